@@ -0,0 +1,274 @@
+/*
+ * Planner for CAN hardware acceptance filters
+ *
+ * @file        CO_CANfilter.c
+ * @ingroup     CO_CANfilter
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_CANfilter.h"
+
+#if defined CO_DRIVER_RX_FILTER_PLAN
+
+#define CO_CAN_FILTER_ID_MASK 0x07FFU
+
+/* Number of CAN-IDs accepted by the mask */
+static uint16_t CO_CANfilter_size(uint16_t mask) {
+    uint16_t size = 1U;
+    uint16_t bit;
+
+    for (bit = 1U; bit <= CO_CAN_FILTER_ID_MASK; bit <<= 1) {
+        if ((mask & bit) == 0U) {
+            size <<= 1;
+        }
+    }
+    return size;
+}
+
+/* true, if all CAN-IDs accepted by inner are also accepted by outer */
+static inline bool_t CO_CANfilter_covers(uint16_t outerIdent,
+                                         uint16_t outerMask,
+                                         uint16_t innerIdent,
+                                         uint16_t innerMask)
+{
+    return (innerMask & outerMask) == outerMask
+           && ((innerIdent ^ outerIdent) & outerMask) == 0U;
+}
+
+/* Number of banks used, if filters with index below listCount are in list
+ * mode. */
+static uint16_t CO_CANfilter_banks(const CO_CANfilterHw_t *hw,
+                                   uint16_t listCount, uint16_t count)
+{
+    uint16_t banks = 0U;
+
+    if (listCount > 0U) {
+        banks = (listCount + hw->listPerBank - 1U) / hw->listPerBank;
+    }
+    return banks + (count - listCount + hw->maskPerBank - 1U) / hw->maskPerBank;
+}
+
+/* Distribute exact identifiers between list and mask mode with the lowest
+ * number of banks. Exact identifiers must be at the beginning of filters.
+ * Return the number of banks and set *listCount. */
+static uint16_t CO_CANfilter_split(const CO_CANfilter_t filters[],
+                                   uint16_t count,
+                                   const CO_CANfilterHw_t *hw,
+                                   uint16_t *listCount)
+{
+    uint16_t exact = 0U;
+    uint16_t banksMin = 0xFFFFU;
+    uint16_t k;
+
+    while (exact < count && filters[exact].mask == CO_CAN_FILTER_ID_MASK) {
+        exact++;
+    }
+    *listCount = 0U;
+    if (hw->listPerBank == 0U) {
+        return CO_CANfilter_banks(hw, 0U, count);
+    }
+    /* Moving exact identifiers into mask mode saves a bank only, if they fill
+     * the last mask bank or empty the last list bank. */
+    for (k = 0U; k <= exact && k <= (hw->listPerBank + hw->maskPerBank); k++) {
+        uint16_t banks = CO_CANfilter_banks(hw, exact - k, count);
+        if (banks < banksMin) {
+            banksMin = banks;
+            *listCount = exact - k;
+        }
+    }
+    return banksMin;
+}
+
+/* Insert filter, keep filters sorted: exact identifiers first, then by ident.
+ * Filters covered by the new filter are removed, new filter is not inserted,
+ * if it is covered by existing one. There must be space for one filter. */
+static uint16_t CO_CANfilter_insert(CO_CANfilter_t filters[], uint16_t count,
+                                    uint16_t ident, uint16_t mask)
+{
+    uint16_t i, j;
+    uint16_t pos;
+    bool_t exact = mask == CO_CAN_FILTER_ID_MASK;
+
+    for (i = 0U; i < count; i++) {
+        if (CO_CANfilter_covers(filters[i].ident, filters[i].mask,
+                                ident, mask)
+        ) {
+            return count;
+        }
+    }
+    for (i = 0U, j = 0U; i < count; i++) {
+        if (!CO_CANfilter_covers(ident, mask,
+                                 filters[i].ident, filters[i].mask)
+        ) {
+            filters[j++] = filters[i];
+        }
+    }
+    count = j;
+
+    for (pos = 0U; pos < count; pos++) {
+        bool_t exactPos = filters[pos].mask == CO_CAN_FILTER_ID_MASK;
+        if ((exact && !exactPos)
+            || (exact == exactPos && filters[pos].ident > ident)
+        ) {
+            break;
+        }
+    }
+    memmove(&filters[pos + 1U], &filters[pos],
+            (count - pos) * sizeof(CO_CANfilter_t));
+    filters[pos].ident = ident;
+    filters[pos].mask = mask;
+    filters[pos].rxIndex = CO_CAN_FILTER_SOFTWARE;
+    return count + 1U;
+}
+
+/* Merge the pair of filters, which adds the lowest number of accepted CAN-IDs.
+ * Candidates are filters close to each other in sorted order, window also
+ * spans from the last exact identifiers to the first mask filters. Return new
+ * count. */
+static uint16_t CO_CANfilter_mergeCheapest(CO_CANfilter_t filters[],
+                                           uint16_t count)
+{
+    int32_t costMin = INT32_MAX;
+    uint16_t aMin = 0U, bMin = 1U;
+    uint16_t a, b, mask, ident;
+
+    for (a = 0U; a < count; a++) {
+        uint16_t sizeA = CO_CANfilter_size(filters[a].mask);
+        uint16_t end = a + 1U + CO_CAN_FILTER_MERGE_WINDOW;
+
+        if (end > count) {
+            end = count;
+        }
+        for (b = a + 1U; b < end; b++) {
+            uint16_t m = filters[a].mask & filters[b].mask
+                         & (uint16_t)~(filters[a].ident ^ filters[b].ident);
+            int32_t cost = (int32_t)CO_CANfilter_size(m)
+                           - (int32_t)sizeA
+                           - (int32_t)CO_CANfilter_size(filters[b].mask);
+            if (cost < costMin) {
+                costMin = cost;
+                aMin = a;
+                bMin = b;
+            }
+        }
+    }
+
+    mask = filters[aMin].mask & filters[bMin].mask
+           & (uint16_t)~(filters[aMin].ident ^ filters[bMin].ident);
+    ident = filters[aMin].ident & mask;
+
+    /* remove both filters, then insert merged one, which also removes other
+     * covered filters */
+    memmove(&filters[bMin], &filters[bMin + 1U],
+            (count - bMin - 1U) * sizeof(CO_CANfilter_t));
+    count--;
+    memmove(&filters[aMin], &filters[aMin + 1U],
+            (count - aMin - 1U) * sizeof(CO_CANfilter_t));
+    count--;
+    return CO_CANfilter_insert(filters, count, ident, mask);
+}
+
+
+/******************************************************************************/
+uint16_t CO_CANfilter_plan(CO_CANfilter_t filters[],
+                           uint16_t filtersSize,
+                           const CO_CANrx_t rxArray[],
+                           uint16_t rxSize,
+                           const CO_CANfilterHw_t *hw,
+                           uint16_t *listCount)
+{
+    uint16_t count = 0U;
+    uint16_t i, j;
+
+    if (filters == NULL || filtersSize < 2U || rxArray == NULL || hw == NULL
+        || hw->banks == 0U || hw->maskPerBank == 0U || listCount == NULL
+    ) {
+        return 0U;
+    }
+
+    /* collect buffers, combine duplicated and overlapping ones */
+    for (i = 0U; i < rxSize; i++) {
+        uint16_t mask = rxArray[i].mask & CO_CAN_FILTER_ID_MASK;
+
+        if (rxArray[i].CANrx_callback == NULL) {
+            continue;
+        }
+        if (count == filtersSize) {
+            count = CO_CANfilter_mergeCheapest(filters, count);
+        }
+        count = CO_CANfilter_insert(filters, count,
+                                    rxArray[i].ident & mask, mask);
+    }
+    if (count == 0U) {
+        *listCount = 0U;
+        return 0U;
+    }
+
+    /* merge until filters fit into hardware */
+    while (CO_CANfilter_split(filters, count, hw, listCount) > hw->banks) {
+        count = CO_CANfilter_mergeCheapest(filters, count);
+    }
+
+    /* Direct buffer for each filter: the buffer with the lowest index, which
+     * accepts any of the CAN-IDs, must accept all of them. */
+    for (i = 0U; i < count; i++) {
+        CO_CANfilter_t *f = &filters[i];
+
+        for (j = 0U; j < rxSize; j++) {
+            uint16_t mask = rxArray[j].mask & CO_CAN_FILTER_ID_MASK;
+
+            if (rxArray[j].CANrx_callback == NULL
+                || ((rxArray[j].ident ^ f->ident) & mask & f->mask) != 0U
+            ) {
+                continue;
+            }
+            if (CO_CANfilter_covers(rxArray[j].ident & mask, mask,
+                                    f->ident, f->mask)
+            ) {
+                f->rxIndex = j;
+            }
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+/******************************************************************************/
+uint16_t CO_CANfilter_accepted(const CO_CANfilter_t filters[], uint16_t count) {
+    uint16_t accepted = 0U;
+    uint16_t id, i;
+
+    if (filters == NULL) {
+        return 0U;
+    }
+    for (id = 0U; id <= CO_CAN_FILTER_ID_MASK; id++) {
+        for (i = 0U; i < count; i++) {
+            if (((id ^ filters[i].ident) & filters[i].mask) == 0U) {
+                accepted++;
+                break;
+            }
+        }
+    }
+    return accepted;
+}
+
+#endif /* defined CO_DRIVER_RX_FILTER_PLAN */
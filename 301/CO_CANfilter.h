@@ -0,0 +1,169 @@
+/**
+ * Planner for CAN hardware acceptance filters
+ *
+ * @file        CO_CANfilter.h
+ * @ingroup     CO_CANfilter
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_CAN_FILTER_H
+#define CO_CAN_FILTER_H
+
+#include "301/CO_driver.h"
+
+#if defined CO_DRIVER_RX_FILTER_PLAN || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANfilter CAN filter planner
+ * Allocation of CAN hardware acceptance filters, optional for the driver.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * CANopenNode configures one CO_CANrx_t buffer for each received CAN-ID or
+ * range of CAN-IDs (ident, mask) with CO_CANrxBufferInit(). CAN controllers
+ * usually have a limited number of acceptance filter banks, for example 14 or
+ * 28 on bxCAN. Each bank holds some exact identifiers (list mode) or some
+ * identifier/mask pairs (mask mode). If driver maps each CO_CANrx_t buffer to
+ * own hardware filter, then larger configurations do not fit and all messages
+ * must be received and matched by software.
+ *
+ * CO_CANfilter_plan() takes all configured buffers and produces set of hardware
+ * filters, which fits into the banks. Duplicated and overlapping buffers are
+ * combined first. If there are still too many filters, pairs of filters are
+ * merged into one mask filter. Merge, which accepts the smallest number of
+ * additional CAN-IDs, is chosen each time. This is the cost: each additional
+ * CAN-ID, which passes the hardware, costs CPU time in the receive interrupt,
+ * if it appears on the bus. So merging is done only as long as necessary to
+ * fit into the banks.
+ *
+ * Each resulting filter has _rxIndex_. If all CAN-IDs accepted by the filter
+ * belong to single CO_CANrx_t buffer, driver can use the buffer directly from
+ * the filter match index. Otherwise merged filter is the residue and received
+ * message is matched by software, with linear search through rxArray or
+ * with CO_DRIVER_RX_LOOKUP table.
+ *
+ * Planner runs in CO_CANsetNormalMode() or after CO_CANrxBufferInit() in
+ * normal mode, not in the CAN receive interrupt. Execution time is
+ * approximately proportional to (number of buffers * size of work array *
+ * CO_CAN_FILTER_MERGE_WINDOW). Driver enables it with CO_DRIVER_RX_FILTER_PLAN
+ * in CO_driver_target.h, see example/CO_driver_blank.c.
+ *
+ * Planner uses 11-bit CAN-ID in bits 0..10 of CO_CANrx_t _ident_ and _mask_,
+ * as in example driver. Other bits (RTR) are ignored, hardware filters accept
+ * both, and driver verifies the received message against the buffer.
+ */
+
+/**
+ * Number of neighbours (in order of CAN-ID) considered for merging with each
+ * filter. Larger value may find cheaper merge and takes more time.
+ */
+#ifndef CO_CAN_FILTER_MERGE_WINDOW
+#define CO_CAN_FILTER_MERGE_WINDOW 4
+#endif
+
+/** Value of CO_CANfilter_t _rxIndex_, if message must be matched by software */
+#define CO_CAN_FILTER_SOFTWARE 0xFFFFU
+
+
+/**
+ * Hardware acceptance filter, result of CO_CANfilter_plan().
+ */
+typedef struct {
+    /** 11-bit CAN identifier, bits not set in _mask_ are zero */
+    uint16_t ident;
+    /** 11-bit mask, CAN-ID bits set to 1 must match _ident_. Exact identifier
+     * has mask 0x07FF. */
+    uint16_t mask;
+    /** Index of CO_CANrx_t buffer in _rxArray_, which receives all messages
+     * accepted by this filter, or CO_CAN_FILTER_SOFTWARE */
+    uint16_t rxIndex;
+} CO_CANfilter_t;
+
+
+/**
+ * Description of CAN hardware acceptance filters.
+ */
+typedef struct {
+    /** Number of filter banks available */
+    uint16_t banks;
+    /** Number of exact identifiers in one bank in list mode, 0 if list mode
+     * is not available */
+    uint8_t listPerBank;
+    /** Number of identifier/mask pairs in one bank in mask mode, at least 1 */
+    uint8_t maskPerBank;
+} CO_CANfilterHw_t;
+
+
+/**
+ * Plan hardware acceptance filters for configured receive buffers.
+ *
+ * @param [out] filters Array for the result, it is also used as work area.
+ * Filters with index below *listCount are exact identifiers for banks in list
+ * mode, others are for banks in mask mode.
+ * @param filtersSize Size of filters array, at least 2. If there are more
+ * different buffers, they are merged while they are collected, so the result
+ * may have more accepted CAN-IDs than necessary.
+ * @param rxArray Array of CAN receive buffers, see CO_CANmodule_init().
+ * Buffers without CANrx_callback are not used.
+ * @param rxSize Number of elements in rxArray.
+ * @param hw Description of CAN hardware filters.
+ * @param [out] listCount Number of filters for list mode.
+ *
+ * @return Number of filters in result. It is 0, if there are no buffers or if
+ * arguments are wrong. Number of banks used is
+ * ceil(listCount / listPerBank) + ceil((return - listCount) / maskPerBank),
+ * it is not larger than hw->banks.
+ */
+uint16_t CO_CANfilter_plan(CO_CANfilter_t filters[],
+                           uint16_t filtersSize,
+                           const CO_CANrx_t rxArray[],
+                           uint16_t rxSize,
+                           const CO_CANfilterHw_t *hw,
+                           uint16_t *listCount);
+
+
+/**
+ * Get number of CAN-IDs accepted by the filters.
+ *
+ * Compare it with the number of CAN-IDs of the receive buffers to estimate the
+ * cost of merging, see @ref CO_CANfilter.
+ *
+ * @param filters Result of CO_CANfilter_plan().
+ * @param count Number of filters.
+ *
+ * @return Number of accepted 11-bit CAN-IDs. Function checks all 2048
+ * CAN-IDs, it is intended for diagnostics.
+ */
+uint16_t CO_CANfilter_accepted(const CO_CANfilter_t filters[], uint16_t count);
+
+/** @} */ /* CO_CANfilter */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* defined CO_DRIVER_RX_FILTER_PLAN */
+
+#endif /* CO_CAN_FILTER_H */
@@ -33,6 +33,18 @@
     || (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT % 8) != 0
  #error CO_CONFIG_EM_ERR_STATUS_BITS_COUNT is not correct
 #endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE) \
+    && (!((CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER) \
+        || CO_CONFIG_EM_CONS_QUEUE_SIZE < 2 \
+        || CO_CONFIG_EM_CONS_QUEUE_SIZE > 255)
+ #error CO_CONFIG_EM_CONS_QUEUE requires CO_CONFIG_EM_CONSUMER and CO_CONFIG_EM_CONS_QUEUE_SIZE from 2 to 255
+#endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_HISTORY) \
+    && (!((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE) \
+        || CO_CONFIG_EM_CONS_HISTORY_SIZE < 1 \
+        || CO_CONFIG_EM_CONS_HISTORY_SIZE > 255)
+ #error CO_CONFIG_EM_CONS_HISTORY requires CO_CONFIG_EM_CONS_QUEUE
+#endif
 
 /* fifo buffer example for fifoSize = 7 (actual capacity = 6)                 *
  *                                                                            *
@@ -48,6 +60,15 @@
  *     to process   to process    to process      full                        *
  ******************************************************************************/
 
+/* Check, if fifo entry at fifoPpPtr is written and may be post-processed. With
+ * CO_CONFIG_EM_ATOMIC slot is reserved before it is written by CO_error(). */
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+#define CO_EM_FIFO_READY(em, fifoPpPtr) \
+    ((fifoPpPtr) != (em)->fifoWrPtr && (em)->fifo[fifoPpPtr].ready != 0)
+#else
+#define CO_EM_FIFO_READY(em, fifoPpPtr) ((fifoPpPtr) != (em)->fifoWrPtr)
+#endif
+
 #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_CONFIGURABLE
 /*
@@ -353,6 +374,9 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
 #else
     memcpy (&em->errorStatusBits[0], buf, countWrite);
 #endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+    em->errorStatusChanged = 1;
+#endif
 
     *countWritten = countWrite;
     return ODR_OK;
@@ -373,7 +397,11 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
 static void CO_EM_receive(void *object, void *msg) {
     CO_EM_t *em = (CO_EM_t*)object;
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE
+    if (em != NULL) {
+#else
     if (em != NULL && em->pFunctSignalRx != NULL) {
+#endif
         uint16_t ident = CO_CANrxMsg_readIdent(msg);
 
         /* ignore sync messages (necessary if sync object is not used) */
@@ -395,17 +423,108 @@ static void CO_EM_receive(void *object, void *msg) {
             memcpy(&errorCode, &data[0], sizeof(errorCode));
             memcpy(&infoCode, &data[4], sizeof(infoCode));
 #endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE
+            /* store message into the queue, consumer is mainline */
+            uint8_t wr = em->consQueueWr;
+            uint8_t wrNext = wr + 1;
+            if (wrNext >= CO_CONFIG_EM_CONS_QUEUE_SIZE) {
+                wrNext = 0;
+            }
+
+            if (wrNext == em->consQueueRd) {
+                if (em->consQueueOverflow < 0xFFFFU) {
+                    em->consQueueOverflow++;
+                }
+            }
+            else {
+                CO_EM_consMsg_t *consMsg = &em->consQueue[wr];
+                consMsg->infoCode = CO_SWAP_32(infoCode);
+                consMsg->ident = ident;
+                consMsg->errorCode = CO_SWAP_16(errorCode);
+                consMsg->errorRegister = data[2];
+                consMsg->errorBit = data[3];
+                CO_MemoryBarrier();
+                em->consQueueWr = wrNext;
+            }
+ #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
+            /* Optional signal to RTOS, which can resume task, which handles
+             * CO_EM_process */
+            if (em->pFunctSignalPre != NULL) {
+                em->pFunctSignalPre(em->functSignalObjectPre);
+            }
+ #endif
+#else
             em->pFunctSignalRx(ident,
                                CO_SWAP_16(errorCode),
                                data[2],
                                data[3],
                                CO_SWAP_32(infoCode));
+#endif
         }
     }
 }
 #endif
 
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE
+/*
+ * Take the oldest message from the emergency consumer queue
+ *
+ * @param em This object.
+ * @param [out] consMsg Copy of the message.
+ *
+ * @return False, if queue is empty.
+ */
+static bool_t CO_EM_consumerPop(CO_EM_t *em, CO_EM_consMsg_t *consMsg) {
+    uint8_t rd = em->consQueueRd;
+
+    if (rd == em->consQueueWr) {
+        return false;
+    }
+    CO_MemoryBarrier();
+    *consMsg = em->consQueue[rd];
+    CO_MemoryBarrier();
+    em->consQueueRd = (++rd < CO_CONFIG_EM_CONS_QUEUE_SIZE) ? rd : 0;
+
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_HISTORY
+    uint8_t nodeId = (uint8_t)(consMsg->ident & 0x7FU);
+    if (em->consHistory != NULL && nodeId < em->consHistoryCount) {
+        CO_EM_consHistory_t *h = &em->consHistory[nodeId];
+        CO_EM_consHistoryEntry_t *entry = &h->entries[h->newest];
+
+        /* compress consecutive messages with the same error */
+        if (h->used > 0 && entry->errorCode == consMsg->errorCode
+            && entry->errorBit == consMsg->errorBit
+        ) {
+            if (entry->repeat < 0xFFU) {
+                entry->repeat++;
+            }
+        }
+        else {
+            if (h->used > 0) {
+                h->newest = (h->newest + 1U < CO_CONFIG_EM_CONS_HISTORY_SIZE)
+                          ? h->newest + 1U : 0U;
+                entry = &h->entries[h->newest];
+            }
+            if (h->used < CO_CONFIG_EM_CONS_HISTORY_SIZE) {
+                h->used++;
+            }
+            entry->errorCode = consMsg->errorCode;
+            entry->errorBit = consMsg->errorBit;
+            entry->repeat = 1;
+        }
+        h->errorRegister = consMsg->errorRegister;
+        if (h->count < 0xFFFFU) {
+            h->count++;
+        }
+    }
+ #endif
+
+    return true;
+}
+#endif
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_EM_init(CO_EM_t *em,
                             CO_CANmodule_t *CANdevTx,
@@ -469,10 +588,20 @@ CO_ReturnError_t CO_EM_init(CO_EM_t *em,
         return CO_ERROR_OD_PARAMETERS;
     }
     *em->errorRegister = 0;
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+    em->errorStatusChanged = 1;
+#endif
 
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     em->fifo = fifo;
     em->fifoSize = fifoSize;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+    /* fifoWrPtr and fifoPpPtr are reset, entries from before communication
+     * reset must not be sent */
+    for (uint8_t i = 0; fifo != NULL && i < fifoSize; i++) {
+        fifo[i].ready = 0;
+    }
+ #endif
 #endif
 #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
     /* get initial and verify "COB-ID EMCY" from Object Dictionary */
@@ -602,6 +731,41 @@ void CO_EM_initCallbackRx(CO_EM_t *em,
 }
 #endif
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE
+uint8_t CO_EM_consumerRead(CO_EM_t *em, CO_EM_consMsg_t msgs[], uint8_t count)
+{
+    uint8_t n = 0;
+
+    if (em != NULL && msgs != NULL) {
+        while (n < count && CO_EM_consumerPop(em, &msgs[n])) {
+            n++;
+        }
+    }
+    return n;
+}
+#endif
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_HISTORY
+void CO_EM_initConsumerHistory(CO_EM_t *em,
+                               CO_EM_consHistory_t history[],
+                               uint8_t historyCount)
+{
+    if (em != NULL) {
+        em->consHistory = history;
+        em->consHistoryCount = history != NULL ? historyCount : 0;
+        if (history != NULL) {
+            memset(history, 0, historyCount * sizeof(CO_EM_consHistory_t));
+        }
+    }
+}
+#endif
+
+void CO_EM_initCANdevErr(CO_EM_t *em, CO_CANmodule_t *CANdevErr) {
+    if (em != NULL) {
+        em->CANdevErr = CANdevErr;
+    }
+}
+
 #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
 void CO_EM_initCallbackPre(CO_EM_t *em,
                            void *object,
@@ -615,6 +779,45 @@ void CO_EM_initCallbackPre(CO_EM_t *em,
 #endif
 
 
+/*
+ * Calculate error register from error conditions, see
+ * CO_CONFIG_ERR_CONDITION_GENERIC.
+ */
+static uint8_t CO_EM_calcErrorRegister(CO_EM_t *em) {
+    uint8_t errorRegister = 0U;
+    if (CO_CONFIG_ERR_CONDITION_GENERIC) {
+        errorRegister |= CO_ERR_REG_GENERIC_ERR;
+    }
+#ifdef CO_CONFIG_ERR_CONDITION_CURRENT
+    if (CO_CONFIG_ERR_CONDITION_CURRENT) {
+        errorRegister |= CO_ERR_REG_CURRENT;
+    }
+#endif
+#ifdef CO_CONFIG_ERR_CONDITION_VOLTAGE
+    if (CO_CONFIG_ERR_CONDITION_VOLTAGE) {
+        errorRegister |= CO_ERR_REG_VOLTAGE;
+    }
+#endif
+#ifdef CO_CONFIG_ERR_CONDITION_TEMPERATURE
+    if (CO_CONFIG_ERR_CONDITION_TEMPERATURE) {
+        errorRegister |= CO_ERR_REG_TEMPERATURE;
+    }
+#endif
+    if (CO_CONFIG_ERR_CONDITION_COMMUNICATION) {
+        errorRegister |= CO_ERR_REG_COMMUNICATION;
+    }
+#ifdef CO_CONFIG_ERR_CONDITION_DEV_PROFILE
+    if (CO_CONFIG_ERR_CONDITION_DEV_PROFILE) {
+        errorRegister |= CO_ERR_REG_DEV_PROFILE;
+    }
+#endif
+    if (CO_CONFIG_ERR_CONDITION_MANUFACTURER) {
+        errorRegister |= CO_ERR_REG_MANUFACTURER;
+    }
+    return errorRegister;
+}
+
+
 /******************************************************************************/
 void CO_EM_process(CO_EM_t *em,
                    bool_t NMTisPreOrOperational,
@@ -625,6 +828,9 @@ void CO_EM_process(CO_EM_t *em,
 
     /* verify errors from driver */
     uint16_t CANerrSt = em->CANdevTx->CANerrorStatus;
+    if (em->CANdevErr != NULL) {
+        CANerrSt |= em->CANdevErr->CANerrorStatus;
+    }
     if (CANerrSt != em->CANerrorStatusOld) {
         uint16_t CANerrStChanged = CANerrSt ^ em->CANerrorStatusOld;
         em->CANerrorStatusOld = CANerrSt;
@@ -661,37 +867,30 @@ void CO_EM_process(CO_EM_t *em,
     }
 
     /* calculate Error register */
-    uint8_t errorRegister = 0U;
-    if (CO_CONFIG_ERR_CONDITION_GENERIC) {
-        errorRegister |= CO_ERR_REG_GENERIC_ERR;
-    }
-#ifdef CO_CONFIG_ERR_CONDITION_CURRENT
-    if (CO_CONFIG_ERR_CONDITION_CURRENT) {
-        errorRegister |= CO_ERR_REG_CURRENT;
-    }
-#endif
-#ifdef CO_CONFIG_ERR_CONDITION_VOLTAGE
-    if (CO_CONFIG_ERR_CONDITION_VOLTAGE) {
-        errorRegister |= CO_ERR_REG_VOLTAGE;
-    }
-#endif
-#ifdef CO_CONFIG_ERR_CONDITION_TEMPERATURE
-    if (CO_CONFIG_ERR_CONDITION_TEMPERATURE) {
-        errorRegister |= CO_ERR_REG_TEMPERATURE;
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+    /* errorStatusBits are not changed, reuse previous value otherwise */
+    if (em->errorStatusChanged != 0) {
+        em->errorStatusChanged = 0;
+        CO_MemoryBarrier();
+        *em->errorRegister = CO_EM_calcErrorRegister(em);
     }
+    uint8_t errorRegister = *em->errorRegister;
+#else
+    uint8_t errorRegister = CO_EM_calcErrorRegister(em);
+    *em->errorRegister = errorRegister;
 #endif
-    if (CO_CONFIG_ERR_CONDITION_COMMUNICATION) {
-        errorRegister |= CO_ERR_REG_COMMUNICATION;
-    }
-#ifdef CO_CONFIG_ERR_CONDITION_DEV_PROFILE
-    if (CO_CONFIG_ERR_CONDITION_DEV_PROFILE) {
-        errorRegister |= CO_ERR_REG_DEV_PROFILE;
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE
+    /* pass received emergency messages to the application */
+    if (em->pFunctSignalRx != NULL) {
+        CO_EM_consMsg_t consMsg;
+        while (CO_EM_consumerPop(em, &consMsg)) {
+            em->pFunctSignalRx(consMsg.ident, consMsg.errorCode,
+                               consMsg.errorRegister, consMsg.errorBit,
+                               consMsg.infoCode);
+        }
     }
 #endif
-    if (CO_CONFIG_ERR_CONDITION_MANUFACTURER) {
-        errorRegister |= CO_ERR_REG_MANUFACTURER;
-    }
-    *em->errorRegister = errorRegister;
 
     if (!NMTisPreOrOperational) {
         return;
@@ -707,12 +906,12 @@ void CO_EM_process(CO_EM_t *em,
             em->inhibitEmTimer += timeDifference_us;
         }
 
-        if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull
+        if (CO_EM_FIFO_READY(em, fifoPpPtr) && !em->CANtxBuff->bufferFull
             && em->inhibitEmTimer >= em->inhibitEmTime_us
         ) {
             em->inhibitEmTimer = 0;
  #else
-        if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull) {
+        if (CO_EM_FIFO_READY(em, fifoPpPtr) && !em->CANtxBuff->bufferFull) {
  #endif
             /* add error register to emergency message */
             em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
@@ -745,6 +944,10 @@ void CO_EM_process(CO_EM_t *em,
  #endif
 
             /* increment pointer */
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+            em->fifo[fifoPpPtr].ready = 0;
+            CO_MemoryBarrier();
+ #endif
             em->fifoPpPtr = (++fifoPpPtr < em->fifoSize) ? fifoPpPtr : 0;
 
             /* verify message buffer overflow. Clear error condition if all
@@ -777,9 +980,13 @@ void CO_EM_process(CO_EM_t *em,
 #elif (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY
     if (em->fifoSize >= 2) {
         uint8_t fifoPpPtr = em->fifoPpPtr;
-        while (fifoPpPtr != em->fifoWrPtr) {
+        while (CO_EM_FIFO_READY(em, fifoPpPtr)) {
             /* add error register to emergency message and increment pointers */
             em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+            em->fifo[fifoPpPtr].ready = 0;
+            CO_MemoryBarrier();
+ #endif
 
             if (++fifoPpPtr >= em->fifoSize) {
                 fifoPpPtr = 0;
@@ -812,6 +1019,32 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
 
     uint8_t *errorStatusBits = &em->errorStatusBits[index];
     uint8_t errorStatusBitMasked = *errorStatusBits & bitmask;
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+    if (!setError) {
+        errorCode = CO_EMC_NO_ERROR;
+    }
+    /* Fast path, if error is already set (or unset). Otherwise toggle the bit
+     * atomically. Only the caller, which actually toggled it, continues. */
+    if ((errorStatusBitMasked != 0) == (setError != 0)) {
+        return;
+    }
+    if (setError) {
+        errorStatusBitMasked = CO_ATOMIC_FETCH_OR_U8(errorStatusBits, bitmask)
+                               & bitmask;
+        if (errorStatusBitMasked != 0) {
+            return;
+        }
+    }
+    else {
+        errorStatusBitMasked = CO_ATOMIC_FETCH_AND_U8(errorStatusBits,
+                                                      (uint8_t)~bitmask)
+                               & bitmask;
+        if (errorStatusBitMasked == 0) {
+            return;
+        }
+    }
+    em->errorStatusChanged = 1;
+#else
 
     /* If error is already set (or unset), return without further actions,
      * otherwise toggle bit and continue with error indication. */
@@ -826,6 +1059,7 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
         }
         errorCode = CO_EMC_NO_ERROR;
     }
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC */
 
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     /* prepare emergency message. Error register will be added in post-process*/
@@ -835,6 +1069,46 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
  #endif
 #endif
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC
+ #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
+    if (em->fifoSize >= 2) {
+        /* reserve the slot in fifo, then write it and mark it ready */
+        uint8_t fifoWrPtr;
+        uint8_t fifoWrPtrNext;
+        bool_t reserved = false;
+        do {
+            fifoWrPtr = em->fifoWrPtr;
+            fifoWrPtrNext = fifoWrPtr + 1;
+            if (fifoWrPtrNext >= em->fifoSize) {
+                fifoWrPtrNext = 0;
+            }
+            if (fifoWrPtrNext == em->fifoPpPtr) {
+                em->fifoOverflow = 1;
+                break;
+            }
+            reserved = CO_ATOMIC_CAS_U8(&em->fifoWrPtr, fifoWrPtr,
+                                        fifoWrPtrNext);
+        } while (!reserved);
+
+        if (reserved) {
+            em->fifo[fifoWrPtr].msg = errMsg;
+  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+            em->fifo[fifoWrPtr].info = infoCodeSwapped;
+  #endif
+            CO_MemoryBarrier();
+            em->fifo[fifoWrPtr].ready = 1;
+
+            uint8_t fifoCount = em->fifoCount;
+            while (fifoCount < (em->fifoSize - 1)
+                   && !CO_ATOMIC_CAS_U8(&em->fifoCount, fifoCount,
+                                        fifoCount + 1))
+            {
+                fifoCount = em->fifoCount;
+            }
+        }
+    }
+ #endif
+#else
     /* safely write data, and increment pointers */
     CO_LOCK_EMCY(em->CANdevTx);
     if (setError) { *errorStatusBits |=  bitmask; }
@@ -863,6 +1137,7 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
 #endif /* (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY) */
 
     CO_UNLOCK_EMCY(em->CANdevTx);
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC */
 
 #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
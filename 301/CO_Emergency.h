@@ -39,6 +39,20 @@
 #ifndef CO_CONFIG_EM_ERR_STATUS_BITS_COUNT
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC) && !defined CO_ATOMIC_FETCH_OR_U8
+#define CO_ATOMIC_FETCH_OR_U8(ptr, value) \
+    __sync_fetch_and_or((ptr), (value))
+#define CO_ATOMIC_FETCH_AND_U8(ptr, value) \
+    __sync_fetch_and_and((ptr), (value))
+#define CO_ATOMIC_CAS_U8(ptr, expected, desired) \
+    __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#endif
+#ifndef CO_CONFIG_EM_CONS_QUEUE_SIZE
+#define CO_CONFIG_EM_CONS_QUEUE_SIZE 16
+#endif
+#ifndef CO_CONFIG_EM_CONS_HISTORY_SIZE
+#define CO_CONFIG_EM_CONS_HISTORY_SIZE 4
+#endif
 #ifndef CO_CONFIG_ERR_CONDITION_GENERIC
 #define CO_CONFIG_ERR_CONDITION_GENERIC (em->errorStatusBits[5] != 0)
 #endif
@@ -99,6 +113,13 @@ extern "C" {
  * ### Emergency consumer
  * If @ref CO_CONFIG_EM has CO_CONFIG_EM_CONSUMER enabled, then callback can be
  * registered by @ref CO_EM_initCallbackRx() function.
+ *
+ * If CO_CONFIG_EM_CONS_QUEUE is also enabled, then received messages are only
+ * stored into the queue inside CAN receive interrupt. Queue is emptied in
+ * batches from mainline, by CO_EM_process() (which calls the callback) or by
+ * CO_EM_consumerRead(). With CO_CONFIG_EM_CONS_HISTORY latest error codes and
+ * counters of each remote node are kept, see CO_EM_initConsumerHistory(), so
+ * diagnostic tools don't need to read 0x1003 from each node.
  */
 
 
@@ -370,22 +391,83 @@ typedef struct {
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER) || defined CO_DOXYGEN
     uint32_t info;
 #endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC) || defined CO_DOXYGEN
+    /** Set by CO_error() after msg is written, cleared by CO_EM_process() */
+    volatile uint8_t ready;
+#endif
 } CO_EM_fifo_t;
 #endif
 
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE) || defined CO_DOXYGEN
+/**
+ * Received emergency message, element of the emergency consumer queue
+ */
+typedef struct {
+    /** Manufacturer specific information, bytes 4..7 of the message */
+    uint32_t infoCode;
+    /** CAN-ID of the message, 0 for own emergency messages */
+    uint16_t ident;
+    /** Emergency error code, see @ref CO_EM_errorCode_t */
+    uint16_t errorCode;
+    /** Error register, see @ref CO_errorRegister_t */
+    uint8_t errorRegister;
+    /** Error status bit, byte 3 of the message */
+    uint8_t errorBit;
+} CO_EM_consMsg_t;
+#endif
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_HISTORY) || defined CO_DOXYGEN
+/**
+ * One entry in history of emergency messages from remote node
+ */
+typedef struct {
+    /** Emergency error code */
+    uint16_t errorCode;
+    /** Error status bit */
+    uint8_t errorBit;
+    /** Number of consecutive messages with the same errorCode and errorBit,
+     * saturates at 255 */
+    uint8_t repeat;
+} CO_EM_consHistoryEntry_t;
+
+/**
+ * History of emergency messages from one remote node
+ */
+typedef struct {
+    /** Circular buffer of latest entries, newest is entries[newest] */
+    CO_EM_consHistoryEntry_t entries[CO_CONFIG_EM_CONS_HISTORY_SIZE];
+    /** Index of the newest entry */
+    uint8_t newest;
+    /** Number of valid entries */
+    uint8_t used;
+    /** Error register from the last message */
+    uint8_t errorRegister;
+    /** Number of all received messages, saturates at 0xFFFF */
+    uint16_t count;
+} CO_EM_consHistory_t;
+#endif
+
+
 /**
  * Emergency object.
  */
 typedef struct {
     /** Bitfield for the internal indication of the error condition. */
     uint8_t errorStatusBits[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8];
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_ATOMIC) || defined CO_DOXYGEN
+    /** Set, if errorStatusBits changed and error register must be calculated
+     * again in CO_EM_process() */
+    volatile uint8_t errorStatusChanged;
+#endif
     /** Pointer to error register in object dictionary at 0x1001,00. */
     uint8_t *errorRegister;
     /** Old CAN error status bitfield */
     uint16_t CANerrorStatusOld;
     /** From CO_EM_init() */
     CO_CANmodule_t *CANdevTx;
+    /** From CO_EM_initCANdevErr() or NULL */
+    CO_CANmodule_t *CANdevErr;
 
 #if ((CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)) \
     || defined CO_DOXYGEN
@@ -400,7 +482,7 @@ typedef struct {
     uint8_t fifoSize;
     /** Pointer for the fifo buffer, where next emergency message will be
      * written by @ref CO_error() function. */
-    uint8_t fifoWrPtr;
+    volatile uint8_t fifoWrPtr;
     /** Pointer for the fifo, where next emergency message has to be
      * post-processed by @ref CO_EM_process() function. If equal to bufWrPtr,
      * then all messages has been post-processed. */
@@ -408,7 +490,7 @@ typedef struct {
     /** Indication of overflow - messages in buffer are not post-processed */
     uint8_t fifoOverflow;
     /** Count of emergency messages in fifo, used for OD object 0x1003 */
-    uint8_t fifoCount;
+    volatile uint8_t fifoCount;
 #endif /* (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY) */
 
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER) || defined CO_DOXYGEN
@@ -455,6 +537,25 @@ typedef struct {
                            const uint32_t infoCode);
 #endif
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE) || defined CO_DOXYGEN
+    /** Queue of received emergency messages */
+    CO_EM_consMsg_t consQueue[CO_CONFIG_EM_CONS_QUEUE_SIZE];
+    /** Write index of consQueue, written by CAN receive callback only */
+    volatile uint8_t consQueueWr;
+    /** Read index of consQueue, written by mainline only */
+    volatile uint8_t consQueueRd;
+    /** Number of messages lost because of full consQueue, written by CAN
+     * receive callback only, saturates at 0xFFFF */
+    volatile uint16_t consQueueOverflow;
+#endif
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_HISTORY) || defined CO_DOXYGEN
+    /** From CO_EM_initConsumerHistory() or NULL */
+    CO_EM_consHistory_t *consHistory;
+    /** From CO_EM_initConsumerHistory() */
+    uint8_t consHistoryCount;
+#endif
+
 #if ((CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_EM_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -527,6 +628,20 @@ CO_ReturnError_t CO_EM_init(CO_EM_t *em,
                             uint32_t *errInfo);
 
 
+/**
+ * Initialize additional CAN module, whose CAN errors are reported.
+ *
+ * CO_EM_process() reports errors from CANerrorStatus of CAN device from
+ * CO_EM_init() and of this CAN module, for example CO_t::CANmoduleRT on own
+ * CAN interface, see CO_SEPARATE_RT_CAN. Both are combined with bitwise OR.
+ * Function must be called after CO_EM_init().
+ *
+ * @param em This object.
+ * @param CANdevErr CAN module or NULL.
+ */
+void CO_EM_initCANdevErr(CO_EM_t *em, CO_CANmodule_t *CANdevErr);
+
+
 #if ((CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
 /**
  * Initialize Emergency callback function.
@@ -559,7 +674,8 @@ void CO_EM_initCallbackPre(CO_EM_t *em,
  * _ident_ == 0, then emergency message was sent from this device.
  *
  * @remark Depending on the CAN driver implementation, this function is called
- * inside an ISR or inside a mainline. Must be thread safe.
+ * inside an ISR or inside a mainline. Must be thread safe. With
+ * CO_CONFIG_EM_CONS_QUEUE it is always called from CO_EM_process().
  *
  * @param em This object.
  * @param pFunctSignalRx Pointer to the callback function. Not called if NULL.
@@ -573,6 +689,59 @@ void CO_EM_initCallbackRx(CO_EM_t *em,
 #endif
 
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_QUEUE) || defined CO_DOXYGEN
+/**
+ * Read received emergency messages from the emergency consumer queue.
+ *
+ * Use this function, if callback from CO_EM_initCallbackRx() is not
+ * configured. Otherwise queue is emptied by CO_EM_process(). Must be called
+ * from the same thread as CO_EM_process().
+ *
+ * @param em This object.
+ * @param [out] msgs Array for received messages.
+ * @param count Number of elements in msgs.
+ *
+ * @return Number of messages copied into msgs.
+ */
+uint8_t CO_EM_consumerRead(CO_EM_t *em, CO_EM_consMsg_t msgs[], uint8_t count);
+#endif
+
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONS_HISTORY) || defined CO_DOXYGEN
+/**
+ * Initialize history of received emergency messages.
+ *
+ * History is indexed by node-ID of the remote node and is updated, when
+ * message is taken from the emergency consumer queue.
+ *
+ * @param em This object.
+ * @param history Array of historyCount elements, usually 128. It will be
+ * cleared. If NULL, history is disabled.
+ * @param historyCount Number of elements in history.
+ */
+void CO_EM_initConsumerHistory(CO_EM_t *em,
+                               CO_EM_consHistory_t history[],
+                               uint8_t historyCount);
+
+
+/**
+ * Get history of received emergency messages for remote node.
+ *
+ * @param em This object.
+ * @param nodeId Node-ID of the remote node.
+ *
+ * @return Pointer to history or NULL, if not available.
+ */
+static inline const CO_EM_consHistory_t *CO_EM_getConsumerHistory(
+        CO_EM_t *em, uint8_t nodeId)
+{
+    return (em != NULL && em->consHistory != NULL
+            && nodeId < em->consHistoryCount)
+           ? &em->consHistory[nodeId] : NULL;
+}
+#endif
+
+
 /**
  * Process Error control and Emergency object.
  *
@@ -52,6 +52,9 @@ static void CO_HBcons_receive(void *object, void *msg) {
         /* copy data and set 'new message' flag. */
         HBconsNode->NMTstate = (CO_NMT_internalState_t)data[0];
         CO_FLAG_SET(HBconsNode->CANrxNew);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        CO_readyList_push(HBconsNode->readyList, HBconsNode->idx);
+#endif
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE
         /* Optional signal to RTOS, which can resume task, which handles HBcons. */
         if (HBconsNode->pFunctSignalPre != NULL) {
@@ -80,6 +83,136 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
                                                 uint16_t consumerTime_ms);
 
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+/* Set or clear bit for nodeId inside 128-bit bitmap */
+static inline void bitWrite(uint32_t bits[], uint8_t nodeId, bool_t value) {
+    uint32_t mask = (uint32_t)1 << (nodeId & 0x1FU);
+
+    if (value) {
+        bits[nodeId >> 5] |= mask;
+    }
+    else {
+        bits[nodeId >> 5] &= ~mask;
+    }
+}
+
+/* Compare bitmaps */
+static inline bool_t bitsEqual(const uint32_t a[], const uint32_t b[]) {
+    return (a[0] == b[0]) && (a[1] == b[1]) && (a[2] == b[2]) && (a[3] == b[3]);
+}
+
+/* Return true, if deadline of node with index a is before deadline of b */
+static inline bool_t heapEarlier(CO_HBconsumer_t *HBcons, uint8_t a, uint8_t b)
+{
+    return (int32_t)(HBcons->monitoredNodes[a].deadline_us
+                     - HBcons->monitoredNodes[b].deadline_us) < 0;
+}
+
+/* Store node with index idx to position pos inside heap */
+static inline void heapPut(CO_HBconsumer_t *HBcons, uint8_t pos, uint8_t idx) {
+    HBcons->heap[pos] = idx;
+    HBcons->monitoredNodes[idx].heapPos = pos;
+}
+
+/* Restore heap order after deadline of the node on position pos changed */
+static void heapFix(CO_HBconsumer_t *HBcons, uint8_t pos) {
+    uint8_t idx = HBcons->heap[pos];
+
+    /* move up */
+    while (pos > 0) {
+        uint8_t parent = (uint8_t)((pos - 1U) / 2U);
+        if (!heapEarlier(HBcons, idx, HBcons->heap[parent])) {
+            break;
+        }
+        heapPut(HBcons, pos, HBcons->heap[parent]);
+        pos = parent;
+    }
+
+    /* move down */
+    for (;;) {
+        uint16_t child = (uint16_t)pos * 2U + 1U;
+        if (child >= HBcons->heapCount) {
+            break;
+        }
+        if ((child + 1U) < HBcons->heapCount
+            && heapEarlier(HBcons, HBcons->heap[child + 1U], HBcons->heap[child])
+        ) {
+            child++;
+        }
+        if (!heapEarlier(HBcons, HBcons->heap[child], idx)) {
+            break;
+        }
+        heapPut(HBcons, pos, HBcons->heap[child]);
+        pos = (uint8_t)child;
+    }
+    heapPut(HBcons, pos, idx);
+}
+
+/* Add node to the heap or update its position after new deadline_us */
+static void heapSchedule(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node) {
+    if (node->heapPos == CO_HB_CONS_NO_HEAP) {
+        heapPut(HBcons, HBcons->heapCount, node->idx);
+        HBcons->heapCount++;
+    }
+    heapFix(HBcons, node->heapPos);
+}
+
+/* Remove node from the heap, if it is there */
+static void heapRemove(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node) {
+    uint8_t pos = node->heapPos;
+
+    if (pos == CO_HB_CONS_NO_HEAP) {
+        return;
+    }
+    node->heapPos = CO_HB_CONS_NO_HEAP;
+    HBcons->heapCount--;
+    if (pos < HBcons->heapCount) {
+        heapPut(HBcons, pos, HBcons->heap[HBcons->heapCount]);
+        heapFix(HBcons, pos);
+    }
+}
+
+/* Update bitmaps after HBstate or NMTstate of the configured node changed */
+static void updateBits(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node) {
+    uint8_t nodeId = node->nodeId;
+
+    bitWrite(HBcons->activeBits, nodeId,
+             node->HBstate == CO_HBconsumer_ACTIVE);
+    bitWrite(HBcons->timeoutBits, nodeId,
+             node->HBstate == CO_HBconsumer_TIMEOUT);
+    bitWrite(HBcons->operationalBits, nodeId,
+             node->NMTstate == CO_NMT_OPERATIONAL);
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+/* Verify, if NMT state of monitored node changed and call callback */
+static void nmtChanged(CO_HBconsumer_t *HBcons,
+                       CO_HBconsNode_t *monitoredNode,
+                       uint8_t idx)
+{
+    if(monitoredNode->NMTstate != monitoredNode->NMTstatePrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE
+        if (HBcons->pFunctSignalNmtChanged != NULL) {
+            HBcons->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, idx, monitoredNode->NMTstate,
+                HBcons->pFunctSignalObjectNmtChanged);
+#else
+        (void)HBcons;
+        if (monitoredNode->pFunctSignalNmtChanged != NULL) {
+            monitoredNode->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, idx, monitoredNode->NMTstate,
+                monitoredNode->pFunctSignalObjectNmtChanged);
+#endif
+        }
+        monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
+    }
+}
+#endif
+
+
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_OD_DYNAMIC
 /*
  * Custom function for writing OD object "Consumer heartbeat time"
@@ -154,6 +287,19 @@ CO_ReturnError_t CO_HBconsumer_init(CO_HBconsumer_t *HBcons,
         OD_1016_HBcons->subEntriesCount-1 < monitoredNodesCount ?
         OD_1016_HBcons->subEntriesCount-1 : monitoredNodesCount;
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+    if (HBcons->numberOfMonitoredNodes > CO_HB_CONS_NODES_MAX) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    CO_readyList_init(&HBcons->readyList, HBcons->readyRing,
+                      HBcons->readyQueued, HBcons->numberOfMonitoredNodes);
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        monitoredNodes[i].heapPos = CO_HB_CONS_NO_HEAP;
+        monitoredNodes[i].idx = i;
+        monitoredNodes[i].readyList = &HBcons->readyList;
+    }
+#endif
+
     for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
         uint32_t val;
         odRet = OD_get_u32(OD_1016_HBcons, i + 1, &val, true);
@@ -203,12 +349,20 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
 
     /* verify for duplicate entries */
     if(consumerTime_ms != 0 && nodeId != 0) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        if (nodeId > CO_HB_CONS_NODES_MAX || (HBcons->nodeIdx[nodeId] != 0
+            && HBcons->nodeIdx[nodeId] != (idx + 1U))
+        ) {
+            ret = CO_ERROR_OD_PARAMETERS;
+        }
+#else
         for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
             CO_HBconsNode_t node = HBcons->monitoredNodes[i];
             if(idx != i && node.time_us != 0 && node.nodeId == nodeId) {
                 ret = CO_ERROR_OD_PARAMETERS;
             }
         }
+#endif
     }
 
     /* Configure one monitored node */
@@ -216,6 +370,20 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
         uint16_t COB_ID;
 
         CO_HBconsNode_t * monitoredNode = &HBcons->monitoredNodes[idx];
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        /* remove previous configuration */
+        uint8_t nodeIdPrev = monitoredNode->nodeId;
+        if (nodeIdPrev <= CO_HB_CONS_NODES_MAX
+            && HBcons->nodeIdx[nodeIdPrev] == (idx + 1U)
+        ) {
+            HBcons->nodeIdx[nodeIdPrev] = 0;
+            bitWrite(HBcons->monitoredBits, nodeIdPrev, false);
+            bitWrite(HBcons->activeBits, nodeIdPrev, false);
+            bitWrite(HBcons->timeoutBits, nodeIdPrev, false);
+            bitWrite(HBcons->operationalBits, nodeIdPrev, false);
+        }
+        heapRemove(HBcons, monitoredNode);
+#endif
         monitoredNode->nodeId = nodeId;
         monitoredNode->time_us = (int32_t)consumerTime_ms * 1000;
         monitoredNode->NMTstate = CO_NMT_UNKNOWN;
@@ -229,6 +397,10 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
         if (monitoredNode->nodeId != 0 && monitoredNode->time_us != 0) {
             COB_ID = monitoredNode->nodeId + CO_CAN_ID_HEARTBEAT;
             monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+            HBcons->nodeIdx[nodeId] = idx + 1U;
+            bitWrite(HBcons->monitoredBits, nodeId, true);
+#endif
         }
         else {
             COB_ID = 0;
@@ -379,6 +551,101 @@ void CO_HBconsumer_process(
     bool_t allMonitoredOperationalCurrent = true;
 
     if (NMTisPreOrOperational && HBcons->NMTisPreOrOperationalPrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        uint16_t i;
+        uint32_t now = HBcons->time_us + timeDifference_us;
+
+        HBcons->time_us = now;
+
+        /* Process nodes with received heartbeat or bootup message */
+        while ((i = CO_readyList_pop(&HBcons->readyList))
+               != CO_READY_LIST_EMPTY
+        ) {
+            CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
+
+            if (monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED) {
+                continue;
+            }
+            CO_FLAG_CLEAR(monitoredNode->CANrxNew);
+            if (monitoredNode->NMTstate == CO_NMT_INITIALIZING) {
+                /* bootup message*/
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+                if (monitoredNode->pFunctSignalRemoteReset != NULL) {
+                    monitoredNode->pFunctSignalRemoteReset(
+                        monitoredNode->nodeId, (uint8_t)i,
+                        monitoredNode->functSignalObjectRemoteReset);
+                }
+#endif
+                if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+                    CO_errorReport(HBcons->em,
+                                   CO_EM_HB_CONSUMER_REMOTE_RESET,
+                                   CO_EMC_HEARTBEAT, i);
+                }
+                monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+                heapRemove(HBcons, monitoredNode);
+            }
+            else {
+                /* heartbeat message */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+                if (monitoredNode->HBstate != CO_HBconsumer_ACTIVE &&
+                    monitoredNode->pFunctSignalHbStarted != NULL) {
+                    monitoredNode->pFunctSignalHbStarted(
+                        monitoredNode->nodeId, (uint8_t)i,
+                        monitoredNode->functSignalObjectHbStarted);
+                }
+#endif
+                monitoredNode->HBstate = CO_HBconsumer_ACTIVE;
+                monitoredNode->deadline_us = now + monitoredNode->time_us;
+                heapSchedule(HBcons, monitoredNode);
+            }
+            updateBits(HBcons, monitoredNode);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+            nmtChanged(HBcons, monitoredNode, (uint8_t)i);
+#endif
+        }
+
+        /* Verify timeouts, earliest deadline first */
+        while (HBcons->heapCount > 0) {
+            CO_HBconsNode_t * const monitoredNode =
+                &HBcons->monitoredNodes[HBcons->heap[0]];
+            uint32_t diff = monitoredNode->deadline_us - now;
+
+            if ((int32_t)diff > 0) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
+                if (timerNext_us != NULL && *timerNext_us > diff) {
+                    *timerNext_us = diff;
+                }
+#endif
+                break;
+            }
+
+            /* timeout expired */
+            i = monitoredNode->idx;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+            if (monitoredNode->pFunctSignalTimeout!=NULL) {
+                monitoredNode->pFunctSignalTimeout(
+                    monitoredNode->nodeId, (uint8_t)i,
+                    monitoredNode->functSignalObjectTimeout);
+            }
+#endif
+            CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER,
+                           CO_EMC_HEARTBEAT, i);
+            monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+            monitoredNode->HBstate = CO_HBconsumer_TIMEOUT;
+            heapRemove(HBcons, monitoredNode);
+            updateBits(HBcons, monitoredNode);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+            nmtChanged(HBcons, monitoredNode, (uint8_t)i);
+#endif
+        }
+
+        allMonitoredActiveCurrent = bitsEqual(HBcons->activeBits,
+                                              HBcons->monitoredBits);
+        allMonitoredOperationalCurrent = bitsEqual(HBcons->operationalBits,
+                                                   HBcons->monitoredBits);
+#else
         for (uint8_t i=0; i<HBcons->numberOfMonitoredNodes; i++) {
             uint32_t timeDifference_us_copy = timeDifference_us;
             CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
@@ -463,24 +730,10 @@ void CO_HBconsumer_process(
             }
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
     || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
-            /* Verify, if NMT state of monitored node changed */
-            if(monitoredNode->NMTstate != monitoredNode->NMTstatePrev) {
-#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE
-                if (HBcons->pFunctSignalNmtChanged != NULL) {
-                    HBcons->pFunctSignalNmtChanged(
-                        monitoredNode->nodeId, i, monitoredNode->NMTstate,
-                        HBcons->pFunctSignalObjectNmtChanged);
-#else
-                if (monitoredNode->pFunctSignalNmtChanged != NULL) {
-                    monitoredNode->pFunctSignalNmtChanged(
-                        monitoredNode->nodeId, i, monitoredNode->NMTstate,
-                        monitoredNode->pFunctSignalObjectNmtChanged);
-#endif
-                }
-                monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
-            }
+            nmtChanged(HBcons, monitoredNode, i);
 #endif
         }
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED */
     }
     else if (NMTisPreOrOperational || HBcons->NMTisPreOrOperationalPrev) {
         /* (pre)operational state changed, clear variables */
@@ -495,7 +748,19 @@ void CO_HBconsumer_process(
             if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
                 monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
             }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+            monitoredNode->heapPos = CO_HB_CONS_NO_HEAP;
+#endif
         }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        HBcons->heapCount = 0;
+        while (CO_readyList_pop(&HBcons->readyList) != CO_READY_LIST_EMPTY) {
+            /* discard received messages */
+        }
+        memset(HBcons->activeBits, 0, sizeof(HBcons->activeBits));
+        memset(HBcons->timeoutBits, 0, sizeof(HBcons->timeoutBits));
+        memset(HBcons->operationalBits, 0, sizeof(HBcons->operationalBits));
+#endif
         allMonitoredActiveCurrent = false;
         allMonitoredOperationalCurrent = false;
     }
@@ -520,6 +785,14 @@ int8_t CO_HBconsumer_getIdxByNodeId(
         CO_HBconsumer_t        *HBcons,
         uint8_t                 nodeId)
 {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+    if (HBcons == NULL || nodeId > CO_HB_CONS_NODES_MAX) {
+        return -1;
+    }
+
+    /* direct lookup, 0 means not monitored */
+    return (int8_t)HBcons->nodeIdx[nodeId] - 1;
+#else
     uint8_t i;
     CO_HBconsNode_t *monitoredNode;
 
@@ -537,6 +810,7 @@ int8_t CO_HBconsumer_getIdxByNodeId(
     }
     /* not found */
     return -1;
+#endif
 }
 
 
@@ -56,6 +56,8 @@ extern "C" {
  * sends emergency message. If all monitored nodes are operational, then
  * variable _allMonitoredOperational_ inside CO_HBconsumer_t is set to true.
  * Monitoring starts after the reception of the first HeartBeat (not bootup).
+ * With CO_CONFIG_HB_CONS_INDEXED states of all monitored nodes are also
+ * available as node-ID indexed bitmaps.
  *
  * Heartbeat set up is done by writing to the OD registers 0x1016.
  * To setup heartbeat consumer by application, use
@@ -64,6 +66,13 @@ extern "C" {
  * @see @ref CO_NMT_Heartbeat
  */
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED) || defined CO_DOXYGEN
+/** Maximum number of monitored nodes with CO_CONFIG_HB_CONS_INDEXED */
+#define CO_HB_CONS_NODES_MAX 127
+/** Value of CO_HBconsNode_t::heapPos, if node is not waiting for timeout */
+#define CO_HB_CONS_NO_HEAP 0xFFU
+#endif
+
 /**
  * Heartbeat state of a node
  */
@@ -85,12 +94,23 @@ typedef struct {
     CO_NMT_internalState_t NMTstate;
     /** Current heartbeat monitoring state of the remote node */
     CO_HBconsumer_state_t HBstate;
-    /** Time since last heartbeat received */
+    /** Time since last heartbeat received, not used with
+     * CO_CONFIG_HB_CONS_INDEXED */
     uint32_t timeoutTimer;
     /** Consumer heartbeat time from OD */
     uint32_t time_us;
     /** Indication if new Heartbeat message received from the CAN bus */
     volatile void *CANrxNew;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED) || defined CO_DOXYGEN
+    /** Heartbeat timeout time, compared with CO_HBconsumer_t::time_us */
+    uint32_t deadline_us;
+    /** Position inside CO_HBconsumer_t::heap or CO_HB_CONS_NO_HEAP */
+    uint8_t heapPos;
+    /** Index of this node inside CO_HBconsumer_t::monitoredNodes */
+    uint8_t idx;
+    /** List of nodes with received messages, from CO_HBconsumer_init() */
+    CO_readyList_t *readyList;
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_HBconsumer_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -156,6 +176,31 @@ typedef struct {
     CO_CANmodule_t *CANdevRx;
     /** From CO_HBconsumer_init() */
     uint16_t CANdevRxIdxStart;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED) || defined CO_DOXYGEN
+    /** Bitmap of monitored node-IDs, bit (nodeId & 0x1F) in word
+     * (nodeId >> 5). Bitmaps can be read by the application. */
+    uint32_t monitoredBits[4];
+    /** Bitmap of node-IDs in state CO_HBconsumer_ACTIVE */
+    uint32_t activeBits[4];
+    /** Bitmap of node-IDs, whose last heartbeat was CO_NMT_OPERATIONAL */
+    uint32_t operationalBits[4];
+    /** Bitmap of node-IDs in state CO_HBconsumer_TIMEOUT */
+    uint32_t timeoutBits[4];
+    /** Index+1 inside monitoredNodes for each node-ID, 0 if not monitored */
+    uint8_t nodeIdx[128];
+    /** Sum of timeDifference_us from CO_HBconsumer_process() */
+    uint32_t time_us;
+    /** Binary min-heap of active nodes (indexes), ordered by deadline_us */
+    uint8_t heap[CO_HB_CONS_NODES_MAX];
+    /** Number of nodes in heap */
+    uint8_t heapCount;
+    /** Nodes with received heartbeat, pushed by CAN receive callback */
+    CO_readyList_t readyList;
+    /** Ring buffer for readyList */
+    uint16_t readyRing[CO_HB_CONS_NODES_MAX + 1];
+    /** Flags for readyList */
+    uint8_t readyQueued[CO_HB_CONS_NODES_MAX];
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_OD_DYNAMIC) || defined CO_DOXYGEN
     /** Extension for OD object */
     OD_extension_t OD_1016_extension;
@@ -309,6 +354,9 @@ void CO_HBconsumer_initCallbackRemoteReset(
  * @param NMTisPreOrOperational True if this node is NMT_PRE_OPERATIONAL or NMT_OPERATIONAL.
  * @param timeDifference_us Time difference from previous function call in [microseconds].
  * @param [out] timerNext_us info to OS - see CO_process().
+ *
+ * With CO_CONFIG_HB_CONS_INDEXED only received heartbeats and expired timeouts
+ * are processed.
  */
 void CO_HBconsumer_process(
         CO_HBconsumer_t        *HBcons,
@@ -323,7 +371,8 @@ void CO_HBconsumer_process(
  *
  * @param HBcons This object.
  * @param nodeId producer node ID
- * @return index. -1 if not found
+ * @return index. -1 if not found. With CO_CONFIG_HB_CONS_INDEXED search is
+ * O(1) and only nodes with non-zero consumer time are found.
  */
 int8_t CO_HBconsumer_getIdxByNodeId(
         CO_HBconsumer_t        *HBcons,
@@ -25,6 +25,12 @@
 
 #include "301/CO_Node_Guarding.h"
 
+/* verify configuration */
+#if ((CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER) \
+    && !((CO_CONFIG_TIMERQ) & CO_CONFIG_TIMERQ_ENABLE)
+ #error CO_CONFIG_TIMERQ_ENABLE must be enabled.
+#endif
+
 #if (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE
 
 /*
@@ -274,7 +280,9 @@ void CO_nodeGuardingSlave_process(CO_nodeGuardingSlave_t *ngs,
  * description of parameters see file CO_driver.h.
  *
  * Function receives messages from CAN identifier from 0x700 to 0x7FF. It
- * searches matching node->ident from nodes array.
+ * searches matching node->ident from nodes array or, with
+ * CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER, gets it from the nodeSlot table.
+ * Slot is indexed with the lower 7 bits only, so node->ident is verified too.
  */
 static void CO_ngm_receive(void *object, void *msg) {
     CO_nodeGuardingMaster_t *ngm = (CO_nodeGuardingMaster_t*)object;
@@ -284,6 +292,18 @@ static void CO_ngm_receive(void *object, void *msg) {
     uint16_t ident = CO_CANrxMsg_readIdent(msg);
     CO_nodeGuardingMasterNode_t *node = &ngm->nodes[0];
 
+#if (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER
+    uint8_t slot = ngm->nodeSlot[ident & 0x7F];
+    if (DLC == 1 && slot > 0 && ngm->nodes[slot - 1].ident == ident) {
+        node = &ngm->nodes[slot - 1];
+        uint8_t toggle = data[0] & 0x80;
+        if (toggle == node->toggle) {
+            node->responseRecived = true;
+            node->NMTstate = (CO_NMT_internalState_t)(data[0] & 0x7F);
+            node->toggle = (toggle != 0) ? 0x00 : 0x80;
+        }
+    }
+#else
     if (DLC == 1) {
         for (uint8_t i=0; i<CO_CONFIG_NODE_GUARDING_MASTER_COUNT; i++) {
             if (ident == node->ident) {
@@ -298,7 +318,34 @@ static void CO_ngm_receive(void *object, void *msg) {
             node ++;
         }
     }
+#endif
+}
+
+
+#if (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER
+/* Calculate allMonitoredActive and allMonitoredOperational */
+static void CO_ngm_updateAllMonitored(CO_nodeGuardingMaster_t *ngm) {
+    bool_t allMonitoredActiveCurrent = true;
+    bool_t allMonitoredOperationalCurrent = true;
+    CO_nodeGuardingMasterNode_t *node = &ngm->nodes[0];
+
+    for (uint8_t i = 0; i < CO_CONFIG_NODE_GUARDING_MASTER_COUNT; i++) {
+        if (node->guardTime_us > 0 && node->ident > CO_CAN_ID_HEARTBEAT) {
+            if (!node->monitoringActive) {
+                allMonitoredActiveCurrent = false;
+                allMonitoredOperationalCurrent = false;
+                break;
+            }
+            if (node->NMTstate != CO_NMT_OPERATIONAL) {
+                allMonitoredOperationalCurrent = false;
+            }
+        }
+        node ++;
+    }
+    ngm->allMonitoredActive = allMonitoredActiveCurrent;
+    ngm->allMonitoredOperational = allMonitoredOperationalCurrent;
 }
+#endif
 
 
 /******************************************************************************/
@@ -321,6 +368,17 @@ CO_ReturnError_t CO_nodeGuardingMaster_init(CO_nodeGuardingMaster_t *ngm,
 
     /* Configure object variables */
     ngm->em = em;
+#if (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER
+    ret = CO_timerQueue_init(&ngm->timerQueue, ngm->timerItems,
+                             CO_CONFIG_NODE_GUARDING_MASTER_COUNT);
+    if (ret != CO_ERROR_NO) {
+        return ret;
+    }
+    ngm->rtrCredit_us = (uint32_t)CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL
+                        * CO_CONFIG_NODE_GUARDING_MASTER_RTR_BURST;
+    ngm->allMonitoredActive = true;
+    ngm->allMonitoredOperational = true;
+#endif
 
     /* configure CAN reception. One buffer will receive all messages
      * from CAN-id 0x700 to 0x7FF. */
@@ -384,10 +442,116 @@ CO_ReturnError_t CO_nodeGuardingMaster_initNode(CO_nodeGuardingMaster_t *ngm,
                                         true, 1, 0);
 #endif
 
+#if (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER
+    /* node-ID of the slot may change */
+    for (uint8_t id = 0; id < 0x80; id++) {
+        if (ngm->nodeSlot[id] == index + 1) {
+            ngm->nodeSlot[id] = 0;
+        }
+    }
+    if (node->guardTime_us > 0) {
+        ngm->nodeSlot[nodeId] = index + 1;
+        CO_timerQueue_set(&ngm->timerQueue, index,
+                          (node->guardTime_us
+                           / CO_CONFIG_NODE_GUARDING_MASTER_COUNT) * index);
+    }
+    else {
+        CO_timerQueue_remove(&ngm->timerQueue, index);
+    }
+    CO_ngm_updateAllMonitored(ngm);
+#endif
+
     return  CO_ERROR_NO;
 }
 
 
+/* Verify response to the previous rtr of the node, see
+ * CO_nodeGuardingMaster_process() */
+static void CO_ngm_checkResponse(CO_nodeGuardingMaster_t *ngm,
+                                 CO_nodeGuardingMasterNode_t *node)
+{
+    if (!node->CANtxWasBusy) {
+        if (!node->responseRecived) {
+            node->monitoringActive = false;
+            /* error bit is shared with HB consumer */
+            CO_errorReport(ngm->em, CO_EM_HEARTBEAT_CONSUMER,
+                           CO_EMC_HEARTBEAT, node->ident & 0x7F);
+        }
+        else if (node->NMTstate != CO_NMT_UNKNOWN) {
+            node->monitoringActive = true;
+            CO_errorReset(ngm->em, CO_EM_HEARTBEAT_CONSUMER,
+                          node->ident & 0x7F);
+        }
+    }
+}
+
+
+#if (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER
+/******************************************************************************/
+void CO_nodeGuardingMaster_process(CO_nodeGuardingMaster_t *ngm,
+                                   uint32_t timeDifference_us,
+                                   uint32_t *timerNext_us)
+{
+    CO_timerQueue_t *tq = &ngm->timerQueue;
+    const uint32_t rtrCost = CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL;
+    const uint32_t rtrCreditMax = rtrCost
+                                  * CO_CONFIG_NODE_GUARDING_MASTER_RTR_BURST;
+    bool_t changed = false;
+    uint16_t i;
+
+    CO_timerQueue_advance(tq, timeDifference_us);
+    ngm->rtrCredit_us = (timeDifference_us < (rtrCreditMax - ngm->rtrCredit_us))
+                      ? (ngm->rtrCredit_us + timeDifference_us) : rtrCreditMax;
+
+    /* Only nodes with expired guard timer are processed, in order of their
+     * deadlines */
+    while ((i = CO_timerQueue_popExpired(tq)) != CO_TIMERQ_NONE) {
+        CO_nodeGuardingMasterNode_t *node = &ngm->nodes[i];
+
+        if (ngm->rtrCredit_us < rtrCost) {
+            /* bus load limit, send when enough credit is collected */
+            CO_timerQueue_set(tq, i, rtrCost - ngm->rtrCredit_us);
+            break;
+        }
+
+        /* it is time to send new rtr, but first verify last response */
+        CO_ngm_checkResponse(ngm, node);
+        changed = true;
+
+        if (ngm->CANtxBuff->bufferFull) {
+            /* retry on next processing */
+            node->CANtxWasBusy = true;
+            CO_timerQueue_set(tq, i, 0);
+            break;
+        }
+
+#if CO_CONFIG_NODE_GUARDING_MASTER_COUNT > 1
+        ngm->CANtxBuff = CO_CANtxBufferInit(ngm->CANdevTx,
+                                            ngm->CANdevTxIdx,
+                                            node->ident,
+                                            true, 1, 0);
+#endif
+        CO_CANsend(ngm->CANdevTx, ngm->CANtxBuff);
+        node->CANtxWasBusy = false;
+        node->responseRecived = false;
+        ngm->rtrCredit_us -= rtrCost;
+        CO_timerQueue_set(tq, i, node->guardTime_us);
+    }
+
+    /* Monitoring state changes only, when some node was verified */
+    if (changed) {
+        CO_ngm_updateAllMonitored(ngm);
+    }
+
+#if (CO_CONFIG_NMT) & CO_CONFIG_FLAG_TIMERNEXT
+    CO_timerQueue_timerNext(tq, timerNext_us);
+#else
+    (void)timerNext_us;
+#endif
+}
+
+#else /* (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER */
+
 /******************************************************************************/
 void CO_nodeGuardingMaster_process(CO_nodeGuardingMaster_t *ngm,
                                    uint32_t timeDifference_us,
@@ -411,19 +575,7 @@ void CO_nodeGuardingMaster_process(CO_nodeGuardingMaster_t *ngm,
             }
             else {
                 /* it is time to send new rtr, but first verify last response */
-                if (!node->CANtxWasBusy) {
-                    if (!node->responseRecived) {
-                        node->monitoringActive = false;
-                        /* error bit is shared with HB consumer */
-                        CO_errorReport(ngm->em, CO_EM_HEARTBEAT_CONSUMER,
-                                       CO_EMC_HEARTBEAT, node->ident & 0x7F);
-                    }
-                    else if (node->NMTstate != CO_NMT_UNKNOWN) {
-                        node->monitoringActive = true;
-                        CO_errorReset(ngm->em, CO_EM_HEARTBEAT_CONSUMER,
-                                      node->ident & 0x7F);
-                    }
-                }
+                CO_ngm_checkResponse(ngm, node);
 
                 if (ngm->CANtxBuff->bufferFull) {
                     node->guardTimer = 0;
@@ -464,5 +616,6 @@ void CO_nodeGuardingMaster_process(CO_nodeGuardingMaster_t *ngm,
 
     return;
 }
+#endif /* (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER */
 
 #endif /* (CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_ENABLE */
@@ -30,6 +30,7 @@
 #include "301/CO_ODinterface.h"
 #include "301/CO_Emergency.h"
 #include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_timerQueue.h"
 
 /* default configuration, see CO_config.h */
 #ifndef CO_CONFIG_NODE_GUARDING
@@ -38,6 +39,12 @@
 #ifndef CO_CONFIG_NODE_GUARDING_MASTER_COUNT
 #define CO_CONFIG_NODE_GUARDING_MASTER_COUNT 0x7F
 #endif
+#ifndef CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL
+#define CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL 500
+#endif
+#ifndef CO_CONFIG_NODE_GUARDING_MASTER_RTR_BURST
+#define CO_CONFIG_NODE_GUARDING_MASTER_RTR_BURST 4
+#endif
 
 #if ((CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE) || defined CO_DOXYGEN
 
@@ -243,6 +250,17 @@ typedef struct {
     bool_t allMonitoredOperational;
     /** Array of monitored nodes */
     CO_nodeGuardingMasterNode_t nodes[CO_CONFIG_NODE_GUARDING_MASTER_COUNT];
+#if ((CO_CONFIG_NODE_GUARDING) & CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER) || defined CO_DOXYGEN
+    /** Guard timers of the nodes, timer id is index in nodes array */
+    CO_timerQueue_t timerQueue;
+    /** Items for timerQueue */
+    CO_timerQueue_item_t timerItems[CO_CONFIG_NODE_GUARDING_MASTER_COUNT];
+    /** Index in nodes array plus one for each node-ID, 0 if not monitored */
+    uint8_t nodeSlot[0x80];
+    /** Token bucket for RTR messages in microseconds, one message costs
+     * CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL */
+    uint32_t rtrCredit_us;
+#endif
 } CO_nodeGuardingMaster_t;
 
 /**
@@ -276,7 +294,13 @@ CO_ReturnError_t CO_nodeGuardingMaster_init(CO_nodeGuardingMaster_t *ngm,
  * @param index Index of the slot, which will be configured.
  * 0 <= index < CO_CONFIG_NODE_GUARDING_MASTER_COUNT.
  * @param nodeId Node Id of the monitored node.
- * @param guardTime_ms Guard time of the monitored node.
+ * @param guardTime_ms Guard time of the monitored node. If 0, monitoring is
+ * disabled.
+ *
+ * With CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER the first RTR message for the
+ * node is delayed by (index / CO_CONFIG_NODE_GUARDING_MASTER_COUNT) part of
+ * the guard time. This way RTR messages for nodes with equal guard time are
+ * spread evenly over the guard time.
  *
  * @return #CO_ReturnError_t CO_ERROR_NO on success.
  */
@@ -0,0 +1,369 @@
+/*
+ * Loader of binary Object Dictionary image
+ *
+ * @file        CO_ODimage.c
+ * @ingroup     CO_ODimage
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define OD_DEFINITION
+#include "301/CO_ODimage.h"
+#include "301/CO_endian.h"
+
+#if OD_IMAGE_MMAP
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define OD_IMAGE_HEADER_SIZE 16U
+#define OD_IMAGE_ENTRY_SIZE 8U
+#define OD_IMAGE_SUB_SIZE 12U
+/* Bit in flags, set after data was converted to native byte order */
+#define OD_IMAGE_FLAG_NATIVE 0x01U
+
+/* Sections of the image */
+typedef struct {
+    const uint8_t *entries;
+    const uint8_t *subs;
+    uint8_t *data;
+    uint16_t entryCount;
+    uint32_t subCount;
+    uint32_t dataSize;
+} OD_imageLayout_t;
+
+
+static inline uint16_t OD_image_u16(const uint8_t *p) {
+    return (uint16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+static inline uint32_t OD_image_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16)
+           | ((uint32_t)p[3] << 24);
+}
+
+/* Verify header and sizes of sections */
+static bool_t OD_image_layout(const void *image, size_t imageSize,
+                              OD_imageLayout_t *l)
+{
+    const uint8_t *img = (const uint8_t *)image;
+    uint64_t dataStart;
+
+    if (image == NULL || imageSize < OD_IMAGE_HEADER_SIZE
+        || OD_image_u32(&img[0]) != OD_IMAGE_MAGIC
+        || img[4] != OD_IMAGE_VERSION
+    ) {
+        return false;
+    }
+    l->entryCount = OD_image_u16(&img[6]);
+    l->subCount = OD_image_u32(&img[8]);
+    l->dataSize = OD_image_u32(&img[12]);
+
+    /* data starts at 8 byte boundary */
+    dataStart = OD_IMAGE_HEADER_SIZE
+                + (uint64_t)l->entryCount * OD_IMAGE_ENTRY_SIZE
+                + (uint64_t)l->subCount * OD_IMAGE_SUB_SIZE;
+    dataStart = (dataStart + 7U) & ~(uint64_t)7U;
+    if (dataStart + l->dataSize > imageSize) {
+        return false;
+    }
+
+    l->entries = &img[OD_IMAGE_HEADER_SIZE];
+    l->subs = &l->entries[(size_t)l->entryCount * OD_IMAGE_ENTRY_SIZE];
+    l->data = (uint8_t *)image + (size_t)dataStart;
+    return true;
+}
+
+/* Data of sub-object description, count elements must fit into data */
+static bool_t OD_image_subValid(const OD_imageLayout_t *l, uint32_t sub,
+                                uint32_t count)
+{
+    const uint8_t *s = &l->subs[(size_t)sub * OD_IMAGE_SUB_SIZE];
+    uint32_t length = OD_image_u32(&s[4]);
+    uint32_t offset = OD_image_u32(&s[8]);
+
+    return offset == OD_IMAGE_NO_DATA
+           || ((uint64_t)offset + (uint64_t)length * count) <= l->dataSize;
+}
+
+static inline void *OD_image_subData(const OD_imageLayout_t *l, uint32_t sub) {
+    uint32_t offset = OD_image_u32(&l->subs[(size_t)sub * OD_IMAGE_SUB_SIZE
+                                            + 8U]);
+    return offset == OD_IMAGE_NO_DATA ? NULL : &l->data[offset];
+}
+
+/* Number of sub-object descriptions of the entry, 0 if type is wrong */
+static uint32_t OD_image_subCount(uint8_t odObjectType,
+                                  uint8_t subEntriesCount)
+{
+    switch (odObjectType) {
+    case ODT_VAR: return 1U;
+    case ODT_ARR: return 2U;
+    case ODT_REC: return subEntriesCount;
+    default: return 0U;
+    }
+}
+
+
+/******************************************************************************/
+size_t OD_image_memSize(const void *image, size_t imageSize) {
+    OD_imageLayout_t l;
+    size_t size;
+    uint16_t i;
+
+    if (!OD_image_layout(image, imageSize, &l)) {
+        return 0;
+    }
+    size = ((size_t)l.entryCount + 1U) * sizeof(OD_entry_t);
+
+    for (i = 0; i < l.entryCount; i++) {
+        const uint8_t *e = &l.entries[(size_t)i * OD_IMAGE_ENTRY_SIZE];
+        uint8_t subEntriesCount = e[2];
+        uint8_t odObjectType = e[3];
+        uint32_t first = OD_image_u32(&e[4]);
+        uint32_t n = OD_image_subCount(odObjectType, subEntriesCount);
+        uint32_t k;
+
+        if ((i > 0U && OD_image_u16(&e[-8]) >= OD_image_u16(&e[0]))
+            || subEntriesCount == 0U || n == 0U
+            || (uint64_t)first + n > l.subCount
+        ) {
+            return 0;
+        }
+
+        if (odObjectType == ODT_VAR) {
+            if (subEntriesCount != 1U || !OD_image_subValid(&l, first, 1U)) {
+                return 0;
+            }
+            size += sizeof(OD_obj_var_t);
+        }
+        else if (odObjectType == ODT_ARR) {
+            /* sub-index 0 is uint8_t, elements follow each other */
+            const uint8_t *s0 = &l.subs[(size_t)first * OD_IMAGE_SUB_SIZE];
+            if (OD_image_u32(&s0[4]) != 1U
+                || !OD_image_subValid(&l, first, 1U)
+                || !OD_image_subValid(&l, first + 1U,
+                                      (uint32_t)subEntriesCount - 1U)
+            ) {
+                return 0;
+            }
+            size += sizeof(OD_obj_array_t);
+        }
+        else {
+            for (k = 0; k < n; k++) {
+                const uint8_t *s = &l.subs[(size_t)(first + k)
+                                           * OD_IMAGE_SUB_SIZE];
+                if ((k > 0U && s[-(int)OD_IMAGE_SUB_SIZE] >= s[0])
+                    || !OD_image_subValid(&l, first + k, 1U)
+                ) {
+                    return 0;
+                }
+            }
+            size += (size_t)n * sizeof(OD_obj_record_t);
+        }
+    }
+
+    return size;
+}
+
+
+#ifdef CO_BIG_ENDIAN
+/* Convert multi-byte variables of the image to native byte order, once */
+static void OD_image_toNative(OD_imageLayout_t *l, uint8_t *flags) {
+    uint16_t i;
+
+    if ((*flags & OD_IMAGE_FLAG_NATIVE) != 0U) {
+        return;
+    }
+    for (i = 0; i < l->entryCount; i++) {
+        const uint8_t *e = &l->entries[(size_t)i * OD_IMAGE_ENTRY_SIZE];
+        uint32_t first = OD_image_u32(&e[4]);
+        uint32_t n = OD_image_subCount(e[3], e[2]);
+        uint32_t k;
+
+        for (k = 0; k < n; k++) {
+            const uint8_t *s = &l->subs[(size_t)(first + k)
+                                        * OD_IMAGE_SUB_SIZE];
+            uint32_t length = OD_image_u32(&s[4]);
+            uint8_t *data = (uint8_t *)OD_image_subData(l, first + k);
+            /* array elements share one description */
+            uint32_t count = (e[3] == ODT_ARR && k == 1U) ? e[2] - 1U : 1U;
+
+            if ((s[1] & ODA_MB) == 0U || data == NULL) {
+                continue;
+            }
+            while (count-- > 0U) {
+                CO_swapBytes(data, length);
+                data += length;
+            }
+        }
+    }
+    *flags |= OD_IMAGE_FLAG_NATIVE;
+}
+#endif
+
+
+/******************************************************************************/
+CO_ReturnError_t OD_image_load(OD_t *od,
+                               void *image,
+                               size_t imageSize,
+                               void *mem,
+                               size_t memSize)
+{
+    OD_imageLayout_t l;
+    OD_entry_t *list;
+    uint8_t *obj;
+    size_t size;
+    uint16_t i;
+
+    if (od == NULL || image == NULL || mem == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    size = OD_image_memSize(image, imageSize);
+    if (size == 0U || !OD_image_layout(image, imageSize, &l)) {
+        return CO_ERROR_DATA_CORRUPT;
+    }
+    if (memSize < size) {
+        return CO_ERROR_OUT_OF_MEMORY;
+    }
+#ifdef CO_BIG_ENDIAN
+    OD_image_toNative(&l, &((uint8_t *)image)[5]);
+#endif
+
+    memset(mem, 0, size);
+    list = (OD_entry_t *)mem;
+    obj = (uint8_t *)mem + ((size_t)l.entryCount + 1U) * sizeof(OD_entry_t);
+
+    for (i = 0; i < l.entryCount; i++) {
+        const uint8_t *e = &l.entries[(size_t)i * OD_IMAGE_ENTRY_SIZE];
+        OD_entry_t *entry = &list[i];
+        uint32_t first = OD_image_u32(&e[4]);
+        const uint8_t *s = &l.subs[(size_t)first * OD_IMAGE_SUB_SIZE];
+
+        entry->index = OD_image_u16(&e[0]);
+        entry->subEntriesCount = e[2];
+        entry->odObjectType = e[3];
+        entry->odObject = obj;
+        entry->extension = NULL;
+
+        if (entry->odObjectType == ODT_VAR) {
+            OD_obj_var_t *var = (OD_obj_var_t *)(void *)obj;
+            var->dataOrig = OD_image_subData(&l, first);
+            var->attribute = (OD_attr_t)s[1];
+            var->dataLength = (OD_size_t)OD_image_u32(&s[4]);
+            obj += sizeof(OD_obj_var_t);
+        }
+        else if (entry->odObjectType == ODT_ARR) {
+            OD_obj_array_t *arr = (OD_obj_array_t *)(void *)obj;
+            const uint8_t *s1 = &s[OD_IMAGE_SUB_SIZE];
+            arr->dataOrig0 = (uint8_t *)OD_image_subData(&l, first);
+            arr->attribute0 = (OD_attr_t)s[1];
+            arr->dataOrig = OD_image_subData(&l, first + 1U);
+            arr->attribute = (OD_attr_t)s1[1];
+            arr->dataElementLength = (OD_size_t)OD_image_u32(&s1[4]);
+            arr->dataElementSizeof = arr->dataElementLength;
+            obj += sizeof(OD_obj_array_t);
+        }
+        else {
+            OD_obj_record_t *rec = (OD_obj_record_t *)(void *)obj;
+            uint8_t k;
+            for (k = 0; k < entry->subEntriesCount; k++) {
+                const uint8_t *sk = &s[(size_t)k * OD_IMAGE_SUB_SIZE];
+                rec[k].dataOrig = OD_image_subData(&l, first + k);
+                rec[k].subIndex = sk[0];
+                rec[k].attribute = (OD_attr_t)sk[1];
+                rec[k].dataLength = (OD_size_t)OD_image_u32(&sk[4]);
+            }
+            obj += (size_t)entry->subEntriesCount * sizeof(OD_obj_record_t);
+        }
+    }
+
+    od->size = l.entryCount;
+    od->list = list;
+#if OD_FIND_LOOKUP
+    od->lookup = NULL;
+#endif
+    return CO_ERROR_NO;
+}
+
+
+#if OD_IMAGE_MMAP
+/******************************************************************************/
+CO_ReturnError_t OD_image_mapFile(OD_imageFile_t *imgFile, const char *path) {
+    CO_ReturnError_t ret;
+    struct stat st;
+    size_t memSize;
+    int fd;
+
+    if (imgFile == NULL || path == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    memset(imgFile, 0, sizeof(*imgFile));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return CO_ERROR_SYSCALL;
+    }
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+        (void)close(fd);
+        return CO_ERROR_SYSCALL;
+    }
+    /* private writable mapping: written pages are copied, file is unchanged */
+    imgFile->imageSize = (size_t)st.st_size;
+    imgFile->image = mmap(NULL, imgFile->imageSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (imgFile->image == MAP_FAILED) {
+        imgFile->image = NULL;
+        return CO_ERROR_SYSCALL;
+    }
+
+    memSize = OD_image_memSize(imgFile->image, imgFile->imageSize);
+    if (memSize == 0U) {
+        ret = CO_ERROR_DATA_CORRUPT;
+    }
+    else {
+        imgFile->mem = malloc(memSize);
+        ret = imgFile->mem == NULL
+            ? CO_ERROR_OUT_OF_MEMORY
+            : OD_image_load(&imgFile->od, imgFile->image, imgFile->imageSize,
+                            imgFile->mem, memSize);
+    }
+    if (ret != CO_ERROR_NO) {
+        OD_image_unmapFile(imgFile);
+    }
+    return ret;
+}
+
+
+/******************************************************************************/
+void OD_image_unmapFile(OD_imageFile_t *imgFile) {
+    if (imgFile == NULL) {
+        return;
+    }
+    free(imgFile->mem);
+    if (imgFile->image != NULL) {
+        (void)munmap(imgFile->image, imgFile->imageSize);
+    }
+    memset(imgFile, 0, sizeof(*imgFile));
+}
+#endif /* OD_IMAGE_MMAP */
@@ -0,0 +1,165 @@
+/**
+ * Loader of binary Object Dictionary image
+ *
+ * @file        CO_ODimage.h
+ * @ingroup     CO_ODimage
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_OD_IMAGE_H
+#define CO_OD_IMAGE_H
+
+#include "301/CO_ODinterface.h"
+
+#ifndef OD_IMAGE_MMAP
+/** If 1, then OD_image_mapFile() is available, which uses POSIX mmap(). */
+#define OD_IMAGE_MMAP 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_ODimage OD image
+ * Object Dictionary loaded at run time from binary image.
+ *
+ * @ingroup CO_ODinterface
+ * @{
+ *
+ * Object Dictionary is usually compiled into the program (OD.c file). Gateway,
+ * configuration tool or simulator, which serves many different device types,
+ * may instead load OD from binary image, generated from EDS or XDD file with
+ * tools/odimage.py. One program then serves any number of device profiles.
+ *
+ * OD_image_load() builds @ref OD_t with OD_entry_t list and odObjects in
+ * memory provided by application, size is from OD_image_memSize(). Data of
+ * OD variables stays inside the image, which contains default values, so
+ * image must be writable and must stay valid while OD is used. Loading takes
+ * one pass through the entries, nothing is parsed or copied.
+ *
+ * OD_image_mapFile() maps image file with MAP_PRIVATE. Operating system reads
+ * pages on first access and copies only pages, which are written, so default
+ * values are copied to RAM lazily. File itself is never modified. Many OD
+ * images of the same file share unmodified pages.
+ *
+ * Image format, all values little endian:
+ * - Header, 16 bytes: magic "COOD", version (1), flags (0), entryCount
+ *   (uint16), subCount (uint32), dataSize (uint32).
+ * - Entries, 8 bytes each, ordered by index: index (uint16), subEntriesCount,
+ *   odObjectType (@ref OD_objectTypes_t), first (uint32), which is position of
+ *   the first sub-object description. VAR has one description, ARRAY two
+ *   (sub-index 0 and elements) and RECORD one for each sub-entry.
+ * - Sub-object descriptions, 12 bytes each: subIndex, attribute
+ *   (@ref OD_attributes_t), 2 reserved bytes, dataLength (uint32), dataOffset
+ *   (uint32) from the start of data or OD_IMAGE_NO_DATA. Array elements follow
+ *   each other at dataOffset.
+ * - Data with default values of all variables, which starts at the next 8
+ *   byte boundary. Each variable is aligned to its length, up to 8 bytes.
+ *
+ * On big endian targets multi-byte variables (ODA_MB) are converted to native
+ * byte order in place by the first OD_image_load() on the image.
+ *
+ * Extensions can be added to loaded OD entries with OD_extension_init().
+ * C2000 is not supported (CHAR_BIT must be 8).
+ */
+
+/** Magic number at the start of OD image, "COOD" */
+#define OD_IMAGE_MAGIC 0x444F4F43UL
+/** Version of OD image format */
+#define OD_IMAGE_VERSION 1U
+/** Value of dataOffset for variables without data in OD, accessed only by
+ * extension (DOMAIN or variable without default value) */
+#define OD_IMAGE_NO_DATA 0xFFFFFFFFUL
+
+
+/**
+ * Get size of memory for OD_image_load().
+ *
+ * Function also verifies structure of the image.
+ *
+ * @param image Pointer to OD image.
+ * @param imageSize Size of OD image in bytes.
+ *
+ * @return Number of bytes or 0, if image is not valid.
+ */
+size_t OD_image_memSize(const void *image, size_t imageSize);
+
+
+/**
+ * Build Object Dictionary from image.
+ *
+ * @param [out] od Object Dictionary to initialize. Its list points into mem.
+ * @param image Pointer to OD image, aligned to 8 bytes, writable. OD variables
+ * point into it.
+ * @param imageSize Size of OD image in bytes.
+ * @param mem Memory for OD entries and odObjects, aligned as pointer.
+ * @param memSize Size of mem, at least OD_image_memSize().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
+ * CO_ERROR_DATA_CORRUPT (wrong image) or CO_ERROR_OUT_OF_MEMORY (mem too
+ * small).
+ */
+CO_ReturnError_t OD_image_load(OD_t *od,
+                               void *image,
+                               size_t imageSize,
+                               void *mem,
+                               size_t memSize);
+
+
+#if OD_IMAGE_MMAP || defined CO_DOXYGEN
+/**
+ * Object Dictionary loaded from file, see OD_image_mapFile().
+ */
+typedef struct {
+    OD_t od;          /**< Object Dictionary */
+    void *image;      /**< Mapped file */
+    size_t imageSize; /**< Size of the file */
+    void *mem;        /**< Allocated memory for OD entries and odObjects */
+} OD_imageFile_t;
+
+
+/**
+ * Map OD image file into memory and load Object Dictionary from it.
+ *
+ * @param [out] imgFile Object to initialize, OD is in imgFile->od.
+ * @param path Path to the OD image file.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT,
+ * CO_ERROR_SYSCALL, CO_ERROR_OUT_OF_MEMORY or CO_ERROR_DATA_CORRUPT.
+ */
+CO_ReturnError_t OD_image_mapFile(OD_imageFile_t *imgFile, const char *path);
+
+
+/**
+ * Release memory of OD image file. OD must not be used anymore.
+ *
+ * @param imgFile Object from OD_image_mapFile().
+ */
+void OD_image_unmapFile(OD_imageFile_t *imgFile);
+#endif /* OD_IMAGE_MMAP */
+
+/** @} */ /* CO_ODimage */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_OD_IMAGE_H */
@@ -25,9 +25,23 @@
 #include <string.h>
 #define OD_DEFINITION
 #include "301/CO_ODinterface.h"
+#include "301/CO_endian.h"
 
 
 /******************************************************************************/
+#if (C2000_PORT != 0)
+/* Number of 16-bit memory units, which hold count bytes of OD variable. On
+ * C2000 uint8_t and uint16_t variables are single unit, strings are copied
+ * as-is. */
+static inline OD_size_t OD_memUnits(const OD_stream_t *stream, OD_size_t count)
+{
+    if ((stream->attribute & ODA_STR) != 0) {
+        return count;
+    }
+    return (stream->dataLength <= 2) ? 1 : (count / 2);
+}
+#endif
+
 ODR_t OD_readOriginal(OD_stream_t *stream, void *buf,
                       OD_size_t count, OD_size_t *countRead)
 {
@@ -66,17 +80,7 @@ ODR_t OD_readOriginal(OD_stream_t *stream, void *buf,
     }
 
 #if (C2000_PORT != 0)
-    if((stream->attribute & ODA_STR) == 0) {
-        if(stream->dataLength <= 2) {
-            /* For C2000, length of uint8_t and uint16_t OD variable is 1 */
-            memcpy(buf, dataOrig, 1);
-        } else {
-            memcpy(buf, dataOrig, dataLenToCopy / 2);
-        }
-    } else {
-        /* As-is for string */
-        memcpy(buf, dataOrig, dataLenToCopy);
-    }
+    memcpy(buf, dataOrig, OD_memUnits(stream, dataLenToCopy));
 #else
     memcpy(buf, dataOrig, dataLenToCopy);
 #endif
@@ -131,25 +135,45 @@ ODR_t OD_writeOriginal(OD_stream_t *stream, const void *buf,
     }
 
 #if (C2000_PORT != 0)
-    if((stream->attribute & ODA_STR) == 0) {
-        if(stream->dataLength <= 2) {
-            /* For C2000, length of uint8_t and uint16_t OD variable is 1 */
-            memcpy(dataOrig, buf, 1);
-        } else {
-            memcpy(dataOrig, buf, dataLenToCopy / 2);
-        }
-    } else {
-        /* As-is for string */
-        memcpy(dataOrig, buf, dataLenToCopy);
-    }
+    memcpy(dataOrig, buf, OD_memUnits(stream, dataLenToCopy));
 #else
     memcpy(dataOrig, buf, dataLenToCopy);
 #endif
+    OD_WRITE_HOOK(dataOrig, dataLenToCopy);
 
     *countWritten = dataLenToCopy;
     return returnCode;
 }
 
+#if OD_FLAGS_PDO_SIZE > 0
+ODR_t OD_writeOnChange(OD_stream_t *stream, const void *buf,
+                       OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    bool_t changed = true;
+    if (stream->dataOrig != NULL && stream->dataOffset == 0
+        && count == stream->dataLength
+    ) {
+        OD_size_t lenToCompare = count;
+#if (C2000_PORT != 0)
+        lenToCompare = OD_memUnits(stream, count);
+#endif
+        changed = memcmp(stream->dataOrig, buf, lenToCompare) != 0;
+    }
+
+    ODR_t returnCode = OD_writeOriginal(stream, buf, count, countWritten);
+
+    if (returnCode == ODR_OK && changed && stream->object != NULL) {
+        OD_extension_t *extension = (OD_extension_t *)stream->object;
+        OD_requestTPDO(&extension->flagsPDO[0], stream->subIndex);
+    }
+    return returnCode;
+}
+#endif
+
 /* Read value from variable from Object Dictionary disabled, see OD_IO_t*/
 static ODR_t OD_readDisabled(OD_stream_t *stream, void *buf,
                              OD_size_t count, OD_size_t *countRead)
@@ -173,6 +197,25 @@ OD_entry_t *OD_find(OD_t *od, uint16_t index) {
         return NULL;
     }
 
+#if OD_FIND_LOOKUP
+    if (od->lookup != NULL) {
+        uint16_t page = (uint16_t)(index >> 8) - od->lookup->pageFirst;
+
+        /* indexes below pageFirst or lowFirst wrap to large values */
+        if (page < od->lookup->pageCount) {
+            CO_PROGMEM OD_lookupPage_t *p = &od->lookup->pages[page];
+            uint16_t low = (uint16_t)(index & 0xFFU) - p->lowFirst;
+            uint16_t pos;
+
+            if (low >= p->lowCount) {
+                return NULL;
+            }
+            pos = p->entryPos[low];
+            return (pos < od->size) ? &od->list[pos] : NULL;
+        }
+    }
+#endif
+
     uint16_t min = 0;
     uint16_t max = od->size - 1;
 
@@ -206,6 +249,87 @@ OD_entry_t *OD_find(OD_t *od, uint16_t index) {
     return NULL;  /* entry does not exist in OD */
 }
 
+/* Set read/write functions and informative data inside io for OD_getSub() */
+static void OD_getSubIO(const OD_entry_t *entry, uint8_t subIndex,
+                        OD_IO_t *io, bool_t odOrig)
+{
+    OD_stream_t *stream = &io->stream;
+
+    /* Access data from the original OD location */
+    if (entry->extension == NULL || odOrig) {
+        io->read = OD_readOriginal;
+        io->write = OD_writeOriginal;
+        stream->object = NULL;
+    }
+    /* Access data from extension specified by application */
+    else {
+        io->read = entry->extension->read != NULL ?
+                   entry->extension->read : OD_readDisabled;
+        io->write = entry->extension->write != NULL ?
+                    entry->extension->write : OD_writeDisabled;
+        stream->object = entry->extension->object;
+    }
+
+    /* Reset stream data offset */
+    stream->dataOffset = 0;
+
+    /* Add informative data */
+    stream->index = entry->index;
+    stream->subIndex = subIndex;
+}
+
+#if OD_INSTANCES
+/* Redirect variable of the template into the region of the instance */
+static void *OD_instanceData(const OD_instance_t *instance, void *dataOrig) {
+    const uint8_t *ptr = (const uint8_t *)dataOrig;
+
+    for (uint8_t i = 0; i < instance->regionCount; i++) {
+        const OD_instanceRegion_t *r = &instance->regions[i];
+        const uint8_t *orig = (const uint8_t *)r->orig;
+
+        if (ptr >= orig && ptr < &orig[r->size]) {
+            return (uint8_t *)r->data + (ptr - orig);
+        }
+    }
+    return dataOrig;
+}
+
+/******************************************************************************/
+ODR_t OD_instance_init(OD_t *od, OD_entry_t *list, const OD_t *tmpl,
+                       const OD_instance_t *instance)
+{
+    if (od == NULL || list == NULL || tmpl == NULL || tmpl->list == NULL
+        || instance == NULL || (instance->regionCount > 0U
+                                && instance->regions == NULL)
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    for (uint8_t i = 0; i < instance->regionCount; i++) {
+        const OD_instanceRegion_t *r = &instance->regions[i];
+        if (r->data == NULL || r->orig == NULL) {
+            return ODR_DEV_INCOMPAT;
+        }
+        memcpy(r->data, r->orig, r->size);
+    }
+
+    /* list includes the last, blank element */
+    for (uint16_t i = 0; i <= tmpl->size; i++) {
+        list[i] = tmpl->list[i];
+        list[i].extension = NULL;
+        list[i].instance = instance;
+    }
+
+    od->size = tmpl->size;
+    od->list = list;
+#if OD_FIND_LOOKUP
+    /* positions inside the list are the same */
+    od->lookup = tmpl->lookup;
+#endif
+    return ODR_OK;
+}
+#endif
+
 /******************************************************************************/
 ODR_t OD_getSub(const OD_entry_t *entry, uint8_t subIndex,
                 OD_IO_t *io, bool_t odOrig)
@@ -266,31 +390,478 @@ ODR_t OD_getSub(const OD_entry_t *entry, uint8_t subIndex,
     }
     }
 
-    /* Access data from the original OD location */
-    if (entry->extension == NULL || odOrig) {
-        io->read = OD_readOriginal;
-        io->write = OD_writeOriginal;
-        stream->object = NULL;
+#if OD_INSTANCES
+    if (entry->instance != NULL && stream->dataOrig != NULL) {
+        stream->dataOrig = OD_instanceData(entry->instance, stream->dataOrig);
     }
-    /* Access data from extension specified by application */
-    else {
-        io->read = entry->extension->read != NULL ?
-                   entry->extension->read : OD_readDisabled;
-        io->write = entry->extension->write != NULL ?
-                    entry->extension->write : OD_writeDisabled;
-        stream->object = entry->extension->object;
+#endif
+
+    OD_getSubIO(entry, subIndex, io, odOrig);
+
+    return ODR_OK;
+}
+
+#if OD_SUB_CACHE_SIZE > 0
+#if (OD_SUB_CACHE_SIZE & (OD_SUB_CACHE_SIZE - 1)) != 0
+#error OD_SUB_CACHE_SIZE must be power of two.
+#endif
+/******************************************************************************/
+ODR_t OD_getSubCached(OD_subCache_t *cache, OD_t *od, uint16_t index,
+                      uint8_t subIndex, OD_IO_t *io, bool_t odOrig)
+{
+    OD_entry_t *entry;
+    OD_subCacheLine_t *line;
+    ODR_t ret;
+
+    if (cache == NULL) {
+        return OD_getSub(OD_find(od, index), subIndex, io, odOrig);
+    }
+    if (io == NULL) { return ODR_DEV_INCOMPAT; }
+    if (cache->od != od) {
+        OD_subCache_clear(cache);
+        cache->od = od;
     }
 
-    /* Reset stream data offset */
-    stream->dataOffset = 0;
+    line = &cache->lines[(index ^ (index >> 7) ^ ((uint16_t)subIndex << 2))
+                         & (OD_SUB_CACHE_SIZE - 1)];
+    entry = line->entry;
+    if (entry != NULL && entry->index == index && line->subIndex == subIndex) {
+        io->stream.attribute = line->attribute;
+        io->stream.dataOrig = line->dataOrig;
+        io->stream.dataLength = line->dataLength;
+        OD_getSubIO(entry, subIndex, io, odOrig);
+        return ODR_OK;
+    }
 
-    /* Add informative data */
+    entry = OD_find(od, index);
+    ret = OD_getSub(entry, subIndex, io, odOrig);
+    if (ret == ODR_OK) {
+        line->entry = entry;
+        line->subIndex = subIndex;
+        line->attribute = io->stream.attribute;
+        line->dataOrig = io->stream.dataOrig;
+        line->dataLength = io->stream.dataLength;
+    }
+    return ret;
+}
+#endif
+
+/******************************************************************************/
+/* Complete access, see OD_getComplete(). Sub-index of the sub-object at the
+ * position pos in the OD entry. */
+static uint8_t OD_completeSubIndex(const OD_entry_t *entry, uint8_t pos) {
+    if ((entry->odObjectType & ODT_TYPE_MASK) == ODT_REC) {
+        CO_PROGMEM OD_obj_record_t *odoArr = entry->odObject;
+        return odoArr[pos].subIndex;
+    }
+    return pos;
+}
+
+/* Length of the sub-object data in the read image, 0 if not included */
+static OD_size_t OD_completeLength(const OD_IO_t *io) {
+    if ((io->stream.attribute & ODA_SDO_R) == 0
+        || io->stream.dataLength > 0xFFFFU
+    ) {
+        return 0;
+    }
+    return io->stream.dataLength;
+}
+
+static void OD_completeRestart(OD_complete_t *c) {
+    c->pos = 0;
+    c->done = false;
+    c->skip = false;
+    c->hdrLen = 0;
+    c->hdrPos = 0;
+    c->subRemain = 0;
+    c->strPad = 0;
+    c->offset = 0;
+}
+
+/* Find the next sub-object for the read image, prepare its header and read
+ * short data. Set done, if there are no more sub-objects. */
+static ODR_t OD_completeReadNext(OD_complete_t *c) {
+    const OD_entry_t *entry = c->entry;
+
+    while (c->pos < entry->subEntriesCount) {
+        uint8_t subIndex = OD_completeSubIndex(entry, c->pos);
+        OD_size_t len;
+
+        c->pos++;
+        if (subIndex < c->subIndexFirst
+            || OD_getSub(entry, subIndex, &c->sub, c->odOrig) != ODR_OK
+        ) {
+            continue;
+        }
+        len = OD_completeLength(&c->sub);
+        if (len == 0) {
+            continue;
+        }
+
+        c->hdr[0] = subIndex;
+        if (len < 0xFFU) {
+            c->hdr[1] = (uint8_t)len;
+            c->hdrLen = 2;
+        }
+        else {
+            c->hdr[1] = 0xFF;
+            c->hdr[2] = (uint8_t)(len & 0xFFU);
+            c->hdr[3] = (uint8_t)(len >> 8);
+            c->hdrLen = 4;
+        }
+        c->hdrPos = 0;
+        c->subRemain = len;
+
+        if (len <= sizeof(c->small)) {
+            OD_size_t countRd = 0;
+            ODR_t ret = c->sub.read(&c->sub.stream, c->small, len, &countRd);
+
+            if (ret == ODR_PARTIAL || countRd > len) {
+                return ODR_DEV_INCOMPAT;
+            }
+            if (ret != ODR_OK) {
+                return ret;
+            }
+            /* image contains whole sub-object */
+            memset(&c->small[countRd], 0, len - countRd);
+#if (C2000_PORT != 0)
+            if ((c->sub.stream.attribute & ODA_STR) == 0) {
+                CO_wordsToBytes(c->small, len);
+            }
+#endif
+#ifdef CO_BIG_ENDIAN
+            if ((c->sub.stream.attribute & ODA_MB) != 0) {
+                CO_swapBytes(c->small, len);
+            }
+#endif
+        }
+        return ODR_OK;
+    }
+
+    c->done = true;
+    return ODR_OK;
+}
+
+/* Header of the sub-object received, find it in OD entry */
+static ODR_t OD_completeWriteStart(OD_complete_t *c) {
+    OD_size_t len = c->hdr[1];
+    OD_size_t sizeInOd;
+    ODR_t ret;
+
+    if (c->hdr[1] == 0xFFU) {
+        len = (OD_size_t)c->hdr[2] | ((OD_size_t)c->hdr[3] << 8);
+    }
+    ret = OD_getSub(c->entry, c->hdr[0], &c->sub, c->odOrig);
+    if (ret != ODR_OK) {
+        return ret;
+    }
+
+    sizeInOd = c->sub.stream.dataLength;
+    c->skip = (c->sub.stream.attribute & ODA_SDO_W) == 0;
+    c->subRemain = len;
+    c->strPad = 0;
+    if (c->skip) {
+        return ODR_OK;
+    }
+
+    /* String may be shorter, terminate it with up to two zeros, the same as
+     * SDO server. Shorten also data size, which indicates EOF to write. */
+    if ((c->sub.stream.attribute & ODA_STR) != 0
+        && (sizeInOd == 0 || len < sizeInOd)
+    ) {
+        c->strPad = (sizeInOd == 0 || (sizeInOd - len) >= 2) ? 2 : 1;
+        c->sub.stream.dataLength = len + c->strPad;
+    }
+    else if (sizeInOd == 0) {
+        c->sub.stream.dataLength = len;
+    }
+    else if (len != sizeInOd) {
+        return (len > sizeInOd) ? ODR_DATA_LONG : ODR_DATA_SHORT;
+    }
+    else { /* MISRA C 2004 14.10 */ }
+
+    return ODR_OK;
+}
+
+/* All data of the sub-object received, write short data or string terminator
+ * and wait for the next header. */
+static ODR_t OD_completeWriteEnd(OD_complete_t *c) {
+    OD_size_t len = c->sub.stream.dataLength;
+    OD_size_t countWr = 0;
+    ODR_t ret = ODR_OK;
+
+    if (c->skip) {
+        /* nothing to write */
+    }
+    else if ((c->sub.stream.attribute & ODA_STR) == 0
+             && len <= sizeof(c->small)
+    ) {
+#ifdef CO_BIG_ENDIAN
+        if ((c->sub.stream.attribute & ODA_MB) != 0) {
+            CO_swapBytes(c->small, len);
+        }
+#endif
+#if (C2000_PORT != 0)
+        if (c->sub.write == OD_writeOriginal) {
+            CO_bytesToWords(c->small, len);
+        }
+#endif
+        ret = c->sub.write(&c->sub.stream, c->small, len, &countWr);
+    }
+    else if (c->strPad > 0) {
+        static const uint8_t zeros[2] = {0, 0};
+        ret = c->sub.write(&c->sub.stream, zeros, c->strPad, &countWr);
+    }
+    else { /* MISRA C 2004 14.10 */ }
+
+    c->hdrPos = 0;
+    c->strPad = 0;
+    return (ret == ODR_PARTIAL) ? ODR_DATA_SHORT : ret;
+}
+
+/******************************************************************************/
+ODR_t OD_getComplete(const OD_entry_t *entry, uint8_t subIndexFirst,
+                     OD_IO_t *io, OD_complete_t *complete,
+                     bool_t odOrig, bool_t write)
+{
+    if (entry == NULL || entry->odObject == NULL) { return ODR_IDX_NOT_EXIST; }
+    if (io == NULL || complete == NULL) { return ODR_DEV_INCOMPAT; }
+
+    uint8_t type = entry->odObjectType & ODT_TYPE_MASK;
+    OD_stream_t *stream = &io->stream;
+
+    if (type != ODT_ARR && type != ODT_REC) {
+        return ODR_UNSUPP_ACCESS;
+    }
+
+    memset(complete, 0, sizeof(OD_complete_t));
+    complete->entry = entry;
+    complete->subIndexFirst = subIndexFirst;
+    complete->odOrig = odOrig;
+
+    stream->dataOrig = NULL;
+    stream->object = complete;
+    stream->dataLength = 0;
+    stream->dataOffset = 0;
+    stream->attribute = 0;
     stream->index = entry->index;
-    stream->subIndex = subIndex;
+    stream->subIndex = subIndexFirst;
+
+    /* access attributes and size of the read image */
+    for (uint8_t pos = 0; pos < entry->subEntriesCount; pos++) {
+        uint8_t subIndex = OD_completeSubIndex(entry, pos);
+        OD_size_t len;
+
+        if (subIndex < subIndexFirst
+            || OD_getSub(entry, subIndex, &complete->sub, odOrig) != ODR_OK
+        ) {
+            continue;
+        }
+        stream->attribute |= complete->sub.stream.attribute & ODA_SDO_RW;
+        len = OD_completeLength(&complete->sub);
+        if (!write && len > 0) {
+            stream->dataLength += ((len < 0xFFU) ? 2U : 4U) + len;
+        }
+    }
+
+    io->read = OD_readComplete;
+    io->write = OD_writeComplete;
 
     return ODR_OK;
 }
 
+/******************************************************************************/
+ODR_t OD_readComplete(OD_stream_t *stream, void *buf,
+                      OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL
+        || stream->object == NULL
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    OD_complete_t *c = stream->object;
+    uint8_t *dest = (uint8_t *)buf;
+    OD_size_t n = 0;
+    ODR_t ret;
+
+    /* Stream was moved, for example by SDO block upload, which retransmits
+     * data. Read the image again from the beginning up to dataOffset. */
+    if (stream->dataOffset != c->offset) {
+        OD_size_t target = stream->dataOffset;
+
+        OD_completeRestart(c);
+        while (c->offset < target) {
+            uint8_t discard[8];
+            OD_size_t chunk = target - c->offset;
+            OD_size_t countSkip = 0;
+
+            if (chunk > sizeof(discard)) {
+                chunk = sizeof(discard);
+            }
+            stream->dataOffset = c->offset;
+            ret = OD_readComplete(stream, discard, chunk, &countSkip);
+            if (ret != ODR_PARTIAL) {
+                return (ret == ODR_OK) ? ODR_DEV_INCOMPAT : ret;
+            }
+        }
+    }
+
+    for (;;) {
+        if (c->hdrPos == c->hdrLen && c->subRemain == 0) {
+            if (!c->done) {
+                ret = OD_completeReadNext(c);
+                if (ret != ODR_OK) {
+                    return ret;
+                }
+                continue;
+            }
+            /* all sub-objects were read */
+            OD_completeRestart(c);
+            stream->dataOffset = 0;
+            *countRead = n;
+            return ODR_OK;
+        }
+        if (n >= count) {
+            break;
+        }
+
+        if (c->hdrPos < c->hdrLen) {
+            dest[n++] = c->hdr[c->hdrPos++];
+        }
+        else if (c->sub.stream.dataLength <= sizeof(c->small)) {
+            dest[n++] = c->small[c->sub.stream.dataLength - c->subRemain];
+            c->subRemain--;
+        }
+        else {
+            OD_size_t countRd = 0;
+            OD_size_t chunk = count - n;
+
+            if (chunk > c->subRemain) {
+                chunk = c->subRemain;
+            }
+            ret = c->sub.read(&c->sub.stream, &dest[n], chunk, &countRd);
+            if (ret != ODR_OK && ret != ODR_PARTIAL) {
+                return ret;
+            }
+            if (countRd > chunk || (ret == ODR_OK) != (countRd == c->subRemain)
+                || countRd == 0
+            ) {
+                return ODR_DEV_INCOMPAT;
+            }
+#if (C2000_PORT != 0)
+            if ((c->sub.stream.attribute & ODA_STR) == 0) {
+                CO_wordsToBytes(&dest[n], countRd);
+            }
+#endif
+            n += countRd;
+            c->subRemain -= countRd;
+        }
+    }
+
+    c->offset += n;
+    stream->dataOffset = c->offset;
+    *countRead = n;
+    return ODR_PARTIAL;
+}
+
+/******************************************************************************/
+ODR_t OD_writeComplete(OD_stream_t *stream, const void *buf,
+                       OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL
+        || stream->object == NULL
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    OD_complete_t *c = stream->object;
+    const uint8_t *src = (const uint8_t *)buf;
+    OD_size_t n = 0;
+    ODR_t ret;
+
+    /* write can be restarted only from the beginning */
+    if (stream->dataOffset != c->offset) {
+        if (stream->dataOffset != 0) {
+            return ODR_DEV_INCOMPAT;
+        }
+        OD_completeRestart(c);
+    }
+
+    while (n < count) {
+        /* header: sub-index, length and optional UNSIGNED16 length */
+        if (c->hdrPos < 2 || (c->hdr[1] == 0xFFU && c->hdrPos < 4)) {
+            c->hdr[c->hdrPos++] = src[n++];
+            if (c->hdrPos == 2 && c->hdr[1] == 0xFFU) {
+                continue;
+            }
+            if (c->hdrPos == 2 || c->hdrPos == 4) {
+                ret = OD_completeWriteStart(c);
+                if (ret == ODR_OK && c->subRemain == 0) {
+                    ret = OD_completeWriteEnd(c);
+                }
+                if (ret != ODR_OK) {
+                    return ret;
+                }
+            }
+            continue;
+        }
+
+        /* data of the sub-object */
+        OD_size_t chunk = count - n;
+        if (chunk > c->subRemain) {
+            chunk = c->subRemain;
+        }
+        if (c->skip) {
+            /* not writable, ignore */
+        }
+        else if ((c->sub.stream.attribute & ODA_STR) == 0
+                 && c->sub.stream.dataLength <= sizeof(c->small)
+        ) {
+            memcpy(&c->small[c->sub.stream.dataLength - c->subRemain],
+                   &src[n], chunk);
+        }
+        else {
+            OD_size_t countWr = 0;
+            bool_t last = chunk == c->subRemain && c->strPad == 0;
+
+            ret = c->sub.write(&c->sub.stream, &src[n], chunk, &countWr);
+            if (ret != ODR_OK && ret != ODR_PARTIAL) {
+                return ret;
+            }
+            if (last != (ret == ODR_OK)) {
+                return last ? ODR_DATA_SHORT : ODR_DATA_LONG;
+            }
+        }
+        n += chunk;
+        c->subRemain -= chunk;
+        if (c->subRemain == 0) {
+            ret = OD_completeWriteEnd(c);
+            if (ret != ODR_OK) {
+                return ret;
+            }
+        }
+    }
+
+    c->offset += n;
+    stream->dataOffset = c->offset;
+    *countWritten = n;
+
+    /* size of the image is known, verify the end */
+    if (stream->dataLength > 0 && c->offset >= stream->dataLength) {
+        bool_t itemOpen = c->hdrPos > 0;
+        bool_t tooLong = c->offset > stream->dataLength;
+
+        OD_completeRestart(c);
+        stream->dataOffset = 0;
+        if (tooLong) {
+            return ODR_DATA_LONG;
+        }
+        return itemOpen ? ODR_DATA_SHORT : ODR_OK;
+    }
+    return ODR_PARTIAL;
+}
+
 /******************************************************************************/
 uint32_t OD_getSDOabCode(ODR_t returnCode) {
     static const uint32_t abortCodes[ODR_COUNT] = {
@@ -383,3 +954,30 @@ void *OD_getPtr(const OD_entry_t *entry, uint8_t subIndex, OD_size_t len,
 
     return errCopy == ODR_OK ? stream->dataOrig : NULL;
 }
+
+ODR_t OD_var_init(OD_var_t *var, const OD_entry_t *entry, uint8_t subIndex,
+                  bool_t odOrig)
+{
+    if (var == NULL) { return ODR_DEV_INCOMPAT; }
+
+    OD_IO_t io;
+    OD_stream_t *stream = &io.stream;
+
+    ODR_t ret = OD_getSub(entry, subIndex, &io, true);
+
+    if (ret != ODR_OK) { return ret; }
+
+    var->entry = entry;
+    var->dataOrig = stream->dataOrig;
+    var->dataLength = stream->dataLength;
+#if (C2000_PORT != 0)
+    /* same as in OD_readOriginal() */
+    var->copyLength = OD_memUnits(stream, stream->dataLength);
+#else
+    var->copyLength = stream->dataLength;
+#endif
+    var->subIndex = subIndex;
+    var->odOrig = odOrig;
+
+    return ODR_OK;
+}
@@ -53,6 +53,32 @@ typedef uint8_t OD_attr_t;
 #define OD_FLAGS_PDO_SIZE 4
 #endif
 
+#ifndef OD_FIND_LOOKUP
+/** If 1, then @ref OD_t contains optional pointer to @ref OD_lookup_t, which
+ * is used by OD_find() for constant time search. */
+#define OD_FIND_LOOKUP 0
+#endif
+
+#ifndef OD_INSTANCES
+/** If 1, then @ref OD_entry_t contains pointer to @ref OD_instance_t and many
+ * Object Dictionaries may share the same constant OD objects, see
+ * @ref OD_instance_init(). */
+#define OD_INSTANCES 0
+#endif
+
+#ifndef OD_WRITE_HOOK
+/** Optional hook, called by @ref OD_writeOriginal() after count bytes were
+ * copied to dataOrig. Target may define it, for example to call
+ * CO_storageEeprom_markDirty(). Empty by default. */
+#define OD_WRITE_HOOK(dataOrig, count)
+#endif
+
+#ifndef OD_SUB_CACHE_SIZE
+/** Number of lines inside @ref OD_subCache_t, power of two. If 0, cache is
+ * not used. */
+#define OD_SUB_CACHE_SIZE 0
+#endif
+
 #ifndef CO_PROGMEM
 /** Modifier for OD objects. This is large amount of data and is specified in
  * Object Dictionary (OD.c file usually) */
@@ -358,9 +384,52 @@ typedef struct {
     CO_PROGMEM void *odObject;
     /** Extension to OD, specified by application */
     OD_extension_t *extension;
+#if OD_INSTANCES || defined CO_DOXYGEN
+    /** Data of the OD instance, set by @ref OD_instance_init(). It is NULL in
+     * the Object Dictionary, which is not an instance. It is the last
+     * element, so OD_entry_t initializers without it stay valid. */
+    const struct OD_instance *instance;
+#endif
 } OD_entry_t;
 
 
+#if OD_FIND_LOOKUP || defined CO_DOXYGEN
+/** Value inside OD_lookupPage_t.entryPos for non-existing OD index */
+#define OD_LOOKUP_NONE 0xFFFFU
+
+/**
+ * Page of @ref OD_lookup_t, OD indexes with the same high byte.
+ */
+typedef struct {
+    /** Positions inside OD_t.list for indexes from lowFirst to
+     * (lowFirst + lowCount - 1), or OD_LOOKUP_NONE */
+    CO_PROGMEM uint16_t *entryPos;
+    /** Low byte of the first index inside entryPos */
+    uint8_t lowFirst;
+    /** Number of elements in entryPos, 0 if page has no OD entries */
+    uint16_t lowCount;
+} OD_lookupPage_t;
+
+/**
+ * Two level direct index into OD_t.list, optional.
+ *
+ * It is generated together with Object Dictionary (OD.c file usually) and
+ * used by OD_find(). Each page covers OD indexes with the same high byte.
+ * Indexes outside pages are searched with binary search, so lookup may cover
+ * only frequently used range, 0x1000 to 0x9FFF for example. See example in
+ * @ref doc/objectDictionary.md.
+ */
+typedef struct {
+    /** Array of pageCount pages */
+    CO_PROGMEM OD_lookupPage_t *pages;
+    /** High byte of the OD index of the first page */
+    uint8_t pageFirst;
+    /** Number of pages */
+    uint16_t pageCount;
+} OD_lookup_t;
+#endif
+
+
 /**
  * Object Dictionary
  */
@@ -369,9 +438,40 @@ typedef struct {
     uint16_t size;
     /** List OD entries (table of contents), ordered by index */
     OD_entry_t *list;
+#if OD_FIND_LOOKUP || defined CO_DOXYGEN
+    /** Optional lookup table for OD_find() or NULL. It is the last element,
+     * so OD_t initializers without it stay valid. */
+    CO_PROGMEM OD_lookup_t *lookup;
+#endif
 } OD_t;
 
 
+#if OD_INSTANCES || defined CO_DOXYGEN
+/**
+ * Memory region with variables of the Object Dictionary, which is instanced
+ * for each OD instance, for example OD_RAM or OD_PERSIST_COMM from OD.c.
+ */
+typedef struct {
+    /** Variables of the template Object Dictionary, default values */
+    const void *orig;
+    /** Variables of the OD instance, same size */
+    void *data;
+    /** Size of the region in bytes */
+    size_t size;
+} OD_instanceRegion_t;
+
+/**
+ * Data of one OD instance, see @ref OD_instance_init().
+ */
+typedef struct OD_instance {
+    /** Array of regionCount regions */
+    const OD_instanceRegion_t *regions;
+    /** Number of regions */
+    uint8_t regionCount;
+} OD_instance_t;
+#endif
+
+
 /**
  * Read value from original OD location
  *
@@ -398,9 +498,33 @@ ODR_t OD_writeOriginal(OD_stream_t *stream, const void *buf,
                        OD_size_t count, OD_size_t *countWritten);
 
 
+#if OD_FLAGS_PDO_SIZE > 0
+/**
+ * Write value to original OD location and request TPDO on change
+ *
+ * This function can be used as write function inside @ref OD_extension_t. It
+ * writes data with @ref OD_writeOriginal() and calls @ref OD_requestTPDO()
+ * for the sub-index, but only if the written value differs from the previous
+ * one. Writing the same value does not trigger event driven TPDO, so OD_set_*
+ * functions may be called on each cycle. Partial (segmented) writes always
+ * request TPDO.
+ *
+ * Member "object" of the extension must point to the extension itself.
+ *
+ * See also CO_CONFIG_PDO_CHANGE_DETECT in CO_config.h, which compares complete TPDO data.
+ */
+ODR_t OD_writeOnChange(OD_stream_t *stream, const void *buf,
+                       OD_size_t count, OD_size_t *countWritten);
+#endif
+
+
 /**
  * Find OD entry in Object Dictionary
  *
+ * If OD_FIND_LOOKUP is enabled and Object Dictionary has @ref OD_lookup_t,
+ * then search time is constant for indexes inside the lookup pages. Otherwise
+ * binary search is used.
+ *
  * @param od Object Dictionary
  * @param index CANopen Object Dictionary index of object in Object Dictionary
  *
@@ -409,6 +533,122 @@ ODR_t OD_writeOriginal(OD_stream_t *stream, const void *buf,
 OD_entry_t *OD_find(OD_t *od, uint16_t index);
 
 
+#if OD_INSTANCES || defined CO_DOXYGEN
+/**
+ * Initialize Object Dictionary, which shares OD objects with template
+ *
+ * Simulation of many devices inside one process needs Object Dictionary for
+ * each device. OD objects (OD_obj_var_t etc.) are constant and may be shared,
+ * only variables must be separate. Instance has own OD entries (list), so
+ * each device may have own extensions, but points to the odObjects of the
+ * template. @ref OD_getSub() then redirects dataOrig, which lies inside one of
+ * the instance regions, to the same offset inside region's data. Variables
+ * outside regions (constants, for example) are shared.
+ *
+ * In CANopen.c OD entries of the instance are obtained with OD_instanceEntry()
+ * (or from CO_config_t, if CO_MULTIPLE_OD is used). Application must also
+ * use OD_find() on the instance and not the OD_ENTRY_Hxxxx macros from OD.h.
+ *
+ * @param [out] od Object Dictionary instance to initialize.
+ * @param list Array of (tmpl->size + 1) elements, OD entries of the instance.
+ * @param tmpl Template Object Dictionary, for example OD from OD.c. It must
+ * stay valid while instance is used.
+ * @param instance Regions of the instance, must stay valid. Data of each
+ * region is initialized with values from the template.
+ *
+ * @return ODR_OK or ODR_DEV_INCOMPAT, if arguments are wrong.
+ */
+ODR_t OD_instance_init(OD_t *od, OD_entry_t *list, const OD_t *tmpl,
+                       const OD_instance_t *instance);
+
+/**
+ * Get OD entry of the instance at the same position as entry in template
+ *
+ * @param od Object Dictionary instance from @ref OD_instance_init().
+ * @param tmpl Template Object Dictionary of the instance. If it is od, then
+ * entry is returned.
+ * @param entry OD entry inside tmpl->list or NULL.
+ *
+ * @return OD entry inside od->list or NULL.
+ */
+static inline OD_entry_t *OD_instanceEntry(OD_t *od, const OD_t *tmpl,
+                                           OD_entry_t *entry)
+{
+    if (entry == NULL || od == NULL || tmpl == NULL || od == tmpl) {
+        return entry;
+    }
+    return &od->list[entry - tmpl->list];
+}
+#endif
+
+
+#if OD_SUB_CACHE_SIZE > 0 || defined CO_DOXYGEN
+/**
+ * One line of @ref OD_subCache_t.
+ */
+typedef struct {
+    /** OD entry, NULL if line is empty */
+    OD_entry_t *entry;
+    /** Original location of the data, see @ref OD_stream_t */
+    void *dataOrig;
+    /** Data length, see @ref OD_stream_t */
+    OD_size_t dataLength;
+    /** Attribute, see @ref OD_stream_t */
+    OD_attr_t attribute;
+    /** Sub-index of the OD variable */
+    uint8_t subIndex;
+} OD_subCacheLine_t;
+
+/**
+ * Direct mapped cache of OD_find() and OD_getSub() results, optional.
+ *
+ * It is used by OD_getSubCached(). Only information from the constant OD
+ * objects is cached. IO extension of the OD entry is evaluated on each
+ * access, so @ref OD_extension_init() does not need to clear the cache.
+ */
+typedef struct {
+    /** Object Dictionary, for which lines are valid */
+    OD_t *od;
+    /** Cache lines */
+    OD_subCacheLine_t lines[OD_SUB_CACHE_SIZE];
+} OD_subCache_t;
+
+
+/**
+ * Clear OD sub-object cache.
+ *
+ * Must be called, if OD_t list is changed after the cache was used.
+ *
+ * @param cache This object.
+ */
+static inline void OD_subCache_clear(OD_subCache_t *cache) {
+    if (cache != NULL) {
+        memset(cache, 0, sizeof(OD_subCache_t));
+    }
+}
+
+
+/**
+ * Find OD entry and its sub-object, use cache.
+ *
+ * Function is equal to OD_getSub(OD_find(od, index), subIndex, io, odOrig),
+ * but repeated access to the same sub-object skips search and decoding of
+ * the OD object.
+ *
+ * @param cache Cache object or NULL.
+ * @param od Object Dictionary.
+ * @param index Index of the OD object.
+ * @param subIndex Sub-index of the variable from the OD object.
+ * @param [out] io Structure will be populated on success.
+ * @param odOrig See @ref OD_getSub().
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+ODR_t OD_getSubCached(OD_subCache_t *cache, OD_t *od, uint16_t index,
+                      uint8_t subIndex, OD_IO_t *io, bool_t odOrig);
+#endif
+
+
 /**
  * Find sub-object with specified sub-index on OD entry returned by OD_find.
  * Function populates io structure with sub-object data.
@@ -429,6 +669,101 @@ ODR_t OD_getSub(const OD_entry_t *entry, uint8_t subIndex,
                 OD_IO_t *io, bool_t odOrig);
 
 
+/**
+ * State of the complete access to OD entry, see @ref OD_getComplete().
+ */
+typedef struct {
+    /** OD entry */
+    const OD_entry_t *entry;
+    /** IO of the current sub-object */
+    OD_IO_t sub;
+    /** Position in the list of sub-objects of the entry */
+    uint8_t pos;
+    /** First sub-index included in the image */
+    uint8_t subIndexFirst;
+    /** See @ref OD_getSub() */
+    bool_t odOrig;
+    /** True, if the last sub-object was already started (read) */
+    bool_t done;
+    /** True, if sub-object is not writable and its data are skipped (write) */
+    bool_t skip;
+    /** Header of the current sub-object: sub-index and length */
+    uint8_t hdr[4];
+    /** Length of the header */
+    uint8_t hdrLen;
+    /** Number of header bytes already transferred */
+    uint8_t hdrPos;
+    /** Number of data bytes of the current sub-object not yet transferred */
+    OD_size_t subRemain;
+    /** Number of zero bytes, added to shorter string (write) */
+    uint8_t strPad;
+    /** Number of image bytes transferred */
+    OD_size_t offset;
+    /** Data of short sub-objects, which are transferred as a whole */
+    uint8_t small[8];
+} OD_complete_t;
+
+
+/**
+ * Prepare complete access to all sub-objects of the ARRAY or RECORD.
+ *
+ * Function populates io structure, which reads or writes all sub-objects of
+ * the entry as one large variable (image). Image is compact and self
+ * describing. It is a sequence of sub-objects, each is:
+ * - sub-index (1 byte),
+ * - length of data, 1 byte for lengths below 255, otherwise 0xFF followed by
+ *   length as UNSIGNED16 (little endian),
+ * - data, little endian and not shortened, also for strings.
+ *
+ * Read produces sub-objects in the order of OD entry, which are readable by
+ * SDO (@ref ODA_SDO_R) and have known length (not 0, up to 0xFFFF). Length
+ * of the image is known from the beginning (stream.dataLength).
+ *
+ * Write accepts sub-objects in any order. Each sub-object must exist in the
+ * entry. Data of sub-objects, which are not writable by SDO, are skipped, so
+ * the image, produced by read, can be written back. Length must equal
+ * length in OD, string may be shorter. io stream.dataLength is zero, caller
+ * must set it to the size of the image, before the last write call, the same
+ * as for variables of unknown size.
+ *
+ * io.read and io.write are OD_readComplete() and OD_writeComplete(). Each
+ * sub-object is accessed with its own read or write function, so IO
+ * extensions are used. Sub-objects of up to 8 bytes are read or written as a
+ * whole, byte order on big endian targets (@ref ODA_MB) is converted here.
+ *
+ * @param entry OD entry returned by @ref OD_find(), type ODT_ARR or ODT_REC.
+ * @param subIndexFirst Sub-objects with lower sub-index are not included in
+ * read image, usually 0 or 1.
+ * @param [out] io Structure will be populated on success.
+ * @param complete Object for the state of access, used by io, may not be
+ * released before access is finished.
+ * @param odOrig See @ref OD_getSub().
+ * @param write True for write access, false for read access.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success,
+ * "ODR_UNSUPP_ACCESS" for VAR entry.
+ */
+ODR_t OD_getComplete(const OD_entry_t *entry, uint8_t subIndexFirst,
+                     OD_IO_t *io, OD_complete_t *complete,
+                     bool_t odOrig, bool_t write);
+
+
+/**
+ * Read function for complete access, see @ref OD_getComplete() and
+ * @ref OD_IO_t.
+ */
+ODR_t OD_readComplete(OD_stream_t *stream, void *buf,
+                      OD_size_t count, OD_size_t *countRead);
+
+
+/**
+ * Write function for complete access, see @ref OD_getComplete() and
+ * @ref OD_IO_t.
+ */
+ODR_t OD_writeComplete(OD_stream_t *stream, const void *buf,
+                       OD_size_t count, OD_size_t *countWritten);
+
+
 /**
  * Return index from OD entry
  *
@@ -872,6 +1207,277 @@ static inline ODR_t OD_set_f64(const OD_entry_t *entry, uint8_t subIndex,
  */
 void *OD_getPtr(const OD_entry_t *entry, uint8_t subIndex, OD_size_t len,
                 ODR_t *err);
+
+
+/**
+ * Handle to OD variable, resolved once by @ref OD_var_init.
+ *
+ * Getters and setters above search OD sub-object with OD_getSub() on each
+ * call and then access data through the read or write function. With handle
+ * variable is located only once. OD_var_get() and OD_var_set() then copy data
+ * directly to or from the original location, if OD entry has no IO extension
+ * (or if handle was initialized with odOrig). If entry has IO extension,
+ * @ref OD_get_value or @ref OD_set_value is used, so extension is respected
+ * also if it is initialized after the handle.
+ */
+typedef struct {
+    /** OD entry, from OD_var_init() */
+    const OD_entry_t *entry;
+    /** Pointer to the original variable, may be NULL */
+    void *dataOrig;
+    /** Length of the variable in bytes */
+    OD_size_t dataLength;
+    /** Number of memory units copied by the direct access */
+    OD_size_t copyLength;
+    /** Sub-index of the variable, from OD_var_init() */
+    uint8_t subIndex;
+    /** From OD_var_init() */
+    bool_t odOrig;
+} OD_var_t;
+
+/**
+ * Initialize handle to OD variable
+ *
+ * Handle stays valid as long as OD entry exists. Function may be called once,
+ * for example after the initialization of the device.
+ *
+ * @param [out] var This object will be initialized.
+ * @param entry OD entry returned by @ref OD_find().
+ * @param subIndex Sub-index of the variable from the OD object.
+ * @param odOrig If true, then potential IO extension on entry will be
+ * ignored and data in the original OD location will be accessed.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success. Error, if
+ * variable does not exist in object dictionary.
+ */
+ODR_t OD_var_init(OD_var_t *var, const OD_entry_t *entry, uint8_t subIndex,
+                  bool_t odOrig);
+
+/**
+ * Get variable from Object Dictionary with handle
+ *
+ * @param var Handle initialized by @ref OD_var_init.
+ * @param [out] val Value will be written here.
+ * @param len Size of value to retrieve from OD, must match length of variable.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+static inline ODR_t OD_var_get(const OD_var_t *var, void *val, OD_size_t len) {
+    if (len != var->dataLength) { return ODR_TYPE_MISMATCH; }
+    if (var->dataOrig != NULL
+        && (var->odOrig || var->entry->extension == NULL)
+    ) {
+        memcpy(val, var->dataOrig, var->copyLength);
+        return ODR_OK;
+    }
+    return OD_get_value(var->entry, var->subIndex, val, len, var->odOrig);
+}
+
+/**
+ * Set variable in Object Dictionary with handle
+ *
+ * Direct write calls also @ref OD_WRITE_HOOK, as OD_writeOriginal() does.
+ *
+ * @param var Handle initialized by @ref OD_var_init.
+ * @param val Pointer to value to write.
+ * @param len Size of value to write, must match length of variable.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+static inline ODR_t OD_var_set(const OD_var_t *var, const void *val,
+                               OD_size_t len)
+{
+    if (len != var->dataLength) { return ODR_TYPE_MISMATCH; }
+    if (var->dataOrig != NULL
+        && (var->odOrig || var->entry->extension == NULL)
+    ) {
+        memcpy(var->dataOrig, val, var->copyLength);
+        OD_WRITE_HOOK(var->dataOrig, var->dataLength);
+        return ODR_OK;
+    }
+    return OD_set_value(var->entry, var->subIndex, (void *)val, len,
+                        var->odOrig);
+}
+
+/** Get int8_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_i8(const OD_var_t *var, int8_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 1);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get int16_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_i16(const OD_var_t *var, int16_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 2);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get int32_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_i32(const OD_var_t *var, int32_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 4);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get int64_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_i64(const OD_var_t *var, int64_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 8);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get uint8_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_u8(const OD_var_t *var, uint8_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 1);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get uint16_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_u16(const OD_var_t *var, uint16_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 2);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get uint32_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_u32(const OD_var_t *var, uint32_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 4);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get uint64_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_u64(const OD_var_t *var, uint64_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 8);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get float32_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_f32(const OD_var_t *var, float32_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 4);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Get float64_t variable with handle, see @ref OD_var_get */
+static inline ODR_t OD_var_get_f64(const OD_var_t *var, float64_t *val) {
+#if C2000_PORT != 0
+    return OD_var_get(var, val, 8);
+#else
+    return OD_var_get(var, val, sizeof(*val));
+#endif
+}
+
+/** Set int8_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_i8(const OD_var_t *var, int8_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 1);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set int16_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_i16(const OD_var_t *var, int16_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 2);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set int32_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_i32(const OD_var_t *var, int32_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 4);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set int64_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_i64(const OD_var_t *var, int64_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 8);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set uint8_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_u8(const OD_var_t *var, uint8_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 1);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set uint16_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_u16(const OD_var_t *var, uint16_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 2);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set uint32_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_u32(const OD_var_t *var, uint32_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 4);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set uint64_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_u64(const OD_var_t *var, uint64_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 8);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set float32_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_f32(const OD_var_t *var, float32_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 4);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
+
+/** Set float64_t variable with handle, see @ref OD_var_set */
+static inline ODR_t OD_var_set_f64(const OD_var_t *var, float64_t val) {
+#if C2000_PORT != 0
+    return OD_var_set(var, &val, 8);
+#else
+    return OD_var_set(var, &val, sizeof(val));
+#endif
+}
 /** @} */ /* CO_ODgetSetters */
 
 
@@ -0,0 +1,292 @@
+/**
+ * Typed C++ interface to CANopen Object Dictionary variables
+ *
+ * @file        CO_ODinterface.hpp
+ * @ingroup     CO_ODtyped
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_OD_INTERFACE_HPP
+#define CO_OD_INTERFACE_HPP
+
+#include <climits>
+#include <type_traits>
+
+#include "301/CO_ODinterface.h"
+
+/**
+ * @defgroup CO_ODtyped Typed C++ interface
+ * Header-only C++11 layer for direct and typed access to OD variables.
+ *
+ * @ingroup CO_ODinterface
+ * @{
+ *
+ * OD variable is declared with #CO_OD_VAR macro from the globals of the
+ * generated ODxyz.h file. Location and type of the variable are resolved by
+ * the compiler, so typing error in the name or wrong type of the variable is
+ * a compile error. CO_OD::Var::get() and CO_OD::Var::set() compile into
+ * direct load and store, without OD_find() and without read/write functions.
+ *
+ * Same as with @ref CO_ODgetSetters or simple access via globals, direct
+ * access must not be used, if OD object has IO extension enabled. Use
+ * CO_OD::Var::read() and CO_OD::Var::write() for such variables, which go
+ * through OD_get_value() and OD_set_value().
+ *
+ * CO_OD::Pdo packs and unpacks static PDO mapping of CO_OD::Var types into
+ * CAN data bytes (little endian), without the mapping tables of CO_PDO.c.
+ * CO_OD::Pdo::mappingMatches() verifies at run time, that the mapping
+ * parameter in the Object Dictionary corresponds to the static mapping.
+ *
+ * Example:
+ * @code
+#include "301/CO_ODinterface.hpp"
+extern "C" {
+#include "OD.h"
+}
+
+CO_OD_VAR(DeviceType, 0x1000, 0, OD_PERSIST_COMM.x1000_deviceType);
+CO_OD_VAR(VendorId, 0x1018, 1, OD_PERSIST_COMM.x1018_identity.vendor_ID);
+CO_OD_VAR(ErrorRegister, 0x1001, 0, OD_RAM.x1001_errorRegister);
+
+typedef CO_OD::Pdo<ErrorRegister, VendorId> MyPdo;
+
+void myFunc(uint8_t *data) {
+    uint32_t devType = DeviceType::get();
+    VendorId::set(0x12345678);
+
+    if (MyPdo::mappingMatches(OD, 0x1A00)) {
+        MyPdo::pack(data); // MyPdo::size is 5
+    }
+}
+ * @endcode
+ *
+ * Handles are declared from the symbols of the generated ODxyz.h, so they work
+ * with any version of OD editor. Byte oriented targets are required
+ * (CHAR_BIT == 8), C2000 is not supported.
+ */
+
+static_assert(CHAR_BIT == 8, "CO_ODinterface.hpp requires 8-bit bytes");
+
+/**
+ * Declare typed handle to OD variable.
+ *
+ * Macro declares type _Name_, which is CO_OD::Var with location of the
+ * variable. It may be used at namespace or class scope.
+ *
+ * @param Name Name of the new type.
+ * @param Index Index of the OD object.
+ * @param SubIndex Sub-index of the variable.
+ * @param Variable Global variable from the ODxyz.h, for example
+ * OD_RAM.x1001_errorRegister or OD_RAM.x1010_storeParameters[0].
+ */
+#define CO_OD_VAR(Name, Index, SubIndex, Variable) \
+    struct Name##_location { \
+        typedef std::remove_reference<decltype((Variable))>::type type; \
+        static type &ref() { return (Variable); } \
+    }; \
+    typedef CO_OD::Var<Name##_location, (Index), (SubIndex)> Name
+
+
+namespace CO_OD {
+
+/** Internal helpers */
+namespace detail {
+/** Copy value into little endian data bytes */
+template <typename T>
+inline void store(uint8_t *data, T val) {
+    memcpy(data, &val, sizeof(T));
+#ifdef CO_BIG_ENDIAN
+    for (size_t i = 0; i < sizeof(T) / 2; i++) {
+        uint8_t swap = data[i];
+        data[i] = data[sizeof(T) - 1 - i];
+        data[sizeof(T) - 1 - i] = swap;
+    }
+#endif
+}
+
+/** Copy value from little endian data bytes */
+template <typename T>
+inline T load(const uint8_t *data) {
+    T val;
+#ifdef CO_BIG_ENDIAN
+    uint8_t buf[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); i++) {
+        buf[i] = data[sizeof(T) - 1 - i];
+    }
+    memcpy(&val, buf, sizeof(T));
+#else
+    memcpy(&val, data, sizeof(T));
+#endif
+    return val;
+}
+} /* namespace detail */
+
+
+/**
+ * Typed handle to OD variable, declared with #CO_OD_VAR.
+ *
+ * @tparam Location Type with _type_ and static function _ref()_, which returns
+ * reference to the variable.
+ * @tparam Index Index of the OD object.
+ * @tparam SubIndex Sub-index of the variable.
+ */
+template <typename Location, uint16_t Index, uint8_t SubIndex>
+struct Var {
+    /** Type of the variable */
+    typedef typename Location::type type;
+    static_assert(std::is_arithmetic<type>::value,
+                  "Only basic data types are supported");
+
+    /** Index of the OD object */
+    static constexpr uint16_t index = Index;
+    /** Sub-index of the variable */
+    static constexpr uint8_t subIndex = SubIndex;
+    /** Length of the variable in bytes */
+    static constexpr OD_size_t length = sizeof(type);
+
+    /** Reference to the original variable */
+    static type &ref() { return Location::ref(); }
+
+    /** Get value directly from the original variable */
+    static type get() { return Location::ref(); }
+
+    /** Set value directly to the original variable, calls OD_WRITE_HOOK */
+    static void set(type val) {
+        Location::ref() = val;
+        OD_WRITE_HOOK(&Location::ref(), length);
+    }
+
+    /** Get value through Object Dictionary, see @ref OD_get_value */
+    static ODR_t read(OD_t *od, type &val, bool_t odOrig = false) {
+        return OD_get_value(OD_find(od, Index), SubIndex, &val, length,
+                            odOrig);
+    }
+
+    /** Set value through Object Dictionary, see @ref OD_set_value */
+    static ODR_t write(OD_t *od, type val, bool_t odOrig = false) {
+        return OD_set_value(OD_find(od, Index), SubIndex, &val, length,
+                            odOrig);
+    }
+
+    /**
+     * Verify handle against Object Dictionary.
+     *
+     * @return True, if OD sub-object exists, has the same length and the same
+     * original location as handle and has no IO extension.
+     */
+    static bool verify(OD_t *od) {
+        OD_entry_t *entry = OD_find(od, Index);
+        return entry != NULL && entry->extension == NULL
+               && OD_getPtr(entry, SubIndex, length, NULL)
+                  == (void *)&Location::ref();
+    }
+
+    /** Value of the PDO mapping parameter for this variable */
+    static constexpr uint32_t mapping() {
+        return ((uint32_t)Index << 16) | ((uint32_t)SubIndex << 8)
+               | (uint32_t)(length * 8);
+    }
+};
+
+
+/**
+ * List of CO_OD::Var types mapped to PDO, see CO_OD::Pdo.
+ */
+template <typename... Vars>
+struct PdoList;
+
+/** Empty list */
+template <>
+struct PdoList<> {
+    static constexpr OD_size_t size = 0;
+    static constexpr uint8_t count = 0;
+    static void pack(uint8_t *data) { (void)data; }
+    static void unpack(const uint8_t *data) { (void)data; }
+    static bool mappingMatches(OD_entry_t *entry, uint8_t subIndex) {
+        (void)entry;
+        (void)subIndex;
+        return true;
+    }
+};
+
+/** Non-empty list */
+template <typename First, typename... Rest>
+struct PdoList<First, Rest...> {
+    static constexpr OD_size_t size = First::length + PdoList<Rest...>::size;
+    static constexpr uint8_t count = 1 + PdoList<Rest...>::count;
+
+    static void pack(uint8_t *data) {
+        detail::store(data, First::get());
+        PdoList<Rest...>::pack(data + First::length);
+    }
+
+    static void unpack(const uint8_t *data) {
+        First::set(detail::load<typename First::type>(data));
+        PdoList<Rest...>::unpack(data + First::length);
+    }
+
+    static bool mappingMatches(OD_entry_t *entry, uint8_t subIndex) {
+        uint32_t map = 0;
+        return OD_get_u32(entry, subIndex, &map, true) == ODR_OK
+               && map == First::mapping()
+               && PdoList<Rest...>::mappingMatches(entry,
+                                                   (uint8_t)(subIndex + 1));
+    }
+};
+
+
+/**
+ * Static PDO mapping.
+ *
+ * @tparam Vars CO_OD::Var types in order of mapping.
+ */
+template <typename... Vars>
+struct Pdo : PdoList<Vars...> {
+    static_assert(PdoList<Vars...>::size <= CO_CAN_DATA_MAX,
+                  "PDO mapping is larger than CAN data");
+
+    /** Copy values of variables into data, size bytes are written */
+    static void pack(uint8_t *data) { PdoList<Vars...>::pack(data); }
+
+    /** Copy data into variables, size bytes are read */
+    static void unpack(const uint8_t *data) { PdoList<Vars...>::unpack(data); }
+
+    /**
+     * Verify PDO mapping parameter in Object Dictionary.
+     *
+     * @param od Object Dictionary.
+     * @param mapIndex Index of the PDO mapping parameter, 0x1600+ or 0x1A00+.
+     *
+     * @return True, if number of mapped objects and all mapping entries match.
+     */
+    static bool mappingMatches(OD_t *od, uint16_t mapIndex) {
+        OD_entry_t *entry = OD_find(od, mapIndex);
+        uint8_t mappedObjects = 0;
+        return OD_get_u8(entry, 0, &mappedObjects, true) == ODR_OK
+               && mappedObjects == PdoList<Vars...>::count
+               && PdoList<Vars...>::mappingMatches(entry, 1);
+    }
+};
+
+} /* namespace CO_OD */
+
+/** @} */ /* CO_ODtyped */
+
+#endif /* CO_OD_INTERFACE_HPP */
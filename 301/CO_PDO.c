@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "301/CO_PDO.h"
+#include "301/CO_endian.h"
 
 #if (CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE)
 
@@ -35,6 +36,23 @@
  #endif
 #endif
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT) && OD_FLAGS_PDO_SIZE == 0
+ #error TPDO change detection is not possible without OD_FLAGS_PDO_SIZE
+#endif
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+/*
+ * Find mapped entry in Object Dictionary. Try position from CO_PDO_mapCache_t
+ * first, it is valid, if the entry there has the same index.
+ */
+static OD_entry_t *PDO_findEntry(OD_t *OD, uint16_t index, uint16_t entryPos) {
+    if (OD != NULL && entryPos < OD->size && OD->list[entryPos].index == index) {
+        return &OD->list[entryPos];
+    }
+    return OD_find(OD, index);
+}
+#endif
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
 /*
  * Custom function for write dummy OD object. Will be used only from RPDO.
@@ -81,6 +99,8 @@ static ODR_t OD_read_dummy(OD_stream_t *stream, void *buf,
  * @param mapIndex from 0 to CO_PDO_MAX_MAPPED_ENTRIES
  * @param isRPDO True for RPDO and false for TPDO.
  * @param OD Object Dictionary.
+ * @param entryPos Position of the entry in OD from CO_PDO_mapCache_t or
+ * CO_PDO_MAP_CACHE_NO_ENTRY, used with CO_CONFIG_PDO_MAP_CACHE.
  *
  * @return ODR_OK on success, otherwise error reason.
  */
@@ -88,7 +108,11 @@ static ODR_t PDOconfigMap(CO_PDO_common_t *PDO,
                           uint32_t map,
                           uint8_t mapIndex,
                           bool_t isRPDO,
-                          OD_t *OD)
+                          OD_t *OD
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                          , uint16_t entryPos
+#endif
+                          )
 {
     uint16_t index = (uint16_t) (map >> 16);
 #if (C2000_PORT != 0)
@@ -100,7 +124,7 @@ static ODR_t PDOconfigMap(CO_PDO_common_t *PDO,
     uint8_t mappedLengthBits = (uint8_t) map;
 #endif
     uint8_t mappedLength = mappedLengthBits >> 3;
-    OD_IO_t *OD_IO = &PDO->OD_IO[mapIndex];
+    OD_IO_t *OD_IO = &PDO->cold->OD_IO[mapIndex];
 
     /* total PDO length can not be more than CO_PDO_MAX_SIZE bytes */
     if (mappedLength > CO_PDO_MAX_SIZE) {
@@ -119,7 +143,11 @@ static ODR_t PDOconfigMap(CO_PDO_common_t *PDO,
 
     /* find entry in the Object Dictionary */
     OD_IO_t OD_IOcopy;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+    OD_entry_t *entry = PDO_findEntry(OD, index, entryPos);
+#else
     OD_entry_t *entry = OD_find(OD, index);
+#endif
     ODR_t odRet = OD_getSub(entry, subIndex, &OD_IOcopy, false);
     if (odRet != ODR_OK) {
         return odRet;
@@ -142,12 +170,12 @@ static ODR_t PDOconfigMap(CO_PDO_common_t *PDO,
 #if OD_FLAGS_PDO_SIZE > 0
     if (!isRPDO) {
         if (subIndex < (OD_FLAGS_PDO_SIZE * 8) && entry->extension != NULL) {
-            PDO->flagPDObyte[mapIndex] =
+            PDO->cold->flagPDObyte[mapIndex] =
                     &entry->extension->flagsPDO[subIndex >> 3];
-            PDO->flagPDObitmask[mapIndex] = 1 << (subIndex & 0x07);
+            PDO->cold->flagPDObitmask[mapIndex] = 1 << (subIndex & 0x07);
         }
         else {
-            PDO->flagPDObyte[mapIndex] = NULL;
+            PDO->cold->flagPDObyte[mapIndex] = NULL;
         }
     }
 #endif
@@ -162,6 +190,7 @@ static ODR_t PDOconfigMap(CO_PDO_common_t *PDO,
  * @param OD Object Dictionary.
  * @param OD_PDOMapPar OD entry for "PDO mapping parameter".
  * @param isRPDO True for RPDO and false for TPDO.
+ * @param mapCache If not NULL, mapping parameters are taken from it.
  * @param [out] errInfo Additional information in case of error, may be NULL.
  * @param [out] erroneousMap Additional information about erroneous map.
  *
@@ -171,6 +200,9 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
                                         OD_t *OD,
                                         OD_entry_t *OD_PDOMapPar,
                                         bool_t isRPDO,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                                        const CO_PDO_mapCache_t *mapCache,
+#endif
                                         uint32_t *errInfo,
                                         uint32_t *erroneousMap)
 {
@@ -179,7 +211,16 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
     uint8_t mappedObjectsCount = 0;
 
     /* number of mapped application objects in PDO */
-    odRet = OD_get_u8(OD_PDOMapPar, 0, &mappedObjectsCount, true);
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+    if (mapCache != NULL) {
+        mappedObjectsCount = mapCache->mappedObjectsCount;
+        odRet = ODR_OK;
+    }
+    else
+#endif
+    {
+        odRet = OD_get_u8(OD_PDOMapPar, 0, &mappedObjectsCount, true);
+    }
     if (odRet != ODR_OK) {
         if (errInfo != NULL) {
             *errInfo = ((uint32_t)OD_getIndex(OD_PDOMapPar)) << 8;
@@ -188,10 +229,22 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
     }
 
     for (uint8_t i = 0; i < CO_PDO_MAX_MAPPED_ENTRIES; i++) {
-        OD_IO_t *OD_IO = &PDO->OD_IO[i];
+        OD_IO_t *OD_IO = &PDO->cold->OD_IO[i];
         uint32_t map = 0;
 
-        odRet = OD_get_u32(OD_PDOMapPar, i + 1, &map, true);
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+        uint16_t entryPos = CO_PDO_MAP_CACHE_NO_ENTRY;
+        if (mapCache != NULL) {
+            map = mapCache->map[i];
+            entryPos = mapCache->entryPos[i];
+            odRet = (entryPos == CO_PDO_MAP_CACHE_NO_SUB) ? ODR_SUB_NOT_EXIST
+                                                          : ODR_OK;
+        }
+        else
+#endif
+        {
+            odRet = OD_get_u32(OD_PDOMapPar, i + 1, &map, true);
+        }
         if (odRet == ODR_SUB_NOT_EXIST) {
             continue;
         }
@@ -202,7 +255,11 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
             return CO_ERROR_OD_PARAMETERS;
         }
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+        odRet = PDOconfigMap(PDO, map, i, isRPDO, OD, entryPos);
+#else
         odRet = PDOconfigMap(PDO, map, i, isRPDO, OD);
+#endif
         if (odRet != ODR_OK) {
             /* indicate erroneous mapping in initialization phase */
             OD_IO->stream.dataLength = 0;
@@ -267,7 +324,7 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
 
         /* validate enabled mapping parameters */
         for (uint8_t i = 0; i < mappedObjectsCount; i++) {
-            OD_IO_t *OD_IO = &PDO->OD_IO[i];
+            OD_IO_t *OD_IO = &PDO->cold->OD_IO[i];
             size_t dataLength = (size_t) OD_IO->stream.dataLength;
             size_t mappedLength = (size_t) OD_IO->stream.dataOffset;
 
@@ -288,6 +345,18 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
         /* success, update PDO */
         PDO->dataLength = (CO_PDO_size_t)pdoDataLength;
         PDO->mappedObjectsCount = mappedObjectsCount;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT
+        /* copy function was written for the previous mapping */
+        PDO->pFunctCopy = NULL;
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+        PDO->schedUpdate = true;
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+        if (PDO->readyList != NULL) {
+            PDO->readyList->checkAll = true;
+        }
+#endif
 #if (C2000_PORT != 0)
         tempU8 = CO_getUint8(buf);
         pBufTemp = (void *)&tempU8;
@@ -295,8 +364,14 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
     }
     else {
         uint32_t val = CO_getUint32(buf);
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+        ODR_t odRet = PDOconfigMap(PDO, val, stream->subIndex-1,
+                                   PDO->cold->isRPDO, PDO->cold->OD,
+                                   CO_PDO_MAP_CACHE_NO_ENTRY);
+#else
         ODR_t odRet = PDOconfigMap(PDO, val, stream->subIndex-1,
-                                   PDO->isRPDO, PDO->OD);
+                                   PDO->cold->isRPDO, PDO->cold->OD);
+#endif
         if (odRet != ODR_OK) {
             return odRet;
         }
@@ -318,10 +393,52 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
 
 
 #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_SEGMENTS
+/*
+ * Add memory location to the list of PDO map segments. Join it with the last
+ * segment, if adjacent and not swapped. If swap is true, bytes of the segment
+ * are copied in reverse order. Return false, if there is no more space.
+ */
+static bool_t PDO_addMapSegment(CO_PDO_common_t *PDO,
+                                uint8_t *odDataPointer,
+                                uint8_t length,
+                                bool_t swap)
+{
+    uint8_t cnt = PDO->cold->mapSegmentsCount;
+
+    (void)swap; /* may be unused */
+#ifdef CO_BIG_ENDIAN
+    if (!swap && cnt > 0 && !PDO->cold->mapSegmentSwap[cnt - 1]
+#else
+    if (cnt > 0
+#endif
+        && PDO->cold->mapSegmentPointer[cnt - 1]
+           + PDO->cold->mapSegmentLength[cnt - 1] == odDataPointer
+    ) {
+        PDO->cold->mapSegmentLength[cnt - 1] += length;
+        return true;
+    }
+    if (cnt >= CO_PDO_MAX_MAP_SEGMENTS) {
+        return false;
+    }
+    PDO->cold->mapSegmentPointer[cnt] = odDataPointer;
+    PDO->cold->mapSegmentLength[cnt] = length;
+#ifdef CO_BIG_ENDIAN
+    PDO->cold->mapSegmentSwap[cnt] = swap;
+#endif
+    PDO->cold->mapSegmentsCount = cnt + 1;
+    return true;
+}
+#endif
+
+
 static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
                                         OD_t *OD,
                                         OD_entry_t *OD_PDOMapPar,
                                         bool_t isRPDO,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                                        const CO_PDO_mapCache_t *mapCache,
+#endif
                                         uint32_t *errInfo,
                                         uint32_t *erroneousMap)
 {
@@ -330,7 +447,16 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
 
     /* number of mapped application objects in PDO */
     uint8_t mappedObjectsCount = 0;
-    odRet = OD_get_u8(OD_PDOMapPar, 0, &mappedObjectsCount, true);
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+    if (mapCache != NULL) {
+        mappedObjectsCount = mapCache->mappedObjectsCount;
+        odRet = ODR_OK;
+    }
+    else
+#endif
+    {
+        odRet = OD_get_u8(OD_PDOMapPar, 0, &mappedObjectsCount, true);
+    }
     if (odRet != ODR_OK) {
         if (errInfo != NULL) {
             *errInfo = ((uint32_t)OD_getIndex(OD_PDOMapPar)) << 8;
@@ -346,7 +472,19 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
     for (uint8_t i = 0; i < mappedObjectsCount; i++) {
         uint32_t map = 0;
 
-        odRet = OD_get_u32(OD_PDOMapPar, i + 1, &map, true);
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+        uint16_t entryPos = CO_PDO_MAP_CACHE_NO_ENTRY;
+        if (mapCache != NULL) {
+            map = mapCache->map[i];
+            entryPos = mapCache->entryPos[i];
+            odRet = (entryPos == CO_PDO_MAP_CACHE_NO_SUB) ? ODR_SUB_NOT_EXIST
+                                                          : ODR_OK;
+        }
+        else
+#endif
+        {
+            odRet = OD_get_u32(OD_PDOMapPar, i + 1, &map, true);
+        }
         if (odRet != ODR_OK) {
             if (errInfo != NULL) {
                 *errInfo = (((uint32_t)OD_getIndex(OD_PDOMapPar)) << 8) | i;
@@ -367,17 +505,32 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
 
         /* is there a reference to the dummy entry */
         if (index < 0x20 && subIndex == 0) {
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_SEGMENTS
+            static uint8_t dummyTX[CO_PDO_MAX_SIZE] = {0};
+            static uint8_t dummyRX[CO_PDO_MAX_SIZE];
+            if (!PDO_addMapSegment(PDO, isRPDO ? dummyRX : dummyTX,
+                                   mappedLength, false)
+            ) {
+                *erroneousMap = map;
+                return CO_ERROR_NO;
+            }
+#else
             for (uint8_t j = pdoDataStart; j < pdoDataLength; j++) {
                 static uint8_t dummyTX = 0;
                 static uint8_t dummyRX;
-                PDO->mapPointer[j] = isRPDO ? &dummyRX : &dummyTX;
+                PDO->cold->mapPointer[j] = isRPDO ? &dummyRX : &dummyTX;
             }
+#endif
             continue;
         }
 
         /* find entry in the Object Dictionary, original location */
         OD_IO_t OD_IO;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+        OD_entry_t *entry = PDO_findEntry(OD, index, entryPos);
+#else
         OD_entry_t *entry = OD_find(OD, index);
+#endif
         OD_attr_t testAttribute = isRPDO ? ODA_RPDO : ODA_TPDO;
 
         ODR_t odRet = OD_getSub(entry, subIndex, &OD_IO, true);
@@ -390,32 +543,56 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
             return CO_ERROR_NO;
         }
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_SEGMENTS
+        /* add OD variable data to PDO map segments. Multibyte variable on
+         * big-endian is single swapped segment with the last mappedLength
+         * bytes of the variable. */
+        bool_t segmentsOk;
+ #ifdef CO_BIG_ENDIAN
+        if((OD_IO.stream.attribute & ODA_MB) != 0) {
+            segmentsOk = PDO_addMapSegment(PDO, (uint8_t *)OD_IO.stream.dataOrig
+                                                + OD_IO.stream.dataLength
+                                                - mappedLength,
+                                           mappedLength, true);
+        }
+        else
+ #endif
+        {
+            segmentsOk = PDO_addMapSegment(PDO, OD_IO.stream.dataOrig,
+                                           mappedLength, false);
+        }
+        if (!segmentsOk) {
+            *erroneousMap = map;
+            return CO_ERROR_NO;
+        }
+#else
         /* write locations to OD variable data bytes into PDO map pointers */
-#ifdef CO_BIG_ENDIAN
+ #ifdef CO_BIG_ENDIAN
         if((OD_IO.stream.attribute & ODA_MB) != 0) {
             uint8_t *odDataPointer = OD_IO.stream.dataOrig
                                    + OD_IO.stream.dataLength - 1;
             for (uint8_t j = pdoDataStart; j < pdoDataLength; j++) {
-                PDO->mapPointer[j] = odDataPointer--;
+                PDO->cold->mapPointer[j] = odDataPointer--;
             }
         }
         else
-#endif
+ #endif
         {
             uint8_t *odDataPointer = OD_IO.stream.dataOrig;
             for (uint8_t j = pdoDataStart; j < pdoDataLength; j++) {
-                PDO->mapPointer[j] = odDataPointer++;
+                PDO->cold->mapPointer[j] = odDataPointer++;
             }
         }
+#endif
 
         /* get TPDO request flag byte from extension */
 #if OD_FLAGS_PDO_SIZE > 0
         if (!isRPDO && subIndex < (OD_FLAGS_PDO_SIZE * 8)
             && entry->extension != NULL
         ) {
-            PDO->flagPDObyte[pdoDataStart] =
+            PDO->cold->flagPDObyte[pdoDataStart] =
                     &entry->extension->flagsPDO[subIndex >> 3];
-            PDO->flagPDObitmask[pdoDataStart] = 1 << (subIndex & 0x07);
+            PDO->cold->flagPDObitmask[pdoDataStart] = 1 << (subIndex & 0x07);
         }
 #endif
     }
@@ -427,6 +604,87 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
 #endif /* ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0 */
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+/******************************************************************************/
+CO_ReturnError_t CO_PDO_getMapCache(OD_t *OD,
+                                    OD_entry_t *OD_PDOMapPar,
+                                    CO_PDO_mapCache_t *mapCache)
+{
+    if (OD == NULL || OD_PDOMapPar == NULL || mapCache == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(mapCache, 0, sizeof(CO_PDO_mapCache_t));
+    if (OD_get_u8(OD_PDOMapPar, 0, &mapCache->mappedObjectsCount, true)
+        != ODR_OK
+    ) {
+        return CO_ERROR_OD_PARAMETERS;
+    }
+
+    for (uint8_t i = 0; i < CO_PDO_MAP_CACHE_ENTRIES; i++) {
+        uint32_t map = 0;
+        ODR_t odRet = OD_get_u32(OD_PDOMapPar, i + 1, &map, true);
+
+        if (odRet == ODR_SUB_NOT_EXIST) {
+            mapCache->entryPos[i] = CO_PDO_MAP_CACHE_NO_SUB;
+            continue;
+        }
+        if (odRet != ODR_OK) {
+            return CO_ERROR_OD_PARAMETERS;
+        }
+
+        OD_entry_t *entry = OD_find(OD, (uint16_t)(map >> 16));
+        mapCache->map[i] = map;
+        mapCache->entryPos[i] = (entry != NULL)
+                              ? (uint16_t)(entry - OD->list)
+                              : CO_PDO_MAP_CACHE_NO_ENTRY;
+    }
+
+    return CO_ERROR_NO;
+}
+#endif
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK
+/******************************************************************************/
+ODR_t CO_PDO_getValue(CO_PDO_common_t *PDO,
+                      const OD_entry_t *entry, uint8_t subIndex,
+                      void *val, OD_size_t len, bool_t odOrig)
+{
+    ODR_t ret;
+    uint32_t seq;
+
+    if (PDO == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    do {
+        seq = CO_PDO_readBegin(PDO);
+        ret = OD_get_value(entry, subIndex, val, len, odOrig);
+    } while (CO_PDO_readRetry(PDO, seq));
+
+    return ret;
+}
+
+
+/******************************************************************************/
+ODR_t CO_PDO_setValue(CO_PDO_common_t *PDO,
+                      const OD_entry_t *entry, uint8_t subIndex,
+                      void *val, OD_size_t len, bool_t odOrig)
+{
+    ODR_t ret;
+
+    if (PDO == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    CO_PDO_writeLock(PDO);
+    ret = OD_set_value(entry, subIndex, val, len, odOrig);
+    CO_PDO_writeUnlock(PDO);
+
+    return ret;
+}
+#endif
+
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
 /*
  * Custom function for reading OD object "PDO communication parameter"
@@ -450,8 +708,8 @@ static ODR_t OD_read_PDO_commParam(OD_stream_t *stream, void *buf,
         uint16_t CAN_ID = (uint16_t)(COB_ID & 0x7FF);
 
         /* If default CAN-ID is stored in OD (without Node-ID), add Node-ID */
-        if (CAN_ID != 0 && CAN_ID == (PDO->preDefinedCanId & 0xFF80)) {
-            COB_ID = (COB_ID & 0xFFFF0000) | PDO->preDefinedCanId;
+        if (CAN_ID != 0 && CAN_ID == (PDO->cold->preDefinedCanId & 0xFF80)) {
+            COB_ID = (COB_ID & 0xFFFF0000) | PDO->cold->preDefinedCanId;
         }
 
         /* If PDO is not valid, set bit 31 */
@@ -468,6 +726,25 @@ static ODR_t OD_read_PDO_commParam(OD_stream_t *stream, void *buf,
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC */
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT
+/* Set copy function, common for RPDO and TPDO */
+static CO_ReturnError_t CO_PDO_initCopyFunct(CO_PDO_common_t *PDO,
+                                             void *object,
+                                             void (*pFunctCopy)(void *object,
+                                                                uint8_t *data),
+                                             CO_PDO_size_t dataLength)
+{
+    if (pFunctCopy != NULL && dataLength != PDO->dataLength) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    PDO->functCopyObject = object;
+    PDO->pFunctCopy = pFunctCopy;
+    return CO_ERROR_NO;
+}
+#endif
+
+
 /*******************************************************************************
  *      R P D O
  ******************************************************************************/
@@ -505,8 +782,8 @@ static void CO_PDO_receive(void *object, void *msg) {
 
     if (PDO->valid) {
         if (DLC >= PDO->dataLength) {
-            /* indicate errors in PDO length */
-            if (DLC == PDO->dataLength) {
+            /* indicate errors in PDO length, CAN FD frame may be padded */
+            if (DLC == CO_CANpaddedLength(PDO->dataLength)) {
                 if (err == CO_RPDO_RX_ACK_ERROR) { err = CO_RPDO_RX_OK; }
             }
             else {
@@ -523,6 +800,15 @@ static void CO_PDO_receive(void *object, void *msg) {
             }
 #endif
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+            /* previous message in the buffer was not processed yet */
+            if (CO_FLAG_READ(RPDO->CANrxNew[bufNo])
+                && RPDO->overwriteCounter != NULL
+            ) {
+                (*RPDO->overwriteCounter)++;
+            }
+#endif
+
             /* copy data into appropriate buffer and set 'new message' flag */
             memcpy(RPDO->CANrxData[bufNo], data,sizeof(RPDO->CANrxData[bufNo]));
             CO_FLAG_SET(RPDO->CANrxNew[bufNo]);
@@ -542,6 +828,13 @@ static void CO_PDO_receive(void *object, void *msg) {
     }
 
     RPDO->receiveError = err;
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+    /* inform PDO scheduler, also on error and on invalid PDO */
+    if (PDO->readyList != NULL) {
+        CO_readyList_push(PDO->readyList, PDO->readyId);
+    }
+#endif
 }
 
 
@@ -574,7 +867,7 @@ static ODR_t OD_write_14xx(OD_stream_t *stream, const void *buf,
          * CAN_ID == 0 is not allowed, mapping must be configured before
          * enabling the PDO */
         if ((COB_ID & 0x3FFFF800) != 0
-            || (valid && PDO->valid && CAN_ID != PDO->configuredCanId)
+            || (valid && PDO->valid && CAN_ID != PDO->cold->configuredCanId)
             || (valid && CO_IS_RESTRICTED_CAN_ID(CAN_ID))
             || (valid && PDO->mappedObjectsCount == 0)
         ) {
@@ -582,9 +875,9 @@ static ODR_t OD_write_14xx(OD_stream_t *stream, const void *buf,
         }
 
         /* parameter changed? */
-        if (valid != PDO->valid || CAN_ID != PDO->configuredCanId) {
+        if (valid != PDO->valid || CAN_ID != PDO->cold->configuredCanId) {
             /* if default CAN-ID is written, store to OD without Node-ID */
-            if (CAN_ID == PDO->preDefinedCanId) {
+            if (CAN_ID == PDO->cold->preDefinedCanId) {
                 CO_setUint32(bufCopy, COB_ID & 0xFFFFFF80);
             }
             if (!valid) {
@@ -593,7 +886,7 @@ static ODR_t OD_write_14xx(OD_stream_t *stream, const void *buf,
 
             CO_ReturnError_t ret = CO_CANrxBufferInit(
                     PDO->CANdev,        /* CAN device */
-                    PDO->CANdevIdx,     /* rx buffer index */
+                    PDO->cold->CANdevIdx, /* rx buffer index */
                     CAN_ID,             /* CAN identifier */
                     0x7FF,              /* mask */
                     0,                  /* rtr */
@@ -602,7 +895,7 @@ static ODR_t OD_write_14xx(OD_stream_t *stream, const void *buf,
 
             if (valid && ret == CO_ERROR_NO) {
                 PDO->valid = true;
-                PDO->configuredCanId = CAN_ID;
+                PDO->cold->configuredCanId = CAN_ID;
             }
             else {
                 PDO->valid = false;
@@ -655,17 +948,19 @@ static ODR_t OD_write_14xx(OD_stream_t *stream, const void *buf,
         break;
     }
 
-#if (C2000_PORT != 0)
-    void * pBufCopy = (void *)bufCopy;
-    if(count == 1) {
-        *((uint8_t *)pBufCopy) = CO_getUint8(buf);
-    } else if(count == 2) {
-        *((uint16_t *)pBufCopy) = CO_getUint16(buf);
-    } else if(count == 4) {
-        *((uint32_t *)pBufCopy) = CO_getUint32(buf);
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    PDO->schedUpdate = true;
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+    if (PDO->readyList != NULL) {
+        PDO->readyList->checkAll = true;
     }
 #endif
 
+#if (C2000_PORT != 0)
+    CO_bytesToWords(bufCopy, count);
+#endif
+
     /* write value to the original location in the Object Dictionary */
     return OD_writeOriginal(stream, bufCopy, count, countWritten);
 }
@@ -684,6 +979,12 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
                               OD_entry_t *OD_16xx_RPDOMapPar,
                               CO_CANmodule_t *CANdevRx,
                               uint16_t CANdevRxIdx,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+                              CO_PDO_cold_t *cold,
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                              const CO_PDO_mapCache_t *mapCache,
+#endif
                               uint32_t *errInfo)
 {
     CO_PDO_common_t *PDO = &RPDO->PDO_common;
@@ -693,12 +994,24 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
     /* verify arguments */
     if (RPDO == NULL || OD == NULL || em == NULL || OD_14xx_RPDOCommPar == NULL
         || OD_16xx_RPDOMapPar == NULL || CANdevRx == NULL
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+        || cold == NULL
+#endif
     ) {
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
 
     /* clear object */
     memset(RPDO, 0, sizeof(CO_RPDO_t));
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    memset(cold, 0, sizeof(CO_PDO_cold_t));
+#else
+    CO_PDO_cold_t *cold = &RPDO->coldData;
+#endif
+    PDO->cold = cold;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    PDO->schedUpdate = true;
+#endif
 
     /* Configure object variables */
     PDO->em = em;
@@ -710,6 +1023,9 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
                           OD,
                           OD_16xx_RPDOMapPar,
                           true,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                          mapCache,
+#endif
                           errInfo,
                           &erroneousMap);
     if (ret != CO_ERROR_NO) {
@@ -789,19 +1105,19 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
 
     /* Configure OD extensions */
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
-    PDO->isRPDO = true;
-    PDO->OD = OD;
-    PDO->CANdevIdx = CANdevRxIdx;
-    PDO->preDefinedCanId = preDefinedCanId;
-    PDO->configuredCanId = CAN_ID;
-    PDO->OD_communicationParam_ext.object = RPDO;
-    PDO->OD_communicationParam_ext.read = OD_read_PDO_commParam;
-    PDO->OD_communicationParam_ext.write = OD_write_14xx;
-    PDO->OD_mappingParam_extension.object = RPDO;
-    PDO->OD_mappingParam_extension.read = OD_readOriginal;
-    PDO->OD_mappingParam_extension.write = OD_write_PDO_mapping;
-    OD_extension_init(OD_14xx_RPDOCommPar, &PDO->OD_communicationParam_ext);
-    OD_extension_init(OD_16xx_RPDOMapPar, &PDO->OD_mappingParam_extension);
+    cold->isRPDO = true;
+    cold->OD = OD;
+    cold->CANdevIdx = CANdevRxIdx;
+    cold->preDefinedCanId = preDefinedCanId;
+    cold->configuredCanId = CAN_ID;
+    cold->OD_communicationParam_ext.object = RPDO;
+    cold->OD_communicationParam_ext.read = OD_read_PDO_commParam;
+    cold->OD_communicationParam_ext.write = OD_write_14xx;
+    cold->OD_mappingParam_extension.object = RPDO;
+    cold->OD_mappingParam_extension.read = OD_readOriginal;
+    cold->OD_mappingParam_extension.write = OD_write_PDO_mapping;
+    OD_extension_init(OD_14xx_RPDOCommPar, &cold->OD_communicationParam_ext);
+    OD_extension_init(OD_16xx_RPDOMapPar, &cold->OD_mappingParam_extension);
 #endif
 
     return CO_ERROR_NO;
@@ -821,6 +1137,82 @@ void CO_RPDO_initCallbackPre(CO_RPDO_t *RPDO,
 #endif
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT
+/******************************************************************************/
+CO_ReturnError_t CO_RPDO_initCopyFunct(CO_RPDO_t *RPDO,
+                                       void *object,
+                                       void (*pFunctCopy)(void *object,
+                                                          uint8_t *data),
+                                       CO_PDO_size_t dataLength)
+{
+    if (RPDO == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    return CO_PDO_initCopyFunct(&RPDO->PDO_common, object,
+                                pFunctCopy, dataLength);
+}
+#endif
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+void CO_RPDO_initReadyList(CO_RPDO_t *RPDO,
+                           CO_readyList_t *readyList,
+                           uint16_t readyId)
+{
+    if (RPDO != NULL) {
+        RPDO->PDO_common.readyId = readyId;
+        RPDO->PDO_common.readyList = readyList;
+    }
+}
+#endif
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
+/* Verify RPDO timeout. It is also called for synchronous RPDO between SYNCs,
+ * so timeout is reported, if SYNC stops. */
+static void CO_RPDO_verifyTimeout(CO_RPDO_t *RPDO,
+                                  bool_t rpdoReceived,
+                                  uint32_t timeDifference_us,
+                                  uint32_t *timerNext_us)
+{
+    CO_PDO_common_t *PDO = &RPDO->PDO_common;
+    (void) timerNext_us;
+
+    if (RPDO->timeoutTime_us > 0) {
+        if (rpdoReceived) {
+            if (RPDO->timeoutTimer > RPDO->timeoutTime_us) {
+                CO_errorReset(PDO->em, CO_EM_RPDO_TIME_OUT,
+                            RPDO->timeoutTimer);
+            }
+            /* enable monitoring */
+            RPDO->timeoutTimer = 1;
+        }
+        else if (RPDO->timeoutTimer > 0
+                && RPDO->timeoutTimer < RPDO->timeoutTime_us
+        ) {
+            RPDO->timeoutTimer += timeDifference_us;
+
+            if (RPDO->timeoutTimer > RPDO->timeoutTime_us) {
+                CO_errorReport(PDO->em, CO_EM_RPDO_TIME_OUT,
+                            CO_EMC_RPDO_TIMEOUT, RPDO->timeoutTimer);
+            }
+        }
+        else { /* MISRA C 2004 14.10 */ }
+ #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_TIMERNEXT
+        if (timerNext_us != NULL
+            && RPDO->timeoutTimer < RPDO->timeoutTime_us
+        ) {
+            uint32_t diff = RPDO->timeoutTime_us - RPDO->timeoutTimer;
+            if (*timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+        }
+ #endif
+    }
+}
+#endif
+
+
 /******************************************************************************/
 void CO_RPDO_process(CO_RPDO_t *RPDO,
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
@@ -861,6 +1253,18 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
         /* copy RPDO into OD variables according to mappings */
         bool_t rpdoReceived = false;
         while (CO_FLAG_READ(RPDO->CANrxNew[bufNo])) {
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK
+            if (!CO_PDO_writeTryLock(PDO)) {
+                /* Other writer holds the lock, message stays for the next
+                 * processing. */
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+                if (PDO->readyList != NULL) {
+                    PDO->readyList->checkAll = true;
+                }
+ #endif
+                break;
+            }
+#endif
             rpdoReceived = true;
             uint8_t *dataRPDO = RPDO->CANrxData[bufNo];
 
@@ -868,9 +1272,19 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
              * by receive thread, then copy the latest data again. */
             CO_FLAG_CLEAR(RPDO->CANrxNew[bufNo]);
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT
+            if (PDO->pFunctCopy != NULL) {
+                PDO->pFunctCopy(PDO->functCopyObject, dataRPDO);
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK
+                CO_PDO_writeUnlock(PDO);
+ #endif
+                continue;
+            }
+#endif
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
             for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
-                OD_IO_t *OD_IO = &PDO->OD_IO[i];
+                OD_IO_t *OD_IO = &PDO->cold->OD_IO[i];
 
                 /* get mappedLength from temporary storage */
                 OD_size_t *dataOffset = &OD_IO->stream.dataOffset;
@@ -897,13 +1311,7 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
                 /* swap multibyte data if big-endian */
  #ifdef CO_BIG_ENDIAN
                 if ((OD_IO->stream.attribute & ODA_MB) != 0) {
-                    uint8_t *lo = dataOD;
-                    uint8_t *hi = dataOD + ODdataLength - 1;
-                    while (lo < hi) {
-                        uint8_t swap = *lo;
-                        *lo++ = *hi;
-                        *hi-- = swap;
-                    }
+                    CO_swapBytes(dataOD, ODdataLength);
                 }
  #endif
 
@@ -912,75 +1320,46 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
                 *dataOffset = 0;
                 OD_size_t countWritten;
 #if (C2000_PORT != 0)
-                uint8_t bufTemp[CO_PDO_MAX_SIZE];
-                void * pBufTemp = (void *)bufTemp;
-                if((OD_IO->stream.attribute & ODA_STR) == 0) {
-                    if(ODdataLength == 1) {
-                        *((uint8_t *)pBufTemp) = CO_getUint8(dataOD);
-                    } else if(ODdataLength == 2) {
-                        *((uint16_t *)pBufTemp) = CO_getUint16(dataOD);
-                    } else if(ODdataLength == 4) {
-                        *((uint32_t *)pBufTemp) = CO_getUint32(dataOD);
-                    } else {
-                        /// TODO
-                    }
-                } else {
-                    /// TODO: handle string
+                /* pack bytes into 16-bit words, strings are copied as-is */
+                if ((OD_IO->stream.attribute & ODA_STR) == 0) {
+                    CO_bytesToWords(dataOD, ODdataLength);
                 }
-                OD_IO->write(&OD_IO->stream, pBufTemp,
-                             ODdataLength, &countWritten);
-#else
+#endif
                 OD_IO->write(&OD_IO->stream, dataOD,
                              ODdataLength, &countWritten);
-#endif
                 *dataOffset = mappedLength;
 
                 dataRPDO += mappedLength;
             }
 
+#elif (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_SEGMENTS
+            for (uint8_t i = 0; i < PDO->cold->mapSegmentsCount; i++) {
+                uint8_t length = PDO->cold->mapSegmentLength[i];
+ #ifdef CO_BIG_ENDIAN
+                if (PDO->cold->mapSegmentSwap[i]) {
+                    CO_swapBytes(dataRPDO, length);
+                }
+ #endif
+                memcpy(PDO->cold->mapSegmentPointer[i], dataRPDO, length);
+                dataRPDO += length;
+            }
 #else
             for (uint8_t i = 0; i < PDO->dataLength; i++) {
-                *PDO->mapPointer[i] = dataRPDO[i];
+                *PDO->cold->mapPointer[i] = dataRPDO[i];
             }
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK
+            CO_PDO_writeUnlock(PDO);
+#endif
         } /* while (CO_FLAG_READ(RPDO->CANrxNew[bufNo])) */
 
         /* verify RPDO timeout */
         (void) rpdoReceived;
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
-        if (RPDO->timeoutTime_us > 0) {
-            if (rpdoReceived) {
-                if (RPDO->timeoutTimer > RPDO->timeoutTime_us) {
-                    CO_errorReset(PDO->em, CO_EM_RPDO_TIME_OUT,
-                                RPDO->timeoutTimer);
-                }
-                /* enable monitoring */
-                RPDO->timeoutTimer = 1;
-            }
-            else if (RPDO->timeoutTimer > 0
-                    && RPDO->timeoutTimer < RPDO->timeoutTime_us
-            ) {
-                RPDO->timeoutTimer += timeDifference_us;
-
-                if (RPDO->timeoutTimer > RPDO->timeoutTime_us) {
-                    CO_errorReport(PDO->em, CO_EM_RPDO_TIME_OUT,
-                                CO_EMC_RPDO_TIMEOUT, RPDO->timeoutTimer);
-                }
-            }
-            else { /* MISRA C 2004 14.10 */ }
- #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_TIMERNEXT
-            if (timerNext_us != NULL
-                && RPDO->timeoutTimer < RPDO->timeoutTime_us
-            ) {
-                uint32_t diff = RPDO->timeoutTime_us - RPDO->timeoutTimer;
-                if (*timerNext_us > diff) {
-                    *timerNext_us = diff;
-                }
-            }
- #endif
-        }
-#endif /* (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE */
+        CO_RPDO_verifyTimeout(RPDO, rpdoReceived,
+                              timeDifference_us, timerNext_us);
+#endif
     } /* if (PDO->valid && NMTisOperational) */
     else {
         /* not valid and operational, clear CAN receive flags and timeoutTimer*/
@@ -992,6 +1371,13 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
             RPDO->timeoutTimer = 0;
  #endif
         }
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
+        else {
+            /* synchronous RPDO waits for SYNC */
+            CO_RPDO_verifyTimeout(RPDO, false,
+                                  timeDifference_us, timerNext_us);
+        }
+ #endif
 #else
         CO_FLAG_CLEAR(RPDO->CANrxNew[0]);
  #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
@@ -1000,6 +1386,36 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
 #endif
     }
 }
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+/******************************************************************************/
+bool_t CO_RPDO_isPending(CO_RPDO_t *RPDO,
+                         bool_t NMTisOperational,
+                         bool_t syncWas)
+{
+    CO_PDO_common_t *PDO = &RPDO->PDO_common;
+    bool_t rxNew = CO_FLAG_READ(RPDO->CANrxNew[0]);
+    (void) syncWas;
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+    rxNew = rxNew || CO_FLAG_READ(RPDO->CANrxNew[1]);
+#endif
+    if (PDO->schedUpdate) {
+        return true;
+    }
+    if (!PDO->valid || !NMTisOperational) {
+        /* received messages will be discarded */
+        return rxNew;
+    }
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+    if (RPDO->synchronous) {
+        return syncWas;
+    }
+#endif
+    return rxNew || RPDO->receiveError > CO_RPDO_RX_ACK;
+}
+#endif
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE */
 
 
@@ -1036,7 +1452,7 @@ static ODR_t OD_write_18xx(OD_stream_t *stream, const void *buf,
          * CAN_ID == 0 is not allowed, mapping must be configured before
          * enabling the PDO */
         if ((COB_ID & 0x3FFFF800) != 0
-            || (valid && PDO->valid && CAN_ID != PDO->configuredCanId)
+            || (valid && PDO->valid && CAN_ID != PDO->cold->configuredCanId)
             || (valid && CO_IS_RESTRICTED_CAN_ID(CAN_ID))
             || (valid && PDO->mappedObjectsCount == 0)
         ) {
@@ -1044,9 +1460,9 @@ static ODR_t OD_write_18xx(OD_stream_t *stream, const void *buf,
         }
 
         /* parameter changed? */
-        if (valid != PDO->valid || CAN_ID != PDO->configuredCanId) {
+        if (valid != PDO->valid || CAN_ID != PDO->cold->configuredCanId) {
             /* if default CAN-ID is written, store to OD without Node-ID */
-            if (CAN_ID == PDO->preDefinedCanId) {
+            if (CAN_ID == PDO->cold->preDefinedCanId) {
                 CO_setUint32(bufCopy, COB_ID & 0xFFFFFF80);
             }
             if (!valid) {
@@ -1055,10 +1471,10 @@ static ODR_t OD_write_18xx(OD_stream_t *stream, const void *buf,
 
             CO_CANtx_t *CANtxBuff = CO_CANtxBufferInit(
                 PDO->CANdev,      /* CAN device */
-                PDO->CANdevIdx,   /* index of specific buffer inside CAN mod. */
+                PDO->cold->CANdevIdx, /* index of buffer inside CAN module */
                 CAN_ID,           /* CAN identifier */
                 0,                /* rtr */
-                PDO->dataLength,  /* number of data bytes */
+                CO_CANpaddedLength(PDO->dataLength), /* number of data bytes */
                 TPDO->transmissionType <= CO_PDO_TRANSM_TYPE_SYNC_240);
                                   /* synchronous message flag */
 
@@ -1066,9 +1482,14 @@ static ODR_t OD_write_18xx(OD_stream_t *stream, const void *buf,
                 return ODR_DEV_INCOMPAT;
             }
 
+            /* clear padding bytes of CAN FD frame */
+            memset(CANtxBuff->data, 0, sizeof(CANtxBuff->data));
             TPDO->CANtxBuff = CANtxBuff;
             PDO->valid = valid;
-            PDO->configuredCanId = CAN_ID;
+            PDO->cold->configuredCanId = CAN_ID;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+            TPDO->burstCanId = CAN_ID;
+#endif
         }
         break;
     }
@@ -1132,25 +1553,17 @@ static ODR_t OD_write_18xx(OD_stream_t *stream, const void *buf,
         break;
     }
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    PDO->schedUpdate = true;
+#endif
+
 #if (C2000_PORT != 0)
-    void * pBufTemp = bufCopy;
-    if((stream->attribute & ODA_STR) == 0) {
-        if(count == 1) {
-            *((uint8_t *)pBufTemp) = CO_getUint8(bufCopy);
-        } else if (count == 2) {
-            *((uint16_t *)pBufTemp) = CO_getUint16(bufCopy);
-        } else if (count == 4) {
-            *((uint32_t *)pBufTemp) = CO_getUint32(bufCopy);
-        } else {
-            /// TODO
-        }
+    if ((stream->attribute & ODA_STR) == 0) {
+        CO_bytesToWords(bufCopy, count);
     }
-    /* write value to the original location in the Object Dictionary */
-    return OD_writeOriginal(stream, pBufTemp, count, countWritten);
-#else
+#endif
     /* write value to the original location in the Object Dictionary */
     return OD_writeOriginal(stream, bufCopy, count, countWritten);
-#endif
 }
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC */
 
@@ -1167,6 +1580,12 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
                               OD_entry_t *OD_1Axx_TPDOMapPar,
                               CO_CANmodule_t *CANdevTx,
                               uint16_t CANdevTxIdx,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+                              CO_PDO_cold_t *cold,
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                              const CO_PDO_mapCache_t *mapCache,
+#endif
                               uint32_t *errInfo)
 {
     CO_PDO_common_t *PDO = &TPDO->PDO_common;
@@ -1175,12 +1594,24 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
     /* verify arguments */
     if (TPDO == NULL || OD == NULL || em == NULL || OD_18xx_TPDOCommPar == NULL
         || OD_1Axx_TPDOMapPar == NULL || CANdevTx == NULL
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+        || cold == NULL
+#endif
     ) {
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
 
     /* clear object */
     memset(TPDO, 0, sizeof(CO_TPDO_t));
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    memset(cold, 0, sizeof(CO_PDO_cold_t));
+#else
+    CO_PDO_cold_t *cold = &TPDO->coldData;
+#endif
+    PDO->cold = cold;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    PDO->schedUpdate = true;
+#endif
 
     /* Configure object variables */
     PDO->em = em;
@@ -1192,6 +1623,9 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
                                            OD,
                                            OD_1Axx_TPDOMapPar,
                                            false,
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                                           mapCache,
+#endif
                                            errInfo,
                                            &erroneousMap);
     if (ret != CO_ERROR_NO) {
@@ -1254,12 +1688,17 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
             CANdevTxIdx,        /* index of specific buffer inside CAN module */
             CAN_ID,             /* CAN identifier */
             0,                  /* rtr */
-            PDO->dataLength,    /* number of data bytes */
+            CO_CANpaddedLength(PDO->dataLength), /* number of data bytes */
             TPDO->transmissionType <= CO_PDO_TRANSM_TYPE_SYNC_240);
                                 /* synchronous message flag bit */
     if (TPDO->CANtxBuff == NULL) {
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
+    /* clear padding bytes of CAN FD frame */
+    memset(TPDO->CANtxBuff->data, 0, sizeof(TPDO->CANtxBuff->data));
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+    TPDO->burstCanId = CAN_ID;
+#endif
 
     PDO->valid = valid;
 
@@ -1286,19 +1725,19 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
 
     /* Configure OD extensions */
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
-    PDO->isRPDO = false;
-    PDO->OD = OD;
-    PDO->CANdevIdx = CANdevTxIdx;
-    PDO->preDefinedCanId = preDefinedCanId;
-    PDO->configuredCanId = CAN_ID;
-    PDO->OD_communicationParam_ext.object = TPDO;
-    PDO->OD_communicationParam_ext.read = OD_read_PDO_commParam;
-    PDO->OD_communicationParam_ext.write = OD_write_18xx;
-    PDO->OD_mappingParam_extension.object = TPDO;
-    PDO->OD_mappingParam_extension.read = OD_readOriginal;
-    PDO->OD_mappingParam_extension.write = OD_write_PDO_mapping;
-    OD_extension_init(OD_18xx_TPDOCommPar, &PDO->OD_communicationParam_ext);
-    OD_extension_init(OD_1Axx_TPDOMapPar, &PDO->OD_mappingParam_extension);
+    cold->isRPDO = false;
+    cold->OD = OD;
+    cold->CANdevIdx = CANdevTxIdx;
+    cold->preDefinedCanId = preDefinedCanId;
+    cold->configuredCanId = CAN_ID;
+    cold->OD_communicationParam_ext.object = TPDO;
+    cold->OD_communicationParam_ext.read = OD_read_PDO_commParam;
+    cold->OD_communicationParam_ext.write = OD_write_18xx;
+    cold->OD_mappingParam_extension.object = TPDO;
+    cold->OD_mappingParam_extension.read = OD_readOriginal;
+    cold->OD_mappingParam_extension.write = OD_write_PDO_mapping;
+    OD_extension_init(OD_18xx_TPDOCommPar, &cold->OD_communicationParam_ext);
+    OD_extension_init(OD_1Axx_TPDOMapPar, &cold->OD_mappingParam_extension);
 #endif
 
     return CO_ERROR_NO;
@@ -1306,122 +1745,342 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
 
 
 /*
- * Send TPDO message.
+ * Pack TPDO data.
  *
- * Function prepares TPDO data from Object Dictionary variables. It is called
- * from CO_TPDO_process() according to TPDO communication parameters.
+ * Function copies Object Dictionary variables into TPDO data and indicates
+ * their transmission in flagsPDO.
  *
  * @param TPDO TPDO object.
- *
- * @return Same as CO_CANsend().
+ * @param dataTPDO Buffer of CO_PDO_MAX_SIZE bytes, usually data of CANtxBuff.
  */
-static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
+static void CO_TPDOpackData(CO_TPDO_t *TPDO, uint8_t *dataTPDO) {
     CO_PDO_common_t *PDO = &TPDO->PDO_common;
-    uint8_t *dataTPDO = &TPDO->CANtxBuff->data[0];
 #if OD_FLAGS_PDO_SIZE > 0
     bool_t eventDriven =
             (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC
             || TPDO->transmissionType >= CO_PDO_TRANSM_TYPE_SYNC_EVENT_LO);
 #endif
 
-#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
-    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
-        OD_IO_t *OD_IO = &PDO->OD_IO[i];
-        OD_stream_t *stream = &OD_IO->stream;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT
+    if (PDO->pFunctCopy != NULL) {
+        PDO->pFunctCopy(PDO->functCopyObject, dataTPDO);
 
-        /* get mappedLength from temporary storage */
-        uint8_t mappedLength = (uint8_t) stream->dataOffset;
-
-        /* length of OD variable may be larger than mappedLength */
-        OD_size_t ODdataLength = stream->dataLength;
-        if (ODdataLength > CO_PDO_MAX_SIZE) {
-            ODdataLength = CO_PDO_MAX_SIZE;
-        }
-        /* If mappedLength is smaller than ODdataLength, use auxiliary buffer */
-        uint8_t buf[CO_PDO_MAX_SIZE];
-        uint8_t *dataTPDOCopy;
-        if (ODdataLength > mappedLength) {
-            memset(buf, 0, sizeof(buf));
-            dataTPDOCopy = buf;
-        }
-        else {
-            dataTPDOCopy = dataTPDO;
+        /* In event driven TPDO indicate transmission of OD variables */
+ #if OD_FLAGS_PDO_SIZE > 0
+  #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
+        uint8_t flagsCount = PDO->mappedObjectsCount;
+  #else
+        uint8_t flagsCount = PDO->dataLength;
+  #endif
+        for (uint8_t i = 0; i < flagsCount && eventDriven; i++) {
+            uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
+            if (flagPDObyte != NULL) {
+                *flagPDObyte |= PDO->cold->flagPDObitmask[i];
+            }
         }
+ #endif
+    }
+    else
+#endif
+    {
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
+        for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+            OD_IO_t *OD_IO = &PDO->cold->OD_IO[i];
+            OD_stream_t *stream = &OD_IO->stream;
 
-        /* Set stream.dataOffset to zero, perform OD_IO.read()
-         * and store mappedLength back to stream.dataOffset */
-        stream->dataOffset= 0;
-        OD_size_t countRd;
-        OD_IO->read(stream, dataTPDOCopy, ODdataLength, &countRd);
-#if (C2000_PORT != 0)
-        if((stream->attribute & ODA_STR) == 0) {
-            uint8_t tempBuff[8] = {0};
-            for (int i = 0; i < countRd; i++) {
-                if((i % 2) == 0) {
-                    tempBuff[i] = (((uint16_t *)dataTPDOCopy)[i/2]) & 0x00FF;
-                } else {
-                    tempBuff[i] = ((((uint16_t *)dataTPDOCopy)[i/2]) >> 8) & 0x00FF;
-                }
+            /* get mappedLength from temporary storage */
+            uint8_t mappedLength = (uint8_t) stream->dataOffset;
+
+            /* length of OD variable may be larger than mappedLength */
+            OD_size_t ODdataLength = stream->dataLength;
+            if (ODdataLength > CO_PDO_MAX_SIZE) {
+                ODdataLength = CO_PDO_MAX_SIZE;
+            }
+            /* If mappedLength is smaller than ODdataLength, use auxiliary buffer */
+            uint8_t buf[CO_PDO_MAX_SIZE];
+            uint8_t *dataTPDOCopy;
+            if (ODdataLength > mappedLength) {
+                memset(buf, 0, sizeof(buf));
+                dataTPDOCopy = buf;
+            }
+            else {
+                dataTPDOCopy = dataTPDO;
             }
 
-            for (int i = 0; i < countRd; i++) {
-                dataTPDOCopy[i] = tempBuff[i];
+            /* Set stream.dataOffset to zero, perform OD_IO.read()
+             * and store mappedLength back to stream.dataOffset */
+            stream->dataOffset= 0;
+            OD_size_t countRd;
+            OD_IO->read(stream, dataTPDOCopy, ODdataLength, &countRd);
+#if (C2000_PORT != 0)
+            if ((stream->attribute & ODA_STR) == 0) {
+                CO_wordsToBytes(dataTPDOCopy, countRd);
             }
-        }
 #endif
-        stream->dataOffset = mappedLength;
+            stream->dataOffset = mappedLength;
 
-        /* swap multibyte data if big-endian */
+            /* swap multibyte data if big-endian */
  #ifdef CO_BIG_ENDIAN
-        if ((stream->attribute & ODA_MB) != 0) {
-            uint8_t *lo = dataTPDOCopy;
-            uint8_t *hi = dataTPDOCopy + ODdataLength - 1;
-            while (lo < hi) {
-                uint8_t swap = *lo;
-                *lo++ = *hi;
-                *hi-- = swap;
+            if ((stream->attribute & ODA_MB) != 0) {
+                CO_swapBytes(dataTPDOCopy, ODdataLength);
             }
-        }
  #endif
 
-        /* If auxiliary buffer, copy it to the TPDO */
-        if (ODdataLength > mappedLength) {
-            memcpy(dataTPDO, buf, mappedLength);
-        }
+            /* If auxiliary buffer, copy it to the TPDO */
+            if (ODdataLength > mappedLength) {
+                memcpy(dataTPDO, buf, mappedLength);
+            }
 
-        /* In event driven TPDO indicate transmission of OD variable */
+            /* In event driven TPDO indicate transmission of OD variable */
  #if OD_FLAGS_PDO_SIZE > 0
-        uint8_t *flagPDObyte = PDO->flagPDObyte[i];
-        if (flagPDObyte != NULL && eventDriven) {
-           *flagPDObyte |= PDO->flagPDObitmask[i];
+            uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
+            if (flagPDObyte != NULL && eventDriven) {
+               *flagPDObyte |= PDO->cold->flagPDObitmask[i];
+            }
+ #endif
+
+            dataTPDO += mappedLength;
         }
+#elif (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_SEGMENTS
+        uint8_t *dataSegment = dataTPDO;
+        for (uint8_t i = 0; i < PDO->cold->mapSegmentsCount; i++) {
+            uint8_t length = PDO->cold->mapSegmentLength[i];
+            memcpy(dataSegment, PDO->cold->mapSegmentPointer[i], length);
+ #ifdef CO_BIG_ENDIAN
+            if (PDO->cold->mapSegmentSwap[i]) {
+                CO_swapBytes(dataSegment, length);
+            }
  #endif
+            dataSegment += length;
+        }
 
-        dataTPDO += mappedLength;
-    }
+        /* In event driven TPDO indicate transmission of OD variables */
+ #if OD_FLAGS_PDO_SIZE > 0
+        for (uint8_t i = 0; i < PDO->dataLength && eventDriven; i++) {
+            uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
+            if (flagPDObyte != NULL) {
+               *flagPDObyte |= PDO->cold->flagPDObitmask[i];
+            }
+        }
+ #endif
 #else
-    for (uint8_t i = 0; i < PDO->dataLength; i++) {
-        dataTPDO[i] = *PDO->mapPointer[i];
+        for (uint8_t i = 0; i < PDO->dataLength; i++) {
+            dataTPDO[i] = *PDO->cold->mapPointer[i];
 
-        /* In event driven TPDO indicate transmission of OD variable */
+            /* In event driven TPDO indicate transmission of OD variable */
  #if OD_FLAGS_PDO_SIZE > 0
-        uint8_t *flagPDObyte = PDO->flagPDObyte[i];
-        if (flagPDObyte != NULL && eventDriven) {
-           *flagPDObyte |= PDO->flagPDObitmask[i];
-        }
+            uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
+            if (flagPDObyte != NULL && eventDriven) {
+               *flagPDObyte |= PDO->cold->flagPDObitmask[i];
+            }
  #endif
-    }
+        }
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
+    }
+}
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK
+/*
+ * Read TPDO data consistently, see CO_PDO_seqlock.
+ *
+ * @param TPDO TPDO object.
+ * @param dataTPDO Buffer of CO_PDO_MAX_SIZE bytes. It is not modified, if
+ * function fails.
+ *
+ * @return False, if data could not be read in CO_PDO_SEQLOCK_RETRY attempts.
+ */
+static bool_t CO_TPDOread(CO_TPDO_t *TPDO, uint8_t *dataTPDO) {
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
+    uint8_t buf[CO_PDO_MAX_SIZE];
+
+    for (uint8_t i = 0; i < CO_PDO_SEQLOCK_RETRY; i++) {
+        uint32_t seq = CO_PDO_readBegin(PDO);
+        CO_TPDOpackData(TPDO, buf);
+        if (!CO_PDO_readRetry(PDO, seq)) {
+            memcpy(dataTPDO, buf, PDO->dataLength);
+            return true;
+        }
+    }
+    return false;
+}
+#else
+#define CO_TPDOread(TPDO, dataTPDO) (CO_TPDOpackData(TPDO, dataTPDO), true)
+#endif
+
+
+/*
+ * Prepare TPDO message.
+ *
+ * Function prepares TPDO data from Object Dictionary variables and restarts
+ * TPDO timers. It is called from CO_TPDOsend().
+ *
+ * @param TPDO TPDO object.
+ */
+static void CO_TPDOpack(CO_TPDO_t *TPDO) {
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+    if (TPDO->changePacked) {
+        TPDO->changePacked = false;
+    }
+    else {
+        (void) CO_TPDOread(TPDO, &TPDO->CANtxBuff->data[0]);
+    }
+    TPDO->changeRequest = false;
+#else
+    /* if data is not consistent, previous data is sent again */
+    (void) CO_TPDOread(TPDO, &TPDO->CANtxBuff->data[0]);
+#endif
 
     TPDO->sendRequest = false;
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
     TPDO->eventTimer = TPDO->eventTime_us;
     TPDO->inhibitTimer = TPDO->inhibitTime_us;
 #endif
-    return CO_CANsend(PDO->CANdev, TPDO->CANtxBuff);
 }
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+/*
+ * Check change request from OD_requestTPDO().
+ *
+ * Function packs TPDO data into temporary buffer and compares it with the last
+ * transmitted data. If data differs, it is stored into CANtxBuff and
+ * sendRequest is set. Otherwise request is dropped, flagsPDO are set as
+ * transmitted and timers are not restarted.
+ *
+ * @param TPDO TPDO object.
+ */
+static void CO_TPDOcheckChange(CO_TPDO_t *TPDO) {
+    uint8_t buf[CO_PDO_MAX_SIZE];
+    CO_PDO_size_t dataLength = TPDO->PDO_common.dataLength;
+
+    if (!CO_TPDOread(TPDO, buf)) {
+        return; /* try again on next processing */
+    }
+    TPDO->changeRequest = false;
+    if (memcmp(buf, &TPDO->CANtxBuff->data[0], dataLength) != 0) {
+        memcpy(&TPDO->CANtxBuff->data[0], buf, dataLength);
+        TPDO->changePacked = true;
+        TPDO->sendRequest = true;
+    }
+}
+#endif
+
+
+/*
+ * Send TPDO message.
+ *
+ * Function prepares TPDO data from Object Dictionary variables. It is called
+ * from CO_TPDO_process() according to TPDO communication parameters.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return Same as CO_CANsend().
+ */
+static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
+    CO_TPDOpack(TPDO);
+    return CO_CANsend(TPDO->PDO_common.CANdev, TPDO->CANtxBuff);
+}
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+#ifndef CO_CANsendBurst
+/* Default for drivers without CO_CANsendBurst(), see CO_driver.h */
+static CO_ReturnError_t CO_CANsendBurst(CO_CANmodule_t *CANmodule,
+                                        CO_CANtx_t *buffers[],
+                                        uint16_t count)
+{
+    CO_ReturnError_t ret = CO_ERROR_NO;
+    for (uint16_t i = 0; i < count; i++) {
+        CO_ReturnError_t err = CO_CANsend(CANmodule, buffers[i]);
+        if (ret == CO_ERROR_NO) { ret = err; }
+    }
+    return ret;
+}
+#endif
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+/*
+ * Send synchronous TPDO message or pack it into the burst.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return Same as CO_CANsend().
+ */
+static CO_ReturnError_t CO_TPDOsendSync(CO_TPDO_t *TPDO) {
+    CO_TPDO_burst_t *burst = TPDO->burst;
+
+    if (burst == NULL || burst->count >= burst->size
+        || burst->CANdev != TPDO->PDO_common.CANdev
+    ) {
+        return CO_TPDOsend(TPDO);
+    }
+
+    CO_TPDOpack(TPDO);
+
+    /* insert into burst, sorted by CAN identifier */
+    uint16_t i = burst->count++;
+    while (i > 0 && burst->canIds[i - 1] > TPDO->burstCanId) {
+        burst->buffers[i] = burst->buffers[i - 1];
+        burst->canIds[i] = burst->canIds[i - 1];
+        i--;
+    }
+    burst->buffers[i] = TPDO->CANtxBuff;
+    burst->canIds[i] = TPDO->burstCanId;
+    return CO_ERROR_NO;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_TPDO_burstInit(CO_TPDO_burst_t *burst,
+                       CO_CANmodule_t *CANdev,
+                       CO_CANtx_t *buffers[],
+                       uint16_t canIds[],
+                       uint16_t size)
+{
+    if (burst != NULL) {
+        burst->CANdev = CANdev;
+        burst->buffers = buffers;
+        burst->canIds = canIds;
+        burst->size = (buffers != NULL && canIds != NULL) ? size : 0;
+        burst->count = 0;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_TPDO_burstSend(CO_TPDO_burst_t *burst) {
+    if (burst == NULL || burst->count == 0) {
+        return CO_ERROR_NO;
+    }
+
+    uint16_t count = burst->count;
+    burst->count = 0;
+    return CO_CANsendBurst(burst->CANdev, burst->buffers, count);
+}
+#else
+#define CO_TPDOsendSync(TPDO) CO_TPDOsend(TPDO)
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST */
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT
+/******************************************************************************/
+CO_ReturnError_t CO_TPDO_initCopyFunct(CO_TPDO_t *TPDO,
+                                       void *object,
+                                       void (*pFunctCopy)(void *object,
+                                                          uint8_t *data),
+                                       CO_PDO_size_t dataLength)
+{
+    if (TPDO == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    return CO_PDO_initCopyFunct(&TPDO->PDO_common, object,
+                                pFunctCopy, dataLength);
+}
+#endif
+
+
 /******************************************************************************/
 void CO_TPDO_process(CO_TPDO_t *TPDO,
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) || defined CO_DOXYGEN
@@ -1461,12 +2120,24 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
             }
  #endif
             /* check for any OD_requestTPDO() */
- #if OD_FLAGS_PDO_SIZE > 0
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+            if (!TPDO->sendRequest && !TPDO->changeRequest) {
+                for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+                    uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
+                    if (flagPDObyte != NULL) {
+                        if ((*flagPDObyte & PDO->cold->flagPDObitmask[i]) == 0) {
+                            TPDO->changeRequest = true;
+                            break;
+                        }
+                    }
+                }
+            }
+ #elif OD_FLAGS_PDO_SIZE > 0
             if (!TPDO->sendRequest) {
                 for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
-                    uint8_t *flagPDObyte = PDO->flagPDObyte[i];
+                    uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
                     if (flagPDObyte != NULL) {
-                        if ((*flagPDObyte & PDO->flagPDObitmask[i]) == 0) {
+                        if ((*flagPDObyte & PDO->cold->flagPDObitmask[i]) == 0) {
                             TPDO->sendRequest = true;
                             break;
                         }
@@ -1484,13 +2155,26 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
             TPDO->inhibitTimer = (TPDO->inhibitTimer > timeDifference_us)
                                ? (TPDO->inhibitTimer - timeDifference_us) : 0;
 
+            /* compare data after the inhibit time */
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+            if (TPDO->changeRequest && !TPDO->sendRequest
+                && TPDO->inhibitTimer == 0
+            ) {
+                CO_TPDOcheckChange(TPDO);
+            }
+ #endif
+
             /* send TPDO */
             if (TPDO->sendRequest && TPDO->inhibitTimer == 0) {
                 CO_TPDOsend(TPDO);
             }
 
  #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_TIMERNEXT
+  #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+            if ((TPDO->sendRequest || TPDO->changeRequest)
+  #else
             if (TPDO->sendRequest
+  #endif
                 && timerNext_us != NULL && *timerNext_us > TPDO->inhibitTimer
             ) {
                 /* Schedule for just beyond inhibit window */
@@ -1498,6 +2182,11 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
             }
  #endif
 #else
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+            if (TPDO->changeRequest && !TPDO->sendRequest) {
+                CO_TPDOcheckChange(TPDO);
+            }
+ #endif
             if (TPDO->sendRequest) {
                 CO_TPDOsend(TPDO);
             }
@@ -1509,7 +2198,12 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
         else if (TPDO->SYNC != NULL && syncWas) {
             /* send synchronous acyclic TPDO */
             if (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC) {
-                if (TPDO->sendRequest) { CO_TPDOsend(TPDO); }
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+                if (TPDO->changeRequest && !TPDO->sendRequest) {
+                    CO_TPDOcheckChange(TPDO);
+                }
+ #endif
+                if (TPDO->sendRequest) { CO_TPDOsendSync(TPDO); }
             }
             /* send synchronous cyclic TPDO */
             else {
@@ -1531,13 +2225,13 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
                 if (TPDO->syncCounter == 254) {
                     if (TPDO->SYNC->counter == TPDO->syncStartValue) {
                         TPDO->syncCounter = TPDO->transmissionType;
-                        CO_TPDOsend(TPDO);
+                        CO_TPDOsendSync(TPDO);
                     }
                 }
                 /* Send TPDO after every N-th Sync */
                 else if (--TPDO->syncCounter == 0) {
                     TPDO->syncCounter = TPDO->transmissionType;
-                    CO_TPDOsend(TPDO);
+                    CO_TPDOsendSync(TPDO);
                 }
                 else { /* MISRA C 2004 14.10 */ }
             }
@@ -1549,6 +2243,10 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
     else {
         /* Not operational or valid, reset triggers */
         TPDO->sendRequest = true;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT
+        TPDO->changeRequest = false;
+        TPDO->changePacked = false;
+#endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
         TPDO->inhibitTimer = TPDO->eventTimer = 0;
 #endif
@@ -1557,5 +2255,52 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
 #endif
     }
 }
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+/******************************************************************************/
+bool_t CO_TPDO_isPending(CO_TPDO_t *TPDO,
+                         bool_t NMTisOperational,
+                         bool_t syncWas)
+{
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
+    (void) syncWas;
+
+    if (PDO->schedUpdate) {
+        return true;
+    }
+    if (!PDO->valid || !NMTisOperational) {
+        return false;
+    }
+    if (TPDO->transmissionType >= CO_PDO_TRANSM_TYPE_SYNC_EVENT_LO) {
+        if (TPDO->sendRequest) {
+            return true;
+        }
+    }
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+    else if (syncWas && TPDO->SYNC != NULL) {
+        return true;
+    }
+#endif
+    else { /* MISRA C 2004 14.10 */ }
+
+#if OD_FLAGS_PDO_SIZE > 0
+    /* check for any OD_requestTPDO() */
+    if (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC
+        || TPDO->transmissionType >= CO_PDO_TRANSM_TYPE_SYNC_EVENT_LO
+    ) {
+        for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+            uint8_t *flagPDObyte = PDO->cold->flagPDObyte[i];
+            if (flagPDObyte != NULL
+                && (*flagPDObyte & PDO->cold->flagPDObitmask[i]) == 0
+            ) {
+                return true;
+            }
+        }
+    }
+#endif
+    return false;
+}
+#endif
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE */
 #endif /* (CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE) */
@@ -29,6 +29,7 @@
 #include "301/CO_ODinterface.h"
 #include "301/CO_Emergency.h"
 #include "301/CO_SYNC.h"
+#include "301/CO_stats.h"
 
 /* default configuration, see CO_config.h */
 #ifndef CO_CONFIG_PDO
@@ -42,6 +43,10 @@
                        CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
                        CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK) && !defined CO_ATOMIC_CAS_U32
+#define CO_ATOMIC_CAS_U32(ptr, expected, desired) \
+    __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#endif
 
 #if ((CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE)) || defined CO_DOXYGEN
 
@@ -73,6 +78,8 @@ extern "C" {
  *    simplified @ref CO_CONFIG_PDO option, where instead of read()/write()
  *    access, PDO data are copied directly to/from memory locations of
  *    OD variables.
+ *  - PDOs with mapping fixed at build time may use application specific copy
+ *    functions instead, see @ref CO_RPDO_initCopyFunct().
  *  - After RPDO is received from CAN bus, its data are copied to internal
  *    buffer (inside fast CAN receive interrupt). Function CO_RPDO_process()
  *    (called by application) copies data to the mapped objects in the Object
@@ -86,6 +93,27 @@ extern "C" {
  *    example, monitor change of state of the OD variable and indicate TPDO
  *    request on it.
  *
+ * @anchor CO_PDO_seqlock
+ * ### Consistent access to mapped variables
+ * Normally mainline code protects access to PDO mapped OD variables with
+ * CO_LOCK_OD(), which blocks the real-time thread. If CO_CONFIG_PDO_SEQLOCK
+ * is enabled, each PDO has a sequence lock instead:
+ * - CO_RPDO_process() writes all mapped variables of one received message
+ *   inside CO_PDO_writeTryLock() / CO_PDO_writeUnlock(). Readers use
+ *   CO_PDO_readBegin() / CO_PDO_readRetry() or CO_PDO_getValue() and always
+ *   get all variables from the same message, without blocking the RPDO.
+ * - CO_TPDO_process() reads mapped variables inside CO_PDO_readBegin() /
+ *   CO_PDO_readRetry(). Application writers use CO_PDO_writeLock() /
+ *   CO_PDO_writeUnlock() or CO_PDO_setValue(). There may be many writers in
+ *   different threads, they are serialized with CO_ATOMIC_CAS_U32().
+ *
+ * Real-time thread never waits for the lock. If RPDO can not get the lock, it
+ * leaves received message for the next processing. If TPDO can not read
+ * consistent data in CO_PDO_SEQLOCK_RETRY attempts, it sends previous data.
+ * Variables may also be accessed with OD_getPtr() or OD_get_* / OD_set_*
+ * between the lock functions. Sequence lock protects only against other users
+ * of the same lock, SDO access to mapped variables still uses CO_LOCK_OD().
+ *
  * @anchor CO_PDO_CAN_ID
  * ### CAN identifiers for PDO
 
@@ -133,15 +161,27 @@ extern "C" {
  *   COB-ID
  */
 
-/** Maximum size of PDO message, 8 for standard CAN */
+/** Maximum size of PDO message, 8 for standard CAN or 64 for CAN FD, see
+ * CO_CAN_DATA_MAX. With CAN FD, TPDO is transmitted in the shortest valid
+ * CAN FD frame, padded with zeros. RPDO accepts such padded frame too. */
 #ifndef CO_PDO_MAX_SIZE
-#define CO_PDO_MAX_SIZE 8
+#define CO_PDO_MAX_SIZE CO_CAN_DATA_MAX
 #endif
 
-/** Maximum number of entries, which can be mapped to PDO, 8 for standard CAN,
- * may be less to preserve RAM usage */
+/** Maximum number of entries, which can be mapped to PDO, 8 for standard CAN
+ * or 64 for CAN FD, may be less to preserve RAM usage */
 #ifndef CO_PDO_MAX_MAPPED_ENTRIES
-#define CO_PDO_MAX_MAPPED_ENTRIES 8
+#define CO_PDO_MAX_MAPPED_ENTRIES CO_CAN_DATA_MAX
+#endif
+
+/** Maximum number of contiguous memory segments, to which PDO data are
+ * copied, if @ref CO_CONFIG_PDO has CO_CONFIG_PDO_MAP_SEGMENTS enabled (and
+ * CO_CONFIG_PDO_OD_IO_ACCESS disabled). Adjacent mapped OD variables are joined
+ * into single segment. Default value is always sufficient. It may be less to
+ * preserve RAM usage, PDO mapping, which needs more segments, is then
+ * erroneous. */
+#ifndef CO_PDO_MAX_MAP_SEGMENTS
+#define CO_PDO_MAX_MAP_SEGMENTS CO_PDO_MAX_SIZE
 #endif
 
 /** Number of CANopen RPDO objects, which uses default CAN indentifiers.
@@ -164,6 +204,12 @@ extern "C" {
 #define CO_TPDO_DEFAULT_CANID_COUNT 4
 #endif
 
+/** Number of attempts of CO_TPDO_process() to read consistent data from
+ * mapped variables, if @ref CO_CONFIG_PDO has CO_CONFIG_PDO_SEQLOCK enabled */
+#ifndef CO_PDO_SEQLOCK_RETRY
+#define CO_PDO_SEQLOCK_RETRY 4
+#endif
+
 #ifndef CO_PDO_OWN_TYPES
 /** Variable of type CO_PDO_size_t contains data length in bytes of PDO */
 typedef uint8_t CO_PDO_size_t;
@@ -184,19 +230,17 @@ typedef enum {
 } CO_PDO_transmissionTypes_t;
 
 /**
- * PDO object, common properties
+ * PDO object, configuration and mapping
+ *
+ * These data are used on initialization, on configuration change and only when
+ * PDO data are actually copied by CO_RPDO_process() or CO_TPDO_process().
+ * They are separated from the rest of the PDO object, which is checked on each
+ * cycle, so CAN receive callback and processing of many PDOs touch fewer cache
+ * lines. By default they are at the end of CO_RPDO_t or CO_TPDO_t. With
+ * CO_CONFIG_PDO_COLD_SPLIT they are in separate memory, provided by
+ * CO_RPDO_init() or CO_TPDO_init().
  */
 typedef struct {
-    /** From CO_xPDO_init() */
-    CO_EM_t *em;
-    /** From CO_xPDO_init() */
-    CO_CANmodule_t *CANdev;
-    /** True, if PDO is enabled and valid */
-    bool_t valid;
-    /** Data length of the received PDO message. Calculated from mapping */
-    CO_PDO_size_t dataLength;
-    /** Number of mapped objects in PDO */
-    uint8_t mappedObjectsCount;
 #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) || defined CO_DOXYGEN
     /** Object dictionary interface for all mapped entries. OD_IO.dataOffset has
      * special usage with PDO. It stores information about mappedLength of
@@ -212,8 +256,20 @@ typedef struct {
     uint8_t flagPDObitmask[CO_PDO_MAX_MAPPED_ENTRIES];
   #endif
 #else
+  #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_SEGMENTS
+    /* Contiguous segments of data objects inside OD, where PDO will be
+     * copied, in order of PDO data */
+    uint8_t *mapSegmentPointer[CO_PDO_MAX_MAP_SEGMENTS];
+    uint8_t mapSegmentLength[CO_PDO_MAX_MAP_SEGMENTS];
+   #ifdef CO_BIG_ENDIAN
+    /* Segment is multibyte variable, copied in reverse byte order */
+    bool_t mapSegmentSwap[CO_PDO_MAX_MAP_SEGMENTS];
+   #endif
+    uint8_t mapSegmentsCount;
+  #else
     /* Pointers to data objects inside OD, where PDO will be copied */
     uint8_t *mapPointer[CO_PDO_MAX_SIZE];
+  #endif
   #if OD_FLAGS_PDO_SIZE > 0
     uint8_t *flagPDObyte[CO_PDO_MAX_SIZE];
     uint8_t flagPDObitmask[CO_PDO_MAX_SIZE];
@@ -235,9 +291,215 @@ typedef struct {
     /** Extension for OD object */
     OD_extension_t OD_mappingParam_extension;
 #endif
+} CO_PDO_cold_t;
+
+
+/**
+ * PDO object, common properties
+ */
+typedef struct {
+    /** From CO_xPDO_init() */
+    CO_EM_t *em;
+    /** From CO_xPDO_init() */
+    CO_CANmodule_t *CANdev;
+    /** True, if PDO is enabled and valid */
+    bool_t valid;
+    /** Data length of the received PDO message. Calculated from mapping */
+    CO_PDO_size_t dataLength;
+    /** Number of mapped objects in PDO */
+    uint8_t mappedObjectsCount;
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER) || defined CO_DOXYGEN
+    /** Time of the last processing, used by PDO scheduler in CANopen.c */
+    uint32_t schedTime_us;
+    /** Set by initialization and by change of PDO configuration, so PDO is
+     * processed by PDO scheduler */
+    volatile bool_t schedUpdate;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST) || defined CO_DOXYGEN
+    /** From CO_RPDO_initReadyList() or NULL */
+    CO_readyList_t *readyList;
+    /** From CO_RPDO_initReadyList() */
+    uint16_t readyId;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT) || defined CO_DOXYGEN
+    /** From CO_RPDO_initCopyFunct() or CO_TPDO_initCopyFunct() or NULL */
+    void (*pFunctCopy)(void *object, uint8_t *data);
+    /** From CO_RPDO_initCopyFunct() or CO_TPDO_initCopyFunct() or NULL */
+    void *functCopyObject;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK) || defined CO_DOXYGEN
+    /** Sequence lock of mapped variables, odd while written, see
+     * @ref CO_PDO_seqlock */
+    volatile uint32_t seqlock;
+#endif
+    /** Configuration and mapping of this PDO */
+    CO_PDO_cold_t *cold;
 } CO_PDO_common_t;
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK) || defined CO_DOXYGEN
+/**
+ * Start reading mapped variables of the PDO, see @ref CO_PDO_seqlock
+ *
+ * Function does not wait. Read variables, then call CO_PDO_readRetry() and
+ * repeat everything, if it returns true.
+ *
+ * @param PDO Common properties of RPDO or TPDO.
+ *
+ * @return Sequence number for CO_PDO_readRetry().
+ */
+static inline uint32_t CO_PDO_readBegin(CO_PDO_common_t *PDO) {
+    uint32_t seq = PDO->seqlock;
+    CO_MemoryBarrier();
+    return seq;
+}
+
+/**
+ * Finish reading mapped variables of the PDO
+ *
+ * @param PDO Common properties of RPDO or TPDO.
+ * @param seq Value returned from CO_PDO_readBegin().
+ *
+ * @return True, if variables were written in the meantime and data read are
+ * not consistent.
+ */
+static inline bool_t CO_PDO_readRetry(CO_PDO_common_t *PDO, uint32_t seq) {
+    CO_MemoryBarrier();
+    return (seq & 1U) != 0U || PDO->seqlock != seq;
+}
+
+/**
+ * Try to lock mapped variables of the PDO for writing
+ *
+ * @param PDO Common properties of RPDO or TPDO.
+ *
+ * @return True on success, then CO_PDO_writeUnlock() must be called. False,
+ * if other writer holds the lock.
+ */
+static inline bool_t CO_PDO_writeTryLock(CO_PDO_common_t *PDO) {
+    uint32_t seq = PDO->seqlock;
+    return (seq & 1U) == 0U && CO_ATOMIC_CAS_U32(&PDO->seqlock, seq, seq + 1U);
+}
+
+/**
+ * Lock mapped variables of the PDO for writing, wait for other writers
+ *
+ * Must not be used from the real-time thread.
+ *
+ * @param PDO Common properties of RPDO or TPDO.
+ */
+static inline void CO_PDO_writeLock(CO_PDO_common_t *PDO) {
+    while (!CO_PDO_writeTryLock(PDO)) { }
+}
+
+/**
+ * Unlock mapped variables of the PDO after writing
+ *
+ * @param PDO Common properties of RPDO or TPDO.
+ */
+static inline void CO_PDO_writeUnlock(CO_PDO_common_t *PDO) {
+    CO_MemoryBarrier();
+    PDO->seqlock = PDO->seqlock + 1U;
+}
+
+/**
+ * Get consistent value of mapped variable from Object Dictionary
+ *
+ * Same as OD_get_value(), but protected by the sequence lock of the PDO. It
+ * retries until value is not written during the read.
+ *
+ * @param PDO Common properties of RPDO or TPDO, which maps the variable.
+ * @param entry OD entry returned by @ref OD_find().
+ * @param subIndex Sub-index of the variable from the OD object.
+ * @param [out] val Value will be written here.
+ * @param len Size of value to retrieve from OD.
+ * @param odOrig If true, then potential IO extension on entry will be ignored.
+ *
+ * @return Same as OD_get_value().
+ */
+ODR_t CO_PDO_getValue(CO_PDO_common_t *PDO,
+                      const OD_entry_t *entry, uint8_t subIndex,
+                      void *val, OD_size_t len, bool_t odOrig);
+
+/**
+ * Set value of mapped variable in Object Dictionary
+ *
+ * Same as OD_set_value(), but protected by the sequence lock of the PDO. Must
+ * not be used from the real-time thread.
+ *
+ * @param PDO Common properties of RPDO or TPDO, which maps the variable.
+ * @param entry OD entry returned by @ref OD_find().
+ * @param subIndex Sub-index of the variable from the OD object.
+ * @param val Pointer to value to write.
+ * @param len Size of value to write.
+ * @param odOrig If true, then potential IO extension on entry will be ignored.
+ *
+ * @return Same as OD_set_value().
+ */
+ODR_t CO_PDO_setValue(CO_PDO_common_t *PDO,
+                      const OD_entry_t *entry, uint8_t subIndex,
+                      void *val, OD_size_t len, bool_t odOrig);
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_SEQLOCK */
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE) || defined CO_DOXYGEN
+/** Number of PDO mapping parameters in CO_PDO_mapCache_t */
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
+#define CO_PDO_MAP_CACHE_ENTRIES CO_PDO_MAX_MAPPED_ENTRIES
+#else
+#define CO_PDO_MAP_CACHE_ENTRIES CO_PDO_MAX_SIZE
+#endif
+
+/** Value of CO_PDO_mapCache_t::entryPos, if OD entry is not known */
+#define CO_PDO_MAP_CACHE_NO_ENTRY 0xFFFFU
+/** Value of CO_PDO_mapCache_t::entryPos, if sub-index of PDO mapping
+ * parameter does not exist */
+#define CO_PDO_MAP_CACHE_NO_SUB 0xFFFEU
+
+/**
+ * Mapping of one PDO, see @ref CO_PDO_getMapCache()
+ *
+ * It contains PDO mapping parameters (index, sub-index and length of each
+ * mapped OD variable) and position of each mapped OD entry inside the Object
+ * Dictionary. There are no pointers, CO_RPDO_init() and CO_TPDO_init() resolve
+ * the mapping from it again, but without reading mapping parameters and
+ * without searching the Object Dictionary. Position is only a hint, it is used
+ * if OD entry at that position has the mapped index, otherwise OD entry is
+ * searched with OD_find(). Mapped OD variables are verified as usual, so cache
+ * from different firmware with different Object Dictionary is safe.
+ *
+ * Cache is valid only with the same PDO mapping parameters. It is intended to
+ * be stored together with them, for example in a boot snapshot from
+ * CO_storageEeprom_writeSnapshot(), which is invalidated by each store or
+ * restore command.
+ */
+typedef struct {
+    /** Number of mapped objects, sub-index 0 of PDO mapping parameter */
+    uint8_t mappedObjectsCount;
+    /** PDO mapping parameters, sub-index 1 and above */
+    uint32_t map[CO_PDO_MAP_CACHE_ENTRIES];
+    /** Position of the mapped OD entry inside OD_t::list or
+     * CO_PDO_MAP_CACHE_NO_ENTRY or CO_PDO_MAP_CACHE_NO_SUB */
+    uint16_t entryPos[CO_PDO_MAP_CACHE_ENTRIES];
+} CO_PDO_mapCache_t;
+
+
+/**
+ * Get mapping of the PDO for CO_PDO_mapCache_t
+ *
+ * @param OD Object Dictionary.
+ * @param OD_PDOMapPar OD entry for "PDO mapping parameter", 0x1600+ or 0x1A00+.
+ * @param [out] mapCache Mapping will be written here.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO on success, CO_ERROR_ILLEGAL_ARGUMENT
+ * or CO_ERROR_OD_PARAMETERS, if mapping parameters can not be read.
+ */
+CO_ReturnError_t CO_PDO_getMapCache(OD_t *OD,
+                                    OD_entry_t *OD_PDOMapPar,
+                                    CO_PDO_mapCache_t *mapCache);
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE */
+
+
 /*******************************************************************************
  *      R P D O
  ******************************************************************************/
@@ -283,6 +545,17 @@ typedef struct {
     /** From CO_RPDO_initCallbackPre() or NULL */
     void *functSignalObjectPre;
 #endif
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) || defined CO_DOXYGEN
+    /** Counter of RPDO messages, received before the previous one was
+     * processed, or NULL. Set by CO_CANopenInit() to
+     * CO_stats_block_t::rpdoOverwrite. */
+    uint32_t *overwriteCounter;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT) == 0 || defined CO_DOXYGEN
+    /** Configuration and mapping, used if CO_CONFIG_PDO_COLD_SPLIT is not
+     * enabled */
+    CO_PDO_cold_t coldData;
+#endif
 } CO_RPDO_t;
 
 
@@ -305,6 +578,12 @@ typedef struct {
  * entry is required.
  * @param CANdevRx CAN device for PDO reception.
  * @param CANdevRxIdx Index of receive buffer in the above CAN device.
+ * @param cold Memory for configuration and mapping of this RPDO, which must
+ * stay in memory permanently. Used with CO_CONFIG_PDO_COLD_SPLIT.
+ * @param mapCache If not NULL, mapping parameters are taken from it instead of
+ * OD_16xx_RPDOMapPar, see CO_PDO_mapCache_t. It must be from
+ * CO_PDO_getMapCache() with the same mapping parameters. Used with
+ * CO_CONFIG_PDO_MAP_CACHE.
  * @param [out] errInfo Additional information in case of error, may be NULL.
  *
  * @return #CO_ReturnError_t CO_ERROR_NO on success.
@@ -320,6 +599,12 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
                               OD_entry_t *OD_16xx_RPDOMapPar,
                               CO_CANmodule_t *CANdevRx,
                               uint16_t CANdevRxIdx,
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT) || defined CO_DOXYGEN
+                              CO_PDO_cold_t *cold,
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE) || defined CO_DOXYGEN
+                              const CO_PDO_mapCache_t *mapCache,
+#endif
                               uint32_t *errInfo);
 
 
@@ -341,6 +626,67 @@ void CO_RPDO_initCallbackPre(CO_RPDO_t *RPDO,
 #endif
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT) || defined CO_DOXYGEN
+/**
+ * Initialize RPDO copy function.
+ *
+ * Copy function replaces generic copying of received data into mapped OD
+ * variables inside CO_RPDO_process(). It is intended for PDOs, which have
+ * mapping fixed at build time. Function may be written (or generated) from
+ * OD.h and then it copies all variables with a few word-sized loads and
+ * stores, for example:
+ *
+ * @code
+void RPDO1_copy(void *object, uint8_t *data) {
+    OD_RAM.x6200_output = CO_getUint8(&data[0]);
+    OD_RAM.x6300_setpoint = CO_SWAP_16(CO_getUint16(&data[1]));
+    OD_RAM.x6301_position = CO_SWAP_32(CO_getUint32(&data[3]));
+}
+ * @endcode
+ *
+ * Function is called from CO_RPDO_process(), so OD locking is the same as
+ * with the generic copy. Up to CO_PDO_MAX_SIZE bytes of data are valid.
+ * If PDO mapping is changed later by CO_CONFIG_FLAG_OD_DYNAMIC, copy
+ * function is removed and generic copy is used again.
+ *
+ * Function must be called after CO_RPDO_init().
+ *
+ * @param RPDO This object.
+ * @param object Pointer to object, which will be passed to pFunctCopy().
+ * @param pFunctCopy Pointer to the copy function or NULL to use generic copy.
+ * @param dataLength Length of the PDO data, as expected by pFunctCopy(). It
+ * must match configured PDO mapping.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO on success or
+ * CO_ERROR_ILLEGAL_ARGUMENT, if dataLength does not match PDO mapping.
+ */
+CO_ReturnError_t CO_RPDO_initCopyFunct(CO_RPDO_t *RPDO,
+                                       void *object,
+                                       void (*pFunctCopy)(void *object,
+                                                          uint8_t *data),
+                                       CO_PDO_size_t dataLength);
+#endif
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST) || defined CO_DOXYGEN
+/**
+ * Initialize RPDO ready list, used by PDO scheduler.
+ *
+ * Each received RPDO message (also erroneous) puts the RPDO into the list, so
+ * CO_process_RPDO() processes it without checking all other RPDOs. Function
+ * is called by CO_CANopenInitPDO(), after CO_RPDO_init().
+ *
+ * @param RPDO This object.
+ * @param readyList List of ready objects, shared by all RPDOs from the same
+ * CAN module, or NULL to disable.
+ * @param readyId Id of this RPDO inside readyList.
+ */
+void CO_RPDO_initReadyList(CO_RPDO_t *RPDO,
+                           CO_readyList_t *readyList,
+                           uint16_t readyId);
+#endif
+
+
 /**
  * Process received PDO messages.
  *
@@ -363,6 +709,27 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
 #endif
                      bool_t NMTisOperational,
                      bool_t syncWas);
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER) || defined CO_DOXYGEN
+/**
+ * Check, if RPDO has pending event, used by PDO scheduler.
+ *
+ * Timeouts of asynchronous RPDOs are not considered here, they are handled by
+ * the scheduler. Synchronous RPDOs are pending on each SYNC. Change of NMT
+ * state must also be handled by the scheduler.
+ *
+ * @param RPDO This object.
+ * @param NMTisOperational True if this node is in NMT_OPERATIONAL state.
+ * @param syncWas True, if CANopen SYNC message was just received or
+ * transmitted.
+ *
+ * @return true, if CO_RPDO_process() must be called.
+ */
+bool_t CO_RPDO_isPending(CO_RPDO_t *RPDO,
+                         bool_t NMTisOperational,
+                         bool_t syncWas);
+#endif
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE */
 
 
@@ -370,6 +737,31 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
  *      T P D O
  ******************************************************************************/
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST) || defined CO_DOXYGEN
+/**
+ * Burst of synchronous TPDOs, see CO_CONFIG_PDO_SYNC_BURST.
+ *
+ * Synchronous TPDOs, which are due on SYNC, are packed by CO_TPDO_process()
+ * and inserted into burst in order of their CAN identifiers. Then whole burst
+ * is passed to CO_CANsendBurst() by CO_TPDO_burstSend(), so time from SYNC to
+ * the last synchronous TPDO is minimal and TPDOs are transmitted in order of
+ * their priority.
+ */
+typedef struct {
+    /** From CO_TPDO_burstInit() */
+    CO_CANmodule_t *CANdev;
+    /** From CO_TPDO_burstInit(), packed transmit buffers, sorted by canIds */
+    CO_CANtx_t **buffers;
+    /** From CO_TPDO_burstInit(), CAN identifiers of the buffers */
+    uint16_t *canIds;
+    /** From CO_TPDO_burstInit(), capacity of buffers and canIds */
+    uint16_t size;
+    /** Number of packed TPDOs in buffers */
+    uint16_t count;
+} CO_TPDO_burst_t;
+#endif
+
+
 /**
  * TPDO object.
  */
@@ -383,6 +775,13 @@ typedef struct {
     /** If this flag is set and TPDO is event driven (transmission type is 0,
      * 254 or 255), then PDO will be sent by CO_TPDO_process(). */
     bool_t sendRequest;
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_CHANGE_DETECT) || defined CO_DOXYGEN
+    /** Set by @ref OD_requestTPDO(), TPDO will be sent, if its data differs
+     * from the last transmitted data. */
+    bool_t changeRequest;
+    /** Data in CANtxBuff are already packed by change detection */
+    bool_t changePacked;
+#endif
 #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE) || defined CO_DOXYGEN
     /** From CO_TPDO_init() */
     CO_SYNC_t *SYNC;
@@ -401,6 +800,17 @@ typedef struct {
     /** Event timer variable in microseconds */
     uint32_t eventTimer;
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST) || defined CO_DOXYGEN
+    /** From CO_TPDO_initBurst() or NULL */
+    CO_TPDO_burst_t *burst;
+    /** Configured CAN identifier, used for sorting of the burst */
+    uint16_t burstCanId;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT) == 0 || defined CO_DOXYGEN
+    /** Configuration and mapping, used if CO_CONFIG_PDO_COLD_SPLIT is not
+     * enabled */
+    CO_PDO_cold_t coldData;
+#endif
 } CO_TPDO_t;
 
 
@@ -423,6 +833,10 @@ typedef struct {
  * entry is required.
  * @param CANdevTx CAN device used for PDO transmission.
  * @param CANdevTxIdx Index of transmit buffer in the above CAN device.
+ * @param cold Memory for configuration and mapping of this TPDO, which must
+ * stay in memory permanently. Used with CO_CONFIG_PDO_COLD_SPLIT.
+ * @param mapCache If not NULL, mapping parameters are taken from it, see
+ * CO_RPDO_init(). Used with CO_CONFIG_PDO_MAP_CACHE.
  * @param [out] errInfo Additional information in case of error, may be NULL.
  *
  * @return #CO_ReturnError_t CO_ERROR_NO on success.
@@ -438,6 +852,12 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
                               OD_entry_t *OD_1Axx_TPDOMapPar,
                               CO_CANmodule_t *CANdevTx,
                               uint16_t CANdevTxIdx,
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT) || defined CO_DOXYGEN
+                              CO_PDO_cold_t *cold,
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE) || defined CO_DOXYGEN
+                              const CO_PDO_mapCache_t *mapCache,
+#endif
                               uint32_t *errInfo);
 
 
@@ -455,6 +875,76 @@ static inline void CO_TPDOsendRequest(CO_TPDO_t *TPDO) {
 }
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_FUNCT) || defined CO_DOXYGEN
+/**
+ * Initialize TPDO copy function.
+ *
+ * Copy function replaces generic copying of mapped OD variables into TPDO
+ * data before transmission. It fills dataLength bytes of data. For more
+ * information see CO_RPDO_initCopyFunct().
+ *
+ * @param TPDO This object.
+ * @param object Pointer to object, which will be passed to pFunctCopy().
+ * @param pFunctCopy Pointer to the copy function or NULL to use generic copy.
+ * @param dataLength Length of the PDO data, as filled by pFunctCopy(). It
+ * must match configured PDO mapping.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO on success or
+ * CO_ERROR_ILLEGAL_ARGUMENT, if dataLength does not match PDO mapping.
+ */
+CO_ReturnError_t CO_TPDO_initCopyFunct(CO_TPDO_t *TPDO,
+                                       void *object,
+                                       void (*pFunctCopy)(void *object,
+                                                          uint8_t *data),
+                                       CO_PDO_size_t dataLength);
+#endif
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST) || defined CO_DOXYGEN
+/**
+ * Initialize burst of synchronous TPDOs.
+ *
+ * @param burst This object will be initialized.
+ * @param CANdev CAN device used for transmission. TPDOs on other CAN devices
+ * are sent directly.
+ * @param buffers Array of size elements.
+ * @param canIds Array of size elements.
+ * @param size Maximum number of TPDOs in burst, usually number of TPDOs.
+ */
+void CO_TPDO_burstInit(CO_TPDO_burst_t *burst,
+                       CO_CANmodule_t *CANdev,
+                       CO_CANtx_t *buffers[],
+                       uint16_t canIds[],
+                       uint16_t size);
+
+
+/**
+ * Assign TPDO to the burst.
+ *
+ * From now on synchronous TPDO is not sent by CO_TPDO_process(), but packed
+ * into burst. If burst is full, TPDO is sent directly.
+ *
+ * @param TPDO This object.
+ * @param burst Initialized burst object or NULL to disable.
+ */
+static inline void CO_TPDO_initBurst(CO_TPDO_t *TPDO, CO_TPDO_burst_t *burst) {
+    if (TPDO != NULL) { TPDO->burst = burst; }
+}
+
+
+/**
+ * Send all packed TPDOs from the burst.
+ *
+ * Must be called after CO_TPDO_process() of all TPDOs assigned to the burst.
+ *
+ * @param burst This object.
+ *
+ * @return Same as CO_CANsendBurst().
+ */
+CO_ReturnError_t CO_TPDO_burstSend(CO_TPDO_burst_t *burst);
+#endif
+
+
 /**
  * Process transmitting PDO messages.
  *
@@ -475,6 +965,26 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
 #endif
                      bool_t NMTisOperational,
                      bool_t syncWas);
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER) || defined CO_DOXYGEN
+/**
+ * Check, if TPDO has pending event, used by PDO scheduler.
+ *
+ * Event and inhibit timers are not considered here, they are handled by the
+ * scheduler. Change of NMT state must also be handled by the scheduler.
+ *
+ * @param TPDO This object.
+ * @param NMTisOperational True if this node is in NMT_OPERATIONAL state.
+ * @param syncWas True, if CANopen SYNC message was just received or
+ * transmitted.
+ *
+ * @return true, if CO_TPDO_process() must be called.
+ */
+bool_t CO_TPDO_isPending(CO_TPDO_t *TPDO,
+                         bool_t NMTisOperational,
+                         bool_t syncWas);
+#endif
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE */
 
 /** @} */ /* CO_PDO */
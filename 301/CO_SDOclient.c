@@ -52,6 +52,36 @@
 #define CO_CONFIG_SDO_CLI_PST 21
 #endif
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+ #if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK)
+  #error CO_CONFIG_SDO_CLI_BLOCK must be enabled.
+ #endif
+ #define CO_SDO_CLI_PST(SDO_C) ((SDO_C)->block_pst)
+#else
+ #define CO_SDO_CLI_PST(SDO_C) CO_CONFIG_SDO_CLI_PST
+#endif
+/* command specifier of initiate request, bit 4 requests complete access */
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+ #define CO_SDO_CLI_INIT_CS(SDO_C, cs) \
+    ((SDO_C)->complete ? (uint8_t)((cs) | 0x10) : (uint8_t)(cs))
+#else
+ #define CO_SDO_CLI_INIT_CS(SDO_C, cs) (cs)
+#endif
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+/* Measure time of block transfer for throughput calculation */
+static void CO_SDOclient_blockTime(CO_SDOclient_t *SDO_C,
+                                   uint32_t timeDifference_us)
+{
+    if (SDO_C != NULL && (SDO_C->state & CO_SDO_ST_FLAG_BLOCK) != 0U
+        && SDO_C->block_elapsed_us < (UINT32_MAX - timeDifference_us)
+    ) {
+        SDO_C->block_elapsed_us += timeDifference_us;
+    }
+}
+#endif
+
 
 /*
  * Read received message from CAN module.
@@ -286,6 +316,12 @@ CO_ReturnError_t CO_SDOclient_init(CO_SDOclient_t *SDO_C,
     /* prepare circular fifo buffer */
     CO_fifo_init(&SDO_C->bufFifo, SDO_C->buf,
                  CO_CONFIG_SDO_CLI_BUFFER_SIZE + 1);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    SDO_C->block_blksizeLimit = 127;
+    SDO_C->block_pst = CO_CONFIG_SDO_CLI_PST;
+    SDO_C->block_elapsed_us = 0;
+    SDO_C->block_throughput = 0;
+#endif
 
     /* Get parameters from Object Dictionary (initial values) */
     uint8_t maxSubIndex, nodeIDOfTheSDOServer;
@@ -450,9 +486,22 @@ CO_SDO_return_t CO_SDOclientDownloadInitiate(CO_SDOclient_t *SDO_C,
     SDO_C->sizeInd = sizeIndicated;
     SDO_C->sizeTran = 0;
     SDO_C->finished = false;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+    SDO_C->complete = false;
+#endif
     SDO_C->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000;
     SDO_C->timeoutTimer = 0;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    SDO_C->block_elapsed_us = 0;
+    SDO_C->block_throughput = 0;
+#endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+    /* fifo may use buffer from previous direct transfer */
+    CO_fifo_init(&SDO_C->bufFifo, SDO_C->buf,
+                 CO_CONFIG_SDO_CLI_BUFFER_SIZE + 1);
+#else
     CO_fifo_reset(&SDO_C->bufFifo);
+#endif
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
     /* if node-ID of the SDO server is the same as node-ID of this node, then
@@ -467,7 +516,7 @@ CO_SDO_return_t CO_SDOclientDownloadInitiate(CO_SDOclient_t *SDO_C,
 #endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK
     if (blockEnable && (sizeIndicated == 0 ||
-                        sizeIndicated > CO_CONFIG_SDO_CLI_PST)
+                        sizeIndicated > CO_SDO_CLI_PST(SDO_C))
     ) {
         SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_INITIATE_REQ;
     }
@@ -490,7 +539,7 @@ void CO_SDOclientDownloadInitiateSize(CO_SDOclient_t *SDO_C,
         SDO_C->sizeInd = sizeIndicated;
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK
         if (SDO_C->state == CO_SDO_ST_DOWNLOAD_BLK_INITIATE_REQ
-            && sizeIndicated > 0 && sizeIndicated <= CO_CONFIG_SDO_CLI_PST
+            && sizeIndicated > 0 && sizeIndicated <= CO_SDO_CLI_PST(SDO_C)
         ) {
             SDO_C->state = CO_SDO_ST_DOWNLOAD_INITIATE_REQ;
         }
@@ -499,6 +548,44 @@ void CO_SDOclientDownloadInitiateSize(CO_SDOclient_t *SDO_C,
 }
 
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+/******************************************************************************/
+void CO_SDOclientCompleteAccess(CO_SDOclient_t *SDO_C, bool_t enable) {
+    if (SDO_C != NULL) {
+        SDO_C->complete = enable;
+    }
+}
+#endif
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientDownloadInitiateDirect(CO_SDOclient_t *SDO_C,
+                                                   uint16_t index,
+                                                   uint8_t subIndex,
+                                                   uint8_t *buf,
+                                                   size_t size,
+                                                   uint16_t SDOtimeoutTime_ms,
+                                                   bool_t blockEnable)
+{
+    CO_SDO_return_t ret;
+
+    if (buf == NULL || size == 0) {
+        return CO_SDO_RT_wrongArguments;
+    }
+    ret = CO_SDOclientDownloadInitiate(SDO_C, index, subIndex, size,
+                                       SDOtimeoutTime_ms, blockEnable);
+    if (ret == CO_SDO_RT_ok_communicationEnd) {
+        /* Fifo contains all data from caller's buffer. Last byte of fifo
+         * buffer is never accessed, because fifo is not written. */
+        CO_fifo_init(&SDO_C->bufFifo, buf, size + 1);
+        SDO_C->bufFifo.writePtr = size;
+    }
+    return ret;
+}
+#endif
+
+
 /******************************************************************************/
 size_t CO_SDOclientDownloadBufWrite(CO_SDOclient_t *SDO_C,
                                     const uint8_t *buf,
@@ -526,6 +613,9 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
     CO_SDO_return_t ret = CO_SDO_RT_waitingResponse;
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    CO_SDOclient_blockTime(SDO_C, timeDifference_us);
+#endif
     if (SDO_C == NULL || !SDO_C->valid) {
         abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
         ret = CO_SDO_RT_wrongArguments;
@@ -540,6 +630,14 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
         if (SDO_C->OD_IO.write == NULL) {
             ODR_t odRet;
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+            if (SDO_C->complete) {
+                odRet = OD_getComplete(OD_find(SDO_C->OD, SDO_C->index),
+                                       SDO_C->subIndex, &SDO_C->OD_IO,
+                                       &SDO_C->OD_complete, false, true);
+            }
+            else
+#endif
             odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
                               &SDO_C->OD_IO, false);
 
@@ -565,8 +663,20 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
             size_t count = CO_fifo_getOccupied(&SDO_C->bufFifo);
             uint8_t buf[CO_CONFIG_SDO_CLI_BUFFER_SIZE + 2];
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+            /* caller's buffer may be larger than temporary buffer */
+            if (count > CO_CONFIG_SDO_CLI_BUFFER_SIZE) {
+                count = CO_CONFIG_SDO_CLI_BUFFER_SIZE;
+            }
+#endif
             CO_fifo_read(&SDO_C->bufFifo, buf, count, NULL);
             SDO_C->sizeTran += count;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+            /* rest of data will be written in the next pass */
+            if (CO_fifo_getOccupied(&SDO_C->bufFifo) > 0) {
+                bufferPartial = true;
+            }
+#endif
 
             /* error: no data */
             if (count == 0) {
@@ -809,6 +919,11 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
 
                     /* confirm successfully transmitted data */
                     CO_fifo_altFinish(&SDO_C->bufFifo, &SDO_C->block_crc);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+                    SDO_C->block_throughput = CO_SDO_blockThroughput(
+                                                SDO_C->sizeTran,
+                                                SDO_C->block_elapsed_us);
+#endif
 
                     if (SDO_C->finished) {
                         SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_END_REQ;
@@ -886,7 +1001,7 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
 
         switch (SDO_C->state) {
         case CO_SDO_ST_DOWNLOAD_INITIATE_REQ: {
-            SDO_C->CANtxBuff->data[0] = 0x20;
+            SDO_C->CANtxBuff->data[0] = CO_SDO_CLI_INIT_CS(SDO_C, 0x20);
             SDO_C->CANtxBuff->data[1] = (uint8_t)SDO_C->index;
             SDO_C->CANtxBuff->data[2] = (uint8_t)(SDO_C->index >> 8);
             SDO_C->CANtxBuff->data[3] = SDO_C->subIndex;
@@ -982,7 +1097,7 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK
         case CO_SDO_ST_DOWNLOAD_BLK_INITIATE_REQ: {
-            SDO_C->CANtxBuff->data[0] = 0xC4;
+            SDO_C->CANtxBuff->data[0] = CO_SDO_CLI_INIT_CS(SDO_C, 0xC4);
             SDO_C->CANtxBuff->data[1] = (uint8_t)SDO_C->index;
             SDO_C->CANtxBuff->data[2] = (uint8_t)(SDO_C->index >> 8);
             SDO_C->CANtxBuff->data[3] = SDO_C->subIndex;
@@ -1122,9 +1237,22 @@ CO_SDO_return_t CO_SDOclientUploadInitiate(CO_SDOclient_t *SDO_C,
     SDO_C->sizeInd = 0;
     SDO_C->sizeTran = 0;
     SDO_C->finished = false;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+    SDO_C->complete = false;
+#endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+    /* fifo may use buffer from previous direct transfer */
+    CO_fifo_init(&SDO_C->bufFifo, SDO_C->buf,
+                 CO_CONFIG_SDO_CLI_BUFFER_SIZE + 1);
+#else
     CO_fifo_reset(&SDO_C->bufFifo);
+#endif
     SDO_C->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000;
     SDO_C->timeoutTimer = 0;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    SDO_C->block_elapsed_us = 0;
+    SDO_C->block_throughput = 0;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK
     SDO_C->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
 #endif
@@ -1156,6 +1284,56 @@ CO_SDO_return_t CO_SDOclientUploadInitiate(CO_SDOclient_t *SDO_C,
 }
 
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientUploadInitiateDirect(CO_SDOclient_t *SDO_C,
+                                                 uint16_t index,
+                                                 uint8_t subIndex,
+                                                 uint8_t *buf,
+                                                 size_t size,
+                                                 uint16_t SDOtimeoutTime_ms,
+                                                 bool_t blockEnable)
+{
+    CO_SDO_return_t ret;
+
+    if (buf == NULL || size == 0) {
+        return CO_SDO_RT_wrongArguments;
+    }
+    ret = CO_SDOclientUploadInitiate(SDO_C, index, subIndex,
+                                     SDOtimeoutTime_ms, blockEnable);
+    if (ret == CO_SDO_RT_ok_communicationEnd) {
+        /* Fifo is never read, so it does not wrap and data are written
+         * sequentially into caller's buffer. Last byte of fifo buffer is
+         * never accessed. */
+        CO_fifo_init(&SDO_C->bufFifo, buf, size + 1);
+    }
+    return ret;
+}
+#endif
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_SEGMENTED
+/*
+ * Free space in data buffer for segmented or block upload.
+ *
+ * Caller's buffer from CO_SDOclientUploadInitiateDirect() may be sized exactly
+ * for the data. If the rest of indicated data fits into it, space for whole
+ * segments is returned, because the last segment contains less data.
+ */
+static size_t CO_SDOclient_uploadSpace(CO_SDOclient_t *SDO_C) {
+    size_t space = CO_fifo_getSpace(&SDO_C->bufFifo);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+    if (SDO_C->bufFifo.buf != SDO_C->buf && SDO_C->sizeInd > SDO_C->sizeTran
+        && space >= (SDO_C->sizeInd - SDO_C->sizeTran)
+    ) {
+        space = (SDO_C->sizeInd - SDO_C->sizeTran + 6) / 7 * 7;
+    }
+#endif
+    return space;
+}
+#endif
+
+
 /******************************************************************************/
 CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
                                    uint32_t timeDifference_us,
@@ -1170,6 +1348,9 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
     CO_SDO_return_t ret = CO_SDO_RT_waitingResponse;
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    CO_SDOclient_blockTime(SDO_C, timeDifference_us);
+#endif
     if (SDO_C == NULL || !SDO_C->valid) {
         abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
         ret = CO_SDO_RT_wrongArguments;
@@ -1184,6 +1365,14 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
         if (SDO_C->OD_IO.read == NULL) {
             ODR_t odRet;
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+            if (SDO_C->complete) {
+                odRet = OD_getComplete(OD_find(SDO_C->OD, SDO_C->index),
+                                       SDO_C->subIndex, &SDO_C->OD_IO,
+                                       &SDO_C->OD_complete, false, false);
+            }
+            else
+#endif
             odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
                               &SDO_C->OD_IO, false);
 
@@ -1206,6 +1395,12 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
         }
 
         size_t countFifo = CO_fifo_getSpace(&SDO_C->bufFifo);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+        /* caller's buffer may be larger than temporary buffer below */
+        if (countFifo > CO_CONFIG_SDO_CLI_BUFFER_SIZE) {
+            countFifo = CO_CONFIG_SDO_CLI_BUFFER_SIZE;
+        }
+#endif
 
         /* skip copying if buffer full */
         if (countFifo == 0) {
@@ -1622,7 +1817,7 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 
         switch (SDO_C->state) {
         case CO_SDO_ST_UPLOAD_INITIATE_REQ: {
-            SDO_C->CANtxBuff->data[0] = 0x40;
+            SDO_C->CANtxBuff->data[0] = CO_SDO_CLI_INIT_CS(SDO_C, 0x40);
             SDO_C->CANtxBuff->data[1] = (uint8_t)SDO_C->index;
             SDO_C->CANtxBuff->data[2] = (uint8_t)(SDO_C->index >> 8);
             SDO_C->CANtxBuff->data[3] = SDO_C->subIndex;
@@ -1637,7 +1832,7 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_SEGMENTED
         case CO_SDO_ST_UPLOAD_SEGMENT_REQ: {
             /* verify, if there is enough space in data buffer */
-            if (CO_fifo_getSpace(&SDO_C->bufFifo) < 7) {
+            if (CO_SDOclient_uploadSpace(SDO_C) < 7) {
                 ret = CO_SDO_RT_uploadDataBufferFull;
                 break;
             }
@@ -1653,7 +1848,7 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK
         case CO_SDO_ST_UPLOAD_BLK_INITIATE_REQ: {
-            SDO_C->CANtxBuff->data[0] = 0xA4;
+            SDO_C->CANtxBuff->data[0] = CO_SDO_CLI_INIT_CS(SDO_C, 0xA4);
             SDO_C->CANtxBuff->data[1] = (uint8_t)SDO_C->index;
             SDO_C->CANtxBuff->data[2] = (uint8_t)(SDO_C->index >> 8);
             SDO_C->CANtxBuff->data[3] = SDO_C->subIndex;
@@ -1668,9 +1863,14 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
                 SDO_C->state = CO_SDO_ST_ABORT;
                 break;
             }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+            if (count > SDO_C->block_blksizeLimit) {
+                count = SDO_C->block_blksizeLimit;
+            }
+#endif
             SDO_C->block_blksize = (uint8_t)count;
             SDO_C->CANtxBuff->data[4] = SDO_C->block_blksize;
-            SDO_C->CANtxBuff->data[5] = CO_CONFIG_SDO_CLI_PST;
+            SDO_C->CANtxBuff->data[5] = CO_SDO_CLI_PST(SDO_C);
 
             /* reset timeout timer and send message */
             SDO_C->timeoutTimer = 0;
@@ -1702,6 +1902,11 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
             bool_t transferShort = SDO_C->block_seqno != SDO_C->block_blksize;
             uint8_t seqnoStart = SDO_C->block_seqno;
 #endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+            SDO_C->block_throughput = CO_SDO_blockThroughput(
+                                        SDO_C->sizeTran,
+                                        SDO_C->block_elapsed_us);
+#endif
 
             /* Is last segment? */
             if (SDO_C->finished) {
@@ -1716,11 +1921,16 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
                 }
 
                 /* calculate number of block segments from free buffer space */
-                count = CO_fifo_getSpace(&SDO_C->bufFifo) / 7;
+                count = CO_SDOclient_uploadSpace(SDO_C) / 7;
                 if (count >= 127) {
                     count = 127;
                 }
-                else if (CO_fifo_getOccupied(&SDO_C->bufFifo) > 0) {
+                else if (CO_fifo_getOccupied(&SDO_C->bufFifo) > 0
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+                         /* caller's buffer is not emptied, use smaller block */
+                         && (count == 0 || SDO_C->bufFifo.buf == SDO_C->buf)
+#endif
+                ) {
                     /* application must empty data buffer first */
                     ret = CO_SDO_RT_uploadDataBufferFull;
 #ifdef CO_DEBUG_SDO_CLIENT
@@ -1740,6 +1950,16 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 #endif
                     break;
                 }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+                /* lost segments decrease, complete sub-blocks increase limit */
+                SDO_C->block_blksizeLimit = CO_SDO_blksizeAdapt(
+                                                SDO_C->block_blksizeLimit,
+                                                SDO_C->block_blksize,
+                                                SDO_C->block_seqno);
+                if (count > SDO_C->block_blksizeLimit) {
+                    count = SDO_C->block_blksizeLimit;
+                }
+#endif
                 SDO_C->block_blksize = (uint8_t)count;
                 SDO_C->block_seqno = 0;
                 /* Block segments will be received in different thread. Make
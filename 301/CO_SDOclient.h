@@ -181,6 +181,12 @@ typedef struct {
     uint8_t nodeId;
     /** Object dictionary interface for locally transferred object */
     OD_IO_t OD_IO;
+#endif
+#if (((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL) \
+     && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE)) \
+    || defined CO_DOXYGEN
+    /** State of complete access for locally transferred object */
+    OD_complete_t OD_complete;
 #endif
     /** From CO_SDOclient_init() */
     CO_CANmodule_t *CANdevRx;
@@ -213,6 +219,10 @@ typedef struct {
     uint8_t subIndex;
     /* If true, then data transfer is finished */
     bool_t finished;
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE) || defined CO_DOXYGEN
+    /** True for complete access, see CO_SDOclientCompleteAccess() */
+    bool_t complete;
+#endif
     /** Size of data, which will be transferred. It is optionally indicated by
      * client in case of download or by server in case of upload. */
     size_t sizeInd;
@@ -262,6 +272,20 @@ typedef struct {
     /** Calculated CRC checksum */
     uint16_t block_crc;
 #endif
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE) || defined CO_DOXYGEN
+    /** Upper limit for blksize in block upload, adapted after each sub-block
+     * with CO_SDO_blksizeAdapt(). It is kept between transfers. */
+    uint8_t block_blksizeLimit;
+    /** 'Protocol switch threshold' for block transfer, initialized to
+     * CO_CONFIG_SDO_CLI_PST. If size of data is equal or lower, then segmented
+     * transfer is used. May be changed by application between transfers. */
+    uint8_t block_pst;
+    /** Time elapsed since start of the current block transfer */
+    uint32_t block_elapsed_us;
+    /** Throughput of the current or the last block transfer in bytes/second,
+     * updated after each sub-block. May be read by application. */
+    uint32_t block_throughput;
+#endif
 } CO_SDOclient_t;
 
 
@@ -389,6 +413,56 @@ void CO_SDOclientDownloadInitiateSize(CO_SDOclient_t *SDO_C,
                                       size_t sizeIndicated);
 
 
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF) || defined CO_DOXYGEN
+/**
+ * Initiate SDO download communication from caller's buffer.
+ *
+ * Same as CO_SDOclientDownloadInitiate(), but SDO client transfers data
+ * directly from buf, without copying it into internal buffer. All data are
+ * available from the beginning, so CO_SDOclientDownloadBufWrite() must not be
+ * used and CO_SDOclientDownload() must be called with bufferPartial set to
+ * false. CRC for block transfer is calculated from buf.
+ *
+ * @param SDO_C This object.
+ * @param index Index of object in object dictionary in remote node.
+ * @param subIndex Subindex of object in object dictionary in remote node.
+ * @param buf Buffer with data. It is not modified and must stay valid until
+ * end of the transfer.
+ * @param size Size of data, it is also indicated to the server.
+ * @param SDOtimeoutTime_ms Timeout time for SDO communication in milliseconds.
+ * @param blockEnable Try to initiate block transfer.
+ *
+ * @return #CO_SDO_return_t
+ */
+CO_SDO_return_t CO_SDOclientDownloadInitiateDirect(CO_SDOclient_t *SDO_C,
+                                                   uint16_t index,
+                                                   uint8_t subIndex,
+                                                   uint8_t *buf,
+                                                   size_t size,
+                                                   uint16_t SDOtimeoutTime_ms,
+                                                   bool_t blockEnable);
+#endif
+
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE) || defined CO_DOXYGEN
+/**
+ * Request complete access to ARRAY or RECORD object.
+ *
+ * Function may be called after download or upload initiate function and before
+ * the first CO_SDOclientDownload() or CO_SDOclientUpload() call. Initiate
+ * functions disable complete access. Bit 4 is then set in the initiate request
+ * and the server transfers all sub-objects, starting from subIndex from the
+ * initiate function, as one image. Format of the image is described in
+ * OD_getComplete(). Server must support it, see CO_CONFIG_SDO_SRV_COMPLETE,
+ * otherwise it aborts the transfer. Local transfer uses OD_getComplete().
+ *
+ * @param SDO_C This object.
+ * @param enable True to enable complete access.
+ */
+void CO_SDOclientCompleteAccess(CO_SDOclient_t *SDO_C, bool_t enable);
+#endif
+
+
 /**
  * Write data into SDO client buffer
  *
@@ -472,6 +546,39 @@ CO_SDO_return_t CO_SDOclientUploadInitiate(CO_SDOclient_t *SDO_C,
                                            bool_t blockEnable);
 
 
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF) || defined CO_DOXYGEN
+/**
+ * Initiate SDO upload communication into caller's buffer.
+ *
+ * Same as CO_SDOclientUploadInitiate(), but SDO client writes received data
+ * directly into buf, without internal buffer. Segmented and block transfers
+ * use free space in buf for flow control, CRC for block transfer is
+ * calculated while data are written. CO_SDOclientUploadBufRead() must not be
+ * used. After CO_SDOclientUpload() returns #CO_SDO_RT_ok_communicationEnd,
+ * buf contains sizeTransferred bytes of data. If CO_SDOclientUpload() returns
+ * #CO_SDO_RT_uploadDataBufferFull, then data are larger than buf and
+ * transfer should be aborted.
+ *
+ * @param SDO_C This object.
+ * @param index Index of object in object dictionary in remote node.
+ * @param subIndex Subindex of object in object dictionary in remote node.
+ * @param buf Buffer for data, must stay valid until end of the transfer.
+ * @param size Size of buf.
+ * @param SDOtimeoutTime_ms Timeout time for SDO communication in milliseconds.
+ * @param blockEnable Try to initiate block transfer.
+ *
+ * @return #CO_SDO_return_t
+ */
+CO_SDO_return_t CO_SDOclientUploadInitiateDirect(CO_SDOclient_t *SDO_C,
+                                                 uint16_t index,
+                                                 uint8_t subIndex,
+                                                 uint8_t *buf,
+                                                 size_t size,
+                                                 uint16_t SDOtimeoutTime_ms,
+                                                 bool_t blockEnable);
+#endif
+
+
 /**
  * Process SDO upload communication.
  *
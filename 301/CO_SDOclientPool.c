@@ -0,0 +1,297 @@
+/*
+ * Pool of SDO clients for parallel access to many nodes
+ *
+ * @file        CO_SDOclientPool.c
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_SDOclientPool.h"
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL
+
+#if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE)
+#error CO_CONFIG_SDO_CLI_ENABLE must be enabled.
+#endif
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientPool_init(CO_SDOclientPool_t *pool,
+                                       CO_SDOclient_t SDO_C[],
+                                       uint8_t channelsCount)
+{
+    if (pool == NULL || SDO_C == NULL || channelsCount == 0
+        || channelsCount > CO_SDO_CLI_POOL_CHANNELS
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(pool, 0, sizeof(CO_SDOclientPool_t));
+    pool->SDO_C = SDO_C;
+    pool->channelsCount = channelsCount;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientPool_submit(CO_SDOclientPool_t *pool,
+                                         CO_SDOclientPool_request_t *req)
+{
+    if (pool == NULL || req == NULL || req->buf == NULL
+        || req->nodeId < 1 || req->nodeId > 127
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    req->abortCode = CO_SDO_AB_NONE;
+    req->sizeTransferred = 0;
+    req->bufOffset = 0;
+    req->next = NULL;
+
+    if (pool->queueFirst == NULL) {
+        pool->queueFirst = req;
+    }
+    else {
+        pool->queueLast->next = req;
+    }
+    pool->queueLast = req;
+
+    return CO_ERROR_NO;
+}
+
+
+/*
+ * Process one step of the transfer on SDO client.
+ *
+ * @return true, if transfer is finished.
+ */
+static bool_t CO_SDOclientPool_step(CO_SDOclient_t *SDO_C,
+                                    CO_SDOclientPool_request_t *req,
+                                    uint32_t timeDifference_us,
+                                    uint32_t *timerNext_us)
+{
+    CO_SDO_return_t ret;
+    bool_t abort = req->abortCode != CO_SDO_AB_NONE;
+
+    if (req->upload) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+        /* data are written directly into req->buf */
+        ret = CO_SDOclientUpload(SDO_C, timeDifference_us, abort,
+                                 &req->abortCode, NULL, &req->sizeTransferred,
+                                 timerNext_us);
+        if (ret == CO_SDO_RT_uploadDataBufferFull) {
+            /* data does not fit into buffer, abort in the next step */
+            req->abortCode = CO_SDO_AB_OUT_OF_MEM;
+        }
+#else
+        ret = CO_SDOclientUpload(SDO_C, timeDifference_us, abort,
+                                 &req->abortCode, NULL, NULL, timerNext_us);
+        if (ret >= CO_SDO_RT_ok_communicationEnd) {
+            req->sizeTransferred += CO_SDOclientUploadBufRead(SDO_C,
+                                        &req->buf[req->sizeTransferred],
+                                        req->bufSize - req->sizeTransferred);
+            if (CO_fifo_getOccupied(&SDO_C->bufFifo) > 0) {
+                /* data does not fit into buffer, abort in the next step */
+                req->abortCode = CO_SDO_AB_OUT_OF_MEM;
+                if (ret == CO_SDO_RT_ok_communicationEnd) {
+                    ret = CO_SDO_RT_endedWithClientAbort;
+                }
+            }
+        }
+#endif
+    }
+    else {
+        if (req->bufOffset < req->bufSize) {
+            req->bufOffset += CO_SDOclientDownloadBufWrite(SDO_C,
+                                  &req->buf[req->bufOffset],
+                                  req->bufSize - req->bufOffset);
+        }
+        ret = CO_SDOclientDownload(SDO_C, timeDifference_us, abort,
+                                   req->bufOffset < req->bufSize,
+                                   &req->abortCode, &req->sizeTransferred,
+                                   timerNext_us);
+    }
+
+    if (ret > CO_SDO_RT_ok_communicationEnd) {
+        return false;
+    }
+    if (ret < CO_SDO_RT_ok_communicationEnd
+        && req->abortCode == CO_SDO_AB_NONE
+    ) {
+        req->abortCode = CO_SDO_AB_GENERAL;
+    }
+    CO_SDOclientClose(SDO_C);
+    return true;
+}
+
+
+/* Start transfer of the request on SDO client. Return true, if finished. */
+static bool_t CO_SDOclientPool_start(CO_SDOclient_t *SDO_C,
+                                     CO_SDOclientPool_request_t *req,
+                                     uint32_t *timerNext_us)
+{
+    CO_SDO_return_t ret;
+
+    ret = CO_SDOclient_setup(SDO_C,
+                             CO_CAN_ID_SDO_CLI + req->nodeId,
+                             CO_CAN_ID_SDO_SRV + req->nodeId,
+                             req->nodeId);
+    if (ret == CO_SDO_RT_ok_communicationEnd) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_DIRECT_BUF
+        if (req->upload) {
+            ret = CO_SDOclientUploadInitiateDirect(SDO_C, req->index,
+                                                   req->subIndex, req->buf,
+                                                   req->bufSize,
+                                                   req->SDOtimeoutTime_ms,
+                                                   req->blockEnable);
+        }
+        else {
+            ret = CO_SDOclientDownloadInitiateDirect(SDO_C, req->index,
+                                                     req->subIndex, req->buf,
+                                                     req->bufSize,
+                                                     req->SDOtimeoutTime_ms,
+                                                     req->blockEnable);
+            req->bufOffset = req->bufSize;
+        }
+#else
+        if (req->upload) {
+            ret = CO_SDOclientUploadInitiate(SDO_C, req->index, req->subIndex,
+                                             req->SDOtimeoutTime_ms,
+                                             req->blockEnable);
+        }
+        else {
+            ret = CO_SDOclientDownloadInitiate(SDO_C, req->index,
+                                               req->subIndex, req->bufSize,
+                                               req->SDOtimeoutTime_ms,
+                                               req->blockEnable);
+        }
+#endif
+    }
+    if (ret != CO_SDO_RT_ok_communicationEnd) {
+        req->abortCode = CO_SDO_AB_GENERAL;
+        return true;
+    }
+
+    /* send initiate request immediately */
+    return CO_SDOclientPool_step(SDO_C, req, 0, timerNext_us);
+}
+
+
+/* Return true, if transfer with the node is active on any SDO client */
+static bool_t CO_SDOclientPool_nodeBusy(CO_SDOclientPool_t *pool,
+                                        uint8_t nodeId)
+{
+    for (uint8_t i = 0; i < pool->channelsCount; i++) {
+        if (pool->active[i] != NULL && pool->active[i]->nodeId == nodeId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* Remove the first request for idle node from the queue, if any */
+static CO_SDOclientPool_request_t *CO_SDOclientPool_next(
+                                            CO_SDOclientPool_t *pool)
+{
+    CO_SDOclientPool_request_t *prev = NULL;
+    CO_SDOclientPool_request_t *req = pool->queueFirst;
+
+    while (req != NULL) {
+        if (!CO_SDOclientPool_nodeBusy(pool, req->nodeId)) {
+            if (prev == NULL) {
+                pool->queueFirst = req->next;
+            }
+            else {
+                prev->next = req->next;
+            }
+            if (pool->queueLast == req) {
+                pool->queueLast = prev;
+            }
+            req->next = NULL;
+            return req;
+        }
+        prev = req;
+        req = req->next;
+    }
+    return NULL;
+}
+
+
+/* Inform application about finished request */
+static void CO_SDOclientPool_done(CO_SDOclientPool_request_t *req) {
+    if (req->pFunctDone != NULL) {
+        req->pFunctDone(req->functDoneObject, req);
+    }
+}
+
+
+/******************************************************************************/
+uint16_t CO_SDOclientPool_process(CO_SDOclientPool_t *pool,
+                                  uint32_t timeDifference_us,
+                                  uint32_t *timerNext_us)
+{
+    uint16_t count = 0;
+
+    if (pool == NULL) {
+        return 0;
+    }
+
+    /* active transfers */
+    for (uint8_t i = 0; i < pool->channelsCount; i++) {
+        CO_SDOclientPool_request_t *req = pool->active[i];
+
+        if (req != NULL
+            && CO_SDOclientPool_step(&pool->SDO_C[i], req,
+                                     timeDifference_us, timerNext_us)
+        ) {
+            pool->active[i] = NULL;
+            CO_SDOclientPool_done(req);
+        }
+    }
+
+    /* start waiting requests on free SDO clients */
+    for (uint8_t i = 0; i < pool->channelsCount; i++) {
+        while (pool->active[i] == NULL) {
+            CO_SDOclientPool_request_t *req = CO_SDOclientPool_next(pool);
+
+            if (req == NULL) {
+                break;
+            }
+            pool->active[i] = req;
+            if (CO_SDOclientPool_start(&pool->SDO_C[i], req, timerNext_us)) {
+                pool->active[i] = NULL;
+                CO_SDOclientPool_done(req);
+            }
+        }
+        if (pool->active[i] != NULL) {
+            count++;
+        }
+    }
+
+    for (CO_SDOclientPool_request_t *req = pool->queueFirst;
+         req != NULL; req = req->next
+    ) {
+        count++;
+    }
+
+    return count;
+}
+
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL */
@@ -0,0 +1,199 @@
+/**
+ * Pool of SDO clients for parallel access to many nodes
+ *
+ * @file        CO_SDOclientPool.h
+ * @ingroup     CO_SDOclientPool
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SDO_CLIENT_POOL_H
+#define CO_SDO_CLIENT_POOL_H
+
+#include "301/CO_SDOclient.h"
+
+#ifndef CO_SDO_CLI_POOL_CHANNELS
+/** Maximum number of SDO clients inside @ref CO_SDOclientPool_t */
+#define CO_SDO_CLI_POOL_CHANNELS 8
+#endif
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_SDOclientPool SDO client pool
+ * Queue of SDO requests, which are executed on multiple SDO clients.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * Single @ref CO_SDOclient_t executes one transfer at a time. SDO client pool
+ * keeps a queue of requests (node-ID, index, sub-index, buffer and callback)
+ * and executes them on multiple SDO clients (0x1280+) simultaneously. At
+ * most one transfer is active for each remote node, because SDO server
+ * usually handles only one transfer. Requests are started in order of
+ * submission, request for busy node waits and requests for other nodes are
+ * started before it.
+ *
+ * Request objects are allocated by the application and must not be modified
+ * until their callback is called. All functions must be called from the same
+ * thread, usually the mainline, which also processes the SDO clients in the
+ * pool. SDO clients in the pool must not be used elsewhere (for example by
+ * the gateway).
+ *
+ * Example:
+ * @code{.c}
+static CO_SDOclientPool_t pool;
+static CO_SDOclientPool_request_t req[100];
+static uint32_t deviceType[100];
+
+static void readDone(void *object, CO_SDOclientPool_request_t *r) {
+    if (r->abortCode != CO_SDO_AB_NONE) { ... }
+}
+
+CO_SDOclientPool_init(&pool, &co->SDOclient[1], 4);
+for (uint8_t i = 0; i < 100; i++) {
+    req[i].nodeId = i + 1;
+    req[i].index = 0x1000;
+    req[i].subIndex = 0;
+    req[i].upload = true;
+    req[i].buf = (uint8_t *)&deviceType[i];
+    req[i].bufSize = sizeof(deviceType[i]);
+    req[i].SDOtimeoutTime_ms = 500;
+    req[i].blockEnable = false;
+    req[i].pFunctDone = readDone;
+    req[i].functDoneObject = NULL;
+    CO_SDOclientPool_submit(&pool, &req[i]);
+}
+// in mainline:
+CO_SDOclientPool_process(&pool, timeDifference_us, &timerNext_us);
+ * @endcode
+ */
+
+
+/**
+ * Request for SDO client pool.
+ */
+typedef struct CO_SDOclientPool_request {
+    /** Node-ID of the SDO server, 1 to 127. Default SDO CAN identifiers are
+     * used. */
+    uint8_t nodeId;
+    /** Index of the object in remote Object Dictionary */
+    uint16_t index;
+    /** Sub-index of the object in remote Object Dictionary */
+    uint8_t subIndex;
+    /** If true, then data are read from remote node (SDO upload), otherwise
+     * they are written (SDO download) */
+    bool_t upload;
+    /** Buffer with data for download or for uploaded data */
+    uint8_t *buf;
+    /** Size of the data for download or size of the buffer for upload */
+    size_t bufSize;
+    /** Timeout time for SDO communication in milliseconds */
+    uint16_t SDOtimeoutTime_ms;
+    /** Try to initiate block transfer */
+    bool_t blockEnable;
+    /** Callback, called from CO_SDOclientPool_process() after end of the
+     * transfer, may be NULL */
+    void (*pFunctDone)(void *object, struct CO_SDOclientPool_request *req);
+    /** Object passed to pFunctDone */
+    void *functDoneObject;
+    /** [out] Result, CO_SDO_AB_NONE on success */
+    CO_SDO_abortCode_t abortCode;
+    /** [out] Number of bytes transferred */
+    size_t sizeTransferred;
+    /** Internal, number of bytes already written to SDO client (download) */
+    size_t bufOffset;
+    /** Internal, next request in the queue */
+    struct CO_SDOclientPool_request *next;
+} CO_SDOclientPool_request_t;
+
+
+/**
+ * SDO client pool object.
+ */
+typedef struct {
+    /** From CO_SDOclientPool_init() */
+    CO_SDOclient_t *SDO_C;
+    /** From CO_SDOclientPool_init() */
+    uint8_t channelsCount;
+    /** Active request on each SDO client or NULL */
+    CO_SDOclientPool_request_t *active[CO_SDO_CLI_POOL_CHANNELS];
+    /** First request waiting in queue */
+    CO_SDOclientPool_request_t *queueFirst;
+    /** Last request waiting in queue */
+    CO_SDOclientPool_request_t *queueLast;
+} CO_SDOclientPool_t;
+
+
+/**
+ * Initialize SDO client pool.
+ *
+ * @param pool This object will be initialized.
+ * @param SDO_C Array of initialized SDO clients.
+ * @param channelsCount Number of SDO clients in array, 1 to
+ * CO_SDO_CLI_POOL_CHANNELS.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientPool_init(CO_SDOclientPool_t *pool,
+                                       CO_SDOclient_t SDO_C[],
+                                       uint8_t channelsCount);
+
+
+/**
+ * Add request to the end of the queue.
+ *
+ * @param pool This object.
+ * @param req Request, filled by application. Output members are cleared.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientPool_submit(CO_SDOclientPool_t *pool,
+                                         CO_SDOclientPool_request_t *req);
+
+
+/**
+ * Process SDO client pool.
+ *
+ * Function processes active transfers, calls callbacks of finished requests
+ * and starts waiting requests on free SDO clients. It must be called
+ * cyclically.
+ *
+ * @param pool This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process(). Ignored if NULL.
+ *
+ * @return Number of requests, which are active or waiting in the queue.
+ */
+uint16_t CO_SDOclientPool_process(CO_SDOclientPool_t *pool,
+                                  uint32_t timeDifference_us,
+                                  uint32_t *timerNext_us);
+
+/** @} */ /* CO_SDOclientPool */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL */
+
+#endif /* CO_SDO_CLIENT_POOL_H */
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "301/CO_SDOserver.h"
+#include "301/CO_endian.h"
 #include "301/crc16-ccitt.h"
 
 /* verify configuration */
@@ -41,10 +42,103 @@
  #if !((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE)
   #error CO_CONFIG_CRC16_ENABLE must be enabled.
  #endif
- #if CO_CONFIG_SDO_SRV_BUFFER_SIZE < 900
+ #if CO_CONFIG_SDO_SRV_BUFFER_SIZE < 900 \
+     && !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM)
   #error CO_CONFIG_SDO_SRV_BUFFER_SIZE must be greater or equal than 900.
  #endif
 #endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_COMPLETE
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+ #if CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT < 1 \
+     || CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT > 32
+  #error CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT must be from 1 to 32.
+ #endif
+ /* size of current data buffer */
+ #define CO_SDO_SRV_BUF_SIZE(SDO) ((SDO)->bufSize)
+#else
+ #define CO_SDO_SRV_BUF_SIZE(SDO) CO_CONFIG_SDO_SRV_BUFFER_SIZE
+#endif
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD
+/*
+ * Answer expedited upload request from the table of fast entries. Called from
+ * CO_SDO_receive() for initiate upload request, when no other message is
+ * waiting for processing.
+ *
+ * SDO client sends next request only after the response to the previous one,
+ * so CANtxBuff is not used by CO_SDOserver_process() while server is idle.
+ *
+ * Returns true, if response was sent.
+ */
+static bool_t fastUpload(CO_SDOserver_t *SDO, const uint8_t *data) {
+    const CO_SDOserver_fastEntry_t *entry = NULL;
+    uint32_t key = ((uint32_t)data[2] << 16) | ((uint32_t)data[1] << 8)
+                   | data[3];
+    uint16_t lo = 0;
+    uint16_t hi = SDO->fastEntriesCount;
+
+    if (!SDO->fastAllowed || !SDO->valid || SDO->state != CO_SDO_ST_IDLE
+        || SDO->CANtxBuff->bufferFull
+    ) {
+        return false;
+    }
+
+    /* binary search, entries are sorted by key */
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)((lo + hi) / 2U);
+        uint32_t keyMid = SDO->fastEntries[mid].key;
+        if (keyMid < key) {
+            lo = mid + 1U;
+        }
+        else if (keyMid > key) {
+            hi = mid;
+        }
+        else {
+            entry = &SDO->fastEntries[mid];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        return false;
+    }
+
+    uint8_t *txData = SDO->CANtxBuff->data;
+    uint8_t len = entry->dataLength;
+
+    memset(txData, 0, 8);
+    txData[0] = (uint8_t)(0x43U | ((4U - len) << 2));
+    txData[1] = data[1];
+    txData[2] = data[2];
+    txData[3] = data[3];
+
+    CO_LOCK_OD(SDO->CANdevTx);
+#if (C2000_PORT != 0)
+    memcpy(&txData[4], entry->dataOrig, (len + 1U) / 2U);
+    CO_UNLOCK_OD(SDO->CANdevTx);
+    CO_wordsToBytes(&txData[4], len);
+#else
+    memcpy(&txData[4], entry->dataOrig, len);
+    CO_UNLOCK_OD(SDO->CANdevTx);
+#endif
+
+#ifdef CO_BIG_ENDIAN
+    if ((entry->attribute & ODA_MB) != 0) {
+        CO_swapBytes(&txData[4], len);
+    }
+#endif
+
+    (void)CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
+    return true;
+}
+#endif
+
 
 /*
  * Read received message from CAN module.
@@ -77,7 +171,7 @@ static void CO_SDO_receive(void *object, void *msg) {
         }
         else if (SDO->state == CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ) {
             /* just in case, condition should always pass */
-            if (SDO->bufOffsetWr <= (CO_CONFIG_SDO_SRV_BUFFER_SIZE - (7+2))) {
+            if (SDO->bufOffsetWr <= (CO_SDO_SRV_BUF_SIZE(SDO) - (7+2))) {
                 /* block download, copy data directly */
                 CO_SDO_state_t state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ;
                 uint8_t seqno = data[0] & 0x7F;
@@ -149,6 +243,11 @@ static void CO_SDO_receive(void *object, void *msg) {
             /* ignore subsequent server messages, if response was requested */
         }
 #endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD
+        else if (data[0] == 0x40 && fastUpload(SDO, data)) {
+            /* expedited upload was answered directly */
+        }
+#endif
         else {
             /* copy data and set 'new message' flag, data will be processed in
              * CO_SDOserver_process() */
@@ -160,6 +259,11 @@ static void CO_SDO_receive(void *object, void *msg) {
             if (SDO->pFunctSignalPre != NULL) {
                 SDO->pFunctSignalPre(SDO->functSignalObjectPre);
             }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+            if (SDO->readyList != NULL) {
+                CO_readyList_push(SDO->readyList, SDO->readyId);
+            }
 #endif
         }
     }
@@ -335,11 +439,30 @@ CO_ReturnError_t CO_SDOserver_init(CO_SDOserver_t *SDO,
     /* Configure object variables */
     SDO->OD = OD;
     SDO->nodeId = nodeId;
+#if OD_SUB_CACHE_SIZE > 0
+    OD_subCache_clear(&SDO->OD_subCache);
+#endif
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
     SDO->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000;
 #endif
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
     SDO->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    SDO->buf = SDO->bufSmall;
+    SDO->bufSize = CO_SDO_SRV_BUF_SMALL_SIZE;
+    SDO->bufPool = NULL;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD
+    SDO->fastEntries = NULL;
+    SDO->fastEntriesSize = 0;
+    SDO->fastEntriesCount = 0;
+    SDO->fastAllowed = false;
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+    SDO->block_blksizeLimit = 127;
+    SDO->block_elapsed_us = 0;
+    SDO->block_throughput = 0;
 #endif
     SDO->state = CO_SDO_ST_IDLE;
 
@@ -347,6 +470,10 @@ CO_ReturnError_t CO_SDOserver_init(CO_SDOserver_t *SDO,
     SDO->pFunctSignalPre = NULL;
     SDO->functSignalObjectPre = NULL;
 #endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+    SDO->readyList = NULL;
+    SDO->readyId = 0;
+#endif
 
     /* configure CAN identifiers and SDO server parameters if available */
     uint16_t CanId_ClientToServer, CanId_ServerToClient;
@@ -454,20 +581,161 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
-#ifdef CO_BIG_ENDIAN
-static inline void reverseBytes(void *start, OD_size_t size) {
-    uint8_t *lo = (uint8_t *)start;
-    uint8_t *hi = (uint8_t *)start + size - 1;
-    while (lo < hi) {
-        uint8_t swap = *lo;
-        *lo++ = *hi;
-        *hi-- = swap;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+/******************************************************************************/
+void CO_SDOserver_initReadyList(CO_SDOserver_t *SDO,
+                                CO_readyList_t *readyList,
+                                uint16_t readyId)
+{
+    if (SDO != NULL) {
+        SDO->readyId = readyId;
+        SDO->readyList = readyList;
     }
 }
 #endif
 
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD
+/******************************************************************************/
+void CO_SDOserver_initFastUpload(CO_SDOserver_t *SDO,
+                                 CO_SDOserver_fastEntry_t *entries,
+                                 uint16_t entriesSize)
+{
+    if (SDO != NULL) {
+        SDO->fastEntriesCount = 0;
+        SDO->fastEntries = entries;
+        SDO->fastEntriesSize = entries != NULL ? entriesSize : 0;
+    }
+}
+
+
+/******************************************************************************/
+ODR_t CO_SDOserver_fastUploadAdd(CO_SDOserver_t *SDO,
+                                 uint16_t index,
+                                 uint8_t subIndex)
+{
+    if (SDO == NULL || SDO->fastEntries == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    OD_IO_t io;
+    ODR_t odRet = OD_getSub(OD_find(SDO->OD, index), subIndex, &io, false);
+    if (odRet != ODR_OK) {
+        return odRet;
+    }
+
+    OD_size_t len = io.stream.dataLength;
+    if (io.read != OD_readOriginal || io.stream.dataOrig == NULL
+        || (io.stream.attribute & ODA_SDO_R) == 0
+        || (io.stream.attribute & ODA_STR) != 0
+        || len < 1 || len > 4
+    ) {
+        return ODR_UNSUPP_ACCESS;
+    }
+
+    /* find position, keep entries sorted */
+    uint32_t key = ((uint32_t)index << 8) | subIndex;
+    uint16_t pos = 0;
+    while (pos < SDO->fastEntriesCount && SDO->fastEntries[pos].key < key) {
+        pos++;
+    }
+
+    if (pos >= SDO->fastEntriesCount || SDO->fastEntries[pos].key != key) {
+        if (SDO->fastEntriesCount >= SDO->fastEntriesSize) {
+            return ODR_OUT_OF_MEM;
+        }
+        memmove(&SDO->fastEntries[pos + 1], &SDO->fastEntries[pos],
+                (SDO->fastEntriesCount - pos)
+                * sizeof(CO_SDOserver_fastEntry_t));
+        SDO->fastEntriesCount++;
+    }
+
+    CO_SDOserver_fastEntry_t *entry = &SDO->fastEntries[pos];
+    entry->key = key;
+    entry->dataOrig = io.stream.dataOrig;
+    entry->dataLength = (uint8_t)len;
+    entry->attribute = io.stream.attribute;
+
+    return ODR_OK;
+}
+#endif
+
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+/******************************************************************************/
+CO_ReturnError_t CO_SDOserver_bufPool_init(CO_SDOserver_bufPool_t *pool,
+                                           uint8_t *arena,
+                                           uint8_t count)
+{
+    if (pool == NULL || arena == NULL || count < 1 || count > 32) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    pool->arena = arena;
+    pool->count = count;
+    pool->used = 0;
+
+    return CO_ERROR_NO;
+}
+
+
+void CO_SDOserver_initBufPool(CO_SDOserver_t *SDO,
+                              CO_SDOserver_bufPool_t *pool)
+{
+    if (SDO != NULL) {
+        SDO->bufPool = pool;
+    }
+}
+
+
+/*
+ * Borrow large buffer from the pool, if not already borrowed. Data from the
+ * small buffer are copied into it.
+ *
+ * Returns true on success.
+ */
+static bool_t bufBorrow(CO_SDOserver_t *SDO) {
+    CO_SDOserver_bufPool_t *pool = SDO->bufPool;
+
+    if (SDO->buf != SDO->bufSmall) {
+        return true;
+    }
+    if (pool == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < pool->count; i++) {
+        uint32_t mask = (uint32_t)1 << i;
+        if ((pool->used & mask) == 0U) {
+            pool->used |= mask;
+            SDO->buf = &pool->arena[i * (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1)];
+            SDO->bufSize = CO_CONFIG_SDO_SRV_BUFFER_SIZE;
+            memcpy(SDO->buf, SDO->bufSmall, SDO->bufOffsetWr);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* Return borrowed buffer to the pool */
+static void bufReturn(CO_SDOserver_t *SDO) {
+    CO_SDOserver_bufPool_t *pool = SDO->bufPool;
+
+    if (SDO->buf != SDO->bufSmall && pool != NULL) {
+        uint32_t i = (uint32_t)(SDO->buf - pool->arena)
+                     / (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1);
+        pool->used &= ~((uint32_t)1 << i);
+    }
+    SDO->buf = SDO->bufSmall;
+    SDO->bufSize = CO_SDO_SRV_BUF_SMALL_SIZE;
+}
+#endif
+
+
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
+static bool_t writeToOD(CO_SDOserver_t *SDO, CO_SDO_abortCode_t *abortCode);
+
 /** Helper function for writing data to Object dictionary. Function swaps data
  * if necessary, calcualtes (and verifies CRC) writes data to OD and verifies
  * data lengths.
@@ -498,7 +766,7 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
 #ifdef CO_BIG_ENDIAN
         /* swap int16_t .. uint64_t data if necessary */
         if ((SDO->OD_IO.stream.attribute & ODA_MB) != 0) {
-            reverseBytes(SDO->buf, SDO->bufOffsetWr);
+            CO_swapBytes(SDO->buf, SDO->bufOffsetWr);
         }
 #endif
 
@@ -510,7 +778,7 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
          * (temporary, send information about EOF into OD_IO.write) */
         if ((SDO->OD_IO.stream.attribute & ODA_STR) != 0
             && (sizeInOd == 0 || SDO->sizeTran < sizeInOd)
-            && (SDO->bufOffsetWr + 2) <= CO_CONFIG_SDO_SRV_BUFFER_SIZE
+            && (SDO->bufOffsetWr + 2) <= CO_SDO_SRV_BUF_SIZE(SDO)
         ) {
             SDO->buf[SDO->bufOffsetWr++] = 0;
             SDO->sizeTran++;
@@ -545,7 +813,16 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
     /* calculate crc on current data */
     if (SDO->block_crcEnabled && crcOperation > 0) {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+        /* data at the start of the buffer, which was not accepted by the
+         * previous write, is already included (bufOffsetRd is not used by
+         * download otherwise) */
+        SDO->block_crc = crc16_ccitt(SDO->buf + SDO->bufOffsetRd,
+                                     bufOffsetWrOrig - SDO->bufOffsetRd,
+                                     SDO->block_crc);
+#else
         SDO->block_crc = crc16_ccitt(SDO->buf, bufOffsetWrOrig, SDO->block_crc);
+#endif
         if (crcOperation == 2 && crcClient != SDO->block_crc) {
             *abortCode = CO_SDO_AB_CRC;
             SDO->state = CO_SDO_ST_ABORT;
@@ -556,7 +833,21 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
     /* may be unused */
     (void) crcOperation; (void) crcClient; (void) bufOffsetWrOrig;
 
-    /* write data */
+    return writeToOD(SDO, abortCode);
+}
+
+
+/** Helper function for writing data from the buffer into Object dictionary,
+ * called from validateAndWriteToOD().
+ *
+ * With CO_CONFIG_SDO_SRV_BLOCK_FLOW in segmented or block download write
+ * function may accept only part of the data, the rest stays in the buffer. If
+ * it returns ODR_PARTIAL after the last data, SDO->block_writePending is set
+ * and function must be called again.
+ *
+ * Returns true on success, otherwise write also abortCode and sets state to
+ * CO_SDO_ST_ABORT */
+static bool_t writeToOD(CO_SDOserver_t *SDO, CO_SDO_abortCode_t *abortCode) {
     OD_size_t countWritten = 0;
 
     CO_LOCK_OD(SDO->CANdevTx);
@@ -564,7 +855,36 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
                                    SDO->bufOffsetWr, &countWritten);
     CO_UNLOCK_OD(SDO->CANdevTx);
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+    if (SDO->state == CO_SDO_ST_DOWNLOAD_SEGMENT_REQ
+        || SDO->state == CO_SDO_ST_DOWNLOAD_SEGMENT_RSP
+        || SDO->state == CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP
+        || SDO->state == CO_SDO_ST_DOWNLOAD_BLK_END_REQ
+        || SDO->state == CO_SDO_ST_DOWNLOAD_BLK_END_RSP
+    ) {
+        /* keep data, which was not accepted, at the start of the buffer */
+        if (odRet == ODR_PARTIAL && countWritten < SDO->bufOffsetWr) {
+            OD_size_t remain = SDO->bufOffsetWr - countWritten;
+            memmove(SDO->buf, SDO->buf + countWritten, remain);
+            SDO->bufOffsetWr = remain;
+        }
+        else {
+            SDO->bufOffsetWr = 0;
+        }
+        SDO->bufOffsetRd = SDO->bufOffsetWr;
+
+        /* OD variable is still busy with the last data, repeat later */
+        SDO->block_writePending = SDO->finished && odRet == ODR_PARTIAL;
+        if (SDO->block_writePending) {
+            return true;
+        }
+    }
+    else {
+        SDO->bufOffsetWr = 0;
+    }
+#else
     SDO->bufOffsetWr = 0;
+#endif
 
     /* verify write error value */
     if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
@@ -615,7 +935,7 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
         SDO->bufOffsetWr = countRemain;
 
         /* Get size of free data buffer */
-        OD_size_t countRdRequest = CO_CONFIG_SDO_SRV_BUFFER_SIZE - countRemain;
+        OD_size_t countRdRequest = CO_SDO_SRV_BUF_SIZE(SDO) - countRemain;
 
         /* load data from OD variable into the buffer */
         OD_size_t countRd = 0;
@@ -627,19 +947,11 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
         CO_UNLOCK_OD(SDO->CANdevTx);
 
 #if (C2000_PORT != 0)
-        if((SDO->OD_IO.stream.attribute & ODA_STR) == 0) {
-            uint8_t tempBuff[CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1] = {0};
-            for (int i = 0; i < countRd; i++) {
-                if((i % 2) == 0) {
-                    tempBuff[i] = (((uint16_t *)bufShifted)[i/2]) & 0x00FF;
-                } else {
-                    tempBuff[i] = ((((uint16_t *)bufShifted)[i/2]) >> 8) & 0x00FF;
-                }
-            }
-
-            for (int i = 0; i < countRd; i++) {
-                bufShifted[i] = tempBuff[i];
-            }
+        /* complete access image is already converted to bytes */
+        if((SDO->OD_IO.stream.attribute & ODA_STR) == 0
+            && SDO->OD_IO.read != OD_readComplete
+        ) {
+            CO_wordsToBytes(bufShifted, countRd);
         }
 #endif
 
@@ -658,7 +970,8 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
                 /* string terminator found, read is finished, shorten data */
                 countRd = countStr;
                 odRet = ODR_OK;
-                SDO->OD_IO.stream.dataLength = SDO->sizeTran + countRd;
+                SDO->OD_IO.stream.dataLength = SDO->sizeTran + countRemain
+                                               + countRd;
             }
         }
 
@@ -681,7 +994,7 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
         if ((SDO->OD_IO.stream.attribute & ODA_MB) != 0) {
             if (SDO->finished) {
                 /* int16_t .. uint64_t */
-                reverseBytes(bufShifted, countRd);
+                CO_swapBytes(bufShifted, countRd);
             }
             else {
                 *abortCode = CO_SDO_AB_PRAM_INCOMPAT;
@@ -701,6 +1014,34 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
     }
     return true;
 }
+
+
+/*
+ * Initial read from OD variable on start of the upload.
+ *
+ * If data does not fit into small buffer, large buffer is borrowed from the
+ * pool and filled.
+ *
+ * Returns true on success, otherwise write also abortCode and sets state to
+ * CO_SDO_ST_ABORT */
+static bool_t readFromOdInitial(CO_SDOserver_t *SDO,
+                                CO_SDO_abortCode_t *abortCode)
+{
+    if (!readFromOd(SDO, abortCode, 7, false)) {
+        return false;
+    }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    if (!SDO->finished) {
+        if (!bufBorrow(SDO)) {
+            *abortCode = CO_SDO_AB_OUT_OF_MEM;
+            SDO->state = CO_SDO_ST_ABORT;
+            return false;
+        }
+        return readFromOd(SDO, abortCode, SDO->bufSize, false);
+    }
+#endif
+    return true;
+}
 #endif
 
 
@@ -720,6 +1061,17 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
     CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
     bool_t isNew = CO_FLAG_READ(SDO->CANrxNew);
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD
+    SDO->fastAllowed = NMTisPreOrOperational;
+#endif
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+    if ((SDO->state & CO_SDO_ST_FLAG_BLOCK) != 0U
+        && SDO->block_elapsed_us < (UINT32_MAX - timeDifference_us)
+    ) {
+        SDO->block_elapsed_us += timeDifference_us;
+    }
+#endif
 
     if (SDO->valid && SDO->state == CO_SDO_ST_IDLE && !isNew) {
         /* Idle and nothing new */
@@ -736,19 +1088,25 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
     else if (isNew) {
         if (SDO->state == CO_SDO_ST_IDLE) { /* new SDO communication? */
             bool_t upload = false;
+            uint8_t cmd = SDO->CANrxData[0];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_COMPLETE
+            /* bit 4 of initiate request indicates complete access */
+            bool_t complete = (cmd & 0x10) != 0;
+            cmd &= 0xEF;
+#endif
 
-            if ((SDO->CANrxData[0] & 0xF0) == 0x20) {
+            if ((cmd & 0xF0) == 0x20) {
                 SDO->state = CO_SDO_ST_DOWNLOAD_INITIATE_REQ;
             }
-            else if (SDO->CANrxData[0] == 0x40) {
+            else if (cmd == 0x40) {
                 upload = true;
                 SDO->state = CO_SDO_ST_UPLOAD_INITIATE_REQ;
             }
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
-            else if ((SDO->CANrxData[0] & 0xF9) == 0xC0) {
+            else if ((cmd & 0xF9) == 0xC0) {
                 SDO->state = CO_SDO_ST_DOWNLOAD_BLK_INITIATE_REQ;
             }
-            else if ((SDO->CANrxData[0] & 0xFB) == 0xA0) {
+            else if ((cmd & 0xFB) == 0xA0) {
                 upload = true;
                 SDO->state = CO_SDO_ST_UPLOAD_BLK_INITIATE_REQ;
             }
@@ -758,14 +1116,35 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 SDO->state = CO_SDO_ST_ABORT;
             }
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+            SDO->block_elapsed_us = 0;
+            SDO->block_throughput = 0;
+#endif
+
             /* if no error search object dictionary for new SDO request */
             if (abortCode == CO_SDO_AB_NONE) {
                 ODR_t odRet;
                 SDO->index = ((uint16_t)SDO->CANrxData[2]) << 8
                              | SDO->CANrxData[1];
                 SDO->subIndex = SDO->CANrxData[3];
-                odRet = OD_getSub(OD_find(SDO->OD, SDO->index), SDO->subIndex,
-                                  &SDO->OD_IO, false);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_COMPLETE
+                if (complete) {
+                    odRet = OD_getComplete(OD_find(SDO->OD, SDO->index),
+                                           SDO->subIndex, &SDO->OD_IO,
+                                           &SDO->OD_complete, false, !upload);
+                }
+                else
+#endif
+                {
+#if OD_SUB_CACHE_SIZE > 0
+                    odRet = OD_getSubCached(&SDO->OD_subCache, SDO->OD,
+                                            SDO->index, SDO->subIndex,
+                                            &SDO->OD_IO, false);
+#else
+                    odRet = OD_getSub(OD_find(SDO->OD, SDO->index),
+                                      SDO->subIndex, &SDO->OD_IO, false);
+#endif
+                }
                 if (odRet != ODR_OK) {
                     abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
                     SDO->state = CO_SDO_ST_ABORT;
@@ -799,7 +1178,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 SDO->sizeTran = 0;
                 SDO->finished = false;
 
-                if (readFromOd(SDO, &abortCode, 7, false)) {
+                if (readFromOdInitial(SDO, &abortCode)) {
                     /* Size of variable in OD (may not be known yet) */
                     if (SDO->finished) {
                         /* OD variable was completely read, its size is known */
@@ -850,7 +1229,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 memcpy(buf, &SDO->CANrxData[4], dataSizeToWrite);
 #ifdef CO_BIG_ENDIAN
                 if ((SDO->OD_IO.stream.attribute & ODA_MB) != 0) {
-                    reverseBytes(buf, dataSizeToWrite);
+                    CO_swapBytes(buf, dataSizeToWrite);
                 }
 #endif
 
@@ -882,24 +1261,14 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 
                 CO_LOCK_OD(SDO->CANdevTx);
 #if (C2000_PORT != 0)
-                uint8_t bufTemp[6];
-                void * pbufTemp = (void *)bufTemp;
-                memcpy(bufTemp, buf, sizeof(buf));
-                if(SDO->OD_IO.write == OD_writeOriginal) {
-                    if(dataSizeToWrite == 1) {
-                        *((uint8_t *)pbufTemp) = CO_getUint8(buf);
-                    } else if(dataSizeToWrite == 2) {
-                        *((uint16_t *)pbufTemp) = CO_getUint16(buf);
-                    } else if(dataSizeToWrite == 4) {
-                        *((uint32_t *)pbufTemp) = CO_getUint32(buf);
-                    }
+                if (SDO->OD_IO.write == OD_writeOriginal
+                    && (SDO->OD_IO.stream.attribute & ODA_STR) == 0
+                ) {
+                    CO_bytesToWords(buf, dataSizeToWrite);
                 }
-                ODR_t odRet = SDO->OD_IO.write(&SDO->OD_IO.stream, bufTemp,
-                                               dataSizeToWrite, &countWritten);
-#else
+#endif
                 ODR_t odRet = SDO->OD_IO.write(&SDO->OD_IO.stream, buf,
                                                dataSizeToWrite, &countWritten);
-#endif
                 CO_UNLOCK_OD(SDO->CANdevTx);
 
                 if (odRet != ODR_OK) {
@@ -921,15 +1290,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     uint32_t size;
                     OD_size_t sizeInOd = SDO->OD_IO.stream.dataLength;
 
-#if (C2000_PORT != 0)
-                    size = 0;
-                    size = SDO->CANrxData[4] & 0x00FF;
-                    size += ((uint32_t)(SDO->CANrxData[5] & 0x00FF)) << 8;
-                    size += ((uint32_t)(SDO->CANrxData[6] & 0x00FF)) << 16;
-                    size += ((uint32_t)(SDO->CANrxData[7] & 0x00FF)) << 24;
-#else
-                    memcpy(&size, &SDO->CANrxData[4], sizeof(size));
-#endif
+                    size = CO_getUint32(&SDO->CANrxData[4]);
                     SDO->sizeInd = CO_SWAP_32(size);
 
                     /* Indicated size of SDO matches sizeof OD variable? */
@@ -953,6 +1314,13 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 else {
                     SDO->sizeInd = 0;
                 }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+                if (!bufBorrow(SDO)) {
+                    abortCode = CO_SDO_AB_OUT_OF_MEM;
+                    SDO->state = CO_SDO_ST_ABORT;
+                    break;
+                }
+#endif
                 SDO->state = CO_SDO_ST_DOWNLOAD_INITIATE_RSP;
                 SDO->finished = false;
 #else
@@ -993,7 +1361,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 
                 /* if necessary, empty the buffer */
                 if (SDO->finished
-                    || (CO_CONFIG_SDO_SRV_BUFFER_SIZE - SDO->bufOffsetWr)<(7+2)
+                    || (CO_SDO_SRV_BUF_SIZE(SDO) - SDO->bufOffsetWr) < (7+2)
                 ) {
                     if (!validateAndWriteToOD(SDO, &abortCode, 0, 0)) {
                         break;
@@ -1037,6 +1405,13 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
         case CO_SDO_ST_DOWNLOAD_BLK_INITIATE_REQ: {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            if (!bufBorrow(SDO)) {
+                abortCode = CO_SDO_AB_OUT_OF_MEM;
+                SDO->state = CO_SDO_ST_ABORT;
+                break;
+            }
+#endif
             SDO->block_crcEnabled = (SDO->CANrxData[0] & 0x04) != 0;
 
             /* is size indicated? */
@@ -1044,15 +1419,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 uint32_t size;
                 OD_size_t sizeInOd = SDO->OD_IO.stream.dataLength;
 
-#if (C2000_PORT != 0)
-                size = 0;
-                size = SDO->CANrxData[4] & 0x00FF;
-                size += ((uint32_t)(SDO->CANrxData[5] & 0x00FF)) << 8;
-                size += ((uint32_t)(SDO->CANrxData[6] & 0x00FF)) << 16;
-                size += ((uint32_t)(SDO->CANrxData[7] & 0x00FF)) << 24;
-#else
-                memcpy(&size, &SDO->CANrxData[4], sizeof(size));
-#endif
+                size = CO_getUint32(&SDO->CANrxData[4]);
                 SDO->sizeInd = CO_SWAP_32(size);
 
                 /* Indicated size of SDO matches sizeof OD variable? */
@@ -1126,6 +1493,12 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 SDO->state = CO_SDO_ST_UPLOAD_INITIATE_RSP;
             }
             else {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM
+                /* crc is calculated on transmitted segments */
+                SDO->block_crcEnabled = (SDO->CANrxData[0] & 0x04) != 0;
+                SDO->block_crc = 0;
+                SDO->block_crcOffset = 0;
+#else
                 /* data were already loaded from OD variable, verify crc */
                 if ((SDO->CANrxData[0] & 0x04) != 0) {
                     SDO->block_crcEnabled = true;
@@ -1134,6 +1507,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 else {
                     SDO->block_crcEnabled = false;
                 }
+#endif
 
                 /* get blksize and verify it */
                 SDO->block_blksize = SDO->CANrxData[4];
@@ -1143,12 +1517,14 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     break;
                 }
 
+#if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM)
                 /* verify, if there is enough data */
                 if (!SDO->finished && SDO->bufOffsetWr < SDO->block_blksize*7U){
                     abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
                     SDO->state = CO_SDO_ST_ABORT;
                     break;
                 }
+#endif
                 SDO->state = CO_SDO_ST_UPLOAD_BLK_INITIATE_RSP;
             }
             break;
@@ -1182,8 +1558,20 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                      * Re-transmit data after erroneous segment. */
                     OD_size_t cntFailed = SDO->block_seqno - SDO->CANrxData[1];
                     cntFailed = cntFailed * 7 - SDO->block_noData;
-                    SDO->bufOffsetRd -= cntFailed;
                     SDO->sizeTran -= cntFailed;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM
+                    if (cntFailed > SDO->bufOffsetRd) {
+                        /* data are not in the buffer any more, read them
+                         * again from the OD variable */
+                        SDO->OD_IO.stream.dataOffset = SDO->sizeTran;
+                        SDO->bufOffsetRd = SDO->bufOffsetWr = 0;
+                        SDO->finished = false;
+                    }
+                    else
+#endif
+                    {
+                        SDO->bufOffsetRd -= cntFailed;
+                    }
                 }
                 else if (SDO->CANrxData[1] > SDO->block_seqno) {
                     /* something strange from server, break transmission */
@@ -1191,10 +1579,20 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     SDO->state = CO_SDO_ST_ABORT;
                     break;
                 }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+                SDO->block_throughput = CO_SDO_blockThroughput(
+                                            SDO->sizeTran,
+                                            SDO->block_elapsed_us);
+#endif
 
                 /* refill data buffer if necessary */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM
+                if (!readFromOd(SDO, &abortCode, 7, false))
+                    break;
+#else
                 if (!readFromOd(SDO, &abortCode, SDO->block_blksize * 7, true))
                     break;
+#endif
 
 
                 if (SDO->bufOffsetWr == SDO->bufOffsetRd) {
@@ -1307,6 +1705,9 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 SDO->sizeTran = 0;
                 SDO->bufOffsetWr = 0;
                 SDO->bufOffsetRd = 0;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+                SDO->block_writePending = false;
+#endif
                 SDO->state = CO_SDO_ST_DOWNLOAD_SEGMENT_REQ;
             }
 #else
@@ -1318,6 +1719,29 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
         case CO_SDO_ST_DOWNLOAD_SEGMENT_RSP: {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+            /* OD variable is busy, write again, until it finishes the last
+             * data or there is space in the buffer for the next segment */
+            if (SDO->block_writePending
+                || (CO_SDO_SRV_BUF_SIZE(SDO) - SDO->bufOffsetWr) < (7+2)
+            ) {
+                if (!writeToOD(SDO, &abortCode)) {
+                    break;
+                }
+                if (SDO->block_writePending
+                    || (CO_SDO_SRV_BUF_SIZE(SDO) - SDO->bufOffsetWr) < (7+2)
+                ) {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_TIMERNEXT
+                    if (timerNext_us != NULL
+                        && *timerNext_us > CO_CONFIG_SDO_SRV_FLOW_RETRY_US
+                    ) {
+                        *timerNext_us = CO_CONFIG_SDO_SRV_FLOW_RETRY_US;
+                    }
+#endif
+                    break;
+                }
+            }
+#endif
             SDO->CANtxBuff->data[0] = 0x20 | SDO->toggle;
             SDO->toggle = (SDO->toggle == 0x00) ? 0x10 : 0x00;
 
@@ -1341,7 +1765,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             if (SDO->sizeInd > 0 && SDO->sizeInd <= 4) {
                 /* expedited transfer */
                 SDO->CANtxBuff->data[0] = (uint8_t)(0x43|((4-SDO->sizeInd)<<2));
-                memcpy(&SDO->CANtxBuff->data[4], &SDO->buf, SDO->sizeInd);
+                memcpy(&SDO->CANtxBuff->data[4], SDO->buf, SDO->sizeInd);
                 SDO->state = CO_SDO_ST_IDLE;
                 ret = CO_SDO_RT_ok_communicationEnd;
             }
@@ -1352,14 +1776,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     uint32_t sizeInd = SDO->sizeInd;
                     uint32_t sizeIndSw = CO_SWAP_32(sizeInd);
                     SDO->CANtxBuff->data[0] = 0x41;
-#if (C2000_PORT != 0)
-                    for (int i = 0; i < 4; i++) {
-                        SDO->CANtxBuff->data[i + 4] = (uint8_t)((sizeIndSw >> (8 * i)) & 0x00FF);
-                    }
-#else
-                    memcpy(&SDO->CANtxBuff->data[4],
-                           &sizeIndSw, sizeof(sizeIndSw));
-#endif
+                    (void)CO_setUint32(&SDO->CANtxBuff->data[4], sizeIndSw);
                 }
                 else {
                     SDO->CANtxBuff->data[0] = 0x40;
@@ -1391,10 +1808,15 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 break;
             }
 
+#if (C2000_PORT != 0)
+            if ((SDO->OD_IO.stream.attribute & ODA_STR) == 0) {
+                CO_wordsToBytes(&SDO->CANtxBuff->data[4], count);
+            }
+#endif
 #ifdef CO_BIG_ENDIAN
             /* swap data if necessary */
             if ((SDO->OD_IO.stream.attribute & ODA_MB) != 0) {
-                reverseBytes(buf, dataSizeToWrite);
+                CO_swapBytes(&SDO->CANtxBuff->data[4], count);
             }
 #endif
             SDO->CANtxBuff->data[0] = 0x43 | ((4 - count) << 2);
@@ -1477,10 +1899,15 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             SDO->CANtxBuff->data[3] = SDO->subIndex;
 
             /* calculate number of block segments from free buffer space */
-            OD_size_t count = (CO_CONFIG_SDO_SRV_BUFFER_SIZE-2) / 7;
+            OD_size_t count = (CO_SDO_SRV_BUF_SIZE(SDO) - 2) / 7;
             if (count > 127) {
                 count = 127;
             }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+            if (count > SDO->block_blksizeLimit) {
+                count = SDO->block_blksizeLimit;
+            }
+#endif
             SDO->block_blksize = (uint8_t)count;
             SDO->CANtxBuff->data[4] = SDO->block_blksize;
 
@@ -1493,6 +1920,10 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             SDO->block_crc = 0;
             SDO->timeoutTimer = 0;
             SDO->block_timeoutTimer = 0;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+            SDO->block_flowWait = false;
+            SDO->block_writePending = false;
+#endif
 
             /* Block segments will be received in different thread. Make memory
              * barrier here with CO_FLAG_CLEAR() call. */
@@ -1509,15 +1940,29 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             bool_t transferShort = SDO->block_seqno != SDO->block_blksize;
             uint8_t seqnoStart = SDO->block_seqno;
 #endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+            SDO->block_throughput = CO_SDO_blockThroughput(
+                                        SDO->sizeTran, SDO->block_elapsed_us);
+#endif
 
             /* Is last segment? */
             if (SDO->finished) {
                 SDO->state = CO_SDO_ST_DOWNLOAD_BLK_END_REQ;
             }
             else {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+                /* lost segments decrease, complete sub-blocks increase limit */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+                if (!SDO->block_flowWait)
+#endif
+                SDO->block_blksizeLimit = CO_SDO_blksizeAdapt(
+                                                SDO->block_blksizeLimit,
+                                                SDO->block_blksize,
+                                                SDO->block_seqno);
+#endif
                 /* calculate number of block segments from free buffer space */
                 OD_size_t count;
-                count = (CO_CONFIG_SDO_SRV_BUFFER_SIZE-2-SDO->bufOffsetWr)/7;
+                count = (CO_SDO_SRV_BUF_SIZE(SDO) - 2 - SDO->bufOffsetWr) / 7;
                 if (count >= 127) {
                     count = 127;
                 }
@@ -1526,11 +1971,30 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     if (!validateAndWriteToOD(SDO, &abortCode, 1, 0))
                         break;
 
-                    count =(CO_CONFIG_SDO_SRV_BUFFER_SIZE-2-SDO->bufOffsetWr)/7;
+                    count = (CO_SDO_SRV_BUF_SIZE(SDO) - 2 - SDO->bufOffsetWr) / 7;
                     if (count >= 127) {
                         count = 127;
                     }
                 }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+                /* OD variable is busy and buffer is full, respond later */
+                SDO->block_flowWait = count == 0;
+                if (SDO->block_flowWait) {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_TIMERNEXT
+                    if (timerNext_us != NULL
+                        && *timerNext_us > CO_CONFIG_SDO_SRV_FLOW_RETRY_US
+                    ) {
+                        *timerNext_us = CO_CONFIG_SDO_SRV_FLOW_RETRY_US;
+                    }
+#endif
+                    break;
+                }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE
+                if (count > SDO->block_blksizeLimit) {
+                    count = SDO->block_blksizeLimit;
+                }
+#endif
 
                 SDO->block_blksize = (uint8_t)count;
                 SDO->block_seqno = 0;
@@ -1558,6 +2022,24 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         }
 
         case CO_SDO_ST_DOWNLOAD_BLK_END_RSP: {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW
+            /* write the last data again, until OD variable finishes */
+            if (SDO->block_writePending) {
+                if (!writeToOD(SDO, &abortCode)) {
+                    break;
+                }
+                if (SDO->block_writePending) {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_TIMERNEXT
+                    if (timerNext_us != NULL
+                        && *timerNext_us > CO_CONFIG_SDO_SRV_FLOW_RETRY_US
+                    ) {
+                        *timerNext_us = CO_CONFIG_SDO_SRV_FLOW_RETRY_US;
+                    }
+#endif
+                    break;
+                }
+            }
+#endif
             SDO->CANtxBuff->data[0] = 0xA1;
 
             CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
@@ -1576,13 +2058,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             if (SDO->sizeInd > 0) {
                 uint32_t size = CO_SWAP_32(SDO->sizeInd);
                 SDO->CANtxBuff->data[0] |= 0x02;
-#if (C2000_PORT != 0)
-                for(int i = 0; i < 4; i++) {
-                    SDO->CANtxBuff->data[i + 4] = (uint8_t)((size >> (8 * i)) & 0x00FF);
-                }
-#else
-                memcpy(&SDO->CANtxBuff->data[4], &size, sizeof(size));
-#endif
+                (void)CO_setUint32(&SDO->CANtxBuff->data[4], size);
             }
 
             /* reset timeout timer and send message */
@@ -1594,6 +2070,11 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 
         case CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_SREQ: {
             /* write header and get current count */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM
+            /* refill data buffer just in time */
+            if (!readFromOd(SDO, &abortCode, 7, false))
+                break;
+#endif
             SDO->CANtxBuff->data[0] = ++SDO->block_seqno;
             OD_size_t count = SDO->bufOffsetWr - SDO->bufOffsetRd;
             /* verify, if this is the last segment */
@@ -1607,6 +2088,17 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             /* copy data segment to CAN message */
             memcpy(&SDO->CANtxBuff->data[1], SDO->buf + SDO->bufOffsetRd,
                    count);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM
+            /* calculate crc on data, which were not transmitted before */
+            if (SDO->block_crcEnabled
+                && (SDO->sizeTran + count) > SDO->block_crcOffset
+            ) {
+                OD_size_t crcSkip = SDO->block_crcOffset - SDO->sizeTran;
+                SDO->block_crc = crc16_ccitt(&SDO->CANtxBuff->data[1 + crcSkip],
+                                             count - crcSkip, SDO->block_crc);
+                SDO->block_crcOffset = SDO->sizeTran + count;
+            }
+#endif
             SDO->bufOffsetRd += count;
             SDO->block_noData = (uint8_t)(7 - count);
             SDO->sizeTran += count;
@@ -1675,13 +2167,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             SDO->CANtxBuff->data[2] = (uint8_t)(SDO->index >> 8);
             SDO->CANtxBuff->data[3] = SDO->subIndex;
 
-#if (C2000_PORT != 0)
-            for(int i = 0; i < 4; i++) {
-                SDO->CANtxBuff->data[i + 4] = (uint8_t)((code >> (i * 8)) & 0x00FF);
-            }
-#else
-            memcpy(&SDO->CANtxBuff->data[4], &code, sizeof(code));
-#endif
+            (void)CO_setUint32(&SDO->CANtxBuff->data[4], code);
             CO_CANsend(SDO->CANdevTx, SDO->CANtxBuff);
             SDO->state = CO_SDO_ST_IDLE;
             ret = CO_SDO_RT_endedWithServerAbort;
@@ -1696,5 +2182,11 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 #endif
     }
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    if (SDO->state == CO_SDO_ST_IDLE) {
+        bufReturn(SDO);
+    }
+#endif
+
     return ret;
 }
@@ -39,6 +39,12 @@
 #ifndef CO_CONFIG_SDO_SRV_BUFFER_SIZE
 #define CO_CONFIG_SDO_SRV_BUFFER_SIZE 32
 #endif
+#ifndef CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT
+#define CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT 2
+#endif
+#ifndef CO_CONFIG_SDO_SRV_FLOW_RETRY_US
+#define CO_CONFIG_SDO_SRV_FLOW_RETRY_US 1000
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -436,6 +442,51 @@ typedef enum {
 } CO_SDO_return_t;
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+/** Size of the buffer inside each SDO server, if buffer pool is used. It holds
+ * data of expedited transfer or single segment. */
+#define CO_SDO_SRV_BUF_SMALL_SIZE 7
+
+/**
+ * Pool of data buffers shared by SDO servers.
+ *
+ * SDO server borrows buffer of size CO_CONFIG_SDO_SRV_BUFFER_SIZE at start of
+ * segmented or block transfer and returns it at the end of the transfer. If no
+ * buffer is free, transfer is aborted with CO_SDO_AB_OUT_OF_MEM. All SDO
+ * servers, which share the pool, must be processed from the same thread.
+ */
+typedef struct {
+    /** Memory for buffers, count * (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1) bytes */
+    uint8_t *arena;
+    /** Number of buffers inside arena, 1 to 32 */
+    uint8_t count;
+    /** Bit mask of buffers currently borrowed by SDO servers */
+    uint32_t used;
+} CO_SDOserver_bufPool_t;
+#endif
+
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD) || defined CO_DOXYGEN
+/**
+ * OD variable, which is uploaded directly from the CAN receive function.
+ *
+ * Array of these entries is provided by application with
+ * CO_SDOserver_initFastUpload() and filled by CO_SDOserver_fastUploadAdd().
+ * Entries are sorted by #key.
+ */
+typedef struct {
+    /** Index of OD object shifted left by 8 bits, ORed with sub-index */
+    uint32_t key;
+    /** Pointer to the original OD variable */
+    void *dataOrig;
+    /** Length of the variable in bytes, 1 to 4 */
+    uint8_t dataLength;
+    /** Attribute of the variable, see OD_attributes_t */
+    uint8_t attribute;
+} CO_SDOserver_fastEntry_t;
+#endif
+
+
 /**
  * SDO server object.
  */
@@ -454,6 +505,14 @@ typedef struct {
     volatile CO_SDO_state_t state;
     /** Object dictionary interface for current object. */
     OD_IO_t OD_IO;
+#if OD_SUB_CACHE_SIZE > 0 || defined CO_DOXYGEN
+    /** Cache of recently accessed OD sub-objects, see OD_getSubCached() */
+    OD_subCache_t OD_subCache;
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_COMPLETE) || defined CO_DOXYGEN
+    /** State of complete access, used by OD_IO, if client requested it */
+    OD_complete_t OD_complete;
+#endif
     /** Index of the current object in Object Dictionary */
     uint16_t index;
     /** Subindex of the current object in Object Dictionary */
@@ -495,8 +554,20 @@ typedef struct {
     uint32_t SDOtimeoutTime_us;
     /** Timeout timer for SDO communication */
     uint32_t timeoutTimer;
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+    /** Interim data buffer, points to #bufSmall or to buffer borrowed from
+     * #bufPool */
+    uint8_t *buf;
+    /** Size of #buf, without byte for '\0' */
+    OD_size_t bufSize;
+    /** Own small buffer + byte for '\0' */
+    uint8_t bufSmall[CO_SDO_SRV_BUF_SMALL_SIZE + 1];
+    /** From CO_SDOserver_initBufPool() or NULL */
+    CO_SDOserver_bufPool_t *bufPool;
+#else
     /** Interim data buffer for segmented or block transfer + byte for '\0' */
     uint8_t buf[CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1];
+#endif
     /** Offset of next free data byte available for write in the buffer. */
     OD_size_t bufOffsetWr;
     /** Offset of first data available for read in the buffer */
@@ -518,12 +589,52 @@ typedef struct {
     /** Calculated CRC checksum */
     uint16_t block_crc;
 #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_STREAM) || defined CO_DOXYGEN
+    /** Number of uploaded bytes already included in #block_crc. Re-transmitted
+     * segments are not included again. */
+    OD_size_t block_crcOffset;
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW) || defined CO_DOXYGEN
+    /** Sub-block response is delayed, because buffer is full */
+    bool_t block_flowWait;
+    /** Last data was passed to OD write function, but it returned
+     * ODR_PARTIAL, so write is repeated before the last segment response or
+     * block download end response */
+    bool_t block_writePending;
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE) || defined CO_DOXYGEN
+    /** Upper limit for blksize in block download, adapted after each sub-block
+     * with CO_SDO_blksizeAdapt(). It is kept between transfers. */
+    uint8_t block_blksizeLimit;
+    /** Time elapsed since start of the current block transfer */
+    uint32_t block_elapsed_us;
+    /** Throughput of the current or the last block transfer in bytes/second,
+     * updated after each sub-block. May be read by application. */
+    uint32_t block_throughput;
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD) || defined CO_DOXYGEN
+    /** From CO_SDOserver_initFastUpload() or NULL */
+    CO_SDOserver_fastEntry_t *fastEntries;
+    /** From CO_SDOserver_initFastUpload() */
+    uint16_t fastEntriesSize;
+    /** Number of used entries in #fastEntries */
+    volatile uint16_t fastEntriesCount;
+    /** True, if NMT state was pre-operational or operational in the last
+     * CO_SDOserver_process() call */
+    volatile bool_t fastAllowed;
+#endif
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_SDOserver_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
     /** From CO_SDOserver_initCallbackPre() or NULL */
     void *functSignalObjectPre;
 #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST) || defined CO_DOXYGEN
+    /** From CO_SDOserver_initReadyList() or NULL */
+    CO_readyList_t *readyList;
+    /** From CO_SDOserver_initReadyList() */
+    uint16_t readyId;
+#endif
 } CO_SDOserver_t;
 
 
@@ -581,6 +692,108 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST) || defined CO_DOXYGEN
+/**
+ * Initialize SDO server ready list.
+ *
+ * Each received SDO request, which must be processed by
+ * CO_SDOserver_process(), puts the SDO server into the list, so CO_process()
+ * does not call CO_SDOserver_process() for idle SDO servers. Function is
+ * called by CO_CANopenInit(), after CO_SDOserver_init().
+ *
+ * @param SDO This object.
+ * @param readyList List of ready objects, shared by all SDO servers from the
+ * same CAN module, or NULL to disable.
+ * @param readyId Id of this SDO server inside readyList.
+ */
+void CO_SDOserver_initReadyList(CO_SDOserver_t *SDO,
+                                CO_readyList_t *readyList,
+                                uint16_t readyId);
+#endif
+
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+/**
+ * Initialize pool of data buffers for SDO servers.
+ *
+ * Function must be called in the communication reset section, before
+ * CO_SDOserver_initBufPool().
+ *
+ * @param pool This object will be initialized.
+ * @param arena Memory for count * (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1) bytes.
+ * @param count Number of buffers, 1 to 32.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOserver_bufPool_init(CO_SDOserver_bufPool_t *pool,
+                                           uint8_t *arena,
+                                           uint8_t count);
+
+
+/**
+ * Configure SDO server to borrow data buffers from the pool.
+ *
+ * Function must be called after CO_SDOserver_init(). Without pool SDO server
+ * supports only expedited transfer and segmented transfer of data with up to
+ * CO_SDO_SRV_BUF_SMALL_SIZE bytes.
+ *
+ * @param SDO This object.
+ * @param pool Initialized pool, may be shared by multiple SDO servers.
+ */
+void CO_SDOserver_initBufPool(CO_SDOserver_t *SDO,
+                              CO_SDOserver_bufPool_t *pool);
+#endif
+
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_FAST_UPLOAD) || defined CO_DOXYGEN
+/**
+ * Initialize table for fast expedited upload.
+ *
+ * Expedited upload request for the OD variable from the table is answered
+ * directly from the CAN receive function of the SDO server, so latency does
+ * not depend on the period of CO_SDOserver_process(). Other requests are
+ * processed as usual. Fast upload is used only, if SDO server is idle, its
+ * CAN transmit buffer is free and NMT state, passed to the last
+ * CO_SDOserver_process() call, was pre-operational or operational.
+ *
+ * Variable is read inside CO_LOCK_OD() from the CAN receive context.
+ * Application must also write it atomically or inside CO_LOCK_OD().
+ *
+ * Function must be called after CO_SDOserver_init(). Table is empty after this
+ * call, entries are added with CO_SDOserver_fastUploadAdd().
+ *
+ * @param SDO This object.
+ * @param entries Array of entries, may be NULL to disable fast upload.
+ * @param entriesSize Number of elements in the array.
+ */
+void CO_SDOserver_initFastUpload(CO_SDOserver_t *SDO,
+                                 CO_SDOserver_fastEntry_t *entries,
+                                 uint16_t entriesSize);
+
+
+/**
+ * Add OD variable to the table for fast expedited upload.
+ *
+ * Variable must be readable by SDO, 1 to 4 bytes long, not a string and
+ * without OD extension, which has own read function. Its data pointer must not
+ * change later. Function must not be called while SDO server is receiving
+ * messages from the CAN bus, for example in the communication reset section.
+ *
+ * @param SDO This object.
+ * @param index Index of the object in Object Dictionary.
+ * @param subIndex Sub-index of the variable.
+ *
+ * @return ODR_OK on success, ODR_IDX_NOT_EXIST or ODR_SUB_NOT_EXIST if
+ * variable does not exist, ODR_UNSUPP_ACCESS if variable is not suitable for
+ * fast upload, ODR_OUT_OF_MEM if table is full, ODR_DEV_INCOMPAT if table is
+ * not initialized.
+ */
+ODR_t CO_SDOserver_fastUploadAdd(CO_SDOserver_t *SDO,
+                                 uint16_t index,
+                                 uint8_t subIndex);
+#endif
+
+
 /**
  * Process SDO communication.
  *
@@ -600,6 +813,71 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                                      uint32_t timeDifference_us,
                                      uint32_t *timerNext_us);
 
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE) \
+    || ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE) \
+    || defined CO_DOXYGEN
+/**
+ * Adapt limit for blksize after end of the sub-block in SDO block transfer.
+ *
+ * Used by the receiver of the sub-block (SDO server by block download, SDO
+ * client by block upload), which chooses blksize. If sub-block was not
+ * completely received (ackseq lower than blksize, also after sub-block
+ * timeout), then segments were lost and limit is reduced to the number of
+ * received segments, but not below 3/4 of blksize. Frames on CAN are usually
+ * lost by receiver overrun (slow USB-CAN adapter or slow SDO server), which
+ * repeats at the similar position in the sub-block. If complete sub-block with
+ * blksize equal to the limit was received, then limit is increased by one
+ * quarter. Sub-blocks limited by free buffer space do not increase the limit.
+ *
+ * @param limit Current limit, 1 to 127.
+ * @param blksize Number of segments requested in the sub-block.
+ * @param ackseq Sequence number of the last correctly received segment.
+ *
+ * @return New limit, 1 to 127.
+ */
+static inline uint8_t CO_SDO_blksizeAdapt(uint8_t limit, uint8_t blksize,
+                                          uint8_t ackseq)
+{
+    uint16_t newLimit = limit;
+
+    if (ackseq < blksize) {
+        newLimit = (blksize * 3U) / 4U;
+        if (newLimit < ackseq) {
+            newLimit = ackseq;
+        }
+        if (newLimit < 1U) {
+            newLimit = 1U;
+        }
+    }
+    else if (blksize >= limit) {
+        newLimit = (uint16_t)limit + (limit / 4U) + 1U;
+        if (newLimit > 127U) {
+            newLimit = 127U;
+        }
+    }
+    else { /* MISRA C 2004 14.10 */ }
+
+    return (uint8_t)newLimit;
+}
+
+
+/**
+ * Calculate throughput of the SDO block transfer.
+ *
+ * @param size Number of bytes transferred.
+ * @param elapsed_us Time elapsed for the transfer in microseconds.
+ *
+ * @return Throughput in bytes/second, 0 if elapsed_us is 0.
+ */
+static inline uint32_t CO_SDO_blockThroughput(size_t size,
+                                              uint32_t elapsed_us)
+{
+    return (elapsed_us == 0U) ? 0U
+           : (uint32_t)(((uint64_t)size * 1000000U) / elapsed_us);
+}
+#endif
+
 /** @} */ /* CO_SDOserver */
 
 #ifdef __cplusplus
@@ -27,6 +27,66 @@
 
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP
+#if CO_CONFIG_SYNC_JITTER_HIST_SIZE < 1 || CO_CONFIG_SYNC_JITTER_HIST_STEP_US < 1
+ #error CO_CONFIG_SYNC_JITTER_HIST_SIZE or CO_CONFIG_SYNC_JITTER_HIST_STEP_US is not correct
+#endif
+
+/*
+ * Update SYNC timing statistics with timestamp of new SYNC message.
+ */
+#if(C2000_PORT != 0)
+#pragma CODE_SECTION(CO_SYNC_timingUpdate, "ramfuncs");
+#endif
+static void CO_SYNC_timingUpdate(CO_SYNC_t *SYNC, uint32_t timestamp_us) {
+    CO_SYNC_timing_t *t = &SYNC->timing;
+    uint32_t period = timestamp_us - t->timestamp_us;
+    uint32_t nominal = SYNC->OD_1006_period != NULL
+                     ? *SYNC->OD_1006_period : 0;
+
+    if (nominal == 0) {
+        nominal = t->period_us;
+    }
+
+    if (!t->started) {
+        t->started = true;
+        t->expected_us = timestamp_us;
+    }
+    else if (nominal != 0 && period > (nominal + (nominal >> 1))) {
+        /* SYNC missed, start grid again */
+        t->missed++;
+        t->expected_us = timestamp_us;
+    }
+    else {
+        int32_t jitter = (int32_t)(period - nominal);
+        uint32_t jitterAbs = (uint32_t)(jitter < 0 ? -jitter : jitter);
+        uint32_t bin = jitterAbs / CO_CONFIG_SYNC_JITTER_HIST_STEP_US;
+
+        if (nominal == 0) {
+            /* second SYNC without nominal period, nothing to compare */
+            jitter = 0;
+            jitterAbs = 0;
+            bin = 0;
+        }
+        if (bin >= CO_CONFIG_SYNC_JITTER_HIST_SIZE) {
+            bin = CO_CONFIG_SYNC_JITTER_HIST_SIZE - 1;
+        }
+        t->period_us = period;
+        t->jitter_us = jitter;
+        if (jitterAbs > t->jitterMax_us) {
+            t->jitterMax_us = jitterAbs;
+        }
+        t->histogram[bin]++;
+        t->count++;
+        t->expected_us = nominal != 0 ? (t->expected_us + nominal)
+                                      : timestamp_us;
+    }
+
+    t->phase_us = (int32_t)(timestamp_us - t->expected_us);
+    t->timestamp_us = timestamp_us;
+}
+#endif /* (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP */
+
 /*
  * Read received message from CAN module.
  *
@@ -65,6 +125,15 @@ static void CO_SYNC_receive(void *object, void *msg) {
         /* toggle PDO receive buffer */
         SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP
+        uint32_t timestamp_us = CO_CANrxMsg_readTimestamp(msg);
+        CO_SYNC_timingUpdate(SYNC, timestamp_us);
+        /* process synchronous PDOs immediately */
+        if (SYNC->pFunctSync != NULL) {
+            SYNC->pFunctSync(SYNC->functSyncObject, timestamp_us);
+        }
+#endif
+
         CO_FLAG_SET(SYNC->CANrxNew);
 
 #if (CO_CONFIG_SYNC) & CO_CONFIG_FLAG_CALLBACK_PRE
@@ -392,6 +461,31 @@ void CO_SYNC_initCallbackPre(
 #endif
 
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP
+/******************************************************************************/
+void CO_SYNC_initCallbackSync(CO_SYNC_t *SYNC,
+                              void *object,
+                              void (*pFunctSync)(void *object,
+                                                 uint32_t timestamp_us),
+                              bool_t processesPDOs)
+{
+    if (SYNC != NULL) {
+        SYNC->functSyncObject = object;
+        SYNC->pFunctSync = pFunctSync;
+        SYNC->functSyncProcessesPDOs = processesPDOs;
+    }
+}
+
+
+/******************************************************************************/
+void CO_SYNC_txTimestamp(CO_SYNC_t *SYNC, uint32_t timestamp_us) {
+    if (SYNC != NULL) {
+        CO_SYNC_timingUpdate(SYNC, timestamp_us);
+    }
+}
+#endif
+
+
 /******************************************************************************/
 CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
                                  bool_t NMTisPreOrOperational,
@@ -411,6 +505,11 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
         if (CO_FLAG_READ(SYNC->CANrxNew)) {
             SYNC->timer = 0;
             syncStatus = CO_SYNC_RX_TX;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP
+            if (SYNC->pFunctSync != NULL && SYNC->functSyncProcessesPDOs) {
+                syncStatus = CO_SYNC_RX_PROCESSED;
+            }
+#endif
             CO_FLAG_CLEAR(SYNC->CANrxNew);
         }
 
@@ -489,7 +588,7 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
         SYNC->timer = 0;
     }
 
-    if (syncStatus == CO_SYNC_RX_TX) {
+    if (syncStatus == CO_SYNC_RX_TX || syncStatus == CO_SYNC_RX_PROCESSED) {
         if (SYNC->timeoutError == 2) {
             CO_errorReset(SYNC->em, CO_EM_SYNC_TIME_OUT, 0);
         }
@@ -40,6 +40,13 @@
                         CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
 #endif
 
+#ifndef CO_CONFIG_SYNC_JITTER_HIST_SIZE
+#define CO_CONFIG_SYNC_JITTER_HIST_SIZE 8
+#endif
+#ifndef CO_CONFIG_SYNC_JITTER_HIST_STEP_US
+#define CO_CONFIG_SYNC_JITTER_HIST_STEP_US 2
+#endif
+
 #if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE) || defined CO_DOXYGEN
 
 #ifdef __cplusplus
@@ -72,9 +79,59 @@ extern "C" {
  * transmitted, internal variable CANrxToggle toggles. That variable is then
  * used by synchronous RPDO to determine, which of the two buffers is used for
  * RPDO reception and which for RPDO processing.
+ *
+ * ####SYNC timestamps
+ * With CO_CONFIG_SYNC_TIMESTAMP CAN driver provides hardware timestamps of
+ * received SYNC messages (CO_CANrxMsg_readTimestamp()) and transmitted SYNC
+ * messages (CO_SYNC_txTimestamp()). For each SYNC measured period, jitter
+ * and phase offset are calculated into @ref CO_SYNC_timing_t. Callback from
+ * CO_SYNC_initCallbackSync() is called directly from the SYNC receive
+ * function. If registered with processesPDOs set to true, synchronous PDOs
+ * must be processed there, aligned to the SYNC timestamp and not delayed to
+ * the next CO_process_SYNC(); mainline then skips them. Otherwise callback is
+ * a notification only and mainline processes synchronous PDOs as usual.
  */
 
 
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP) || defined CO_DOXYGEN
+/**
+ * Timing of SYNC messages, calculated from timestamps.
+ *
+ * Values are updated inside SYNC receive function (or CO_SYNC_txTimestamp())
+ * and may be read inside the callback from CO_SYNC_initCallbackSync().
+ */
+typedef struct {
+    /** Timestamp of the last SYNC in microseconds */
+    uint32_t timestamp_us;
+    /** Measured time between the last two SYNC messages in microseconds */
+    uint32_t period_us;
+    /** Measured period minus nominal period in microseconds. Nominal period
+     * is _Communication cycle period_ (OD 1006) or previous measured period, if
+     * it is zero. */
+    int32_t jitter_us;
+    /** Time between the last SYNC and the ideal SYNC grid in microseconds.
+     * Grid starts with the first SYNC and is advanced by nominal period, so
+     * value shows drift between SYNC producer and local clock. */
+    int32_t phase_us;
+    /** Maximum absolute value of jitter_us in microseconds */
+    uint32_t jitterMax_us;
+    /** Number of SYNC messages with valid period_us */
+    uint32_t count;
+    /** Number of missed SYNC messages, detected from period longer than 1,5
+     * nominal period. Grid is started again after missed SYNC. */
+    uint32_t missed;
+    /** Histogram of absolute jitter values. Bin i counts SYNC messages with
+     * jitter from i to i+1 times CO_CONFIG_SYNC_JITTER_HIST_STEP_US, last bin
+     * counts also all larger values. */
+    uint32_t histogram[CO_CONFIG_SYNC_JITTER_HIST_SIZE];
+    /** Expected timestamp of the next SYNC on the ideal grid */
+    uint32_t expected_us;
+    /** True, if timestamp_us is valid */
+    bool_t started;
+} CO_SYNC_timing_t;
+#endif
+
+
 /**
  * SYNC producer and consumer object.
  */
@@ -140,6 +197,17 @@ typedef struct {
     /** From CO_SYNC_initCallbackPre() or NULL */
     void *functSignalObjectPre;
 #endif
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP) || defined CO_DOXYGEN
+    /** Timing statistics of SYNC messages */
+    CO_SYNC_timing_t timing;
+    /** From CO_SYNC_initCallbackSync() or NULL */
+    void (*pFunctSync)(void *object, uint32_t timestamp_us);
+    /** From CO_SYNC_initCallbackSync() or NULL */
+    void *functSyncObject;
+    /** From CO_SYNC_initCallbackSync(), true if pFunctSync processes PDOs */
+    bool_t functSyncProcessesPDOs;
+#endif
 } CO_SYNC_t;
 
 
@@ -150,7 +218,11 @@ typedef enum {
     /** SYNC message was received or transmitted in last cycle */
     CO_SYNC_RX_TX = 1,
     /** Time has just passed SYNC window (OD_1007) in last cycle */
-    CO_SYNC_PASSED_WINDOW = 2
+    CO_SYNC_PASSED_WINDOW = 2,
+    /** SYNC message was received in last cycle and synchronous PDOs were
+     * already processed by callback from CO_SYNC_initCallbackSync(), which
+     * was registered with processesPDOs set to true */
+    CO_SYNC_RX_PROCESSED = 3
 } CO_SYNC_status_t;
 
 
@@ -210,6 +282,65 @@ void CO_SYNC_initCallbackPre(CO_SYNC_t *SYNC,
 #endif
 
 
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_TIMESTAMP) || defined CO_DOXYGEN
+/**
+ * Initialize SYNC callback, optionally for processing of synchronous PDOs.
+ *
+ * Callback is called from the SYNC receive function (usually CAN receive
+ * interrupt) after PDO receive buffers are toggled, with SYNC timestamp as
+ * argument.
+ *
+ * @warning By default (processesPDOs is false) callback is only a
+ * notification and synchronous PDOs are still processed by the mainline
+ * CO_process_RPDO() and CO_process_TPDO(), CO_SYNC_process() returns
+ * CO_SYNC_RX_TX. If processesPDOs is true, callback takes over synchronous
+ * PDOs: it must call CO_process_RPDO() and CO_process_TPDO() with syncWas set
+ * to true and make sure, that PDOs are not processed concurrently from the
+ * mainline thread. CO_SYNC_process() then returns CO_SYNC_RX_PROCESSED for
+ * received SYNC and mainline skips synchronous PDOs for that SYNC. SYNC
+ * transmitted by this node as producer is always processed by mainline.
+ *
+ * @param SYNC This object.
+ * @param object Pointer to object, which will be passed to pFunctSync().
+ * @param pFunctSync Pointer to the callback function. Not called if NULL.
+ * @param processesPDOs True, if pFunctSync processes synchronous PDOs.
+ */
+void CO_SYNC_initCallbackSync(CO_SYNC_t *SYNC,
+                              void *object,
+                              void (*pFunctSync)(void *object,
+                                                 uint32_t timestamp_us),
+                              bool_t processesPDOs);
+
+
+/**
+ * Report transmission timestamp of the SYNC message.
+ *
+ * Should be called by the CAN driver (usually from CAN transmit interrupt),
+ * after SYNC message from CO_SYNC_t::CANtxBuff is transmitted. Updates
+ * @ref CO_SYNC_timing_t. Callback from CO_SYNC_initCallbackSync() is not
+ * called, synchronous PDOs of SYNC producer are processed after
+ * CO_SYNC_process().
+ *
+ * @param SYNC This object.
+ * @param timestamp_us Transmission time in microseconds, same time base as
+ * CO_CANrxMsg_readTimestamp().
+ */
+void CO_SYNC_txTimestamp(CO_SYNC_t *SYNC, uint32_t timestamp_us);
+
+
+/**
+ * Clear SYNC timing statistics.
+ *
+ * @param SYNC This object.
+ */
+static inline void CO_SYNC_timingReset(CO_SYNC_t *SYNC) {
+    if (SYNC != NULL) {
+        memset(&SYNC->timing, 0, sizeof(SYNC->timing));
+    }
+}
+#endif
+
+
 #if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER) || defined CO_DOXYGEN
 /**
  * Send SYNC message.
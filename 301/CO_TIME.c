@@ -45,6 +45,9 @@ static void CO_TIME_receive(void *object, void *msg) {
     uint8_t *data = CO_CANrxMsg_readData(msg);
 
     if (DLC == CO_TIME_MSG_LENGTH) {
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+        TIME->rxTimestamp_us = CO_CANrxMsg_readTimestamp(msg);
+#endif
         memcpy(TIME->timeStamp, data, sizeof(TIME->timeStamp));
         CO_FLAG_SET(TIME->CANrxNew);
 
@@ -177,6 +180,123 @@ CO_ReturnError_t CO_TIME_init(CO_TIME_t *TIME,
 }
 
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+/* Minimum time between reference point and TIME message for skew measurement,
+ * shorter baseline is too noisy with millisecond resolution of TIME message */
+#define CO_TIME_CLOCK_BASELINE_MIN_US 10000000
+
+/* Calculate network time from clock parameters at local time */
+static uint64_t CO_TIME_clockAt(const CO_TIME_clock_t *clock,
+                                uint32_t local_us)
+{
+    uint32_t dt = local_us - clock->local_us;
+    int64_t skew = ((int64_t)dt * clock->skew_ppb) / 1000000000;
+    return clock->net_us + dt + (uint64_t)skew;
+}
+
+/* Write clock parameters into inactive slot and publish them */
+static void CO_TIME_clockPublish(CO_TIME_t *TIME,
+                                 uint64_t net_us,
+                                 uint32_t local_us,
+                                 int32_t skew_ppb)
+{
+    uint32_t gen = TIME->clockGen;
+    CO_TIME_clock_t *clock = &TIME->clock[(gen + 1) & 1];
+
+    clock->local_us = local_us;
+    clock->skew_ppb = skew_ppb;
+    clock->net_us = net_us;
+    CO_MemoryBarrier();
+    TIME->clockGen = gen + 1;
+    TIME->clockSynced = true;
+}
+
+/*
+ * Correct clock with network time from received TIME message.
+ *
+ * Skew is measured between the reference point (first message after the step)
+ * and the message, so noise of the millisecond resolution is averaged over
+ * long time. Anchor point is moved to the message and 1/8 of the difference is
+ * corrected into offset. Large difference is corrected with a step.
+ */
+static void CO_TIME_clockDiscipline(CO_TIME_t *TIME,
+                                    uint64_t net_us,
+                                    uint32_t local_us)
+{
+    const CO_TIME_clock_t *clock = &TIME->clock[TIME->clockGen & 1];
+    int32_t skew_ppb = clock->skew_ppb;
+    uint32_t dt = local_us - clock->local_us;
+    uint64_t predicted = CO_TIME_clockAt(clock, local_us);
+    int64_t diff = (int64_t)(net_us - predicted);
+
+    if (!TIME->clockSynced || dt > 0x7FFFFFFF
+        || diff > CO_CONFIG_TIME_CLOCK_STEP_US
+        || diff < -CO_CONFIG_TIME_CLOCK_STEP_US
+    ) {
+        TIME->clockOffset_us = 0;
+        TIME->clockCount = 0;
+        TIME->clockRefNet_us = net_us;
+        TIME->clockRefLocal_us = local_us;
+        CO_TIME_clockPublish(TIME, net_us, local_us, skew_ppb);
+        return;
+    }
+
+    /* keep baseline for skew measurement below 2^31 microseconds */
+    uint32_t dtRef = local_us - TIME->clockRefLocal_us;
+    if (dtRef > 0x7FFFFFFF) {
+        TIME->clockRefLocal_us += 0x40000000;
+        TIME->clockRefNet_us += 0x40000000
+            + (uint64_t)(((int64_t)0x40000000 * skew_ppb) / 1000000000);
+        dtRef -= 0x40000000;
+    }
+    if (dtRef >= CO_TIME_CLOCK_BASELINE_MIN_US) {
+        const int64_t skewMax =
+            (int64_t)CO_CONFIG_TIME_CLOCK_MAX_SKEW_PPM * 1000;
+        int64_t drift = (int64_t)(net_us - TIME->clockRefNet_us)
+                      - (int64_t)dtRef;
+        int64_t skew = drift * 1000000000 / (int64_t)dtRef;
+        if (skew > skewMax) { skew = skewMax; }
+        else if (skew < -skewMax) { skew = -skewMax; }
+        else { /* MISRA C 2004 14.10 */ }
+        skew_ppb = (int32_t)skew;
+    }
+
+    TIME->clockOffset_us = (int32_t)diff;
+    TIME->clockCount++;
+    CO_TIME_clockPublish(TIME, predicted + (uint64_t)(diff / 8), local_us,
+                         skew_ppb);
+}
+
+
+void CO_TIME_clockSet(CO_TIME_t *TIME, uint64_t net_us, uint32_t local_us) {
+    if (TIME != NULL) {
+        CO_TIME_clockPublish(TIME, net_us, local_us,
+                             TIME->clock[TIME->clockGen & 1].skew_ppb);
+    }
+}
+
+
+uint64_t CO_TIME_now_us(const CO_TIME_t *TIME) {
+    if (TIME == NULL || !TIME->clockSynced) {
+        return 0;
+    }
+
+    uint32_t gen;
+    CO_TIME_clock_t clock;
+    /* Repeat, if clock parameters were published during the copy. Interrupt,
+     * which preempts CO_TIME_process(), reads unchanged active slot. */
+    do {
+        gen = TIME->clockGen;
+        CO_MemoryBarrier();
+        clock = TIME->clock[gen & 1];
+        CO_MemoryBarrier();
+    } while (gen != TIME->clockGen);
+
+    return CO_TIME_clockAt(&clock, CO_localTime_us());
+}
+#endif /* (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK */
+
+
 #if (CO_CONFIG_TIME) & CO_CONFIG_FLAG_CALLBACK_PRE
 void CO_TIME_initCallbackPre(CO_TIME_t *TIME,
                              void *object,
@@ -205,6 +325,12 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
             TIME->days = CO_SWAP_16(days_swapped);
             TIME->residual_us = 0;
             timestampReceived = true;
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+            /* message has millisecond resolution, use middle of it */
+            CO_TIME_clockDiscipline(TIME,
+                ((uint64_t)TIME->days * 86400000 + TIME->ms) * 1000 + 500,
+                TIME->rxTimestamp_us);
+#endif
 
             CO_FLAG_CLEAR(TIME->CANrxNew);
         }
@@ -226,6 +352,18 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
         }
     }
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK
+    /* move anchor point before local time difference overflows */
+    if (TIME->clockSynced) {
+        const CO_TIME_clock_t *clock = &TIME->clock[TIME->clockGen & 1];
+        uint32_t local_us = CO_localTime_us();
+        if ((local_us - clock->local_us) > 0x40000000) {
+            CO_TIME_clockPublish(TIME, CO_TIME_clockAt(clock, local_us),
+                                 local_us, clock->skew_ppb);
+        }
+    }
+#endif
+
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_PRODUCER
     if (NMTisPreOrOperational && TIME->isProducer
         && TIME->producerInterval_ms > 0
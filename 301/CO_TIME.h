@@ -38,6 +38,13 @@
                         CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
 #endif
 
+#ifndef CO_CONFIG_TIME_CLOCK_STEP_US
+#define CO_CONFIG_TIME_CLOCK_STEP_US 100000
+#endif
+#ifndef CO_CONFIG_TIME_CLOCK_MAX_SKEW_PPM
+#define CO_CONFIG_TIME_CLOCK_MAX_SKEW_PPM 500
+#endif
+
 #if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) || defined CO_DOXYGEN
 
 #ifdef __cplusplus
@@ -68,9 +75,38 @@ extern "C" {
  * Current time can be set with @ref CO_TIME_set() function, which is necessary
  * at least once, if time producer. If configured, time stamp message is
  * send from @ref CO_TIME_process() in intervals specified by @ref CO_TIME_set()
+ *
+ * ####Disciplined clock
+ * With CO_CONFIG_TIME_CLOCK network time with microsecond resolution is
+ * provided by CO_TIME_now_us(). It is calculated from CO_localTime_us() and
+ * from clock parameters: local and network time of the last anchor point and
+ * skew of the local clock. Consumer updates parameters in CO_TIME_process()
+ * after each received TIME message: skew is measured against the first
+ * message after the last step and part of the difference between network
+ * time from the message and prediction of the local clock is corrected into
+ * the offset. Producer is the reference, so its clock follows CO_TIME_set().
+ *
+ * Clock parameters are stored in two slots. CO_TIME_process() writes the
+ * inactive slot and then publishes it, so CO_TIME_now_us() is lock-free and
+ * may be called from any thread or interrupt.
  */
 
 
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK) || defined CO_DOXYGEN
+/**
+ * Parameters of the disciplined clock, see CO_TIME_now_us().
+ */
+typedef struct {
+    /** Local time of the anchor point, from CO_localTime_us() */
+    uint32_t local_us;
+    /** Skew of the local clock, in parts per billion */
+    int32_t skew_ppb;
+    /** Network time of the anchor point, microseconds since January 1, 1984 */
+    uint64_t net_us;
+} CO_TIME_clock_t;
+#endif
+
+
 /** Length of the TIME message */
 #define CO_TIME_MSG_LENGTH 6
 
@@ -115,6 +151,26 @@ typedef struct {
     /** Extension for OD object */
     OD_extension_t OD_1012_extension;
 #endif
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK) || defined CO_DOXYGEN
+    /** Two slots with clock parameters, clock[clockGen & 1] is valid */
+    CO_TIME_clock_t clock[2];
+    /** Incremented after new clock parameters are published */
+    volatile uint32_t clockGen;
+    /** True, if clock parameters are valid */
+    volatile bool_t clockSynced;
+    /** Local time of the last received TIME message, from
+     * CO_CANrxMsg_readTimestamp() */
+    uint32_t rxTimestamp_us;
+    /** Difference between last received TIME message and local clock in
+     * microseconds, before correction */
+    int32_t clockOffset_us;
+    /** Number of TIME messages used for smooth correction since last step */
+    uint32_t clockCount;
+    /** Network time of the reference point for skew measurement */
+    uint64_t clockRefNet_us;
+    /** Local time of the reference point for skew measurement */
+    uint32_t clockRefLocal_us;
+#endif
 } CO_TIME_t;
 
 
@@ -163,6 +219,33 @@ void CO_TIME_initCallbackPre(CO_TIME_t *TIME,
 #endif
 
 
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK) || defined CO_DOXYGEN
+/**
+ * Set disciplined clock to network time, see CO_TIME_now_us().
+ *
+ * Called from CO_TIME_set(). Skew is kept.
+ *
+ * @param TIME This object.
+ * @param net_us Network time in microseconds since January 1, 1984.
+ * @param local_us Local time from CO_localTime_us(), at which net_us is valid.
+ */
+void CO_TIME_clockSet(CO_TIME_t *TIME, uint64_t net_us, uint32_t local_us);
+
+
+/**
+ * Get current network time from disciplined clock.
+ *
+ * Function is lock-free and may be called from any thread or interrupt.
+ *
+ * @param TIME This object.
+ *
+ * @return Network time in microseconds since January 1, 1984 or 0, if clock
+ * is not yet synchronized.
+ */
+uint64_t CO_TIME_now_us(const CO_TIME_t *TIME);
+#endif
+
+
 /**
  * Set current time
  *
@@ -182,6 +265,10 @@ static inline void CO_TIME_set(CO_TIME_t *TIME,
         TIME->residual_us = 0;
         TIME->ms = ms;
         TIME->days = days;
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_CLOCK)
+        CO_TIME_clockSet(TIME, ((uint64_t)days * 86400000 + ms) * 1000,
+                         CO_localTime_us());
+#endif
 #if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_PRODUCER)
         TIME->producerTimer_ms = TIME->producerInterval_ms =producerInterval_ms;
 #endif
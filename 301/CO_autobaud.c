@@ -0,0 +1,189 @@
+/*
+ * CAN bit rate auto-detection
+ *
+ * @file        CO_autobaud.c
+ * @ingroup     CO_autobaud
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_autobaud.h"
+
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE
+
+/* Bit rates from CiA 301 in kbit/s, in order of the LSS bit timing table */
+static const uint16_t CO_autobaud_rates[] = {
+    1000, 800, 500, 250, 125, 50, 20, 10
+};
+#define RATES_COUNT (sizeof(CO_autobaud_rates) / sizeof(CO_autobaud_rates[0]))
+#define RATES_ALL ((uint8_t)((1U << RATES_COUNT) - 1U))
+
+/* Bit rate, used if preferred bit rate is not valid */
+#define DEFAULT_INDEX 4
+
+
+/* Get index of bit rate in the table or RATES_COUNT, if not found */
+static uint8_t rateIndex(uint16_t bitRate) {
+    uint8_t i;
+
+    for (i = 0; i < RATES_COUNT; i++) {
+        if (CO_autobaud_rates[i] == bitRate) {
+            break;
+        }
+    }
+    return i;
+}
+
+
+/* Start listening with bit rate from the table */
+static bool_t startListen(CO_autobaud_t *ab, uint8_t index) {
+    ab->index = index;
+    ab->bitRate = CO_autobaud_rates[index];
+    ab->tried |= (uint8_t)(1U << index);
+    ab->dwellTimer = 0;
+    return CO_autobaud_listen(ab->CANptr, ab->bitRate);
+}
+
+
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_MEASURE
+/* Get index of bit rate, which matches measured bit time within 10%, or
+ * RATES_COUNT */
+static uint8_t measuredIndex(uint32_t bitTime_ns) {
+    for (uint8_t i = 0; i < RATES_COUNT; i++) {
+        uint32_t nominal_ns = 1000000UL / CO_autobaud_rates[i];
+        uint32_t diff = bitTime_ns > nominal_ns ? bitTime_ns - nominal_ns
+                                                : nominal_ns - bitTime_ns;
+        if (diff <= nominal_ns / 10U) {
+            return i;
+        }
+    }
+    return RATES_COUNT;
+}
+#endif
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_autobaud_init(CO_autobaud_t *ab,
+                                  void *CANptr,
+                                  uint16_t preferredBitRate,
+                                  uint32_t dwellTime_us,
+                                  uint32_t timeout_us)
+{
+    uint8_t index;
+
+    /* verify arguments */
+    if (ab == NULL || dwellTime_us == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    index = rateIndex(preferredBitRate);
+    if (index >= RATES_COUNT) {
+        index = DEFAULT_INDEX;
+    }
+
+    ab->CANptr = CANptr;
+    ab->preferredBitRate = CO_autobaud_rates[index];
+    ab->tried = 0;
+    ab->state = CO_AUTOBAUD_WAIT;
+    ab->dwellTime_us = dwellTime_us;
+    ab->timeout_us = timeout_us;
+    ab->timer = 0;
+    ab->switches = 0;
+
+    if (!startListen(ab, index)) {
+        ab->state = CO_AUTOBAUD_ERROR;
+        return CO_ERROR_ILLEGAL_BAUDRATE;
+    }
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_autobaud_return_t CO_autobaud_process(CO_autobaud_t *ab,
+                                         uint32_t timeDifference_us,
+                                         uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    if (ab == NULL || ab->state != CO_AUTOBAUD_WAIT) {
+        return ab != NULL ? ab->state : CO_AUTOBAUD_ERROR;
+    }
+
+    CO_autobaud_event_t event = CO_autobaud_event(ab->CANptr);
+    uint8_t next = RATES_COUNT;
+
+    if (event == CO_AUTOBAUD_EV_FRAME) {
+        ab->state = CO_AUTOBAUD_FOUND;
+        return ab->state;
+    }
+
+    ab->timer += timeDifference_us;
+    ab->dwellTimer += timeDifference_us;
+    if (ab->timeout_us > 0 && ab->timer >= ab->timeout_us) {
+        /* silent mode ends with CO_CANinit() */
+        ab->bitRate = ab->preferredBitRate;
+        ab->state = CO_AUTOBAUD_TIMEOUT;
+        return ab->state;
+    }
+
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_MEASURE
+    /* jump to the measured bit rate, if not already tried */
+    uint32_t bitTime_ns = CO_autobaud_bitTime_ns(ab->CANptr);
+    if (bitTime_ns > 0) {
+        uint8_t i = measuredIndex(bitTime_ns);
+        if (i < RATES_COUNT && (ab->tried & (1U << i)) == 0) {
+            next = i;
+        }
+    }
+#endif
+
+    if (next >= RATES_COUNT
+        && (event == CO_AUTOBAUD_EV_ERROR || ab->dwellTimer >= ab->dwellTime_us)
+    ) {
+        /* next bit rate in the table, start new round after the last */
+        if (ab->tried == RATES_ALL) {
+            ab->tried = 0;
+        }
+        for (next = 0; (ab->tried & (1U << next)) != 0; next++) { }
+    }
+
+    if (next < RATES_COUNT) {
+        ab->switches++;
+        if (!startListen(ab, next)) {
+            ab->state = CO_AUTOBAUD_ERROR;
+            return ab->state;
+        }
+    }
+
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_FLAG_TIMERNEXT
+    if (timerNext_us != NULL) {
+        uint32_t diff = ab->dwellTime_us - ab->dwellTimer;
+        if (ab->timeout_us > 0 && (ab->timeout_us - ab->timer) < diff) {
+            diff = ab->timeout_us - ab->timer;
+        }
+        if (*timerNext_us > diff) {
+            *timerNext_us = diff;
+        }
+    }
+#endif
+
+    return ab->state;
+}
+
+#endif /* (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE */
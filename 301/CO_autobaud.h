@@ -0,0 +1,224 @@
+/**
+ * CAN bit rate auto-detection
+ *
+ * @file        CO_autobaud.h
+ * @ingroup     CO_autobaud
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_AUTOBAUD_H
+#define CO_AUTOBAUD_H
+
+#include "301/CO_driver.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_AUTOBAUD
+#define CO_CONFIG_AUTOBAUD (0)
+#endif
+
+#if ((CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_autobaud Bit rate detection
+ * Detection of CAN bit rate before joining the network.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * CO_CANinit() requires known bit rate. Device, which is connected to the
+ * network with unknown bit rate, can detect it with this object before
+ * CO_CANinit(). CAN controller listens in silent (listen-only) mode, so it
+ * never sends dominant bits, not even acknowledge or error frames, and it does
+ * not disturb the traffic.
+ *
+ * Bit rates from the CiA 301 table (1000, 800, 500, 250, 125, 50, 20 and
+ * 10 kbit/s) are tried, preferred bit rate (for example the last one used,
+ * stored by LSS) first. With wrong bit rate the controller detects error
+ * (stuff, form or CRC) on the first frame on the bus and the next bit rate is
+ * tried immediately. Bit rate is found with the first correctly received frame.
+ * If the bus is silent, the next bit rate is tried after _dwellTime_us_. So
+ * detection on a bus with traffic takes a few frames, not a timeout for each
+ * bit rate.
+ *
+ * If CAN hardware can measure the bus (for example timer input capture on
+ * CAN RX pin or controller with bit rate detection), then enable
+ * CO_CONFIG_AUTOBAUD_MEASURE. Driver reports the shortest time between
+ * edges, which is one bit, and the nearest bit rate from the table is tried
+ * next, without walking through the table.
+ *
+ * If nothing is received in _timeout_us_, preferred bit rate is returned. With
+ * LSS (CiA 305) master may then configure the bit rate. Value 0, which is
+ * CO_LSS_BIT_TIMING_AUTO in LSS, may be used as pending bit rate, which is
+ * detected on the next communication reset, see example/main_blank.c.
+ *
+ * When detected, application calls CO_CANinit() with _bitRate_, which ends the
+ * silent mode. Functions CO_autobaud_listen(), CO_autobaud_event() and
+ * CO_autobaud_bitTime_ns() are target system specific.
+ */
+
+/**
+ * Return value of CO_autobaud_process()
+ */
+typedef enum {
+    CO_AUTOBAUD_ERROR = -1,   /**< CO_autobaud_listen() failed */
+    CO_AUTOBAUD_WAIT = 0,     /**< Detection is in progress */
+    CO_AUTOBAUD_FOUND = 1,    /**< Bit rate was detected */
+    CO_AUTOBAUD_TIMEOUT = 2   /**< Nothing received, preferred bit rate is
+                                   returned */
+} CO_autobaud_return_t;
+
+/**
+ * Event from CAN controller in silent mode, see CO_autobaud_event()
+ */
+typedef enum {
+    CO_AUTOBAUD_EV_NONE = 0,  /**< No bus activity */
+    CO_AUTOBAUD_EV_FRAME = 1, /**< Valid frame received */
+    CO_AUTOBAUD_EV_ERROR = 2  /**< Stuff, form, CRC or bit error detected */
+} CO_autobaud_event_t;
+
+
+/**
+ * Bit rate detection object
+ */
+typedef struct {
+    /** From CO_autobaud_init() */
+    void *CANptr;
+    /** From CO_autobaud_init() */
+    uint16_t preferredBitRate;
+    /** Bit rate in kbit/s, which is currently tried or detected */
+    uint16_t bitRate;
+    /** Index of the currently tried bit rate in the CiA 301 table */
+    uint8_t index;
+    /** Bit mask of bit rates, tried in the current round */
+    uint8_t tried;
+    /** Result of the detection */
+    CO_autobaud_return_t state;
+    /** From CO_autobaud_init() */
+    uint32_t dwellTime_us;
+    /** From CO_autobaud_init() */
+    uint32_t timeout_us;
+    /** Time since the current bit rate is tried */
+    uint32_t dwellTimer;
+    /** Time since start of the detection */
+    uint32_t timer;
+    /** Number of changes of the bit rate */
+    uint16_t switches;
+} CO_autobaud_t;
+
+
+/**
+ * Initialize bit rate detection and start listening.
+ *
+ * Function must be called in the communication reset section, before
+ * CO_CANinit(). CAN module must be in configuration mode.
+ *
+ * @param ab This object will be initialized.
+ * @param CANptr Pointer to CAN device, passed to target functions.
+ * @param preferredBitRate Bit rate in kbit/s, which is tried first and returned
+ * on timeout. If 0 or not in the table, 125 kbit/s is used.
+ * @param dwellTime_us Time, how long one bit rate is tried on silent bus.
+ * Should be longer than the period of the most frequent message, for example
+ * 100000 for heartbeat.
+ * @param timeout_us Time of the whole detection, 0 for no timeout.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_ILLEGAL_BAUDRATE, if CO_autobaud_listen() failed.
+ */
+CO_ReturnError_t CO_autobaud_init(CO_autobaud_t *ab,
+                                  void *CANptr,
+                                  uint16_t preferredBitRate,
+                                  uint32_t dwellTime_us,
+                                  uint32_t timeout_us);
+
+
+/**
+ * Process bit rate detection.
+ *
+ * Function must be called cyclically until it returns other than
+ * CO_AUTOBAUD_WAIT, or after CAN controller signalled the event.
+ *
+ * @param ab This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * microseconds.
+ * @param [out] timerNext_us info to OS, see CO_process_SYNC().
+ *
+ * @return #CO_autobaud_return_t. If CO_AUTOBAUD_FOUND or
+ * CO_AUTOBAUD_TIMEOUT, use _ab->bitRate_ with CO_CANinit().
+ */
+CO_autobaud_return_t CO_autobaud_process(CO_autobaud_t *ab,
+                                         uint32_t timeDifference_us,
+                                         uint32_t *timerNext_us);
+
+
+/**
+ * Configure CAN controller in silent mode, target system specific function.
+ *
+ * Controller must only receive, it must not transmit anything, including
+ * acknowledge. Received frames are not passed to CANopen objects. Events
+ * reported by CO_autobaud_event() are cleared.
+ *
+ * @param CANptr Pointer to CAN device, from CO_autobaud_init().
+ * @param bitRate Bit rate in kbit/s.
+ *
+ * @return true on success.
+ */
+bool_t CO_autobaud_listen(void *CANptr, uint16_t bitRate);
+
+
+/**
+ * Get event from CAN controller in silent mode, target system specific
+ * function.
+ *
+ * @param CANptr Pointer to CAN device.
+ *
+ * @return CO_AUTOBAUD_EV_ERROR, if any error was detected since
+ * CO_autobaud_listen(), else CO_AUTOBAUD_EV_FRAME, if valid frame was
+ * received, else CO_AUTOBAUD_EV_NONE.
+ */
+CO_autobaud_event_t CO_autobaud_event(void *CANptr);
+
+
+#if ((CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_MEASURE) || defined CO_DOXYGEN
+/**
+ * Get the shortest time between two edges on the bus, target system specific
+ * function, used with CO_CONFIG_AUTOBAUD_MEASURE.
+ *
+ * Measurement runs independently of the bit rate of the controller.
+ *
+ * @param CANptr Pointer to CAN device.
+ *
+ * @return Time in nanoseconds or 0, if there were no edges yet.
+ */
+uint32_t CO_autobaud_bitTime_ns(void *CANptr);
+#endif
+
+/** @} */ /* CO_autobaud */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE */
+
+#endif /* CO_AUTOBAUD_H */
@@ -31,7 +31,11 @@
 extern "C" {
 #endif
 
+/* Non zero for TI C2000 port, where char has 16 bits. May be overridden by
+ * compiler option, for example host benchmark builds with C2000_PORT=0. */
+#ifndef C2000_PORT
 #define C2000_PORT  (1)
+#endif
 
 /**
  * @defgroup CO_STACK_CONFIG Stack configuration
@@ -167,6 +171,13 @@ extern "C" {
  *   CO_HBconsumer_initCallbackRemoteReset() functions.
  * - CO_CONFIG_HB_CONS_QUERY_FUNCT - Enable functions for query HB state or
  *   NMT state of the specific monitored node.
+ * - CO_CONFIG_HB_CONS_INDEXED - Enable node-ID indexed monitoring for devices
+ *   with many monitored nodes. Received heartbeats are queued by the receive
+ *   callback, timeouts are checked in deadline order and aggregate states are
+ *   kept in node-ID indexed bitmaps, see CO_HBconsumer_t::activeBits. Cost of
+ *   CO_HBconsumer_process() then depends on number of received heartbeats and
+ *   expired timeouts, not on number of monitored nodes. Uses approximately
+ *   700 bytes of additional memory.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received heartbeat CAN message.
  *   Callback is configured by CO_HBconsumer_initCallbackPre().
@@ -185,6 +196,7 @@ extern "C" {
 #define CO_CONFIG_HB_CONS_CALLBACK_CHANGE 0x02
 #define CO_CONFIG_HB_CONS_CALLBACK_MULTI 0x04
 #define CO_CONFIG_HB_CONS_QUERY_FUNCT 0x08
+#define CO_CONFIG_HB_CONS_INDEXED 0x10
 /** @} */ /* CO_STACK_CONFIG_NMT_HB */
 
 
@@ -199,6 +211,12 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE - Enable Node guarding slave.
  * - CO_CONFIG_NODE_GUARDING_MASTER_ENABLE - Enable Node guarding master.
+ * - CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER - Node guarding master keeps
+ *   guard timers of monitored nodes in a timer queue, so processing time does
+ *   not depend on number of nodes. First RTR messages of the nodes are spread
+ *   over the guard time and RTR messages are rate limited, see
+ *   CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL. CO_CONFIG_TIMERQ_ENABLE must
+ *   be enabled.
  * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
  *   inside CO_nodeGuardingSlave_process().
  */
@@ -207,6 +225,7 @@ extern "C" {
 #endif
 #define CO_CONFIG_NODE_GUARDING_SLAVE_ENABLE 0x01
 #define CO_CONFIG_NODE_GUARDING_MASTER_ENABLE 0x02
+#define CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER 0x04
 
 /**
  * Maximum number of nodes monitored by master
@@ -214,6 +233,25 @@ extern "C" {
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_NODE_GUARDING_MASTER_COUNT 0x7F
 #endif
+
+/**
+ * Average interval between RTR messages from Node guarding master in
+ * microseconds, used with CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER.
+ *
+ * Token bucket allows up to CO_CONFIG_NODE_GUARDING_MASTER_RTR_BURST messages
+ * at once, then one message per interval. Value 0 disables rate limiting.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL 500
+#endif
+
+/**
+ * Size of the token bucket for RTR messages, see
+ * CO_CONFIG_NODE_GUARDING_MASTER_RTR_INTERVAL.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_NODE_GUARDING_MASTER_RTR_BURST 4
+#endif
 /** @} */ /* CO_STACK_CONFIG_NODE_GUARDING */
 
 
@@ -235,6 +273,19 @@ extern "C" {
  * - CO_CONFIG_EM_HISTORY - Enable error history, OD object 0x1003,
  *   "Pre-defined error field"
  * - CO_CONFIG_EM_CONSUMER - Enable simple emergency consumer with callback.
+ * - CO_CONFIG_EM_CONS_QUEUE - Received emergency messages are stored into a
+ *   lock-free queue by the CAN receive callback. They are passed to the
+ *   callback from CO_EM_initCallbackRx() inside CO_EM_process() or read by
+ *   the application with CO_EM_consumerRead(). Requires CO_CONFIG_EM_CONSUMER.
+ * - CO_CONFIG_EM_CONS_HISTORY - Enable history of received emergency messages
+ *   for each remote node, see CO_EM_initConsumerHistory(). Requires
+ *   CO_CONFIG_EM_CONS_QUEUE.
+ * - CO_CONFIG_EM_ATOMIC - CO_errorReport() and CO_errorReset() don't use
+ *   CO_LOCK_EMCY(). Error status bits are changed with atomic operations and
+ *   emergency fifo is written lock-free, so functions may be called from any
+ *   interrupt. Error register is calculated only after error status bits
+ *   change, so CO_CONFIG_ERR_CONDITION_* must depend on errorStatusBits only.
+ *   See CO_ATOMIC_FETCH_OR_U8() for port requirements.
  * - CO_CONFIG_EM_STATUS_BITS - Access @ref CO_EM_errorStatusBits_t from OD.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   emergency condition by CO_errorReport() or CO_errorReset() call.
@@ -251,6 +302,27 @@ extern "C" {
 #define CO_CONFIG_EM_HISTORY 0x08
 #define CO_CONFIG_EM_STATUS_BITS 0x10
 #define CO_CONFIG_EM_CONSUMER 0x20
+#define CO_CONFIG_EM_CONS_QUEUE 0x40
+#define CO_CONFIG_EM_CONS_HISTORY 0x80
+#define CO_CONFIG_EM_ATOMIC 0x100
+
+/**
+ * Number of elements in emergency consumer queue, see CO_CONFIG_EM_CONS_QUEUE.
+ *
+ * Queue holds (CO_CONFIG_EM_CONS_QUEUE_SIZE - 1) messages. Valid values are
+ * from 2 to 255. Default is 16.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_CONS_QUEUE_SIZE 16
+#endif
+
+/**
+ * Number of latest different error codes stored for each remote node, see
+ * CO_CONFIG_EM_CONS_HISTORY. Default is 4.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_CONS_HISTORY_SIZE 4
+#endif
 
 /**
  * Maximum number of @ref CO_EM_errorStatusBits_t
@@ -353,6 +425,45 @@ extern "C" {
  * - CO_CONFIG_SDO_SRV_SEGMENTED - Enable SDO server segmented transfer.
  * - CO_CONFIG_SDO_SRV_BLOCK - Enable SDO server block transfer. If set, then
  *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE - Adapt blksize in block download to the
+ *   observed frame loss and measure throughput of block transfer, see
+ *   CO_SDO_blksizeAdapt().
+ * - CO_CONFIG_SDO_SRV_BLOCK_STREAM - Stream data of block upload from OD_IO
+ *   read function into segments just in time, so block transfer works with
+ *   small CO_CONFIG_SDO_SRV_BUFFER_SIZE. Segments, which must be
+ *   re-transmitted, are read again from the OD variable from
+ *   OD_stream_t.dataOffset. Read functions of OD extensions, accessed by block
+ *   upload, must respect dataOffset, as OD_readOriginal() does. With small
+ *   buffer blksize of block download is also small.
+ * - CO_CONFIG_SDO_SRV_BUFFER_POOL - SDO servers do not include own data buffer
+ *   of CO_CONFIG_SDO_SRV_BUFFER_SIZE, they borrow it from the shared pool at
+ *   start of segmented or block transfer, see CO_SDOserver_bufPool_t. Size of
+ *   the pool is CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT.
+ * - CO_CONFIG_SDO_SRV_FAST_UPLOAD - Answer expedited upload of selected OD
+ *   variables directly from the CAN receive function, without waiting for
+ *   CO_SDOserver_process(). Variables are registered with
+ *   CO_SDOserver_fastUploadAdd(). CO_LOCK_OD() must be usable from the CAN
+ *   receive context.
+ * - CO_CONFIG_SDO_SRV_COMPLETE - Enable complete access to ARRAY and RECORD
+ *   objects. Bit 4 of the initiate command specifier (reserved by CiA 301) is
+ *   set by the client, then all sub-objects from the requested sub-index on
+ *   are transferred as one image, see OD_getComplete(). If set, then
+ *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_BLOCK_FLOW - Flow control in segmented and block
+ *   download. Write function of OD extension may return ODR_PARTIAL with
+ *   countWritten smaller than count, for example if flash is busy. Remaining
+ *   data stays in the buffer, so the next blksize is smaller. If buffer is
+ *   full, response to the segment or sub-block is delayed and write is
+ *   retried. After the last data write function may return ODR_PARTIAL also
+ *   after all data is written, then it is called again with the remaining data
+ *   (count may be 0), until it returns ODR_OK, and the last segment response
+ *   or block download end response is delayed. Retry period is
+ *   CO_CONFIG_SDO_SRV_FLOW_RETRY_US. See also CO_prgDownload.
+ * - CO_CONFIG_SDO_SRV_READY_LIST - SDO servers with received message are put
+ *   into lock-free list of ready objects (see CO_readyList_t) from CAN receive
+ *   callback, so CO_process() calls CO_SDOserver_process() only for them and
+ *   for SDO servers in transfer, which need time for timeouts. All SDO servers
+ *   are processed after communication reset and on change of NMT state.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOserver_initCallbackPre().
@@ -366,18 +477,45 @@ extern "C" {
 #endif
 #define CO_CONFIG_SDO_SRV_SEGMENTED 0x02
 #define CO_CONFIG_SDO_SRV_BLOCK 0x04
+#define CO_CONFIG_SDO_SRV_BLOCK_ADAPTIVE 0x08
+#define CO_CONFIG_SDO_SRV_BLOCK_STREAM 0x10
+#define CO_CONFIG_SDO_SRV_BUFFER_POOL 0x20
+#define CO_CONFIG_SDO_SRV_FAST_UPLOAD 0x40
+#define CO_CONFIG_SDO_SRV_COMPLETE 0x80
+#define CO_CONFIG_SDO_SRV_BLOCK_FLOW 0x100
+#define CO_CONFIG_SDO_SRV_READY_LIST 0x200
 
 /**
  * Size of the internal data buffer for the SDO server.
  *
  * If size is less than size of some variables in Object Dictionary, then data
  * will be transferred to internal buffer in several segments. Minimum size is
- * 8 or 899 (127*7) for block transfer.
+ * 8 or 899 (127*7) for block transfer. With CO_CONFIG_SDO_SRV_BLOCK_STREAM
+ * minimum size is 20 also for block transfer.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_SDO_SRV_BUFFER_SIZE 32
 #endif
 
+/**
+ * Period in microseconds, in which SDO server with
+ * CO_CONFIG_SDO_SRV_BLOCK_FLOW retries write to the busy OD variable. It is
+ * used for calculation of timerNext_us.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_SRV_FLOW_RETRY_US 1000
+#endif
+
+/**
+ * Number of data buffers in the pool shared by SDO servers, if
+ * CO_CONFIG_SDO_SRV_BUFFER_POOL is enabled. It is the maximum number of
+ * simultaneous segmented or block transfers on all SDO servers. Value from 1
+ * to 32.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT 2
+#endif
+
 /**
  * Configuration of @ref CO_SDOclient
  *
@@ -390,6 +528,18 @@ extern "C" {
  * - CO_CONFIG_SDO_CLI_LOCAL - Enable local transfer, if Node-ID of the SDO
  *   server is the same as node-ID of the SDO client. (SDO client is the same
  *   device as SDO server.) Transfer data directly without communication on CAN.
+ * - CO_CONFIG_SDO_CLI_POOL - Enable @ref CO_SDOclientPool, queue of SDO
+ *   requests, which are executed on multiple SDO clients simultaneously.
+ * - CO_CONFIG_SDO_CLI_DIRECT_BUF - Enable CO_SDOclientUploadInitiateDirect()
+ *   and CO_SDOclientDownloadInitiateDirect(), which transfer data directly
+ *   from/to caller's buffer, without internal buffer of the SDO client.
+ * - CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE - Adapt blksize in block upload to the
+ *   observed frame loss, measure throughput of block transfer and make
+ *   'protocol switch threshold' configurable at run time, see
+ *   CO_SDO_blksizeAdapt().
+ * - CO_CONFIG_SDO_CLI_COMPLETE - Enable CO_SDOclientCompleteAccess(), which
+ *   requests complete access to ARRAY or RECORD object on the server, see
+ *   CO_CONFIG_SDO_SRV_COMPLETE.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOclient_initCallbackPre().
@@ -406,6 +556,10 @@ extern "C" {
 #define CO_CONFIG_SDO_CLI_SEGMENTED 0x02
 #define CO_CONFIG_SDO_CLI_BLOCK 0x04
 #define CO_CONFIG_SDO_CLI_LOCAL 0x08
+#define CO_CONFIG_SDO_CLI_POOL 0x10
+#define CO_CONFIG_SDO_CLI_DIRECT_BUF 0x20
+#define CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE 0x40
+#define CO_CONFIG_SDO_CLI_COMPLETE 0x80
 
 /**
  * Size of the internal data buffer for the SDO client.
@@ -435,6 +589,11 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_TIME_ENABLE - Enable TIME object and TIME consumer.
  * - CO_CONFIG_TIME_PRODUCER - Enable TIME producer.
+ * - CO_CONFIG_TIME_CLOCK - Enable local clock, disciplined to the TIME
+ *   producer, see CO_TIME_now_us(). Offset and skew of the local clock are
+ *   estimated from hardware timestamps of received TIME messages. CAN driver
+ *   must provide CO_CANrxMsg_readTimestamp() and CO_localTime_us() with the
+ *   same time base as SYNC timestamps (CO_CONFIG_SYNC_TIMESTAMP).
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received TIME CAN message.
  *   Callback is configured by CO_TIME_initCallbackPre().
@@ -446,6 +605,24 @@ extern "C" {
 #endif
 #define CO_CONFIG_TIME_ENABLE 0x01
 #define CO_CONFIG_TIME_PRODUCER 0x02
+#define CO_CONFIG_TIME_CLOCK 0x04
+
+/**
+ * Maximum difference between TIME message and local clock in microseconds,
+ * which is corrected smoothly, see CO_CONFIG_TIME_CLOCK. Larger differences
+ * are corrected with a step. Default is 100000.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TIME_CLOCK_STEP_US 100000
+#endif
+
+/**
+ * Maximum estimated skew between local clock and TIME producer in ppm, see
+ * CO_CONFIG_TIME_CLOCK. Default is 500.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TIME_CLOCK_MAX_SKEW_PPM 500
+#endif
 /** @} */ /* CO_STACK_CONFIG_TIME */
 
 
@@ -460,6 +637,12 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_SYNC_ENABLE - Enable SYNC object and SYNC consumer.
  * - CO_CONFIG_SYNC_PRODUCER - Enable SYNC producer.
+ * - CO_CONFIG_SYNC_TIMESTAMP - Enable timestamps of received and transmitted
+ *   SYNC messages, measured period, jitter histogram and phase offset in
+ *   @ref CO_SYNC_timing_t and callback directly after SYNC reception, which
+ *   may optionally take over synchronous PDOs, see CO_SYNC_initCallbackSync().
+ *   CAN driver must provide CO_CANrxMsg_readTimestamp() and call
+ *   CO_SYNC_txTimestamp().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SYNC CAN message.
  *   Callback is configured by CO_SYNC_initCallbackPre().
@@ -472,6 +655,22 @@ extern "C" {
 #endif
 #define CO_CONFIG_SYNC_ENABLE 0x01
 #define CO_CONFIG_SYNC_PRODUCER 0x02
+#define CO_CONFIG_SYNC_TIMESTAMP 0x04
+
+/**
+ * Number of bins in SYNC jitter histogram, see CO_CONFIG_SYNC_TIMESTAMP.
+ * Default is 8.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SYNC_JITTER_HIST_SIZE 8
+#endif
+
+/**
+ * Width of one bin in SYNC jitter histogram in microseconds. Default is 2.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SYNC_JITTER_HIST_STEP_US 2
+#endif
 
 /**
  * Configuration of @ref CO_PDO
@@ -489,6 +688,54 @@ extern "C" {
  *   flexibility for application program, but consumes some additional memory
  *   and processor resources. If this option is not enabled, then data from OD
  *   variables are fetched directly from memory allocated by Object dictionary.
+ * - CO_CONFIG_PDO_MAP_SEGMENTS - Used, if CO_CONFIG_PDO_OD_IO_ACCESS is not
+ *   enabled. Instead of one pointer for each PDO data byte, mapped OD
+ *   variables, which are located contiguously in memory, are joined into
+ *   segments and copied with memcpy(). See @ref CO_PDO_MAX_MAP_SEGMENTS.
+ * - CO_CONFIG_PDO_SCHEDULER - Enable PDO scheduler inside CO_process_RPDO()
+ *   and CO_process_TPDO(). Deadlines (timeouts, event and inhibit timers) of
+ *   PDOs are kept in @ref CO_CANopen_301_timerQueue, so time-driven
+ *   processing happens only for expired PDOs and exact timerNext_us is
+ *   calculated without searching. Other PDOs are processed only, if they have
+ *   pending event (received message, send request, SYNC, NMT state or
+ *   configuration change). CO_CONFIG_FLAG_TIMERNEXT and
+ *   CO_CONFIG_TIMERQ_ENABLE must be enabled.
+ * - CO_CONFIG_PDO_READY_LIST - Used with CO_CONFIG_PDO_SCHEDULER. Received
+ *   RPDOs are put into lock-free list of ready objects (see CO_readyList_t)
+ *   from CAN receive callback, so CO_process_RPDO() does not check all RPDOs
+ *   for received messages. All RPDOs are checked only on SYNC, NMT state or
+ *   configuration change. Heartbeat consumer uses own ready list with
+ *   CO_CONFIG_HB_CONS_INDEXED and SDO servers with
+ *   CO_CONFIG_SDO_SRV_READY_LIST. CO_process() still calls CO_EM_process()
+ *   for the single emergency object. SDO clients are processed by the
+ *   application.
+ * - CO_CONFIG_PDO_SYNC_BURST - Synchronous TPDOs, which are due on SYNC, are
+ *   first packed into a burst, sorted by CAN identifier, and then passed to
+ *   the CAN driver at once with CO_CANsendBurst() at the end of
+ *   CO_process_TPDO(). See CO_TPDO_burst_t.
+ * - CO_CONFIG_PDO_MAP_CACHE - CO_RPDO_init() and CO_TPDO_init() may take
+ *   PDO mapping parameters and positions of mapped OD entries from
+ *   CO_PDO_mapCache_t instead of reading and searching OD, see
+ *   CO_PDO_getMapCache() and CO_t::PDOmapCache.
+ * - CO_CONFIG_PDO_COLD_SPLIT - Configuration and mapping of PDOs
+ *   (CO_PDO_cold_t) is not stored inside CO_RPDO_t and CO_TPDO_t, but in
+ *   separate arrays CO_t::RPDOcold and CO_t::TPDOcold. Arrays of RPDO and TPDO
+ *   objects then contain only data, used on each cycle, so processing of many
+ *   PDOs touches fewer cache lines. With CO_USE_ARENA configuration is placed
+ *   outside of time critical objects.
+ * - CO_CONFIG_PDO_CHANGE_DETECT - Event driven TPDO, requested by
+ *   @ref OD_requestTPDO(), is sent only, if its data differs from the last
+ *   transmitted data. Comparison is made after the inhibit time, just before
+ *   transmission. Event timer and CO_TPDOsendRequest() send TPDO always. See
+ *   also @ref OD_writeOnChange(). Requires OD_FLAGS_PDO_SIZE > 0.
+ * - CO_CONFIG_PDO_SEQLOCK - Each PDO has a sequence lock, which gives
+ *   consistent access to its mapped variables from other threads without
+ *   blocking the real-time thread, see @ref CO_PDO_seqlock. Requires
+ *   CO_ATOMIC_CAS_U32() (GCC builtin by default).
+ * - CO_CONFIG_PDO_COPY_FUNCT - Enable application specific copy functions for
+ *   PDOs with mapping fixed at build time, see CO_RPDO_initCopyFunct() and
+ *   CO_TPDO_initCopyFunct(). Such function copies all mapped variables in one
+ *   step, instead of per-byte or per-mapped-object copy.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received RPDO CAN message.
  *   Callback is configured by CO_RPDO_initCallbackPre().
@@ -505,6 +752,15 @@ extern "C" {
 #define CO_CONFIG_TPDO_TIMERS_ENABLE 0x08
 #define CO_CONFIG_PDO_SYNC_ENABLE 0x10
 #define CO_CONFIG_PDO_OD_IO_ACCESS 0x20
+#define CO_CONFIG_PDO_COPY_FUNCT 0x40
+#define CO_CONFIG_PDO_MAP_SEGMENTS 0x80
+#define CO_CONFIG_PDO_SCHEDULER 0x100
+#define CO_CONFIG_PDO_READY_LIST 0x200
+#define CO_CONFIG_PDO_SYNC_BURST 0x400
+#define CO_CONFIG_PDO_MAP_CACHE 0x800
+#define CO_CONFIG_PDO_COLD_SPLIT 0x1000
+#define CO_CONFIG_PDO_CHANGE_DETECT 0x2000
+#define CO_CONFIG_PDO_SEQLOCK 0x4000
 /** @} */ /* CO_STACK_CONFIG_SYNC_PDO */
 
 
@@ -518,14 +774,83 @@ extern "C" {
  *
  * Possible flags, can be ORed:
  * - CO_CONFIG_STORAGE_ENABLE - Enable data storage
+ * - CO_CONFIG_STORAGE_AUTO_DIRTY - Automatic storage in eeprom updates only
+ *   pages, marked dirty by CO_storageEeprom_markDirty(), with page sized
+ *   CO_eeprom_writeBlock(), instead of comparing eeprom byte by byte.
+ *   CO_storage_entry_t must contain 'dirty' member.
+ * - CO_CONFIG_STORAGE_SNAPSHOT - Enable boot snapshot in eeprom storage, see
+ *   CO_storageEeprom_snapshot_t.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_STORAGE (CO_CONFIG_STORAGE_ENABLE)
 #endif
 #define CO_CONFIG_STORAGE_ENABLE 0x01
+#define CO_CONFIG_STORAGE_AUTO_DIRTY 0x02
+#define CO_CONFIG_STORAGE_SNAPSHOT 0x04
+
+/**
+ * Size of the eeprom page in bytes, used with CO_CONFIG_STORAGE_AUTO_DIRTY.
+ * Data written with one CO_eeprom_writeBlock() never crosses page boundary.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STORAGE_PAGE_SIZE 64
+#endif
+
+/**
+ * Programming unit of the flash in bytes, used with @ref CO_storage_flash.
+ * All flash records and CO_flash_program() blocks are aligned to it.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STORAGE_FLASH_ALIGN 8
+#endif
+
+/**
+ * Size of the buffer on stack in bytes, used with @ref CO_storage_flash for
+ * copying data into flash. It must be multiple of
+ * CO_CONFIG_STORAGE_FLASH_ALIGN.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STORAGE_FLASH_BUF_SIZE 64
+#endif
+
+/**
+ * Number of failed attempts of CO_storageFlash_process() to copy live records
+ * out of the oldest sector and erase it, until the next successful store.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STORAGE_FLASH_ERASE_RETRIES 3
+#endif
 /** @} */ /* CO_STACK_CONFIG_STORAGE */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_PRG_DOWNLOAD Program download
+ * Program download with CANopen OD objects 1F50 and 1F57, CiA 302-3
+ * @{
+ */
+/**
+ * Configuration of @ref CO_CANopen_302_prgDownload
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_PRG_DOWNLOAD_ENABLE - Enable program download. Also
+ *   CO_CONFIG_SDO_SRV_BLOCK_FLOW and CO_CONFIG_CRC16_ENABLE must be enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_PRG_DOWNLOAD (0)
+#endif
+#define CO_CONFIG_PRG_DOWNLOAD_ENABLE 0x01
+
+/**
+ * Size of each of the two program download buffers in bytes. It is the length
+ * of data programmed with one CO_prgFlash_program(). For efficient pipeline it
+ * should be at least the size of one SDO sub-block (127 * 7 bytes maximum).
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE 256
+#endif
+/** @} */ /* CO_STACK_CONFIG_PRG_DOWNLOAD */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_LEDS CANopen LED diodes
  * Specified in standard CiA 303-3
@@ -615,6 +940,10 @@ extern "C" {
  * - CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND - Send LSS fastscan respond
  *   directly from CO_LSSslave_receive() function.
  * - CO_CONFIG_LSS_MASTER - Enable LSS master
+ * - CO_CONFIG_LSS_MASTER_ASSIGN_ALL - Enable CO_LSSmaster_assignAll(), which
+ *   assigns node-IDs to all unconfigured nodes in one run. It reuses already
+ *   discovered parts of the LSS address and adapts fastscan step timeout to
+ *   the measured response latency. Also used by gateway 'lss_allnodes'.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received CAN message.
  *   Callback is configured by CO_LSSmaster_initCallbackPre().
@@ -625,9 +954,33 @@ extern "C" {
 #define CO_CONFIG_LSS_SLAVE 0x01
 #define CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND 0x02
 #define CO_CONFIG_LSS_MASTER 0x10
+#define CO_CONFIG_LSS_MASTER_ASSIGN_ALL 0x20
 /** @} */ /* CO_STACK_CONFIG_LSS */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_AUTOBAUD Bit rate detection
+ * Detection of CAN bit rate in silent mode before CO_CANinit()
+ * @{
+ */
+/**
+ * Configuration of @ref CO_autobaud
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_AUTOBAUD_ENABLE - Enable bit rate detection.
+ * - CO_CONFIG_AUTOBAUD_MEASURE - CAN driver measures bit time on the bus,
+ *   CO_autobaud_bitTime_ns() must be defined by target system.
+ * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
+ *   inside CO_autobaud_process().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_AUTOBAUD (0)
+#endif
+#define CO_CONFIG_AUTOBAUD_ENABLE 0x01
+#define CO_CONFIG_AUTOBAUD_MEASURE 0x02
+/** @} */ /* CO_STACK_CONFIG_AUTOBAUD */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_GATEWAY CANopen gateway
  * Specified in standard CiA 309
@@ -642,7 +995,9 @@ extern "C" {
  *
  * Possible flags, can be ORed:
  * - CO_CONFIG_GTW_MULTI_NET - Enable multiple network interfaces in gateway
- *   device. This functionality is currently not implemented.
+ *   device. Commands are routed to one gateway object per CANopen network by
+ *   @ref CO_CANopen_309_3_Router. If set, then CO_CONFIG_GTW_ASCII must also
+ *   be set.
  * - CO_CONFIG_GTW_ASCII - Enable gateway device with ASCII mapping (CiA 309-3)
  *   If set, then CO_CONFIG_FIFO_ASCII_COMMANDS must also be set.
  * - CO_CONFIG_GTW_ASCII_SDO - Enable SDO client. If set, then
@@ -656,6 +1011,18 @@ extern "C" {
  *   help usage.
  * - CO_CONFIG_GTW_ASCII_PRINT_LEDS - Display "red" and "green" CANopen status
  *   LED diodes on terminal.
+ * - CO_CONFIG_GTW_ASCII_ASYNC - Execute SDO 'read' and 'write' commands with
+ *   fixed size data types on @ref CO_SDOclientPool, see CO_GTWA_initAsync().
+ *   Gateway then accepts next commands while SDO transfers are in progress
+ *   and responses are printed in order of completion. If set, then
+ *   CO_CONFIG_GTW_ASCII_SDO and CO_CONFIG_SDO_CLI_POOL must also be set.
+ * - CO_CONFIG_GTW_BINARY - Enable @ref CO_CANopen_309_3_Binary, written with
+ *   CO_GTWA_writeBinary(). It shares SDO client and NMT master with the ASCII
+ *   commands. If set, then CO_CONFIG_GTW_ASCII must also be set.
+ * - CO_CONFIG_GTW_ASCII_SUBSCRIBE - Enable non-standard commands 'subscribe'
+ *   and 'unsubscribe'. Gateway then prints rate-limited notifications about
+ *   received CAN frames, changed local OD variables or heartbeat states of
+ *   remote nodes, see CO_GTWA_initSubscribe().
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GTW (0)
@@ -669,6 +1036,9 @@ extern "C" {
 #define CO_CONFIG_GTW_ASCII_ERROR_DESC 0x40
 #define CO_CONFIG_GTW_ASCII_PRINT_HELP 0x80
 #define CO_CONFIG_GTW_ASCII_PRINT_LEDS 0x100
+#define CO_CONFIG_GTW_ASCII_ASYNC 0x200
+#define CO_CONFIG_GTW_BINARY 0x400
+#define CO_CONFIG_GTW_ASCII_SUBSCRIBE 0x800
 
 /**
  * Number of loops of #CO_SDOclientDownload() in case of block download
@@ -697,6 +1067,77 @@ extern "C" {
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GTWA_LOG_BUF_SIZE 2000
 #endif
+
+/**
+ * Maximum number of SDO commands in progress in ASCII gateway object.
+ *
+ * Valid if CO_CONFIG_GTW_ASCII_ASYNC is enabled. If all are in use, next
+ * command waits in the command buffer.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_ASYNC_COUNT 8
+#endif
+
+/**
+ * Size of binary command buffer in gateway object.
+ *
+ * Valid if CO_CONFIG_GTW_BINARY is enabled. Data of SDO download need not fit
+ * into the buffer, it may be refilled during the transfer.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_BIN_BUF_SIZE 200
+#endif
+
+/**
+ * Maximum number of subscriptions in ASCII gateway object.
+ *
+ * Valid if CO_CONFIG_GTW_ASCII_SUBSCRIBE is enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_SUB_COUNT 8
+#endif
+
+/**
+ * Number of CAN receive buffers reserved for 'subscribe pdo' commands.
+ *
+ * Valid if CO_CONFIG_GTW_ASCII_SUBSCRIBE is enabled. Each subscription to
+ * COB-ID uses own CAN receive buffer. May be 0, if only OD variables and
+ * heartbeat states are subscribed.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_SUB_CAN_COUNT 4
+#endif
+
+/**
+ * Range of valid CANopen network numbers in gateway.
+ *
+ * Valid if CO_CONFIG_GTW_MULTI_NET is enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTW_NET_MIN 1
+#define CO_CONFIG_GTW_NET_MAX 127
+#endif
+
+/**
+ * Maximum number of CANopen networks in gateway router.
+ *
+ * Valid if CO_CONFIG_GTW_MULTI_NET is enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWR_NET_COUNT 4
+#endif
+
+/**
+ * Size of command and response buffer of each network in gateway router.
+ *
+ * Valid if CO_CONFIG_GTW_MULTI_NET is enabled. Buffers pass commands and
+ * responses between the router and the network threads. Long responses are
+ * transferred in parts.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWR_CMD_BUF_SIZE 200
+#define CO_CONFIG_GTWR_RESP_BUF_SIZE 400
+#endif
 /** @} */ /* CO_STACK_CONFIG_GATEWAY */
 
 
@@ -710,13 +1151,23 @@ extern "C" {
  *
  * Possible flags, can be ORed:
  * - CO_CONFIG_CRC16_ENABLE - Enable CRC16 calculation
- * - CO_CONFIG_CRC16_EXTERNAL - CRC functions are defined externally
+ * - CO_CONFIG_CRC16_EXTERNAL - CRC functions are defined externally. This
+ *   is a hook for CRC peripherals of microcontrollers or for host specific
+ *   implementations (carry-less multiply, for example). Application must then
+ *   provide crc16_ccitt_single() and crc16_ccitt() with the same results.
+ * - CO_CONFIG_CRC16_SLICE_BY_4 - crc16_ccitt() processes four bytes per loop
+ *   pass with slice-by-4 algorithm. It uses additional 1.5kB of tables.
+ * - CO_CONFIG_CRC16_SLICE_BY_8 - crc16_ccitt() processes eight bytes per loop
+ *   pass with slice-by-8 algorithm. It uses additional 3.5kB of tables.
+ *   Overrides CO_CONFIG_CRC16_SLICE_BY_4.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_CRC16 (0)
 #endif
 #define CO_CONFIG_CRC16_ENABLE 0x01
 #define CO_CONFIG_CRC16_EXTERNAL 0x02
+#define CO_CONFIG_CRC16_SLICE_BY_4 0x04
+#define CO_CONFIG_CRC16_SLICE_BY_8 0x08
 /** @} */ /* CO_STACK_CONFIG_CRC16 */
 
 
@@ -757,6 +1208,109 @@ extern "C" {
 /** @} */ /* CO_STACK_CONFIG_FIFO */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_TIMERQ Timer queue
+ * Helper object for timer queue
+ * @{
+ */
+/**
+ * Configuration of @ref CO_CANopen_301_timerQueue
+ *
+ * Timer queue keeps deadlines of many objects sorted, so the next expired
+ * object and time to the next deadline are available without searching. It is
+ * used by the PDO scheduler, see CO_CONFIG_PDO_SCHEDULER, and by the Node
+ * guarding master, see CO_CONFIG_NODE_GUARDING_MASTER_SCHEDULER.
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_TIMERQ_ENABLE - Enable timer queue
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TIMERQ (0)
+#endif
+#define CO_CONFIG_TIMERQ_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_TIMERQ */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_STATS Statistics
+ * Processing time and event counters of the hot path
+ * @{
+ */
+/**
+ * Configuration of @ref CO_CANopen_301_stats
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_STATS_ENABLE - Enable statistics. Execution time of
+ *   CO_process(), CO_process_SYNC(), CO_process_RPDO(), CO_process_TPDO() and
+ *   latency from SYNC to the end of CO_process_TPDO() are measured with
+ *   CO_cycleCounter(), which must be provided by the target. CAN overflows,
+ *   overwritten RPDOs and maximum number of pending CAN transmit messages are
+ *   counted. Statistics are available in CO_t::stats and in the optional OD
+ *   object @ref OD_INDEX_STATS. CAN driver may also measure CANrx_callback, if
+ *   it defines CO_DRIVER_STATS.
+ * - CO_CONFIG_STATS_BUSLOAD - Enable bus load meter. CAN driver, which
+ *   defines CO_DRIVER_STATS, reports each frame on the bus. Bus load per
+ *   window, its histogram and counters of frames per traffic class are
+ *   calculated.
+ * - CO_CONFIG_STATS_TX_LIMIT - Enable token bucket limiter, which holds back
+ *   non real-time frames (SDO, emergency, LSS), if total bus load would exceed
+ *   the ceiling. Requires CO_CONFIG_STATS_BUSLOAD and support in CAN driver.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS (0)
+#endif
+#define CO_CONFIG_STATS_ENABLE 0x01
+#define CO_CONFIG_STATS_BUSLOAD 0x02
+#define CO_CONFIG_STATS_TX_LIMIT 0x04
+
+/**
+ * Number of histogram bins for each measured stage.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_HIST_BINS 16
+#endif
+
+/**
+ * Upper limit of the first histogram bin is 2^CO_CONFIG_STATS_HIST_SHIFT
+ * counts of CO_cycleCounter(). Each next bin doubles the limit.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_HIST_SHIFT 4
+#endif
+
+/**
+ * Length of the bus load window in milliseconds.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_BUSLOAD_WINDOW_MS 100
+#endif
+
+/**
+ * Number of bus load histogram bins, each covers 1000 /
+ * CO_CONFIG_STATS_BUSLOAD_BINS permille.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_BUSLOAD_BINS 10
+#endif
+
+/**
+ * Initial ceiling of the transmit limiter in permille of the bit rate. 0
+ * disables limiter, until ceiling is written to the Object Dictionary.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_TX_LIMIT_CEILING 0
+#endif
+
+/**
+ * Size of the transmit limiter token bucket in bits. Non real-time frames are
+ * allowed in bursts up to this size.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_TX_LIMIT_BURST 1500
+#endif
+/** @} */ /* CO_STACK_CONFIG_STATS */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_TRACE Trace recorder
  * Non standard object
@@ -766,18 +1320,61 @@ extern "C" {
  * Configuration of @ref CO_trace for recording variables over time.
  *
  * Possible flags, can be ORed:
- * - CO_CONFIG_TRACE_ENABLE - Enable Trace recorder
- * - CO_CONFIG_TRACE_OWN_INTTYPES - If set, then macros PRIu32("u" or "lu")
- *   and PRId32("d" or "ld") must be set. (File inttypes.h can not be included).
+ * - CO_CONFIG_TRACE_ENABLE - Enable Trace recorder. CO_CONFIG_FIFO_ENABLE must
+ *   also be set.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_TRACE (0)
 #endif
 #define CO_CONFIG_TRACE_ENABLE 0x01
-#define CO_CONFIG_TRACE_OWN_INTTYPES 0x02
+
+/**
+ * Maximum number of variables, recorded by one trace object.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TRACE_CHANNELS 16
+#endif
+
+/**
+ * Size of circular buffer for records of one trace object in bytes.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TRACE_BUFFER_SIZE 1024
+#endif
 /** @} */ /* CO_STACK_CONFIG_TRACE */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_EVLOOP Event loop
+ * Tickless processing of the stack, non standard
+ * @{
+ */
+/**
+ * Configuration of @ref CO_eventLoop.
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_EVLOOP_ENABLE - Enable event loop, which processes all CANopen
+ *   objects in one thread, sleeps until the next deadline from timerNext_us
+ *   and is woken up by CO_CONFIG_FLAG_CALLBACK_PRE callbacks.
+ * - CO_CONFIG_EVLOOP_LINUX - Enable Linux implementation with epoll, eventfd
+ *   and timerfd, see CO_eventLoop_wait().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EVLOOP (0)
+#endif
+#define CO_CONFIG_EVLOOP_ENABLE 0x01
+#define CO_CONFIG_EVLOOP_LINUX 0x02
+
+/**
+ * Maximum sleep time of the event loop in microseconds. It limits delay of
+ * objects, which don't calculate timerNext_us.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EVLOOP_MAX_SLEEP_US 100000
+#endif
+/** @} */ /* CO_STACK_CONFIG_EVLOOP */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_DEBUG Debug messages
  * Messages from different parts of the stack.
@@ -27,8 +27,57 @@
 #define CO_DRIVER_H
 
 #include <string.h>
+#include <stdint.h>
 
 #include "CO_config.h"
+
+/**
+ * Maximum number of CO_CANtx_t buffers, which can be managed by
+ * @ref CO_CANtxQueue_t. Must be multiple of 32 and not larger than 1024.
+ * Default may be overridden by compiler option.
+ */
+#ifndef CO_CAN_TX_QUEUE_SIZE
+#define CO_CAN_TX_QUEUE_SIZE 128
+#endif
+
+/**
+ * Priority queue of pending CAN transmit buffers, optional for the driver.
+ *
+ * Defined here (before CO_driver_target.h), so it can be included inside
+ * CO_CANmodule_t. Queue is keyed by index of CO_CANtx_t buffer in _txArray_.
+ * Lower index means higher priority (CANopenNode allocates _txArray_ in order
+ * of CAN-ID priority). One bit is used for each buffer and one summary bit for
+ * each 32-bit word, so CO_CANtxQueue_pop() needs only two count-leading-zeros
+ * operations, independent of number of buffers. See @ref CO_CANtxQueue_init()
+ * and related functions.
+ */
+typedef struct {
+    uint32_t summary; /**< Bit (31 - n) is set, if words[n] is not zero */
+    uint32_t words[CO_CAN_TX_QUEUE_SIZE / 32]; /**< Bit (31 - (i % 32)) in
+            words[i / 32] is set, if buffer with index i is pending */
+} CO_CANtxQueue_t;
+
+/**
+ * Maximum number of data bytes in CAN message.
+ *
+ * It is 8 for classical CAN. If CO_CAN_FD is defined (as compiler option, it
+ * must be known before CO_driver_target.h), it is 64 for CAN FD. Driver should
+ * use it for size of data arrays in CO_CANrxMsg_t and CO_CANtx_t. Length of
+ * CAN FD message is one of 0..8, 12, 16, 20, 24, 32, 48 or 64 bytes, see
+ * CO_CANlengthToDlc() and CO_CANdlcToLength().
+ *
+ * With CAN FD, PDO may contain up to 64 bytes, see CO_PDO_MAX_SIZE. Other
+ * objects (SDO, SRDO, ...) still use classical CAN frames, which are also
+ * valid CAN FD frames.
+ */
+#ifndef CO_CAN_DATA_MAX
+ #ifdef CO_CAN_FD
+  #define CO_CAN_DATA_MAX 64
+ #else
+  #define CO_CAN_DATA_MAX 8
+ #endif
+#endif
+
 #include "CO_driver_target.h"
 
 #ifdef __cplusplus
@@ -231,7 +280,8 @@ static inline uint16_t CO_CANrxMsg_readIdent(void *rxMsg) {
  * See also CO_CANrxMsg_readIdent():
  *
  * @param rxMsg Pointer to received message
- * @return data length in bytes (0 to 8)
+ * @return data length in bytes (0 to 8, or to 64 with CO_CAN_FD). Driver
+ * converts data length code with CO_CANdlcToLength().
  */
 static inline uint8_t CO_CANrxMsg_readDLC(void *rxMsg) {
     return 0;
@@ -249,6 +299,60 @@ static inline uint8_t *CO_CANrxMsg_readData(void *rxMsg) {
     return NULL;
 }
 
+/**
+ * CANrx_callback() can read reception timestamp from received CAN message
+ *
+ * Required with CO_CONFIG_SYNC_TIMESTAMP. Timestamp should be captured by CAN
+ * hardware (or as early as possible in the receive interrupt) from a free
+ * running microsecond counter. Counter may overflow.
+ *
+ * See also CO_CANrxMsg_readIdent():
+ *
+ * @param rxMsg Pointer to received message
+ * @return reception time in microseconds
+ */
+static inline uint32_t CO_CANrxMsg_readTimestamp(void *rxMsg) {
+    return 0;
+}
+
+/**
+ * Read free running microsecond counter
+ *
+ * Required with CO_CONFIG_TIME_CLOCK. Must use the same time base as
+ * CO_CANrxMsg_readTimestamp() and must be callable from any thread.
+ *
+ * @return current local time in microseconds
+ */
+static inline uint32_t CO_localTime_us(void) {
+    return 0;
+}
+
+/**
+ * Read free running counter for processing time measurement
+ *
+ * Required with CO_CONFIG_STATS_ENABLE. Fast counter, preferably CPU cycle
+ * counter, it may overflow. Units are target specific. Must be callable from
+ * any thread, including CAN interrupt.
+ *
+ * @return current value of the counter
+ */
+static inline uint32_t CO_cycleCounter(void) {
+    return 0;
+}
+
+/**
+ * Received CAN message, as copied from CAN module, optional.
+ *
+ * May be defined in the **CO_driver_target.h** file, if driver stores received
+ * messages (for example in the receive ring, see CO_CANmodule_processRx()).
+ * Pointer to it is passed to CANrx_callback().
+ */
+typedef struct {
+    uint32_t ident;  /**< CAN identifier, as read from CAN module */
+    uint8_t DLC;     /**< Data length code */
+    uint8_t data[CO_CAN_DATA_MAX]; /**< Message data */
+} CO_CANrxMsg_t;
+
 /**
  * Configuration object for CAN received message for specific \ref CO_obj
  * "CANopenNode Object".
@@ -305,7 +409,7 @@ typedef struct {
 typedef struct {
     uint32_t ident;             /**< CAN identifier as aligned in CAN module */
     uint8_t DLC;                /**< Length of CAN message */
-    uint8_t data[8];            /**< 8 data bytes */
+    uint8_t data[CO_CAN_DATA_MAX]; /**< 8 (or 64 for CAN FD) data bytes */
     volatile bool_t bufferFull; /**< True if previous message is still in the
                                      buffer */
     volatile bool_t syncFlag;   /**< Synchronous PDO messages has this flag set.
@@ -344,6 +448,38 @@ typedef struct {
     volatile uint16_t CANtxCount;      /**< Number of messages in transmit
             buffer, which are waiting to be copied to the CAN module */
     uint32_t errOld;                   /**< Previous state of CAN errors */
+    /** Optional, if CO_DRIVER_RX_LOOKUP is defined. Direct lookup table with
+     * one entry for each 11-bit CAN identifier. Entry contains (index + 1)
+     * of the CO_CANrx_t buffer in _rxArray_ with the lowest index, which
+     * accepts that identifier, or 0 if there is none. Table is maintained by
+     * CO_CANrxBufferInit() and is used by CAN receive interrupt, when
+     * _useCANrxFilters_ is false. So matching of the received message takes
+     * constant time instead of linear search through the _rxArray_. */
+    uint16_t rxLookup[0x800];
+    /** Optional, if CO_DRIVER_RX_FILTER_PLAN is defined. Index of CO_CANrx_t
+     * buffer in _rxArray_ for each filter match index of the CAN hardware, or
+     * CO_CAN_FILTER_SOFTWARE for merged filters, which need software matching.
+     * Hardware filters are planned with CO_CANfilter_plan() from all
+     * configured buffers, see @ref CO_CANfilter. */
+    uint16_t rxFilterMap[56];
+    /** Optional, if CO_DRIVER_TX_QUEUE is defined. Priority queue of
+     * CO_CANtx_t buffers with _bufferFull_ set. CAN transmit interrupt takes
+     * buffers with CO_CANtxQueue_pop() in constant time and may fill multiple
+     * hardware transmit mailboxes at once. */
+    CO_CANtxQueue_t txQueue;
+    /** Optional, if CO_DRIVER_RX_RING is defined. Single producer, single
+     * consumer ring of received CAN messages. CAN receive interrupt only copies
+     * messages into the ring and CO_CANmodule_processRx() calls CANrx_callback
+     * functions later. Size is power of 2. */
+    CO_CANrxMsg_t rxRing[64];
+    volatile uint16_t rxRingWr; /**< Write index into rxRing, used by interrupt */
+    volatile uint16_t rxRingRd; /**< Read index into rxRing, used by
+            CO_CANmodule_processRx() */
+    /** Optional, if CO_DRIVER_STATS is defined. Pointer to CO_stats_t object,
+     * set by CO_stats_init(), or NULL. Driver uses it with
+     * CO_STATS_CAN_RX_BEGIN() and CO_STATS_CAN_RX_END() around CANrx_callback
+     * to measure its execution time. */
+    void *stats;
 } CO_CANmodule_t;
 
 
@@ -354,8 +490,8 @@ typedef struct {
  *
  * For more information on Data storage see @ref CO_storage or **CO_storage.h**
  * file. Structure members documented here are always required or required with
- * @ref CO_storage_eeprom. Target system may add own additional, hardware
- * specific variables.
+ * @ref CO_storage_eeprom or @ref CO_storage_flash. Target system may add own
+ * additional, hardware specific variables.
  */
 typedef struct {
     /** Address of data to store, always required. */
@@ -373,7 +509,7 @@ typedef struct {
      * @ref CO_storage_eeprom. */
     void *storageModule;
     /** CRC checksum of the data stored in eeprom, set on store, required with
-     * @ref CO_storage_eeprom. */
+     * @ref CO_storage_eeprom or @ref CO_storage_flash. */
     uint16_t crc;
     /** Address of entry signature inside eeprom, set by init, required with
      * @ref CO_storage_eeprom. */
@@ -384,6 +520,16 @@ typedef struct {
     /** Offset of next byte being updated by automatic storage, required with
      * @ref CO_storage_eeprom. */
     size_t offset;
+    /** Bit mask of eeprom pages (or groups of pages) of automatic storage
+     * data, which were changed and are not yet updated in eeprom. Required
+     * with @ref CO_storage_eeprom and CO_CONFIG_STORAGE_AUTO_DIRTY. */
+    uint32_t dirty;
+    /** Pointer to @ref CO_storageFlash_t object, set by init, required with
+     * @ref CO_storage_flash. */
+    void *flashLog;
+    /** Address of the newest record inside flash or (size_t)-1, set by init
+     * and store, required with @ref CO_storage_flash. */
+    size_t flashAddr;
     /** Additional target specific parameters, optional. */
     void *additionalParameters;
 } CO_storage_entry_t;
@@ -409,6 +555,9 @@ typedef struct {
  * Either by disabling scheduler or interrupts or by mutexes or semaphores.
  * Lock/unlock macro is called with pointer to CAN module, which may be used
  * inside.
+ * With CO_SEPARATE_RT_CAN (see CANopen.h) real-time objects (SYNC, PDO, ...)
+ * use own CAN module, so lock per CAN module is enough for CO_CANsend(). Then
+ * real-time thread does not block on messages sent from mainline thread.
  *
  * #### Object Dictionary variables
  * In general, there are two threads, which accesses OD variables: mainline
@@ -457,6 +606,32 @@ typedef struct {
 /** Unock critical section when accessing Object Dictionary */
 #define CO_UNLOCK_OD(CAN_MODULE)
 
+/**
+ * Atomic operations on uint8_t variables, used with CO_CONFIG_EM_ATOMIC.
+ *
+ * CO_ATOMIC_FETCH_OR_U8() and CO_ATOMIC_FETCH_AND_U8() return value of the
+ * variable before the operation. CO_ATOMIC_CAS_U8() stores desired value, if
+ * variable is equal to expected and returns true on success. Macros must be
+ * safe against all interrupts and threads, which call CO_errorReport().
+ * If not defined by the port, GCC `__sync` builtins are used.
+ */
+#define CO_ATOMIC_FETCH_OR_U8(ptr, value) \
+    __sync_fetch_and_or((ptr), (value))
+/** See CO_ATOMIC_FETCH_OR_U8() */
+#define CO_ATOMIC_FETCH_AND_U8(ptr, value) \
+    __sync_fetch_and_and((ptr), (value))
+/** See CO_ATOMIC_FETCH_OR_U8() */
+#define CO_ATOMIC_CAS_U8(ptr, expected, desired) \
+    __sync_bool_compare_and_swap((ptr), (expected), (desired))
+
+/**
+ * Atomic compare and swap on uint32_t variable, used with
+ * CO_CONFIG_PDO_SEQLOCK. Same as CO_ATOMIC_CAS_U8(), it must also be a full
+ * memory barrier.
+ */
+#define CO_ATOMIC_CAS_U32(ptr, expected, desired) \
+    __sync_bool_compare_and_swap((ptr), (expected), (desired))
+
 /** Check if new message has arrived */
 #define CO_FLAG_READ(rxNew) ((rxNew) != NULL)
 /** Set new message flag */
@@ -575,6 +750,61 @@ typedef enum {
 } CO_ReturnError_t;
 
 
+/**
+ * Get data length from 4-bit data length code of CAN message.
+ *
+ * For classical CAN (without CO_CAN_FD) codes 9..15 mean 8 bytes.
+ *
+ * @param dlc Data length code, 0..15.
+ *
+ * @return Number of data bytes.
+ */
+static inline uint8_t CO_CANdlcToLength(uint8_t dlc) {
+#ifdef CO_CAN_FD
+    static const uint8_t lengths[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8,
+                                        12, 16, 20, 24, 32, 48, 64};
+    return lengths[dlc & 0x0FU];
+#else
+    return (dlc > 8U) ? 8U : dlc;
+#endif
+}
+
+/**
+ * Get 4-bit data length code for data length.
+ *
+ * If CAN FD frame can not have length bytes, data length code for the next
+ * longer frame is returned. Driver transmits such frame with padding bytes.
+ *
+ * @param length Number of data bytes, 0..CO_CAN_DATA_MAX.
+ *
+ * @return Data length code, 0..15.
+ */
+static inline uint8_t CO_CANlengthToDlc(uint8_t length) {
+    if (length <= 8U) {
+        return length;
+    }
+#ifdef CO_CAN_FD
+    if (length <= 24U) {
+        return (uint8_t)(9U + ((length - 9U) / 4U));
+    }
+    return (length <= 32U) ? 13U : ((length <= 48U) ? 14U : 15U);
+#else
+    return 8U;
+#endif
+}
+
+/**
+ * Get length of the shortest CAN frame, which can contain length bytes.
+ *
+ * @param length Number of data bytes, 0..CO_CAN_DATA_MAX.
+ *
+ * @return Length of padded CAN frame, equal to length for classical CAN.
+ */
+static inline uint8_t CO_CANpaddedLength(uint8_t length) {
+    return CO_CANdlcToLength(CO_CANlengthToDlc(length));
+}
+
+
 /**
  * Request CAN configuration (stopped) mode and *wait* until it is set.
  *
@@ -672,12 +902,13 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule,
  * @param index Index of the specific buffer in _txArray_.
  * @param ident 11-bit standard CAN Identifier.
  * @param rtr If true, 'Remote Transmit Request' messages will be transmitted.
- * @param noOfBytes Length of CAN message in bytes (0 to 8 bytes).
+ * @param noOfBytes Length of CAN message in bytes (0 to 8 bytes or to 64 bytes
+ * with CO_CAN_FD). Driver transmits CO_CANlengthToDlc(noOfBytes).
  * @param syncFlag This flag bit is used for synchronous TPDO messages. If it is
  * set, message will not be sent, if current time is outside synchronous window.
  *
- * @return Pointer to CAN transmit message buffer. 8 bytes data array inside
- * buffer should be written, before CO_CANsend() function is called.
+ * @return Pointer to CAN transmit message buffer. Data array inside buffer
+ * should be written, before CO_CANsend() function is called.
  * Zero is returned in case of wrong arguments.
  */
 CO_CANtx_t *CO_CANtxBufferInit(CO_CANmodule_t *CANmodule,
@@ -701,6 +932,31 @@ CO_CANtx_t *CO_CANtxBufferInit(CO_CANmodule_t *CANmodule,
 CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer);
 
 
+#ifdef CO_DOXYGEN
+/**
+ * Send multiple CAN messages at once, optional.
+ *
+ * Used with CO_CONFIG_PDO_SYNC_BURST for synchronous TPDOs. Driver should copy
+ * all messages into CAN module (or its transmit queue) in one critical
+ * section, in given order. Buffers are sorted by CAN identifier, highest
+ * priority first.
+ *
+ * May be defined as a macro in the **CO_driver_target.h** file. If not defined,
+ * CO_CANsend() is called for each buffer.
+ *
+ * @param CANmodule This object.
+ * @param buffers Array of pointers to transmit buffers, with data written.
+ * @param count Number of elements in buffers.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or first error from transmission of
+ * the buffers, same as CO_CANsend().
+ */
+CO_ReturnError_t CO_CANsendBurst(CO_CANmodule_t *CANmodule,
+                                 CO_CANtx_t *buffers[],
+                                 uint16_t count);
+#endif
+
+
 /**
  * Clear all synchronous TPDOs from CAN module transmit buffers.
  *
@@ -729,6 +985,231 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule);
 void CO_CANmodule_process(CO_CANmodule_t *CANmodule);
 
 
+/**
+ * Process received CAN messages from the receive ring, optional.
+ *
+ * Used, if CAN driver defers processing of received messages (for example
+ * CO_DRIVER_RX_RING in example driver). CAN receive interrupt then only copies
+ * messages (whole hardware FIFO) into the lock-free ring and this function
+ * calls CANrx_callback for each of them. Order of messages is preserved.
+ * Messages received during execution of this function are processed in the
+ * next call.
+ *
+ * Function must be called cyclically from the real-time thread, before
+ * CO_process_SYNC() and CO_process_RPDO(), inside CO_LOCK_OD section. If ring
+ * is full, message is dropped and CO_CAN_ERRRX_OVERFLOW is set.
+ *
+ * Note: CANopen objects still keep single received message buffer each. For
+ * example, if the same RPDO is received twice inside one batch, the second
+ * overwrites the first. Application may call this function and
+ * CO_process_RPDO() alternately, if required.
+ *
+ * @param CANmodule This object.
+ *
+ * @return Number of processed messages.
+ */
+uint16_t CO_CANmodule_processRx(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Count leading zeros of 32-bit value.
+ *
+ * Builtin is used on unsigned long, which has at least 32 bits, also on C2000,
+ * where int has 16 bits. Portable version is used for C2000 compiler.
+ *
+ * @param value Value, must not be zero.
+ *
+ * @return Number of leading zero bits, 0 to 31.
+ */
+static inline uint8_t CO_clz32(uint32_t value) {
+#if (defined(__GNUC__) || defined(__clang__)) && (C2000_PORT == 0)
+    return (uint8_t)(__builtin_clzl((unsigned long)value)
+                     - ((sizeof(unsigned long) * 8U) - 32U));
+#else
+    uint8_t n = 0;
+    if ((value & 0xFFFF0000UL) == 0U) { n += 16; value <<= 16; }
+    if ((value & 0xFF000000UL) == 0U) { n += 8; value <<= 8; }
+    if ((value & 0xF0000000UL) == 0U) { n += 4; value <<= 4; }
+    if ((value & 0xC0000000UL) == 0U) { n += 2; value <<= 2; }
+    if ((value & 0x80000000UL) == 0U) { n += 1; }
+    return n;
+#endif
+}
+
+/** Returned from CO_CANtxQueue_pop(), if queue is empty */
+#define CO_CAN_TX_QUEUE_EMPTY 0xFFFFU
+
+/**
+ * Initialize (clear) CAN transmit priority queue.
+ *
+ * @param q This object.
+ */
+static inline void CO_CANtxQueue_init(CO_CANtxQueue_t *q) {
+    memset(q, 0, sizeof(CO_CANtxQueue_t));
+}
+
+/**
+ * Check, if CAN transmit priority queue is empty.
+ *
+ * @param q This object.
+ *
+ * @return true, if there are no pending buffers.
+ */
+static inline bool_t CO_CANtxQueue_isEmpty(const CO_CANtxQueue_t *q) {
+    return q->summary == 0U;
+}
+
+/**
+ * Mark transmit buffer as pending.
+ *
+ * Function must be protected by CO_LOCK_CAN_SEND(), if CAN interrupt can
+ * modify the queue.
+ *
+ * @param q This object.
+ * @param index Index of CO_CANtx_t buffer in _txArray_, less than
+ * CO_CAN_TX_QUEUE_SIZE. Repeated push of the same index has no effect.
+ */
+static inline void CO_CANtxQueue_push(CO_CANtxQueue_t *q, uint16_t index) {
+    uint16_t w = index >> 5;
+    q->words[w] |= 0x80000000UL >> (index & 0x1FU);
+    q->summary |= 0x80000000UL >> w;
+}
+
+/**
+ * Remove transmit buffer from the queue, if pending.
+ *
+ * @param q This object.
+ * @param index Index of CO_CANtx_t buffer in _txArray_.
+ */
+static inline void CO_CANtxQueue_remove(CO_CANtxQueue_t *q, uint16_t index) {
+    uint16_t w = index >> 5;
+    q->words[w] &= ~(0x80000000UL >> (index & 0x1FU));
+    if (q->words[w] == 0U) {
+        q->summary &= ~(0x80000000UL >> w);
+    }
+}
+
+/**
+ * Get and remove pending transmit buffer with the highest priority (lowest
+ * index) from the queue. Execution time is constant.
+ *
+ * @param q This object.
+ *
+ * @return Index of CO_CANtx_t buffer in _txArray_ or CO_CAN_TX_QUEUE_EMPTY.
+ */
+static inline uint16_t CO_CANtxQueue_pop(CO_CANtxQueue_t *q) {
+    uint16_t w, index;
+
+    if (q->summary == 0U) {
+        return CO_CAN_TX_QUEUE_EMPTY;
+    }
+    w = CO_clz32(q->summary);
+    index = (uint16_t)(w << 5) + CO_clz32(q->words[w]);
+    CO_CANtxQueue_remove(q, index);
+    return index;
+}
+
+
+/** Returned from CO_readyList_pop(), if list is empty */
+#define CO_READY_LIST_EMPTY 0xFFFFU
+
+/**
+ * List of objects, which are ready for processing.
+ *
+ * Lock-free single producer, single consumer queue of object ids. It is used
+ * by CANopen objects, which are processed from many instances (for example
+ * RPDOs), so processing function does not need to scan all of them. Producer
+ * is CANrx_callback, which calls CO_readyList_push(). All CANrx_callbacks of
+ * the objects in the same list must run from the same context (the same CAN
+ * receive interrupt or CO_CANmodule_processRx()). Consumer is processing
+ * function, which calls CO_readyList_pop().
+ *
+ * Each object is inside the list at most once, so list can not overflow.
+ */
+typedef struct {
+    uint16_t *ring; /**< Ids of ready objects, array of ringSize elements */
+    volatile uint8_t *queued; /**< Set for each object, which is inside ring */
+    uint16_t ringSize; /**< Number of objects + 1 */
+    volatile uint16_t wr; /**< Write index, written by producer only */
+    volatile uint16_t rd; /**< Read index, written by consumer only */
+    /** Set from mainline inside CO_LOCK_OD section, if processing function
+     * should check all objects (configuration change, for example). Read and
+     * cleared by consumer inside the same lock. */
+    volatile bool_t checkAll;
+} CO_readyList_t;
+
+/**
+ * Initialize list of ready objects.
+ *
+ * @param rl This object.
+ * @param ring Array of (count + 1) elements.
+ * @param queued Array of count elements.
+ * @param count Number of objects, ids are from 0 to count - 1.
+ */
+static inline void CO_readyList_init(CO_readyList_t *rl, uint16_t ring[],
+                                     uint8_t queued[], uint16_t count)
+{
+    rl->ring = ring;
+    rl->queued = queued;
+    rl->ringSize = count + 1U;
+    rl->wr = 0;
+    rl->rd = 0;
+    rl->checkAll = true;
+    memset(queued, 0, count);
+}
+
+/**
+ * Add object to the list of ready objects. Called by producer.
+ *
+ * @param rl This object.
+ * @param id Id of the object. If already inside the list, there is no effect.
+ */
+static inline void CO_readyList_push(CO_readyList_t *rl, uint16_t id) {
+    if (rl->queued[id] == 0U) {
+        uint16_t wr = rl->wr;
+
+        rl->queued[id] = 1;
+        rl->ring[wr] = id;
+        wr++;
+        if (wr >= rl->ringSize) {
+            wr = 0;
+        }
+        CO_MemoryBarrier();
+        rl->wr = wr;
+    }
+}
+
+/**
+ * Get and remove the oldest object from the list of ready objects. Called by
+ * consumer.
+ *
+ * Object is removed before return, so producer may add it again while the
+ * consumer processes it.
+ *
+ * @param rl This object.
+ *
+ * @return Id of the object or CO_READY_LIST_EMPTY.
+ */
+static inline uint16_t CO_readyList_pop(CO_readyList_t *rl) {
+    uint16_t rd = rl->rd;
+    uint16_t id;
+
+    if (rd == rl->wr) {
+        return CO_READY_LIST_EMPTY;
+    }
+    CO_MemoryBarrier();
+    id = rl->ring[rd];
+    rd++;
+    if (rd >= rl->ringSize) {
+        rd = 0;
+    }
+    rl->rd = rd;
+    rl->queued[id] = 0;
+    CO_MemoryBarrier();
+    return id;
+}
+
+
 /**
  * Get uint8_t value from memory buffer
  *
@@ -0,0 +1,163 @@
+/**
+ * Byte order and word size conversion of CANopen data
+ *
+ * @file        CO_endian.h
+ * @ingroup     CO_endian
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_ENDIAN_H
+#define CO_ENDIAN_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_endian Byte order conversion
+ * Kernels for conversion between CANopen (little endian, 8-bit bytes) and
+ * target representation of OD variables.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ *
+ * CO_swapBytes() reverses multi-byte variable on big endian targets
+ * (CO_BIG_ENDIAN). Lengths 2, 4 and 8 use CO_BSWAP_16(), CO_BSWAP_32() and
+ * CO_BSWAP_64(), which are compiler builtins with gcc and clang and may be
+ * overridden by the target. CO_wordsToBytes() and CO_bytesToWords() convert
+ * in place between variables with 16-bit words and CAN data with one byte in
+ * each memory unit, as needed on C2000 (C2000_PORT), where uint8_t has 16 bits.
+ *
+ * Kernels are used by SDO server, PDO and OD interface.
+ */
+
+#ifndef CO_BSWAP_16
+#if defined __GNUC__ || defined __clang__ || defined CO_DOXYGEN
+/** Reverse bytes of uint16_t value */
+#define CO_BSWAP_16(x) __builtin_bswap16(x)
+/** Reverse bytes of uint32_t value */
+#define CO_BSWAP_32(x) __builtin_bswap32(x)
+/** Reverse bytes of uint64_t value */
+#define CO_BSWAP_64(x) __builtin_bswap64(x)
+#else
+#define CO_BSWAP_16(x) ((uint16_t)(((uint16_t)(x) >> 8) | ((uint16_t)(x) << 8)))
+#define CO_BSWAP_32(x) ((((uint32_t)(x) & 0x000000FFUL) << 24) \
+                      | (((uint32_t)(x) & 0x0000FF00UL) << 8) \
+                      | (((uint32_t)(x) & 0x00FF0000UL) >> 8) \
+                      | (((uint32_t)(x) & 0xFF000000UL) >> 24))
+#define CO_BSWAP_64(x) (((uint64_t)CO_BSWAP_32((uint32_t)(x)) << 32) \
+                      | (uint64_t)CO_BSWAP_32((uint32_t)((uint64_t)(x) >> 32)))
+#endif
+#endif
+
+
+/**
+ * Reverse order of bytes in place.
+ *
+ * @param data Pointer to data, does not need to be aligned.
+ * @param length Number of bytes.
+ */
+static inline void CO_swapBytes(void *data, size_t length) {
+    switch (length) {
+    case 2: {
+        uint16_t value;
+        memcpy(&value, data, sizeof(value));
+        value = CO_BSWAP_16(value);
+        memcpy(data, &value, sizeof(value));
+        break;
+    }
+    case 4: {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        value = CO_BSWAP_32(value);
+        memcpy(data, &value, sizeof(value));
+        break;
+    }
+    case 8: {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        value = CO_BSWAP_64(value);
+        memcpy(data, &value, sizeof(value));
+        break;
+    }
+    default: {
+        uint8_t *lo = (uint8_t *)data;
+        uint8_t *hi = (uint8_t *)data + length - 1;
+        while (length > 1 && lo < hi) {
+            uint8_t swap = *lo;
+            *lo++ = *hi;
+            *hi-- = swap;
+        }
+        break;
+    }
+    }
+}
+
+
+/**
+ * Unpack 16-bit words into one byte per memory unit, in place.
+ *
+ * Low byte of each word comes first. Data is processed from the end, so
+ * words are read before they are overwritten.
+ *
+ * @param data Buffer with (count + 1) / 2 words on input and count bytes on
+ * output.
+ * @param count Number of bytes.
+ */
+static inline void CO_wordsToBytes(uint8_t *data, size_t count) {
+    uint16_t *words = (uint16_t *)(void *)data;
+    while (count > 0) {
+        count--;
+        data[count] = (uint8_t)((words[count / 2] >> ((count % 2) * 8))
+                                & 0x00FFU);
+    }
+}
+
+
+/**
+ * Pack bytes, one per memory unit, into 16-bit words, in place.
+ *
+ * Reverse of CO_wordsToBytes(). Data is processed from the start, so bytes are
+ * read before they are overwritten.
+ *
+ * @param data Buffer with count bytes on input and (count + 1) / 2 words on
+ * output.
+ * @param count Number of bytes.
+ */
+static inline void CO_bytesToWords(uint8_t *data, size_t count) {
+    uint16_t *words = (uint16_t *)(void *)data;
+    for (size_t i = 0; i < count; i += 2) {
+        uint16_t word = (uint16_t)(data[i] & 0x00FFU);
+        if ((i + 1) < count) {
+            word |= (uint16_t)((data[i + 1] & 0x00FFU) << 8);
+        }
+        words[i / 2] = word;
+    }
+}
+
+/** @} */ /* CO_endian */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_ENDIAN_H */
@@ -85,51 +85,42 @@ size_t CO_fifo_write(CO_fifo_t *fifo,
                      size_t count,
                      uint16_t *crc)
 {
-    size_t i;
-    uint8_t *bufDest;
+    size_t written = 0;
 
     if (fifo == NULL || fifo->buf == NULL || buf == NULL) {
         return 0;
     }
 
-    bufDest = &fifo->buf[fifo->writePtr];
-    for (i = count; i > 0; i--) {
-        size_t writePtrNext = fifo->writePtr + 1;
+    /* copy into one or two contiguous regions of the circular buffer */
+    while (written < count) {
+        uint8_t *bufDest;
+        size_t n = CO_fifo_writeSpan(fifo, &bufDest);
 
-        /* is circular buffer full */
-        if (writePtrNext == fifo->readPtr ||
-            (writePtrNext == fifo->bufSize && fifo->readPtr == 0)) {
+        if (n == 0) {
             break;
         }
-
-        *bufDest = *buf;
+        if (n > (count - written)) {
+            n = count - written;
+        }
+        memcpy(bufDest, &buf[written], n);
 
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
         if (crc != NULL) {
-            crc16_ccitt_single(crc, *buf);
+            *crc = crc16_ccitt(bufDest, n, *crc);
         }
 #endif
 
-        /* increment variables */
-        if (writePtrNext == fifo->bufSize) {
-            fifo->writePtr = 0;
-            bufDest = &fifo->buf[0];
-        }
-        else {
-            fifo->writePtr++;
-            bufDest++;
-        }
-        buf++;
+        CO_fifo_writeCommit(fifo, n);
+        written += n;
     }
 
-    return count - i;
+    return written;
 }
 
 
 /******************************************************************************/
 size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
-    size_t i;
-    const uint8_t *bufSrc;
+    size_t read = 0;
 
     if (eof != NULL) {
         *eof = false;
@@ -138,63 +129,63 @@ size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
         return 0;
     }
 
-    bufSrc = &fifo->buf[fifo->readPtr];
-    for (i = count; i > 0; ) {
-        const uint8_t c = *bufSrc;
+    /* copy from one or two contiguous regions of the circular buffer */
+    while (read < count) {
+        const uint8_t *bufSrc;
+        size_t n = CO_fifo_readSpan(fifo, &bufSrc);
+        bool_t delimFound = false;
 
-        /* is circular buffer empty */
-        if (fifo->readPtr == fifo->writePtr) {
+        if (n == 0) {
             break;
         }
-
-        *(buf++) = c;
-
-        /* increment variables */
-        if (++fifo->readPtr == fifo->bufSize) {
-            fifo->readPtr = 0;
-            bufSrc = &fifo->buf[0];
-        }
-        else {
-            bufSrc++;
+        if (n > (count - read)) {
+            n = count - read;
         }
-        i--;
 
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
         /* is delimiter? */
-        if (eof != NULL && c == DELIM_COMMAND) {
+        if (eof != NULL) {
+            const uint8_t *delim = memchr(bufSrc, DELIM_COMMAND, n);
+            if (delim != NULL) {
+                n = (size_t)(delim - bufSrc) + 1;
+                delimFound = true;
+            }
+        }
+#endif
+
+        memcpy(&buf[read], bufSrc, n);
+        CO_fifo_readCommit(fifo, n);
+        read += n;
+
+        if (delimFound) {
             *eof = true;
             break;
         }
-#endif
     }
 
-    return count - i;
+    return read;
 }
 
 
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ
 /******************************************************************************/
 size_t CO_fifo_altBegin(CO_fifo_t *fifo, size_t offset) {
-    size_t i;
+    size_t occupied;
 
     if (fifo == NULL) {
         return 0;
     }
 
-    fifo->altReadPtr = fifo->readPtr;
-    for (i = offset; i > 0; i--) {
-        /* is circular buffer empty */
-        if (fifo->altReadPtr == fifo->writePtr) {
-            break;
-        }
-
-        /* increment variable */
-        if (++fifo->altReadPtr == fifo->bufSize) {
-            fifo->altReadPtr = 0;
-        }
+    occupied = CO_fifo_getOccupied(fifo);
+    if (offset > occupied) {
+        offset = occupied;
+    }
+    fifo->altReadPtr = fifo->readPtr + offset;
+    if (fifo->altReadPtr >= fifo->bufSize) {
+        fifo->altReadPtr -= fifo->bufSize;
     }
 
-    return offset - i;
+    return offset;
 }
 
 void CO_fifo_altFinish(CO_fifo_t *fifo, uint16_t *crc) {
@@ -203,53 +194,45 @@ void CO_fifo_altFinish(CO_fifo_t *fifo, uint16_t *crc) {
         return;
     }
 
-    if (crc == NULL) {
-        fifo->readPtr = fifo->altReadPtr;
-    }
-    else {
-        const uint8_t *bufSrc = &fifo->buf[fifo->readPtr];
-        while (fifo->readPtr != fifo->altReadPtr) {
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
-            crc16_ccitt_single(crc, *bufSrc);
-#endif
-            /* increment variable */
-            if (++fifo->readPtr == fifo->bufSize) {
-                fifo->readPtr = 0;
-                bufSrc = &fifo->buf[0];
-            }
-            else {
-                bufSrc++;
-            }
+    /* calculate crc over one or two contiguous regions of consumed data */
+    if (crc != NULL) {
+        while (fifo->readPtr != fifo->altReadPtr) {
+            size_t end = (fifo->altReadPtr > fifo->readPtr)
+                       ? fifo->altReadPtr : fifo->bufSize;
+            size_t n = end - fifo->readPtr;
+
+            *crc = crc16_ccitt(&fifo->buf[fifo->readPtr], n, *crc);
+            CO_fifo_readCommit(fifo, n);
         }
     }
+#else
+    (void)crc;
+#endif
+    fifo->readPtr = fifo->altReadPtr;
 }
 
 size_t CO_fifo_altRead(CO_fifo_t *fifo, uint8_t *buf, size_t count) {
-    size_t i;
-    const uint8_t *bufSrc;
+    size_t read = 0;
 
-    bufSrc = &fifo->buf[fifo->altReadPtr];
-    for (i = count; i > 0; i--) {
-        const uint8_t c = *bufSrc;
+    /* copy from one or two contiguous regions of the circular buffer */
+    while (read < count && fifo->altReadPtr != fifo->writePtr) {
+        size_t end = (fifo->writePtr > fifo->altReadPtr)
+                   ? fifo->writePtr : fifo->bufSize;
+        size_t n = end - fifo->altReadPtr;
 
-        /* is there no more data */
-        if (fifo->altReadPtr == fifo->writePtr) {
-            break;
+        if (n > (count - read)) {
+            n = count - read;
         }
-
-        *(buf++) = c;
-
-        /* increment variables */
-        if (++fifo->altReadPtr == fifo->bufSize) {
+        memcpy(&buf[read], &fifo->buf[fifo->altReadPtr], n);
+        fifo->altReadPtr += n;
+        if (fifo->altReadPtr == fifo->bufSize) {
             fifo->altReadPtr = 0;
-            bufSrc = &fifo->buf[0];
-        }
-        else {
-            bufSrc++;
         }
+        read += n;
     }
 
-    return count - i;
+    return read;
 }
 #endif /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ */
 
@@ -485,12 +468,132 @@ static const uint8_t base64DecTable[] = {
    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
     41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,255,255,255,255,255};
 
+/* Integer conversions below are used instead of sprintf() and strtoul(), which
+ * are much slower and have platform dependent range of long type. */
+static const char hexDigits[] = "0123456789ABCDEF";
+
+/* Print unsigned integer as decimal string, return number of characters */
+static size_t u64toa(char *buf, uint64_t n) {
+    char tmp[20];
+    size_t len = 0;
+    size_t i;
+    uint32_t n32;
+
+    /* 64-bit division is slow on 32-bit targets, use it only if necessary */
+    while (n > UINT32_MAX) {
+        tmp[len++] = (char)('0' + (uint8_t)(n % 10U));
+        n /= 10U;
+    }
+    n32 = (uint32_t)n;
+    do {
+        tmp[len++] = (char)('0' + (uint8_t)(n32 % 10U));
+        n32 /= 10U;
+    } while (n32 > 0U);
+
+    for (i = 0; i < len; i++) {
+        buf[i] = tmp[len - 1U - i];
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/* Print signed integer as decimal string, return number of characters */
+static size_t i64toa(char *buf, int64_t n) {
+    if (n < 0) {
+        buf[0] = '-';
+        return u64toa(&buf[1], 0U - (uint64_t)n) + 1U;
+    }
+    return u64toa(buf, (uint64_t)n);
+}
+
+/* Print integer as "0x" followed by 'digits' uppercase hex digits */
+static size_t x64toa(char *buf, uint64_t n, uint8_t digits) {
+    size_t i;
+
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (i = digits + 1U; i > 1U; i--) {
+        buf[i] = hexDigits[(uint8_t)n & 0x0FU];
+        n >>= 4;
+    }
+    buf[digits + 2U] = '\0';
+    return digits + 2U;
+}
+
+/* Return value of hex digit or 0xFF, if character is not hex digit */
+static inline uint8_t hexNibble(uint8_t c) {
+    if (c >= (uint8_t)'0' && c <= (uint8_t)'9') {
+        return c - (uint8_t)'0';
+    }
+    c |= 0x20U; /* lower case */
+    if (c >= (uint8_t)'a' && c <= (uint8_t)'f') {
+        return c - (uint8_t)'a' + 10U;
+    }
+    return 0xFFU;
+}
+
+/* Parse unsigned integer token with decimal, "0x" hex or "0" octal notation,
+ * same as strtoull(buf, NULL, 0). Return false, if token contains other
+ * characters or value is larger than max. */
+static bool_t a2u64(const char *buf, uint64_t max, uint64_t *value) {
+    const char *c = buf;
+    uint64_t n = 0;
+    uint8_t base = 10;
+
+    if (*c == '+') {
+        c++;
+    }
+    if (c[0] == '0' && (c[1] == 'x' || c[1] == 'X')) {
+        base = 16;
+        c += 2;
+    }
+    else if (c[0] == '0') {
+        base = 8;
+    }
+    else { /* MISRA C 2004 14.10 */ }
+
+    if (*c == '\0') {
+        return false;
+    }
+    for (; *c != '\0'; c++) {
+        uint8_t digit = hexNibble((uint8_t)*c);
+
+        if (digit >= base || n > (max - digit) / base) {
+            return false;
+        }
+        n = n * base + digit;
+    }
+
+    *value = n;
+    return true;
+}
+
+/* Parse signed integer token, see a2u64. Return false also, if value is
+ * outside min...max. */
+static bool_t a2i64(const char *buf, int64_t min, int64_t max, int64_t *value){
+    uint64_t n;
+
+    if (buf[0] == '-') {
+        if (buf[1] == '+' || !a2u64(&buf[1], 0U - (uint64_t)min, &n)) {
+            return false;
+        }
+        *value = (int64_t)(0U - n);
+    }
+    else {
+        if (!a2u64(buf, (uint64_t)max, &n)) {
+            return false;
+        }
+        *value = (int64_t)n;
+    }
+    return true;
+}
+
 size_t CO_fifo_readU82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
     uint8_t n=0;
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, &n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu8, n);
+        return u64toa(buf, n);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -502,7 +605,7 @@ size_t CO_fifo_readU162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu16, CO_SWAP_16(n));
+        return u64toa(buf, CO_SWAP_16(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -514,7 +617,7 @@ size_t CO_fifo_readU322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 12 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu32, CO_SWAP_32(n));
+        return u64toa(buf, CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -526,7 +629,7 @@ size_t CO_fifo_readU642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu64, CO_SWAP_64(n));
+        return u64toa(buf, CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -538,7 +641,7 @@ size_t CO_fifo_readX82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%02"PRIX8, n);
+        return x64toa(buf, n, 2);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -550,7 +653,7 @@ size_t CO_fifo_readX162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%04"PRIX16, CO_SWAP_16(n));
+        return x64toa(buf, CO_SWAP_16(n), 4);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -562,7 +665,7 @@ size_t CO_fifo_readX322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 12 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%08"PRIX32, CO_SWAP_32(n));
+        return x64toa(buf, CO_SWAP_32(n), 8);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -574,7 +677,7 @@ size_t CO_fifo_readX642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%016"PRIX64, CO_SWAP_64(n));
+        return x64toa(buf, CO_SWAP_64(n), 16);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -586,7 +689,7 @@ size_t CO_fifo_readI82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId8, n);
+        return i64toa(buf, n);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -598,7 +701,7 @@ size_t CO_fifo_readI162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId16, CO_SWAP_16(n));
+        return i64toa(buf, (int16_t)CO_SWAP_16(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -610,7 +713,7 @@ size_t CO_fifo_readI322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 13 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId32, CO_SWAP_32(n));
+        return i64toa(buf, (int32_t)CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -622,7 +725,7 @@ size_t CO_fifo_readI642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 23 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId64, CO_SWAP_64(n));
+        return i64toa(buf, (int64_t)CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -663,17 +766,34 @@ size_t CO_fifo_readHex2a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
         if (!fifo->started) {
             uint8_t c;
             if(CO_fifo_getc(fifo, &c)) {
-                len = sprintf(&buf[0], "%02"PRIX8, c);
+                buf[len++] = hexDigits[c >> 4];
+                buf[len++] = hexDigits[c & 0x0FU];
                 fifo->started = true;
             }
         }
 
+        /* Process contiguous parts of the circular buffer. Each byte takes
+         * three characters, one more is reserved for string terminator. */
         while ((len + 3) < count) {
-            uint8_t c;
-            if(!CO_fifo_getc(fifo, &c)) {
+            const uint8_t *c;
+            size_t n = CO_fifo_readSpan(fifo, &c);
+            size_t i;
+
+            if (n == 0) {
                 break;
             }
-            len += sprintf(&buf[len], " %02"PRIX8, c);
+            if (n > (count - 1 - len) / 3) {
+                n = (count - 1 - len) / 3;
+            }
+            for (i = 0; i < n; i++) {
+                buf[len++] = ' ';
+                buf[len++] = hexDigits[c[i] >> 4];
+                buf[len++] = hexDigits[c[i] & 0x0FU];
+            }
+            CO_fifo_readCommit(fifo, n);
+        }
+        if (len > 0) {
+            buf[len] = '\0';
         }
     }
 
@@ -690,21 +810,28 @@ size_t CO_fifo_readVs2a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
             fifo->started = true;
         }
 
+        /* Process contiguous parts of the circular buffer */
         while ((len + 2) < count) {
-            uint8_t c;
-            if(!CO_fifo_getc(fifo, &c)) {
+            const uint8_t *c;
+            size_t n = CO_fifo_readSpan(fifo, &c);
+            size_t i;
+
+            if (n == 0) {
                 if (end) {
                     buf[len++] = '"';
                 }
                 break;
             }
-            else if (c != 0 && c != (uint8_t)'\r') {
+            for (i = 0; i < n && (len + 2) < count; i++) {
                 /* skip null and CR inside string */
-                buf[len++] = (char)c;
-                if (c == DELIM_DQUOTE) {
-                    buf[len++] = '"';
+                if (c[i] != 0 && c[i] != (uint8_t)'\r') {
+                    buf[len++] = (char)c[i];
+                    if (c[i] == DELIM_DQUOTE) {
+                        buf[len++] = '"';
+                    }
                 }
             }
+            CO_fifo_readCommit(fifo, i);
         }
     }
 
@@ -792,11 +919,10 @@ size_t CO_fifo_cpyTok2U8(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || u32 > UINT8_MAX) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!a2u64(buf, UINT8_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint8_t num = (uint8_t) u32;
+            uint8_t num = (uint8_t) u64;
             nWr = CO_fifo_write(dest, &num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -814,11 +940,10 @@ size_t CO_fifo_cpyTok2U16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || u32 > UINT16_MAX) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!a2u64(buf, UINT16_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint16_t num = CO_SWAP_16((uint16_t) u32);
+            uint16_t num = CO_SWAP_16((uint16_t) u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -836,11 +961,10 @@ size_t CO_fifo_cpyTok2U32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!a2u64(buf, UINT32_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint32_t num = CO_SWAP_32(u32);
+            uint32_t num = CO_SWAP_32((uint32_t) u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -858,9 +982,8 @@ size_t CO_fifo_cpyTok2U64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint64_t u64 = strtoull(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!a2u64(buf, UINT64_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
             uint64_t num = CO_SWAP_64(u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -880,12 +1003,11 @@ size_t CO_fifo_cpyTok2I8(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || i32 < INT8_MIN || i32 > INT8_MAX) {
+        int64_t i64;
+        if (!a2i64(buf, INT8_MIN, INT8_MAX, &i64)) {
             st |= CO_fifo_st_errVal;
         } else {
-            int8_t num = (int8_t) i32;
+            int8_t num = (int8_t) i64;
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -903,12 +1025,11 @@ size_t CO_fifo_cpyTok2I16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || i32 < INT16_MIN || i32 > INT16_MAX) {
+        int64_t i64;
+        if (!a2i64(buf, INT16_MIN, INT16_MAX, &i64)) {
             st |= CO_fifo_st_errVal;
         } else {
-            int16_t num = CO_SWAP_16((int16_t) i32);
+            int16_t num = CO_SWAP_16((int16_t) i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -926,11 +1047,10 @@ size_t CO_fifo_cpyTok2I32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        int64_t i64;
+        if (!a2i64(buf, INT32_MIN, INT32_MAX, &i64)) st |= CO_fifo_st_errVal;
         else {
-            int32_t num = CO_SWAP_32(i32);
+            int32_t num = CO_SWAP_32((int32_t) i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -948,9 +1068,8 @@ size_t CO_fifo_cpyTok2I64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int64_t i64 = strtoll(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        int64_t i64;
+        if (!a2i64(buf, INT64_MIN, INT64_MAX, &i64)) st |= CO_fifo_st_errVal;
         else {
             int64_t num = CO_SWAP_64(i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -993,7 +1112,7 @@ size_t CO_fifo_cpyTok2R64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
         char *sRet;
-        float64_t f64 = strtof(buf, &sRet);
+        float64_t f64 = strtod(buf, &sRet);
         if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
         else {
             float64_t num = CO_SWAP_64(f64);
@@ -1054,7 +1173,7 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             continue;
         }
 
-        if (isxdigit((int)c) != 0) {
+        if (hexNibble(c) != 0xFFU) {
             /* first or second hex digit */
             if (step == 0) {
                 firstChar = c;
@@ -1062,11 +1181,8 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             }
             else {
                 /* write the byte */
-                uint8_t s[3];
-                int32_t num;
-                s[0] = firstChar; s[1] = c; s[2] = 0;
-                num = strtol((char *)&s[0], NULL, 16);
-                CO_fifo_putc(dest, (uint8_t) num);
+                CO_fifo_putc(dest, (uint8_t)(hexNibble(firstChar) << 4)
+                                   | hexNibble(c));
                 destSpace--;
                 step = 0;
             }
@@ -1082,11 +1198,7 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             /* this is space or delimiter */
             if (step == 1) {
                 /* write the byte */
-                uint8_t s[2];
-                int32_t num;
-                s[0] = firstChar; s[1] = 0;
-                num = strtol((char *)&s[0], NULL, 16);
-                CO_fifo_putc(dest, (uint8_t) num);
+                CO_fifo_putc(dest, hexNibble(firstChar));
                 destSpace--;
                 step = 0;
             }
@@ -227,6 +227,97 @@ static inline bool_t CO_fifo_getc(CO_fifo_t *fifo, uint8_t *buf) {
 }
 
 
+/**
+ * Get contiguous region of CO_fifo_t buffer, into which data may be written
+ *
+ * Producer may write data directly into the region (with memcpy or similar)
+ * and then make them available with CO_fifo_writeCommit(). Free space of
+ * circular buffer may be split into two regions. Second region is returned by
+ * the next call after the commit.
+ *
+ * @param fifo This object
+ * @param [out] buf Pointer to the first free byte
+ *
+ * @return number of bytes, which may be written into buf, 0 if fifo is full.
+ */
+static inline size_t CO_fifo_writeSpan(CO_fifo_t *fifo, uint8_t **buf) {
+    /* read pointers once, consumer may change readPtr meanwhile */
+    size_t readPtr = fifo->readPtr;
+    size_t writePtr = fifo->writePtr;
+    size_t end;
+
+    if (readPtr > writePtr) {
+        end = readPtr - 1;
+    }
+    else {
+        end = (readPtr == 0) ? fifo->bufSize - 1 : fifo->bufSize;
+    }
+    *buf = &fifo->buf[writePtr];
+
+    return end - writePtr;
+}
+
+
+/**
+ * Commit data written into region from CO_fifo_writeSpan()
+ *
+ * @param fifo This object
+ * @param count Number of bytes written, must not be larger than
+ * CO_fifo_getSpace().
+ */
+static inline void CO_fifo_writeCommit(CO_fifo_t *fifo, size_t count) {
+    size_t writePtr = fifo->writePtr + count;
+
+    if (writePtr >= fifo->bufSize) {
+        writePtr -= fifo->bufSize;
+    }
+    /* single store, consumer never sees intermediate value */
+    fifo->writePtr = writePtr;
+}
+
+
+/**
+ * Get contiguous region of data inside CO_fifo_t buffer for reading
+ *
+ * Consumer may process data directly inside the buffer and then remove them
+ * with CO_fifo_readCommit(). Data in circular buffer may be split into two
+ * regions. Second region is returned by the next call after the commit.
+ *
+ * @param fifo This object
+ * @param [out] buf Pointer to the first byte of data
+ *
+ * @return number of bytes available in buf, 0 if fifo is empty.
+ */
+static inline size_t CO_fifo_readSpan(CO_fifo_t *fifo, const uint8_t **buf) {
+    /* read pointers once, producer may change writePtr meanwhile */
+    size_t readPtr = fifo->readPtr;
+    size_t writePtr = fifo->writePtr;
+    size_t end = (writePtr >= readPtr) ? writePtr : fifo->bufSize;
+
+    *buf = &fifo->buf[readPtr];
+
+    return end - readPtr;
+}
+
+
+/**
+ * Remove data processed from region from CO_fifo_readSpan()
+ *
+ * @param fifo This object
+ * @param count Number of bytes to remove, must not be larger than
+ * CO_fifo_getOccupied().
+ */
+static inline void CO_fifo_readCommit(CO_fifo_t *fifo, size_t count) {
+    size_t readPtr = fifo->readPtr + count;
+
+    if (readPtr >= fifo->bufSize) {
+        readPtr -= fifo->bufSize;
+    }
+    /* single store, producer never sees intermediate value */
+    fifo->readPtr = readPtr;
+}
+
+
 /**
  * Write data into CO_fifo_t object.
  *
@@ -0,0 +1,358 @@
+/*
+ * Processing time statistics
+ *
+ * @file        CO_stats.c
+ * @ingroup     CO_CANopen_301_stats
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_stats.h"
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+
+#include <string.h>
+
+/* Sub-indexes of OD_INDEX_STATS */
+#define STATS_RESET             1
+#define STATS_DATA              2
+#define STATS_BUSLOAD           3
+#define STATS_TX_LIMIT          4
+
+/* Number of uint32_t words in CO_stats_block_t */
+#define STATS_WORDS (sizeof(CO_stats_block_t) / sizeof(uint32_t))
+
+
+/* Serialize array of words as little endian, independent of target */
+static ODR_t OD_readWords(OD_stream_t *stream, const uint32_t *words,
+                          size_t nWords, void *buf,
+                          OD_size_t count, OD_size_t *countRead)
+{
+    uint8_t *dest = (uint8_t *)buf;
+    size_t size = nWords * 4U;
+    size_t offset = stream->dataOffset;
+    size_t n = 0;
+
+    while (n < count && offset < size) {
+        uint32_t word = words[offset / 4U];
+        dest[n] = (uint8_t)((word >> (8U * (offset % 4U))) & 0xFFU);
+        n++;
+        offset++;
+    }
+
+    *countRead = (OD_size_t)n;
+    if (offset < size) {
+        stream->dataOffset = (OD_size_t)offset;
+        return ODR_PARTIAL;
+    }
+    stream->dataOffset = 0;
+    return ODR_OK;
+}
+
+
+/*
+ * Custom functions for reading and writing OD object "Statistics"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_stats(OD_stream_t *stream, void *buf,
+                           OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_stats_t *stats = stream->object;
+
+    switch (stream->subIndex) {
+    case 0:
+        return OD_readOriginal(stream, buf, count, countRead);
+    case STATS_RESET:
+        if (count < sizeof(uint8_t)) {
+            return ODR_DEV_INCOMPAT;
+        }
+        *countRead = CO_setUint8(buf, 0);
+        return ODR_OK;
+    case STATS_DATA:
+        return OD_readWords(stream, (const uint32_t *)&stats->block,
+                            STATS_WORDS, buf, count, countRead);
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+    case STATS_BUSLOAD:
+        return OD_readWords(stream, (const uint32_t *)&stats->busLoad,
+                            sizeof(CO_stats_busLoad_t) / sizeof(uint32_t),
+                            buf, count, countRead);
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT
+    case STATS_TX_LIMIT:
+        if (count < sizeof(uint16_t)) {
+            return ODR_DEV_INCOMPAT;
+        }
+        *countRead = CO_setUint16(buf, stats->txLimit);
+        return ODR_OK;
+#endif
+    default:
+        return ODR_SUB_NOT_EXIST;
+    }
+}
+
+static ODR_t OD_write_stats(OD_stream_t *stream, const void *buf,
+                            OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT
+    if (stream->subIndex == STATS_TX_LIMIT) {
+        CO_stats_t *stats = stream->object;
+        uint16_t txLimit;
+
+        if (count != sizeof(uint16_t)) {
+            return ODR_TYPE_MISMATCH;
+        }
+        txLimit = CO_getUint16(buf);
+        if (txLimit > 1000U) {
+            return ODR_INVALID_VALUE;
+        }
+        stats->txLimit = txLimit;
+
+        *countWritten = count;
+        return ODR_OK;
+    }
+#endif
+    if (stream->subIndex != STATS_RESET) {
+        return ODR_READONLY;
+    }
+    if (count != sizeof(uint8_t)) {
+        return ODR_TYPE_MISMATCH;
+    }
+    if (CO_getUint8(buf) != 1) {
+        return ODR_INVALID_VALUE;
+    }
+
+    CO_stats_reset(stream->object);
+
+    *countWritten = count;
+    return ODR_OK;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_stats_init(CO_stats_t *stats,
+                               CO_CANmodule_t *CANmodule,
+                               OD_entry_t *OD_stats)
+{
+    /* verify arguments */
+    if (stats == NULL || CANmodule == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(stats, 0, sizeof(CO_stats_t));
+    stats->CANmodule = CANmodule;
+    stats->CANerrorStatusPrev = CANmodule->CANerrorStatus;
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT
+    stats->txLimit = CO_CONFIG_STATS_TX_LIMIT_CEILING;
+#endif
+    CO_stats_reset(stats);
+#ifdef CO_DRIVER_STATS
+    CANmodule->stats = stats;
+#endif
+
+    if (OD_stats != NULL) {
+        stats->OD_stats_ext.object = stats;
+        stats->OD_stats_ext.read = OD_read_stats;
+        stats->OD_stats_ext.write = OD_write_stats;
+        OD_extension_init(OD_stats, &stats->OD_stats_ext);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_stats_reset(CO_stats_t *stats) {
+    CO_stats_block_t *block = &stats->block;
+
+    memset(block, 0, sizeof(CO_stats_block_t));
+    block->layout = (uint32_t)CO_STATS_STAGES
+                  | ((uint32_t)CO_CONFIG_STATS_HIST_BINS << 8)
+                  | ((uint32_t)CO_CONFIG_STATS_HIST_SHIFT << 16);
+    for (uint8_t i = 0; i < (uint8_t)CO_STATS_STAGES; i++) {
+        block->stage[i].min = 0xFFFFFFFFUL;
+    }
+    stats->syncPending = false;
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+    memset(&stats->busLoad, 0, sizeof(CO_stats_busLoad_t));
+    memset(stats->windowBits, 0, sizeof(stats->windowBits));
+    stats->busLoad.layout = (uint32_t)CO_CONFIG_STATS_BUSLOAD_BINS
+                          | ((uint32_t)CO_STATS_CLASSES << 8)
+                          | ((uint32_t)CO_CONFIG_STATS_BUSLOAD_WINDOW_MS << 16);
+    stats->windowTime_us = 0;
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT
+    stats->tokens = (int32_t)CO_CONFIG_STATS_TX_LIMIT_BURST;
+    stats->tokensFrac = 0;
+#endif
+}
+
+
+/******************************************************************************/
+void CO_stats_record(CO_stats_t *stats,
+                     CO_stats_stageId_t id,
+                     uint32_t cycles)
+{
+    if (stats == NULL || id >= CO_STATS_STAGES) {
+        return;
+    }
+
+    CO_stats_stage_t *stage = &stats->block.stage[id];
+    uint32_t v = cycles >> CO_CONFIG_STATS_HIST_SHIFT;
+    uint16_t bin = 0;
+
+    /* bin is number of significant bits in v, limited by the last bin */
+    while (v != 0U && bin < (CO_CONFIG_STATS_HIST_BINS - 1U)) {
+        v >>= 1;
+        bin++;
+    }
+
+    stage->count++;
+    stage->hist[bin]++;
+    if (cycles < stage->min) {
+        stage->min = cycles;
+    }
+    if (cycles > stage->max) {
+        stage->max = cycles;
+    }
+}
+
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+/* Calculate bus load of the finished window, windowTime_us is at least
+ * CO_CONFIG_STATS_BUSLOAD_WINDOW_MS. windowBits are taken from stats. */
+static void CO_stats_busLoadWindow(CO_stats_t *stats,
+                                   const uint32_t windowBits[]) {
+    CO_stats_busLoad_t *busLoad = &stats->busLoad;
+    /* capacity of the window in bits */
+    uint64_t capacity = (uint64_t)stats->bitRate * stats->windowTime_us
+                      / 1000U;
+    uint32_t bits = 0;
+    uint32_t load;
+    uint32_t bin;
+
+    for (uint8_t i = 0; i < (uint8_t)CO_STATS_CLASSES; i++) {
+        bits += windowBits[i];
+        busLoad->classLoad[i] = (uint32_t)((uint64_t)windowBits[i]
+                                           * 1000U / capacity);
+    }
+    load = (uint32_t)((uint64_t)bits * 1000U / capacity);
+
+    bin = load * CO_CONFIG_STATS_BUSLOAD_BINS / 1000U;
+    if (bin >= CO_CONFIG_STATS_BUSLOAD_BINS) {
+        bin = CO_CONFIG_STATS_BUSLOAD_BINS - 1U;
+    }
+    busLoad->hist[bin]++;
+    busLoad->windows++;
+    busLoad->load = load;
+    if (load > busLoad->loadMax) {
+        busLoad->loadMax = load;
+    }
+}
+#endif
+
+
+/******************************************************************************/
+void CO_stats_process(CO_stats_t *stats,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us)
+{
+    CO_CANmodule_t *CANmodule = stats->CANmodule;
+    CO_stats_block_t *block = &stats->block;
+    uint16_t status = CANmodule->CANerrorStatus;
+    uint16_t rising = status & (uint16_t)~stats->CANerrorStatusPrev;
+
+    if ((rising & CO_CAN_ERRRX_OVERFLOW) != 0U) {
+        block->rxOverflow++;
+    }
+    if ((rising & CO_CAN_ERRTX_OVERFLOW) != 0U) {
+        block->txOverflow++;
+    }
+    stats->CANerrorStatusPrev = status;
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+    if (stats->bitRate == 0U) {
+        return;
+    }
+
+    stats->windowTime_us += timeDifference_us;
+    if (stats->windowTime_us >= (CO_CONFIG_STATS_BUSLOAD_WINDOW_MS * 1000UL)) {
+        uint32_t windowBits[CO_STATS_CLASSES];
+
+        /* windowBits are updated by CO_stats_frame() from CAN interrupt or
+         * from CO_CANsend() */
+        CO_LOCK_CAN_SEND(CANmodule);
+        memcpy(windowBits, stats->windowBits, sizeof(windowBits));
+        memset(stats->windowBits, 0, sizeof(stats->windowBits));
+        CO_UNLOCK_CAN_SEND(CANmodule);
+
+        CO_stats_busLoadWindow(stats, windowBits);
+        stats->windowTime_us = 0;
+    }
+#endif
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT
+    if (stats->txLimit != 0U) {
+        /* fill rate in millionths of bit per microsecond */
+        uint32_t rate = (uint32_t)stats->bitRate * stats->txLimit;
+        uint64_t fill = (uint64_t)rate * timeDifference_us + stats->tokensFrac;
+        int64_t tokens;
+
+        /* tokens are also taken by CO_stats_frame() from CAN interrupt or
+         * from CO_CANsend() */
+        CO_LOCK_CAN_SEND(CANmodule);
+        tokens = (int64_t)stats->tokens + (int64_t)(fill / 1000000U);
+        stats->tokensFrac = (uint32_t)(fill % 1000000U);
+        if (tokens > (int64_t)CO_CONFIG_STATS_TX_LIMIT_BURST) {
+            tokens = CO_CONFIG_STATS_TX_LIMIT_BURST;
+            stats->tokensFrac = 0;
+        }
+        stats->tokens = (int32_t)tokens;
+        CO_UNLOCK_CAN_SEND(CANmodule);
+
+        /* held frames are released, when bucket is not empty any more */
+        if (tokens <= 0 && CANmodule->CANtxCount > 0U
+            && timerNext_us != NULL
+        ) {
+            uint64_t need = (uint64_t)(1 - tokens) * 1000000U
+                          - stats->tokensFrac;
+            uint32_t diff = (uint32_t)((need + rate - 1U) / rate);
+            if (*timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+        }
+    }
+#else
+    (void)timerNext_us;
+#endif
+#if !((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD)
+    (void)timeDifference_us;
+#endif
+}
+
+#endif /* (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE */
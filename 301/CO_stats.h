@@ -0,0 +1,554 @@
+/**
+ * Processing time statistics
+ *
+ * @file        CO_stats.h
+ * @ingroup     CO_CANopen_301_stats
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_STATS_H
+#define CO_STATS_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_STATS
+#define CO_CONFIG_STATS (0)
+#endif
+#ifndef CO_CONFIG_STATS_HIST_BINS
+#define CO_CONFIG_STATS_HIST_BINS 16
+#endif
+#ifndef CO_CONFIG_STATS_HIST_SHIFT
+#define CO_CONFIG_STATS_HIST_SHIFT 4
+#endif
+#ifndef CO_CONFIG_STATS_BUSLOAD_WINDOW_MS
+#define CO_CONFIG_STATS_BUSLOAD_WINDOW_MS 100
+#endif
+#ifndef CO_CONFIG_STATS_BUSLOAD_BINS
+#define CO_CONFIG_STATS_BUSLOAD_BINS 10
+#endif
+#ifndef CO_CONFIG_STATS_TX_LIMIT_CEILING
+#define CO_CONFIG_STATS_TX_LIMIT_CEILING 0
+#endif
+#ifndef CO_CONFIG_STATS_TX_LIMIT_BURST
+#define CO_CONFIG_STATS_TX_LIMIT_BURST 1500
+#endif
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT) \
+    && !((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD)
+#error CO_CONFIG_STATS_TX_LIMIT requires CO_CONFIG_STATS_BUSLOAD
+#endif
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANopen_301_stats Statistics
+ * Processing time and event counters of the hot path.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ *
+ * Statistics measure execution time of CO_process(), CO_process_SYNC(),
+ * CO_process_RPDO(), CO_process_TPDO() and of CANrx_callback functions, called
+ * by the CAN driver. They also measure latency from the SYNC (as seen by
+ * CO_process_SYNC()) to the end of the following CO_process_TPDO(). Time is
+ * measured with target specific CO_cycleCounter(), units are the units of
+ * that counter (CPU cycles, for example).
+ *
+ * For each measured stage number of samples, minimum, maximum and histogram
+ * are kept. Histogram bin 0 counts samples shorter than
+ * 2^@ref CO_CONFIG_STATS_HIST_SHIFT, bin n counts samples from
+ * 2^(SHIFT+n-1) to 2^(SHIFT+n)-1, last bin counts all longer samples.
+ *
+ * Event counters count CAN receive and transmit overflows (rising edges of
+ * CO_CAN_ERRRX_OVERFLOW and CO_CAN_ERRTX_OVERFLOW, sampled in CO_process()),
+ * RPDO messages overwritten by the next message before they were processed and
+ * maximum number of messages waiting in CAN transmit buffers.
+ *
+ * All values are in @ref CO_stats_block_t of fixed size, which may be read
+ * from Object Dictionary, @ref OD_INDEX_STATS (RECORD):
+ * - 1 reset (UNSIGNED8, rw): write 1 to reset statistics, reads 0.
+ * - 2 data (DOMAIN, ro): CO_stats_block_t as array of UNSIGNED32, little
+ *   endian.
+ *
+ * Gateway-ascii may read it with SDO client, also from the own node, if
+ * CO_CONFIG_SDO_CLI_LOCAL is enabled: "r 0x2310 2 d".
+ *
+ * Samples are recorded without locking. Each stage must be recorded from one
+ * thread only, because samples from different threads may be lost. The same is
+ * for reset, which may race with concurrent recording.
+ *
+ * Statistics are reset by CO_stats_init() on communication reset.
+ *
+ * CAN driver records CANrx_callback execution time, if it defines
+ * CO_DRIVER_STATS, see CO_STATS_CAN_RX_BEGIN().
+ *
+ * ### Bus load
+ * If CO_CONFIG_STATS_BUSLOAD is enabled, CAN driver reports each frame on the
+ * bus, received or transmitted, with CO_STATS_CAN_FRAME(). Length of the frame
+ * in bits is estimated with CO_stats_frameBits(), including worst case bit
+ * stuffing. Frames are sorted into classes by CAN-ID, see
+ * @ref CO_stats_class_t. At the end of each window of
+ * @ref CO_CONFIG_STATS_BUSLOAD_WINDOW_MS, bus load is calculated in permille
+ * of the bit rate, set by CO_stats_setBitRate(). Results are in
+ * @ref CO_stats_busLoad_t, which is available from Object Dictionary:
+ * - 3 bus load (DOMAIN, ro): CO_stats_busLoad_t as array of UNSIGNED32,
+ *   little endian.
+ *
+ * ### Transmit limiter
+ * If CO_CONFIG_STATS_TX_LIMIT is enabled, token bucket keeps total bus load
+ * below the ceiling. Bucket is filled with ceiling * bit rate in
+ * CO_stats_process() and each frame on the bus takes its bits from it, up to
+ * +-@ref CO_CONFIG_STATS_TX_LIMIT_BURST. Real-time frames (NMT, SYNC, TIME,
+ * PDO and heartbeat) are always transmitted. Other frames (emergency, SDO and
+ * LSS, for example from SDO block transfer or gateway) are held back by the
+ * CAN driver, while bucket is empty, see CO_STATS_CAN_TX_ALLOWED(). They stay
+ * in CAN transmit buffers with _bufferFull_ set, so SDO and emergency objects
+ * wait as with busy CAN module. Ceiling is available from Object Dictionary:
+ * - 4 transmit limit (UNSIGNED16, rw): ceiling in permille, 0 disables
+ *   limiter.
+ *
+ * With CO_SEPARATE_RT_CAN only the frames of CO_t::CANmodule are observed.
+ */
+
+/**
+ * Default index of the statistics object in Object Dictionary.
+ */
+#ifndef OD_INDEX_STATS
+#define OD_INDEX_STATS 0x2310
+#endif
+
+/**
+ * Measured stages
+ */
+typedef enum {
+    CO_STATS_PROCESS = 0,   /**< CO_process() */
+    CO_STATS_SYNC = 1,      /**< CO_process_SYNC() */
+    CO_STATS_RPDO = 2,      /**< CO_process_RPDO() */
+    CO_STATS_TPDO = 3,      /**< CO_process_TPDO() */
+    CO_STATS_CAN_RX = 4,    /**< CANrx_callback, called from CAN driver */
+    CO_STATS_SYNC_TPDO = 5, /**< From SYNC to the end of CO_process_TPDO() */
+    CO_STATS_STAGES = 6     /**< Number of stages */
+} CO_stats_stageId_t;
+
+/**
+ * Traffic classes, determined from CAN-ID of the frame
+ */
+typedef enum {
+    CO_STATS_CLASS_NMT = 0,   /**< NMT command, 0x000 */
+    CO_STATS_CLASS_SYNC = 1,  /**< SYNC, 0x080 */
+    CO_STATS_CLASS_EMCY = 2,  /**< Emergency, 0x081..0x0FF */
+    CO_STATS_CLASS_TIME = 3,  /**< TIME, 0x100 */
+    CO_STATS_CLASS_PDO = 4,   /**< PDO, 0x180..0x57F */
+    CO_STATS_CLASS_SDO = 5,   /**< SDO, 0x580..0x6FF */
+    CO_STATS_CLASS_HB = 6,    /**< Heartbeat and node guarding, 0x700..0x77F */
+    CO_STATS_CLASS_OTHER = 7, /**< Other CAN-IDs, for example LSS */
+    CO_STATS_CLASSES = 8      /**< Number of classes */
+} CO_stats_class_t;
+
+/**
+ * Statistics of one stage
+ */
+typedef struct {
+    uint32_t count; /**< Number of samples */
+    uint32_t min;   /**< Minimum sample, 0xFFFFFFFF if no samples */
+    uint32_t max;   /**< Maximum sample */
+    /** Histogram of samples, see @ref CO_CANopen_301_stats */
+    uint32_t hist[CO_CONFIG_STATS_HIST_BINS];
+} CO_stats_stage_t;
+
+/**
+ * Block of all statistics. It contains only uint32_t variables, so it is
+ * transferred as array of UNSIGNED32.
+ */
+typedef struct {
+    /** Layout of the block: bits 0..7 number of stages, bits 8..15 number of
+     * histogram bins, bits 16..23 CO_CONFIG_STATS_HIST_SHIFT */
+    uint32_t layout;
+    /** Statistics of the stages, indexed by @ref CO_stats_stageId_t */
+    CO_stats_stage_t stage[CO_STATS_STAGES];
+    uint32_t rxOverflow;    /**< Number of CAN receive overflows */
+    uint32_t txOverflow;    /**< Number of CAN transmit overflows */
+    uint32_t rpdoOverwrite; /**< Number of overwritten RPDO messages */
+    uint32_t txQueueMax;    /**< Maximum of CO_CANmodule_t::CANtxCount */
+} CO_stats_block_t;
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD) || defined CO_DOXYGEN
+/**
+ * Bus load statistics. Load is in permille of the bit rate. It contains only
+ * uint32_t variables, so it is transferred as array of UNSIGNED32.
+ */
+typedef struct {
+    /** Layout: bits 0..7 number of histogram bins, bits 8..15 number of
+     * classes, bits 16..31 CO_CONFIG_STATS_BUSLOAD_WINDOW_MS */
+    uint32_t layout;
+    uint32_t windows; /**< Number of finished windows */
+    uint32_t load;    /**< Load in the last window */
+    uint32_t loadMax; /**< Maximum load in a window */
+    /** Histogram of load per window, bins of equal width from 0 to 1000
+     * permille, last bin counts also overload */
+    uint32_t hist[CO_CONFIG_STATS_BUSLOAD_BINS];
+    /** Number of frames by class, indexed by @ref CO_stats_class_t */
+    uint32_t frames[CO_STATS_CLASSES];
+    /** Load of each class in the last window */
+    uint32_t classLoad[CO_STATS_CLASSES];
+    /** Number of times, transmit limiter held back a frame */
+    uint32_t txHeld;
+} CO_stats_busLoad_t;
+#endif
+
+/**
+ * Statistics object
+ */
+typedef struct {
+    /** All statistics */
+    CO_stats_block_t block;
+    /** From CO_stats_init() */
+    CO_CANmodule_t *CANmodule;
+    /** CANerrorStatus from the previous CO_stats_process() */
+    uint16_t CANerrorStatusPrev;
+    /** True, if SYNC was processed and CO_process_TPDO() was not yet */
+    bool_t syncPending;
+    /** Value of CO_cycleCounter() at SYNC */
+    uint32_t syncCycles;
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD) || defined CO_DOXYGEN
+    /** Bus load statistics */
+    CO_stats_busLoad_t busLoad;
+    /** Bits of each class in the current window */
+    uint32_t windowBits[CO_STATS_CLASSES];
+    /** Time of the current window in microseconds */
+    uint32_t windowTime_us;
+    /** CAN bit rate in kbps, 0 if unknown, from CO_stats_setBitRate() */
+    uint16_t bitRate;
+#endif
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT) || defined CO_DOXYGEN
+    /** Ceiling of bus load in permille, 0 if limiter is disabled */
+    uint16_t txLimit;
+    /** Bits available in token bucket, may be negative */
+    int32_t tokens;
+    /** Remainder of token bucket fill, in millionths of bit */
+    uint32_t tokensFrac;
+#endif
+    /** Extension for OD object */
+    OD_extension_t OD_stats_ext;
+} CO_stats_t;
+
+
+/**
+ * Initialize statistics object.
+ *
+ * Function must be called in the communication reset section.
+ *
+ * @param stats This object will be initialized.
+ * @param CANmodule CAN device, which overflows and transmit buffers are
+ * observed. If CO_DRIVER_STATS is defined, CANmodule->stats is set to _stats_.
+ * @param OD_stats OD entry for statistics, @ref OD_INDEX_STATS, may be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_stats_init(CO_stats_t *stats,
+                               CO_CANmodule_t *CANmodule,
+                               OD_entry_t *OD_stats);
+
+
+/**
+ * Reset all statistics.
+ *
+ * @param stats This object.
+ */
+void CO_stats_reset(CO_stats_t *stats);
+
+
+/**
+ * Record one sample of the stage.
+ *
+ * @param stats This object, may be NULL.
+ * @param id Stage.
+ * @param cycles Measured time, difference of two CO_cycleCounter() values.
+ */
+void CO_stats_record(CO_stats_t *stats,
+                     CO_stats_stageId_t id,
+                     uint32_t cycles);
+
+
+/**
+ * Update CAN overflow counters from CAN module, finish bus load window and
+ * fill token bucket of the transmit limiter.
+ *
+ * Function is called from CO_process().
+ *
+ * @param stats This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - time until transmit limiter releases
+ * held frames, see CO_process(). Output is not changed, if limiter is not
+ * active. Parameter may be NULL.
+ */
+void CO_stats_process(CO_stats_t *stats,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us);
+
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD) || defined CO_DOXYGEN
+/**
+ * Set CAN bit rate for bus load calculation.
+ *
+ * Function is called by CO_CANopenInit() with bit rate from CO_CANinit().
+ * Application must call it again, if bit rate is changed later.
+ *
+ * @param stats This object.
+ * @param bitRate CAN bit rate in kbps, 0 disables load calculation and
+ * transmit limiter.
+ */
+static inline void CO_stats_setBitRate(CO_stats_t *stats, uint16_t bitRate) {
+    stats->bitRate = bitRate;
+}
+
+
+/**
+ * Get traffic class of the CAN frame.
+ *
+ * @param ident CAN-ID, bits above 11-bit identifier are ignored.
+ *
+ * @return @ref CO_stats_class_t.
+ */
+static inline CO_stats_class_t CO_stats_class(uint32_t ident) {
+    uint16_t id = (uint16_t)(ident & 0x07FFU);
+
+    if (id == 0x000U) { return CO_STATS_CLASS_NMT; }
+    if (id < 0x080U) { return CO_STATS_CLASS_OTHER; }
+    if (id == 0x080U) { return CO_STATS_CLASS_SYNC; }
+    if (id < 0x100U) { return CO_STATS_CLASS_EMCY; }
+    if (id == 0x100U) { return CO_STATS_CLASS_TIME; }
+    if (id < 0x180U) { return CO_STATS_CLASS_OTHER; }
+    if (id < 0x580U) { return CO_STATS_CLASS_PDO; }
+    if (id < 0x700U) { return CO_STATS_CLASS_SDO; }
+    if (id < 0x780U) { return CO_STATS_CLASS_HB; }
+    return CO_STATS_CLASS_OTHER;
+}
+
+
+/**
+ * Estimate length of standard CAN data frame on the bus.
+ *
+ * Length includes SOF, arbitration, control, data and CRC fields, delimiters,
+ * ACK, EOF, interframe space and worst case number of stuff bits.
+ *
+ * @param DLC Number of data bytes, 0 to 8, or to 64 with CO_CAN_FD. CAN FD
+ * frame is estimated as classical frame with the same data at nominal bit
+ * rate, upper bound without bit rate switch.
+ *
+ * @return Number of bits.
+ */
+static inline uint32_t CO_stats_frameBits(uint8_t DLC) {
+    /* 34 bits from SOF to the end of CRC are subject to bit stuffing */
+    uint32_t stuffed = 34U + 8U * DLC;
+    return stuffed + 13U + (stuffed - 1U) / 4U;
+}
+
+
+/**
+ * Record one CAN frame on the bus, see CO_STATS_CAN_FRAME().
+ *
+ * Must be called from CAN interrupt or with CO_LOCK_CAN_SEND() held,
+ * CO_stats_process() drains windowBits and fills tokens with the same lock.
+ *
+ * @param stats This object, may be NULL.
+ * @param ident CAN-ID, bits above 11-bit identifier are ignored.
+ * @param DLC Number of data bytes.
+ */
+static inline void CO_stats_frame(CO_stats_t *stats,
+                                  uint32_t ident,
+                                  uint8_t DLC)
+{
+    if (stats != NULL) {
+        CO_stats_class_t cls = CO_stats_class(ident);
+        uint32_t bits = CO_stats_frameBits(DLC);
+
+        stats->windowBits[cls] += bits;
+        stats->busLoad.frames[cls]++;
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT
+        if (stats->tokens > -(int32_t)CO_CONFIG_STATS_TX_LIMIT_BURST) {
+            stats->tokens -= (int32_t)bits;
+        }
+#endif
+    }
+}
+#endif /* (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD */
+
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT) || defined CO_DOXYGEN
+/**
+ * Check if CAN frame may be transmitted now, see CO_STATS_CAN_TX_ALLOWED().
+ *
+ * @param stats This object, may be NULL.
+ * @param ident CAN-ID, bits above 11-bit identifier are ignored.
+ *
+ * @return false, if limiter is active, frame is not real-time and token bucket
+ * is empty.
+ */
+static inline bool_t CO_stats_txAllowed(CO_stats_t *stats, uint32_t ident) {
+    if (stats == NULL || stats->txLimit == 0U || stats->bitRate == 0U
+        || stats->tokens > 0
+    ) {
+        return true;
+    }
+    switch (CO_stats_class(ident)) {
+    case CO_STATS_CLASS_EMCY:
+    case CO_STATS_CLASS_SDO:
+    case CO_STATS_CLASS_OTHER:
+        stats->busLoad.txHeld++;
+        return false;
+    default:
+        return true;
+    }
+}
+
+
+/**
+ * Check if transmit limiter holds frames back now, see
+ * CO_STATS_CAN_TX_HOLDING().
+ *
+ * @param stats This object, may be NULL.
+ *
+ * @return true, if limiter is active and token bucket is empty.
+ */
+static inline bool_t CO_stats_txHolding(CO_stats_t *stats) {
+    return stats != NULL && stats->txLimit != 0U && stats->bitRate != 0U
+           && stats->tokens <= 0;
+}
+#endif /* (CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT */
+
+
+/**
+ * Remember time of the SYNC. Called from CO_process_SYNC(), if SYNC was
+ * received or transmitted.
+ *
+ * @param stats This object.
+ */
+static inline void CO_stats_sync(CO_stats_t *stats) {
+    stats->syncCycles = CO_cycleCounter();
+    stats->syncPending = true;
+}
+
+
+/**
+ * Record latency from the SYNC, if SYNC is pending, and update maximum number
+ * of messages in CAN transmit buffers. Called at the end of CO_process_TPDO().
+ *
+ * @param stats This object.
+ */
+static inline void CO_stats_TPDOdone(CO_stats_t *stats) {
+    uint32_t txCount = stats->CANmodule->CANtxCount;
+
+    if (stats->syncPending) {
+        stats->syncPending = false;
+        CO_stats_record(stats, CO_STATS_SYNC_TPDO,
+                        CO_cycleCounter() - stats->syncCycles);
+    }
+    if (txCount > stats->block.txQueueMax) {
+        stats->block.txQueueMax = txCount;
+    }
+}
+
+
+/** @} */ /* CO_CANopen_301_stats */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE */
+
+#if (defined CO_DRIVER_STATS && ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE)) \
+    || defined CO_DOXYGEN
+/**
+ * Start measurement of CANrx_callback inside CAN driver. Macro declares local
+ * variable, so it must be used at the beginning of the block, which calls
+ * CANrx_callback. Macros are empty, if CO_DRIVER_STATS is not defined or
+ * statistics are disabled.
+ */
+#define CO_STATS_CAN_RX_BEGIN() uint32_t CO_statsCycles = CO_cycleCounter()
+
+/**
+ * Record execution time of CANrx_callback, see CO_STATS_CAN_RX_BEGIN().
+ *
+ * @param CANmodule CAN module object with _stats_ member.
+ */
+#define CO_STATS_CAN_RX_END(CANmodule) \
+    CO_stats_record((CO_stats_t *)(CANmodule)->stats, CO_STATS_CAN_RX, \
+                    CO_cycleCounter() - CO_statsCycles)
+#else
+#define CO_STATS_CAN_RX_BEGIN()
+#define CO_STATS_CAN_RX_END(CANmodule)
+#endif
+
+#if (defined CO_DRIVER_STATS && ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) \
+     && ((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD)) || defined CO_DOXYGEN
+/**
+ * Record CAN frame on the bus inside CAN driver. Driver must call it for each
+ * received frame, also if it is not accepted by any receive buffer, and for
+ * each transmitted frame. Macro is empty, if CO_DRIVER_STATS is not defined or
+ * bus load statistics are disabled.
+ *
+ * @param CANmodule CAN module object with _stats_ member.
+ * @param ident CAN-ID, bits above 11-bit identifier are ignored.
+ * @param DLC Number of data bytes.
+ */
+#define CO_STATS_CAN_FRAME(CANmodule, ident, DLC) \
+    CO_stats_frame((CO_stats_t *)(CANmodule)->stats, (ident), (DLC))
+#else
+#define CO_STATS_CAN_FRAME(CANmodule, ident, DLC)
+#endif
+
+#if (defined CO_DRIVER_STATS && ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) \
+     && ((CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT)) || defined CO_DOXYGEN
+/**
+ * Check inside CAN driver, if frame may be copied to CAN module, see
+ * CO_stats_txAllowed(). If not, driver keeps the frame in transmit buffer and
+ * tries again later, from transmit interrupt or from CO_CANmodule_process().
+ * Macro is true, if CO_DRIVER_STATS is not defined or limiter is disabled.
+ *
+ * @param CANmodule CAN module object with _stats_ member.
+ * @param ident CAN-ID, bits above 11-bit identifier are ignored.
+ */
+#define CO_STATS_CAN_TX_ALLOWED(CANmodule, ident) \
+    CO_stats_txAllowed((CO_stats_t *)(CANmodule)->stats, (ident))
+/**
+ * Check inside CAN driver, if transmit limiter holds frames back, see
+ * CO_stats_txHolding(). Then frames waiting in transmit buffers are held and
+ * CO_CANsend() may transmit allowed (real-time) frame directly, if CAN
+ * module is free. Macro is false, if CO_DRIVER_STATS is not defined or
+ * limiter is disabled.
+ *
+ * @param CANmodule CAN module object with _stats_ member.
+ */
+#define CO_STATS_CAN_TX_HOLDING(CANmodule) \
+    CO_stats_txHolding((CO_stats_t *)(CANmodule)->stats)
+#else
+#define CO_STATS_CAN_TX_ALLOWED(CANmodule, ident) (true)
+#define CO_STATS_CAN_TX_HOLDING(CANmodule) (false)
+#endif
+
+#endif /* CO_STATS_H */
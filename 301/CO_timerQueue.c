@@ -0,0 +1,163 @@
+/*
+ * Timer queue
+ *
+ * @file        CO_timerQueue.c
+ * @ingroup     CO_CANopen_301_timerQueue
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_timerQueue.h"
+
+#if (CO_CONFIG_TIMERQ) & CO_CONFIG_TIMERQ_ENABLE
+
+/* true, if deadline of the timer on heap position a is before b */
+static inline bool_t TQ_before(CO_timerQueue_t *tq, uint16_t a, uint16_t b) {
+    CO_timerQueue_item_t *items = tq->items;
+    uint32_t da = items[items[a].heapId].deadline;
+    uint32_t db = items[items[b].heapId].deadline;
+    return (int32_t)(da - db) < 0;
+}
+
+/* place timer id on heap position pos */
+static inline void TQ_place(CO_timerQueue_t *tq, uint16_t pos, uint16_t id) {
+    tq->items[pos].heapId = id;
+    tq->items[id].position = pos + 1;
+}
+
+static void TQ_siftUp(CO_timerQueue_t *tq, uint16_t pos) {
+    uint16_t id = tq->items[pos].heapId;
+
+    while (pos > 0) {
+        uint16_t parent = (pos - 1) / 2;
+        tq->items[pos].heapId = id; /* for TQ_before() */
+        if (!TQ_before(tq, pos, parent)) {
+            break;
+        }
+        TQ_place(tq, pos, tq->items[parent].heapId);
+        pos = parent;
+    }
+    TQ_place(tq, pos, id);
+}
+
+static void TQ_siftDown(CO_timerQueue_t *tq, uint16_t pos) {
+    uint16_t id = tq->items[pos].heapId;
+
+    for (;;) {
+        uint16_t child = 2 * pos + 1;
+        if (child >= tq->count) {
+            break;
+        }
+        if (child + 1 < tq->count && TQ_before(tq, child + 1, child)) {
+            child++;
+        }
+        tq->items[pos].heapId = id; /* for TQ_before() */
+        if (!TQ_before(tq, child, pos)) {
+            break;
+        }
+        TQ_place(tq, pos, tq->items[child].heapId);
+        pos = child;
+    }
+    TQ_place(tq, pos, id);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_timerQueue_init(CO_timerQueue_t *tq,
+                                    CO_timerQueue_item_t items[],
+                                    uint16_t size)
+{
+    /* verify arguments */
+    if (tq == NULL || (items == NULL && size > 0) || size == CO_TIMERQ_NONE) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    tq->items = items;
+    tq->size = size;
+    tq->count = 0;
+    tq->now_us = 0;
+    for (uint16_t i = 0; i < size; i++) {
+        items[i].position = 0;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_timerQueue_set(CO_timerQueue_t *tq, uint16_t id, uint32_t timeout_us) {
+    if (tq == NULL || id >= tq->size) {
+        return;
+    }
+
+    CO_timerQueue_item_t *item = &tq->items[id];
+    uint32_t deadlineOld = item->deadline;
+    item->deadline = tq->now_us + timeout_us;
+
+    if (item->position == 0) {
+        /* insert new timer at the end of the heap */
+        uint16_t pos = tq->count++;
+        TQ_place(tq, pos, id);
+        TQ_siftUp(tq, pos);
+    }
+    else if ((int32_t)(item->deadline - deadlineOld) < 0) {
+        TQ_siftUp(tq, item->position - 1);
+    }
+    else {
+        TQ_siftDown(tq, item->position - 1);
+    }
+}
+
+
+/******************************************************************************/
+void CO_timerQueue_remove(CO_timerQueue_t *tq, uint16_t id) {
+    if (tq == NULL || id >= tq->size || tq->items[id].position == 0) {
+        return;
+    }
+
+    uint16_t pos = tq->items[id].position - 1;
+    uint16_t last = --tq->count;
+    tq->items[id].position = 0;
+
+    if (pos != last) {
+        /* move the last timer into freed position and restore heap order */
+        uint16_t moved = tq->items[last].heapId;
+        TQ_place(tq, pos, moved);
+        TQ_siftUp(tq, pos);
+        TQ_siftDown(tq, tq->items[moved].position - 1);
+    }
+}
+
+
+/******************************************************************************/
+uint16_t CO_timerQueue_popExpired(CO_timerQueue_t *tq) {
+    if (tq == NULL || tq->count == 0) {
+        return CO_TIMERQ_NONE;
+    }
+
+    uint16_t id = tq->items[0].heapId;
+    if ((int32_t)(tq->items[id].deadline - tq->now_us) > 0) {
+        return CO_TIMERQ_NONE;
+    }
+
+    CO_timerQueue_remove(tq, id);
+    return id;
+}
+
+#endif /* (CO_CONFIG_TIMERQ) & CO_CONFIG_TIMERQ_ENABLE */
@@ -0,0 +1,176 @@
+/**
+ * Timer queue
+ *
+ * @file        CO_timerQueue.h
+ * @ingroup     CO_CANopen_301_timerQueue
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_TIMER_QUEUE_H
+#define CO_TIMER_QUEUE_H
+
+#include "301/CO_driver.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_TIMERQ
+#define CO_CONFIG_TIMERQ (0)
+#endif
+
+#if ((CO_CONFIG_TIMERQ) & CO_CONFIG_TIMERQ_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANopen_301_timerQueue Timer queue
+ * Sorted deadlines of many objects.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ *
+ * Timer queue is a binary min-heap of deadlines. Each timer is identified by
+ * its id (for example index of the object in array), from 0 to size-1. Queue
+ * has own time, which is increased by CO_timerQueue_advance(). Deadlines are
+ * compared relative to that time, so overflow of 32-bit microsecond counter is
+ * handled correctly. Timeouts must be shorter than 2^31 microseconds.
+ *
+ * Insertion, update and removal of the timer take O(log n) time, time to the
+ * next deadline is available in O(1). Functions are not thread safe.
+ */
+
+/** Returned by CO_timerQueue_popExpired(), if no timer expired */
+#define CO_TIMERQ_NONE 0xFFFFU
+
+/**
+ * Timer queue item. Array of items is used for two purposes: _deadline_ and
+ * _position_ belong to the timer with id equal to array index, _heapId_ is
+ * id of the timer at that position in the heap.
+ */
+typedef struct {
+    /** Deadline of the timer, in queue time */
+    uint32_t deadline;
+    /** Position of the timer in heap plus one, 0 if timer is not queued */
+    uint16_t position;
+    /** Id of the timer on this heap position */
+    uint16_t heapId;
+} CO_timerQueue_item_t;
+
+/**
+ * Timer queue object
+ */
+typedef struct {
+    /** Array of items of size _size_. Initialized by CO_timerQueue_init() */
+    CO_timerQueue_item_t *items;
+    /** Initialized by CO_timerQueue_init() */
+    uint16_t size;
+    /** Number of queued timers */
+    uint16_t count;
+    /** Current time of the queue in microseconds, may overflow */
+    uint32_t now_us;
+} CO_timerQueue_t;
+
+
+/**
+ * Initialize timer queue object, all timers are removed.
+ *
+ * @param tq This object will be initialized.
+ * @param items Array of size _size_ allocated externally.
+ * @param size Number of timers, less than CO_TIMERQ_NONE.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_timerQueue_init(CO_timerQueue_t *tq,
+                                    CO_timerQueue_item_t items[],
+                                    uint16_t size);
+
+
+/**
+ * Increase time of the timer queue.
+ *
+ * @param tq This object.
+ * @param timeDifference_us Time difference from previous function call.
+ */
+static inline void CO_timerQueue_advance(CO_timerQueue_t *tq,
+                                         uint32_t timeDifference_us)
+{
+    tq->now_us += timeDifference_us;
+}
+
+
+/**
+ * Set (insert or update) the timer.
+ *
+ * @param tq This object.
+ * @param id Id of the timer.
+ * @param timeout_us Deadline relative to the current queue time.
+ */
+void CO_timerQueue_set(CO_timerQueue_t *tq, uint16_t id, uint32_t timeout_us);
+
+
+/**
+ * Remove the timer, if queued.
+ *
+ * @param tq This object.
+ * @param id Id of the timer.
+ */
+void CO_timerQueue_remove(CO_timerQueue_t *tq, uint16_t id);
+
+
+/**
+ * Remove the first expired timer from the queue.
+ *
+ * @param tq This object.
+ *
+ * @return Id of the timer with the earliest deadline, which is not later than
+ * the current queue time, or CO_TIMERQ_NONE.
+ */
+uint16_t CO_timerQueue_popExpired(CO_timerQueue_t *tq);
+
+
+/**
+ * Calculate time to the earliest deadline.
+ *
+ * @param tq This object.
+ * @param [out] timerNext_us info to OS - see CO_process(). It is lowered, if
+ * the earliest deadline is closer. May be NULL.
+ */
+static inline void CO_timerQueue_timerNext(CO_timerQueue_t *tq,
+                                           uint32_t *timerNext_us)
+{
+    if (timerNext_us != NULL && tq->count > 0) {
+        uint32_t deadline = tq->items[tq->items[0].heapId].deadline;
+        int32_t diff = (int32_t)(deadline - tq->now_us);
+        uint32_t next = diff > 0 ? (uint32_t)diff : 0;
+        if (*timerNext_us > next) {
+            *timerNext_us = next;
+        }
+    }
+}
+
+/** @} */ /* CO_CANopen_301_timerQueue */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_TIMERQ) & CO_CONFIG_TIMERQ_ENABLE */
+
+#endif /* CO_TIMER_QUEUE_H */
@@ -0,0 +1,238 @@
+/*
+ * CANopen program download, CiA 302-3
+ *
+ * @file        CO_prgDownload.c
+ * @ingroup     CO_CANopen_302_prgDownload
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "302/CO_prgDownload.h"
+#include "301/crc16-ccitt.h"
+
+#if (CO_CONFIG_PRG_DOWNLOAD) & CO_CONFIG_PRG_DOWNLOAD_ENABLE
+
+/* Sub-index of the program in 1F50 and 1F57, only one program is supported */
+#define PRG_SUBINDEX 1
+
+
+/* Check, if flash finished the last operation. On error set status. */
+static bool_t flashReady(CO_prgDownload_t *prg) {
+    if (prg->flashBusy) {
+        CO_prgFlash_status_t st = CO_prgFlash_status(prg->flashModule);
+
+        if (st == CO_PRG_FLASH_BUSY) {
+            return false;
+        }
+        prg->flashBusy = false;
+        if (st != CO_PRG_FLASH_READY) {
+            prg->status = CO_PRG_DOWNLOAD_STATUS_WRITE_ERR;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * Custom function for writing OD object "Program data"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_write_1F50(OD_stream_t *stream, const void *buf,
+                           OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (stream->subIndex != PRG_SUBINDEX) {
+        return OD_writeOriginal(stream, buf, count, countWritten);
+    }
+
+    CO_prgDownload_t *prg = (CO_prgDownload_t *)stream->object;
+    const uint8_t *data = (const uint8_t *)buf;
+    OD_size_t n = 0;
+    bool_t last;
+
+    /* start of the new program, previous programming must be finished */
+    if (stream->dataOffset == 0) {
+        if (count == 0) {
+            return ODR_DATA_SHORT;
+        }
+        if (!flashReady(prg) && prg->flashBusy) {
+            *countWritten = 0;
+            return ODR_PARTIAL;
+        }
+        prg->bufFill = 0;
+        prg->bufCount = 0;
+        prg->flashAddr = 0;
+        prg->size = 0;
+        prg->crc = 0;
+        prg->status = CO_PRG_DOWNLOAD_STATUS_BUSY;
+        if (!CO_prgFlash_begin(prg->flashModule)) {
+            prg->status = CO_PRG_DOWNLOAD_STATUS_NOT_CLEARED;
+            return ODR_HW;
+        }
+        prg->flashBusy = true;
+    }
+    else if (prg->status != CO_PRG_DOWNLOAD_STATUS_BUSY) {
+        /* error during previous write */
+        return ODR_HW;
+    }
+    else { /* MISRA C 2004 14.10 */ }
+
+    for (;;) {
+        /* copy data into the filled buffer */
+        size_t len = CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE - prg->bufCount;
+        if (len > (size_t)(count - n)) {
+            len = count - n;
+        }
+        uint8_t *dest = &prg->buf[prg->bufFill][prg->bufCount];
+        memcpy(dest, &data[n], len);
+        prg->crc = crc16_ccitt(dest, len, prg->crc);
+        prg->bufCount += len;
+        n += (OD_size_t)len;
+
+        /* SDO server indicates the size on the last data */
+        last = stream->dataLength > 0
+               && (stream->dataOffset + n) >= stream->dataLength;
+
+        /* program the full buffer or the rest, swap buffers */
+        if ((prg->bufCount < CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE && !last)
+            || prg->bufCount == 0 || !flashReady(prg)
+        ) {
+            break;
+        }
+        if (!CO_prgFlash_program(prg->flashModule, prg->flashAddr,
+                                 prg->buf[prg->bufFill], prg->bufCount)
+        ) {
+            prg->status = CO_PRG_DOWNLOAD_STATUS_WRITE_ERR;
+            break;
+        }
+        prg->flashBusy = true;
+        prg->flashAddr += prg->bufCount;
+        prg->bufFill ^= 1;
+        prg->bufCount = 0;
+    }
+
+    stream->dataOffset += n;
+    prg->size += n;
+    *countWritten = n;
+
+    if (prg->status != CO_PRG_DOWNLOAD_STATUS_BUSY) {
+        return ODR_HW;
+    }
+    if (!last || prg->bufCount > 0 || !flashReady(prg)) {
+        /* SDO server repeats the write after the last data until finished */
+        return prg->status == CO_PRG_DOWNLOAD_STATUS_BUSY ? ODR_PARTIAL
+                                                           : ODR_HW;
+    }
+
+    stream->dataOffset = 0;
+    if (!CO_prgFlash_end(prg->flashModule, prg->size, prg->crc)) {
+        prg->status = CO_PRG_DOWNLOAD_STATUS_NO_PRG;
+        return ODR_DATA_TRANSF;
+    }
+    prg->status = 0;
+    return ODR_OK;
+}
+
+
+/*
+ * Custom function for reading OD object "Program data"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_1F50(OD_stream_t *stream, void *buf,
+                          OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (stream->subIndex != PRG_SUBINDEX) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    return ODR_WRITEONLY;
+}
+
+
+/*
+ * Custom function for reading OD object "Flash status identification"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_1F57(OD_stream_t *stream, void *buf,
+                          OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (stream->subIndex != PRG_SUBINDEX) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    if (count < sizeof(uint32_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_prgDownload_t *prg = (CO_prgDownload_t *)stream->object;
+
+    *countRead = CO_setUint32(buf, prg->status);
+    return ODR_OK;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_prgDownload_init(CO_prgDownload_t *prg,
+                                     void *flashModule,
+                                     OD_entry_t *OD_1F50_ProgramData,
+                                     OD_entry_t *OD_1F57_FlashStatus,
+                                     uint32_t *errInfo)
+{
+    /* verify arguments */
+    if (prg == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    if (OD_1F50_ProgramData == NULL) {
+        if (errInfo != NULL) {
+            *errInfo = OD_INDEX_PROGRAM_DATA;
+        }
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(prg, 0, sizeof(CO_prgDownload_t));
+    prg->flashModule = flashModule;
+
+    prg->OD_1F50_extension.object = prg;
+    prg->OD_1F50_extension.read = OD_read_1F50;
+    prg->OD_1F50_extension.write = OD_write_1F50;
+    OD_extension_init(OD_1F50_ProgramData, &prg->OD_1F50_extension);
+
+    if (OD_1F57_FlashStatus != NULL) {
+        prg->OD_1F57_extension.object = prg;
+        prg->OD_1F57_extension.read = OD_read_1F57;
+        prg->OD_1F57_extension.write = OD_writeOriginal;
+        OD_extension_init(OD_1F57_FlashStatus, &prg->OD_1F57_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+
+#endif /* (CO_CONFIG_PRG_DOWNLOAD) & CO_CONFIG_PRG_DOWNLOAD_ENABLE */
@@ -0,0 +1,163 @@
+/**
+ * CANopen program download, CiA 302-3
+ *
+ * @file        CO_prgDownload.h
+ * @ingroup     CO_CANopen_302_prgDownload
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_PRG_DOWNLOAD_H
+#define CO_PRG_DOWNLOAD_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+#include "301/CO_SDOserver.h"
+#include "302/CO_prgFlash.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_PRG_DOWNLOAD
+#define CO_CONFIG_PRG_DOWNLOAD (0)
+#endif
+#ifndef CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE
+#define CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE 256
+#endif
+
+#if ((CO_CONFIG_PRG_DOWNLOAD) & CO_CONFIG_PRG_DOWNLOAD_ENABLE) \
+    || defined CO_DOXYGEN
+
+#if !((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE)
+#error CO_CONFIG_CRC16_ENABLE must be enabled.
+#endif
+#if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK_FLOW)
+#error CO_CONFIG_SDO_SRV_BLOCK_FLOW must be enabled.
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANopen_302_prgDownload Program download
+ * Pipelined program download into flash with object 1F50.
+ *
+ * @ingroup CO_CANopen_302
+ * @{
+ *
+ * Program is downloaded with SDO block transfer into sub-index 1 of object
+ * 1F50 (Program data, DOMAIN). Data is collected into two buffers of size
+ * @ref CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE. When one buffer is full, its
+ * programming is started with CO_prgFlash_program(), which returns
+ * immediately, and the following data is received into the other buffer. So
+ * flash programming runs in parallel with the CAN transfer.
+ *
+ * If both buffers are in use, write function of 1F50 accepts only part of the
+ * data (see @ref CO_CONFIG_SDO_SRV_BLOCK_FLOW). Remaining data stays inside
+ * the SDO server buffer, so the next sub-block is smaller or its response is
+ * delayed until flash finishes. Flash speed therefore limits the transfer only
+ * when it is slower than the CAN bus. Block download end response is sent
+ * after the last data is programmed and CO_prgFlash_end() verified the
+ * program. CRC of the SDO block transfer is verified by the SDO server for
+ * each sub-block incrementally, so no data is read back.
+ *
+ * Segmented SDO download works the same way, but the buffer of the SDO
+ * server is written only when it is full, and segment response is delayed
+ * while flash is busy. SDO timeout of the client and server must be longer
+ * than the flash erase time.
+ *
+ * Optional object 1F57 (Flash status identification, sub-index 1) shows
+ * progress and error according to CiA 302-3. Functions specified by
+ * @ref CO_prgFlash.h file, must be defined by target system.
+ */
+
+/** Index of OD object "Program data" */
+#define OD_INDEX_PROGRAM_DATA 0x1F50
+/** Index of OD object "Flash status identification" */
+#define OD_INDEX_FLASH_STATUS 0x1F57
+
+/** Flash status (1F57), bit 0: programming is in progress */
+#define CO_PRG_DOWNLOAD_STATUS_BUSY 0x01UL
+/** Flash status (1F57), error in bits 1..7: no valid program */
+#define CO_PRG_DOWNLOAD_STATUS_NO_PRG (1UL << 1)
+/** Flash status (1F57), error in bits 1..7: flash not cleared */
+#define CO_PRG_DOWNLOAD_STATUS_NOT_CLEARED (4UL << 1)
+/** Flash status (1F57), error in bits 1..7: flash write error */
+#define CO_PRG_DOWNLOAD_STATUS_WRITE_ERR (5UL << 1)
+
+
+/**
+ * Program download object.
+ */
+typedef struct {
+    /** From CO_prgDownload_init() */
+    void *flashModule;
+    /** Extension for OD object 1F50 */
+    OD_extension_t OD_1F50_extension;
+    /** Extension for OD object 1F57 */
+    OD_extension_t OD_1F57_extension;
+    /** Two data buffers, one is filled, other is programmed */
+    uint8_t buf[2][CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE];
+    /** Index of the buffer, which is filled */
+    uint8_t bufFill;
+    /** Number of bytes in the filled buffer */
+    size_t bufCount;
+    /** True, if flash is busy with erase or programming of the other buffer */
+    bool_t flashBusy;
+    /** Address in flash for the next CO_prgFlash_program() */
+    size_t flashAddr;
+    /** Number of bytes of the program downloaded so far */
+    size_t size;
+    /** CRC16 CCITT of the downloaded data */
+    uint16_t crc;
+    /** Value of flash status (1F57), see CO_PRG_DOWNLOAD_STATUS_BUSY */
+    uint32_t status;
+} CO_prgDownload_t;
+
+
+/**
+ * Initialize program download object.
+ *
+ * Function must be called in the communication reset section.
+ *
+ * @param prg This object will be initialized.
+ * @param flashModule Pointer to flash module, passed to target system specific
+ * functions.
+ * @param OD_1F50_ProgramData OD entry for 0x1F50 -"Program data", entry is
+ * required.
+ * @param OD_1F57_FlashStatus OD entry for 0x1F57 -"Flash status
+ * identification", may be NULL.
+ * @param [out] errInfo If OD entry is not valid, index is written here.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_prgDownload_init(CO_prgDownload_t *prg,
+                                     void *flashModule,
+                                     OD_entry_t *OD_1F50_ProgramData,
+                                     OD_entry_t *OD_1F57_FlashStatus,
+                                     uint32_t *errInfo);
+
+/** @} */ /* CO_CANopen_302_prgDownload */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (CO_CONFIG_PRG_DOWNLOAD) & CO_CONFIG_PRG_DOWNLOAD_ENABLE */
+
+#endif /* CO_PRG_DOWNLOAD_H */
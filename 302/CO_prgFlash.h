@@ -0,0 +1,118 @@
+/**
+ * Flash interface for use with CO_prgDownload
+ *
+ * @file        CO_prgFlash.h
+ * @ingroup     CO_CANopen_302_prgDownload
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_PRG_FLASH_H
+#define CO_PRG_FLASH_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CO_CANopen_302_prgDownload
+ * @{
+ */
+
+/**
+ * Status of the flash, returned by CO_prgFlash_status()
+ */
+typedef enum {
+    CO_PRG_FLASH_READY = 0, /**< Last operation finished successfully */
+    CO_PRG_FLASH_BUSY = 1,  /**< Operation is in progress */
+    CO_PRG_FLASH_ERROR = 2  /**< Last operation failed */
+} CO_prgFlash_status_t;
+
+
+/**
+ * Start program download, target system specific function.
+ *
+ * It is called, when the first data of the new program is written to 1F50.
+ * Function may start erase of the program area and return immediately. Then
+ * CO_prgFlash_status() returns CO_PRG_FLASH_BUSY until flash is erased. After
+ * communication reset function may be called while the previous programming
+ * is still in progress, then it must wait for it or abort it.
+ *
+ * @param flashModule Pointer to flash module, from CO_prgDownload_init().
+ *
+ * @return true on success
+ */
+bool_t CO_prgFlash_begin(void *flashModule);
+
+
+/**
+ * Start programming block of data, target system specific function.
+ *
+ * Function is called only when CO_prgFlash_status() returned
+ * CO_PRG_FLASH_READY. It starts programming and returns immediately. Data
+ * buffer stays unchanged until CO_prgFlash_status() returns other than
+ * CO_PRG_FLASH_BUSY. Blocks follow each other, flashAddr of the first block is
+ * 0. Length of all blocks, except the last, is
+ * @ref CO_CONFIG_PRG_DOWNLOAD_BUF_SIZE.
+ *
+ * @param flashModule Pointer to flash module.
+ * @param flashAddr Address inside program area, where data will be programmed.
+ * @param data Pointer to data buffer which will be programmed.
+ * @param len Length of the data block.
+ *
+ * @return true on success
+ */
+bool_t CO_prgFlash_program(void *flashModule, size_t flashAddr,
+                           const uint8_t *data, size_t len);
+
+
+/**
+ * Get status of the last CO_prgFlash_begin() or CO_prgFlash_program(), target
+ * system specific function.
+ *
+ * @param flashModule Pointer to flash module.
+ *
+ * @return @ref CO_prgFlash_status_t
+ */
+CO_prgFlash_status_t CO_prgFlash_status(void *flashModule);
+
+
+/**
+ * Finish program download, target system specific function.
+ *
+ * It is called after all data is programmed. Function may verify the program
+ * and mark it valid.
+ *
+ * @param flashModule Pointer to flash module.
+ * @param size Size of the program in bytes.
+ * @param crc CRC16 CCITT of the program, see crc16_ccitt().
+ *
+ * @return true, if program is valid
+ */
+bool_t CO_prgFlash_end(void *flashModule, size_t size, uint16_t crc);
+
+/** @} */ /* CO_CANopen_302_prgDownload */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_PRG_FLASH_H */
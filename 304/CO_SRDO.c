@@ -44,6 +44,11 @@
 #define CO_SRDO_BITCMD_OPERATIONAL      (0x01U)
 #define CO_SRDO_BITCMD_CALC_CRC         (0x02U)
 
+/* Serialized SRDO configuration for CRC: informationDirection,
+ * safetyCycleTime, safetyRelatedValidationTime, two COB-IDs,
+ * mappedObjectsCount, then subindex and mapping for each mapped object */
+#define CO_SRDO_CRC_BUFFER_SIZE (13U + (CO_SRDO_MAX_MAPPED_ENTRIES * 5U))
+
 #if(C2000_PORT != 0)
 #pragma CODE_SECTION(CO_SRDO_receive_normal, "ramfuncs");
 #endif
@@ -278,19 +283,24 @@ static CO_ReturnError_t SRDO_configMap(CO_SRDO_t* SRDO,
     return CO_ERROR_NO;
 }
 
+/* Calculate CRC of SRDO configuration, communication and mapping parameters
+ * are first serialized into one buffer. */
 static uint16_t CO_SRDOcalcCrc(const CO_SRDO_t *SRDO){
-    uint16_t i,tmp_u16;
-    uint16_t result = 0x0000;
-    uint8_t buffer[4];
-    uint32_t cob, tmp_u32;
+    uint8_t buffer[CO_SRDO_CRC_BUFFER_SIZE];
+    uint16_t len = 0;
+    uint32_t cob;
     uint32_t map;
     ODR_t odRet;
-    
-    result = crc16_ccitt(&SRDO->CommPar_informationDirection, 1, result);
-    tmp_u16 = CO_SWAP_16(SRDO->CommPar_safetyCycleTime);
-    memcpy(&buffer[0], &tmp_u16, sizeof(tmp_u16));
-    result = crc16_ccitt(&buffer[0], 2, result);
-    result = crc16_ccitt(&SRDO->CommPar_safetyRelatedValidationTime, 1, result);
+    uint8_t mappedObjectsCount = SRDO->mappedObjectsCount;
+
+    /* count is verified on write, clamp it anyway to protect the buffer */
+    if (mappedObjectsCount > CO_SRDO_MAX_MAPPED_ENTRIES) {
+        mappedObjectsCount = CO_SRDO_MAX_MAPPED_ENTRIES;
+    }
+
+    buffer[len++] = SRDO->CommPar_informationDirection;
+    len += CO_setUint16(&buffer[len], CO_SWAP_16(SRDO->CommPar_safetyCycleTime));
+    buffer[len++] = SRDO->CommPar_safetyRelatedValidationTime;
 
     /* adjust COB-ID if the default is used
     Caution: if the node id changes and you are using the default COB-ID you have to recalculate the checksum
@@ -300,32 +310,42 @@ static uint16_t CO_SRDOcalcCrc(const CO_SRDO_t *SRDO){
     if(((cob&0x7FFU) == SRDO->defaultCOB_ID[0]) && (SRDO->nodeId <= 64U)){
         cob += (uint32_t)SRDO->nodeId*2;
     }
-    tmp_u32 = CO_SWAP_32(cob);
-    memcpy(&buffer[0], &tmp_u32, sizeof(tmp_u32));
-    result = crc16_ccitt(&buffer[0], 4, result);
+    len += CO_setUint32(&buffer[len], CO_SWAP_32(cob));
 
     cob = SRDO->CommPar_COB_ID2_inverted;
     if(((cob&0x7FFU) == SRDO->defaultCOB_ID[1]) && (SRDO->nodeId <= 64U)){
         cob += (uint32_t)SRDO->nodeId*2;
     }
-    tmp_u32 = CO_SWAP_32(cob);
-    memcpy(&buffer[0], &tmp_u32, sizeof(tmp_u32));
-    result = crc16_ccitt(&buffer[0], 4, result);
+    len += CO_setUint32(&buffer[len], CO_SWAP_32(cob));
 
-    result = crc16_ccitt(&SRDO->mappedObjectsCount, 1, result);
-    for(i = 0; i < SRDO->mappedObjectsCount;){
-        uint8_t subindex = i + 1U;
-        result = crc16_ccitt(&subindex, 1, result);
+    buffer[len++] = mappedObjectsCount;
+    for(uint8_t subindex = 1; subindex <= mappedObjectsCount; subindex++){
+        buffer[len++] = subindex;
         odRet = OD_get_u32(SRDO->SRDOMapPar, subindex, &map, true);
         if (odRet != ODR_OK) {
             map = 0;
         }
-        tmp_u32 = CO_SWAP_32(map);
-        memcpy(&buffer[0], &tmp_u32, sizeof(tmp_u32));
-        result = crc16_ccitt(&buffer[0], 4, result);
-        i = subindex;
+        len += CO_setUint32(&buffer[len], CO_SWAP_32(map));
     }
-    return result;
+    return crc16_ccitt(&buffer[0], len, 0x0000);
+}
+
+/* Verify, if each of length bytes in inverted is bit-inverted byte in normal.
+ * Bytes are compared four at a time. */
+static inline bool_t CO_SRDOisInverted(const uint8_t *normal,
+                                       const uint8_t *inverted,
+                                       CO_SRDO_size_t length)
+{
+    uint32_t diff = 0;
+    CO_SRDO_size_t i = 0;
+
+    for(; (i + 4U) <= length; i += 4U){
+        diff |= ~(CO_getUint32(&normal[i]) ^ CO_getUint32(&inverted[i]));
+    }
+    for(; i < length; i++){
+        diff |= ~((uint32_t)normal[i] ^ inverted[i]) & 0xFFU;
+    }
+    return diff == 0U;
 }
 
 
@@ -435,6 +455,7 @@ static ODR_t OD_write_SRDO_communicationParam(OD_stream_t *stream, const void *b
     else { /* MISRA C 2004 14.10 */ }
 
     SRDOGuard->configurationValid = CO_SRDO_INVALID;
+    SRDO->configCrcValid = false;
 
     /* write value to the original location in the Object Dictionary */
     return OD_writeOriginal(stream, bufCopy, count, countWritten);
@@ -466,7 +487,7 @@ static ODR_t OD_write_SRDO_mappingParam(OD_stream_t *stream, const void *buf,
     /* numberOfMappedObjects */
     if(stream->subIndex == 0U){
         uint8_t value = CO_getUint8(buf);
-        if((value > 16U) || (value & 1)){ /*only odd numbers are allowed*/
+        if((value > CO_SRDO_MAX_MAPPED_ENTRIES) || (value & 1)){ /*only odd numbers are allowed*/
             return ODR_MAP_LEN;  /* Number and length of object to be mapped exceeds SRDO length. */
         }
         SRDO->mappedObjectsCount = value;
@@ -477,8 +498,9 @@ static ODR_t OD_write_SRDO_mappingParam(OD_stream_t *stream, const void *buf,
         }
     }
     SRDOGuard->configurationValid = CO_SRDO_INVALID;
-    
-    
+    SRDO->configCrcValid = false;
+
+
     /* write value to the original location in the Object Dictionary */
     return OD_writeOriginal(stream, buf, count, countWritten);
 }
@@ -763,6 +785,12 @@ CO_ReturnError_t CO_SRDO_init(
         }
         return CO_ERROR_OD_PARAMETERS;
     }
+    if (numberOfMappedObjects > CO_SRDO_MAX_MAPPED_ENTRIES) {
+        if (errInfo != NULL) {
+            *errInfo = (((uint32_t)OD_getIndex(OD_138x_SRDOMapPar)) << 8) | 0U;
+        }
+        return CO_ERROR_OD_PARAMETERS;
+    }
     SRDO->mappedObjectsCount = numberOfMappedObjects;
 
     SRDO->OD_mappingParam_extension.object = SRDO;
@@ -803,10 +831,15 @@ void CO_SRDO_process(
     (void)timerNext_us; /* may be unused */
 
     if(commands & CO_SRDO_BITCMD_CALC_CRC){
-        uint16_t crcValue = CO_SRDOcalcCrc(SRDO);
+        /* CRC of own configuration changes only with writes to 0x1301+ or
+         * 0x1381+, so it is calculated only once after each change */
+        if(!SRDO->configCrcValid){
+            SRDO->configCrc = CO_SRDOcalcCrc(SRDO);
+            SRDO->configCrcValid = true;
+        }
         uint16_t crcSRDO = 0;
         odRet = OD_get_u16(SRDO->SRDOGuard->SRDO_CRC, SRDO->SRDO_Index+1, &crcSRDO, true);
-        if ((odRet != ODR_OK) || (crcSRDO != crcValue)) {
+        if ((odRet != ODR_OK) || (crcSRDO != SRDO->configCrc)) {
             SRDO->SRDOGuard->configurationValid = 0;
         }
     }
@@ -925,18 +958,12 @@ void CO_SRDO_process(
 
                     uint8_t** ppODdataByte_normal;
                     uint8_t** ppODdataByte_inverted;
-                    bool_t data_ok = true;
 
                     pSRDOdataByte_normal = &SRDO->CANrxData[0][0];
                     pSRDOdataByte_inverted = &SRDO->CANrxData[1][0];
-                    for(i = 0; i<SRDO->dataLength; i++){
-                        uint8_t invert = (uint8_t)(~pSRDOdataByte_inverted[i]);
-                        if(pSRDOdataByte_normal[i] != invert){
-                            data_ok = false;
-                            break;
-                        }
-                    }
-                    if(data_ok){
+                    if(CO_SRDOisInverted(pSRDOdataByte_normal,
+                                         pSRDOdataByte_inverted,
+                                         SRDO->dataLength)){
                         ppODdataByte_normal = &SRDO->mapPointer[0][0];
                         ppODdataByte_inverted = &SRDO->mapPointer[1][0];
 
@@ -1020,4 +1047,27 @@ void CO_SRDO_process(
     }
 }
 
+void CO_SRDO_processBatch(
+        CO_SRDO_t              *SRDO,
+        uint16_t                count,
+        uint8_t                 commands,
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us)
+{
+    if(SRDO == NULL){
+        return;
+    }
+
+    for(uint16_t i = 0; i < count; i++, SRDO++){
+        /* Skip invalid SRDOs quickly, CO_SRDO_process() would only clear
+         * already cleared flags */
+        if((commands == 0U) && (SRDO->valid == CO_SRDO_INVALID)
+           && !CO_FLAG_READ(SRDO->CANrxNew[0]) && !CO_FLAG_READ(SRDO->CANrxNew[1])
+        ){
+            continue;
+        }
+        CO_SRDO_process(SRDO, commands, timeDifference_us, timerNext_us);
+    }
+}
+
 #endif /* (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE */
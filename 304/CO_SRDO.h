@@ -131,6 +131,11 @@ typedef struct{
     /** From CO_SRDO_initCallbackPre() or NULL */
     void                   *functSignalObjectPre;
 #endif
+    /** CRC of the SRDO configuration, valid if configCrcValid is true. It is
+     * invalidated by writes to communication or mapping parameter. */
+    uint16_t                configCrc;
+    /** True, if configCrc is calculated from actual configuration */
+    bool_t                  configCrcValid;
     /** Extension for OD object */
     OD_extension_t OD_communicationParam_ext;
     OD_extension_t OD_mappingParam_extension;
@@ -285,6 +290,26 @@ void CO_SRDO_process(
         uint32_t                timeDifference_us,
         uint32_t               *timerNext_us);
 
+/**
+ * Process array of SRDO objects in one pass.
+ *
+ * Same as calling CO_SRDO_process() for each SRDO, but invalid SRDOs without
+ * received messages are skipped quickly. All SRDOs must use the same
+ * CO_SRDOGuard_t.
+ *
+ * @param SRDO Array of SRDO objects.
+ * @param count Number of SRDO objects in array.
+ * @param commands result from CO_SRDOGuard_process().
+ * @param timeDifference_us Time difference from previous function call in [microseconds].
+ * @param [out] timerNext_us info to OS.
+ */
+void CO_SRDO_processBatch(
+        CO_SRDO_t              *SRDO,
+        uint16_t                count,
+        uint8_t                 commands,
+        uint32_t                timeDifference_us,
+        uint32_t               *timerNext_us);
+
 /** @} */ /* CO_SRDO */
 
 #ifdef __cplusplus
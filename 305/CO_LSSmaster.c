@@ -56,6 +56,7 @@ typedef enum {
   CO_LSSmaster_COMMAND_INQUIRE_SERIAL,
   CO_LSSmaster_COMMAND_INQUIRE,
   CO_LSSmaster_COMMAND_IDENTIFY_FASTSCAN,
+  CO_LSSmaster_COMMAND_ASSIGN_ALL,
 } CO_LSSmaster_command_t;
 
 /*
@@ -1116,4 +1117,523 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
     return ret;
 }
 
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL
+/*
+ * LSS master assign all state machine
+ */
+typedef enum {
+  CO_LSSmaster_AA_STATE_CONFIRM,
+  CO_LSSmaster_AA_STATE_POSITION,
+  CO_LSSmaster_AA_STATE_BACKTRACK,
+  CO_LSSmaster_AA_STATE_SCAN,
+  CO_LSSmaster_AA_STATE_VERIFY,
+  CO_LSSmaster_AA_STATE_CFG_NODE_ID,
+  CO_LSSmaster_AA_STATE_CFG_STORE
+} CO_LSSmaster_aa_t;
+
+/* No part of LSS address */
+#define CO_LSSmaster_AA_NONE 0xFFU
+
+/*
+ * Helper function - next part of LSS address, which is not skipped, or
+ * CO_LSS_FASTSCAN_VENDOR_ID, if there is none
+ */
+static uint8_t CO_LSSmaster_AaNext(
+        const CO_LSSmaster_assignAll_t  *assign,
+        uint8_t                          lssSub)
+{
+    uint8_t i;
+
+    for (i = lssSub + 1; i <= CO_LSS_FASTSCAN_SERIAL; i++) {
+        if (assign->fastscan.scan[i] != CO_LSSmaster_FS_SKIP) {
+            return i;
+        }
+    }
+    return CO_LSS_FASTSCAN_VENDOR_ID;
+}
+
+/*
+ * Helper function - previous part of LSS address, which is not skipped, or
+ * CO_LSSmaster_AA_NONE, if there is none
+ */
+static uint8_t CO_LSSmaster_AaPrev(
+        const CO_LSSmaster_assignAll_t  *assign,
+        uint8_t                          lssSub)
+{
+    uint8_t i;
+
+    for (i = lssSub; i > CO_LSS_FASTSCAN_VENDOR_ID; i--) {
+        if (assign->fastscan.scan[i - 1] != CO_LSSmaster_FS_SKIP) {
+            return i - 1;
+        }
+    }
+    return CO_LSSmaster_AA_NONE;
+}
+
+/*
+ * Helper function - update measured response latency and step timeout.
+ *
+ * Only the first response of each request is seen, which is the fastest one,
+ * if many nodes respond. So step timeout is based on the peak latency, which
+ * decays slowly, and not on the average latency.
+ */
+static void CO_LSSmaster_AaLatency(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        uint32_t                         sample_us)
+{
+    uint32_t timeout_us;
+
+    if (assign->latency_us == 0) {
+        assign->latency_us = sample_us;
+    }
+    else {
+        int32_t err = (int32_t)sample_us - (int32_t)assign->latency_us;
+        assign->latency_us = (uint32_t)((int32_t)assign->latency_us + err / 8);
+    }
+
+    if (sample_us > assign->latencyMax_us) {
+        assign->latencyMax_us = sample_us;
+    }
+    else {
+        assign->latencyMax_us -= (assign->latencyMax_us - sample_us) / 32;
+    }
+
+    timeout_us = 2 * assign->latencyMax_us;
+    if (timeout_us < assign->fsTimeoutMin_us) {
+        timeout_us = assign->fsTimeoutMin_us;
+    }
+    if (timeout_us > LSSmaster->timeout_us) {
+        timeout_us = LSSmaster->timeout_us;
+    }
+    assign->fsTimeout_us = timeout_us;
+}
+
+/*
+ * Helper function - send fastscan request
+ */
+static void CO_LSSmaster_AaSend(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        CO_LSSmaster_aa_t                aaState,
+        uint32_t                         idNumber,
+        uint8_t                          bitCheck,
+        uint8_t                          lssSub,
+        uint8_t                          lssNext)
+{
+    assign->aaState = (uint8_t)aaState;
+    assign->sampled = false;
+    assign->fsRequests++;
+
+    LSSmaster->fsIdNumber = idNumber;
+    LSSmaster->fsBitChecked = bitCheck;
+    LSSmaster->fsLssSub = lssSub;
+    CO_LSSmaster_FsSendMsg(LSSmaster, idNumber, bitCheck, lssSub, lssNext);
+}
+
+/*
+ * Helper function - wait until step timeout expires
+ *
+ * All nodes, which match the request, respond, so we always have to wait for
+ * the whole step. Latency of the first response is measured.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaWait(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        uint32_t                         timeDifference_us)
+{
+    CO_LSSmaster_return_t ret = CO_LSSmaster_WAIT_SLAVE;
+
+    LSSmaster->timeoutTimer += timeDifference_us;
+
+    if (CO_FLAG_READ(LSSmaster->CANrxNew) && !assign->sampled) {
+        assign->sampled = true;
+        CO_LSSmaster_AaLatency(LSSmaster, assign, LSSmaster->timeoutTimer);
+    }
+
+    if (LSSmaster->timeoutTimer >= (assign->sweep ? LSSmaster->timeout_us
+                                                  : assign->fsTimeout_us)) {
+        LSSmaster->timeoutTimer = 0;
+        ret = CO_LSSmaster_SCAN_NOACK;
+
+        if (CO_FLAG_READ(LSSmaster->CANrxNew)) {
+            uint8_t cs = LSSmaster->CANrxData[0];
+            CO_FLAG_CLEAR(LSSmaster->CANrxNew);
+
+            if (cs == CO_LSS_IDENT_SLAVE) {
+                ret = CO_LSSmaster_SCAN_FINISHED;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*
+ * Helper function - reset fastscan on all unconfigured nodes
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaConfirm(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign)
+{
+    CO_LSSmaster_AaSend(LSSmaster, assign, CO_LSSmaster_AA_STATE_CONFIRM,
+                        0, CO_LSS_FASTSCAN_CONFIRM, 0, 0);
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+
+/*
+ * Helper function - no more nodes found in the trie. Repeat the search from
+ * scratch with non-adaptive timeout once, then finish.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaExhausted(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign)
+{
+    if (assign->sweep) {
+        return CO_LSSmaster_OK;
+    }
+    assign->sweep = true;
+    assign->previous = false;
+    return CO_LSSmaster_AaConfirm(LSSmaster, assign);
+}
+
+/*
+ * Helper function - start search for the part of LSS address from scratch
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaDescend(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        uint8_t                          lssSub)
+{
+    if (assign->fastscan.scan[lssSub] == CO_LSSmaster_FS_MATCH) {
+        CO_LSSmaster_AaSend(LSSmaster, assign, CO_LSSmaster_AA_STATE_VERIFY,
+                            assign->fastscan.match.addr[lssSub],
+                            CO_LSS_FASTSCAN_BIT0, lssSub,
+                            CO_LSSmaster_AaNext(assign, lssSub));
+    }
+    else {
+        CO_LSSmaster_AaSend(LSSmaster, assign, CO_LSSmaster_AA_STATE_SCAN,
+                            0, CO_LSS_FASTSCAN_BIT31, lssSub, lssSub);
+    }
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+
+/*
+ * Helper function - search for the next node in the trie
+ *
+ * The last found node is on the path fastscan.found. Each next node has
+ * higher LSS address, so it is in the subtree, where the path goes to bit 0
+ * and the other branch (bit 1) was not examined yet. The lowest such bit is
+ * searched first, from bit 'bit' of part 'lssSub' upwards. Nodes with equal
+ * upper parts of the address are already switched to 'lssSub'.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaBacktrack(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        uint8_t                          lssSub,
+        uint8_t                          bit)
+{
+    while (lssSub != CO_LSSmaster_AA_NONE) {
+        if (assign->fastscan.scan[lssSub] == CO_LSSmaster_FS_SCAN) {
+            uint32_t idNumber = assign->fastscan.found.addr[lssSub];
+
+            for ( ; bit <= CO_LSS_FASTSCAN_BIT31; bit++) {
+                if ((idNumber & (1UL << bit)) == 0) {
+                    /* Upper bits as before, this bit set, lower bits zero.
+                     * Verify request, if bit 0 is checked. */
+                    idNumber = (idNumber & (uint32_t)(0xFFFFFFFEUL << bit))
+                             | (uint32_t)(1UL << bit);
+                    CO_LSSmaster_AaSend(LSSmaster, assign,
+                        CO_LSSmaster_AA_STATE_BACKTRACK, idNumber, bit, lssSub,
+                        bit == CO_LSS_FASTSCAN_BIT0
+                            ? CO_LSSmaster_AaNext(assign, lssSub) : lssSub);
+                    return CO_LSSmaster_WAIT_SLAVE;
+                }
+            }
+        }
+        /* Subtree exhausted, nodes, which differ in this part of the address,
+         * are still in this part of fastscan, so continue with upper part */
+        lssSub = CO_LSSmaster_AaPrev(assign, lssSub);
+        bit = CO_LSS_FASTSCAN_BIT0;
+    }
+
+    return CO_LSSmaster_AaExhausted(LSSmaster, assign);
+}
+
+/*
+ * Helper function - verify parts of the path of the last found node, until
+ * the last part or until no node responds. Continue there with backtracking.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaPosition(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        uint8_t                          lssSub)
+{
+    uint8_t lssNext = CO_LSSmaster_AaNext(assign, lssSub);
+
+    if (lssNext == CO_LSS_FASTSCAN_VENDOR_ID) {
+        return CO_LSSmaster_AaBacktrack(LSSmaster, assign, lssSub,
+                                        CO_LSS_FASTSCAN_BIT0);
+    }
+    CO_LSSmaster_AaSend(LSSmaster, assign, CO_LSSmaster_AA_STATE_POSITION,
+                        assign->fastscan.found.addr[lssSub],
+                        CO_LSS_FASTSCAN_BIT0, lssSub, lssNext);
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+
+/*
+ * Helper function - part of LSS address is verified, continue with next part
+ * or with node-ID assignment
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaPartDone(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        uint8_t                          lssSub)
+{
+    uint8_t lssNext = CO_LSSmaster_AaNext(assign, lssSub);
+
+    assign->fastscan.found.addr[lssSub] = LSSmaster->fsIdNumber;
+
+    if (lssNext != CO_LSS_FASTSCAN_VENDOR_ID) {
+        return CO_LSSmaster_AaDescend(LSSmaster, assign, lssNext);
+    }
+
+    /* node is in LSS configuration state now */
+    assign->previous = true;
+    assign->sweep = false;
+    assign->aaState = (uint8_t)CO_LSSmaster_AA_STATE_CFG_NODE_ID;
+    LSSmaster->state = CO_LSSmaster_STATE_CFG_SLECTIVE;
+    LSSmaster->command = CO_LSSmaster_COMMAND_WAITING;
+    return CO_LSSmaster_configureNodeId(LSSmaster, 0, assign->nodeIdNext);
+}
+
+/*
+ * Helper function - evaluate response to the fastscan request
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaStep(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign,
+        bool_t                           ack)
+{
+    uint8_t lssSub = LSSmaster->fsLssSub;
+    uint8_t bit = LSSmaster->fsBitChecked;
+
+    switch (assign->aaState) {
+        case CO_LSSmaster_AA_STATE_CONFIRM:
+            if (!ack) {
+                return CO_LSSmaster_AaExhausted(LSSmaster, assign);
+            }
+            return assign->previous
+                 ? CO_LSSmaster_AaPosition(LSSmaster, assign,
+                                           CO_LSS_FASTSCAN_VENDOR_ID)
+                 : CO_LSSmaster_AaDescend(LSSmaster, assign,
+                                          CO_LSS_FASTSCAN_VENDOR_ID);
+
+        case CO_LSSmaster_AA_STATE_POSITION:
+            if (!ack) {
+                /* no more nodes with this part of address */
+                return CO_LSSmaster_AaBacktrack(LSSmaster, assign, lssSub,
+                                                CO_LSS_FASTSCAN_BIT0);
+            }
+            return CO_LSSmaster_AaPosition(LSSmaster, assign,
+                                      CO_LSSmaster_AaNext(assign, lssSub));
+
+        case CO_LSSmaster_AA_STATE_BACKTRACK:
+            if (!ack) {
+                return CO_LSSmaster_AaBacktrack(LSSmaster, assign, lssSub,
+                                                bit + 1);
+            }
+            if (bit == CO_LSS_FASTSCAN_BIT0) {
+                return CO_LSSmaster_AaPartDone(LSSmaster, assign, lssSub);
+            }
+            /* subtree is not empty, scan it */
+            bit--;
+            CO_LSSmaster_AaSend(LSSmaster, assign, CO_LSSmaster_AA_STATE_SCAN,
+                LSSmaster->fsIdNumber, bit, lssSub,
+                bit == CO_LSS_FASTSCAN_BIT0
+                    ? CO_LSSmaster_AaNext(assign, lssSub) : lssSub);
+            return CO_LSSmaster_WAIT_SLAVE;
+
+        case CO_LSSmaster_AA_STATE_SCAN:
+            if (ack && bit == CO_LSS_FASTSCAN_BIT0) {
+                /* last bit was requested together with verification */
+                return CO_LSSmaster_AaPartDone(LSSmaster, assign, lssSub);
+            }
+            if (!ack) {
+                LSSmaster->fsIdNumber |= 1UL << bit;
+            }
+            if (bit == CO_LSS_FASTSCAN_BIT0) {
+                CO_LSSmaster_AaSend(LSSmaster, assign,
+                    CO_LSSmaster_AA_STATE_VERIFY, LSSmaster->fsIdNumber,
+                    CO_LSS_FASTSCAN_BIT0, lssSub,
+                    CO_LSSmaster_AaNext(assign, lssSub));
+                return CO_LSSmaster_WAIT_SLAVE;
+            }
+            bit--;
+            CO_LSSmaster_AaSend(LSSmaster, assign, CO_LSSmaster_AA_STATE_SCAN,
+                LSSmaster->fsIdNumber, bit, lssSub,
+                bit == CO_LSS_FASTSCAN_BIT0
+                    ? CO_LSSmaster_AaNext(assign, lssSub) : lssSub);
+            return CO_LSSmaster_WAIT_SLAVE;
+
+        case CO_LSSmaster_AA_STATE_VERIFY:
+            if (ack) {
+                return CO_LSSmaster_AaPartDone(LSSmaster, assign, lssSub);
+            }
+            if (assign->fastscan.scan[lssSub] == CO_LSSmaster_FS_MATCH) {
+                /* no node matches, continue with upper part of address */
+                return CO_LSSmaster_AaBacktrack(LSSmaster, assign,
+                                CO_LSSmaster_AaPrev(assign, lssSub),
+                                CO_LSS_FASTSCAN_BIT0);
+            }
+            /* Scanned value does not match, some response was lost or came
+             * too late. Double the timeout, keep it as lower limit for the
+             * rest of the process and restart search from scratch. */
+            if (assign->retries == 0) {
+                return CO_LSSmaster_SCAN_FAILED;
+            }
+            assign->retries--;
+            assign->fsTimeout_us *= 2;
+            if (assign->fsTimeout_us > LSSmaster->timeout_us) {
+                assign->fsTimeout_us = LSSmaster->timeout_us;
+            }
+            assign->fsTimeoutMin_us = assign->fsTimeout_us;
+            assign->previous = false;
+            return CO_LSSmaster_AaConfirm(LSSmaster, assign);
+
+        default:
+            return CO_LSSmaster_INVALID_STATE;
+    }
+}
+
+/*
+ * Helper function - node-ID is assigned, report and search for the next node
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_AaAssigned(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_assignAll_t        *assign)
+{
+    CO_LSSmaster_switchStateDeselect(LSSmaster);
+
+    assign->nodeCount++;
+    if (assign->pFunctProgress != NULL) {
+        assign->pFunctProgress(assign->functProgressObject,
+                               assign->nodeIdNext, &assign->fastscan.found);
+    }
+
+    assign->retries = CO_LSSmaster_ASSIGN_ALL_RETRIES;
+    assign->nodeIdNext++;
+    if (assign->nodeIdNext > assign->nodeIdLast) {
+        return CO_LSSmaster_SCAN_FINISHED;
+    }
+
+    LSSmaster->command = CO_LSSmaster_COMMAND_ASSIGN_ALL;
+    return CO_LSSmaster_AaConfirm(LSSmaster, assign);
+}
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_assignAll(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us,
+        CO_LSSmaster_assignAll_t        *assign)
+{
+    CO_LSSmaster_return_t ret;
+
+    /* parameter validation */
+    if (LSSmaster==NULL || assign==NULL){
+        return CO_LSSmaster_ILLEGAL_ARGUMENT;
+    }
+
+    /* start the process */
+    if (LSSmaster->command == CO_LSSmaster_COMMAND_WAITING) {
+        uint8_t i;
+        uint8_t count = 0;
+
+        if (assign->fastscan.scan[0] == CO_LSSmaster_FS_SKIP
+            || assign->nodeIdNext < 1 || assign->nodeIdNext > 0x7F
+            || assign->nodeIdLast < assign->nodeIdNext
+            || assign->nodeIdLast > 0x7F
+        ) {
+            return CO_LSSmaster_ILLEGAL_ARGUMENT;
+        }
+        for (i = 0; i < (sizeof(assign->fastscan.scan)
+                         / sizeof(assign->fastscan.scan[0])); i++) {
+            if (assign->fastscan.scan[i] == CO_LSSmaster_FS_SKIP) {
+                count ++;
+            }
+            else if (assign->fastscan.scan[i] != CO_LSSmaster_FS_SCAN
+                     && assign->fastscan.scan[i] != CO_LSSmaster_FS_MATCH) {
+                return CO_LSSmaster_ILLEGAL_ARGUMENT;
+            }
+            else { /* MISRA C 2004 14.10 */ }
+        }
+        if (count > 2) {
+            return CO_LSSmaster_ILLEGAL_ARGUMENT;
+        }
+        if (LSSmaster->state != CO_LSSmaster_STATE_WAITING) {
+            return CO_LSSmaster_INVALID_STATE;
+        }
+
+        memset(&assign->fastscan.found, 0, sizeof(assign->fastscan.found));
+        assign->nodeCount = 0;
+        assign->fsRequests = 0;
+        assign->fsTimeout_us = LSSmaster->timeout_us;
+        assign->fsTimeoutMin_us = CO_LSSmaster_ASSIGN_ALL_TIMEOUT_MIN;
+        assign->latency_us = 0;
+        assign->latencyMax_us = 0;
+        assign->previous = false;
+        assign->sweep = false;
+        assign->retries = CO_LSSmaster_ASSIGN_ALL_RETRIES;
+
+        LSSmaster->command = CO_LSSmaster_COMMAND_ASSIGN_ALL;
+        return CO_LSSmaster_AaConfirm(LSSmaster, assign);
+    }
+
+    switch (assign->aaState) {
+        case CO_LSSmaster_AA_STATE_CFG_NODE_ID:
+            ret = CO_LSSmaster_configureNodeId(LSSmaster, timeDifference_us,
+                                               assign->nodeIdNext);
+            if (ret == CO_LSSmaster_OK) {
+                if (assign->store) {
+                    assign->aaState = (uint8_t)CO_LSSmaster_AA_STATE_CFG_STORE;
+                    ret = CO_LSSmaster_configureStore(LSSmaster, 0);
+                }
+                else {
+                    ret = CO_LSSmaster_AaAssigned(LSSmaster, assign);
+                }
+            }
+            break;
+        case CO_LSSmaster_AA_STATE_CFG_STORE:
+            ret = CO_LSSmaster_configureStore(LSSmaster, timeDifference_us);
+            if (ret == CO_LSSmaster_OK) {
+                ret = CO_LSSmaster_AaAssigned(LSSmaster, assign);
+            }
+            break;
+        default:
+            if (LSSmaster->command != CO_LSSmaster_COMMAND_ASSIGN_ALL) {
+                return CO_LSSmaster_INVALID_STATE;
+            }
+            ret = CO_LSSmaster_AaWait(LSSmaster, assign, timeDifference_us);
+            if (ret != CO_LSSmaster_WAIT_SLAVE) {
+                ret = CO_LSSmaster_AaStep(LSSmaster, assign,
+                                          ret == CO_LSSmaster_SCAN_FINISHED);
+            }
+            break;
+    }
+
+    if (ret != CO_LSSmaster_WAIT_SLAVE && ret != CO_LSSmaster_SCAN_FINISHED
+        && ret != CO_LSSmaster_OK
+    ) {
+        /* error, node may still be selected */
+        CO_LSSmaster_switchStateDeselect(LSSmaster);
+    }
+    else if (ret != CO_LSSmaster_WAIT_SLAVE) {
+        LSSmaster->command = CO_LSSmaster_COMMAND_WAITING;
+    }
+    else { /* MISRA C 2004 14.10 */ }
+    return ret;
+}
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL */
+
 #endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER */
@@ -50,6 +50,7 @@ extern "C" {
  * - Configure node ID
  * - Activate bit timing parameters
  * - Store configuration
+ * - Assign node-IDs to all unconfigured nodes, see CO_LSSmaster_assignAll()
  *
  * The LSS master is initalized during the CANopenNode initialization process.
  * Except for enabling the LSS master in the configurator, no further
@@ -467,6 +468,115 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
         uint32_t                         timeDifference_us,
         CO_LSSmaster_fastscan_t         *fastscan);
 
+
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL) || defined CO_DOXYGEN
+/**
+ * Lower limit for the adaptive fastscan step timeout of
+ * #CO_LSSmaster_assignAll() in microseconds.
+ */
+#ifndef CO_LSSmaster_ASSIGN_ALL_TIMEOUT_MIN
+#define CO_LSSmaster_ASSIGN_ALL_TIMEOUT_MIN 2000U /* us */
+#endif
+
+/**
+ * Number of times #CO_LSSmaster_assignAll() restarts the search for one node
+ * after inconsistent fastscan responses, before it gives up.
+ */
+#ifndef CO_LSSmaster_ASSIGN_ALL_RETRIES
+#define CO_LSSmaster_ASSIGN_ALL_RETRIES 3U
+#endif
+
+/**
+ * Parameters, progress and internal state of #CO_LSSmaster_assignAll()
+ *
+ * Members fastscan.scan, fastscan.match, nodeIdNext, nodeIdLast, store and
+ * optionally pFunctProgress must be set by the application before the first
+ * call. Other members are set by CO_LSSmaster_assignAll().
+ */
+typedef struct {
+    /** Selection of nodes, the same as for #CO_LSSmaster_IdentifyFastscan().
+     * Member found contains LSS address of the last assigned node. */
+    CO_LSSmaster_fastscan_t fastscan;
+    /** Node-ID, which will be assigned to the next found node */
+    uint8_t          nodeIdNext;
+    /** Last node-ID, which may be assigned, 1..127 */
+    uint8_t          nodeIdLast;
+    /** If true, configuration is stored on each node, see
+     * #CO_LSSmaster_configureStore() */
+    bool_t           store;
+    /** Number of nodes assigned in this run */
+    uint8_t          nodeCount;
+    /** Number of fastscan requests sent in this run */
+    uint16_t         fsRequests;
+    /** Current fastscan step timeout in microseconds */
+    uint32_t         fsTimeout_us;
+    /** Lower limit of fsTimeout_us, raised after inconsistent responses */
+    uint32_t         fsTimeoutMin_us;
+    /** Smoothed latency of fastscan responses in microseconds */
+    uint32_t         latency_us;
+    /** Peak latency of fastscan responses in microseconds, decays slowly */
+    uint32_t         latencyMax_us;
+    /** Optional function, called after node-ID was assigned to a node, or
+     * NULL. Called from CO_LSSmaster_assignAll(). */
+    void           (*pFunctProgress)(void *object,
+                                     uint8_t nodeId,
+                                     const CO_LSS_address_t *lssAddress);
+    /** Pointer to object passed to pFunctProgress */
+    void            *functProgressObject;
+    uint8_t          aaState;      /**< Internal state machine */
+    bool_t           previous;     /**< fastscan.found is valid trie path */
+    bool_t           sweep;        /**< Use non-adaptive timeout */
+    bool_t           sampled;      /**< Latency of current step is measured */
+    uint8_t          retries;      /**< Remaining restarts of the search */
+} CO_LSSmaster_assignAll_t;
+
+/**
+ * Assign node-IDs to all unconfigured nodes
+ *
+ * Function finds all unconfigured nodes, which match fastscan criteria, by
+ * the means of LSS fastscan. Each found node is assigned next node-ID,
+ * configuration is optionally stored and node is deselected. Node with
+ * assigned node-ID does not respond to fastscan anymore.
+ *
+ * Unlike repeated #CO_LSSmaster_IdentifyFastscan(), which scans complete LSS
+ * address for each node, this function traverses binary tree (trie) of LSS
+ * addresses depth first. Nodes are found in ascending order of LSS address,
+ * so only LSS address of the last found node is needed to continue: parts of
+ * the address shared with the next node are only verified and the search
+ * continues from the lowest bit, where the next node may differ. Nodes with
+ * equal vendor ID, product code, revision number and consecutive serial
+ * numbers are found with few requests.
+ *
+ * Each fastscan request waits for all responses, so its duration is the step
+ * timeout. This starts with the timeout from #CO_LSSmaster_changeTimeout()
+ * and adapts to twice the peak measured response latency, but not below
+ * @ref CO_LSSmaster_ASSIGN_ALL_TIMEOUT_MIN. On inconsistent responses the step
+ * timeout is doubled, kept as the lower limit, and search for the node is
+ * repeated. When no more nodes are found, search is repeated once
+ * from scratch with non-adaptive timeout, so slow nodes are not missed.
+ *
+ * This function needs that no node is selected when starting the process.
+ * Process can be aborted with #CO_LSSmaster_switchStateDeselect().
+ *
+ * Function must be called cyclically until it returns != #CO_LSSmaster_WAIT_SLAVE.
+ * Function is non-blocking.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds]. Zero when request is started.
+ * @param assign Parameters and progress, see #CO_LSSmaster_assignAll_t.
+ * @return #CO_LSSmaster_ILLEGAL_ARGUMENT, #CO_LSSmaster_INVALID_STATE,
+ * #CO_LSSmaster_WAIT_SLAVE, #CO_LSSmaster_OK (no more unconfigured nodes),
+ * #CO_LSSmaster_SCAN_FINISHED (nodeIdLast assigned, there may be more nodes),
+ * #CO_LSSmaster_SCAN_FAILED, #CO_LSSmaster_TIMEOUT,
+ * #CO_LSSmaster_OK_ILLEGAL_ARGUMENT, #CO_LSSmaster_OK_MANUFACTURER
+ */
+CO_LSSmaster_return_t CO_LSSmaster_assignAll(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us,
+        CO_LSSmaster_assignAll_t        *assign);
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL */
+
 /** @} */ /*@defgroup CO_LSSmaster*/
 
 #ifdef __cplusplus
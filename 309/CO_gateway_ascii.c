@@ -46,6 +46,29 @@
   #error CO_CONFIG_FIFO_ASCII_DATATYPES must be enabled.
  #endif
 #endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+ #if !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+  #error CO_CONFIG_GTW_ASCII_SDO must be enabled.
+ #endif
+ #if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL)
+  #error CO_CONFIG_SDO_CLI_POOL must be enabled.
+ #endif
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+ #if CO_GTWA_RESP_BUF_SIZE < (CO_GTWA_BIN_RESP_HEADER_SIZE + 8)
+  #error CO_GTWA_RESP_BUF_SIZE is too small for binary responses.
+ #endif
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+ /* maximum length of one notification line */
+ #define CO_GTWA_SUB_LINE_SIZE (24 + CO_CAN_DATA_MAX * 3)
+ #if CO_GTWA_RESP_BUF_SIZE < CO_GTWA_SUB_LINE_SIZE
+  #error CO_GTWA_RESP_BUF_SIZE is too small for subscription notifications.
+ #endif
+ #if CO_CONFIG_GTWA_SUB_COUNT > 255 || CO_CONFIG_GTWA_SUB_CAN_COUNT > 255
+  #error CO_CONFIG_GTWA_SUB_COUNT or CO_CONFIG_GTWA_SUB_CAN_COUNT too large.
+ #endif
+#endif
 
 /******************************************************************************/
 CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
@@ -117,6 +140,12 @@ CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
                  CO_CONFIG_GTWA_LOG_BUF_SIZE + 1);
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    CO_fifo_init(&gtwa->binFifo,
+                 &gtwa->binBuf[0],
+                 CO_CONFIG_GTWA_BIN_BUF_SIZE + 1);
+#endif
+
     return CO_ERROR_NO;
 }
 
@@ -136,6 +165,45 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
 }
 
 
+/******************************************************************************/
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+void CO_GTWA_initAsync(CO_GTWA_t* gtwa, CO_SDOclientPool_t *SDOpool) {
+    if (gtwa != NULL) {
+        memset(&gtwa->async[0], 0, sizeof(gtwa->async));
+        gtwa->SDOpool = SDOpool;
+    }
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC */
+
+
+/******************************************************************************/
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+CO_ReturnError_t CO_GTWA_initSubscribe(CO_GTWA_t* gtwa,
+                                       OD_t *OD,
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+                                       CO_HBconsumer_t *HBcons,
+#endif
+                                       CO_CANmodule_t *CANdevRx,
+                                       uint16_t CANdevRxIdx)
+{
+    /* verify arguments */
+    if (gtwa == NULL || OD == NULL || CANdevRx == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(&gtwa->sub[0], 0, sizeof(gtwa->sub));
+    gtwa->subOD = OD;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    gtwa->subHBcons = HBcons;
+#endif
+    gtwa->subCANdevRx = CANdevRx;
+    gtwa->subCANdevRxIdx = CANdevRxIdx;
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
 /******************************************************************************/
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
 void CO_GTWA_log_print(CO_GTWA_t* gtwa, const char *message) {
@@ -171,7 +239,7 @@ static const char CO_GTWA_helpString[] =
 "[<net>] set sdo_timeout <value>          # Configure SDO client time-out in ms.\n" \
 "[<net>] set sdo_block <0|1>              # Enable/disable SDO block transfer.\n" \
 "\n" \
-"help [datatype|lss]                      # Print this or datatype or lss help.\n" \
+"help [datatype|lss|subscribe]            # Print this or other help.\n" \
 "led                                      # Print status LEDs of this device.\n" \
 "log                                      # Print message log.\n" \
 "\n" \
@@ -186,7 +254,9 @@ static const char CO_GTWA_helpString[] =
 "* 'sdo_timeout' is in milliseconds, 500 by default. Block transfer is\n" \
 "  disabled by default.\n" \
 "* If '<net>' or '<node>' is not specified within commands, then value defined\n" \
-"  by 'set network' or 'set node' command is used.\r\n";
+"  by 'set network' or 'set node' command is used.\n" \
+"* '<subindex>*' (for example '1*' or '*') reads or writes all sub-objects of\n" \
+"  array or record from subindex on, non-standard. Use 'hex' datatype.\r\n";
 
 static const char CO_GTWA_helpStringDatatypes[] =
 "\nDatatypes:\n" \
@@ -222,6 +292,31 @@ static const char CO_GTWA_helpStringLss[] =
 "* <table_index>: 0=1000 kbit/s, 1=800 kbit/s, 2=500 kbit/s, 3=250 kbit/s,\n" \
 "                 4=125 kbit/s, 6=50 kbit/s, 7=20 kbit/s, 8=10 kbit/s, 9=auto\n" \
 "* <scanType>: 0=fastscan, 1=ignore, 2=match value in next parameter\r\n";
+
+static const char CO_GTWA_helpStringSub[] =
+"\nSubscribe commands, non-standard:\n" \
+"[<net>] subscribe pdo <COB-ID> [<interval_ms>]\n" \
+"                                       # Notify received CAN frame.\n" \
+"[<net>] subscribe od <index> <subindex> [<interval_ms>]\n" \
+"                                       # Notify change of local OD variable.\n" \
+"[[<net>] <node>] subscribe hb [<interval_ms>]\n" \
+"                                       # Notify heartbeat state of node.\n" \
+"[<net>] unsubscribe [<id>]             # Cancel one or all subscriptions.\n" \
+"\n" \
+"Response:\n" \
+"\"[\"<sequence>\"]\" <id> | OK | ERROR:<internal-error-code>\n" \
+"\n" \
+"Notifications:\n" \
+"\"!\" <id> pdo <COB-ID> <data>\n" \
+"\"!\" <id> od <index> <subindex> <data>\n" \
+"\"!\" <id> hb <node> unconfigured|unknown|timeout|initializing|\n" \
+"                   pre-operational|operational|stopped\n" \
+"\n" \
+"* Notification is printed, when data differs from the last one, but not more\n" \
+"  often than <interval_ms> (0 by default). Pending notifications are printed\n" \
+"  together, between responses. <data> is in 'hex' format.\n" \
+"* 'pdo' receives CAN frames, which are not received by other objects of this\n" \
+"  device. For own RPDOs subscribe their mapped OD variables.\r\n";
 #endif
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS
@@ -250,6 +345,21 @@ static inline uint32_t getU32(char *token, uint32_t min,
     return num;
 }
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE)
+/* Remove '*' from the end of subindex token, return true, if it was there.
+ * It requests complete access, '*' alone is the same as '0*'. */
+static bool_t getCompleteAccess(char *token) {
+    size_t len = strlen(token);
+
+    if (len > 0 && token[len - 1] == '*') {
+        token[len - 1] = '\0';
+        return true;
+    }
+    return false;
+}
+#endif
+
 /* Verify net and node, return true on error */
 static bool_t checkNetNode(CO_GTWA_t *gtwa,
                            int32_t net, int16_t node, uint8_t NodeMin,
@@ -401,6 +511,44 @@ static bool_t respBufTransfer(CO_GTWA_t *gtwa) {
 }
 
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+/* Write header of binary response frame into respBuf, return its size */
+static size_t binRespHeader(CO_GTWA_t *gtwa, uint8_t status, size_t dataLen) {
+    uint8_t *b = (uint8_t *)gtwa->respBuf;
+    size_t len = CO_GTWA_BIN_RESP_HEADER_SIZE - 3 + dataLen;
+
+    b[0] = CO_GTWA_BIN_SYNC;
+    b[1] = (uint8_t)len;
+    b[2] = (uint8_t)(len >> 8);
+    b[3] = (uint8_t)gtwa->sequence;
+    b[4] = (uint8_t)(gtwa->sequence >> 8);
+    b[5] = (uint8_t)(gtwa->sequence >> 16);
+    b[6] = (uint8_t)(gtwa->sequence >> 24);
+    b[7] = gtwa->binCmd;
+    b[8] = status;
+
+    return CO_GTWA_BIN_RESP_HEADER_SIZE;
+}
+
+
+/* Transfer binary response without data (status OK) or with uint32 code */
+static void responseBinary(CO_GTWA_t *gtwa, uint8_t status, uint32_t code) {
+    size_t dataLen = status == CO_GTWA_BIN_ST_OK ? 0 : 4;
+    uint8_t *b = (uint8_t *)gtwa->respBuf;
+    size_t count = binRespHeader(gtwa, status, dataLen);
+
+    if (dataLen > 0) {
+        b[count++] = (uint8_t)code;
+        b[count++] = (uint8_t)(code >> 8);
+        b[count++] = (uint8_t)(code >> 16);
+        b[count++] = (uint8_t)(code >> 24);
+    }
+    gtwa->respBufCount = count;
+    respBufTransfer(gtwa);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
+
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ERROR_DESC
 #ifndef CO_CONFIG_GTW_ASCII_ERROR_DESC_STRINGS
 #define CO_CONFIG_GTW_ASCII_ERROR_DESC_STRINGS
@@ -483,6 +631,13 @@ static void responseWithError(CO_GTWA_t *gtwa,
     int len = sizeof(errorDescs) / sizeof(errorDescs_t);
     const char *desc = "-";
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (gtwa->binary) {
+        responseBinary(gtwa, CO_GTWA_BIN_ST_ERROR, (uint32_t)respErrorCode);
+        return;
+    }
+#endif
+
     for (i = 0; i < len; i++) {
         const errorDescs_t *ed = &errorDescs[i];
         if((CO_GTWA_respErrorCode_t)ed->code == respErrorCode) {
@@ -505,6 +660,13 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
     int len = sizeof(errorDescsSDO) / sizeof(errorDescs_t);
     const char *desc = "-";
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (gtwa->binary) {
+        responseBinary(gtwa, CO_GTWA_BIN_ST_SDO_ABORT, (uint32_t)abortCode);
+        return;
+    }
+#endif
+
     for (i = 0; i < len; i++) {
         const errorDescs_t *ed = &errorDescsSDO[i];
         if((CO_SDO_abortCode_t)ed->code == abortCode) {
@@ -531,6 +693,12 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
 static inline void responseWithError(CO_GTWA_t *gtwa,
                                      CO_GTWA_respErrorCode_t respErrorCode)
 {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (gtwa->binary) {
+        responseBinary(gtwa, CO_GTWA_BIN_ST_ERROR, (uint32_t)respErrorCode);
+        return;
+    }
+#endif
     gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                   "[%"PRId32"] ERROR:%d\r\n",
                                   gtwa->sequence, respErrorCode);
@@ -542,6 +710,12 @@ static inline void responseWithErrorSDO(CO_GTWA_t *gtwa,
                                         CO_SDO_abortCode_t abortCode,
                                         bool_t postponed)
 {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (gtwa->binary) {
+        responseBinary(gtwa, CO_GTWA_BIN_ST_SDO_ABORT, (uint32_t)abortCode);
+        return;
+    }
+#endif
     if (!postponed) {
         gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                       "[%"PRId32"] ERROR:0x%08X\r\n",
@@ -560,6 +734,12 @@ static inline void responseWithErrorSDO(CO_GTWA_t *gtwa,
 
 
 static inline void responseWithOK(CO_GTWA_t *gtwa) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (gtwa->binary) {
+        responseBinary(gtwa, CO_GTWA_BIN_ST_OK, 0);
+        return;
+    }
+#endif
     gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                   "[%"PRId32"] OK\r\n",
                                   gtwa->sequence);
@@ -588,28 +768,843 @@ static void responseLSS(CO_GTWA_t *gtwa, CO_LSSmaster_return_t lss_ret) {
         else if (lss_ret == CO_LSSmaster_OK_MANUFACTURER) {
             respErrorCode = CO_GTWA_respErrorLSSmanufacturer;
         }
-        else {
-            respErrorCode = CO_GTWA_respErrorInternalState;
+        else {
+            respErrorCode = CO_GTWA_respErrorInternalState;
+        }
+        responseWithError(gtwa, respErrorCode);
+    }
+}
+#endif
+
+
+static inline void convertToLower(char *token, size_t maxCount) {
+    size_t i;
+    char *c = &token[0];
+
+    for (i = 0; i < maxCount; i++) {
+        if (*c == 0) {
+            break;
+        } else {
+            *c = (char)tolower((int)*c);
+        }
+        c++;
+    }
+}
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+/* Setup SDO client and initiate upload of gtwa->SDOindex/SDOsubIndex. */
+static CO_GTWA_respErrorCode_t sdoReadStart(CO_GTWA_t *gtwa) {
+    CO_SDO_return_t SDO_ret;
+
+    /* setup client */
+    SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
+                                 CO_CAN_ID_SDO_CLI + gtwa->node,
+                                 CO_CAN_ID_SDO_SRV + gtwa->node,
+                                 gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        return CO_GTWA_respErrorInternalState;
+    }
+
+    /* initiate upload */
+    SDO_ret = CO_SDOclientUploadInitiate(gtwa->SDO_C,
+                                         gtwa->SDOindex, gtwa->SDOsubIndex,
+                                         gtwa->SDOtimeoutTime,
+                                         gtwa->SDOblockTransferEnable);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        return CO_GTWA_respErrorInternalState;
+    }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+    CO_SDOclientCompleteAccess(gtwa->SDO_C, gtwa->SDOcomplete);
+#endif
+
+    /* indicate that gateway response didn't start yet */
+    gtwa->SDOdataCopyStatus = false;
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_READ;
+    return CO_GTWA_respErrorNone;
+}
+
+
+/* Setup SDO client, initiate download of gtwa->SDOindex/SDOsubIndex and copy
+ * (first part of) value from the command. *closed is set to 1, if value was
+ * closed with command delimiter. */
+static CO_GTWA_respErrorCode_t sdoWriteStart(CO_GTWA_t *gtwa, int8_t *closed) {
+    CO_fifo_st status;
+    CO_SDO_return_t SDO_ret;
+    size_t size;
+
+    /* setup client */
+    SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
+                                 CO_CAN_ID_SDO_CLI + gtwa->node,
+                                 CO_CAN_ID_SDO_SRV + gtwa->node,
+                                 gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        return CO_GTWA_respErrorInternalState;
+    }
+
+    /* initiate download */
+    SDO_ret =
+    CO_SDOclientDownloadInitiate(gtwa->SDO_C,
+                                 gtwa->SDOindex, gtwa->SDOsubIndex,
+                                 gtwa->SDOdataType->length,
+                                 gtwa->SDOtimeoutTime,
+                                 gtwa->SDOblockTransferEnable);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        return CO_GTWA_respErrorInternalState;
+    }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+    CO_SDOclientCompleteAccess(gtwa->SDO_C, gtwa->SDOcomplete);
+#endif
+
+    /* copy data from comm to the SDO buffer, according to data type */
+    size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
+                                           &gtwa->commFifo,
+                                           &status);
+    /* set to true, if command delimiter was found */
+    *closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+    /* set to true, if data are copied only partially */
+    gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+
+    /* is syntax error in command or size is zero or not the last token
+     * in command */
+    if ((status & CO_fifo_st_errMask) != 0 || size == 0
+        || (gtwa->SDOdataCopyStatus == false && *closed != 1)
+    ) {
+        return CO_GTWA_respErrorSyntax;
+    }
+
+    /* if data size was not known before and is known now, update SDO */
+    if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
+        CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
+    }
+
+    /* continue with state machine */
+    gtwa->stateTimeoutTmr = 0;
+    gtwa->state = CO_GTWA_ST_WRITE;
+    return CO_GTWA_respErrorNone;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) \
+    && ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+/* Copy data of binary SDO download from binFifo to SDO buffer */
+static void binCopyData(CO_GTWA_t *gtwa) {
+    while (gtwa->binRemain > 0) {
+        const uint8_t *buf;
+        size_t count = CO_fifo_readSpan(&gtwa->binFifo, &buf);
+
+        if (count > gtwa->binRemain) {
+            count = gtwa->binRemain;
+        }
+        count = CO_fifo_write(&gtwa->SDO_C->bufFifo, buf, count, NULL);
+        if (count == 0) {
+            break;
+        }
+        CO_fifo_readCommit(&gtwa->binFifo, count);
+        gtwa->binRemain -= count;
+    }
+    gtwa->SDOdataCopyStatus = gtwa->binRemain > 0;
+}
+
+
+/* Setup SDO client and initiate download of data from binary request */
+static CO_GTWA_respErrorCode_t binWriteStart(CO_GTWA_t *gtwa) {
+    CO_SDO_return_t SDO_ret;
+
+    if (gtwa->binRemain == 0) {
+        return CO_GTWA_respErrorSyntax;
+    }
+
+    /* setup client */
+    SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
+                                 CO_CAN_ID_SDO_CLI + gtwa->node,
+                                 CO_CAN_ID_SDO_SRV + gtwa->node,
+                                 gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        return CO_GTWA_respErrorInternalState;
+    }
+
+    /* initiate download, size is known */
+    SDO_ret = CO_SDOclientDownloadInitiate(gtwa->SDO_C,
+                                           gtwa->SDOindex, gtwa->SDOsubIndex,
+                                           gtwa->binRemain,
+                                           gtwa->SDOtimeoutTime,
+                                           gtwa->SDOblockTransferEnable);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        return CO_GTWA_respErrorInternalState;
+    }
+
+    binCopyData(gtwa);
+
+    /* continue with state machine */
+    gtwa->stateTimeoutTmr = 0;
+    gtwa->state = CO_GTWA_ST_WRITE;
+    return CO_GTWA_respErrorNone;
+}
+
+
+/* Transfer uploaded data in binary response frame, return remaining size of
+ * data in SDO buffer */
+static size_t binReadResponse(CO_GTWA_t *gtwa, bool_t end) {
+    uint8_t *b = (uint8_t *)gtwa->respBuf;
+    size_t count = CO_fifo_read(&gtwa->SDO_C->bufFifo,
+                                &b[CO_GTWA_BIN_RESP_HEADER_SIZE],
+                                CO_GTWA_RESP_BUF_SIZE
+                                    - CO_GTWA_BIN_RESP_HEADER_SIZE,
+                                NULL);
+    size_t fifoRemain = CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo);
+
+    if (end && fifoRemain == 0) {
+        binRespHeader(gtwa, CO_GTWA_BIN_ST_OK, count);
+        gtwa->state = CO_GTWA_ST_IDLE;
+    }
+    else {
+        binRespHeader(gtwa, CO_GTWA_BIN_ST_PARTIAL, count);
+    }
+    gtwa->respBufCount = CO_GTWA_BIN_RESP_HEADER_SIZE + count;
+    return fifoRemain;
+}
+#endif
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+/* Callback from SDO client pool, transfer finished */
+static void asyncDone(void *object, CO_SDOclientPool_request_t *req) {
+    CO_GTWA_async_t *as = (CO_GTWA_async_t *)object;
+
+    (void)req;
+    as->active = false;
+    as->done = true;
+}
+
+
+/* Return true, if new async command can be accepted */
+static bool_t asyncFree(CO_GTWA_t *gtwa) {
+    if (gtwa->SDOpool != NULL) {
+        for (int i = 0; i < CO_CONFIG_GTWA_ASYNC_COUNT; i++) {
+            if (!gtwa->async[i].active && !gtwa->async[i].done) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return true;
+}
+
+
+/* Return true, if async command for the node is in progress */
+static bool_t asyncNodeBusy(CO_GTWA_t *gtwa, uint8_t node) {
+    for (int i = 0; i < CO_CONFIG_GTWA_ASYNC_COUNT; i++) {
+        if (gtwa->async[i].active && gtwa->async[i].req.nodeId == node) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* Submit SDO command to the SDO client pool, if command is suitable. Data type,
+ * index, sub-index and node are in gtwa, value for download is read from
+ * commFifo. Return true, if command was accepted, *respErrorCode is set in
+ * case of error. */
+static bool_t asyncStart(CO_GTWA_t *gtwa, bool_t upload, int8_t *closed,
+                         CO_GTWA_respErrorCode_t *respErrorCode)
+{
+    CO_GTWA_async_t *as = NULL;
+
+    if (gtwa->SDOpool == NULL || gtwa->SDOdataType->length == 0
+        || gtwa->SDOdataType->length > CO_GTWA_ASYNC_DATA_SIZE
+    ) {
+        return false;
+    }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+    /* pool requests do not support complete access */
+    if (gtwa->SDOcomplete) {
+        return false;
+    }
+#endif
+    for (int i = 0; i < CO_CONFIG_GTWA_ASYNC_COUNT; i++) {
+        if (!gtwa->async[i].active && !gtwa->async[i].done) {
+            as = &gtwa->async[i];
+            break;
+        }
+    }
+    if (as == NULL) {
+        return false;
+    }
+
+    if (upload) {
+        as->req.bufSize = sizeof(as->data);
+    }
+    else {
+        /* copy value from comm, it must be the last token in command */
+        uint8_t buf[CO_GTWA_ASYNC_DATA_SIZE + 1];
+        CO_fifo_t fifo;
+        CO_fifo_st status;
+        size_t size;
+
+        CO_fifo_init(&fifo, &buf[0], sizeof(buf));
+        size = gtwa->SDOdataType->dataTypeScan(&fifo, &gtwa->commFifo,
+                                               &status);
+        *closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+        if ((status & (CO_fifo_st_errMask | CO_fifo_st_partial)) != 0
+            || size == 0 || *closed != 1
+        ) {
+            *respErrorCode = CO_GTWA_respErrorSyntax;
+            return true;
+        }
+        as->req.bufSize = CO_fifo_read(&fifo, &as->data[0],
+                                       sizeof(as->data), NULL);
+    }
+
+    as->sequence = gtwa->sequence;
+    as->dataType = gtwa->SDOdataType;
+    as->req.nodeId = gtwa->node;
+    as->req.index = gtwa->SDOindex;
+    as->req.subIndex = gtwa->SDOsubIndex;
+    as->req.upload = upload;
+    as->req.buf = &as->data[0];
+    as->req.SDOtimeoutTime_ms = gtwa->SDOtimeoutTime;
+    as->req.blockEnable = false;
+    as->req.pFunctDone = asyncDone;
+    as->req.functDoneObject = as;
+
+    if (CO_SDOclientPool_submit(gtwa->SDOpool, &as->req) != CO_ERROR_NO) {
+        *respErrorCode = CO_GTWA_respErrorInternalState;
+        return true;
+    }
+    as->active = true;
+    return true;
+}
+
+
+/* Print responses of finished async commands, unless other response is in
+ * progress. */
+static void asyncResponses(CO_GTWA_t *gtwa) {
+    /* responses of 'read', 'log', 'help' and 'led' may span multiple calls */
+    bool_t streaming = gtwa->state == CO_GTWA_ST_READ
+                     ? gtwa->SDOdataCopyStatus
+                     : gtwa->state >= CO_GTWA_ST_LOG;
+    uint32_t sequence = gtwa->sequence;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    bool_t binary = gtwa->binary;
+
+    gtwa->binary = false;
+#endif
+
+    for (int i = 0; i < CO_CONFIG_GTWA_ASYNC_COUNT; i++) {
+        CO_GTWA_async_t *as = &gtwa->async[i];
+
+        if (gtwa->respHold || streaming) {
+            break;
+        }
+        if (!as->done) {
+            continue;
+        }
+
+        gtwa->sequence = as->sequence;
+        if (as->req.abortCode != CO_SDO_AB_NONE) {
+            responseWithErrorSDO(gtwa, as->req.abortCode, false);
+        }
+        else if (!as->req.upload) {
+            responseWithOK(gtwa);
+        }
+        else {
+            uint8_t buf[CO_GTWA_ASYNC_DATA_SIZE + 1];
+            CO_fifo_t fifo;
+            size_t count;
+
+            CO_fifo_init(&fifo, &buf[0], sizeof(buf));
+            CO_fifo_write(&fifo, &as->data[0], as->req.sizeTransferred, NULL);
+
+            count = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE - 2,
+                             "[%"PRId32"] ", gtwa->sequence);
+            do {
+                size_t n = as->dataType->dataTypePrint(&fifo,
+                                    &gtwa->respBuf[count],
+                                    CO_GTWA_RESP_BUF_SIZE - 2 - count,
+                                    true);
+                if (n == 0) {
+                    break;
+                }
+                count += n;
+            } while (CO_fifo_getOccupied(&fifo) > 0);
+            count += sprintf(&gtwa->respBuf[count], "\r\n");
+            gtwa->respBufCount = count;
+            respBufTransfer(gtwa);
+        }
+        as->done = false;
+    }
+    gtwa->sequence = sequence;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    gtwa->binary = binary;
+#endif
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+/* Receive CAN frame for 'subscribe pdo'. Function is called from the CAN
+ * receive interrupt, newer frame overwrites unprocessed one. */
+static void subReceive(void *object, void *msg) {
+    CO_GTWA_sub_t *sub = (CO_GTWA_sub_t *)object;
+    uint8_t DLC = CO_CANrxMsg_readDLC(msg);
+    const uint8_t *data = CO_CANrxMsg_readData(msg);
+
+    if (sub->type == CO_GTWA_SUB_PDO) {
+        if (DLC > CO_CAN_DATA_MAX) {
+            DLC = CO_CAN_DATA_MAX;
+        }
+        sub->CANrxDLC = DLC;
+        memcpy(&sub->CANrxData[0], data, DLC);
+        CO_FLAG_SET(sub->CANrxNew);
+    }
+}
+
+
+/* Read current data of the subscription and set pending, if data differs from
+ * the previous. */
+static void subSample(CO_GTWA_t *gtwa, CO_GTWA_sub_t *sub) {
+    uint8_t buf[CO_CAN_DATA_MAX];
+    uint8_t len = 0;
+
+    switch (sub->type) {
+    case CO_GTWA_SUB_PDO: {
+        if (!CO_FLAG_READ(sub->CANrxNew)) {
+            return;
+        }
+        len = sub->CANrxDLC;
+        memcpy(&buf[0], &sub->CANrxData[0], len);
+        CO_FLAG_CLEAR(sub->CANrxNew);
+        break;
+    }
+    case CO_GTWA_SUB_OD: {
+        OD_size_t countRd = 0;
+        ODR_t odRet;
+
+        sub->io.stream.dataOffset = 0;
+        CO_LOCK_OD(gtwa->subCANdevRx);
+        odRet = sub->io.read(&sub->io.stream, &buf[0], sub->dataLength,
+                             &countRd);
+        CO_UNLOCK_OD(gtwa->subCANdevRx);
+        if (odRet != ODR_OK || countRd != sub->dataLength) {
+            return;
+        }
+        len = (uint8_t)countRd;
+        break;
+    }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    case CO_GTWA_SUB_HB: {
+        CO_HBconsumer_t *HBcons = gtwa->subHBcons;
+
+        buf[0] = (uint8_t)CO_HBconsumer_UNCONFIGURED;
+        buf[1] = (uint8_t)CO_NMT_UNKNOWN;
+        for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+            CO_HBconsNode_t *monitoredNode = &HBcons->monitoredNodes[i];
+
+            if (monitoredNode->nodeId == sub->id) {
+                buf[0] = (uint8_t)monitoredNode->HBstate;
+                buf[1] = (uint8_t)monitoredNode->NMTstate;
+                break;
+            }
+        }
+        len = 2;
+        break;
+    }
+#endif
+    default:
+        return;
+    }
+
+    if (len != sub->dataLength || memcmp(&buf[0], &sub->data[0], len) != 0) {
+        memcpy(&sub->data[0], &buf[0], len);
+        sub->dataLength = len;
+        sub->pending = true;
+    }
+}
+
+
+/* Add new subscription and read its initial data. */
+static CO_GTWA_respErrorCode_t subAdd(CO_GTWA_t *gtwa,
+                                      CO_GTWA_subType_t type,
+                                      uint16_t id,
+                                      uint8_t subIndex,
+                                      uint16_t interval_ms,
+                                      uint8_t *subId)
+{
+    CO_GTWA_sub_t *sub = NULL;
+    uint8_t i;
+
+    for (i = 0; i < CO_CONFIG_GTWA_SUB_COUNT; i++) {
+        if (gtwa->sub[i].type == CO_GTWA_SUB_NONE) {
+            sub = &gtwa->sub[i];
+            break;
+        }
+    }
+    if (sub == NULL) {
+        return CO_GTWA_respErrorRunningOutOfMemory;
+    }
+    memset(sub, 0, sizeof(*sub));
+
+    if (type == CO_GTWA_SUB_PDO) {
+        uint8_t slot;
+        CO_ReturnError_t ret;
+
+        /* find free CAN receive buffer */
+        for (slot = 0; slot < CO_CONFIG_GTWA_SUB_CAN_COUNT; slot++) {
+            bool_t used = false;
+
+            for (uint8_t j = 0; j < CO_CONFIG_GTWA_SUB_COUNT; j++) {
+                if (gtwa->sub[j].type == CO_GTWA_SUB_PDO
+                    && gtwa->sub[j].CANslot == slot
+                ) {
+                    used = true;
+                    break;
+                }
+            }
+            if (!used) {
+                break;
+            }
+        }
+        if (slot >= CO_CONFIG_GTWA_SUB_CAN_COUNT) {
+            return CO_GTWA_respErrorRunningOutOfMemory;
+        }
+
+        ret = CO_CANrxBufferInit(
+                gtwa->subCANdevRx,      /* CAN device */
+                gtwa->subCANdevRxIdx + slot, /* rx buffer index */
+                id,                     /* CAN identifier */
+                0x7FF,                  /* mask */
+                0,                      /* rtr */
+                (void*)sub,             /* object passed to receive function */
+                subReceive);            /* this function will process rx msg */
+        if (ret != CO_ERROR_NO) {
+            return CO_GTWA_respErrorCANinit;
+        }
+        sub->CANslot = slot;
+    }
+    else if (type == CO_GTWA_SUB_OD) {
+        OD_entry_t *entry = OD_find(gtwa->subOD, id);
+
+        if (OD_getSub(entry, subIndex, &sub->io, false) != ODR_OK
+            || sub->io.stream.dataLength == 0
+            || sub->io.stream.dataLength > CO_CAN_DATA_MAX
+        ) {
+            return CO_GTWA_respErrorReqNotSupported;
+        }
+        sub->dataLength = (uint8_t)sub->io.stream.dataLength;
+    }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    else if (type == CO_GTWA_SUB_HB) {
+        if (gtwa->subHBcons == NULL) {
+            return CO_GTWA_respErrorReqNotSupported;
+        }
+    }
+#endif
+    else {
+        return CO_GTWA_respErrorReqNotSupported;
+    }
+
+    sub->id = id;
+    sub->subIndex = subIndex;
+    sub->interval_us = (uint32_t)interval_ms * 1000;
+    sub->timer_us = sub->interval_us;
+    sub->type = type;
+
+    /* first notification contains present value, except for CAN frames */
+    subSample(gtwa, sub);
+    sub->pending = type != CO_GTWA_SUB_PDO;
+
+    *subId = i;
+    return CO_GTWA_respErrorNone;
+}
+
+
+/* Cancel subscription. */
+static void subCancel(CO_GTWA_t *gtwa, CO_GTWA_sub_t *sub) {
+    if (sub->type == CO_GTWA_SUB_PDO) {
+        /* Disable reception, same as for disabled RPDO. Receive function
+         * ignores frames for free entry. */
+        CO_CANrxBufferInit(gtwa->subCANdevRx,
+                           gtwa->subCANdevRxIdx + sub->CANslot,
+                           0, 0x7FF, 0, (void*)sub, subReceive);
+        CO_FLAG_CLEAR(sub->CANrxNew);
+    }
+    sub->type = CO_GTWA_SUB_NONE;
+    sub->pending = false;
+}
+
+
+/* Print notification line into buf, return number of characters. */
+static size_t subPrint(CO_GTWA_sub_t *sub, uint8_t subId,
+                       char *buf, size_t size)
+{
+    size_t count = 0;
+
+    switch (sub->type) {
+    case CO_GTWA_SUB_PDO: {
+        count = snprintf(buf, size, "! %d pdo 0x%03X", subId, sub->id);
+        break;
+    }
+    case CO_GTWA_SUB_OD: {
+        count = snprintf(buf, size, "! %d od 0x%04X 0x%02X",
+                         subId, sub->id, sub->subIndex);
+        break;
+    }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    case CO_GTWA_SUB_HB: {
+        const char *state;
+
+        switch (sub->data[0]) {
+        case CO_HBconsumer_UNKNOWN: state = "unknown"; break;
+        case CO_HBconsumer_TIMEOUT: state = "timeout"; break;
+        case CO_HBconsumer_ACTIVE:
+            switch ((int8_t)sub->data[1]) {
+            case CO_NMT_INITIALIZING: state = "initializing"; break;
+            case CO_NMT_PRE_OPERATIONAL: state = "pre-operational"; break;
+            case CO_NMT_OPERATIONAL: state = "operational"; break;
+            case CO_NMT_STOPPED: state = "stopped"; break;
+            default: state = "unknown"; break;
+            }
+            break;
+        default: state = "unconfigured"; break;
+        }
+        return snprintf(buf, size, "! %d hb %d %s\r\n", subId, sub->id, state);
+    }
+#endif
+    default:
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < sub->dataLength; i++) {
+        count += snprintf(&buf[count], size - count, " %02X", sub->data[i]);
+    }
+    count += snprintf(&buf[count], size - count, "\r\n");
+    return count;
+}
+
+
+/* Sample all subscriptions and print pending notifications together, if
+ * interval has expired and no other response is in progress. */
+static void subNotify(CO_GTWA_t *gtwa,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us)
+{
+    /* responses of 'read', 'log', 'help' and 'led' may span multiple calls */
+    bool_t streaming = gtwa->state >= CO_GTWA_ST_LOG;
+    size_t count = 0;
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    if (gtwa->state == CO_GTWA_ST_READ) {
+        streaming = gtwa->SDOdataCopyStatus;
+    }
+#endif
+
+    for (uint8_t i = 0; i < CO_CONFIG_GTWA_SUB_COUNT; i++) {
+        CO_GTWA_sub_t *sub = &gtwa->sub[i];
+
+        if (sub->type == CO_GTWA_SUB_NONE) {
+            continue;
+        }
+
+        if (sub->timer_us < sub->interval_us) {
+            uint32_t diff = sub->interval_us - sub->timer_us;
+            sub->timer_us = (diff > timeDifference_us)
+                          ? sub->timer_us + timeDifference_us
+                          : sub->interval_us;
+        }
+
+        subSample(gtwa, sub);
+        if (!sub->pending) {
+            continue;
+        }
+
+        if (sub->timer_us < sub->interval_us) {
+            /* rate limit, print later */
+            uint32_t diff = sub->interval_us - sub->timer_us;
+            if (timerNext_us != NULL && *timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+            continue;
+        }
+        if (streaming || gtwa->respHold) {
+            continue;
+        }
+
+        /* transfer collected notifications, if next may not fit */
+        if ((CO_GTWA_RESP_BUF_SIZE - count) < CO_GTWA_SUB_LINE_SIZE) {
+            gtwa->respBufCount = count;
+            respBufTransfer(gtwa);
+            count = 0;
+            if (gtwa->respHold) {
+                continue;
+            }
+        }
+
+        count += subPrint(sub, i, &gtwa->respBuf[count],
+                          CO_GTWA_RESP_BUF_SIZE - count);
+        sub->pending = false;
+        sub->timer_us = 0;
+    }
+
+    if (count > 0) {
+        gtwa->respBufCount = count;
+        respBufTransfer(gtwa);
+    }
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+/* Read binary request frames from binFifo and start commands, while gateway
+ * is idle */
+static void binaryParse(CO_GTWA_t *gtwa) {
+    while (gtwa->state == CO_GTWA_ST_IDLE && gtwa->respHold == false) {
+        uint8_t *h = &gtwa->binHeader[0];
+        CO_GTWA_respErrorCode_t respErrorCode = CO_GTWA_respErrorNone;
+        uint16_t len;
+        uint8_t node;
+
+        /* skip the rest of the discarded frame */
+        while (gtwa->binDiscard > 0) {
+            uint8_t c;
+            if (!CO_fifo_getc(&gtwa->binFifo, &c)) {
+                return;
+            }
+            gtwa->binDiscard--;
+        }
+
+        /* search for start of frame and read the header */
+        while (gtwa->binHeaderCount == 0) {
+            uint8_t c;
+            if (!CO_fifo_getc(&gtwa->binFifo, &c)) {
+                return;
+            }
+            if (c == CO_GTWA_BIN_SYNC) {
+                h[gtwa->binHeaderCount++] = c;
+            }
+        }
+        gtwa->binHeaderCount += (uint8_t)CO_fifo_read(&gtwa->binFifo,
+                                    &h[gtwa->binHeaderCount],
+                                    CO_GTWA_BIN_REQ_HEADER_SIZE
+                                        - gtwa->binHeaderCount,
+                                    NULL);
+        if (gtwa->binHeaderCount < CO_GTWA_BIN_REQ_HEADER_SIZE) {
+            return;
         }
-        responseWithError(gtwa, respErrorCode);
-    }
-}
+        gtwa->binHeaderCount = 0;
+
+        len = (uint16_t)h[1] | ((uint16_t)h[2] << 8);
+        gtwa->sequence = (uint32_t)h[3] | ((uint32_t)h[4] << 8)
+                       | ((uint32_t)h[5] << 16) | ((uint32_t)h[6] << 24);
+        gtwa->binCmd = h[7];
+        node = h[8];
+        gtwa->binary = true;
+        gtwa->binRemain = 0;
+
+        if (len < (CO_GTWA_BIN_REQ_HEADER_SIZE - 3)) {
+            responseWithError(gtwa, CO_GTWA_respErrorSyntax);
+            continue;
+        }
+        gtwa->binRemain = len - (CO_GTWA_BIN_REQ_HEADER_SIZE - 3);
+
+        switch (gtwa->binCmd) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+        case CO_GTWA_BIN_CMD_READ:
+        case CO_GTWA_BIN_CMD_WRITE: {
+            bool_t upload = gtwa->binCmd == CO_GTWA_BIN_CMD_READ;
+
+            if (upload && gtwa->binRemain > 0) {
+                respErrorCode = CO_GTWA_respErrorSyntax;
+                break;
+            }
+            if (checkNetNode(gtwa, gtwa->net_default, (int16_t)node, 1,
+                             &respErrorCode)
+            ) {
+                break;
+            }
+            gtwa->SDOindex = (uint16_t)h[9] | ((uint16_t)h[10] << 8);
+            gtwa->SDOsubIndex = h[11];
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+            gtwa->SDOcomplete = false;
 #endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+            if (asyncNodeBusy(gtwa, gtwa->node)) {
+                gtwa->state = upload ? CO_GTWA_ST_READ_WAIT
+                                     : CO_GTWA_ST_WRITE_WAIT;
+                break;
+            }
+#endif
+            respErrorCode = upload ? sdoReadStart(gtwa) : binWriteStart(gtwa);
+            break;
+        }
 
+        case CO_GTWA_BIN_CMD_SET_SDO: {
+            uint16_t timeout = (uint16_t)h[9] | ((uint16_t)h[10] << 8);
 
-static inline void convertToLower(char *token, size_t maxCount) {
-    size_t i;
-    char *c = &token[0];
+            if (gtwa->binRemain > 0 || h[11] > 1) {
+                respErrorCode = CO_GTWA_respErrorSyntax;
+                break;
+            }
+            if (timeout > 0) {
+                gtwa->SDOtimeoutTime = timeout;
+            }
+            gtwa->SDOblockTransferEnable = h[11] == 1;
+            responseWithOK(gtwa);
+            break;
+        }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
-    for (i = 0; i < maxCount; i++) {
-        if (*c == 0) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
+        case CO_GTWA_BIN_CMD_NMT: {
+            uint16_t command = (uint16_t)h[9] | ((uint16_t)h[10] << 8);
+
+            if (gtwa->binRemain > 0) {
+                respErrorCode = CO_GTWA_respErrorSyntax;
+                break;
+            }
+            if (checkNetNode(gtwa, gtwa->net_default, (int16_t)node, 0,
+                             &respErrorCode)
+            ) {
+                break;
+            }
+            if (command != CO_NMT_ENTER_OPERATIONAL
+                && command != CO_NMT_ENTER_STOPPED
+                && command != CO_NMT_ENTER_PRE_OPERATIONAL
+                && command != CO_NMT_RESET_NODE
+                && command != CO_NMT_RESET_COMMUNICATION
+            ) {
+                respErrorCode = CO_GTWA_respErrorReqNotSupported;
+                break;
+            }
+            if (CO_NMT_sendCommand(gtwa->NMT, (CO_NMT_command_t)command,
+                                   gtwa->node) == CO_ERROR_NO
+            ) {
+                responseWithOK(gtwa);
+            }
+            else {
+                respErrorCode = CO_GTWA_respErrorInternalState;
+            }
             break;
-        } else {
-            *c = (char)tolower((int)*c);
         }
-        c++;
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT */
+
+        default:
+            respErrorCode = CO_GTWA_respErrorReqNotSupported;
+            break;
+        }
+
+        if (respErrorCode != CO_GTWA_respErrorNone) {
+            responseWithError(gtwa, respErrorCode);
+            /* data of the request are not used */
+            gtwa->binDiscard = gtwa->binRemain;
+            gtwa->binRemain = 0;
+        }
     }
 }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
 
 
 /*******************************************************************************
@@ -630,9 +1625,36 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         return;
     }
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+    /* SDO transfers on the pool run independently of the gateway state */
+    if (gtwa->SDOpool != NULL) {
+        CO_SDOclientPool_process(gtwa->SDOpool, timeDifference_us,
+                                 timerNext_us);
+    }
+#endif
+
     if (!enable) {
         gtwa->state = CO_GTWA_ST_IDLE;
         CO_fifo_reset(&gtwa->commFifo);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        CO_fifo_reset(&gtwa->binFifo);
+        gtwa->binHeaderCount = 0;
+        gtwa->binRemain = 0;
+        gtwa->binDiscard = 0;
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+        /* discard responses of async commands */
+        for (int i = 0; i < CO_CONFIG_GTWA_ASYNC_COUNT; i++) {
+            gtwa->async[i].done = false;
+        }
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+        for (uint8_t i = 0; i < CO_CONFIG_GTWA_SUB_COUNT; i++) {
+            if (gtwa->sub[i].type != CO_GTWA_SUB_NONE) {
+                subCancel(gtwa, &gtwa->sub[i]);
+            }
+        }
+#endif
         return;
     }
 
@@ -651,11 +1673,35 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         }
     }
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+    asyncResponses(gtwa);
+    if (gtwa->respHold) {
+        gtwa->timeDifference_us_cumulative = timeDifference_us;
+        return;
+    }
+#endif
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+    subNotify(gtwa, timeDifference_us, timerNext_us);
+    if (gtwa->respHold) {
+        gtwa->timeDifference_us_cumulative = timeDifference_us;
+        return;
+    }
+#endif
+
     /***************************************************************************
     * COMMAND PARSER
     ***************************************************************************/
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    /* binary commands are read first */
+    binaryParse(gtwa);
+#endif
+
     /* if idle, search for new command, skip comments or empty lines */
     while (gtwa->state == CO_GTWA_ST_IDLE
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+           && asyncFree(gtwa)
+#endif
            && CO_fifo_CommSearch(&gtwa->commFifo, false)
     ) {
         char tok[20];
@@ -665,6 +1711,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         int32_t net = gtwa->net_default;
         int16_t node = gtwa->node_default;
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        gtwa->binary = false;
+#endif
 
         /* parse mandatory token '"["<sequence>"]"' */
         closed = -1;
@@ -858,7 +1907,7 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         else if (strcmp(tok, "r") == 0 || strcmp(tok, "read") == 0) {
             uint16_t idx;
             uint8_t subidx;
-            CO_SDO_return_t SDO_ret;
+            bool_t started = false;
             bool_t NodeErr = checkNetNode(gtwa, net, node, 1, &respErrorCode);
 
             if (closed != 0 || NodeErr) {
@@ -876,6 +1925,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
             closed = -1;
             n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
                                   &closed, &err);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+            gtwa->SDOcomplete = getCompleteAccess(tok);
+#endif
             subidx = (uint8_t)getU32(tok, 0, 0xFF, &err);
             if (err || n == 0) {
                 err = true;
@@ -894,42 +1946,33 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
             else {
                 gtwa->SDOdataType = &dataTypes[0]; /* use generic data type */
             }
+            gtwa->SDOindex = idx;
+            gtwa->SDOsubIndex = subidx;
 
-            /* setup client */
-            SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
-                                         CO_CAN_ID_SDO_CLI + gtwa->node,
-                                         CO_CAN_ID_SDO_SRV + gtwa->node,
-                                         gtwa->node);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+            started = asyncStart(gtwa, true, &closed, &respErrorCode);
+            if (!started && asyncNodeBusy(gtwa, gtwa->node)) {
+                gtwa->state = CO_GTWA_ST_READ_WAIT;
+                started = true;
             }
-
-            /* initiate upload */
-            SDO_ret = CO_SDOclientUploadInitiate(gtwa->SDO_C, idx, subidx,
-                                                 gtwa->SDOtimeoutTime,
-                                                 gtwa->SDOblockTransferEnable);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
+#endif
+            if (!started) {
+                respErrorCode = sdoReadStart(gtwa);
+            }
+            if (respErrorCode != CO_GTWA_respErrorNone) {
                 err = true;
                 break;
             }
 
-            /* indicate that gateway response didn't start yet */
-            gtwa->SDOdataCopyStatus = false;
             /* continue with state machine */
             timeDifference_us = 0;
-            gtwa->state = CO_GTWA_ST_READ;
         }
 
         /* Download SDO comm. - w[rite] <index> <subindex> <datatype> <value> */
         else if (strcmp(tok, "w") == 0 || strcmp(tok, "write") == 0) {
             uint16_t idx;
             uint8_t subidx;
-            CO_fifo_st status;
-            CO_SDO_return_t SDO_ret;
-            size_t size;
+            bool_t started = false;
             bool_t NodeErr = checkNetNode(gtwa, net, node, 1, &respErrorCode);
 
             if (closed != 0 || NodeErr) {
@@ -947,6 +1990,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
             closed = 0;
             n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
                                   &closed, &err);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE
+            gtwa->SDOcomplete = getCompleteAccess(tok);
+#endif
             subidx = (uint8_t)getU32(tok, 0, 0xFF, &err);
             if (err) break;
 
@@ -957,57 +2003,27 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
             convertToLower(tok, sizeof(tok));
             gtwa->SDOdataType = CO_GTWA_getDataType(tok, &err);
             if (err) break;
+            gtwa->SDOindex = idx;
+            gtwa->SDOsubIndex = subidx;
 
-            /* setup client */
-            SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
-                                         CO_CAN_ID_SDO_CLI + gtwa->node,
-                                         CO_CAN_ID_SDO_SRV + gtwa->node,
-                                         gtwa->node);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+            started = asyncStart(gtwa, false, &closed, &respErrorCode);
+            if (!started && asyncNodeBusy(gtwa, gtwa->node)) {
+                /* value will be read from comm later */
+                gtwa->state = CO_GTWA_ST_WRITE_WAIT;
+                started = true;
             }
-
-            /* initiate download */
-            SDO_ret =
-            CO_SDOclientDownloadInitiate(gtwa->SDO_C, idx, subidx,
-                                         gtwa->SDOdataType->length,
-                                         gtwa->SDOtimeoutTime,
-                                         gtwa->SDOblockTransferEnable);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
+#endif
+            if (!started) {
+                respErrorCode = sdoWriteStart(gtwa, &closed);
             }
-
-            /* copy data from comm to the SDO buffer, according to data type */
-            size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
-                                                   &gtwa->commFifo,
-                                                   &status);
-            /* set to true, if command delimiter was found */
-            closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
-            /* set to true, if data are copied only partially */
-            gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
-
-            /* is syntax error in command or size is zero or not the last token
-             * in command */
-            if ((status & CO_fifo_st_errMask) != 0 || size == 0
-                || (gtwa->SDOdataCopyStatus == false && closed != 1)
-            ) {
+            if (respErrorCode != CO_GTWA_respErrorNone) {
                 err = true;
                 break;
             }
 
-            /* if data size was not known before and is known now, update SDO */
-            if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
-                CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
-            }
-
             /* continue with state machine */
-            gtwa->stateTimeoutTmr = 0;
             timeDifference_us = 0;
-            gtwa->state = CO_GTWA_ST_WRITE;
         }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
@@ -1458,6 +2474,14 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                 if (err) break;
             }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL
+            gtwa->lssAssign.fastscan = gtwa->lssFastscan;
+            gtwa->lssAssign.nodeIdNext = gtwa->lssNID;
+            gtwa->lssAssign.nodeIdLast = 127;
+            gtwa->lssAssign.store = gtwa->lssStore;
+            gtwa->lssAssign.pFunctProgress = NULL;
+            gtwa->lssAssign.functProgressObject = NULL;
+#endif
             /* continue with state machine */
             gtwa->state = CO_GTWA_ST_LSS_ALLNODES;
         }
@@ -1474,6 +2498,141 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+        /* 'subscribe pdo <COB-ID> [<interval_ms>]',
+         * 'subscribe od <index> <subindex> [<interval_ms>]' or
+         * 'subscribe hb [<interval_ms>]' */
+        else if (strcmp(tok, "subscribe") == 0) {
+            CO_GTWA_subType_t type;
+            uint16_t id = 0;
+            uint8_t subIndex = 0;
+            uint16_t interval_ms = 0;
+            uint8_t subId = 0;
+
+            if (closed != 0) {
+                err = true;
+                break;
+            }
+
+            /* subscription type */
+            closed = -1;
+            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
+            if (err) break;
+
+            convertToLower(tok, sizeof(tok));
+            if (strcmp(tok, "pdo") == 0) {
+                bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
+
+                if (closed != 0 || NodeErr) {
+                    err = true;
+                    break;
+                }
+
+                /* COB-ID */
+                closed = -1;
+                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                                  &closed, &err);
+                id = (uint16_t)getU32(tok, 1, 0x7FF, &err);
+                if (err) break;
+                type = CO_GTWA_SUB_PDO;
+            }
+            else if (strcmp(tok, "od") == 0) {
+                bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
+
+                if (closed != 0 || NodeErr) {
+                    err = true;
+                    break;
+                }
+
+                /* index */
+                closed = 0;
+                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                                  &closed, &err);
+                id = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
+                if (err) break;
+
+                /* subindex */
+                closed = -1;
+                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                                  &closed, &err);
+                subIndex = (uint8_t)getU32(tok, 0, 0xFF, &err);
+                if (err) break;
+                type = CO_GTWA_SUB_OD;
+            }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+            else if (strcmp(tok, "hb") == 0) {
+                bool_t NodeErr = checkNetNode(gtwa, net, node, 1,
+                                              &respErrorCode);
+
+                if (NodeErr) {
+                    err = true;
+                    break;
+                }
+                id = gtwa->node;
+                type = CO_GTWA_SUB_HB;
+            }
+#endif
+            else {
+                err = true;
+                break;
+            }
+
+            /* optional interval */
+            if (closed == 0) {
+                closed = 1;
+                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                                  &closed, &err);
+                interval_ms = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
+                if (err) break;
+            }
+
+            respErrorCode = subAdd(gtwa, type, id, subIndex, interval_ms,
+                                   &subId);
+            if (respErrorCode != CO_GTWA_respErrorNone) {
+                err = true;
+                break;
+            }
+
+            gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                                          "[%"PRId32"] %d\r\n",
+                                          gtwa->sequence, subId);
+            respBufTransfer(gtwa);
+        }
+
+        /* 'unsubscribe [<id>]' */
+        else if (strcmp(tok, "unsubscribe") == 0) {
+            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
+
+            if (NodeErr) {
+                err = true;
+                break;
+            }
+
+            if (closed == 0) {
+                uint8_t subId;
+
+                closed = 1;
+                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                                  &closed, &err);
+                subId = (uint8_t)getU32(tok, 0, CO_CONFIG_GTWA_SUB_COUNT - 1,
+                                        &err);
+                if (err || gtwa->sub[subId].type == CO_GTWA_SUB_NONE) {
+                    err = true;
+                    break;
+                }
+                subCancel(gtwa, &gtwa->sub[subId]);
+            }
+            else {
+                for (uint8_t j = 0; j < CO_CONFIG_GTWA_SUB_COUNT; j++) {
+                    if (gtwa->sub[j].type != CO_GTWA_SUB_NONE) {
+                        subCancel(gtwa, &gtwa->sub[j]);
+                    }
+                }
+            }
+            responseWithOK(gtwa);
+        }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP
         /* Print help */
         else if (strcmp(tok, "help") == 0) {
@@ -1493,6 +2652,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                 else if (strcmp(tok, "lss") == 0) {
                     gtwa->helpString = CO_GTWA_helpStringLss;
                 }
+                else if (strcmp(tok, "subscribe") == 0) {
+                    gtwa->helpString = CO_GTWA_helpStringSub;
+                }
                 else {
                     err = true;
                     break;
@@ -1573,6 +2735,24 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         ) {
             size_t fifoRemain;
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+            if (gtwa->binary) {
+                /* raw data in one or more binary frames */
+                do {
+                    fifoRemain = binReadResponse(gtwa,
+                                        ret == CO_SDO_RT_ok_communicationEnd);
+                    gtwa->SDOdataCopyStatus = true;
+                    if (respBufTransfer(gtwa) == false) {
+                        abortCode = CO_SDO_AB_DATA_TRANSF;
+                        CO_SDOclientUpload(gtwa->SDO_C, 0, true, &abortCode,
+                                           NULL, NULL, NULL);
+                        gtwa->state = CO_GTWA_ST_IDLE;
+                        break;
+                    }
+                } while (gtwa->respHold == false && fifoRemain > 0);
+                break;
+            }
+#endif
             /* write response head first */
             if (!gtwa->SDOdataCopyStatus) {
                 gtwa->respBufCount = snprintf(gtwa->respBuf,
@@ -1629,6 +2809,15 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         bool_t hold = false;
         CO_SDO_return_t ret;
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        /* copy the rest of binary request data to the SDO buffer */
+        if (gtwa->binary) {
+            if (gtwa->SDOdataCopyStatus) {
+                binCopyData(gtwa);
+            }
+        }
+        else
+#endif
         /* copy data to the SDO buffer if previous dataTypeScan was partial */
         if (gtwa->SDOdataCopyStatus) {
             CO_fifo_st status;
@@ -1698,6 +2887,13 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                 gtwa->state = gtwa->SDOdataCopyStatus
                               ? CO_GTWA_ST_WRITE_ABORTED
                               : CO_GTWA_ST_IDLE;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+                if (gtwa->binary) {
+                    gtwa->binDiscard = gtwa->binRemain;
+                    gtwa->binRemain = 0;
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                }
+#endif
             }
             else if (ret == CO_SDO_RT_ok_communicationEnd) {
                 responseWithOK(gtwa);
@@ -1708,6 +2904,43 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC
+    /* wait for end of async commands on the same node, then start SDO */
+    case CO_GTWA_ST_READ_WAIT:
+    case CO_GTWA_ST_WRITE_WAIT: {
+        if (asyncNodeBusy(gtwa, gtwa->node)) {
+            break;
+        }
+        if (gtwa->state == CO_GTWA_ST_READ_WAIT) {
+            closed = 1;
+            respErrorCode = sdoReadStart(gtwa);
+        }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        else if (gtwa->binary) {
+            closed = 1;
+            respErrorCode = binWriteStart(gtwa);
+        }
+#endif
+        else {
+            closed = 0;
+            respErrorCode = sdoWriteStart(gtwa, &closed);
+        }
+        if (respErrorCode != CO_GTWA_respErrorNone) {
+            responseWithError(gtwa, respErrorCode);
+            /* delete command, if it was only partially read */
+            if (closed == 0) {
+                CO_fifo_CommSearch(&gtwa->commFifo, true);
+            }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+            gtwa->binDiscard = gtwa->binRemain;
+            gtwa->binRemain = 0;
+#endif
+            gtwa->state = CO_GTWA_ST_IDLE;
+        }
+        break;
+    }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC */
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
     case CO_GTWA_ST_LSS_SWITCH_GLOB: {
         CO_LSSmaster_return_t ret;
@@ -1863,6 +3096,62 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     }
     case CO_GTWA_ST_LSS_ALLNODES: {
         CO_LSSmaster_return_t ret;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL
+        ret = CO_LSSmaster_assignAll(gtwa->LSSmaster,
+                                     timeDifference_us,
+                                     &gtwa->lssAssign);
+        gtwa->respBufCount = 0;
+        if (gtwa->lssAssign.nodeCount != gtwa->lssNodeCount) {
+            /* node-ID assigned in this call, send report */
+            gtwa->lssNodeCount = gtwa->lssAssign.nodeCount;
+            gtwa->respBufCount =
+                snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                         "# Node-ID %d assigned to: 0x%08"PRIX32" 0x%08" \
+                         PRIX32" 0x%08"PRIX32" 0x%08"PRIX32"\n",
+                         gtwa->lssAssign.nodeIdNext - 1,
+                         gtwa->lssAssign.fastscan.found.identity.vendorID,
+                         gtwa->lssAssign.fastscan.found.identity.productCode,
+                         gtwa->lssAssign.fastscan.found.identity.revisionNumber,
+                         gtwa->lssAssign.fastscan.found.identity.serialNumber);
+        }
+        if (ret != CO_LSSmaster_WAIT_SLAVE) {
+            CO_LSSmaster_changeTimeout(gtwa->LSSmaster,
+                                       CO_LSSmaster_DEFAULT_TIMEOUT);
+            gtwa->state = CO_GTWA_ST_IDLE;
+
+            if (ret == CO_LSSmaster_OK) {
+                /* no more nodes found, send report sum and finish */
+                gtwa->respBufCount +=
+                    snprintf(&gtwa->respBuf[gtwa->respBufCount],
+                             CO_GTWA_RESP_BUF_SIZE - gtwa->respBufCount,
+                             "# Found %d nodes, search finished.\n" \
+                             "[%"PRId32"] OK\r\n",
+                             gtwa->lssNodeCount,
+                             gtwa->sequence);
+            }
+            else if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                /* If we can't assign more node IDs, quit scanning */
+                gtwa->respBufCount +=
+                    snprintf(&gtwa->respBuf[gtwa->respBufCount],
+                             CO_GTWA_RESP_BUF_SIZE - gtwa->respBufCount,
+                             "# Not all nodes scanned!\n" \
+                             "[%"PRId32"] OK\r\n",
+                             gtwa->sequence);
+            }
+            else if (ret == CO_LSSmaster_OK_ILLEGAL_ARGUMENT) {
+                respErrorCode = CO_GTWA_respErrorLSSnodeIdNotSupported;
+                responseWithError(gtwa, respErrorCode);
+                break;
+            }
+            else {
+                responseLSS(gtwa, ret);
+                break;
+            }
+        }
+        if (gtwa->respBufCount > 0) {
+            respBufTransfer(gtwa);
+        }
+#else
         if (gtwa->lssSubState == 0) { /* _lss_fastscan */
             ret = CO_LSSmaster_IdentifyFastscan(gtwa->LSSmaster,
                                                 timeDifference_us,
@@ -1981,6 +3270,7 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                 respBufTransfer(gtwa);
             }
         }
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL */
         break;
     } /* CO_GTWA_ST_LSS_ALLNODES */
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS */
@@ -2072,6 +3362,13 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     ) {
         *timerNext_us = 0;
     }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (timerNext_us != NULL && gtwa->state == CO_GTWA_ST_IDLE
+        && CO_fifo_getOccupied(&gtwa->binFifo) > 0
+    ) {
+        *timerNext_us = 0;
+    }
+#endif
 }
 
 #endif  /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII */
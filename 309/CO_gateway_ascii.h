@@ -30,7 +30,9 @@
 #include "301/CO_driver.h"
 #include "301/CO_fifo.h"
 #include "301/CO_SDOclient.h"
+#include "301/CO_SDOclientPool.h"
 #include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_HBconsumer.h"
 #include "305/CO_LSSmaster.h"
 #include "303/CO_LEDs.h"
 
@@ -89,7 +91,7 @@ Command strings start with '"["<sequence>"]"' followed by:
 [<net>] set sdo_timeout <value>          # Configure SDO time-out.
 [<net>] set sdo_block <value>            # Enable/disable SDO block transfer.
 
-help [datatype|lss]                      # Print this or datatype or lss help.
+help [datatype|lss|subscribe]            # Print this or other help.
 led                                      # Print status LED diodes.
 log                                      # Print message log.
 
@@ -105,6 +107,9 @@ Response:
   disabled by default.
 * If '<net>' or '<node>' is not specified within commands, then value defined
   by 'set network' or 'set node' command is used.
+* '<subindex>*' (for example '1*' or '*') reads or writes all sub-objects of
+  array or record from subindex on, non-standard, see OD_getComplete(). Use
+  'hex' datatype. Requires CO_CONFIG_SDO_CLI_COMPLETE.
 
 Datatypes:
 b                  # Boolean.
@@ -139,6 +144,30 @@ lss_allnodes [<timeout_ms> [<nodeStart=1..127> <store=0|1>\\
 * <table_index>: 0=1000 kbit/s, 1=800 kbit/s, 2=500 kbit/s, 3=250 kbit/s,
                  4=125 kbit/s, 6=50 kbit/s, 7=20 kbit/s, 8=10 kbit/s, 9=auto
 * <scanType>: 0=fastscan, 1=ignore, 2=match value in next parameter
+
+Subscribe commands, non-standard:
+[<net>] subscribe pdo <COB-ID> [<interval_ms>]
+                                       # Notify received CAN frame.
+[<net>] subscribe od <index> <subindex> [<interval_ms>]
+                                       # Notify change of local OD variable.
+[[<net>] <node>] subscribe hb [<interval_ms>]
+                                       # Notify heartbeat state of node.
+[<net>] unsubscribe [<id>]             # Cancel one or all subscriptions.
+
+Response:
+"["<sequence>"]" <id> | OK | ERROR:<internal-error-code>
+
+Notifications:
+"!" <id> pdo <COB-ID> <data>
+"!" <id> od <index> <subindex> <data>
+"!" <id> hb <node> unconfigured|unknown|timeout|initializing|
+                   pre-operational|operational|stopped
+
+* Notification is printed, when data differs from the last one, but not more
+  often than <interval_ms> (0 by default). Pending notifications are printed
+  together, between responses. <data> is in 'hex' format.
+* 'pdo' receives CAN frames, which are not received by other objects of this
+  device. For own RPDOs subscribe their mapped OD variables.
  * @endcode
  *
  * This help text is the same as variable contents in CO_GTWA_helpString.
@@ -153,6 +182,112 @@ lss_allnodes [<timeout_ms> [<nodeStart=1..127> <store=0|1>\\
 #endif
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_MULTI_NET) || defined CO_DOXYGEN
+#ifndef CO_CONFIG_GTW_NET_MIN
+#define CO_CONFIG_GTW_NET_MIN 1
+#endif
+#ifndef CO_CONFIG_GTW_NET_MAX
+#define CO_CONFIG_GTW_NET_MAX 127
+#endif
+#endif
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC) || defined CO_DOXYGEN
+#ifndef CO_CONFIG_GTWA_ASYNC_COUNT
+#define CO_CONFIG_GTWA_ASYNC_COUNT 8
+#endif
+
+/** Maximum size of data in SDO command executed on SDO client pool. Larger
+ * data types are transferred with the SDO client of the gateway. */
+#define CO_GTWA_ASYNC_DATA_SIZE 8
+#endif
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) || defined CO_DOXYGEN
+#ifndef CO_CONFIG_GTWA_BIN_BUF_SIZE
+#define CO_CONFIG_GTWA_BIN_BUF_SIZE 200
+#endif
+
+/**
+ * @defgroup CO_CANopen_309_3_Binary Binary command frames
+ * Compact binary alternative to the ASCII command syntax.
+ *
+ * @{
+ * Frames are written with CO_GTWA_writeBinary() and responses are passed to
+ * the same readCallback as ASCII responses. Multi-byte values are little
+ * endian. Binary commands are executed by the same state machine as ASCII
+ * commands, so one command is processed at a time.
+ *
+ * Request frame (12 bytes + data):
+ * - sync byte, #CO_GTWA_BIN_SYNC,
+ * - length, uint16, number of bytes after this field (9 + data length),
+ * - sequence, uint32, copied into the response,
+ * - command, #CO_GTWA_binCmd_t,
+ * - node-ID, uint8,
+ * - index, uint16 and sub-index, uint8, meaning depends on command,
+ * - data for SDO download.
+ *
+ * Response frame (9 bytes + data):
+ * - sync byte, #CO_GTWA_BIN_SYNC,
+ * - length, uint16, number of bytes after this field (6 + data length),
+ * - sequence, uint32, from the request,
+ * - command from the request,
+ * - status, #CO_GTWA_binStatus_t,
+ * - data: uploaded data, or uint32 SDO abort code or #CO_GTWA_respErrorCode_t
+ *   in case of error.
+ *
+ * Bytes before the sync byte are ignored.
+ */
+
+/** First byte of binary request and response frame */
+#define CO_GTWA_BIN_SYNC 0xA5U
+/** Size of binary request frame without data */
+#define CO_GTWA_BIN_REQ_HEADER_SIZE 12
+/** Size of binary response frame without data */
+#define CO_GTWA_BIN_RESP_HEADER_SIZE 9
+
+/**
+ * Binary commands
+ */
+typedef enum {
+    /** SDO upload of index/sub-index from node */
+    CO_GTWA_BIN_CMD_READ = 0x01U,
+    /** SDO download of data to index/sub-index on node */
+    CO_GTWA_BIN_CMD_WRITE = 0x02U,
+    /** NMT command (#CO_NMT_command_t in index) to node, 0 for all nodes */
+    CO_GTWA_BIN_CMD_NMT = 0x10U,
+    /** Set SDO timeout (in index, in milliseconds, if nonzero) and SDO block
+     * transfer enable (in sub-index) */
+    CO_GTWA_BIN_CMD_SET_SDO = 0x20U
+} CO_GTWA_binCmd_t;
+
+/**
+ * Status in binary response
+ */
+typedef enum {
+    /** Command finished successfully, frame contains (last) data */
+    CO_GTWA_BIN_ST_OK = 0x00U,
+    /** Frame contains part of uploaded data, more frames follow */
+    CO_GTWA_BIN_ST_PARTIAL = 0x01U,
+    /** SDO transfer aborted, frame contains SDO abort code */
+    CO_GTWA_BIN_ST_SDO_ABORT = 0x80U,
+    /** Gateway error, frame contains #CO_GTWA_respErrorCode_t */
+    CO_GTWA_BIN_ST_ERROR = 0x81U
+} CO_GTWA_binStatus_t;
+/** @} */ /* CO_CANopen_309_3_Binary */
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+#ifndef CO_CONFIG_GTWA_SUB_COUNT
+#define CO_CONFIG_GTWA_SUB_COUNT 8
+#endif
+#ifndef CO_CONFIG_GTWA_SUB_CAN_COUNT
+#define CO_CONFIG_GTWA_SUB_CAN_COUNT 4
+#endif
+#endif
+
+
 /** Timeout time in microseconds for some internal states. */
 #ifndef CO_GTWA_STATE_TIMEOUT_TIME_US
 #define CO_GTWA_STATE_TIMEOUT_TIME_US 1200000
@@ -236,6 +371,11 @@ typedef enum {
     CO_GTWA_ST_WRITE = 0x11U,
     /** SDO 'write' (download) - aborted, purging remaining data */
     CO_GTWA_ST_WRITE_ABORTED = 0x12U,
+    /** SDO 'read' (upload) - waiting for end of async commands on the node */
+    CO_GTWA_ST_READ_WAIT = 0x13U,
+    /** SDO 'write' (download) - waiting for end of async commands on the
+     * node */
+    CO_GTWA_ST_WRITE_WAIT = 0x14U,
     /** LSS 'lss_switch_glob' */
     CO_GTWA_ST_LSS_SWITCH_GLOB = 0x20U,
     /** LSS 'lss_switch_sel' */
@@ -291,6 +431,79 @@ typedef struct {
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC) || defined CO_DOXYGEN
+/**
+ * SDO command executed on SDO client pool
+ */
+typedef struct {
+    /** Request for the SDO client pool */
+    CO_SDOclientPool_request_t req;
+    /** Sequence number of the command */
+    uint32_t sequence;
+    /** Data type of the variable */
+    const CO_GTWA_dataType_t *dataType;
+    /** Data for download or uploaded data */
+    uint8_t data[CO_GTWA_ASYNC_DATA_SIZE];
+    /** True, if request is submitted to the pool */
+    bool_t active;
+    /** True, if transfer is finished and response is not printed yet */
+    bool_t done;
+} CO_GTWA_async_t;
+#endif
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+/**
+ * Type of subscription
+ */
+typedef enum {
+    /** Entry is free */
+    CO_GTWA_SUB_NONE = 0x00U,
+    /** CAN frame with COB-ID, 'subscribe pdo' */
+    CO_GTWA_SUB_PDO = 0x01U,
+    /** Variable from local Object Dictionary, 'subscribe od' */
+    CO_GTWA_SUB_OD = 0x02U,
+    /** Heartbeat state of the remote node, 'subscribe hb' */
+    CO_GTWA_SUB_HB = 0x03U
+} CO_GTWA_subType_t;
+
+
+/**
+ * Subscription in Gateway-ascii object
+ */
+typedef struct {
+    /** Type of subscription */
+    CO_GTWA_subType_t type;
+    /** COB-ID, OD index or node-ID */
+    uint16_t id;
+    /** OD sub-index */
+    uint8_t subIndex;
+    /** Index of CAN receive buffer, relative to CANdevRxIdx from
+     * CO_GTWA_initSubscribe() */
+    uint8_t CANslot;
+    /** Minimum time between two notifications in microseconds */
+    uint32_t interval_us;
+    /** Time since last notification, saturated at interval_us */
+    uint32_t timer_us;
+    /** True, if data has changed since last notification */
+    bool_t pending;
+    /** Length of data */
+    uint8_t dataLength;
+    /** Last data: CAN frame, value of OD variable or heartbeat consumer and
+     * NMT state */
+    uint8_t data[CO_CAN_DATA_MAX];
+    /** IO object of OD variable */
+    OD_IO_t io;
+    /** Indication, that CAN frame was received, set from receive callback */
+    volatile void *CANrxNew;
+    /** DLC of received CAN frame */
+    uint8_t CANrxDLC;
+    /** Data of received CAN frame */
+    uint8_t CANrxData[CO_CAN_DATA_MAX];
+} CO_GTWA_sub_t;
+#endif
+
+
 /**
  * CANopen Gateway-ascii object
  */
@@ -356,6 +569,52 @@ typedef struct {
     bool_t SDOdataCopyStatus;
     /** Data type of variable in current SDO communication */
     const CO_GTWA_dataType_t *SDOdataType;
+    /** Index of variable in current SDO communication */
+    uint16_t SDOindex;
+    /** Sub-index of variable in current SDO communication */
+    uint8_t SDOsubIndex;
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_COMPLETE) || defined CO_DOXYGEN
+    /** Complete access requested with '<subindex>*' */
+    bool_t SDOcomplete;
+#endif
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC) || defined CO_DOXYGEN
+    /** SDO client pool from CO_GTWA_initAsync(), may be NULL */
+    CO_SDOclientPool_t *SDOpool;
+    /** SDO commands executed on SDOpool */
+    CO_GTWA_async_t async[CO_CONFIG_GTWA_ASYNC_COUNT];
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) || defined CO_DOXYGEN
+    /** CO_fifo_t object for binary commands (not pointer) */
+    CO_fifo_t binFifo;
+    /** Binary command buffer of usable size @ref CO_CONFIG_GTWA_BIN_BUF_SIZE*/
+    uint8_t binBuf[CO_CONFIG_GTWA_BIN_BUF_SIZE + 1];
+    /** Header of binary request frame */
+    uint8_t binHeader[CO_GTWA_BIN_REQ_HEADER_SIZE];
+    /** Number of bytes in binHeader */
+    uint8_t binHeaderCount;
+    /** True, if current command is binary */
+    bool_t binary;
+    /** Command of current binary request */
+    uint8_t binCmd;
+    /** Remaining data of current binary request in binFifo */
+    size_t binRemain;
+    /** Number of bytes to skip in binFifo, rest of the discarded frame */
+    size_t binDiscard;
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+    /** Subscriptions */
+    CO_GTWA_sub_t sub[CO_CONFIG_GTWA_SUB_COUNT];
+    /** Object Dictionary from CO_GTWA_initSubscribe() */
+    OD_t *subOD;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+    /** Heartbeat consumer from CO_GTWA_initSubscribe(), may be NULL */
+    CO_HBconsumer_t *subHBcons;
+#endif
+    /** CAN device for 'subscribe pdo', from CO_GTWA_initSubscribe() */
+    CO_CANmodule_t *subCANdevRx;
+    /** Index of the first CAN receive buffer, from CO_GTWA_initSubscribe() */
+    uint16_t subCANdevRxIdx;
 #endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT) || defined CO_DOXYGEN
     /** NMT object from CO_GTWA_init() */
@@ -382,6 +641,10 @@ typedef struct {
     bool_t lssStore;
     /** LSS allnodes timeout parameter */
     uint16_t lssTimeout_ms;
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_ASSIGN_ALL) || defined CO_DOXYGEN
+    /** LSS allnodes parameters and progress of CO_LSSmaster_assignAll() */
+    CO_LSSmaster_assignAll_t lssAssign;
+#endif
 #endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) || defined CO_DOXYGEN
     /** Message log buffer of usable size @ref CO_CONFIG_GTWA_LOG_BUF_SIZE */
@@ -491,6 +754,98 @@ static inline size_t CO_GTWA_write(CO_GTWA_t* gtwa,
 }
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) || defined CO_DOXYGEN
+/**
+ * Get free binary write buffer space
+ *
+ * @param gtwa This object
+ *
+ * @return number of available bytes
+ */
+static inline size_t CO_GTWA_writeBinary_getSpace(CO_GTWA_t* gtwa) {
+    return CO_fifo_getSpace(&gtwa->binFifo);
+}
+
+
+/**
+ * Write binary command frames into CO_GTWA_t object.
+ *
+ * Same as CO_GTWA_write(), but for @ref CO_CANopen_309_3_Binary. Frame may be
+ * written in multiple parts.
+ *
+ * @param gtwa This object
+ * @param buf Buffer which will be copied
+ * @param count Number of bytes in buf
+ *
+ * @return number of bytes actually written.
+ */
+static inline size_t CO_GTWA_writeBinary(CO_GTWA_t* gtwa,
+                                         const uint8_t *buf,
+                                         size_t count)
+{
+    return CO_fifo_write(&gtwa->binFifo, buf, count, NULL);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC) || defined CO_DOXYGEN
+/**
+ * Initialize asynchronous execution of SDO commands in Gateway-ascii object
+ *
+ * If SDO client pool is set, then SDO 'read' and 'write' commands with data
+ * type of known size (not 'hex', 'vs', 'os', 'us' or 'd') are submitted to the
+ * pool and gateway continues with next command immediately. Up to
+ * @ref CO_CONFIG_GTWA_ASYNC_COUNT commands may be in progress, one per remote
+ * node at a time. Responses ('"["<sequence>"]" OK', value or error) are
+ * printed, when each transfer finishes, so they may be out of order, as
+ * allowed by CiA 309-3. Other SDO commands use SDO client from CO_GTWA_init()
+ * and wait for end of async commands on the same node.
+ *
+ * Pool is processed from CO_GTWA_process(). SDO clients in the pool must be
+ * different from the SDO client from CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param SDOpool Initialized SDO client pool or NULL to disable.
+ */
+void CO_GTWA_initAsync(CO_GTWA_t* gtwa, CO_SDOclientPool_t *SDOpool);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ASYNC */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+/**
+ * Initialize subscriptions in Gateway-ascii object
+ *
+ * Enables 'subscribe' and 'unsubscribe' commands, see
+ * @ref CO_CANopen_309_3_Syntax. Subscriptions are checked in CO_GTWA_process()
+ * and notifications are printed into the same output stream as responses, so
+ * host does not need to poll values with SDO. CAN frames are received within
+ * @ref CO_CONFIG_GTWA_SUB_CAN_COUNT receive buffers, which are configured,
+ * when 'subscribe pdo' command is executed. OD variables are compared with
+ * their previous value in each CO_GTWA_process() call.
+ *
+ * Function must be called after CO_GTWA_init(), which clears all
+ * subscriptions.
+ *
+ * @param gtwa This object
+ * @param OD Object Dictionary, for 'subscribe od'.
+ * @param HBcons Heartbeat consumer, for 'subscribe hb'. May be NULL. Only
+ * if CO_CONFIG_HB_CONS_ENABLE is set.
+ * @param CANdevRx CAN device for 'subscribe pdo'.
+ * @param CANdevRxIdx Index of the first of @ref CO_CONFIG_GTWA_SUB_CAN_COUNT
+ * receive buffers in CANdevRx.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWA_initSubscribe(CO_GTWA_t* gtwa,
+                                       OD_t *OD,
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+                                       CO_HBconsumer_t *HBcons,
+#endif
+                                       CO_CANmodule_t *CANdevRx,
+                                       uint16_t CANdevRxIdx);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) || defined CO_DOXYGEN
 /**
  * Print message log string into fifo buffer
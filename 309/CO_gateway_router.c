@@ -0,0 +1,495 @@
+/*
+ * Routing of CiA 309-3 ASCII commands to multiple CANopen networks
+ *
+ * @file        CO_gateway_router.c
+ * @ingroup     CO_CANopen_309_3_Router
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "309/CO_gateway_router.h"
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_MULTI_NET) \
+    && ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <inttypes.h>
+
+/* Non-graphical character for command delimiter */
+#define DELIM_COMMAND ((uint8_t)'\n')
+
+/* Maximum number of tokens inspected at the start of the command */
+#define HEAD_TOKENS 5
+
+
+/* Data are exchanged between threads with the span API of CO_fifo. Each fifo
+ * has one producer and one consumer thread. Producer makes data visible with
+ * the barrier before writePtr is updated, consumer reads data after barrier
+ * and releases space after another barrier. */
+
+/* Write into fifo, which is read from other thread. Return number of bytes
+ * written. */
+static size_t sharedWrite(CO_fifo_t *fifo, const uint8_t *buf, size_t count) {
+    size_t written = 0;
+
+    while (written < count) {
+        uint8_t *dest;
+        size_t n;
+
+        CO_MemoryBarrier();
+        n = CO_fifo_writeSpan(fifo, &dest);
+        if (n == 0) {
+            break;
+        }
+        if (n > (count - written)) {
+            n = count - written;
+        }
+        memcpy(dest, &buf[written], n);
+        CO_MemoryBarrier();
+        CO_fifo_writeCommit(fifo, n);
+        written += n;
+    }
+
+    return written;
+}
+
+
+/* Get contiguous data from fifo, which is written from other thread */
+static size_t sharedReadSpan(CO_fifo_t *fifo, const uint8_t **buf) {
+    size_t n = CO_fifo_readSpan(fifo, buf);
+
+    CO_MemoryBarrier();
+    return n;
+}
+
+
+/* Release data from sharedReadSpan() */
+static void sharedReadCommit(CO_fifo_t *fifo, size_t count) {
+    CO_MemoryBarrier();
+    CO_fifo_readCommit(fifo, count);
+}
+
+
+/* Callback from Gateway-ascii object inside network thread */
+static size_t netReadCallback(void *object,
+                              const char *buf,
+                              size_t count,
+                              uint8_t *connectionOK)
+{
+    CO_GTWR_net_t *net = (CO_GTWR_net_t *)object;
+
+    *connectionOK = 1;
+    return sharedWrite(&net->respFifo, (const uint8_t *)buf, count);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_GTWR_init(CO_GTWR_t *gtwr,
+                              const uint16_t nets[],
+                              uint8_t netsCount)
+{
+    uint8_t i;
+
+    if (gtwr == NULL || nets == NULL || netsCount == 0
+        || netsCount > CO_CONFIG_GTWR_NET_COUNT
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(gtwr, 0, sizeof(CO_GTWR_t));
+
+    for (i = 0; i < netsCount; i++) {
+        CO_GTWR_net_t *net = &gtwr->nets[i];
+
+        if (nets[i] < CO_CONFIG_GTW_NET_MIN || nets[i] > CO_CONFIG_GTW_NET_MAX){
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+        net->net = nets[i];
+        CO_fifo_init(&net->cmdFifo, &net->cmdBuf[0],
+                     CO_CONFIG_GTWR_CMD_BUF_SIZE + 1);
+        CO_fifo_init(&net->respFifo, &net->respBuf[0],
+                     CO_CONFIG_GTWR_RESP_BUF_SIZE + 1);
+    }
+    gtwr->netsCount = netsCount;
+    gtwr->netDefault = 0;
+    gtwr->cmdNet = CO_GTWR_NET_NONE;
+    gtwr->respNet = CO_GTWR_NET_NONE;
+    gtwr->respNetLast = netsCount;
+
+    CO_fifo_init(&gtwr->commFifo, &gtwr->commBuf[0],
+                 CO_CONFIG_GTWA_COMM_BUF_SIZE + 1);
+    CO_fifo_init(&gtwr->respFifo, &gtwr->respBuf[0],
+                 CO_GTWA_RESP_BUF_SIZE + 1);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_GTWR_initRead(CO_GTWR_t *gtwr,
+                      size_t (*readCallback)(void *object,
+                                             const char *buf,
+                                             size_t count,
+                                             uint8_t *connectionOK),
+                      void *readCallbackObject)
+{
+    if (gtwr != NULL) {
+        gtwr->readCallback = readCallback;
+        gtwr->readCallbackObject = readCallbackObject;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_GTWR_attachNet(CO_GTWR_t *gtwr,
+                                   uint8_t netIndex,
+                                   CO_GTWA_t *gtwa)
+{
+    CO_GTWR_net_t *net;
+
+    if (gtwr == NULL || gtwa == NULL || netIndex >= gtwr->netsCount) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    net = &gtwr->nets[netIndex];
+    net->gtwa = gtwa;
+    /* commands are received without <net> */
+    gtwa->net_default = (int32_t)net->net;
+    CO_GTWA_initRead(gtwa, netReadCallback, (void *)net);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_GTWR_processNet(CO_GTWR_t *gtwr, uint8_t netIndex) {
+    CO_GTWR_net_t *net;
+
+    if (gtwr == NULL || netIndex >= gtwr->netsCount) {
+        return;
+    }
+    net = &gtwr->nets[netIndex];
+    if (net->gtwa == NULL) {
+        return;
+    }
+
+    /* copy routed commands into the Gateway-ascii object */
+    for (;;) {
+        const uint8_t *buf;
+        size_t n = sharedReadSpan(&net->cmdFifo, &buf);
+
+        if (n == 0) {
+            break;
+        }
+        n = CO_GTWA_write(net->gtwa, (const char *)buf, n);
+        if (n == 0) {
+            break;
+        }
+        sharedReadCommit(&net->cmdFifo, n);
+    }
+}
+
+
+/* Copy up to count bytes from the start of commFifo, without removing them */
+static size_t peekHead(CO_fifo_t *fifo, char *buf, size_t count) {
+    size_t occupied = CO_fifo_getOccupied(fifo);
+    size_t ptr = fifo->readPtr;
+    size_t i;
+
+    if (count > occupied) {
+        count = occupied;
+    }
+    for (i = 0; i < count; i++) {
+        buf[i] = (char)fifo->buf[ptr];
+        if (++ptr == fifo->bufSize) {
+            ptr = 0;
+        }
+    }
+
+    return count;
+}
+
+
+/* Write router's own response, sequence is the '"["<sequence>"]"' token.
+ * Return false, if there is no space for the whole response, then command
+ * stays in commFifo and response is written later. */
+static bool_t response(CO_GTWR_t *gtwr, const char *sequence,
+                       CO_GTWA_respErrorCode_t respErrorCode)
+{
+    char buf[40];
+    int len;
+
+    if (respErrorCode == CO_GTWA_respErrorNone) {
+        len = snprintf(buf, sizeof(buf), "%s OK\r\n", sequence);
+    }
+    else {
+        len = snprintf(buf, sizeof(buf), "%s ERROR:%d\r\n",
+                       sequence, (int)respErrorCode);
+    }
+    if (len <= 0) {
+        return true;
+    }
+    if (CO_fifo_getSpace(&gtwr->respFifo) < (size_t)len) {
+        return false;
+    }
+    CO_fifo_write(&gtwr->respFifo, (const uint8_t *)buf, (size_t)len, NULL);
+    return true;
+}
+
+
+/* Return index of the network with number net or CO_GTWR_NET_NONE */
+static uint8_t findNet(CO_GTWR_t *gtwr, uint32_t net) {
+    uint8_t i;
+
+    for (i = 0; i < gtwr->netsCount; i++) {
+        if (gtwr->nets[i].net == net) {
+            return i;
+        }
+    }
+    return CO_GTWR_NET_NONE;
+}
+
+
+/* Inspect start of the new command in commFifo and select its network. Write
+ * the command without <net> into the network. Return false, if command can
+ * not be routed yet. */
+static bool_t routeCommand(CO_GTWR_t *gtwr) {
+    char head[CO_GTWR_HEAD_SIZE + 1];
+    char seq[16];
+    size_t tokStart[HEAD_TOKENS];
+    size_t tokEnd[HEAD_TOKENS];
+    uint8_t tokCount = 0;
+    size_t len;
+    size_t i = 0;
+    bool_t closed;
+    uint8_t netIndex = gtwr->netDefault;
+    uint8_t cmd = 1; /* index of <command> token */
+    size_t stripStart = 0, stripEnd = 0;
+
+    /* wait for the whole command or enough characters */
+    len = peekHead(&gtwr->commFifo, head, CO_GTWR_HEAD_SIZE);
+    head[len] = '\0';
+    closed = memchr(head, (char)DELIM_COMMAND, len) != NULL;
+    if (!closed && len < CO_GTWR_HEAD_SIZE) {
+        return false;
+    }
+
+    /* split tokens, stop on comment or command delimiter */
+    while (i < len && tokCount < HEAD_TOKENS) {
+        while (i < len && head[i] != (char)DELIM_COMMAND
+               && isgraph((int)head[i]) == 0
+        ) {
+            i++;
+        }
+        if (i >= len || head[i] == (char)DELIM_COMMAND || head[i] == '#') {
+            break;
+        }
+        tokStart[tokCount] = i;
+        while (i < len && isgraph((int)head[i]) != 0 && head[i] != '#') {
+            i++;
+        }
+        tokEnd[tokCount++] = i;
+    }
+
+    seq[0] = '\0';
+    if (tokCount > 0 && head[tokStart[0]] == '['
+        && (tokEnd[0] - tokStart[0]) < sizeof(seq)
+    ) {
+        memcpy(seq, &head[tokStart[0]], tokEnd[0] - tokStart[0]);
+        seq[tokEnd[0] - tokStart[0]] = '\0';
+    }
+
+    /* '"["<sequence>"]" <net> <node> <command>' or
+     * '"["<sequence>"]" <net> set|lss_...|_lss_... ...' */
+    if (seq[0] != '\0' && tokCount >= 3 && isdigit((int)head[tokStart[1]])) {
+        const char *t2 = &head[tokStart[2]];
+        size_t t2Len = tokEnd[2] - tokStart[2];
+        bool_t netToken = isdigit((int)*t2) != 0
+                       || (t2Len == 3 && strncmp(t2, "set", 3) == 0)
+                       || (t2Len > 4 && strncmp(t2, "lss_", 4) == 0)
+                       || (t2Len > 5 && strncmp(t2, "_lss_", 5) == 0);
+
+        if (netToken) {
+            uint32_t net = (uint32_t)strtoul(&head[tokStart[1]], NULL, 0);
+
+            netIndex = findNet(gtwr, net);
+            stripStart = tokStart[1];
+            stripEnd = tokStart[2];
+            cmd = 2;
+        }
+    }
+
+    /* 'set network <value>' is processed by the router */
+    if (seq[0] != '\0' && tokCount > (cmd + 1)
+        && (tokEnd[cmd] - tokStart[cmd]) == 3
+        && strncmp(&head[tokStart[cmd]], "set", 3) == 0
+        && (tokEnd[cmd + 1] - tokStart[cmd + 1]) == 7
+        && strncmp(&head[tokStart[cmd + 1]], "network", 7) == 0
+    ) {
+        CO_GTWA_respErrorCode_t respErrorCode = CO_GTWA_respErrorSyntax;
+        uint8_t index = CO_GTWR_NET_NONE;
+
+        if (closed && tokCount == (cmd + 3)) {
+            uint32_t net = (uint32_t)strtoul(&head[tokStart[cmd + 2]],NULL,0);
+
+            index = findNet(gtwr, net);
+            respErrorCode = (index == CO_GTWR_NET_NONE)
+                          ? CO_GTWA_respErrorUnsupportedNet
+                          : CO_GTWA_respErrorNone;
+        }
+        if (!response(gtwr, seq, respErrorCode)) {
+            return false;
+        }
+        if (index != CO_GTWR_NET_NONE) {
+            gtwr->netDefault = index;
+        }
+        gtwr->cmdNet = CO_GTWR_NET_DISCARD;
+        return true;
+    }
+
+    if (netIndex == CO_GTWR_NET_NONE) {
+        if (!response(gtwr, seq, CO_GTWA_respErrorUnsupportedNet)) {
+            return false;
+        }
+        gtwr->cmdNet = CO_GTWR_NET_DISCARD;
+        return true;
+    }
+
+    /* remove <net> token, write characters before it */
+    if (stripEnd > 0) {
+        CO_GTWR_net_t *net = &gtwr->nets[netIndex];
+
+        CO_MemoryBarrier();
+        if (CO_fifo_getSpace(&net->cmdFifo) < stripStart) {
+            return false;
+        }
+        sharedWrite(&net->cmdFifo, (const uint8_t *)head, stripStart);
+        CO_fifo_readCommit(&gtwr->commFifo, stripEnd);
+    }
+    gtwr->cmdNet = netIndex;
+    return true;
+}
+
+
+/* Transfer commands from commFifo to the networks */
+static void processCommands(CO_GTWR_t *gtwr) {
+    for (;;) {
+        const uint8_t *buf;
+        const uint8_t *delim;
+        size_t n;
+        size_t written;
+
+        if (gtwr->cmdNet == CO_GTWR_NET_NONE && !routeCommand(gtwr)) {
+            break;
+        }
+
+        /* transfer the rest of the command, including delimiter */
+        n = CO_fifo_readSpan(&gtwr->commFifo, &buf);
+        if (n == 0) {
+            break;
+        }
+        delim = memchr(buf, DELIM_COMMAND, n);
+        if (delim != NULL) {
+            n = (size_t)(delim - buf) + 1;
+        }
+        if (gtwr->cmdNet == CO_GTWR_NET_DISCARD) {
+            written = n;
+        }
+        else {
+            written = sharedWrite(&gtwr->nets[gtwr->cmdNet].cmdFifo, buf, n);
+        }
+        CO_fifo_readCommit(&gtwr->commFifo, written);
+        if (written < n) {
+            break; /* network is busy */
+        }
+        if (delim != NULL) {
+            gtwr->cmdNet = CO_GTWR_NET_NONE;
+        }
+    }
+}
+
+
+/* Transfer responses to the application line by line */
+static void processResponses(CO_GTWR_t *gtwr) {
+    uint8_t sources = gtwr->netsCount + 1;
+
+    while (gtwr->readCallback != NULL) {
+        CO_fifo_t *fifo;
+        const uint8_t *buf;
+        const uint8_t *delim;
+        size_t n;
+        size_t written;
+        uint8_t connectionOK = 1;
+
+        /* select next source with data, round robin */
+        if (gtwr->respNet == CO_GTWR_NET_NONE) {
+            uint8_t i;
+
+            for (i = 1; i <= sources; i++) {
+                uint8_t s = (uint8_t)((gtwr->respNetLast + i) % sources);
+
+                fifo = (s < gtwr->netsCount) ? &gtwr->nets[s].respFifo
+                                             : &gtwr->respFifo;
+                if (sharedReadSpan(fifo, &buf) > 0) {
+                    gtwr->respNet = s;
+                    break;
+                }
+            }
+            if (gtwr->respNet == CO_GTWR_NET_NONE) {
+                break;
+            }
+        }
+
+        fifo = (gtwr->respNet < gtwr->netsCount)
+             ? &gtwr->nets[gtwr->respNet].respFifo : &gtwr->respFifo;
+        n = sharedReadSpan(fifo, &buf);
+        if (n == 0) {
+            break; /* wait for the rest of the response */
+        }
+        delim = memchr(buf, DELIM_COMMAND, n);
+        if (delim != NULL) {
+            n = (size_t)(delim - buf) + 1;
+        }
+        written = gtwr->readCallback(gtwr->readCallbackObject,
+                                     (const char *)buf, n, &connectionOK);
+        sharedReadCommit(fifo, written);
+        if (delim != NULL && written == n) {
+            gtwr->respNetLast = gtwr->respNet;
+            gtwr->respNet = CO_GTWR_NET_NONE;
+        }
+        if (written < n) {
+            break; /* application is busy */
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_GTWR_process(CO_GTWR_t *gtwr) {
+    if (gtwr == NULL) {
+        return;
+    }
+
+    processCommands(gtwr);
+    processResponses(gtwr);
+}
+
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_MULTI_NET */
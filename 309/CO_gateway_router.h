@@ -0,0 +1,257 @@
+/**
+ * Routing of CiA 309-3 ASCII commands to multiple CANopen networks
+ *
+ * @file        CO_gateway_router.h
+ * @ingroup     CO_CANopen_309_3_Router
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_GATEWAY_ROUTER_H
+#define CO_GATEWAY_ROUTER_H
+
+#include "309/CO_gateway_ascii.h"
+
+#if (((CO_CONFIG_GTW) & CO_CONFIG_GTW_MULTI_NET) \
+     && ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII)) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANopen_309_3_Router Gateway router
+ * Routing of ASCII commands to multiple CANopen networks
+ *
+ * @ingroup CO_CANopen_309_3
+ * @{
+ * Gateway router is a front end for gateway device with multiple CAN
+ * interfaces. Each CANopen network has own CO_t object with own Gateway-ascii
+ * object, own SDO client (and optional @ref CO_SDOclientPool) and is usually
+ * processed in own thread. Router reads commands from the application, selects
+ * the network from the optional `<net>` parameter (or default network, set
+ * with `set network <value>`) and passes the command without `<net>` to the
+ * Gateway-ascii object of that network. Responses of all networks are passed
+ * to the application line by line, so partial responses of different networks
+ * are never mixed.
+ *
+ * Router and each network exchange data through single producer, single
+ * consumer buffers, protected by CO_MemoryBarrier() only, so networks do not
+ * block each other and no CO_LOCK_OD() is used.
+ *
+ * Usage:
+ * - Router thread: CO_GTWR_init(), CO_GTWR_initRead(), then periodically
+ *   CO_GTWR_write() with new commands and CO_GTWR_process().
+ * - Thread of each network: CO_GTWR_attachNet() after each CO_CANopenInit(),
+ *   then CO_GTWR_processNet() before each CO_process().
+ *
+ * The second token after `[<sequence>]` is taken as `<net>` only, if the
+ * following token is a number (`<node>`), `set` or starts with `lss_` or
+ * `_lss_`. So `[1] 4 start` is NMT command for node 4 on default network.
+ * Commands `set network` and commands for unknown network are answered by the
+ * router.
+ */
+
+/** Size of the start of the command, which is inspected by the router */
+#define CO_GTWR_HEAD_SIZE 48
+
+/** Value of CO_GTWR_t::cmdNet, if no command is in transfer */
+#define CO_GTWR_NET_NONE 0xFFU
+/** Value of CO_GTWR_t::cmdNet, if command is discarded */
+#define CO_GTWR_NET_DISCARD 0xFEU
+
+#ifndef CO_CONFIG_GTWR_NET_COUNT
+#define CO_CONFIG_GTWR_NET_COUNT 4
+#endif
+#ifndef CO_CONFIG_GTWR_CMD_BUF_SIZE
+#define CO_CONFIG_GTWR_CMD_BUF_SIZE 200
+#endif
+#ifndef CO_CONFIG_GTWR_RESP_BUF_SIZE
+#define CO_CONFIG_GTWR_RESP_BUF_SIZE 400
+#endif
+
+
+/**
+ * One CANopen network in gateway router
+ */
+typedef struct {
+    /** CANopen network number */
+    uint16_t net;
+    /** Gateway-ascii object of the network, used by the network thread only */
+    CO_GTWA_t *gtwa;
+    /** Commands from router to network thread */
+    CO_fifo_t cmdFifo;
+    /** Buffer for cmdFifo */
+    uint8_t cmdBuf[CO_CONFIG_GTWR_CMD_BUF_SIZE + 1];
+    /** Responses from network thread to router */
+    CO_fifo_t respFifo;
+    /** Buffer for respFifo */
+    uint8_t respBuf[CO_CONFIG_GTWR_RESP_BUF_SIZE + 1];
+} CO_GTWR_net_t;
+
+
+/**
+ * Gateway router object
+ */
+typedef struct {
+    /** Networks, initialized by CO_GTWR_init() */
+    CO_GTWR_net_t nets[CO_CONFIG_GTWR_NET_COUNT];
+    /** Number of used elements in nets */
+    uint8_t netsCount;
+    /** Index of default network in nets */
+    uint8_t netDefault;
+    /** Index of network, to which command is currently transferred, or
+     * CO_GTWR_NET_NONE or CO_GTWR_NET_DISCARD */
+    uint8_t cmdNet;
+    /** Index of network, from which response is currently transferred, or
+     * CO_GTWR_NET_NONE. Index netsCount is for router's own responses. */
+    uint8_t respNet;
+    /** Index of network, whose response was transferred last */
+    uint8_t respNetLast;
+    /** Commands from application */
+    CO_fifo_t commFifo;
+    /** Buffer for commFifo */
+    uint8_t commBuf[CO_CONFIG_GTWA_COMM_BUF_SIZE + 1];
+    /** Responses generated by the router itself */
+    CO_fifo_t respFifo;
+    /** Buffer for respFifo */
+    uint8_t respBuf[CO_GTWA_RESP_BUF_SIZE + 1];
+    /** Pointer to external function for reading responses, see
+     * CO_GTWA_initRead() */
+    size_t (*readCallback)(void *object,
+                           const char *buf,
+                           size_t count,
+                           uint8_t *connectionOK);
+    /** Pointer to object, which will be used inside readCallback */
+    void *readCallbackObject;
+} CO_GTWR_t;
+
+
+/**
+ * Initialize gateway router
+ *
+ * Must be called before network threads are started.
+ *
+ * @param gtwr This object will be initialized
+ * @param nets Array of CANopen network numbers, first is default network.
+ * @param netsCount Number of elements in nets, up to
+ * @ref CO_CONFIG_GTWR_NET_COUNT.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWR_init(CO_GTWR_t *gtwr,
+                              const uint16_t nets[],
+                              uint8_t netsCount);
+
+
+/**
+ * Initialize read callback in gateway router, see CO_GTWA_initRead()
+ *
+ * @param gtwr This object
+ * @param readCallback Pointer to external function, called from
+ * CO_GTWR_process().
+ * @param readCallbackObject Pointer to object, which will be used inside
+ * readCallback
+ */
+void CO_GTWR_initRead(CO_GTWR_t *gtwr,
+                      size_t (*readCallback)(void *object,
+                                             const char *buf,
+                                             size_t count,
+                                             uint8_t *connectionOK),
+                      void *readCallbackObject);
+
+
+/**
+ * Get free write buffer space in gateway router
+ *
+ * @param gtwr This object
+ *
+ * @return number of available bytes
+ */
+static inline size_t CO_GTWR_write_getSpace(CO_GTWR_t *gtwr) {
+    return CO_fifo_getSpace(&gtwr->commFifo);
+}
+
+
+/**
+ * Write commands into gateway router, see CO_GTWA_write()
+ *
+ * Must be called from the router thread.
+ *
+ * @param gtwr This object
+ * @param buf Buffer which will be copied
+ * @param count Number of bytes in buf
+ *
+ * @return number of bytes actually written.
+ */
+static inline size_t CO_GTWR_write(CO_GTWR_t *gtwr,
+                                   const char *buf,
+                                   size_t count)
+{
+    return CO_fifo_write(&gtwr->commFifo, (const uint8_t *)buf, count, NULL);
+}
+
+
+/**
+ * Process gateway router
+ *
+ * Route new commands to the networks and pass responses to the readCallback.
+ * Must be called cyclically from the router thread.
+ *
+ * @param gtwr This object
+ */
+void CO_GTWR_process(CO_GTWR_t *gtwr);
+
+
+/**
+ * Attach Gateway-ascii object of the network to the router
+ *
+ * Must be called from network thread after each CO_GTWA_init() (inside
+ * CO_CANopenInit()). It sets readCallback and default network of the gtwa.
+ *
+ * @param gtwr Gateway router object
+ * @param netIndex Index of the network from CO_GTWR_init()
+ * @param gtwa Initialized Gateway-ascii object of the network
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWR_attachNet(CO_GTWR_t *gtwr,
+                                   uint8_t netIndex,
+                                   CO_GTWA_t *gtwa);
+
+
+/**
+ * Pass routed commands to Gateway-ascii object of the network
+ *
+ * Must be called from network thread, before CO_process().
+ *
+ * @param gtwr Gateway router object
+ * @param netIndex Index of the network from CO_GTWR_init()
+ */
+void CO_GTWR_processNet(CO_GTWR_t *gtwr, uint8_t netIndex);
+
+/** @} */ /* CO_CANopen_309_3_Router */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_MULTI_NET */
+
+#endif /* CO_GATEWAY_ROUTER_H */
@@ -25,6 +25,37 @@
 
 #include "CANopen.h"
 
+/* Measurement of processing time, see CO_stats.h */
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+ #define CO_STATS_BEGIN() uint32_t statsCycles = CO_cycleCounter()
+ #define CO_STATS_END(co, id) \
+    CO_stats_record((co)->stats, (id), CO_cycleCounter() - statsCycles)
+#else
+ #define CO_STATS_BEGIN()
+ #define CO_STATS_END(co, id)
+#endif
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+ #if !((CO_CONFIG_PDO) & CO_CONFIG_FLAG_TIMERNEXT)
+  #error CO_CONFIG_FLAG_TIMERNEXT must be enabled in CO_CONFIG_PDO.
+ #endif
+ #if !((CO_CONFIG_TIMERQ) & CO_CONFIG_TIMERQ_ENABLE)
+  #error CO_CONFIG_TIMERQ_ENABLE must be enabled.
+ #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST) && !((CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER)
+  #error CO_CONFIG_PDO_SCHEDULER must be enabled in CO_CONFIG_PDO.
+ #endif
+ /* timerNext_us value, if PDO has no deadline */
+ #define CO_PDO_SCHED_NO_DEADLINE 0xFFFFFFFFUL
+#endif
+
+/* CAN module for real-time objects, see CO_SEPARATE_RT_CAN */
+#ifdef CO_SEPARATE_RT_CAN
+#define CO_CANMODULE_RT co->CANmoduleRT
+#else
+#define CO_CANMODULE_RT co->CANmodule
+#endif
+
 /* Get values from CO_config_t or from single default OD.h ********************/
 #ifdef CO_MULTIPLE_OD
 #define CO_GET_CO(obj) co->obj
@@ -35,7 +66,12 @@
 #include "OD.h"
 #define CO_GET_CO(obj) CO_##obj
 #define CO_GET_CNT(obj) OD_CNT_##obj
+#if OD_INSTANCES
+/* od may be instance of the default OD, see OD_instance_init() */
+#define OD_GET(entry, index) OD_instanceEntry(od, OD, OD_ENTRY_##entry)
+#else
 #define OD_GET(entry, index) OD_ENTRY_##entry
+#endif
 
 /* Verify parameters from "OD.h" and calculate necessary values for each object:
  * - verify OD_CNT_xx or set default
@@ -260,6 +296,11 @@
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
  #define OD_CNT_GTWA 1
 #endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+ #define CO_RX_CNT_GTWA CO_CONFIG_GTWA_SUB_CAN_COUNT
+#else
+ #define CO_RX_CNT_GTWA 0
+#endif
 
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
  #if !defined OD_CNT_TRACE
@@ -272,6 +313,44 @@
 /* Indexes of CO_CANrx_t and CO_CANtx_t objects in CO_CANmodule_t and total
  * number of them. Indexes are sorted in a way, that objects with highest
  * priority of the CAN identifier are listed first. */
+#ifdef CO_SEPARATE_RT_CAN
+/* Objects of CO_t::CANmodule are first, objects of CO_t::CANmoduleRT follow
+ * from CO_RX_IDX_RT and CO_TX_IDX_RT. Their indexes are relative to it. */
+#define CO_RX_IDX_NMT_SLV   0
+#define CO_RX_IDX_EM_CONS   (CO_RX_IDX_NMT_SLV  + CO_RX_CNT_NMT_SLV)
+#define CO_RX_IDX_TIME      (CO_RX_IDX_EM_CONS  + CO_RX_CNT_EM_CONS)
+#define CO_RX_IDX_SDO_SRV   (CO_RX_IDX_TIME     + CO_RX_CNT_TIME)
+#define CO_RX_IDX_SDO_CLI   (CO_RX_IDX_SDO_SRV  + CO_RX_CNT_SDO_SRV)
+#define CO_RX_IDX_HB_CONS   (CO_RX_IDX_SDO_CLI  + CO_RX_CNT_SDO_CLI)
+#define CO_RX_IDX_NG_SLV    (CO_RX_IDX_HB_CONS  + CO_RX_CNT_HB_CONS)
+#define CO_RX_IDX_NG_MST    (CO_RX_IDX_NG_SLV   + CO_RX_CNT_NG_SLV)
+#define CO_RX_IDX_LSS_SLV   (CO_RX_IDX_NG_MST   + CO_RX_CNT_NG_MST)
+#define CO_RX_IDX_LSS_MST   (CO_RX_IDX_LSS_SLV  + CO_RX_CNT_LSS_SLV)
+#define CO_RX_IDX_GTWA      (CO_RX_IDX_LSS_MST  + CO_RX_CNT_LSS_MST)
+#define CO_RX_IDX_RT        (CO_RX_IDX_GTWA     + CO_RX_CNT_GTWA)
+#define CO_RX_IDX_SYNC      0
+#define CO_RX_IDX_GFC       (CO_RX_IDX_SYNC     + CO_RX_CNT_SYNC)
+#define CO_RX_IDX_SRDO      (CO_RX_IDX_GFC      + CO_RX_CNT_GFC)
+#define CO_RX_IDX_RPDO      (CO_RX_IDX_SRDO     + CO_RX_CNT_SRDO * 2)
+#define CO_CNT_ALL_RX_MSGS  (CO_RX_IDX_RT + CO_RX_IDX_RPDO + CO_RX_CNT_RPDO)
+
+#define CO_TX_IDX_NMT_MST   0
+#define CO_TX_IDX_EM_PROD   (CO_TX_IDX_NMT_MST  + CO_TX_CNT_NMT_MST)
+#define CO_TX_IDX_TIME      (CO_TX_IDX_EM_PROD  + CO_TX_CNT_EM_PROD)
+#define CO_TX_IDX_SDO_SRV   (CO_TX_IDX_TIME     + CO_TX_CNT_TIME)
+#define CO_TX_IDX_SDO_CLI   (CO_TX_IDX_SDO_SRV  + CO_TX_CNT_SDO_SRV)
+#define CO_TX_IDX_HB_PROD   (CO_TX_IDX_SDO_CLI  + CO_TX_CNT_SDO_CLI)
+#define CO_TX_IDX_NG_SLV    (CO_TX_IDX_HB_PROD  + CO_TX_CNT_HB_PROD)
+#define CO_TX_IDX_NG_MST    (CO_TX_IDX_NG_SLV   + CO_TX_CNT_NG_SLV)
+#define CO_TX_IDX_LSS_SLV   (CO_TX_IDX_NG_MST   + CO_TX_CNT_NG_MST)
+#define CO_TX_IDX_LSS_MST   (CO_TX_IDX_LSS_SLV  + CO_TX_CNT_LSS_SLV)
+#define CO_TX_IDX_RT        (CO_TX_IDX_LSS_MST  + CO_TX_CNT_LSS_MST)
+#define CO_TX_IDX_SYNC      0
+#define CO_TX_IDX_GFC       (CO_TX_IDX_SYNC     + CO_TX_CNT_SYNC)
+#define CO_TX_IDX_SRDO      (CO_TX_IDX_GFC      + CO_TX_CNT_GFC)
+#define CO_TX_IDX_TPDO      (CO_TX_IDX_SRDO     + CO_TX_CNT_SRDO * 2)
+#define CO_CNT_ALL_TX_MSGS  (CO_TX_IDX_RT + CO_TX_IDX_TPDO + CO_TX_CNT_TPDO)
+#else
 #define CO_RX_IDX_NMT_SLV   0
 #define CO_RX_IDX_SYNC      (CO_RX_IDX_NMT_SLV  + CO_RX_CNT_NMT_SLV)
 #define CO_RX_IDX_EM_CONS   (CO_RX_IDX_SYNC     + CO_RX_CNT_SYNC)
@@ -286,7 +365,8 @@
 #define CO_RX_IDX_NG_MST    (CO_RX_IDX_NG_SLV   + CO_RX_CNT_NG_SLV)
 #define CO_RX_IDX_LSS_SLV   (CO_RX_IDX_NG_MST   + CO_RX_CNT_NG_MST)
 #define CO_RX_IDX_LSS_MST   (CO_RX_IDX_LSS_SLV  + CO_RX_CNT_LSS_SLV)
-#define CO_CNT_ALL_RX_MSGS  (CO_RX_IDX_LSS_MST  + CO_RX_CNT_LSS_MST)
+#define CO_RX_IDX_GTWA      (CO_RX_IDX_LSS_MST  + CO_RX_CNT_LSS_MST)
+#define CO_CNT_ALL_RX_MSGS  (CO_RX_IDX_GTWA     + CO_RX_CNT_GTWA)
 
 #define CO_TX_IDX_NMT_MST   0
 #define CO_TX_IDX_SYNC      (CO_TX_IDX_NMT_MST  + CO_TX_CNT_NMT_MST)
@@ -303,11 +383,51 @@
 #define CO_TX_IDX_LSS_SLV   (CO_TX_IDX_NG_MST   + CO_TX_CNT_NG_MST)
 #define CO_TX_IDX_LSS_MST   (CO_TX_IDX_LSS_SLV  + CO_TX_CNT_LSS_SLV)
 #define CO_CNT_ALL_TX_MSGS  (CO_TX_IDX_LSS_MST  + CO_TX_CNT_LSS_MST)
+#endif /* CO_SEPARATE_RT_CAN */
 #endif /* #ifdef #else CO_MULTIPLE_OD */
 
 
-/* Objects from heap **********************************************************/
+/* Objects from heap or arena *************************************************/
 #ifndef CO_USE_GLOBALS
+#ifdef CO_USE_ARENA
+#include <string.h>
+
+#if defined(CO_alloc) || defined(CO_free)
+#error CO_alloc and CO_free can not be used with CO_USE_ARENA
+#endif
+
+/* Placement of objects inside arena. Hot objects are placed from the start of
+ * the arena, cold objects from the first cache line after them. If hot is
+ * NULL, only sizes are calculated and all objects point to scratch. */
+typedef struct {
+    uint8_t *hot;
+    uint8_t *cold;
+    size_t hotSize;
+    size_t coldSize;
+    void *scratch;
+} CO_arena_t;
+
+/* Arena used by the CO_new() call in progress */
+static CO_arena_t *CO_arena = NULL;
+
+#define CO_ARENA_ROUND(size, align) \
+    (((size) + ((size_t)(align) - 1U)) & ~((size_t)(align) - 1U))
+
+static void *CO_arenaAlloc(bool_t hot, size_t num, size_t size) {
+    size_t *used = hot ? &CO_arena->hotSize : &CO_arena->coldSize;
+    uint8_t *base = hot ? CO_arena->hot : CO_arena->cold;
+    size_t offset = CO_ARENA_ROUND(*used, CO_ARENA_ALIGN);
+
+    *used = offset + num * size;
+    return (CO_arena->hot == NULL) ? CO_arena->scratch : (void *)&base[offset];
+}
+
+/* Arena is cleared, objects are already zero and freed with the arena */
+#define CO_alloc(num, size)             CO_arenaAlloc(false, (num), (size))
+#define CO_allocHot(num, size)          CO_arenaAlloc(true, (num), (size))
+#define CO_free(ptr)                    (void)(ptr)
+
+#else /* CO_USE_ARENA */
 #include <stdlib.h>
 
 /* Default allocation strategy ************************************************/
@@ -330,10 +450,17 @@
 
 #endif
 
+/* Objects in time critical path, no difference on heap */
+#define CO_allocHot(num, size)          CO_alloc((num), (size))
+#endif /* CO_USE_ARENA */
+
 /* Define macros for allocation */
 #define CO_alloc_break_on_fail(var, num, size) {                    \
     var = CO_alloc((num), (size));                                  \
     if((var) != NULL) { mem += (size) * (num); } else { break; } }
+#define CO_allocHot_break_on_fail(var, num, size) {                 \
+    var = CO_allocHot((num), (size));                               \
+    if((var) != NULL) { mem += (size) * (num); } else { break; } }
 
 #ifdef CO_MULTIPLE_OD
 #define ON_MULTI_OD(sentence) sentence
@@ -341,6 +468,9 @@
 #define ON_MULTI_OD(sentence)
 #endif
 
+#ifdef CO_USE_ARENA
+static
+#endif
 CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     CO_t *co = NULL;
     /* return values */
@@ -375,7 +505,7 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 
         /* CANopen object */
-        CO_alloc_break_on_fail(co, 1, sizeof(*co));
+        CO_allocHot_break_on_fail(co, 1, sizeof(*co));
 
 #ifdef CO_MULTIPLE_OD
         co->config = config;
@@ -438,6 +568,17 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
             CO_alloc_break_on_fail(co->SDOserver, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserver));
             ON_MULTI_OD(RX_CNT_SDO_SRV = config->CNT_SDO_SRV);
             ON_MULTI_OD(TX_CNT_SDO_SRV = config->CNT_SDO_SRV);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            CO_alloc_break_on_fail(co->SDOserverBufArena,
+                                   CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT,
+                                   CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1);
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+            CO_allocHot_break_on_fail(co->SDOserverReadyRing, CO_GET_CNT(SDO_SRV) + 1, sizeof(*co->SDOserverReadyRing));
+            CO_allocHot_break_on_fail(co->SDOserverReadyQueued, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserverReadyQueued));
+            CO_allocHot_break_on_fail(co->SDOserverActive, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserverActive));
+            CO_allocHot_break_on_fail(co->SDOserverActiveFlag, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserverActiveFlag));
+#endif
         }
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
@@ -466,7 +607,7 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t RX_CNT_SYNC = 0);
         ON_MULTI_OD(uint8_t TX_CNT_SYNC = 0);
         if (CO_GET_CNT(SYNC) == 1) {
-            CO_alloc_break_on_fail(co->SYNC, CO_GET_CNT(SYNC), sizeof(*co->SYNC));
+            CO_allocHot_break_on_fail(co->SYNC, CO_GET_CNT(SYNC), sizeof(*co->SYNC));
             ON_MULTI_OD(RX_CNT_SYNC = 1);
  #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER
             ON_MULTI_OD(TX_CNT_SYNC = 1);
@@ -477,7 +618,17 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
         ON_MULTI_OD(uint16_t RX_CNT_RPDO = 0);
         if (CO_GET_CNT(RPDO) > 0) {
-            CO_alloc_break_on_fail(co->RPDO, CO_GET_CNT(RPDO), sizeof(*co->RPDO));
+            CO_allocHot_break_on_fail(co->RPDO, CO_GET_CNT(RPDO), sizeof(*co->RPDO));
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+            CO_alloc_break_on_fail(co->RPDOcold, CO_GET_CNT(RPDO), sizeof(*co->RPDOcold));
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+            CO_allocHot_break_on_fail(co->RPDOtimerItems, CO_GET_CNT(RPDO), sizeof(*co->RPDOtimerItems));
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+            CO_allocHot_break_on_fail(co->RPDOreadyRing, CO_GET_CNT(RPDO) + 1, sizeof(*co->RPDOreadyRing));
+            CO_allocHot_break_on_fail(co->RPDOreadyQueued, CO_GET_CNT(RPDO), sizeof(*co->RPDOreadyQueued));
+ #endif
             ON_MULTI_OD(RX_CNT_RPDO = config->CNT_RPDO);
         }
 #endif
@@ -485,7 +636,17 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
         ON_MULTI_OD(uint16_t TX_CNT_TPDO = 0);
         if (CO_GET_CNT(TPDO) > 0) {
-            CO_alloc_break_on_fail(co->TPDO, CO_GET_CNT(TPDO), sizeof(*co->TPDO));
+            CO_allocHot_break_on_fail(co->TPDO, CO_GET_CNT(TPDO), sizeof(*co->TPDO));
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+            CO_alloc_break_on_fail(co->TPDOcold, CO_GET_CNT(TPDO), sizeof(*co->TPDOcold));
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+            CO_allocHot_break_on_fail(co->TPDOtimerItems, CO_GET_CNT(TPDO), sizeof(*co->TPDOtimerItems));
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+            CO_allocHot_break_on_fail(co->TPDOburstBuffers, CO_GET_CNT(TPDO), sizeof(*co->TPDOburstBuffers));
+            CO_allocHot_break_on_fail(co->TPDOburstCanIds, CO_GET_CNT(TPDO), sizeof(*co->TPDOburstCanIds));
+ #endif
             ON_MULTI_OD(TX_CNT_TPDO = config->CNT_TPDO);
         }
 #endif
@@ -538,8 +699,12 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+        ON_MULTI_OD(uint8_t RX_CNT_GTWA = 0);
         if (CO_GET_CNT(GTWA) == 1) {
             CO_alloc_break_on_fail(co->gtwa, CO_GET_CNT(GTWA), sizeof(*co->gtwa));
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+            ON_MULTI_OD(RX_CNT_GTWA = CO_CONFIG_GTWA_SUB_CAN_COUNT);
+ #endif
         }
 #endif
 
@@ -549,27 +714,38 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         }
 #endif
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+        CO_allocHot_break_on_fail(co->stats, 1, sizeof(*co->stats));
+#endif
+
 #ifdef CO_MULTIPLE_OD
         /* Indexes of CO_CANrx_t and CO_CANtx_t objects in CO_CANmodule_t and
          * total number of them. Indexes are sorted in a way, that objects with
          * highest priority of the CAN identifier are listed first. */
         int16_t idxRx = 0;
+        /* objects of CO_CANMODULE_RT */
+#ifdef CO_SEPARATE_RT_CAN
+        int16_t idxRxSeparateRT = 0;
+        int16_t *idxRxRT = &idxRxSeparateRT;
+#else
+        int16_t *idxRxRT = &idxRx;
+#endif
         co->RX_IDX_NMT_SLV = idxRx; idxRx += RX_CNT_NMT_SLV;
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
-        co->RX_IDX_SYNC = idxRx; idxRx += RX_CNT_SYNC;
+        co->RX_IDX_SYNC = *idxRxRT; *idxRxRT += RX_CNT_SYNC;
 #endif
         co->RX_IDX_EM_CONS = idxRx; idxRx += RX_CNT_EM_CONS;
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
         co->RX_IDX_TIME = idxRx; idxRx += RX_CNT_TIME;
 #endif
 #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_ENABLE
-        co->RX_IDX_GFC = idxRx; idxRx += RX_CNT_GFC;
+        co->RX_IDX_GFC = *idxRxRT; *idxRxRT += RX_CNT_GFC;
 #endif
 #if (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE
-        co->RX_IDX_SRDO = idxRx; idxRx += RX_CNT_SRDO * 2;
+        co->RX_IDX_SRDO = *idxRxRT; *idxRxRT += RX_CNT_SRDO * 2;
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
-        co->RX_IDX_RPDO = idxRx; idxRx += RX_CNT_RPDO;
+        co->RX_IDX_RPDO = *idxRxRT; *idxRxRT += RX_CNT_RPDO;
 #endif
         co->RX_IDX_SDO_SRV = idxRx; idxRx += RX_CNT_SDO_SRV;
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
@@ -589,26 +765,39 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
         co->RX_IDX_LSS_MST = idxRx; idxRx += RX_CNT_LSS_MST;
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+        co->RX_IDX_GTWA = idxRx; idxRx += RX_CNT_GTWA;
+#endif
+#ifdef CO_SEPARATE_RT_CAN
+        co->RX_IDX_RT = idxRx;
+        idxRx += idxRxSeparateRT;
 #endif
         co->CNT_ALL_RX_MSGS = idxRx;
 
         int16_t idxTx = 0;
+#ifdef CO_SEPARATE_RT_CAN
+        int16_t idxTxSeparateRT = 0;
+        int16_t *idxTxRT = &idxTxSeparateRT;
+#else
+        int16_t *idxTxRT = &idxTx;
+#endif
         co->TX_IDX_NMT_MST = idxTx; idxTx += TX_CNT_NMT_MST;
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
-        co->TX_IDX_SYNC = idxTx; idxTx += TX_CNT_SYNC;
+        co->TX_IDX_SYNC = *idxTxRT; *idxTxRT += TX_CNT_SYNC;
 #endif
         co->TX_IDX_EM_PROD = idxTx; idxTx += TX_CNT_EM_PROD;
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
         co->TX_IDX_TIME = idxTx; idxTx += TX_CNT_TIME;
 #endif
 #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_ENABLE
-        co->TX_IDX_GFC = idxTx; idxTx += TX_CNT_GFC;
+        co->TX_IDX_GFC = *idxTxRT; *idxTxRT += TX_CNT_GFC;
 #endif
 #if (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE
-        co->TX_IDX_SRDO = idxTx; idxTx += TX_CNT_SRDO * 2;
+        co->TX_IDX_SRDO = *idxTxRT; *idxTxRT += TX_CNT_SRDO * 2;
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
-        co->TX_IDX_TPDO = idxTx; idxTx += TX_CNT_TPDO;
+        co->TX_IDX_TPDO = *idxTxRT; *idxTxRT += TX_CNT_TPDO;
 #endif
         co->TX_IDX_SDO_SRV = idxTx; idxTx += TX_CNT_SDO_SRV;
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
@@ -626,18 +815,25 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
         co->TX_IDX_LSS_MST = idxTx; idxTx += TX_CNT_LSS_MST;
+#endif
+#ifdef CO_SEPARATE_RT_CAN
+        co->TX_IDX_RT = idxTx;
+        idxTx += idxTxSeparateRT;
 #endif
         co->CNT_ALL_TX_MSGS = idxTx;
 #endif /* #ifdef CO_MULTIPLE_OD */
 
         /* CANmodule */
-        CO_alloc_break_on_fail(co->CANmodule, 1, sizeof(*co->CANmodule));
+        CO_allocHot_break_on_fail(co->CANmodule, 1, sizeof(*co->CANmodule));
+#ifdef CO_SEPARATE_RT_CAN
+        CO_allocHot_break_on_fail(co->CANmoduleRT, 1, sizeof(*co->CANmoduleRT));
+#endif
 
         /* CAN RX blocks */
-        CO_alloc_break_on_fail(co->CANrx, CO_GET_CO(CNT_ALL_RX_MSGS), sizeof(*co->CANrx));
+        CO_allocHot_break_on_fail(co->CANrx, CO_GET_CO(CNT_ALL_RX_MSGS), sizeof(*co->CANrx));
 
         /* CAN TX blocks */
-        CO_alloc_break_on_fail(co->CANtx, CO_GET_CO(CNT_ALL_TX_MSGS), sizeof(*co->CANtx));
+        CO_allocHot_break_on_fail(co->CANtx, CO_GET_CO(CNT_ALL_TX_MSGS), sizeof(*co->CANtx));
 
         /* finish successfully, set other parameters */
         co->nodeIdUnconfigured = true;
@@ -659,12 +855,22 @@ void CO_delete(CO_t *co) {
     }
 
     CO_CANmodule_disable(co->CANmodule);
+#ifdef CO_SEPARATE_RT_CAN
+    CO_CANmodule_disable(co->CANmoduleRT);
+#endif
 
     /* CANmodule */
     CO_free(co->CANtx);
     CO_free(co->CANrx);
+#ifdef CO_SEPARATE_RT_CAN
+    CO_free(co->CANmoduleRT);
+#endif
     CO_free(co->CANmodule);
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_free(co->stats);
+#endif
+
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
     CO_free(co->trace);
 #endif
@@ -695,10 +901,30 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+    CO_free(co->TPDOburstCanIds);
+    CO_free(co->TPDOburstBuffers);
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    CO_free(co->TPDOtimerItems);
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    CO_free(co->TPDOcold);
+ #endif
     CO_free(co->TPDO);
 #endif
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    CO_free(co->RPDOtimerItems);
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+    CO_free(co->RPDOreadyQueued);
+    CO_free(co->RPDOreadyRing);
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    CO_free(co->RPDOcold);
+ #endif
     CO_free(co->RPDO);
 #endif
 
@@ -711,10 +937,19 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
-    free(co->SDOclient);
+    CO_free(co->SDOclient);
 #endif
 
     /* SDOserver */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+    CO_free(co->SDOserverActiveFlag);
+    CO_free(co->SDOserverActive);
+    CO_free(co->SDOserverReadyQueued);
+    CO_free(co->SDOserverReadyRing);
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    CO_free(co->SDOserverBufArena);
+#endif
     CO_free(co->SDOserver);
 
     /* Emergency */
@@ -741,6 +976,61 @@ void CO_delete(CO_t *co) {
     /* CANopen object */
     CO_free(co);
 }
+
+#ifdef CO_USE_ARENA
+/* Place all objects with the help of CO_new(). If arena->hot is NULL, only
+ * sizes of hot and cold objects are calculated. */
+static CO_t *CO_arenaLayout(CO_config_t *config, CO_arena_t *arena) {
+    CO_t *co;
+
+    CO_arena = arena;
+    co = CO_new(config, NULL);
+    CO_arena = NULL;
+    return co;
+}
+
+size_t CO_sizeof(CO_config_t *config) {
+    CO_t scratch;
+    CO_arena_t arena = { NULL, NULL, 0, 0, &scratch };
+
+    memset(&scratch, 0, sizeof(scratch));
+    if (CO_arenaLayout(config, &arena) == NULL) {
+        return 0;
+    }
+    return CO_ARENA_ROUND(arena.hotSize, CO_ARENA_CACHE_LINE) + arena.coldSize;
+}
+
+CO_t *CO_newArena(CO_config_t *config, void *arena, size_t arenaSize,
+                  uint32_t *arenaMemoryUsed)
+{
+    CO_t scratch;
+    CO_arena_t layout = { NULL, NULL, 0, 0, &scratch };
+    CO_t *co = NULL;
+    size_t size = 0;
+
+    memset(&scratch, 0, sizeof(scratch));
+    if (arena != NULL && ((uintptr_t)arena & (CO_ARENA_ALIGN - 1U)) == 0U
+        && CO_arenaLayout(config, &layout) != NULL
+    ) {
+        size_t hotSize = CO_ARENA_ROUND(layout.hotSize, CO_ARENA_CACHE_LINE);
+
+        if ((hotSize + layout.coldSize) <= arenaSize) {
+            size = hotSize + layout.coldSize;
+            memset(arena, 0, size);
+            layout.hot = (uint8_t *)arena;
+            layout.cold = &layout.hot[hotSize];
+            layout.hotSize = 0;
+            layout.coldSize = 0;
+            co = CO_arenaLayout(config, &layout);
+        }
+    }
+
+    if (arenaMemoryUsed != NULL) {
+        *arenaMemoryUsed = (uint32_t)size;
+    }
+    return co;
+}
+#endif /* CO_USE_ARENA */
 #endif /* #ifndef CO_USE_GLOBALS */
 
 
@@ -748,9 +1038,15 @@ void CO_delete(CO_t *co) {
 #ifdef CO_USE_GLOBALS
  #ifdef CO_MULTIPLE_OD
   #error CO_MULTIPLE_OD can not be used with CO_USE_GLOBALS
+ #endif
+ #ifdef CO_USE_ARENA
+  #error CO_USE_ARENA can not be used with CO_USE_GLOBALS
  #endif
     static CO_t COO;
     static CO_CANmodule_t COO_CANmodule;
+#ifdef CO_SEPARATE_RT_CAN
+    static CO_CANmodule_t COO_CANmoduleRT;
+#endif
     static CO_CANrx_t COO_CANmodule_rxArray[CO_CNT_ALL_RX_MSGS];
     static CO_CANtx_t COO_CANmodule_txArray[CO_CNT_ALL_TX_MSGS];
     static CO_NMT_t COO_NMT;
@@ -769,6 +1065,16 @@ void CO_delete(CO_t *co) {
     static CO_EM_fifo_t COO_EM_FIFO[CO_GET_CNT(ARR_1003) + 1];
 #endif
     static CO_SDOserver_t COO_SDOserver[OD_CNT_SDO_SRV];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    static uint8_t COO_SDOserverBufArena[CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT
+                                         * (CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1)];
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+    static uint16_t COO_SDOserverReadyRing[OD_CNT_SDO_SRV + 1];
+    static uint8_t COO_SDOserverReadyQueued[OD_CNT_SDO_SRV];
+    static uint8_t COO_SDOserverActive[OD_CNT_SDO_SRV];
+    static uint8_t COO_SDOserverActiveFlag[OD_CNT_SDO_SRV];
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     static CO_SDOclient_t COO_SDOclient[OD_CNT_SDO_CLI];
 #endif
@@ -780,9 +1086,29 @@ void CO_delete(CO_t *co) {
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
     static CO_RPDO_t COO_RPDO[OD_CNT_RPDO];
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    static CO_PDO_cold_t COO_RPDOcold[OD_CNT_RPDO];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    static CO_timerQueue_item_t COO_RPDOtimerItems[OD_CNT_RPDO];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+    static uint16_t COO_RPDOreadyRing[OD_CNT_RPDO + 1];
+    static uint8_t COO_RPDOreadyQueued[OD_CNT_RPDO];
+ #endif
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
     static CO_TPDO_t COO_TPDO[OD_CNT_TPDO];
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    static CO_PDO_cold_t COO_TPDOcold[OD_CNT_TPDO];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    static CO_timerQueue_item_t COO_TPDOtimerItems[OD_CNT_TPDO];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+    static CO_CANtx_t *COO_TPDOburstBuffers[OD_CNT_TPDO];
+    static uint16_t COO_TPDOburstCanIds[OD_CNT_TPDO];
+ #endif
 #endif
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
     static CO_LEDs_t COO_LEDs;
@@ -804,12 +1130,10 @@ void CO_delete(CO_t *co) {
     static CO_GTWA_t COO_gtwa;
 #endif
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
-  #ifndef CO_TRACE_BUFFER_SIZE_FIXED
-    #define CO_TRACE_BUFFER_SIZE_FIXED 100
-  #endif
     static CO_trace_t COO_trace[OD_CNT_TRACE];
-    static uint32_t COO_traceTimeBuffers[OD_CNT_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
-    static int32_t COO_traceValueBuffers[OD_CNT_TRACE][CO_TRACE_BUFFER_SIZE_FIXED];
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    static CO_stats_t COO_stats;
 #endif
 
 CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
@@ -818,6 +1142,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     CO_t *co = &COO;
 
     co->CANmodule = &COO_CANmodule;
+#ifdef CO_SEPARATE_RT_CAN
+    co->CANmoduleRT = &COO_CANmoduleRT;
+#endif
     co->CANrx = &COO_CANmodule_rxArray[0];
     co->CANtx = &COO_CANmodule_txArray[0];
 
@@ -837,6 +1164,15 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     co->em_fifo = &COO_EM_FIFO[0];
 #endif
     co->SDOserver = &COO_SDOserver[0];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    co->SDOserverBufArena = &COO_SDOserverBufArena[0];
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+    co->SDOserverReadyRing = &COO_SDOserverReadyRing[0];
+    co->SDOserverReadyQueued = &COO_SDOserverReadyQueued[0];
+    co->SDOserverActive = &COO_SDOserverActive[0];
+    co->SDOserverActiveFlag = &COO_SDOserverActiveFlag[0];
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     co->SDOclient = &COO_SDOclient[0];
 #endif
@@ -848,9 +1184,29 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
     co->RPDO = &COO_RPDO[0];
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    co->RPDOcold = &COO_RPDOcold[0];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    co->RPDOtimerItems = &COO_RPDOtimerItems[0];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+    co->RPDOreadyRing = &COO_RPDOreadyRing[0];
+    co->RPDOreadyQueued = &COO_RPDOreadyQueued[0];
+ #endif
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
     co->TPDO = &COO_TPDO[0];
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+    co->TPDOcold = &COO_TPDOcold[0];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    co->TPDOtimerItems = &COO_TPDOtimerItems[0];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+    co->TPDOburstBuffers = &COO_TPDOburstBuffers[0];
+    co->TPDOburstCanIds = &COO_TPDOburstCanIds[0];
+ #endif
 #endif
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
     co->LEDs = &COO_LEDs;
@@ -873,9 +1229,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #endif
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
     co->trace = &COO_trace[0];
-    co->traceTimeBuffers = &COO_traceTimeBuffers[0][0];
-    co->traceValueBuffers = &COO_traceValueBuffers[0][0];
-    co->traceBufferSize = CO_TRACE_BUFFER_SIZE_FIXED;
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    co->stats = &COO_stats;
 #endif
 
     return co;
@@ -887,6 +1243,9 @@ void CO_delete(CO_t *co) {
     }
 
     CO_CANmodule_disable(co->CANmodule);
+#ifdef CO_SEPARATE_RT_CAN
+    CO_CANmodule_disable(co->CANmoduleRT);
+#endif
 }
 #endif /* #ifdef CO_USE_GLOBALS */
 
@@ -902,12 +1261,18 @@ bool_t CO_isLSSslaveEnabled(CO_t *co) {
 
 /******************************************************************************/
 CO_ReturnError_t CO_CANinit(CO_t *co, void *CANptr, uint16_t bitRate) {
+#ifdef CO_SEPARATE_RT_CAN
+    return CO_CANinitSeparate(co, CANptr, CANptr, bitRate);
+#else
     CO_ReturnError_t err;
 
     if (co == NULL) { return CO_ERROR_ILLEGAL_ARGUMENT; }
 
     co->CANmodule->CANnormal = false;
     CO_CANsetConfigurationMode(CANptr);
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+    co->CANbitRate = bitRate;
+#endif
 
     /* CANmodule */
     err = CO_CANmodule_init(co->CANmodule,
@@ -919,9 +1284,55 @@ CO_ReturnError_t CO_CANinit(CO_t *co, void *CANptr, uint16_t bitRate) {
                             bitRate);
 
     return err;
+#endif
 }
 
 
+#ifdef CO_SEPARATE_RT_CAN
+/******************************************************************************/
+CO_ReturnError_t CO_CANinitSeparate(CO_t *co,
+                                    void *CANptr,
+                                    void *CANptrRT,
+                                    uint16_t bitRate)
+{
+    CO_ReturnError_t err;
+
+    if (co == NULL) { return CO_ERROR_ILLEGAL_ARGUMENT; }
+
+    co->CANmodule->CANnormal = false;
+    co->CANmoduleRT->CANnormal = false;
+    CO_CANsetConfigurationMode(CANptr);
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+    co->CANbitRate = bitRate;
+#endif
+    if (CANptrRT != CANptr) {
+        CO_CANsetConfigurationMode(CANptrRT);
+    }
+
+    /* CANmodule, real-time objects use CAN buffers after RX_IDX_RT and
+     * TX_IDX_RT */
+    err = CO_CANmodule_init(co->CANmodule,
+                            CANptr,
+                            co->CANrx,
+                            CO_GET_CO(RX_IDX_RT),
+                            co->CANtx,
+                            CO_GET_CO(TX_IDX_RT),
+                            bitRate);
+    if (err) { return err; }
+
+    err = CO_CANmodule_init(co->CANmoduleRT,
+                            CANptrRT,
+                            &co->CANrx[CO_GET_CO(RX_IDX_RT)],
+                            CO_GET_CO(CNT_ALL_RX_MSGS) - CO_GET_CO(RX_IDX_RT),
+                            &co->CANtx[CO_GET_CO(TX_IDX_RT)],
+                            CO_GET_CO(CNT_ALL_TX_MSGS) - CO_GET_CO(TX_IDX_RT),
+                            bitRate);
+
+    return err;
+}
+#endif
+
+
 /******************************************************************************/
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
 CO_ReturnError_t CO_LSSinit(CO_t *co,
@@ -1038,6 +1449,10 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                          nodeId,
                          errInfo);
         if (err) { return err; }
+ #ifdef CO_SEPARATE_RT_CAN
+        /* errors of CAN module for real-time objects, also on own CAN bus */
+        CO_EM_initCANdevErr(co->em, co->CANmoduleRT);
+ #endif
     }
 
     /* NMT_Heartbeat */
@@ -1116,6 +1531,26 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                     errInfo);
             if (err) { return err; }
         }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+        err = CO_SDOserver_bufPool_init(&co->SDOserverBufPool,
+                                        co->SDOserverBufArena,
+                                        CO_CONFIG_SDO_SRV_BUFFER_POOL_COUNT);
+        if (err) { return err; }
+        for (int16_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+            CO_SDOserver_initBufPool(&co->SDOserver[i], &co->SDOserverBufPool);
+        }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+        CO_readyList_init(&co->SDOserverReadyList, co->SDOserverReadyRing,
+                          co->SDOserverReadyQueued, CO_GET_CNT(SDO_SRV));
+        memset(co->SDOserverActiveFlag, 0, CO_GET_CNT(SDO_SRV));
+        co->SDOserverActiveCount = 0;
+        co->SDOserverWasPreOrOperational = false;
+        for (uint16_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+            CO_SDOserver_initReadyList(&co->SDOserver[i],
+                                       &co->SDOserverReadyList, i);
+        }
+#endif
     }
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
@@ -1159,10 +1594,10 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                            OD_GET(H1006, OD_H1006_COMM_CYCL_PERIOD),
                            OD_GET(H1007, OD_H1007_SYNC_WINDOW_LEN),
                            OD_GET(H1019, OD_H1019_SYNC_CNT_OVERFLOW),
-                           co->CANmodule,
+                           CO_CANMODULE_RT,
                            CO_GET_CO(RX_IDX_SYNC),
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER
-                           co->CANmodule,
+                           CO_CANMODULE_RT,
                            CO_GET_CO(TX_IDX_SYNC),
 #endif
                            errInfo);
@@ -1174,10 +1609,10 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
     if (CO_GET_CNT(GFC) == 1) {
         err = CO_GFC_init(co->GFC,
                           &OD_globalFailSafeCommandParameter,
-                          co->CANmodule,
+                          CO_CANMODULE_RT,
                           CO_GET_CO(RX_IDX_GFC),
                           CO_CAN_ID_GFC,
-                          co->CANmodule,
+                          CO_CANMODULE_RT,
                           CO_GET_CO(TX_IDX_GFC),
                           CO_CAN_ID_GFC);
         if (err) { return err; }
@@ -1206,10 +1641,10 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                ((i == 0) ? CO_CAN_ID_SRDO_1 : 0),
                                SRDOcomm++,
                                SRDOmap++,
-                               co->CANmodule,
+                               CO_CANMODULE_RT,
                                CANdevRxIdx,
                                CANdevRxIdx + 1,
-                               co->CANmodule,
+                               CO_CANMODULE_RT,
                                CANdevTxIdx,
                                CANdevTxIdx + 1,
                                errInfo);
@@ -1251,37 +1686,51 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
  #endif
                            0);
         if (err) { return err; }
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+        err = CO_GTWA_initSubscribe(co->gtwa,
+                                    od,
+  #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+                                    CO_GET_CNT(HB_CONS) == 1 ? co->HBcons : NULL,
+  #endif
+                                    co->CANmodule,
+                                    CO_GET_CO(RX_IDX_GTWA));
+        if (err) { return err; }
+ #endif
     }
 #endif
 
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
-    if (CO_GET_CNT(TRACE) > 0) {
-        for (uint16_t i = 0; i < CO_GET_CNT(TRACE); i++) {
-            err = CO_trace_init(co->trace[i],
-                                co->SDO[0],
-                                OD_traceConfig[i].axisNo,
-                                CO_traceTimeBuffers[i],
-                                CO_traceValueBuffers[i],
-                                CO_traceBufferSize[i],
-                                &OD_traceConfig[i].map,
-                                &OD_traceConfig[i].format,
-                                &OD_traceConfig[i].trigger,
-                                &OD_traceConfig[i].threshold,
-                                &OD_trace[i].value,
-                                &OD_trace[i].min,
-                                &OD_trace[i].max,
-                                &OD_trace[i].triggerTime,
-                                OD_INDEX_TRACE_CONFIG + i,
-                                OD_INDEX_TRACE + i);
-            if (err) { return err; }
-        }
+    for (int16_t i = 0; i < CO_GET_CNT(TRACE); i++) {
+        err = CO_trace_init(&co->trace[i],
+                            od,
+                            OD_find(od, OD_INDEX_TRACE_CONFIG + i),
+                            OD_find(od, OD_INDEX_TRACE + i),
+                            errInfo);
+        if (err) { return err; }
     }
 #endif
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    err = CO_stats_init(co->stats, co->CANmodule, OD_find(od, OD_INDEX_STATS));
+    if (err) { return err; }
+ #if (CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD
+    CO_stats_setBitRate(co->stats, co->CANbitRate);
+ #endif
+#endif
+
     return CO_ERROR_NO;
 }
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+ /* index of the first TPDO in CO_t::PDOmapCache */
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+  #define CO_PDO_MAP_CACHE_TPDO CO_GET_CNT(RPDO)
+ #else
+  #define CO_PDO_MAP_CACHE_TPDO 0
+ #endif
+#endif
+
 /******************************************************************************/
 CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                    CO_EM_t *em,
@@ -1323,11 +1772,33 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                preDefinedCanId,
                                RPDOcomm++,
                                RPDOmap++,
-                               co->CANmodule,
+                               CO_CANMODULE_RT,
                                CO_GET_CO(RX_IDX_RPDO) + i,
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+                               &co->RPDOcold[i],
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                               co->PDOmapCache != NULL
+                                   ? &co->PDOmapCache[i] : NULL,
+ #endif
                                errInfo);
             if (err) { return err; }
+ #if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+            co->RPDO[i].overwriteCounter = &co->stats->block.rpdoOverwrite;
+ #endif
         }
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+        CO_timerQueue_init(&co->RPDOtimerQueue, co->RPDOtimerItems,
+                           CO_GET_CNT(RPDO));
+        co->RPDOwasOperational = false;
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+        CO_readyList_init(&co->RPDOreadyList, co->RPDOreadyRing,
+                          co->RPDOreadyQueued, CO_GET_CNT(RPDO));
+        for (uint16_t i = 0; i < CO_GET_CNT(RPDO); i++) {
+            CO_RPDO_initReadyList(&co->RPDO[i], &co->RPDOreadyList, i);
+        }
+ #endif
     }
 #endif
 
@@ -1357,11 +1828,31 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                preDefinedCanId,
                                TPDOcomm++,
                                TPDOmap++,
-                               co->CANmodule,
+                               CO_CANMODULE_RT,
                                CO_GET_CO(TX_IDX_TPDO) + i,
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT
+                               &co->TPDOcold[i],
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+                               co->PDOmapCache != NULL
+                                   ? &co->PDOmapCache[CO_PDO_MAP_CACHE_TPDO + i]
+                                   : NULL,
+ #endif
                                errInfo);
             if (err) { return err; }
         }
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+        CO_timerQueue_init(&co->TPDOtimerQueue, co->TPDOtimerItems,
+                           CO_GET_CNT(TPDO));
+        co->TPDOwasOperational = false;
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+        CO_TPDO_burstInit(&co->TPDOburst, CO_CANMODULE_RT, co->TPDOburstBuffers,
+                          co->TPDOburstCanIds, CO_GET_CNT(TPDO));
+        for (uint16_t i = 0; i < CO_GET_CNT(TPDO); i++) {
+            CO_TPDO_initBurst(&co->TPDO[i], &co->TPDOburst);
+        }
+ #endif
     }
 #endif
 
@@ -1369,6 +1860,171 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
 }
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE
+/******************************************************************************/
+CO_ReturnError_t CO_getPDOmapCache(CO_t *co, OD_t *od,
+                                   CO_PDO_mapCache_t *mapCache)
+{
+    CO_ReturnError_t err = CO_ERROR_NO;
+
+    if (co == NULL || mapCache == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    if (CO_GET_CNT(RPDO) > 0) {
+        OD_entry_t *RPDOmap = OD_GET(H1600, OD_H1600_RXPDO_1_MAPPING);
+        for (uint16_t i = 0; i < CO_GET_CNT(RPDO) && !err; i++) {
+            err = CO_PDO_getMapCache(od, RPDOmap++, &mapCache[i]);
+        }
+    }
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+    if (CO_GET_CNT(TPDO) > 0) {
+        OD_entry_t *TPDOmap = OD_GET(H1A00, OD_H1A00_TXPDO_1_MAPPING);
+        for (uint16_t i = 0; i < CO_GET_CNT(TPDO) && !err; i++) {
+            err = CO_PDO_getMapCache(od, TPDOmap++,
+                                     &mapCache[CO_PDO_MAP_CACHE_TPDO + i]);
+        }
+    }
+ #endif
+    return err;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_initCallbackPre(CO_t *co,
+                        void *object,
+                        void (*pFunctSignal)(void *object))
+{
+    (void) object; (void) pFunctSignal; /* may be unused */
+    if (co == NULL) {
+        return;
+    }
+
+#if (CO_CONFIG_NMT) & CO_CONFIG_FLAG_CALLBACK_PRE
+    if (CO_GET_CNT(NMT) == 1) {
+        CO_NMT_initCallbackPre(co->NMT, object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) \
+    && ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    if (CO_GET_CNT(HB_CONS) == 1) {
+        CO_HBconsumer_initCallbackPre(co->HBcons, object, pFunctSignal);
+    }
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
+    if (CO_GET_CNT(EM) == 1) {
+        CO_EM_initCallbackPre(co->em, object, pFunctSignal);
+    }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_CALLBACK_PRE
+    for (int16_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+        CO_SDOserver_initCallbackPre(&co->SDOserver[i], object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    for (int16_t i = 0; i < CO_GET_CNT(SDO_CLI); i++) {
+        CO_SDOclient_initCallbackPre(&co->SDOclient[i], object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) \
+    && ((CO_CONFIG_TIME) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    if (CO_GET_CNT(TIME) == 1) {
+        CO_TIME_initCallbackPre(co->TIME, object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE) \
+    && ((CO_CONFIG_SYNC) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    if (CO_GET_CNT(SYNC) == 1) {
+        CO_SYNC_initCallbackPre(co->SYNC, object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE) \
+    && ((CO_CONFIG_PDO) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    for (int16_t i = 0; i < CO_GET_CNT(RPDO); i++) {
+        CO_RPDO_initCallbackPre(&co->RPDO[i], object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE) \
+    && ((CO_CONFIG_SRDO) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    if (CO_GET_CNT(SRDO) > 0) {
+        for (int16_t i = 0; i < CO_GET_CNT(SRDO); i++) {
+            CO_SRDO_initCallbackPre(&co->SRDO[i], object, pFunctSignal);
+        }
+    }
+#endif
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE) \
+    && ((CO_CONFIG_LSS) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    if (CO_GET_CNT(LSS_SLV) == 1) {
+        CO_LSSslave_initCallbackPre(co->LSSslave, object, pFunctSignal);
+    }
+#endif
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER) \
+    && ((CO_CONFIG_LSS) & CO_CONFIG_FLAG_CALLBACK_PRE)
+    if (CO_GET_CNT(LSS_MST) == 1) {
+        CO_LSSmaster_initCallbackPre(co->LSSmaster, object, pFunctSignal);
+    }
+#endif
+}
+
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+/* Process SDO servers with received message and SDO servers in transfer, which
+ * need time for timeouts. All SDO servers are processed after communication
+ * reset and on change of NMT state, so each of them sees the NMT state. */
+static void CO_process_SDOserver(CO_t *co,
+                                 bool_t NMTisPreOrOperational,
+                                 uint32_t timeDifference_us,
+                                 uint32_t *timerNext_us)
+{
+    CO_readyList_t *rl = &co->SDOserverReadyList;
+    uint8_t *active = co->SDOserverActive;
+    uint8_t *activeFlag = co->SDOserverActiveFlag;
+    uint8_t count = co->SDOserverActiveCount;
+    uint8_t countNew = 0;
+    uint16_t i;
+
+    if (rl->checkAll
+        || NMTisPreOrOperational != co->SDOserverWasPreOrOperational
+    ) {
+        rl->checkAll = false;
+        co->SDOserverWasPreOrOperational = NMTisPreOrOperational;
+        for (i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+            if (activeFlag[i] == 0U) {
+                activeFlag[i] = 1;
+                active[count++] = (uint8_t)i;
+            }
+        }
+    }
+    while ((i = CO_readyList_pop(rl)) != CO_READY_LIST_EMPTY) {
+        if (activeFlag[i] == 0U) {
+            activeFlag[i] = 1;
+            active[count++] = (uint8_t)i;
+        }
+    }
+
+    /* SDO server stays in the list, until it becomes idle */
+    for (uint8_t j = 0; j < count; j++) {
+        CO_SDOserver_t *SDO = &co->SDOserver[active[j]];
+
+        CO_SDOserver_process(SDO,
+                             NMTisPreOrOperational,
+                             timeDifference_us,
+                             timerNext_us);
+        if (SDO->state != CO_SDO_ST_IDLE) {
+            active[countNew++] = active[j];
+        }
+        else {
+            activeFlag[active[j]] = 0;
+        }
+    }
+    co->SDOserverActiveCount = countNew;
+}
+#endif
+
+
 /******************************************************************************/
 CO_NMT_reset_cmd_t CO_process(CO_t *co,
                               bool_t enableGateway,
@@ -1380,9 +2036,19 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
     CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(co->NMT);
     bool_t NMTisPreOrOperational = (NMTstate == CO_NMT_PRE_OPERATIONAL
                                     || NMTstate == CO_NMT_OPERATIONAL);
+    CO_STATS_BEGIN();
 
     /* CAN module */
     CO_CANmodule_process(co->CANmodule);
+#ifdef CO_SEPARATE_RT_CAN
+    /* Error counters of the other CAN module, its messages are processed by
+     * CO_process_SYNC(), CO_process_RPDO(), CO_process_TPDO(), etc. Its
+     * CANerrorStatus is reported by emergency and CAN LEDs. */
+    CO_CANmodule_process(co->CANmoduleRT);
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_process(co->stats, timeDifference_us, timerNext_us);
+#endif
 
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
     if (CO_GET_CNT(LSS_SLV) == 1) {
@@ -1395,6 +2061,10 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
     bool_t unc = co->nodeIdUnconfigured;
     uint16_t CANerrorStatus = co->CANmodule->CANerrorStatus;
+ #ifdef CO_SEPARATE_RT_CAN
+    /* CAN module for real-time objects may be on other CAN interface */
+    CANerrorStatus |= co->CANmoduleRT->CANerrorStatus;
+ #endif
     bool_t LSSslave_configuration = false;
  #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
     if (CO_GET_CNT(LSS_SLV) == 1
@@ -1427,6 +2097,7 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
 
     /* CANopen Node ID is unconfigured (LSS slave), stop processing here */
     if (co->nodeIdUnconfigured) {
+        CO_STATS_END(co, CO_STATS_PROCESS);
         return reset;
     }
 
@@ -1449,12 +2120,19 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
                              || NMTstate == CO_NMT_OPERATIONAL);
 
     /* SDOserver */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST
+    if (CO_GET_CNT(SDO_SRV) > 0) {
+        CO_process_SDOserver(co, NMTisPreOrOperational,
+                             timeDifference_us, timerNext_us);
+    }
+#else
     for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
         CO_SDOserver_process(&co->SDOserver[i],
                              NMTisPreOrOperational,
                              timeDifference_us,
                              timerNext_us);
     }
+#endif
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     if (CO_GET_CNT(HB_CONS) == 1) {
@@ -1493,6 +2171,7 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
     }
 #endif
 
+    CO_STATS_END(co, CO_STATS_PROCESS);
     return reset;
 }
 
@@ -1504,6 +2183,7 @@ bool_t CO_process_SYNC(CO_t *co,
                        uint32_t *timerNext_us)
 {
     bool_t syncWas = false;
+    CO_STATS_BEGIN();
 
     if (!co->nodeIdUnconfigured && CO_GET_CNT(SYNC) == 1) {
         CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(co->NMT);
@@ -1521,8 +2201,12 @@ bool_t CO_process_SYNC(CO_t *co,
             case CO_SYNC_RX_TX:
                 syncWas = true;
                 break;
+            case CO_SYNC_RX_PROCESSED:
+                /* SYNC callback took over synchronous PDOs, see
+                 * CO_SYNC_initCallbackSync() */
+                break;
             case CO_SYNC_PASSED_WINDOW:
-                CO_CANclearPendingSyncPDOs(co->CANmodule);
+                CO_CANclearPendingSyncPDOs(CO_CANMODULE_RT);
                 break;
             default:
                 /* MISRA C 2004 15.3 */
@@ -1530,6 +2214,12 @@ bool_t CO_process_SYNC(CO_t *co,
         }
     }
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    if (syncWas) {
+        CO_stats_sync(co->stats);
+    }
+#endif
+    CO_STATS_END(co, CO_STATS_SYNC);
     return syncWas;
 }
 #endif
@@ -1537,6 +2227,41 @@ bool_t CO_process_SYNC(CO_t *co,
 
 /******************************************************************************/
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+/* Process single RPDO with time elapsed since its last processing and store
+ * its next deadline into the timer queue. */
+static void CO_RPDO_processScheduled(CO_t *co,
+                                     uint16_t i,
+                                     bool_t NMTisOperational,
+                                     bool_t syncWas)
+{
+    CO_RPDO_t *RPDO = &co->RPDO[i];
+    CO_PDO_common_t *PDO = &RPDO->PDO_common;
+    CO_timerQueue_t *tq = &co->RPDOtimerQueue;
+    uint32_t timerNext_us = CO_PDO_SCHED_NO_DEADLINE;
+
+    PDO->schedUpdate = false;
+    CO_RPDO_process(RPDO,
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
+                    tq->now_us - PDO->schedTime_us,
+                    &timerNext_us,
+ #endif
+                    NMTisOperational,
+                    syncWas);
+    PDO->schedTime_us = tq->now_us;
+
+    /* synchronous RPDOs are processed on each SYNC anyway, but their timeout
+     * deadline is kept, so timeout is detected also, if SYNC stops. Deadline
+     * is at least 1us ahead, so RPDO is not popped again in the same call. */
+    if (timerNext_us != CO_PDO_SCHED_NO_DEADLINE) {
+        CO_timerQueue_set(tq, i, timerNext_us > 0 ? timerNext_us : 1);
+    }
+    else {
+        CO_timerQueue_remove(tq, i);
+    }
+}
+#endif
+
 void CO_process_RPDO(CO_t *co,
                      bool_t syncWas,
                      uint32_t timeDifference_us,
@@ -1547,9 +2272,48 @@ void CO_process_RPDO(CO_t *co,
         return;
     }
 
+    CO_STATS_BEGIN();
     bool_t NMTisOperational =
         CO_NMT_getInternalState(co->NMT) == CO_NMT_OPERATIONAL;
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    CO_timerQueue_t *tq = &co->RPDOtimerQueue;
+    bool_t processAll = NMTisOperational != co->RPDOwasOperational;
+    uint16_t i;
+    bool_t checkAll = true;
+
+    co->RPDOwasOperational = NMTisOperational;
+    CO_timerQueue_advance(tq, timeDifference_us);
+
+    /* RPDOs with expired timeout */
+    while ((i = CO_timerQueue_popExpired(tq)) != CO_TIMERQ_NONE) {
+        CO_RPDO_processScheduled(co, i, NMTisOperational, syncWas);
+    }
+    /* RPDOs with pending events */
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST
+    CO_readyList_t *rl = &co->RPDOreadyList;
+
+    checkAll = processAll || syncWas || rl->checkAll;
+    rl->checkAll = false;
+    /* received RPDOs, list is only emptied, if all RPDOs are checked below */
+    while ((i = CO_readyList_pop(rl)) != CO_READY_LIST_EMPTY) {
+        if (!checkAll
+            && CO_RPDO_isPending(&co->RPDO[i], NMTisOperational, syncWas)
+        ) {
+            CO_RPDO_processScheduled(co, i, NMTisOperational, syncWas);
+        }
+    }
+ #endif
+    for (i = 0; checkAll && i < CO_GET_CNT(RPDO); i++) {
+        if (processAll
+            || CO_RPDO_isPending(&co->RPDO[i], NMTisOperational, syncWas)
+        ) {
+            CO_RPDO_processScheduled(co, i, NMTisOperational, syncWas);
+        }
+    }
+
+    CO_timerQueue_timerNext(tq, timerNext_us);
+#else
     for (int16_t i = 0; i < CO_GET_CNT(RPDO); i++) {
         CO_RPDO_process(&co->RPDO[i],
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
@@ -1559,12 +2323,50 @@ void CO_process_RPDO(CO_t *co,
                         NMTisOperational,
                         syncWas);
     }
+#endif
+
+    CO_STATS_END(co, CO_STATS_RPDO);
 }
 #endif
 
 
 /******************************************************************************/
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+/* Process single TPDO with time elapsed since its last processing and store
+ * its next deadline into the timer queue. */
+static void CO_TPDO_processScheduled(CO_t *co,
+                                     uint16_t i,
+                                     bool_t NMTisOperational,
+                                     bool_t syncWas)
+{
+    CO_TPDO_t *TPDO = &co->TPDO[i];
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
+    CO_timerQueue_t *tq = &co->TPDOtimerQueue;
+    uint32_t timerNext_us = CO_PDO_SCHED_NO_DEADLINE;
+
+    PDO->schedUpdate = false;
+    CO_TPDO_process(TPDO,
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
+                    tq->now_us - PDO->schedTime_us,
+                    &timerNext_us,
+ #endif
+                    NMTisOperational,
+                    syncWas);
+    PDO->schedTime_us = tq->now_us;
+
+    /* Deadline is at least 1us ahead, so TPDO is not popped again in the same
+     * call, for example sync acyclic TPDO with expired event timer, which
+     * waits for SYNC. */
+    if (timerNext_us != CO_PDO_SCHED_NO_DEADLINE) {
+        CO_timerQueue_set(tq, i, timerNext_us > 0 ? timerNext_us : 1);
+    }
+    else {
+        CO_timerQueue_remove(tq, i);
+    }
+}
+#endif
+
 void CO_process_TPDO(CO_t *co,
                      bool_t syncWas,
                      uint32_t timeDifference_us,
@@ -1575,9 +2377,33 @@ void CO_process_TPDO(CO_t *co,
         return;
     }
 
+    CO_STATS_BEGIN();
     bool_t NMTisOperational =
         CO_NMT_getInternalState(co->NMT) == CO_NMT_OPERATIONAL;
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER
+    CO_timerQueue_t *tq = &co->TPDOtimerQueue;
+    bool_t processAll = NMTisOperational != co->TPDOwasOperational;
+    uint16_t i;
+
+    co->TPDOwasOperational = NMTisOperational;
+    CO_timerQueue_advance(tq, timeDifference_us);
+
+    /* TPDOs with expired event or inhibit timer */
+    while ((i = CO_timerQueue_popExpired(tq)) != CO_TIMERQ_NONE) {
+        CO_TPDO_processScheduled(co, i, NMTisOperational, syncWas);
+    }
+    /* TPDOs with pending events */
+    for (i = 0; i < CO_GET_CNT(TPDO); i++) {
+        if (processAll
+            || CO_TPDO_isPending(&co->TPDO[i], NMTisOperational, syncWas)
+        ) {
+            CO_TPDO_processScheduled(co, i, NMTisOperational, syncWas);
+        }
+    }
+
+    CO_timerQueue_timerNext(tq, timerNext_us);
+#else
     for (int16_t i = 0; i < CO_GET_CNT(TPDO); i++) {
         CO_TPDO_process(&co->TPDO[i],
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
@@ -1587,6 +2413,17 @@ void CO_process_TPDO(CO_t *co,
                         NMTisOperational,
                         syncWas);
     }
+#endif
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST
+    /* all synchronous TPDOs due on this SYNC at once */
+    CO_TPDO_burstSend(&co->TPDOburst);
+#endif
+
+    CO_STATS_END(co, CO_STATS_TPDO);
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_TPDOdone(co->stats);
+#endif
 }
 #endif
 
@@ -1607,11 +2444,20 @@ void CO_process_SRDO(CO_t *co,
     uint8_t firstOperational = CO_SRDOGuard_process(co->SRDOGuard, 
                         NMTisOperational);
 
-    for (int16_t i = 0; i < CO_GET_CNT(SRDO); i++) {
-                        CO_SRDO_process(&co->SRDO[i],
-                        firstOperational,
-                        timeDifference_us,
-                        timerNext_us);
+    CO_SRDO_processBatch(co->SRDO, CO_GET_CNT(SRDO), firstOperational,
+                         timeDifference_us, timerNext_us);
+}
+#endif
+
+
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
+/******************************************************************************/
+void CO_process_TRACE(CO_t *co,
+                      bool_t syncWas,
+                      uint32_t timeDifference_us)
+{
+    for (int16_t i = 0; i < CO_GET_CNT(TRACE); i++) {
+        CO_trace_process(&co->trace[i], syncWas, timeDifference_us);
     }
 }
 #endif
@@ -36,8 +36,11 @@
 #include "301/CO_Emergency.h"
 #include "301/CO_SDOserver.h"
 #include "301/CO_SDOclient.h"
+#include "301/CO_SDOclientPool.h"
 #include "301/CO_SYNC.h"
 #include "301/CO_PDO.h"
+#include "301/CO_timerQueue.h"
+#include "301/CO_stats.h"
 #include "301/CO_TIME.h"
 #include "303/CO_LEDs.h"
 #include "304/CO_GFC.h"
@@ -96,6 +99,16 @@ extern "C" {
  * @}
  */
 
+/**
+ * @defgroup CO_CANopen_302 CANopen_302
+ * @{
+ *
+ * CANopen additional application layer functions (CiA 302)
+ *
+ * Part 3 of the standard specifies program download with objects 1F50 to 1F57.
+ * @}
+ */
+
 /**
  * @defgroup CO_CANopen_303 CANopen_303
  * @{
@@ -187,6 +200,78 @@ extern "C" {
 #define CO_USE_GLOBALS
 #endif
 
+/**
+ * If macro is defined externally, then all CANopen objects are placed inside
+ * single memory block (arena), provided by application to @ref CO_newArena().
+ * @ref CO_sizeof() returns exact size of the arena for the configuration.
+ * CO_alloc() and CO_free() are not used, @ref CO_new() is not available. This
+ * is possible only if CO_USE_GLOBALS is not defined.
+ *
+ * Objects, which are used on each SYNC and PDO (CO_t, SYNC, RPDO, TPDO,
+ * CANmodule with CAN buffers and statistics), are placed together at the
+ * start of the arena, other objects follow on the next
+ * @ref CO_ARENA_CACHE_LINE boundary.
+ */
+#ifdef CO_DOXYGEN
+#define CO_USE_ARENA
+#endif
+
+/**
+ * If macro is defined externally, then real-time objects (SYNC, GFC, SRDO,
+ * RPDO and TPDO) use own CAN module @ref CO_t::CANmoduleRT with own CAN
+ * receive and transmit buffers. Other objects (NMT, heartbeat, emergency,
+ * TIME, SDO, node guarding, LSS) use @ref CO_t::CANmodule.
+ *
+ * Both CAN modules are initialized by @ref CO_CANinit() with the same CANptr.
+ * Driver must support more than one CO_CANmodule_t on the same CAN interface,
+ * each with own transmit queue (for example own socket or own group of
+ * hardware transmit mailboxes). CO_LOCK_CAN_SEND() is called with the CAN
+ * module and should lock only that module. So long SDO block transfer or
+ * gateway burst in mainline thread does not delay TPDO in real-time thread.
+ *
+ * Alternatively @ref CO_CANinitSeparate() connects CAN modules to two
+ * different CAN interfaces, similar to CiA 302-6 multiple CAN networks. Process
+ * data then have own bus and SDO transfers do not consume its bandwidth.
+ * Other devices must use the same assignment of objects to the interfaces.
+ * Assignment is fixed per object class, objects can not be selected per bus
+ * and are not transmitted redundantly on both buses. Emergency, NMT and CAN
+ * LEDs report CAN errors (including bus-off) of both CAN modules.
+ *
+ * Threading model is then:
+ * - Real-time thread calls CO_process_SYNC(), CO_process_RPDO(),
+ *   CO_process_TPDO() and CO_process_SRDO(). It sends and receives only on
+ *   CO_t::CANmoduleRT, except CO_errorReport(), which is protected by
+ *   CO_LOCK_EMCY().
+ * - Mainline thread calls CO_process() and uses CO_t::CANmodule. For
+ *   CO_t::CANmoduleRT it only calls CO_CANmodule_process() and reads its
+ *   CANerrorStatus, so emergency, NMT and CAN LEDs report CAN errors of both
+ *   modules. Driver must protect CANerrorStatus in CO_CANmodule_process()
+ *   with CO_LOCK_CAN_SEND() against CO_CANsend() from real-time thread.
+ * - CO_LOCK_OD() is still common. SDO holds it only while single OD
+ *   read()/write() is executed, never while waiting for CAN messages.
+ *   Alternatively PDO mapped variables can be accessed with sequence lock,
+ *   see @ref CO_PDO_seqlock.
+ *
+ * Application must call CO_CANsetNormalMode() for both CAN modules.
+ */
+#ifdef CO_DOXYGEN
+#define CO_SEPARATE_RT_CAN
+#endif
+
+#if defined CO_USE_ARENA || defined CO_DOXYGEN
+/** Alignment of each object inside arena in bytes, power of 2. Arena passed to
+ * @ref CO_newArena() must be aligned to it. */
+#ifndef CO_ARENA_ALIGN
+#define CO_ARENA_ALIGN 8
+#endif
+/** Cache line size in bytes, power of 2. Objects, which are not in time
+ * critical path, start in the next cache line. For best results arena should
+ * be aligned to cache line. Use CO_ARENA_ALIGN for the most compact arena. */
+#ifndef CO_ARENA_CACHE_LINE
+#define CO_ARENA_CACHE_LINE 32
+#endif
+#endif
+
 
 #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
 /**
@@ -293,6 +378,17 @@ typedef struct {
     uint16_t CNT_ALL_RX_MSGS; /**< Number of all CAN receive message objects. */
     uint16_t CNT_ALL_TX_MSGS; /**< Number of all CAN transmit message objects.*/
  #endif
+#if defined CO_SEPARATE_RT_CAN || defined CO_DOXYGEN
+    /** CAN module for real-time objects, initialised by
+     * @ref CO_CANmodule_init(), see @ref CO_SEPARATE_RT_CAN. It uses CANrx and
+     * CANtx from RX_IDX_RT and TX_IDX_RT on. Indexes of real-time objects are
+     * relative to them. */
+    CO_CANmodule_t *CANmoduleRT;
+ #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
+    uint16_t RX_IDX_RT; /**< Start index of CANmoduleRT objects in CANrx. */
+    uint16_t TX_IDX_RT; /**< Start index of CANmoduleRT objects in CANtx. */
+ #endif
+#endif
     /** NMT and heartbeat object, initialised by @ref CO_NMT_init() */
     CO_NMT_t *NMT;
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
@@ -342,6 +438,31 @@ typedef struct {
     uint16_t RX_IDX_SDO_SRV; /**< Start index in CANrx. */
     uint16_t TX_IDX_SDO_SRV; /**< Start index in CANtx. */
  #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+    /** Pool of data buffers shared by SDO servers, initialised by
+     * @ref CO_SDOserver_bufPool_init() */
+    CO_SDOserver_bufPool_t SDOserverBufPool;
+    /** Memory for the buffer pool */
+    uint8_t *SDOserverBufArena;
+#endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_READY_LIST) || defined CO_DOXYGEN
+    /** SDO servers with received message, used by CO_process() */
+    CO_readyList_t SDOserverReadyList;
+    /** Ring for SDOserverReadyList, (number of SDO servers + 1) elements */
+    uint16_t *SDOserverReadyRing;
+    /** Flags for SDOserverReadyList, one for each SDO server */
+    uint8_t *SDOserverReadyQueued;
+    /** Indexes of SDO servers processed by CO_process() in each call, number
+     * of SDO servers elements */
+    uint8_t *SDOserverActive;
+    /** Set for each SDO server, which is inside SDOserverActive */
+    uint8_t *SDOserverActiveFlag;
+    /** Number of used elements in SDOserverActive */
+    uint8_t SDOserverActiveCount;
+    /** NMT pre-operational or operational state from previous CO_process()
+     * call */
+    bool_t SDOserverWasPreOrOperational;
+#endif
 #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) || defined CO_DOXYGEN
     /** SDO client objects, initialised by @ref CO_SDOclient_init() */
     CO_SDOclient_t *SDOclient;
@@ -372,6 +493,26 @@ typedef struct {
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t RX_IDX_RPDO; /**< Start index in CANrx. */
  #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT) || defined CO_DOXYGEN
+    /** Configuration and mapping of RPDOs, one for each RPDO */
+    CO_PDO_cold_t *RPDOcold;
+ #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER) || defined CO_DOXYGEN
+    /** Deadlines of RPDOs, used by CO_process_RPDO() */
+    CO_timerQueue_t RPDOtimerQueue;
+    /** Items for RPDOtimerQueue, one for each RPDO */
+    CO_timerQueue_item_t *RPDOtimerItems;
+    /** NMT operational state from previous CO_process_RPDO() call */
+    bool_t RPDOwasOperational;
+ #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_READY_LIST) || defined CO_DOXYGEN
+    /** RPDOs with received message, used by CO_process_RPDO() */
+    CO_readyList_t RPDOreadyList;
+    /** Ring for RPDOreadyList, (number of RPDOs + 1) elements */
+    uint16_t *RPDOreadyRing;
+    /** Flags for RPDOreadyList, one for each RPDO */
+    uint8_t *RPDOreadyQueued;
+ #endif
 #endif
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
     /** TPDO objects, initialised by @ref CO_TPDO_init() */
@@ -379,6 +520,32 @@ typedef struct {
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t TX_IDX_TPDO; /**< Start index in CANtx. */
  #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COLD_SPLIT) || defined CO_DOXYGEN
+    /** Configuration and mapping of TPDOs, one for each TPDO */
+    CO_PDO_cold_t *TPDOcold;
+ #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SCHEDULER) || defined CO_DOXYGEN
+    /** Deadlines of TPDOs, used by CO_process_TPDO() */
+    CO_timerQueue_t TPDOtimerQueue;
+    /** Items for TPDOtimerQueue, one for each TPDO */
+    CO_timerQueue_item_t *TPDOtimerItems;
+    /** NMT operational state from previous CO_process_TPDO() call */
+    bool_t TPDOwasOperational;
+ #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_BURST) || defined CO_DOXYGEN
+    /** Burst of synchronous TPDOs, sent at the end of CO_process_TPDO() */
+    CO_TPDO_burst_t TPDOburst;
+    /** Buffers for TPDOburst, one for each TPDO */
+    CO_CANtx_t **TPDOburstBuffers;
+    /** CAN identifiers for TPDOburst, one for each TPDO */
+    uint16_t *TPDOburstCanIds;
+ #endif
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE) || defined CO_DOXYGEN
+    /** Mapping of all RPDOs followed by all TPDOs, or NULL. If set by
+     * application, CO_CANopenInitPDO() takes PDO mapping parameters from it
+     * instead of reading them from OD. See CO_getPDOmapCache(). */
+    const CO_PDO_mapCache_t *PDOmapCache;
 #endif
 #if ((CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE) || defined CO_DOXYGEN
     /** LEDs object, initialised by @ref CO_LEDs_init() */
@@ -423,12 +590,21 @@ typedef struct {
     /** Gateway-ascii object, initialised by @ref CO_GTWA_init(). */
     CO_GTWA_t *gtwa;
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
+    uint16_t RX_IDX_GTWA; /**< Start index in CANrx. */
  #endif
 #endif
 #if ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE) || defined CO_DOXYGEN
-    /** Trace object, initialised by @ref CO_trace_init(). */
+    /** Trace objects, initialised by @ref CO_trace_init(). */
     CO_trace_t *trace;
 #endif
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) || defined CO_DOXYGEN
+    /** Processing time statistics, initialised by @ref CO_stats_init(). */
+    CO_stats_t *stats;
+ #if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_BUSLOAD) || defined CO_DOXYGEN
+    /** CAN bit rate from CO_CANinit(), for bus load statistics. */
+    uint16_t CANbitRate;
+ #endif
+#endif
 } CO_t;
 
 
@@ -437,6 +613,8 @@ typedef struct {
  *
  * If CO_USE_GLOBALS is defined, then function uses global static variables for
  * all the CANopenNode objects. Otherwise it allocates all objects from heap.
+ * If CO_USE_ARENA is defined, function is not available, use
+ * @ref CO_newArena() instead.
  *
  * @remark
  * With some microcontrollers it is necessary to specify Heap size within
@@ -451,11 +629,55 @@ typedef struct {
  *
  * @return Successfully allocated and configured CO_t object or NULL.
  */
+#if !defined CO_USE_ARENA || defined CO_DOXYGEN
 CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed);
+#endif
+
+
+#if defined CO_USE_ARENA || defined CO_DOXYGEN
+/**
+ * Calculate memory size, needed by @ref CO_newArena()
+ *
+ * Function is available if @ref CO_USE_ARENA is defined. Arena holds CO_t and
+ * all objects, which would be allocated by @ref CO_new(), including padding
+ * for @ref CO_ARENA_ALIGN and @ref CO_ARENA_CACHE_LINE. Size does not depend
+ * on arena address.
+ *
+ * @param config Configuration structure, same as in @ref CO_newArena().
+ *
+ * @return Size of arena in bytes or 0 if configuration is not valid.
+ */
+size_t CO_sizeof(CO_config_t *config);
+
+
+/**
+ * Create new CANopen object inside memory block provided by application
+ *
+ * Function is available if @ref CO_USE_ARENA is defined. Arena is cleared and
+ * all objects are placed inside it, there are no other memory allocations.
+ * Arena must stay in memory permanently, until @ref CO_delete(). Static arena
+ * may be sized by calling CO_sizeof() during development, or CO_sizeof() may
+ * be verified against arena size at startup.
+ *
+ * @param config Configuration structure, used if @ref CO_MULTIPLE_OD is
+ * defined. It must stay in memory permanently. If CO_MULTIPLE_OD is not
+ * defined, config should be NULL.
+ * @param arena Memory block, aligned to @ref CO_ARENA_ALIGN.
+ * @param arenaSize Size of arena in bytes.
+ * @param [out] arenaMemoryUsed Number of bytes used from the start of arena,
+ * equal to CO_sizeof(). Ignored if NULL.
+ *
+ * @return Configured CO_t object (at the start of arena) or NULL, if arena is
+ * too small or misaligned or configuration is not valid.
+ */
+CO_t *CO_newArena(CO_config_t *config, void *arena, size_t arenaSize,
+                  uint32_t *arenaMemoryUsed);
+#endif
 
 
 /**
  * Delete CANopen object and free memory. Must be called at program exit.
+ * If @ref CO_USE_ARENA is defined, arena may be reused after this function.
  *
  * @param co CANopen object.
  */
@@ -475,7 +697,8 @@ bool_t CO_isLSSslaveEnabled(CO_t *co);
 /**
  * Initialize CAN driver
  *
- * Function must be called in the communication reset section.
+ * Function must be called in the communication reset section. If
+ * @ref CO_SEPARATE_RT_CAN is defined, it initializes both CAN modules.
  *
  * @param co CANopen object.
  * @param CANptr Pointer to the user-defined CAN base structure, passed to
@@ -486,6 +709,29 @@ bool_t CO_isLSSslaveEnabled(CO_t *co);
 CO_ReturnError_t CO_CANinit(CO_t *co, void *CANptr, uint16_t bitRate);
 
 
+#if defined CO_SEPARATE_RT_CAN || defined CO_DOXYGEN
+/**
+ * Initialize CAN driver with separate CAN interface for real-time objects
+ *
+ * Function must be called in the communication reset section instead of
+ * CO_CANinit(), see @ref CO_SEPARATE_RT_CAN.
+ *
+ * @param co CANopen object.
+ * @param CANptr Pointer to the user-defined CAN base structure for
+ *               CO_t::CANmodule (NMT, heartbeat, emergency, SDO, ...).
+ * @param CANptrRT Pointer to the user-defined CAN base structure for
+ *                 CO_t::CANmoduleRT (SYNC, PDO, SRDO, GFC). May be the same as
+ *                 CANptr.
+ * @param bitRate CAN bit rate, the same for both interfaces.
+ * @return CO_ERROR_NO in case of success.
+ */
+CO_ReturnError_t CO_CANinitSeparate(CO_t *co,
+                                    void *CANptr,
+                                    void *CANptrRT,
+                                    uint16_t bitRate);
+#endif
+
+
 #if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE) || defined CO_DOXYGEN
 /**
  * Initialize CANopen LSS slave
@@ -577,6 +823,51 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                    uint32_t *errInfo);
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_MAP_CACHE) || defined CO_DOXYGEN
+/**
+ * Get mapping of all PDOs for CO_t::PDOmapCache.
+ *
+ * Function may be used after CO_CANopenInitPDO() to store PDO mapping
+ * parameters together with positions of the mapped OD entries, for example
+ * into boot snapshot, see CO_PDO_mapCache_t. On next startup with valid
+ * snapshot application sets CO_t::PDOmapCache before CO_CANopenInitPDO(), so
+ * mapping parameters are not read and mapped entries are not searched again.
+ *
+ * @param co CANopen object.
+ * @param od CANopen Object dictionary, same as in CO_CANopenInitPDO().
+ * @param [out] mapCache Array of (number of RPDOs + number of TPDOs) elements,
+ * RPDOs first.
+ *
+ * @return CO_ERROR_NO on success.
+ */
+CO_ReturnError_t CO_getPDOmapCache(CO_t *co, OD_t *od,
+                                   CO_PDO_mapCache_t *mapCache);
+#endif
+
+
+/**
+ * Configure callback for all CANopen objects, which have it.
+ *
+ * Function calls CO_***_initCallbackPre() of all objects, for which
+ * @ref CO_CONFIG_FLAG_CALLBACK_PRE is enabled: NMT, HB consumer, emergency,
+ * SDO servers and clients, TIME, SYNC, RPDOs, SRDOs and LSS. Callback is called
+ * after CAN message was preprocessed (may be from CAN receive interrupt) or
+ * when object has something to do, so it should wake up the thread, which
+ * calls CO_process() and other processing functions. See @ref CO_eventLoop
+ * for the reference implementation.
+ *
+ * Function must be called after CO_CANopenInit(), CO_CANopenInitPDO() and
+ * CO_LSSinit() in each communication reset.
+ *
+ * @param co CANopen object.
+ * @param object Pointer to object, which will be passed to pFunctSignal().
+ * @param pFunctSignal Pointer to the callback function. Can be NULL.
+ */
+void CO_initCallbackPre(CO_t *co,
+                        void *object,
+                        void (*pFunctSignal)(void *object));
+
+
 /**
  * Process CANopen objects.
  *
@@ -634,6 +925,9 @@ bool_t CO_process_SYNC(CO_t *co,
  * called from real time thread with constant interval (1ms typically). It
  * processes receive PDO CANopen objects.
  *
+ * If CO_CONFIG_PDO_SCHEDULER is enabled, only PDOs with expired deadlines or
+ * pending events are processed, see @ref CO_CONFIG_PDO.
+ *
  * @param co CANopen object.
  * @param syncWas True, if CANopen SYNC message was just received or
  * transmitted.
@@ -656,6 +950,9 @@ void CO_process_RPDO(CO_t *co,
  * called from real time thread with constant interval (1ms typically). It
  * processes transmit PDO CANopen objects.
  *
+ * If CO_CONFIG_PDO_SCHEDULER is enabled, only PDOs with expired deadlines or
+ * pending events are processed, see @ref CO_CONFIG_PDO.
+ *
  * @param co CANopen object.
  * @param syncWas True, if CANopen SYNC message was just received or
  * transmitted.
@@ -688,6 +985,26 @@ void CO_process_SRDO(CO_t *co,
                      uint32_t *timerNext_us);
 #endif
 
+
+#if ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE) || defined CO_DOXYGEN
+/**
+ * Process CANopen trace objects.
+ *
+ * Function must be called cyclically, usually from real time thread after
+ * CO_process_SYNC() and before CO_process_TPDO(), so values sent by PDOs on
+ * SYNC are recorded.
+ *
+ * @param co CANopen object.
+ * @param syncWas True, if CANopen SYNC message was just received or
+ * transmitted.
+ * @param timeDifference_us Time difference from previous function call in
+ * microseconds.
+ */
+void CO_process_TRACE(CO_t *co,
+                      bool_t syncWas,
+                      uint32_t timeDifference_us);
+#endif
+
 /** @} */ /* CO_CANopen */
 
 #ifdef __cplusplus
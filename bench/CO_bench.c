@@ -0,0 +1,1350 @@
+/*
+ * CANopenNode host benchmark with virtual CAN bus
+ *
+ * @file        CO_bench.c
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* benchmark defines own Object Dictionary for SDO transfers */
+#define OD_DEFINITION
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "CANopen.h"
+#include "OD.h"
+#include "CO_driver_loopback.h"
+#include "CO_sim.h"
+#include "301/crc16-ccitt.h"
+#include "302/CO_prgDownload.h"
+#include "309/CO_gateway_router.h"
+
+
+#define BENCH_NODES_MAX 127
+#define BENCH_BITRATE 1000  /* kbit/s */
+#define BENCH_STEP_US 1000  /* simulated time of one network step */
+#define BENCH_RPDO_TIMEOUT_MS 10 /* RPDO event timer in pdo scenario */
+
+#define BENCH_SDO_SIZE 16384
+#define BENCH_SDO_NODE_ID 5
+#define BENCH_LSS_NODES 64
+#define BENCH_PRG_SIZE 65536
+#define BENCH_PRG_STEP_US 100      /* simulated time of one prg step */
+#define BENCH_PRG_ERASE_US 20000   /* flash erase time */
+#define BENCH_PRG_US_PER_KB 10000  /* flash programming time, 100 kB/s */
+
+
+/* One CANopen device on the virtual bus */
+typedef struct {
+    CO_t *co;
+    CO_LSS_address_t lssAddress;
+    uint8_t pendingNodeId;
+    uint16_t pendingBitRate;
+    uint32_t heapMemoryUsed;
+    /* Own Object Dictionary instance, if odList is not NULL */
+    OD_t od;
+    OD_entry_t *odList;
+    OD_PERSIST_COMM_t *odPersistComm;
+    OD_RAM_t *odRam;
+    OD_instanceRegion_t odRegions[2];
+    OD_instance_t odInstance;
+} bench_node_t;
+
+/* Elapsed time of one measurement */
+typedef struct {
+    uint64_t ns;
+    uint64_t cycles;
+} bench_time_t;
+
+static CO_loopback_t bench_bus;
+static bench_node_t bench_nodes[BENCH_NODES_MAX];
+static uint16_t bench_nodeCount;
+
+/* command line options */
+static uint16_t opt_nodes = 64;
+static uint32_t opt_seconds = 10;
+
+/* default Object Dictionary values, restored before each scenario */
+static OD_PERSIST_COMM_t bench_odPersistComm;
+static OD_RAM_t bench_odRam;
+
+
+static uint64_t bench_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_start(bench_time_t *t) {
+    t->ns = bench_ns();
+    t->cycles = CO_benchCycles();
+}
+
+static void bench_stop(bench_time_t *t) {
+    t->ns = bench_ns() - t->ns;
+    t->cycles = CO_benchCycles() - t->cycles;
+}
+
+static void bench_report(const char *scenario, const char *metric,
+                         double value, const char *unit)
+{
+    printf("%-10s %-34s %14.1f %s\n", scenario, metric, value, unit);
+}
+
+static void bench_reportTime(const char *scenario, const char *operation,
+                             const bench_time_t *t, uint64_t count)
+{
+    char metric[64];
+
+    if (count == 0) {
+        count = 1;
+    }
+    snprintf(metric, sizeof(metric), "ns per %s", operation);
+    bench_report(scenario, metric, (double)t->ns / (double)count, "ns");
+    snprintf(metric, sizeof(metric), "cycles per %s", operation);
+    bench_report(scenario, metric, (double)t->cycles / (double)count, "cyc");
+}
+
+/* count, min and max of one stage of the node's CO_stats */
+static void bench_reportStage(const char *scenario, const char *name,
+                              CO_t *co, CO_stats_stageId_t id)
+{
+    const CO_stats_stage_t *stage = &co->stats->block.stage[id];
+    char metric[64];
+
+    if (stage->count == 0) {
+        return;
+    }
+    snprintf(metric, sizeof(metric), "node 1 %s min", name);
+    bench_report(scenario, metric, (double)stage->min, "cyc");
+    snprintf(metric, sizeof(metric), "node 1 %s max", name);
+    bench_report(scenario, metric, (double)stage->max, "cyc");
+}
+
+static void bench_reportBus(const char *scenario, uint64_t simulated_us) {
+    uint64_t busTime_us = CO_loopback_busTime_us(&bench_bus);
+
+    bench_report(scenario, "frames", (double)bench_bus.frames, "");
+    bench_report(scenario, "frames dropped", (double)bench_bus.framesDropped,
+                 "");
+    if (simulated_us > 0) {
+        bench_report(scenario, "bus load at 1 Mbit/s",
+                     100.0 * (double)busTime_us / (double)simulated_us, "%");
+    }
+}
+
+
+/* Reset the bus and Object Dictionary, delete all nodes */
+static void bench_reset(void) {
+    for (uint16_t i = 0; i < bench_nodeCount; i++) {
+        bench_node_t *node = &bench_nodes[i];
+        CO_delete(node->co);
+        free(node->odList);
+        free(node->odPersistComm);
+        free(node->odRam);
+        memset(node, 0, sizeof(*node));
+    }
+    bench_nodeCount = 0;
+    CO_loopback_init(&bench_bus);
+    OD_PERSIST_COMM = bench_odPersistComm;
+    OD_RAM = bench_odRam;
+}
+
+/* Create Object Dictionary instance for the next node, which shares constant
+ * OD objects with default OD. Variables are copied from default OD. */
+static OD_t *bench_newInstance(void) {
+    bench_node_t *node = &bench_nodes[bench_nodeCount];
+
+    node->odList = malloc((OD->size + 1U) * sizeof(OD_entry_t));
+    node->odPersistComm = malloc(sizeof(OD_PERSIST_COMM_t));
+    node->odRam = malloc(sizeof(OD_RAM_t));
+    if (node->odList == NULL || node->odPersistComm == NULL
+        || node->odRam == NULL
+    ) {
+        printf("Error: Can't allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    node->odRegions[0].orig = &OD_PERSIST_COMM;
+    node->odRegions[0].data = node->odPersistComm;
+    node->odRegions[0].size = sizeof(OD_PERSIST_COMM_t);
+    node->odRegions[1].orig = &OD_RAM;
+    node->odRegions[1].data = node->odRam;
+    node->odRegions[1].size = sizeof(OD_RAM_t);
+    node->odInstance.regions = node->odRegions;
+    node->odInstance.regionCount = 2;
+    if (OD_instance_init(&node->od, node->odList, OD, &node->odInstance)
+        != ODR_OK
+    ) {
+        printf("Error: OD instance initialization failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return &node->od;
+}
+
+/* Create and initialize CANopen device with nodeId, as in main_blank.c. Object
+ * Dictionary od is default OD shared by all nodes or instance from
+ * bench_newInstance(). It must be configured before the call. */
+static CO_t *bench_addNode(uint8_t nodeId, OD_t *od) {
+    bench_node_t *node = &bench_nodes[bench_nodeCount];
+    CO_ReturnError_t err;
+    uint32_t errInfo = 0;
+
+    node->co = CO_new(NULL, &node->heapMemoryUsed);
+    if (node->co == NULL) {
+        printf("Error: Can't allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    bench_nodeCount++;
+
+    CO_t *co = node->co;
+    co->CANmodule->CANnormal = false;
+    CO_CANsetConfigurationMode((void *)&bench_bus);
+    CO_CANmodule_disable(co->CANmodule);
+
+    err = CO_CANinit(co, (void *)&bench_bus, BENCH_BITRATE);
+    if (err != CO_ERROR_NO) {
+        printf("Error: CAN initialization failed: %d\n", err);
+        exit(EXIT_FAILURE);
+    }
+
+    node->lssAddress.identity.vendorID = 0x000001A0;
+    node->lssAddress.identity.productCode = 0x00000001;
+    node->lssAddress.identity.revisionNumber = 0x00040000;
+    node->lssAddress.identity.serialNumber = nodeId;
+    node->pendingNodeId = nodeId;
+    node->pendingBitRate = BENCH_BITRATE;
+    err = CO_LSSinit(co, &node->lssAddress,
+                     &node->pendingNodeId, &node->pendingBitRate);
+    if (err != CO_ERROR_NO) {
+        printf("Error: LSS slave initialization failed: %d\n", err);
+        exit(EXIT_FAILURE);
+    }
+
+    err = CO_CANopenInit(co, NULL, NULL, od, NULL,
+                         CO_NMT_STARTUP_TO_OPERATIONAL,
+                         0,     /* firstHBTime_ms */
+                         1000,  /* SDOserverTimeoutTime_ms */
+                         1000,  /* SDOclientTimeoutTime_ms */
+                         true,  /* SDOclientBlockTransfer */
+                         nodeId, &errInfo);
+    if (err == CO_ERROR_NO) {
+        err = CO_CANopenInitPDO(co, co->em, od, nodeId, &errInfo);
+    }
+    if (err != CO_ERROR_NO) {
+        printf("Error: node %u initialization failed: %d, 0x%X\n",
+               nodeId, err, errInfo);
+        exit(EXIT_FAILURE);
+    }
+
+    CO_CANsetNormalMode(co->CANmodule);
+#ifdef CO_SEPARATE_RT_CAN
+    CO_CANsetNormalMode(co->CANmoduleRT);
+#endif
+    return co;
+}
+
+/* Process mainline of one node */
+static void bench_process(CO_t *co, bool_t enableGateway, uint32_t dt_us) {
+    CO_NMT_reset_cmd_t reset = CO_process(co, enableGateway, dt_us, NULL);
+    if (reset != CO_RESET_NOT) {
+        printf("Error: unexpected reset command %d\n", reset);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Process real-time part of one node */
+static void bench_processRT(CO_t *co, uint32_t dt_us) {
+    bool_t syncWas = CO_process_SYNC(co, dt_us, NULL);
+    CO_process_RPDO(co, syncWas, dt_us, NULL);
+    CO_process_TPDO(co, syncWas, dt_us, NULL);
+}
+
+/* Process all nodes for one step and deliver messages */
+static void bench_step(uint32_t dt_us) {
+    for (uint16_t i = 0; i < bench_nodeCount; i++) {
+        bench_process(bench_nodes[i].co, false, dt_us);
+        bench_processRT(bench_nodes[i].co, dt_us);
+    }
+    CO_loopback_deliver(&bench_bus);
+}
+
+
+/*
+ * N nodes produce heartbeat each 10 ms, each node consumes heartbeats of the
+ * next 8 nodes.
+ */
+static void bench_heartbeat(void) {
+    const char *sc = "heartbeat";
+    uint16_t nodes = opt_nodes;
+    uint32_t steps = opt_seconds * (1000000U / BENCH_STEP_US);
+    uint16_t operational = 0;
+    bench_time_t tProcess = {0}, tDeliver = {0};
+
+    bench_reset();
+    OD_set_u16(OD_ENTRY_H1017_producerHeartbeatTime, 0, 10, true);
+    for (uint8_t k = 1; k <= nodes; k++) {
+        for (uint8_t j = 1; j <= OD_CNT_ARR_1016; j++) {
+            uint32_t hb = 0;
+            if (j < nodes) {
+                uint8_t monitored = (uint8_t)(((k - 1U + j) % nodes) + 1U);
+                hb = ((uint32_t)monitored << 16) | 50U;
+            }
+            OD_set_u32(OD_ENTRY_H1016_consumerHeartbeatTime, j, hb, true);
+        }
+        bench_addNode(k, OD);
+    }
+
+    /* boot-up and the first heartbeats */
+    for (uint32_t i = 0; i < 100; i++) {
+        bench_step(BENCH_STEP_US);
+    }
+    CO_loopback_resetCounters(&bench_bus);
+
+    for (uint32_t i = 0; i < steps; i++) {
+        bench_time_t t;
+
+        bench_start(&t);
+        for (uint16_t n = 0; n < bench_nodeCount; n++) {
+            bench_process(bench_nodes[n].co, false, BENCH_STEP_US);
+        }
+        bench_stop(&t);
+        tProcess.ns += t.ns;
+        tProcess.cycles += t.cycles;
+
+        bench_start(&t);
+        CO_loopback_deliver(&bench_bus);
+        bench_stop(&t);
+        tDeliver.ns += t.ns;
+        tDeliver.cycles += t.cycles;
+    }
+
+    for (uint16_t n = 0; n < bench_nodeCount; n++) {
+        if (bench_nodes[n].co->HBcons->allMonitoredOperational) {
+            operational++;
+        }
+    }
+
+    bench_report(sc, "nodes", nodes, "");
+    bench_report(sc, "simulated time", (double)steps * BENCH_STEP_US / 1000.0,
+                 "ms");
+    bench_reportTime(sc, "CO_process()", &tProcess,
+                     (uint64_t)steps * nodes);
+    bench_reportTime(sc, "delivered frame", &tDeliver, bench_bus.frames);
+    bench_reportBus(sc, (uint64_t)steps * BENCH_STEP_US);
+    bench_report(sc, "consumers all operational", operational, "nodes");
+    bench_reportStage(sc, "CO_process()", bench_nodes[0].co, CO_STATS_PROCESS);
+    bench_reportStage(sc, "CANrx_callback", bench_nodes[0].co, CO_STATS_CAN_RX);
+}
+
+
+/*
+ * 64 nodes (by default) with 4 synchronous TPDOs and 4 synchronous RPDOs each,
+ * 512 PDOs together. RPDOs of each node receive TPDOs of the next node. SYNC
+ * is sent by a separate CAN module, latency is measured from SYNC to the
+ * delivery of the last TPDO of the cycle. At the end SYNC stops and all RPDOs
+ * must report timeout.
+ */
+typedef struct {
+    uint32_t pdoFrames;
+} bench_pdoMonitor_t;
+
+static void bench_pdoMonitor(void *object, const CO_CANrxMsg_t *msg) {
+    bench_pdoMonitor_t *mon = object;
+    if (msg->ident >= 0x181U && msg->ident <= 0x4FFU) {
+        mon->pdoFrames++;
+    }
+}
+
+static void bench_pdo(void) {
+    const char *sc = "pdo";
+    uint16_t nodes = opt_nodes;
+    uint32_t cycles = opt_seconds * (1000000U / BENCH_STEP_US);
+    uint64_t latMin = UINT64_MAX, latMax = 0, latNsMin = UINT64_MAX;
+    uint64_t latNsMax = 0;
+    uint32_t incomplete = 0, rpdoOverwrite = 0;
+    uint16_t rpdoTimeout = 0, rpdoTimeoutEarly = 0;
+    bench_time_t tCycle = {0};
+    bench_pdoMonitor_t mon = {0};
+    CO_CANmodule_t tester;
+    CO_CANrx_t testerRx[1];
+    CO_CANtx_t testerTx[1];
+    CO_CANtx_t *syncTx;
+
+    bench_reset();
+    for (uint8_t k = 1; k <= nodes; k++) {
+        uint8_t next = (uint8_t)((k % nodes) + 1U);
+
+        for (uint16_t j = 0; j < 4; j++) {
+            OD_entry_t *tpdoComm = OD_find(OD, 0x1800 + j);
+            OD_entry_t *tpdoMap = OD_find(OD, 0x1A00 + j);
+            OD_entry_t *rpdoComm = OD_find(OD, 0x1400 + j);
+            OD_entry_t *rpdoMap = OD_find(OD, 0x1600 + j);
+            uint32_t cobTPDO = 0x180U + 0x100U * j;
+
+            OD_set_u32(tpdoComm, 1, cobTPDO + k, true);
+            if (j < 3) {
+                OD_set_u8(tpdoComm, 2, 1, true);
+            }
+            else {
+                /* synchronous acyclic TPDO, triggered by event timer */
+                OD_set_u8(tpdoComm, 2, 0, true);
+                OD_set_u16(tpdoComm, 5, 1, true);
+            }
+            OD_set_u32(tpdoMap, 1, 0x10010008, true);
+            OD_set_u32(tpdoMap, 2, 0x00070020, true);
+            OD_set_u32(tpdoMap, 3, 0x00060010, true);
+            OD_set_u32(tpdoMap, 4, 0x00050008, true);
+            OD_set_u8(tpdoMap, 0, 4, true);
+
+            OD_set_u32(rpdoComm, 1, cobTPDO + next, true);
+            OD_set_u8(rpdoComm, 2, 1, true);
+            OD_set_u16(rpdoComm, 5, BENCH_RPDO_TIMEOUT_MS, true);
+            OD_set_u32(rpdoMap, 1, 0x00050008, true);
+            OD_set_u32(rpdoMap, 2, 0x00070020, true);
+            OD_set_u32(rpdoMap, 3, 0x00060010, true);
+            OD_set_u32(rpdoMap, 4, 0x00050008, true);
+            OD_set_u8(rpdoMap, 0, 4, true);
+        }
+        bench_addNode(k, OD);
+    }
+
+    CO_CANmodule_init(&tester, &bench_bus, testerRx, 1, testerTx, 1,
+                      BENCH_BITRATE);
+    syncTx = CO_CANtxBufferInit(&tester, 0, CO_CAN_ID_SYNC, false, 0, false);
+    CO_CANsetNormalMode(&tester);
+    bench_bus.monitor = bench_pdoMonitor;
+    bench_bus.monitorObject = &mon;
+
+    /* boot-up, NMT operational */
+    for (uint32_t i = 0; i < 10; i++) {
+        bench_step(BENCH_STEP_US);
+    }
+    CO_loopback_resetCounters(&bench_bus);
+    for (uint16_t n = 0; n < bench_nodeCount; n++) {
+        CO_stats_reset(bench_nodes[n].co->stats);
+    }
+
+    for (uint32_t i = 0; i < cycles; i++) {
+        bench_time_t t;
+        uint32_t pdoFrames = mon.pdoFrames;
+
+        for (uint16_t n = 0; n < bench_nodeCount; n++) {
+            bench_process(bench_nodes[n].co, false, BENCH_STEP_US);
+        }
+        CO_loopback_deliver(&bench_bus);
+
+        bench_start(&t);
+        CO_CANsend(&tester, syncTx);
+        CO_loopback_deliver(&bench_bus);
+        for (uint16_t n = 0; n < bench_nodeCount; n++) {
+            bench_processRT(bench_nodes[n].co, BENCH_STEP_US);
+        }
+        CO_loopback_deliver(&bench_bus);
+        bench_stop(&t);
+
+        if ((mon.pdoFrames - pdoFrames) != 4U * nodes) {
+            incomplete++;
+        }
+        tCycle.ns += t.ns;
+        tCycle.cycles += t.cycles;
+        if (t.cycles < latMin) { latMin = t.cycles; }
+        if (t.cycles > latMax) { latMax = t.cycles; }
+        if (t.ns < latNsMin) { latNsMin = t.ns; }
+        if (t.ns > latNsMax) { latNsMax = t.ns; }
+    }
+    bench_bus.monitor = NULL;
+
+    for (uint16_t n = 0; n < bench_nodeCount; n++) {
+        rpdoOverwrite += bench_nodes[n].co->stats->block.rpdoOverwrite;
+        if (CO_isError(bench_nodes[n].co->em, CO_EM_RPDO_TIME_OUT)) {
+            rpdoTimeoutEarly++;
+        }
+    }
+
+    /* SYNC stops */
+    for (uint32_t i = 0; i < 2U * BENCH_RPDO_TIMEOUT_MS; i++) {
+        bench_step(BENCH_STEP_US);
+    }
+    for (uint16_t n = 0; n < bench_nodeCount; n++) {
+        if (CO_isError(bench_nodes[n].co->em, CO_EM_RPDO_TIME_OUT)) {
+            rpdoTimeout++;
+        }
+    }
+
+    bench_report(sc, "nodes", nodes, "");
+    bench_report(sc, "PDOs (TPDO + RPDO)", 8.0 * nodes, "");
+    bench_report(sc, "SYNC cycles", cycles, "");
+    bench_report(sc, "TPDO frames", mon.pdoFrames, "");
+    bench_report(sc, "incomplete cycles", incomplete, "");
+    bench_report(sc, "RPDO overwritten", rpdoOverwrite, "");
+    bench_report(sc, "RPDO timeout with SYNC", rpdoTimeoutEarly, "nodes");
+    bench_report(sc, "RPDO timeout after SYNC stops", rpdoTimeout, "nodes");
+    bench_reportTime(sc, "SYNC cycle", &tCycle, cycles);
+    bench_reportTime(sc, "PDO", &tCycle, (uint64_t)cycles * 8U * nodes);
+    bench_report(sc, "SYNC -> last TPDO min", (double)latNsMin, "ns");
+    bench_report(sc, "SYNC -> last TPDO avg",
+                 (double)tCycle.ns / (double)cycles, "ns");
+    bench_report(sc, "SYNC -> last TPDO max", (double)latNsMax, "ns");
+    bench_report(sc, "SYNC -> last TPDO min cycles", (double)latMin, "cyc");
+    bench_report(sc, "SYNC -> last TPDO max cycles", (double)latMax, "cyc");
+    /* 512 PDOs do not fit into 1 ms at 1 Mbit/s, so report bus time only */
+    bench_reportBus(sc, 0);
+    bench_report(sc, "bus time per SYNC cycle",
+                 (double)CO_loopback_busTime_us(&bench_bus) / (double)cycles,
+                 "us");
+    bench_reportStage(sc, "SYNC -> TPDO", bench_nodes[0].co,
+                      CO_STATS_SYNC_TPDO);
+    bench_reportStage(sc, "CO_process_RPDO()", bench_nodes[0].co,
+                      CO_STATS_RPDO);
+    bench_reportStage(sc, "CO_process_TPDO()", bench_nodes[0].co,
+                      CO_STATS_TPDO);
+}
+
+
+/*
+ * SDO client reads and writes 16 KiB octet string of SDO server, segmented
+ * and block transfer. Both use their own Object Dictionary with the octet
+ * string at index 0x2000 and SDO client parameter at index 0x1280.
+ */
+static uint8_t bench_sdoDomain[BENCH_SDO_SIZE];
+static uint8_t bench_sdoData[BENCH_SDO_SIZE];
+
+static struct {
+    uint8_t maxSubIndex;
+    uint32_t COB_IDClientToServer;
+    uint32_t COB_IDServerToClient;
+    uint8_t nodeIdOfServer;
+} bench_sdo1280 = {3, 0x80000000, 0x80000000, BENCH_SDO_NODE_ID};
+
+static OD_obj_record_t bench_sdo1280Obj[4] = {
+    {&bench_sdo1280.maxSubIndex, 0, ODA_SDO_R, 1},
+    {&bench_sdo1280.COB_IDClientToServer, 1, ODA_SDO_RW | ODA_MB, 4},
+    {&bench_sdo1280.COB_IDServerToClient, 2, ODA_SDO_RW | ODA_MB, 4},
+    {&bench_sdo1280.nodeIdOfServer, 3, ODA_SDO_RW, 1}
+};
+
+/* byte array is copied as-is also with C2000_PORT, see OD_writeOriginal() */
+static OD_obj_var_t bench_sdoDomainObj = {
+    bench_sdoDomain, ODA_SDO_RW | ODA_STR, BENCH_SDO_SIZE
+};
+
+static OD_entry_t bench_sdoList[] = {
+    {0x1280, 4, ODT_REC, &bench_sdo1280Obj, NULL},
+    {0x2000, 1, ODT_VAR, &bench_sdoDomainObj, NULL},
+    {0x0000, 0, 0, NULL, NULL}
+};
+
+static OD_t bench_sdoOD = {
+    .size = (sizeof(bench_sdoList) / sizeof(bench_sdoList[0])) - 1,
+    .list = bench_sdoList
+};
+
+typedef struct {
+    CO_SDOserver_t server;
+    CO_SDOclient_t client;
+    CO_CANmodule_t serverCAN;
+    CO_CANmodule_t clientCAN;
+    CO_CANrx_t serverRx[1];
+    CO_CANtx_t serverTx[1];
+    CO_CANrx_t clientRx[1];
+    CO_CANtx_t clientTx[1];
+} bench_sdoPair_t;
+
+static void bench_sdoServerStep(bench_sdoPair_t *p) {
+    CO_loopback_deliver(&bench_bus);
+    CO_SDOserver_process(&p->server, true, 100, NULL);
+    CO_loopback_deliver(&bench_bus);
+}
+
+static CO_SDO_return_t bench_sdoDownload(bench_sdoPair_t *p, bool_t block) {
+    CO_SDO_return_t ret;
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    size_t written = 0, sizeTransferred = 0;
+
+    ret = CO_SDOclientDownloadInitiate(&p->client, 0x2000, 0, BENCH_SDO_SIZE,
+                                       1000, block);
+    if (ret != CO_SDO_RT_ok_communicationEnd) {
+        return ret;
+    }
+    do {
+        if (written < BENCH_SDO_SIZE) {
+            written += CO_SDOclientDownloadBufWrite(&p->client,
+                                                    &bench_sdoData[written],
+                                                    BENCH_SDO_SIZE - written);
+        }
+        ret = CO_SDOclientDownload(&p->client, 100, false,
+                                   written < BENCH_SDO_SIZE, &abortCode,
+                                   &sizeTransferred, NULL);
+        bench_sdoServerStep(p);
+    } while (ret > 0);
+    CO_SDOclientClose(&p->client);
+
+    return (ret == CO_SDO_RT_ok_communicationEnd
+            && sizeTransferred == BENCH_SDO_SIZE) ? ret : CO_SDO_RT_endedWithClientAbort;
+}
+
+static CO_SDO_return_t bench_sdoUpload(bench_sdoPair_t *p, bool_t block,
+                                       uint8_t *dest)
+{
+    CO_SDO_return_t ret;
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    size_t read = 0, sizeIndicated = 0, sizeTransferred = 0;
+
+    ret = CO_SDOclientUploadInitiate(&p->client, 0x2000, 0, 1000, block);
+    if (ret != CO_SDO_RT_ok_communicationEnd) {
+        return ret;
+    }
+    do {
+        ret = CO_SDOclientUpload(&p->client, 100, false, &abortCode,
+                                 &sizeIndicated, &sizeTransferred, NULL);
+        read += CO_SDOclientUploadBufRead(&p->client, &dest[read],
+                                          BENCH_SDO_SIZE - read);
+        bench_sdoServerStep(p);
+    } while (ret > 0);
+    read += CO_SDOclientUploadBufRead(&p->client, &dest[read],
+                                      BENCH_SDO_SIZE - read);
+    CO_SDOclientClose(&p->client);
+
+    return (ret == CO_SDO_RT_ok_communicationEnd && read == BENCH_SDO_SIZE)
+           ? ret : CO_SDO_RT_endedWithClientAbort;
+}
+
+static void bench_sdo(void) {
+    static bench_sdoPair_t p;
+    static uint8_t uploaded[BENCH_SDO_SIZE];
+    const uint32_t repeat = 16;
+    uint32_t errInfo = 0;
+
+    bench_reset();
+    memset(&p, 0, sizeof(p));
+    for (size_t i = 0; i < BENCH_SDO_SIZE; i++) {
+        /* no zero bytes, octet string would be shorter */
+        bench_sdoData[i] = (uint8_t)(1U + ((i * 7U + (i >> 8)) % 255U));
+    }
+
+    CO_CANmodule_init(&p.serverCAN, &bench_bus, p.serverRx, 1, p.serverTx, 1,
+                      BENCH_BITRATE);
+    CO_CANmodule_init(&p.clientCAN, &bench_bus, p.clientRx, 1, p.clientTx, 1,
+                      BENCH_BITRATE);
+    if (CO_SDOserver_init(&p.server, &bench_sdoOD, NULL, BENCH_SDO_NODE_ID,
+                          1000, &p.serverCAN, 0, &p.serverCAN, 0, &errInfo)
+            != CO_ERROR_NO
+        || CO_SDOclient_init(&p.client, &bench_sdoOD,
+                             OD_find(&bench_sdoOD, 0x1280), 1,
+                             &p.clientCAN, 0, &p.clientCAN, 0, &errInfo)
+            != CO_ERROR_NO
+    ) {
+        printf("Error: SDO initialization failed, 0x%X\n", errInfo);
+        exit(EXIT_FAILURE);
+    }
+    CO_SDOclient_setup(&p.client,
+                       CO_CAN_ID_SDO_CLI + BENCH_SDO_NODE_ID,
+                       CO_CAN_ID_SDO_SRV + BENCH_SDO_NODE_ID,
+                       BENCH_SDO_NODE_ID);
+    CO_CANsetNormalMode(&p.serverCAN);
+    CO_CANsetNormalMode(&p.clientCAN);
+
+    for (int m = 0; m < 4; m++) {
+        bool_t block = (m & 1) != 0;
+        bool_t upload = (m & 2) != 0;
+        const char *sc = block ? (upload ? "sdo-blk-up" : "sdo-blk-dn")
+                               : (upload ? "sdo-seg-up" : "sdo-seg-dn");
+        uint32_t failed = 0;
+        bench_time_t t;
+
+        CO_loopback_resetCounters(&bench_bus);
+        bench_start(&t);
+        for (uint32_t r = 0; r < repeat; r++) {
+            CO_SDO_return_t ret;
+            if (upload) {
+                memset(uploaded, 0, sizeof(uploaded));
+                ret = bench_sdoUpload(&p, block, uploaded);
+                if (memcmp(uploaded, bench_sdoData, BENCH_SDO_SIZE) != 0) {
+                    ret = CO_SDO_RT_endedWithClientAbort;
+                }
+            }
+            else {
+                memset(bench_sdoDomain, 0, sizeof(bench_sdoDomain));
+                ret = bench_sdoDownload(&p, block);
+                if (memcmp(bench_sdoDomain, bench_sdoData, BENCH_SDO_SIZE)
+                    != 0) {
+                    ret = CO_SDO_RT_endedWithClientAbort;
+                }
+            }
+            if (ret != CO_SDO_RT_ok_communicationEnd) {
+                failed++;
+            }
+        }
+        bench_stop(&t);
+
+        uint64_t bytes = (uint64_t)repeat * BENCH_SDO_SIZE;
+        uint64_t busTime_us = CO_loopback_busTime_us(&bench_bus);
+        bench_report(sc, "bytes", (double)bytes, "B");
+        bench_report(sc, "failed transfers", failed, "");
+        bench_report(sc, "host throughput",
+                     (double)bytes * 1000.0 / (double)t.ns, "MB/s");
+        bench_reportTime(sc, "byte", &t, bytes);
+        bench_report(sc, "frames", bench_bus.frames, "");
+        bench_report(sc, "bus throughput at 1 Mbit/s",
+                     (double)bytes * 1000.0 / (double)busTime_us, "kB/s");
+    }
+}
+
+
+/*
+ * SDO client downloads 64 KiB program with block transfer into 0x1F50 of
+ * SDO server with CO_prgDownload. Simulated flash erases in 20 ms and
+ * programs at 100 kB/s, about the same as the block transfer on 1 Mbit/s
+ * bus. Client and server are processed each 100 us of simulated time. At the
+ * end program is downloaded once more with segmented transfer.
+ */
+static struct {
+    uint8_t image[BENCH_PRG_SIZE];
+    size_t size;
+    uint32_t busy_us;      /* remaining time of the current operation */
+    uint64_t busyTotal_us;
+    bool_t valid;
+} bench_flash;
+
+bool_t CO_prgFlash_begin(void *flashModule) {
+    (void)flashModule;
+    memset(bench_flash.image, 0xFF, sizeof(bench_flash.image));
+    bench_flash.valid = false;
+    bench_flash.busy_us = BENCH_PRG_ERASE_US;
+    bench_flash.busyTotal_us += BENCH_PRG_ERASE_US;
+    return true;
+}
+
+bool_t CO_prgFlash_program(void *flashModule, size_t flashAddr,
+                           const uint8_t *data, size_t len)
+{
+    (void)flashModule;
+    if (bench_flash.busy_us > 0 || flashAddr + len > BENCH_PRG_SIZE) {
+        return false;
+    }
+    memcpy(&bench_flash.image[flashAddr], data, len);
+    bench_flash.busy_us = (uint32_t)(len * BENCH_PRG_US_PER_KB / 1024U);
+    bench_flash.busyTotal_us += bench_flash.busy_us;
+    return true;
+}
+
+CO_prgFlash_status_t CO_prgFlash_status(void *flashModule) {
+    (void)flashModule;
+    return bench_flash.busy_us > 0 ? CO_PRG_FLASH_BUSY : CO_PRG_FLASH_READY;
+}
+
+bool_t CO_prgFlash_end(void *flashModule, size_t size, uint16_t crc) {
+    (void)flashModule;
+    bench_flash.size = size;
+    bench_flash.valid = size == BENCH_PRG_SIZE
+                        && crc == crc16_ccitt(bench_flash.image, size, 0);
+    return bench_flash.valid;
+}
+
+static uint8_t bench_prgSub0 = 1;
+static uint32_t bench_prgStatus;
+
+static OD_obj_array_t bench_prg1F50Obj = {
+    &bench_prgSub0, NULL, ODA_SDO_R, ODA_SDO_W, 0, 0
+};
+
+static OD_obj_array_t bench_prg1F57Obj = {
+    &bench_prgSub0, &bench_prgStatus, ODA_SDO_R, ODA_SDO_R | ODA_MB, 4, 4
+};
+
+static OD_entry_t bench_prgList[] = {
+    {0x1280, 4, ODT_REC, &bench_sdo1280Obj, NULL},
+    {0x1F50, 2, ODT_ARR, &bench_prg1F50Obj, NULL},
+    {0x1F57, 2, ODT_ARR, &bench_prg1F57Obj, NULL},
+    {0x0000, 0, 0, NULL, NULL}
+};
+
+static OD_t bench_prgOD = {
+    .size = (sizeof(bench_prgList) / sizeof(bench_prgList[0])) - 1,
+    .list = bench_prgList
+};
+
+/* Download one program, return true on success */
+static bool_t bench_prgDownload(bench_sdoPair_t *p, CO_prgDownload_t *prg,
+                                bool_t blockEnable, uint64_t *simulated_us)
+{
+    CO_SDO_return_t ret;
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    size_t written = 0, sizeTransferred = 0;
+
+    ret = CO_SDOclientDownloadInitiate(&p->client, 0x1F50, 1,
+                                       BENCH_PRG_SIZE, 1000, blockEnable);
+    while (ret == CO_SDO_RT_ok_communicationEnd || ret > 0) {
+        if (written < BENCH_PRG_SIZE) {
+            /* program is the 16 KiB pattern repeated */
+            size_t offset = written % BENCH_SDO_SIZE;
+            written += CO_SDOclientDownloadBufWrite(&p->client,
+                                           &bench_sdoData[offset],
+                                           BENCH_SDO_SIZE - offset);
+        }
+        ret = CO_SDOclientDownload(&p->client, BENCH_PRG_STEP_US, false,
+                                   written < BENCH_PRG_SIZE, &abortCode,
+                                   &sizeTransferred, NULL);
+        CO_loopback_deliver(&bench_bus);
+        CO_SDOserver_process(&p->server, true, BENCH_PRG_STEP_US, NULL);
+        CO_loopback_deliver(&bench_bus);
+
+        bench_flash.busy_us = bench_flash.busy_us > BENCH_PRG_STEP_US
+                            ? bench_flash.busy_us - BENCH_PRG_STEP_US : 0;
+        *simulated_us += BENCH_PRG_STEP_US;
+        if (ret == CO_SDO_RT_ok_communicationEnd) {
+            break;
+        }
+    }
+    CO_SDOclientClose(&p->client);
+    return ret == CO_SDO_RT_ok_communicationEnd && bench_flash.valid
+           && bench_flash.size == BENCH_PRG_SIZE && prg->status == 0;
+}
+
+static void bench_prg(void) {
+    const char *sc = "prg";
+    static bench_sdoPair_t p;
+    static CO_prgDownload_t prg;
+    const uint32_t repeat = 4;
+    uint32_t errInfo = 0, failed = 0;
+    uint64_t simulated_us = 0, segmented_us = 0;
+    bench_time_t t;
+
+    bench_reset();
+    memset(&p, 0, sizeof(p));
+    memset(&bench_flash, 0, sizeof(bench_flash));
+    for (size_t i = 0; i < BENCH_SDO_SIZE; i++) {
+        bench_sdoData[i] = (uint8_t)(i * 7U + (i >> 8));
+    }
+
+    CO_CANmodule_init(&p.serverCAN, &bench_bus, p.serverRx, 1, p.serverTx, 1,
+                      BENCH_BITRATE);
+    CO_CANmodule_init(&p.clientCAN, &bench_bus, p.clientRx, 1, p.clientTx, 1,
+                      BENCH_BITRATE);
+    if (CO_SDOserver_init(&p.server, &bench_prgOD, NULL, BENCH_SDO_NODE_ID,
+                          1000, &p.serverCAN, 0, &p.serverCAN, 0, &errInfo)
+            != CO_ERROR_NO
+        || CO_SDOclient_init(&p.client, &bench_prgOD,
+                             OD_find(&bench_prgOD, 0x1280), 1,
+                             &p.clientCAN, 0, &p.clientCAN, 0, &errInfo)
+            != CO_ERROR_NO
+        || CO_prgDownload_init(&prg, NULL, OD_find(&bench_prgOD, 0x1F50),
+                               OD_find(&bench_prgOD, 0x1F57), &errInfo)
+            != CO_ERROR_NO
+    ) {
+        printf("Error: program download initialization failed, 0x%X\n",
+               errInfo);
+        exit(EXIT_FAILURE);
+    }
+    CO_SDOclient_setup(&p.client,
+                       CO_CAN_ID_SDO_CLI + BENCH_SDO_NODE_ID,
+                       CO_CAN_ID_SDO_SRV + BENCH_SDO_NODE_ID,
+                       BENCH_SDO_NODE_ID);
+    CO_CANsetNormalMode(&p.serverCAN);
+    CO_CANsetNormalMode(&p.clientCAN);
+
+    CO_loopback_resetCounters(&bench_bus);
+    bench_start(&t);
+    for (uint32_t r = 0; r < repeat; r++) {
+        if (!bench_prgDownload(&p, &prg, true, &simulated_us)) {
+            failed++;
+        }
+    }
+    bench_stop(&t);
+    uint64_t busTime_us = CO_loopback_busTime_us(&bench_bus);
+    uint64_t flashBusy_us = bench_flash.busyTotal_us;
+
+    /* segmented transfer, SDO server buffer is full before flash is erased */
+    if (!bench_prgDownload(&p, &prg, false, &segmented_us)) {
+        failed++;
+    }
+
+    uint64_t bytes = (uint64_t)repeat * BENCH_PRG_SIZE;
+    bench_report(sc, "bytes", (double)bytes, "B");
+    bench_report(sc, "failed transfers", failed, "");
+    bench_report(sc, "simulated time", (double)simulated_us / 1000.0, "ms");
+    bench_report(sc, "bus time", (double)busTime_us / 1000.0, "ms");
+    bench_report(sc, "flash busy time",
+                 (double)flashBusy_us / 1000.0, "ms");
+    bench_report(sc, "simulated throughput",
+                 (double)bytes * 1000.0 / (double)simulated_us, "kB/s");
+    bench_report(sc, "host throughput",
+                 (double)bytes * 1000.0 / (double)t.ns, "MB/s");
+    bench_report(sc, "segmented simulated throughput",
+                 (double)BENCH_PRG_SIZE * 1000.0 / (double)segmented_us,
+                 "kB/s");
+}
+
+
+/*
+ * Gateway-ascii on node 2 executes commands: SDO read from node 1, SDO read
+ * from own Object Dictionary and NMT command. Then the same Gateway-ascii is
+ * attached to the gateway router as network 1 and commands are routed: with
+ * explicit <net> and with <node> only, which must not be taken as <net>. Next
+ * command is written after response to the previous.
+ */
+typedef struct {
+    uint32_t responses;
+    uint32_t errors;
+    uint8_t errorMatch; /* number of matched characters of "ERROR:" */
+} bench_gtwaReader_t;
+
+static size_t bench_gtwaRead(void *object, const char *buf, size_t count,
+                             uint8_t *connectionOK)
+{
+    static const char error[] = "ERROR:";
+    bench_gtwaReader_t *reader = object;
+    (void)connectionOK;
+
+    for (size_t i = 0; i < count; i++) {
+        if (buf[i] == '\n') {
+            reader->responses++;
+        }
+        if (buf[i] == error[reader->errorMatch]) {
+            if (++reader->errorMatch == (sizeof(error) - 1)) {
+                reader->errors++;
+                reader->errorMatch = 0;
+            }
+        }
+        else {
+            reader->errorMatch = (buf[i] == error[0]) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+static CO_GTWR_t bench_gtwr;
+
+static void bench_gatewayRun(const char *sc, const char *command,
+                             CO_t *gtw, CO_t *slave, bool_t routed,
+                             bench_gtwaReader_t *reader)
+{
+    uint32_t count = opt_seconds * 1000U;
+    uint32_t steps = 0;
+    uint32_t errors = reader->errors;
+    bench_time_t t;
+
+    CO_loopback_resetCounters(&bench_bus);
+    bench_start(&t);
+    for (uint32_t i = 0; i < count; i++) {
+        char cmd[48];
+        uint32_t responses = reader->responses;
+        int len = snprintf(cmd, sizeof(cmd), "[%u] %s",
+                           (unsigned)(i % 1000U), command);
+
+        if (routed) {
+            CO_GTWR_write(&bench_gtwr, cmd, (size_t)len);
+        }
+        else {
+            CO_GTWA_write(gtw->gtwa, cmd, (size_t)len);
+        }
+        while (reader->responses == responses && steps < count * 100U) {
+            if (routed) {
+                CO_GTWR_process(&bench_gtwr);
+                CO_GTWR_processNet(&bench_gtwr, 0);
+            }
+            bench_process(gtw, true, 100);
+            CO_loopback_deliver(&bench_bus);
+            bench_process(slave, false, 100);
+            CO_loopback_deliver(&bench_bus);
+            steps++;
+        }
+    }
+    bench_stop(&t);
+
+    bench_report(sc, "commands", count, "");
+    bench_report(sc, "errors", reader->errors - errors, "");
+    bench_report(sc, "command rate",
+                 (double)count * 1e9 / (double)t.ns, "1/s");
+    bench_reportTime(sc, "command", &t, count);
+    bench_report(sc, "process steps per command",
+                 (double)steps / (double)count, "");
+    bench_report(sc, "frames per command",
+                 (double)bench_bus.frames / (double)count, "");
+}
+
+static void bench_gateway(void) {
+    static const char *commands[][2] = {
+        {"gtw-sdo", "1 r 0x1018 4 u32\n"},
+        {"gtw-local", "2 r 0x1018 4 u32\n"},
+        {"gtw-nmt", "1 start\n"}
+    };
+    static const char *routedCommands[][2] = {
+        {"gtwr-sdo", "1 1 r 0x1018 4 u32\n"},
+        {"gtwr-stop", "1 stop\n"},
+        {"gtwr-start", "1 start\n"},
+        {"gtwr-nmt", "1 1 start\n"}
+    };
+    static const uint16_t nets[] = {1};
+    bench_gtwaReader_t reader = {0};
+
+    bench_reset();
+    CO_t *gtw = bench_addNode(2, OD);
+    CO_t *slave = bench_addNode(1, OD);
+    CO_GTWA_initRead(gtw->gtwa, bench_gtwaRead, &reader);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        bench_step(BENCH_STEP_US);
+    }
+    /* default network for commands without <net> */
+    CO_GTWA_write(gtw->gtwa, "[0] set network 1\n", 18);
+    bench_process(gtw, true, 100);
+
+    for (size_t c = 0; c < sizeof(commands) / sizeof(commands[0]); c++) {
+        bench_gatewayRun(commands[c][0], commands[c][1], gtw, slave, false,
+                         &reader);
+    }
+
+    CO_GTWR_init(&bench_gtwr, nets, 1);
+    CO_GTWR_initRead(&bench_gtwr, bench_gtwaRead, &reader);
+    CO_GTWR_attachNet(&bench_gtwr, 0, gtw->gtwa);
+    for (size_t c = 0; c < sizeof(routedCommands) / sizeof(routedCommands[0]);
+         c++
+    ) {
+        bench_gatewayRun(routedCommands[c][0], routedCommands[c][1], gtw,
+                         slave, true, &reader);
+    }
+}
+
+
+/*
+ * LSS master assigns node-IDs to 64 unconfigured LSS slaves with identical
+ * vendor-ID, product code and revision number and different serial numbers.
+ * First with CO_LSSmaster_assignAll(), then with CO_LSSmaster_IdentifyFastscan()
+ * and CO_LSSmaster_configureNodeId() in a loop.
+ */
+typedef struct {
+    CO_LSSslave_t slave[BENCH_LSS_NODES];
+    CO_LSS_address_t address[BENCH_LSS_NODES];
+    uint16_t bitRate[BENCH_LSS_NODES];
+    uint8_t nodeId[BENCH_LSS_NODES];
+    CO_CANmodule_t slaveCAN[BENCH_LSS_NODES];
+    CO_CANrx_t slaveRx[BENCH_LSS_NODES][1];
+    CO_CANtx_t slaveTx[BENCH_LSS_NODES][1];
+    CO_LSSmaster_t master;
+    CO_CANmodule_t masterCAN;
+    CO_CANrx_t masterRx[1];
+    CO_CANtx_t masterTx[1];
+} bench_lss_t;
+
+static void bench_lssSetup(bench_lss_t *l) {
+    bench_reset();
+    memset(l, 0, sizeof(*l));
+    srand(7);
+    for (uint16_t i = 0; i < BENCH_LSS_NODES; i++) {
+        l->address[i].identity.vendorID = 0x000001A0;
+        l->address[i].identity.productCode = 0x00000001;
+        l->address[i].identity.revisionNumber = 0x00040000;
+        l->address[i].identity.serialNumber = (uint32_t)rand();
+        l->bitRate[i] = BENCH_BITRATE;
+        l->nodeId[i] = CO_LSS_NODE_ID_ASSIGNMENT;
+        CO_CANmodule_init(&l->slaveCAN[i], &bench_bus, l->slaveRx[i], 1,
+                          l->slaveTx[i], 1, BENCH_BITRATE);
+        CO_LSSslave_init(&l->slave[i], &l->address[i], &l->bitRate[i],
+                         &l->nodeId[i], &l->slaveCAN[i], 0,
+                         CO_CAN_ID_LSS_MST, &l->slaveCAN[i], 0,
+                         CO_CAN_ID_LSS_SLV);
+        CO_CANsetNormalMode(&l->slaveCAN[i]);
+    }
+    CO_CANmodule_init(&l->masterCAN, &bench_bus, l->masterRx, 1,
+                      l->masterTx, 1, BENCH_BITRATE);
+    CO_LSSmaster_init(&l->master, 100, &l->masterCAN, 0, CO_CAN_ID_LSS_SLV,
+                      &l->masterCAN, 0, CO_CAN_ID_LSS_MST);
+    CO_CANsetNormalMode(&l->masterCAN);
+}
+
+/* Process slaves, deliver their responses to the master */
+static void bench_lssSlaves(bench_lss_t *l) {
+    CO_loopback_deliver(&bench_bus);
+    for (uint16_t i = 0; i < BENCH_LSS_NODES; i++) {
+        CO_LSSslave_process(&l->slave[i]);
+    }
+    CO_loopback_deliver(&bench_bus);
+}
+
+static uint16_t bench_lssVerify(bench_lss_t *l) {
+    bool_t seen[128] = {false};
+    uint16_t ok = 0;
+
+    for (uint16_t i = 0; i < BENCH_LSS_NODES; i++) {
+        uint8_t id = l->nodeId[i];
+        if (id >= 1 && id <= 127 && !seen[id]) {
+            seen[id] = true;
+            ok++;
+        }
+    }
+    return ok;
+}
+
+static void bench_lssReport(const char *sc, bench_lss_t *l,
+                            const bench_time_t *t, uint64_t simulated_us)
+{
+    bench_report(sc, "nodes with unique node-ID", bench_lssVerify(l), "");
+    bench_report(sc, "frames", bench_bus.frames, "");
+    bench_report(sc, "simulated time", (double)simulated_us / 1000.0, "ms");
+    bench_report(sc, "bus time at 1 Mbit/s",
+                 (double)CO_loopback_busTime_us(&bench_bus) / 1000.0, "ms");
+    bench_reportTime(sc, "assigned node", t, BENCH_LSS_NODES);
+    bench_reportTime(sc, "frame", t, bench_bus.frames);
+}
+
+static void bench_lss(void) {
+    static bench_lss_t l;
+    const uint32_t dt_us = 500;
+    CO_LSSmaster_return_t ret;
+    uint64_t simulated_us;
+    bench_time_t t;
+
+    /* assign all */
+    CO_LSSmaster_assignAll_t assign;
+    bench_lssSetup(&l);
+    memset(&assign, 0, sizeof(assign));
+    assign.nodeIdNext = 2;
+    assign.nodeIdLast = 127;
+    simulated_us = 0;
+    bench_start(&t);
+    do {
+        bench_lssSlaves(&l);
+        ret = CO_LSSmaster_assignAll(&l.master,
+                                     simulated_us == 0 ? 0 : dt_us, &assign);
+        simulated_us += dt_us;
+    } while (ret == CO_LSSmaster_WAIT_SLAVE && simulated_us < 600000000U);
+    bench_stop(&t);
+    bench_lssReport("lss-all", &l, &t, simulated_us);
+    bench_report("lss-all", "fastscan requests", assign.fsRequests, "");
+
+    /* fastscan and configure node-ID, one by one */
+    CO_LSSmaster_fastscan_t fastscan;
+    uint8_t nodeId = 2;
+    bench_lssSetup(&l);
+    memset(&fastscan, 0, sizeof(fastscan));
+    simulated_us = 0;
+    bench_start(&t);
+    for (;;) {
+        uint32_t dt = 0;
+        do {
+            bench_lssSlaves(&l);
+            ret = CO_LSSmaster_IdentifyFastscan(&l.master, dt, &fastscan);
+            dt = dt_us;
+            simulated_us += dt_us;
+        } while (ret == CO_LSSmaster_WAIT_SLAVE);
+        if (ret != CO_LSSmaster_SCAN_FINISHED) {
+            break;
+        }
+        dt = 0;
+        do {
+            bench_lssSlaves(&l);
+            ret = CO_LSSmaster_configureNodeId(&l.master, dt, nodeId);
+            dt = dt_us;
+            simulated_us += dt_us;
+        } while (ret == CO_LSSmaster_WAIT_SLAVE);
+        CO_LSSmaster_switchStateDeselect(&l.master);
+        nodeId++;
+    }
+    bench_stop(&t);
+    bench_lssReport("lss-scan", &l, &t, simulated_us);
+}
+
+
+/*
+ * N devices (64 by default), each with own Object Dictionary instance, which
+ * shares constant OD objects with the default OD. Heartbeat each 10 ms, each
+ * node consumes heartbeats of the next 8 nodes, as in heartbeat scenario.
+ * CO_sim scheduler processes device only at its deadline or on received
+ * message and then jumps to the next deadline.
+ */
+static size_t bench_odObjectsSize(const OD_t *od) {
+    size_t size = 0;
+
+    for (uint16_t i = 0; i < od->size; i++) {
+        const OD_entry_t *entry = &od->list[i];
+        switch (entry->odObjectType & ODT_TYPE_MASK) {
+        case ODT_VAR: size += sizeof(OD_obj_var_t); break;
+        case ODT_ARR: size += sizeof(OD_obj_array_t); break;
+        default:
+            size += entry->subEntriesCount * sizeof(OD_obj_record_t);
+            break;
+        }
+    }
+    return size;
+}
+
+static void bench_sim(void) {
+    const char *sc = "sim";
+    static CO_simNode_t simNodes[BENCH_NODES_MAX];
+    uint16_t nodes = opt_nodes;
+    uint64_t simulated_us = (uint64_t)opt_seconds * 1000000U;
+    uint16_t operational = 0, ownData = 0;
+    uint64_t processed;
+    CO_sim_t sim;
+    bench_time_t t;
+
+    bench_reset();
+    for (uint8_t k = 1; k <= nodes; k++) {
+        OD_t *od = bench_newInstance();
+        OD_entry_t *hbCons = OD_find(od, 0x1016);
+
+        OD_set_u16(OD_find(od, 0x1017), 0, 10, true);
+        for (uint8_t j = 1; j <= OD_CNT_ARR_1016; j++) {
+            uint32_t hb = 0;
+            if (j < nodes) {
+                uint8_t monitored = (uint8_t)(((k - 1U + j) % nodes) + 1U);
+                hb = ((uint32_t)monitored << 16) | 50U;
+            }
+            OD_set_u32(hbCons, j, hb, true);
+        }
+        bench_addNode(k, od);
+    }
+
+    CO_sim_init(&sim, &bench_bus, simNodes, BENCH_NODES_MAX);
+    for (uint16_t n = 0; n < bench_nodeCount; n++) {
+        CO_sim_addNode(&sim, bench_nodes[n].co);
+    }
+
+    /* boot-up and the first heartbeats */
+    if (CO_sim_run(&sim, 100000) != NULL) {
+        printf("Error: unexpected reset command\n");
+        exit(EXIT_FAILURE);
+    }
+    CO_loopback_resetCounters(&bench_bus);
+    processed = sim.processed;
+
+    bench_start(&t);
+    if (CO_sim_run(&sim, simulated_us) != NULL) {
+        printf("Error: unexpected reset command\n");
+        exit(EXIT_FAILURE);
+    }
+    bench_stop(&t);
+    processed = sim.processed - processed;
+
+    for (uint16_t n = 0; n < bench_nodeCount; n++) {
+        bench_node_t *node = &bench_nodes[n];
+        uint8_t *ptr = OD_getPtr(OD_find(&node->od, 0x1016), 1, 0, NULL);
+
+        if (node->co->HBcons->allMonitoredOperational) {
+            operational++;
+        }
+        /* variables of each instance are inside its own memory */
+        if (ptr >= (uint8_t *)node->odPersistComm
+            && ptr < (uint8_t *)(node->odPersistComm + 1)
+        ) {
+            ownData++;
+        }
+    }
+
+    size_t listSize = (OD->size + 1U) * sizeof(OD_entry_t);
+    size_t dataSize = sizeof(OD_PERSIST_COMM_t) + sizeof(OD_RAM_t);
+    size_t objSize = bench_odObjectsSize(OD);
+
+    bench_report(sc, "nodes", nodes, "");
+    bench_report(sc, "simulated time", (double)simulated_us / 1000.0, "ms");
+    bench_report(sc, "host time", (double)t.ns / 1000000.0, "ms");
+    bench_report(sc, "simulated / host time",
+                 (double)simulated_us * 1000.0 / (double)t.ns, "x");
+    bench_report(sc, "node processings per second",
+                 (double)processed * 1000000.0 / (double)simulated_us, "");
+    bench_reportTime(sc, "node processing", &t, processed);
+    bench_reportBus(sc, simulated_us);
+    bench_report(sc, "consumers all operational", operational, "nodes");
+    bench_report(sc, "nodes with own OD data", ownData, "nodes");
+    bench_report(sc, "OD instance per node", (double)(listSize + dataSize),
+                 "B");
+    bench_report(sc, "OD copy per node",
+                 (double)(listSize + dataSize + objSize), "B");
+    bench_report(sc, "shared OD objects", (double)objSize, "B");
+    bench_report(sc, "CANopen objects per node",
+                 (double)bench_nodes[0].heapMemoryUsed, "B");
+}
+
+/******************************************************************************/
+static const struct {
+    const char *name;
+    void (*run)(void);
+} bench_scenarios[] = {
+    {"heartbeat", bench_heartbeat},
+    {"pdo", bench_pdo},
+    {"sdo", bench_sdo},
+    {"prg", bench_prg},
+    {"gateway", bench_gateway},
+    {"lss", bench_lss},
+    {"sim", bench_sim}
+};
+
+#define BENCH_SCENARIOS (sizeof(bench_scenarios) / sizeof(bench_scenarios[0]))
+
+static void bench_usage(const char *prog) {
+    printf("Usage: %s [-n nodes] [-t seconds] [scenario ...]\n", prog);
+    printf("  -n nodes    Number of nodes for heartbeat, pdo and sim, 2..%u, "
+           "default 64.\n", BENCH_NODES_MAX);
+    printf("  -t seconds  Simulated time for heartbeat, pdo and sim, number of\n"
+           "              gateway commands in thousands, default 10.\n");
+    printf("Scenarios:");
+    for (size_t i = 0; i < BENCH_SCENARIOS; i++) {
+        printf(" %s", bench_scenarios[i].name);
+    }
+    printf(", default all.\n");
+}
+
+int main(int argc, char *argv[]) {
+    bool_t selected[BENCH_SCENARIOS] = {false};
+    bool_t any = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && (i + 1) < argc) {
+            opt_nodes = (uint16_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "-t") == 0 && (i + 1) < argc) {
+            opt_seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else {
+            size_t s;
+            for (s = 0; s < BENCH_SCENARIOS; s++) {
+                if (strcmp(argv[i], bench_scenarios[s].name) == 0) {
+                    selected[s] = true;
+                    any = true;
+                    break;
+                }
+            }
+            if (s == BENCH_SCENARIOS) {
+                bench_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    if (opt_nodes < 2 || opt_nodes > BENCH_NODES_MAX || opt_seconds == 0) {
+        bench_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench_odPersistComm = OD_PERSIST_COMM;
+    bench_odRam = OD_RAM;
+
+    printf("%-10s %-34s %14s %s\n", "scenario", "metric", "value", "unit");
+    for (size_t s = 0; s < BENCH_SCENARIOS; s++) {
+        if (!any || selected[s]) {
+            bench_scenarios[s].run();
+        }
+    }
+    bench_reset();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,454 @@
+/*
+ * Loopback CAN driver (virtual CAN bus) for host benchmark
+ *
+ * @file        CO_driver_loopback.c
+ * @ingroup     CO_driver_loopback
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_driver.h"
+#include "301/CO_stats.h"
+#include "CO_driver_loopback.h"
+
+#if (CO_LOOPBACK_QUEUE_SIZE & (CO_LOOPBACK_QUEUE_SIZE - 1)) != 0
+#error CO_LOOPBACK_QUEUE_SIZE must be power of 2
+#endif
+
+/* Bits of standard data frame without data and without bit stuffing: SOF,
+ * identifier, RTR, IDE, r0, DLC, CRC, delimiters, ACK, EOF and interframe
+ * space */
+#define LOOPBACK_FRAME_BITS 47U
+
+
+/* Walk through receive buffers of all modules and call function for each
+ * CAN-ID (with RTR bit), accepted by the first matching buffer of the module.
+ * Masked bits of the identifier are expanded to all accepted CAN-IDs. */
+static void CO_loopback_walk(CO_loopback_t *bus, uint16_t *stamp,
+                             void (*fn)(CO_loopback_t *bus, uint16_t id,
+                                        uint16_t module, uint16_t buffer))
+{
+    memset(stamp, 0, CO_LOOPBACK_IDS * sizeof(uint16_t));
+
+    for (uint16_t m = 0; m < bus->moduleCount; m++) {
+        CO_CANmodule_t *CANmodule = bus->modules[m];
+
+        for (uint16_t i = 0; i < CANmodule->rxSize; i++) {
+            CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+            uint16_t free = (uint16_t)~buffer->mask & (CO_LOOPBACK_IDS - 1U);
+            uint16_t fixed = buffer->ident & buffer->mask
+                           & (CO_LOOPBACK_IDS - 1U);
+            uint16_t s = 0;
+
+            if (buffer->CANrx_callback == NULL) {
+                continue;
+            }
+            /* all subsets of free bits */
+            do {
+                uint16_t id = fixed | s;
+                if (stamp[id] != (uint16_t)(m + 1U)) {
+                    stamp[id] = (uint16_t)(m + 1U);
+                    fn(bus, id, m, i);
+                }
+                s = (uint16_t)(s - free) & free;
+            } while (s != 0U);
+        }
+    }
+}
+
+static void CO_loopback_count(CO_loopback_t *bus, uint16_t id,
+                              uint16_t module, uint16_t buffer)
+{
+    (void)module; (void)buffer;
+    bus->lookupStart[id + 1U]++;
+}
+
+static void CO_loopback_fill(CO_loopback_t *bus, uint16_t id,
+                             uint16_t module, uint16_t buffer)
+{
+    /* lookupStart[id] is used as write position and restored later */
+    CO_loopback_rx_t *rx = &bus->lookup[bus->lookupStart[id]++];
+    rx->module = module;
+    rx->buffer = buffer;
+}
+
+static void CO_loopback_rebuild(CO_loopback_t *bus) {
+    static uint16_t stamp[CO_LOOPBACK_IDS];
+    uint32_t total = 0;
+
+    memset(bus->lookupStart, 0, sizeof(bus->lookupStart));
+    CO_loopback_walk(bus, stamp, CO_loopback_count);
+    for (uint16_t id = 0; id < CO_LOOPBACK_IDS; id++) {
+        total += bus->lookupStart[id + 1U];
+        if (total > CO_LOOPBACK_LOOKUP_SIZE) {
+            bus->lookupOverflow = true;
+            bus->lookupDirty = false;
+            return;
+        }
+        bus->lookupStart[id + 1U] = (uint16_t)total;
+    }
+
+    CO_loopback_walk(bus, stamp, CO_loopback_fill);
+    /* each start was moved to the start of the next identifier */
+    for (uint16_t id = CO_LOOPBACK_IDS; id > 0U; id--) {
+        bus->lookupStart[id] = bus->lookupStart[id - 1U];
+    }
+    bus->lookupStart[0] = 0;
+    bus->lookupOverflow = false;
+    bus->lookupDirty = false;
+}
+
+static void CO_loopback_receive(CO_CANmodule_t *CANmodule, uint16_t index,
+                                CO_CANrxMsg_t *msg)
+{
+    CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+    if (CANmodule->CANnormal && buffer->CANrx_callback != NULL) {
+        CO_STATS_CAN_RX_BEGIN();
+        buffer->CANrx_callback(buffer->object, msg);
+        CO_STATS_CAN_RX_END(CANmodule);
+    }
+}
+
+
+/******************************************************************************/
+void CO_loopback_init(CO_loopback_t *bus) {
+    if (bus != NULL) {
+        memset(bus, 0, sizeof(CO_loopback_t));
+        bus->lookupDirty = true;
+    }
+}
+
+
+/******************************************************************************/
+uint32_t CO_loopback_deliver(CO_loopback_t *bus) {
+    uint32_t delivered = 0;
+
+    while (bus->queueRd != bus->queueWr) {
+        /* copy, so the slot may be reused if callbacks send new messages */
+        CO_loopback_frame_t frame =
+            bus->queue[bus->queueRd & (CO_LOOPBACK_QUEUE_SIZE - 1U)];
+        uint16_t id = (uint16_t)(frame.msg.ident & (CO_LOOPBACK_IDS - 1U));
+
+        bus->queueRd++;
+        if (bus->lookupDirty) {
+            CO_loopback_rebuild(bus);
+        }
+
+        if (bus->monitor != NULL) {
+            bus->monitor(bus->monitorObject, &frame.msg);
+        }
+        for (uint16_t m = 0; m < bus->moduleCount; m++) {
+            CO_STATS_CAN_FRAME(bus->modules[m], frame.msg.ident,
+                               frame.msg.DLC);
+        }
+
+        /* CANrx_callback functions see CAN-ID without RTR bit */
+        frame.msg.ident &= 0x07FFU;
+        if (!bus->lookupOverflow) {
+            for (uint16_t i = bus->lookupStart[id];
+                 i < bus->lookupStart[id + 1U]; i++) {
+                CO_CANmodule_t *CANmodule =
+                    bus->modules[bus->lookup[i].module];
+                if (CANmodule != frame.from) {
+                    CO_loopback_receive(CANmodule, bus->lookup[i].buffer,
+                                        &frame.msg);
+                }
+            }
+        }
+        else {
+            for (uint16_t m = 0; m < bus->moduleCount; m++) {
+                CO_CANmodule_t *CANmodule = bus->modules[m];
+                if (CANmodule == frame.from) {
+                    continue;
+                }
+                for (uint16_t i = 0; i < CANmodule->rxSize; i++) {
+                    CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+                    if (buffer->CANrx_callback != NULL
+                        && ((id ^ buffer->ident) & buffer->mask) == 0U
+                    ) {
+                        CO_loopback_receive(CANmodule, i, &frame.msg);
+                        break;
+                    }
+                }
+            }
+        }
+
+        bus->frames++;
+        bus->bits += LOOPBACK_FRAME_BITS + 8U * frame.msg.DLC;
+        delivered++;
+    }
+
+    return delivered;
+}
+
+
+/******************************************************************************/
+void CO_loopback_resetCounters(CO_loopback_t *bus) {
+    bus->frames = 0;
+    bus->framesDropped = 0;
+    bus->bits = 0;
+}
+
+
+/******************************************************************************/
+uint64_t CO_loopback_busTime_us(CO_loopback_t *bus) {
+    uint16_t bitRate = bus->bitRate != 0U ? bus->bitRate : 1000U;
+    return bus->bits * 1000U / bitRate;
+}
+
+
+/******************************************************************************/
+void CO_CANsetConfigurationMode(void *CANptr){
+    /* Put CAN module in configuration mode */
+    (void)CANptr;
+}
+
+
+/******************************************************************************/
+void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+    /* Put CAN module in normal mode */
+
+    CANmodule->CANnormal = true;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(
+        CO_CANmodule_t         *CANmodule,
+        void                   *CANptr,
+        CO_CANrx_t              rxArray[],
+        uint16_t                rxSize,
+        CO_CANtx_t              txArray[],
+        uint16_t                txSize,
+        uint16_t                CANbitRate)
+{
+    CO_loopback_t *bus = (CO_loopback_t *)CANptr;
+    uint16_t i;
+
+    /* verify arguments */
+    if(CANmodule==NULL || bus==NULL || rxArray==NULL || txArray==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* connect to the bus, if not already */
+    for(i=0U; i<bus->moduleCount; i++){
+        if(bus->modules[i] == CANmodule){
+            break;
+        }
+    }
+    if(i == bus->moduleCount){
+        if(bus->moduleCount >= CO_LOOPBACK_MODULES){
+            return CO_ERROR_OUT_OF_MEMORY;
+        }
+        bus->modules[bus->moduleCount++] = CANmodule;
+    }
+    bus->bitRate = CANbitRate;
+    bus->lookupDirty = true;
+
+    /* Configure object variables */
+    CANmodule->CANptr = CANptr;
+    CANmodule->rxArray = rxArray;
+    CANmodule->rxSize = rxSize;
+    CANmodule->txArray = txArray;
+    CANmodule->txSize = txSize;
+    CANmodule->CANerrorStatus = 0;
+    CANmodule->CANnormal = false;
+    CANmodule->useCANrxFilters = true;
+    CANmodule->bufferInhibitFlag = false;
+    CANmodule->firstCANtxMessage = true;
+    CANmodule->CANtxCount = 0U;
+    CANmodule->errOld = 0U;
+    CANmodule->stats = NULL;
+
+    for(i=0U; i<rxSize; i++){
+        rxArray[i].ident = 0U;
+        rxArray[i].mask = 0xFFFFU;
+        rxArray[i].object = NULL;
+        rxArray[i].CANrx_callback = NULL;
+    }
+    for(i=0U; i<txSize; i++){
+        txArray[i].bufferFull = false;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule) {
+    if (CANmodule != NULL) {
+        CANmodule->CANnormal = false;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        uint16_t                mask,
+        bool_t                  rtr,
+        void                   *object,
+        void                  (*CANrx_callback)(void *object, void *message))
+{
+    CO_ReturnError_t ret = CO_ERROR_NO;
+
+    if((CANmodule!=NULL) && (object!=NULL) && (CANrx_callback!=NULL) && (index < CANmodule->rxSize)){
+        /* buffer, which will be configured */
+        CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+        /* Configure object variables */
+        buffer->object = object;
+        buffer->CANrx_callback = CANrx_callback;
+
+        /* CAN identifier and CAN mask, same layout as lookup table index */
+        buffer->ident = ident & 0x07FFU;
+        if(rtr){
+            buffer->ident |= 0x0800U;
+        }
+        buffer->mask = (mask & 0x07FFU) | 0x0800U;
+
+        ((CO_loopback_t *)CANmodule->CANptr)->lookupDirty = true;
+    }
+    else{
+        ret = CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        bool_t                  rtr,
+        uint8_t                 noOfBytes,
+        bool_t                  syncFlag)
+{
+    CO_CANtx_t *buffer = NULL;
+
+    if((CANmodule != NULL) && (index < CANmodule->txSize)){
+        /* get specific buffer */
+        buffer = &CANmodule->txArray[index];
+
+        /* CAN identifier, DLC and rtr, bit aligned as in example driver */
+        buffer->ident = ((uint32_t)ident & 0x07FFU)
+                      | ((uint32_t)CO_CANlengthToDlc(noOfBytes) << 11U)
+                      | ((uint32_t)(rtr ? 0x8000U : 0U));
+
+        buffer->bufferFull = false;
+        buffer->syncFlag = syncFlag;
+    }
+
+    return buffer;
+}
+
+
+/* Put message into the bus queue */
+static CO_ReturnError_t CO_loopback_queue(CO_CANmodule_t *CANmodule,
+                                          CO_CANtx_t *buffer)
+{
+    CO_loopback_t *bus = (CO_loopback_t *)CANmodule->CANptr;
+    CO_loopback_frame_t *frame;
+
+    if((bus->queueWr - bus->queueRd) >= CO_LOOPBACK_QUEUE_SIZE){
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+        bus->framesDropped++;
+        return CO_ERROR_TX_OVERFLOW;
+    }
+
+    frame = &bus->queue[bus->queueWr & (CO_LOOPBACK_QUEUE_SIZE - 1U)];
+    frame->from = CANmodule;
+    frame->msg.ident = buffer->ident & 0x07FFU;
+    if((buffer->ident & 0x8000U) != 0U){
+        frame->msg.ident |= 0x0800U;
+    }
+    frame->msg.DLC = CO_CANdlcToLength((uint8_t)((buffer->ident >> 11U) & 0xFU));
+    memcpy(frame->msg.data, buffer->data, sizeof(frame->msg.data));
+    bus->queueWr++;
+
+    CANmodule->firstCANtxMessage = false;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
+    /* Message held back by transmit limiter waits in the buffer, it is
+     * queued later by CO_CANmodule_process(). */
+    if(buffer->bufferFull){
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+        return CO_ERROR_TX_OVERFLOW;
+    }
+    if(!CO_STATS_CAN_TX_ALLOWED(CANmodule, buffer->ident)){
+        buffer->bufferFull = true;
+        CANmodule->CANtxCount++;
+        return CO_ERROR_NO;
+    }
+
+    return CO_loopback_queue(CANmodule, buffer);
+}
+
+
+/******************************************************************************/
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
+    /* messages are queued on the bus immediately, nothing is pending */
+    (void)CANmodule;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
+    CO_loopback_t *bus = (CO_loopback_t *)CANmodule->CANptr;
+
+    /* queue held messages, highest priority first, if limiter allows */
+    if(CANmodule->CANtxCount > 0U){
+        uint16_t pending = 0;
+
+        for(uint16_t i = 0; i < CANmodule->txSize; i++){
+            CO_CANtx_t *buffer = &CANmodule->txArray[i];
+
+            if(!buffer->bufferFull){
+                continue;
+            }
+            if((bus->queueWr - bus->queueRd) < CO_LOOPBACK_QUEUE_SIZE
+               && CO_STATS_CAN_TX_ALLOWED(CANmodule, buffer->ident)
+            ){
+                buffer->bufferFull = false;
+                (void)CO_loopback_queue(CANmodule, buffer);
+            }
+            else{
+                pending++;
+            }
+        }
+        CANmodule->CANtxCount = pending;
+    }
+
+    /* transmit overflow lasts until there is space in the queue again */
+    if((bus->queueWr - bus->queueRd) < CO_LOOPBACK_QUEUE_SIZE){
+        CANmodule->CANerrorStatus &= (uint16_t)~CO_CAN_ERRTX_OVERFLOW;
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ * Loopback CAN driver (virtual CAN bus) for host benchmark
+ *
+ * @file        CO_driver_loopback.h
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_DRIVER_LOOPBACK_H
+#define CO_DRIVER_LOOPBACK_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_driver_loopback Loopback CAN bus
+ * In-memory CAN bus, which connects many CAN modules inside one process.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Loopback bus is passed as _CANptr_ argument to CO_CANmodule_init() (or
+ * CO_CANinit()), so any number of CANopen devices may be connected to the same
+ * virtual bus. CO_CANsend() copies the message into the bus queue and returns
+ * immediately. CO_loopback_deliver() then passes queued messages to all other
+ * CAN modules on the bus, in order of transmission. Each receiving CAN module
+ * calls CANrx_callback of the CO_CANrx_t buffer with the lowest index, which
+ * accepts the message, as with hardware filters.
+ *
+ * Matching uses a lookup table over all 11-bit identifiers (and RTR bit), so
+ * delivery costs are proportional to the number of receivers, not to the
+ * number of all receive buffers on the bus. Table is rebuilt on the next
+ * delivery after any CO_CANrxBufferInit().
+ *
+ * Everything runs in the caller's thread, critical section macros are empty.
+ */
+
+/** Maximum number of CAN modules on one loopback bus */
+#ifndef CO_LOOPBACK_MODULES
+#define CO_LOOPBACK_MODULES 160
+#endif
+
+/** Number of messages in the bus queue, must be power of 2 */
+#ifndef CO_LOOPBACK_QUEUE_SIZE
+#define CO_LOOPBACK_QUEUE_SIZE 1024
+#endif
+
+/** Number of (module, buffer) pairs in the lookup table */
+#ifndef CO_LOOPBACK_LOOKUP_SIZE
+#define CO_LOOPBACK_LOOKUP_SIZE 16384
+#endif
+
+/** Number of lookup table slots: 11-bit CAN-ID and RTR bit */
+#define CO_LOOPBACK_IDS 0x1000
+
+/**
+ * Message in the bus queue
+ */
+typedef struct {
+    CO_CANrxMsg_t msg;        /**< Message, as received by CANrx_callback */
+    CO_CANmodule_t *from;     /**< Transmitting CAN module */
+} CO_loopback_frame_t;
+
+/**
+ * Receiver inside lookup table
+ */
+typedef struct {
+    uint16_t module;          /**< Index of the CAN module on the bus */
+    uint16_t buffer;          /**< Index of the buffer inside rxArray */
+} CO_loopback_rx_t;
+
+/**
+ * Loopback bus object
+ */
+typedef struct {
+    /** Connected CAN modules */
+    CO_CANmodule_t *modules[CO_LOOPBACK_MODULES];
+    uint16_t moduleCount;     /**< Number of connected CAN modules */
+    /** Queue of transmitted, not yet delivered messages */
+    CO_loopback_frame_t queue[CO_LOOPBACK_QUEUE_SIZE];
+    uint32_t queueWr;         /**< Queue write counter */
+    uint32_t queueRd;         /**< Queue read counter */
+    /** Receivers for each identifier start at lookupStart[ident] and end
+     * before lookupStart[ident + 1] */
+    uint16_t lookupStart[CO_LOOPBACK_IDS + 1];
+    CO_loopback_rx_t lookup[CO_LOOPBACK_LOOKUP_SIZE]; /**< Receivers */
+    /** Lookup table must be rebuilt before next delivery */
+    bool_t lookupDirty;
+    /** Lookup table is too small, delivery searches all rxArrays */
+    bool_t lookupOverflow;
+    /** Optional monitor, called for each delivered message, may be NULL.
+     * Identifier of the message includes RTR bit as 0x0800. */
+    void (*monitor)(void *object, const CO_CANrxMsg_t *msg);
+    void *monitorObject;      /**< Object passed to monitor */
+    /** Bit rate in kbit/s, from the last CO_CANmodule_init() */
+    uint16_t bitRate;
+    uint32_t frames;          /**< Number of all delivered messages */
+    uint32_t framesDropped;   /**< Number of messages lost on full queue */
+    uint64_t bits;            /**< Bus time of delivered messages in bits */
+} CO_loopback_t;
+
+
+/**
+ * Initialize loopback bus, all CAN modules are disconnected.
+ *
+ * @param bus This object will be initialized.
+ */
+void CO_loopback_init(CO_loopback_t *bus);
+
+
+/**
+ * Deliver all queued messages to receiving CAN modules.
+ *
+ * Messages, sent from CANrx_callback functions, are delivered too.
+ *
+ * @param bus This object.
+ *
+ * @return Number of delivered messages.
+ */
+uint32_t CO_loopback_deliver(CO_loopback_t *bus);
+
+
+/**
+ * Reset message counters.
+ *
+ * @param bus This object.
+ */
+void CO_loopback_resetCounters(CO_loopback_t *bus);
+
+
+/**
+ * Bus time of the messages in microseconds, without bit stuffing.
+ *
+ * @param bus This object.
+ *
+ * @return Time, which delivered messages would occupy on a real bus.
+ */
+uint64_t CO_loopback_busTime_us(CO_loopback_t *bus);
+
+/** @} */ /* CO_driver_loopback */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_DRIVER_LOOPBACK_H */
@@ -0,0 +1,256 @@
+/*
+ * Device and application specific definitions for CANopenNode benchmark.
+ *
+ * @file        CO_driver_target.h
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CO_DRIVER_TARGET_H
+#define CO_DRIVER_TARGET_H
+
+/* This file contains definitions for the host benchmark with the loopback
+ * (virtual) CAN bus, see CO_driver_loopback.h. It is included from
+ * CO_driver.h, which contains documentation for common definitions below. */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#endif
+
+#ifdef CO_DRIVER_CUSTOM
+#include "CO_driver_custom.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stack configuration override default values.
+ * For more information see file CO_config.h. Callbacks and timerNext are
+ * used by the simulation scheduler, see CO_sim.h. */
+#ifndef CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE
+#define CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE CO_CONFIG_FLAG_CALLBACK_PRE
+#endif
+#ifndef CO_CONFIG_GLOBAL_RT_FLAG_CALLBACK_PRE
+#define CO_CONFIG_GLOBAL_RT_FLAG_CALLBACK_PRE CO_CONFIG_FLAG_CALLBACK_PRE
+#endif
+#ifndef CO_CONFIG_GLOBAL_FLAG_TIMERNEXT
+#define CO_CONFIG_GLOBAL_FLAG_TIMERNEXT CO_CONFIG_FLAG_TIMERNEXT
+#endif
+#ifndef CO_CONFIG_NMT
+#define CO_CONFIG_NMT (CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                       CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
+                       CO_CONFIG_NMT_MASTER)
+#endif
+#ifndef CO_CONFIG_SDO_SRV
+#define CO_CONFIG_SDO_SRV (CO_CONFIG_SDO_SRV_SEGMENTED | \
+                           CO_CONFIG_SDO_SRV_BLOCK | \
+                           CO_CONFIG_SDO_SRV_BLOCK_FLOW | \
+                           CO_CONFIG_SDO_SRV_READY_LIST | \
+                           CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                           CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
+                           CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+#endif
+#ifndef CO_CONFIG_SDO_SRV_BUFFER_SIZE
+#define CO_CONFIG_SDO_SRV_BUFFER_SIZE 900
+#endif
+#ifndef CO_CONFIG_SDO_CLI
+#define CO_CONFIG_SDO_CLI (CO_CONFIG_SDO_CLI_ENABLE | \
+                           CO_CONFIG_SDO_CLI_SEGMENTED | \
+                           CO_CONFIG_SDO_CLI_BLOCK | \
+                           CO_CONFIG_SDO_CLI_LOCAL | \
+                           CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                           CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
+                           CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+#endif
+#ifndef CO_CONFIG_SDO_CLI_BUFFER_SIZE
+#define CO_CONFIG_SDO_CLI_BUFFER_SIZE 1000
+#endif
+#ifndef CO_CONFIG_LSS
+#define CO_CONFIG_LSS (CO_CONFIG_LSS_SLAVE | \
+                       CO_CONFIG_LSS_MASTER | \
+                       CO_CONFIG_LSS_MASTER_ASSIGN_ALL | \
+                       CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE)
+#endif
+#ifndef CO_CONFIG_GTW
+#define CO_CONFIG_GTW (CO_CONFIG_GTW_MULTI_NET | \
+                       CO_CONFIG_GTW_ASCII | \
+                       CO_CONFIG_GTW_ASCII_SDO | \
+                       CO_CONFIG_GTW_ASCII_NMT | \
+                       CO_CONFIG_GTW_ASCII_LSS)
+#endif
+#ifndef CO_CONFIG_GTW_BLOCK_DL_LOOP
+#define CO_CONFIG_GTW_BLOCK_DL_LOOP 1
+#endif
+#ifndef CO_CONFIG_GTWA_COMM_BUF_SIZE
+#define CO_CONFIG_GTWA_COMM_BUF_SIZE 200
+#endif
+#ifndef CO_CONFIG_GTWA_LOG_BUF_SIZE
+#define CO_CONFIG_GTWA_LOG_BUF_SIZE 2000
+#endif
+#ifndef CO_CONFIG_FIFO
+#define CO_CONFIG_FIFO (CO_CONFIG_FIFO_ENABLE | \
+                        CO_CONFIG_FIFO_ALT_READ | \
+                        CO_CONFIG_FIFO_CRC16_CCITT | \
+                        CO_CONFIG_FIFO_ASCII_COMMANDS | \
+                        CO_CONFIG_FIFO_ASCII_DATATYPES)
+#endif
+#ifndef CO_CONFIG_CRC16
+#define CO_CONFIG_CRC16 (CO_CONFIG_CRC16_ENABLE)
+#endif
+#ifndef CO_CONFIG_STATS
+#define CO_CONFIG_STATS (CO_CONFIG_STATS_ENABLE)
+#endif
+#ifndef CO_CONFIG_LEDS
+#define CO_CONFIG_LEDS (0)
+#endif
+#ifndef CO_CONFIG_STORAGE
+#define CO_CONFIG_STORAGE (0)
+#endif
+#ifndef CO_CONFIG_EVLOOP
+#define CO_CONFIG_EVLOOP (CO_CONFIG_EVLOOP_ENABLE)
+#endif
+#ifndef CO_CONFIG_PRG_DOWNLOAD
+#define CO_CONFIG_PRG_DOWNLOAD (CO_CONFIG_PRG_DOWNLOAD_ENABLE)
+#endif
+
+/* Simulated devices share constant Object Dictionary, see OD_instance_init() */
+#ifndef OD_INSTANCES
+#define OD_INSTANCES 1
+#endif
+
+/* Loopback driver records execution time of CANrx_callback functions */
+#define CO_DRIVER_STATS
+
+
+/* Basic definitions. If big endian, CO_SWAP_xx macros must swap bytes. */
+#define CO_LITTLE_ENDIAN
+#define CO_SWAP_16(x) x
+#define CO_SWAP_32(x) x
+#define CO_SWAP_64(x) x
+/* NULL is defined in stddef.h */
+/* true and false are defined in stdbool.h */
+/* int8_t to uint64_t are defined in stdint.h */
+typedef uint_fast8_t            bool_t;
+typedef float                   float32_t;
+typedef double                  float64_t;
+
+
+/* Host time stamp counter, CPU cycles on x86, nanoseconds otherwise. It is
+ * used by benchmark for totals, CO_cycleCounter() is its lower 32 bits. */
+static inline uint64_t CO_benchCycles(void) {
+#if defined __x86_64__ || defined __i386__
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Access to received CAN message */
+#define CO_CANrxMsg_readIdent(msg) ((uint16_t)(((CO_CANrxMsg_t *)(msg))->ident))
+#define CO_CANrxMsg_readDLC(msg)   ((uint8_t)(((CO_CANrxMsg_t *)(msg))->DLC))
+#define CO_CANrxMsg_readData(msg)  ((uint8_t *)(((CO_CANrxMsg_t *)(msg))->data))
+#define CO_CANrxMsg_readTimestamp(msg) ((uint32_t)0)
+#define CO_localTime_us() ((uint32_t)0)
+#define CO_cycleCounter() ((uint32_t)CO_benchCycles())
+
+/* Received CAN message, as delivered by loopback bus */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[CO_CAN_DATA_MAX];
+} CO_CANrxMsg_t;
+
+/* Received message object */
+typedef struct {
+    uint16_t ident;
+    uint16_t mask;
+    void *object;
+    void (*CANrx_callback)(void *object, void *message);
+} CO_CANrx_t;
+
+/* Transmit message object */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[CO_CAN_DATA_MAX];
+    volatile bool_t bufferFull;
+    volatile bool_t syncFlag;
+} CO_CANtx_t;
+
+/* CAN module object */
+typedef struct {
+    void *CANptr;
+    CO_CANrx_t *rxArray;
+    uint16_t rxSize;
+    CO_CANtx_t *txArray;
+    uint16_t txSize;
+    uint16_t CANerrorStatus;
+    volatile bool_t CANnormal;
+    volatile bool_t useCANrxFilters;
+    volatile bool_t bufferInhibitFlag;
+    volatile bool_t firstCANtxMessage;
+    volatile uint16_t CANtxCount;
+    uint32_t errOld;
+    /* Statistics object, set by CO_stats_init() */
+    void *stats;
+} CO_CANmodule_t;
+
+
+/* Data storage object for one entry */
+typedef struct {
+    void *addr;
+    size_t len;
+    uint8_t subIndexOD;
+    uint8_t attr;
+} CO_storage_entry_t;
+
+
+/* (un)lock critical section in CO_CANsend(). Benchmark is single threaded,
+ * CANrx_callback functions are called from CO_loopback_deliver(). */
+#define CO_LOCK_CAN_SEND(CAN_MODULE)
+#define CO_UNLOCK_CAN_SEND(CAN_MODULE)
+
+/* (un)lock critical section in CO_errorReport() or CO_errorReset() */
+#define CO_LOCK_EMCY(CAN_MODULE)
+#define CO_UNLOCK_EMCY(CAN_MODULE)
+
+/* (un)lock critical section when accessing Object Dictionary */
+#define CO_LOCK_OD(CAN_MODULE)
+#define CO_UNLOCK_OD(CAN_MODULE)
+
+/* Synchronization between CAN receive and message processing threads. */
+#define CO_MemoryBarrier()
+#define CO_FLAG_READ(rxNew) ((rxNew) != NULL)
+#define CO_FLAG_SET(rxNew) {CO_MemoryBarrier(); rxNew = (void*)1L;}
+#define CO_FLAG_CLEAR(rxNew) {CO_MemoryBarrier(); rxNew = NULL;}
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_DRIVER_TARGET_H */
@@ -0,0 +1,118 @@
+/*
+ * Simulation of many CANopen devices on loopback CAN bus
+ *
+ * @file        CO_sim.c
+ * @ingroup     CO_sim
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "CO_sim.h"
+
+
+/******************************************************************************/
+void CO_sim_init(CO_sim_t *sim,
+                 CO_loopback_t *bus,
+                 CO_simNode_t *nodes,
+                 uint16_t nodesMax)
+{
+    if (sim == NULL) {
+        return;
+    }
+    memset(sim, 0, sizeof(*sim));
+    sim->bus = bus;
+    sim->nodes = nodes;
+    sim->nodesMax = nodes != NULL ? nodesMax : 0;
+}
+
+
+/******************************************************************************/
+CO_simNode_t *CO_sim_addNode(CO_sim_t *sim, CO_t *co) {
+    CO_simNode_t *node;
+
+    if (sim == NULL || co == NULL || sim->nodeCount >= sim->nodesMax) {
+        return NULL;
+    }
+    node = &sim->nodes[sim->nodeCount];
+    if (CO_eventLoop_init(&node->el, NULL, NULL) != CO_ERROR_NO) {
+        return NULL;
+    }
+    sim->nodeCount++;
+
+    node->co = co;
+    node->due_us = sim->time_us;
+    node->last_us = sim->time_us;
+    node->reset = CO_RESET_NOT;
+    CO_eventLoop_initCANopen(&node->el, co);
+    return node;
+}
+
+
+/******************************************************************************/
+CO_simNode_t *CO_sim_run(CO_sim_t *sim, uint64_t duration_us) {
+    uint64_t end_us;
+
+    if (sim == NULL || sim->bus == NULL) {
+        return NULL;
+    }
+    end_us = sim->time_us + duration_us;
+
+    for (;;) {
+        uint64_t next_us = end_us;
+
+        for (uint16_t i = 0; i < sim->nodeCount; i++) {
+            CO_simNode_t *node = &sim->nodes[i];
+
+            if (node->el.signaled || node->due_us <= sim->time_us) {
+                uint32_t timerNext_us;
+
+                node->el.timeDifference_us +=
+                    (uint32_t)(sim->time_us - node->last_us);
+                node->last_us = sim->time_us;
+                node->reset = CO_eventLoop_process(&node->el, node->co, false);
+                sim->processed++;
+
+                /* Without new message repeat processing at least 1 us later,
+                 * so simulated time always advances. */
+                timerNext_us = node->el.timerNext_us;
+                node->due_us = sim->time_us
+                               + (timerNext_us > 0U ? timerNext_us : 1U);
+                if (node->reset != CO_RESET_NOT) {
+                    (void)CO_loopback_deliver(sim->bus);
+                    return node;
+                }
+            }
+            if (node->due_us < next_us) {
+                next_us = node->due_us;
+            }
+        }
+
+        /* received messages signal devices at the same simulated time */
+        if (CO_loopback_deliver(sim->bus) > 0U) {
+            continue;
+        }
+        if (next_us >= end_us) {
+            sim->time_us = end_us;
+            return NULL;
+        }
+        sim->time_us = next_us;
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * Simulation of many CANopen devices on loopback CAN bus
+ *
+ * @file        CO_sim.h
+ * @ingroup     CO_sim
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SIM_H
+#define CO_SIM_H
+
+#include "CANopen.h"
+#include "extra/CO_eventLoop.h"
+#include "CO_driver_loopback.h"
+
+#if !((CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE)
+#error CO_sim requires CO_CONFIG_EVLOOP_ENABLE
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_sim Simulation
+ * Discrete event scheduler for many CANopen devices inside one process.
+ *
+ * @ingroup CO_driver_loopback
+ * @{
+ *
+ * Each simulated device has own CO_t and own @ref CO_eventLoop_t, all are
+ * connected to the same @ref CO_loopback_t. CO_sim_run() processes only
+ * devices, which have a deadline (_timerNext_us_) at the current simulated
+ * time or which received a message. Then simulated time jumps directly to the
+ * earliest deadline of all devices. Idle device, which only produces
+ * heartbeat, is processed once per heartbeat period, so simulated network size
+ * is limited by CPU time of real events and not by the number of devices.
+ *
+ * Simulated time does not depend on host time. Messages are delivered
+ * immediately, at the same simulated time, they were sent.
+ *
+ * Devices may share the same constant Object Dictionary, see
+ * @ref OD_instance_init(). Processing functions should report _timerNext_us_,
+ * so CO_CONFIG_GLOBAL_FLAG_TIMERNEXT and CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE
+ * should be enabled. Device without deadline is processed at least each
+ * CO_CONFIG_EVLOOP_MAX_SLEEP_US.
+ */
+
+
+/**
+ * Simulated device
+ */
+typedef struct {
+    /** CANopen object, from CO_sim_addNode() */
+    CO_t *co;
+    /** Event loop of the device, signaled by its CANopen objects */
+    CO_eventLoop_t el;
+    /** Simulated time of the next processing in microseconds */
+    uint64_t due_us;
+    /** Simulated time of the previous processing in microseconds */
+    uint64_t last_us;
+    /** Reset command from the last processing */
+    CO_NMT_reset_cmd_t reset;
+} CO_simNode_t;
+
+/**
+ * Simulation object
+ */
+typedef struct {
+    /** Loopback bus, from CO_sim_init() */
+    CO_loopback_t *bus;
+    /** Devices, from CO_sim_init() */
+    CO_simNode_t *nodes;
+    uint16_t nodesMax;        /**< Size of nodes array */
+    uint16_t nodeCount;       /**< Number of added devices */
+    uint64_t time_us;         /**< Current simulated time in microseconds */
+    uint64_t processed;       /**< Number of processings of all devices */
+} CO_sim_t;
+
+
+/**
+ * Initialize simulation, no devices are added.
+ *
+ * @param sim This object will be initialized.
+ * @param bus Loopback bus, which connects devices, initialized.
+ * @param nodes Array of devices, must stay valid.
+ * @param nodesMax Size of nodes array.
+ */
+void CO_sim_init(CO_sim_t *sim,
+                 CO_loopback_t *bus,
+                 CO_simNode_t *nodes,
+                 uint16_t nodesMax);
+
+
+/**
+ * Add device to simulation.
+ *
+ * Function must be called after CO_CANopenInit() and CO_CANopenInitPDO(). It
+ * configures callbacks of CANopen objects with CO_eventLoop_initCANopen().
+ * After communication reset of the device, CO_eventLoop_initCANopen() must be
+ * called again with _el_ of the device.
+ *
+ * @param sim This object.
+ * @param co Initialized CANopen object.
+ *
+ * @return Added device or NULL, if nodes array is full.
+ */
+CO_simNode_t *CO_sim_addNode(CO_sim_t *sim, CO_t *co);
+
+
+/**
+ * Run simulation.
+ *
+ * Function processes devices and delivers messages until simulated time is
+ * advanced by duration_us or until some device requests reset.
+ *
+ * @param sim This object.
+ * @param duration_us Simulated time in microseconds.
+ *
+ * @return Device, which requested reset (see CO_simNode_t::reset), or NULL.
+ * Simulation may continue with the next call.
+ */
+CO_simNode_t *CO_sim_run(CO_sim_t *sim, uint64_t duration_us);
+
+/** @} */ /* CO_sim */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_SIM_H */
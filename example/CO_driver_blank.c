@@ -27,6 +27,9 @@
 
 
 #include "301/CO_driver.h"
+#include "301/CO_stats.h"
+#include "301/CO_CANfilter.h"
+#include "301/CO_autobaud.h"
 
 
 /******************************************************************************/
@@ -35,8 +38,62 @@ void CO_CANsetConfigurationMode(void *CANptr){
 }
 
 
+/******************************************************************************/
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+/* Plan hardware filters for all configured rxArray buffers and program them.
+ *
+ * Filters in list mode occupy the first banks, filters in mask mode the rest.
+ * Unused entries of the last bank in each mode repeat the last filter.
+ * Hardware assigns filter match index (FMI) to each entry in order of banks,
+ * so rxFilterMap is filled in the same order. */
+static void CO_CANrxFilterApply(CO_CANmodule_t *CANmodule){
+    static const CO_CANfilterHw_t hw = {
+        CO_CAN_RX_FILTER_BANKS, CO_CAN_RX_FILTER_LIST, CO_CAN_RX_FILTER_MASK
+    };
+    CO_CANfilter_t filters[CO_CAN_RX_FILTER_WORK];
+    uint16_t count, listCount;
+    uint16_t i, entry = 0U, fmi = 0U;
+
+    count = CO_CANfilter_plan(filters, CO_CAN_RX_FILTER_WORK,
+                              CANmodule->rxArray, CANmodule->rxSize,
+                              &hw, &listCount);
+
+    /* Deactivate all filter banks here */
+
+    for(i = 0U; i < count; i++){
+        bool_t list = i < listCount;
+        uint16_t perBank = list ? CO_CAN_RX_FILTER_LIST : CO_CAN_RX_FILTER_MASK;
+        bool_t lastInMode = (i + 1U) == (list ? listCount : count);
+
+        /* Write filters[i].ident (and filters[i].mask in mask mode) into the
+         * entry of the current bank here */
+        CANmodule->rxFilterMap[fmi++] = filters[i].rxIndex;
+        entry++;
+
+        /* fill unused entries of the last bank with the same filter */
+        while(lastInMode && entry < perBank){
+            /* Write filters[i] again here */
+            CANmodule->rxFilterMap[fmi++] = filters[i].rxIndex;
+            entry++;
+        }
+        if(entry == perBank){
+            /* Activate bank in list or mask mode, 16-bit scale, here */
+            entry = 0U;
+        }
+    }
+    while(fmi < CO_CAN_RX_FILTER_FMI_COUNT){
+        CANmodule->rxFilterMap[fmi++] = CO_CAN_FILTER_SOFTWARE;
+    }
+}
+#endif
+
+
 /******************************************************************************/
 void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+    CO_CANrxFilterApply(CANmodule);
+#endif
+
     /* Put CAN module in normal mode */
 
     CANmodule->CANnormal = true;
@@ -59,6 +116,11 @@ CO_ReturnError_t CO_CANmodule_init(
     if(CANmodule==NULL || rxArray==NULL || txArray==NULL){
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
+#ifdef CO_DRIVER_TX_QUEUE
+    if(txSize > CO_CAN_TX_QUEUE_SIZE){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+#endif
 
     /* Configure object variables */
     CANmodule->CANptr = CANptr;
@@ -68,7 +130,12 @@ CO_ReturnError_t CO_CANmodule_init(
     CANmodule->txSize = txSize;
     CANmodule->CANerrorStatus = 0;
     CANmodule->CANnormal = false;
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+    /* filters are planned for any number of buffers */
+    CANmodule->useCANrxFilters = true;
+#else
     CANmodule->useCANrxFilters = (rxSize <= 32U) ? true : false;/* microcontroller dependent */
+#endif
     CANmodule->bufferInhibitFlag = false;
     CANmodule->firstCANtxMessage = true;
     CANmodule->CANtxCount = 0U;
@@ -80,9 +147,27 @@ CO_ReturnError_t CO_CANmodule_init(
         rxArray[i].object = NULL;
         rxArray[i].CANrx_callback = NULL;
     }
+#ifdef CO_DRIVER_RX_LOOKUP
+    memset(CANmodule->rxLookup, 0, sizeof(CANmodule->rxLookup));
+#endif
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+    for(i=0U; i<CO_CAN_RX_FILTER_FMI_COUNT; i++){
+        CANmodule->rxFilterMap[i] = CO_CAN_FILTER_SOFTWARE;
+    }
+#endif
+#ifdef CO_DRIVER_RX_RING
+    CANmodule->rxRingWr = 0U;
+    CANmodule->rxRingRd = 0U;
+#endif
+#ifdef CO_DRIVER_STATS
+    CANmodule->stats = NULL;
+#endif
     for(i=0U; i<txSize; i++){
         txArray[i].bufferFull = false;
     }
+#ifdef CO_DRIVER_TX_QUEUE
+    CO_CANtxQueue_init(&CANmodule->txQueue);
+#endif
 
 
     /* Configure CAN module registers */
@@ -120,6 +205,52 @@ void CO_CANmodule_disable(CO_CANmodule_t *CANmodule) {
 }
 
 
+/******************************************************************************/
+#ifdef CO_DRIVER_RX_LOOKUP
+/* Update rxLookup table after rxArray[index] was (re)configured.
+ *
+ * Each entry in the table holds (index + 1) of the buffer with the lowest
+ * index, which accepts that CAN-ID (RTR bit is ignored), or 0 if none. Entries
+ * of the previous configuration of the buffer are released to the next
+ * matching buffer. Masked identifiers are expanded to all accepted CAN-IDs.
+ * Function is called from CO_CANrxBufferInit() only, so time spent here does
+ * not affect CAN receive interrupt. */
+static void CO_CANrxLookupUpdate(CO_CANmodule_t *CANmodule, uint16_t index) {
+    CO_CANrx_t *rxArray = CANmodule->rxArray;
+    CO_CANrx_t *buffer = &rxArray[index];
+    uint16_t entryThis = index + 1U;
+    uint16_t id;
+
+    for(id = 0U; id < CO_CAN_RX_LOOKUP_SIZE; id++){
+        uint16_t entry = CANmodule->rxLookup[id];
+        bool_t match = (buffer->CANrx_callback != NULL)
+                    && (((id ^ buffer->ident) & buffer->mask & 0x07FFU) == 0U);
+
+        if(match){
+            if(entry == 0U || entry > entryThis){
+                CANmodule->rxLookup[id] = entryThis;
+            }
+        }
+        else if(entry == entryThis){
+            /* release the entry, buffers with lower index don't match */
+            uint16_t i;
+            CANmodule->rxLookup[id] = 0U;
+            for(i = entryThis; i < CANmodule->rxSize; i++){
+                CO_CANrx_t *b = &rxArray[i];
+                if((b->CANrx_callback != NULL)
+                   && (((id ^ b->ident) & b->mask & 0x07FFU) == 0U)
+                ){
+                    CANmodule->rxLookup[id] = i + 1U;
+                    break;
+                }
+            }
+        }
+        else { /* MISRA C 2004 14.10 */ }
+    }
+}
+#endif
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_CANrxBufferInit(
         CO_CANmodule_t         *CANmodule,
@@ -147,9 +278,19 @@ CO_ReturnError_t CO_CANrxBufferInit(
         }
         buffer->mask = (mask & 0x07FFU) | 0x0800U;
 
+#ifdef CO_DRIVER_RX_LOOKUP
+        CO_CANrxLookupUpdate(CANmodule, index);
+#endif
+
         /* Set CAN hardware module filter and mask. */
         if(CANmodule->useCANrxFilters){
-
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+            /* Filters are planned for all buffers together. Plan them again,
+             * if buffer is reconfigured in normal mode, for example by PDO. */
+            if(CANmodule->CANnormal){
+                CO_CANrxFilterApply(CANmodule);
+            }
+#endif
         }
     }
     else{
@@ -178,7 +319,7 @@ CO_CANtx_t *CO_CANtxBufferInit(
         /* CAN identifier, DLC and rtr, bit aligned with CAN module transmit buffer.
          * Microcontroller specific. */
         buffer->ident = ((uint32_t)ident & 0x07FFU)
-                      | ((uint32_t)(((uint32_t)noOfBytes & 0xFU) << 11U))
+                      | ((uint32_t)CO_CANlengthToDlc(noOfBytes) << 11U)
                       | ((uint32_t)(rtr ? 0x8000U : 0U));
 
         buffer->bufferFull = false;
@@ -203,15 +344,25 @@ CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
     }
 
     CO_LOCK_CAN_SEND(CANmodule);
-    /* if CAN TX buffer is free, copy message to it */
-    if(1 && CANmodule->CANtxCount == 0){
+    /* if CAN TX buffer is free, copy message to it. Waiting messages held
+     * back by transmit limiter do not delay real-time messages. */
+    if(1 /* transmit mailbox free */
+       && (CANmodule->CANtxCount == 0 || CO_STATS_CAN_TX_HOLDING(CANmodule))
+       && CO_STATS_CAN_TX_ALLOWED(CANmodule, buffer->ident)
+    ){
         CANmodule->bufferInhibitFlag = buffer->syncFlag;
+        CO_STATS_CAN_FRAME(CANmodule, buffer->ident,
+                           CO_CANdlcToLength((uint8_t)(buffer->ident >> 11U) & 0xFU));
         /* copy message and txRequest */
     }
     /* if no buffer is free, message will be sent by interrupt */
     else{
         buffer->bufferFull = true;
         CANmodule->CANtxCount++;
+#ifdef CO_DRIVER_TX_QUEUE
+        CO_CANtxQueue_push(&CANmodule->txQueue,
+                           (uint16_t)(buffer - CANmodule->txArray));
+#endif
     }
     CO_UNLOCK_CAN_SEND(CANmodule);
 
@@ -240,6 +391,10 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
                 if(buffer->syncFlag){
                     buffer->bufferFull = false;
                     CANmodule->CANtxCount--;
+#ifdef CO_DRIVER_TX_QUEUE
+                    CO_CANtxQueue_remove(&CANmodule->txQueue,
+                            (uint16_t)(buffer - CANmodule->txArray));
+#endif
                     tpdoDeleted = 2U;
                 }
             }
@@ -255,6 +410,88 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
 }
 
 
+/******************************************************************************/
+/* Copy waiting messages from transmit buffers to free CAN module mailboxes.
+ * Messages held back by transmit limiter stay in buffers. Function is called
+ * from transmit interrupt and from CO_CANmodule_process(). */
+static void CO_CANtxNext(CO_CANmodule_t *CANmodule){
+#ifdef CO_DRIVER_TX_QUEUE
+    CO_CANtxQueue_t held;
+
+    CO_CANtxQueue_init(&held);
+
+    /* Fill all free transmit mailboxes of the CAN module, highest */
+    /* priority (lowest txArray index) first. */
+    while(1 /* transmit mailbox free */
+          && !CO_CANtxQueue_isEmpty(&CANmodule->txQueue))
+    {
+        uint16_t i = CO_CANtxQueue_pop(&CANmodule->txQueue);
+        CO_CANtx_t *buffer = &CANmodule->txArray[i];
+
+        if(!CO_STATS_CAN_TX_ALLOWED(CANmodule, buffer->ident)){
+            CO_CANtxQueue_push(&held, i);
+            continue;
+        }
+        buffer->bufferFull = false;
+        CANmodule->CANtxCount--;
+
+        /* Copy message to CAN buffer. Inhibit flag stays set, if any */
+        /* of the messages in mailboxes is synchronous TPDO. */
+        if(buffer->syncFlag){
+            CANmodule->bufferInhibitFlag = true;
+        }
+        CO_STATS_CAN_FRAME(CANmodule, buffer->ident,
+                           CO_CANdlcToLength((uint8_t)(buffer->ident >> 11U) & 0xFU));
+        /* canSend... */
+    }
+
+    /* return held messages to the queue */
+    while(!CO_CANtxQueue_isEmpty(&held)){
+        CO_CANtxQueue_push(&CANmodule->txQueue, CO_CANtxQueue_pop(&held));
+    }
+#else
+    /* Are there any new messages waiting to be send */
+    if(CANmodule->CANtxCount > 0U){
+        uint16_t i;             /* index of transmitting message */
+
+        /* first buffer */
+        CO_CANtx_t *buffer = &CANmodule->txArray[0];
+        /* search through whole array of pointers to transmit message buffers. */
+        for(i = CANmodule->txSize; i > 0U; i--){
+            /* if message buffer is full, send it. */
+            if(buffer->bufferFull
+               && CO_STATS_CAN_TX_ALLOWED(CANmodule, buffer->ident)
+            ){
+                buffer->bufferFull = false;
+                CANmodule->CANtxCount--;
+
+                /* Copy message to CAN buffer */
+                CANmodule->bufferInhibitFlag = buffer->syncFlag;
+                CO_STATS_CAN_FRAME(CANmodule, buffer->ident,
+                                   CO_CANdlcToLength((uint8_t)(buffer->ident >> 11U) & 0xFU));
+                /* canSend... */
+                break;                      /* exit for loop */
+            }
+            buffer++;
+        }/* end of for loop */
+
+        /* Clear counter if no more messages */
+        if(i == 0U && CANmodule->CANtxCount > 0U){
+            uint16_t pending = 0U;
+            buffer = &CANmodule->txArray[0];
+            for(i = CANmodule->txSize; i > 0U; i--){
+                if(buffer->bufferFull){
+                    pending++;
+                }
+                buffer++;
+            }
+            CANmodule->CANtxCount = pending;
+        }
+    }
+#endif /* CO_DRIVER_TX_QUEUE */
+}
+
+
 /******************************************************************************/
 /* Get error counters from the module. If necessary, function may use
     * different way to determine errors. */
@@ -266,6 +503,8 @@ void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
     err = ((uint32_t)txErrors << 16) | ((uint32_t)rxErrors << 8) | overflow;
 
     if (CANmodule->errOld != err) {
+        /* CANerrorStatus is also modified by CO_CANsend() */
+        CO_LOCK_CAN_SEND(CANmodule);
         uint16_t status = CANmodule->CANerrorStatus;
 
         CANmodule->errOld = err;
@@ -306,22 +545,111 @@ void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
         }
 
         CANmodule->CANerrorStatus = status;
+        CO_UNLOCK_CAN_SEND(CANmodule);
+    }
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_TX_LIMIT) && defined CO_DRIVER_STATS
+    /* Messages held back by transmit limiter are not sent from interrupt, if
+     * CAN module is idle. Start transmission here. */
+    if(CANmodule->CANtxCount > 0U && 1 /* all transmit mailboxes free */){
+        CO_LOCK_CAN_SEND(CANmodule);
+        CO_CANtxNext(CANmodule);
+        CO_UNLOCK_CAN_SEND(CANmodule);
     }
+#endif
 }
 
 
 /******************************************************************************/
-typedef struct {
-    uint32_t ident;
-    uint8_t DLC;
-    uint8_t data[8];
-} CO_CANrxMsg_t;
+/* Find receive buffer for the message with rcvMsgIdent by software. Returns
+ * NULL, if no CO_CANrx_t buffer accepts the message. */
+static CO_CANrx_t *CO_CANrxFind(CO_CANmodule_t *CANmodule, uint32_t rcvMsgIdent){
+    CO_CANrx_t *buffer;
+    uint16_t index;
+
+#ifdef CO_DRIVER_RX_LOOKUP
+    /* Get buffer directly from the lookup table. Table ignores RTR */
+    /* bit, so search rxArray only in case of (rare) RTR mismatch. */
+    index = CANmodule->rxLookup[rcvMsgIdent & 0x07FFU];
+    if(index == 0U){
+        return NULL;
+    }
+    buffer = &CANmodule->rxArray[index - 1U];
+    if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
+        return buffer;
+    }
+#endif
+
+    /* Search rxArray form CANmodule for the same CAN-ID. */
+    buffer = &CANmodule->rxArray[0];
+    for(index = CANmodule->rxSize; index > 0U; index--){
+        if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
+            return buffer;
+        }
+        buffer++;
+    }
+
+    return NULL;
+}
+
+
+#ifdef CO_DRIVER_RX_RING
+/******************************************************************************/
+uint16_t CO_CANmodule_processRx(CO_CANmodule_t *CANmodule){
+    uint16_t count = 0U;
+    uint16_t rd = CANmodule->rxRingRd;
+    uint16_t wr = CANmodule->rxRingWr;
+
+    /* Process all messages, which were in the ring at the time of the call. */
+    while(rd != wr){
+        CO_CANrxMsg_t *rcvMsg = &CANmodule->rxRing[rd];
+        CO_CANrx_t *buffer;
+
+        CO_MemoryBarrier();
+        buffer = CO_CANrxFind(CANmodule, rcvMsg->ident);
+        if((buffer != NULL) && (buffer->CANrx_callback != NULL)){
+            CO_STATS_CAN_RX_BEGIN();
+            buffer->CANrx_callback(buffer->object, (void*) rcvMsg);
+            CO_STATS_CAN_RX_END(CANmodule);
+        }
+
+        /* release the slot to the CAN receive interrupt */
+        rd = (rd + 1U) & (CO_CAN_RX_RING_SIZE - 1U);
+        CO_MemoryBarrier();
+        CANmodule->rxRingRd = rd;
+        count++;
+    }
 
+    return count;
+}
+#endif
+
+
+/******************************************************************************/
 void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
 
     /* receive interrupt */
     if(1){
         CO_CANrxMsg_t *rcvMsg;      /* pointer to received message in CAN module */
+#ifdef CO_DRIVER_RX_RING
+        uint16_t wr = CANmodule->rxRingWr;
+        uint16_t wrNext = (wr + 1U) & (CO_CAN_RX_RING_SIZE - 1U);
+
+        rcvMsg = 0; /* get message from module here */
+        CO_STATS_CAN_FRAME(CANmodule, CO_CANrxMsg_readIdent(rcvMsg),
+                           CO_CANrxMsg_readDLC(rcvMsg));
+
+        /* Only copy the message into the ring, it will be processed by */
+        /* CO_CANmodule_processRx(). Drain whole hardware FIFO here, if any. */
+        if(wrNext != CANmodule->rxRingRd){
+            memcpy(&CANmodule->rxRing[wr], rcvMsg, sizeof(CO_CANrxMsg_t));
+            CO_MemoryBarrier();
+            CANmodule->rxRingWr = wrNext;
+        }
+        else{
+            CANmodule->CANerrorStatus |= CO_CAN_ERRRX_OVERFLOW;
+        }
+#else
         uint16_t index;             /* index of received message */
         uint32_t rcvMsgIdent;       /* identifier of the received message */
         CO_CANrx_t *buffer = NULL;  /* receive message buffer from CO_CANmodule_t object. */
@@ -329,10 +657,23 @@ void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
 
         rcvMsg = 0; /* get message from module here */
         rcvMsgIdent = rcvMsg->ident;
+        CO_STATS_CAN_FRAME(CANmodule, rcvMsgIdent,
+                           CO_CANrxMsg_readDLC(rcvMsg));
         if(CANmodule->useCANrxFilters){
             /* CAN module filters are used. Message with known 11-bit identifier has */
             /* been received */
             index = 0;  /* get index of the received message here. Or something similar */
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+            /* index is filter match index, translate it to rxArray index */
+            index = (index < CO_CAN_RX_FILTER_FMI_COUNT)
+                  ? CANmodule->rxFilterMap[index] : CO_CAN_FILTER_SOFTWARE;
+            if(index == CO_CAN_FILTER_SOFTWARE){
+                /* merged filter, find the buffer by software */
+                buffer = CO_CANrxFind(CANmodule, rcvMsgIdent);
+                msgMatched = buffer != NULL;
+            }
+            else
+#endif
             if(index < CANmodule->rxSize){
                 buffer = &CANmodule->rxArray[index];
                 /* verify also RTR */
@@ -343,21 +684,18 @@ void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
         }
         else{
             /* CAN module filters are not used, message with any standard 11-bit identifier */
-            /* has been received. Search rxArray form CANmodule for the same CAN-ID. */
-            buffer = &CANmodule->rxArray[0];
-            for(index = CANmodule->rxSize; index > 0U; index--){
-                if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
-                    msgMatched = true;
-                    break;
-                }
-                buffer++;
-            }
+            /* has been received. Find the buffer by software. */
+            buffer = CO_CANrxFind(CANmodule, rcvMsgIdent);
+            msgMatched = buffer != NULL;
         }
 
         /* Call specific function, which will process the message */
         if(msgMatched && (buffer != NULL) && (buffer->CANrx_callback != NULL)){
+            CO_STATS_CAN_RX_BEGIN();
             buffer->CANrx_callback(buffer->object, (void*) rcvMsg);
+            CO_STATS_CAN_RX_END(CANmodule);
         }
+#endif /* CO_DRIVER_RX_RING */
 
         /* Clear interrupt flag */
     }
@@ -371,34 +709,40 @@ void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
         CANmodule->firstCANtxMessage = false;
         /* clear flag from previous message */
         CANmodule->bufferInhibitFlag = false;
-        /* Are there any new messages waiting to be send */
-        if(CANmodule->CANtxCount > 0U){
-            uint16_t i;             /* index of transmitting message */
-
-            /* first buffer */
-            CO_CANtx_t *buffer = &CANmodule->txArray[0];
-            /* search through whole array of pointers to transmit message buffers. */
-            for(i = CANmodule->txSize; i > 0U; i--){
-                /* if message buffer is full, send it. */
-                if(buffer->bufferFull){
-                    buffer->bufferFull = false;
-                    CANmodule->CANtxCount--;
-
-                    /* Copy message to CAN buffer */
-                    CANmodule->bufferInhibitFlag = buffer->syncFlag;
-                    /* canSend... */
-                    break;                      /* exit for loop */
-                }
-                buffer++;
-            }/* end of for loop */
-
-            /* Clear counter if no more messages */
-            if(i == 0U){
-                CANmodule->CANtxCount = 0U;
-            }
-        }
+        CO_CANtxNext(CANmodule);
     }
     else{
         /* some other interrupt reason */
     }
 }
+
+
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE
+/******************************************************************************/
+bool_t CO_autobaud_listen(void *CANptr, uint16_t bitRate){
+    /* Put CAN module in configuration mode, configure bit timing for bitRate,
+     * enable silent (listen-only) mode and clear error and receive flags */
+    (void)CANptr; (void)bitRate;
+    return true;
+}
+
+
+/******************************************************************************/
+CO_autobaud_event_t CO_autobaud_event(void *CANptr){
+    /* Read error flags (stuff, form, CRC, bit) and receive flag of the CAN
+     * module. Received message is discarded. */
+    (void)CANptr;
+    return CO_AUTOBAUD_EV_NONE;
+}
+
+
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_MEASURE
+/******************************************************************************/
+uint32_t CO_autobaud_bitTime_ns(void *CANptr){
+    /* Return the shortest time between edges on CAN RX pin, measured for
+     * example with timer input capture */
+    (void)CANptr;
+    return 0;
+}
+#endif
+#endif /* (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE */
@@ -63,6 +63,50 @@ typedef double                  float64_t;
 #define CO_CANrxMsg_readIdent(msg) ((uint16_t)0)
 #define CO_CANrxMsg_readDLC(msg)   ((uint8_t)0)
 #define CO_CANrxMsg_readData(msg)  ((uint8_t *)NULL)
+#define CO_CANrxMsg_readTimestamp(msg) ((uint32_t)0)
+#define CO_localTime_us() ((uint32_t)0)
+#define CO_cycleCounter() ((uint32_t)0)
+
+/* Received CAN message, as copied from CAN module */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[CO_CAN_DATA_MAX];
+} CO_CANrxMsg_t;
+
+/* Optional receive ring between CAN receive interrupt and the thread, which
+ * calls CO_CANmodule_processRx(). Interrupt only copies received messages into
+ * the ring, CANrx_callback functions are called from CO_CANmodule_processRx().
+ * Size must be power of 2. */
+#ifdef CO_DRIVER_RX_RING
+#ifndef CO_CAN_RX_RING_SIZE
+#define CO_CAN_RX_RING_SIZE 64
+#endif
+#endif
+
+/* Optional direct lookup table for received CAN identifiers, used by
+ * CO_CANinterrupt(), if CAN module hardware filters are not used. It replaces
+ * linear search through rxArray and costs 4kB of RAM (2048 * uint16_t). */
+#ifdef CO_DRIVER_RX_LOOKUP
+#define CO_CAN_RX_LOOKUP_SIZE 0x800
+#endif
+
+/* Optional planner for hardware acceptance filters, see CO_CANfilter.h. Values
+ * below are for bxCAN with 16-bit filter scale: 14 banks, each with 4 exact
+ * identifiers (list mode) or 2 identifier/mask pairs (mask mode). Each
+ * identifier has own filter match index (FMI). Planner work array takes 6
+ * bytes of stack for each filter in CO_CAN_RX_FILTER_WORK. */
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+#ifndef CO_CAN_RX_FILTER_BANKS
+#define CO_CAN_RX_FILTER_BANKS 14
+#define CO_CAN_RX_FILTER_LIST 4
+#define CO_CAN_RX_FILTER_MASK 2
+#endif
+#ifndef CO_CAN_RX_FILTER_WORK
+#define CO_CAN_RX_FILTER_WORK 64
+#endif
+#define CO_CAN_RX_FILTER_FMI_COUNT (CO_CAN_RX_FILTER_BANKS * 4)
+#endif
 
 /* Received message object */
 typedef struct {
@@ -76,7 +120,7 @@ typedef struct {
 typedef struct {
     uint32_t ident;
     uint8_t DLC;
-    uint8_t data[8];
+    uint8_t data[CO_CAN_DATA_MAX];
     volatile bool_t bufferFull;
     volatile bool_t syncFlag;
 } CO_CANtx_t;
@@ -95,6 +139,28 @@ typedef struct {
     volatile bool_t firstCANtxMessage;
     volatile uint16_t CANtxCount;
     uint32_t errOld;
+#ifdef CO_DRIVER_RX_LOOKUP
+    uint16_t rxLookup[CO_CAN_RX_LOOKUP_SIZE];
+#endif
+#ifdef CO_DRIVER_RX_FILTER_PLAN
+    /* Index of rxArray buffer for each hardware filter match index, or
+     * CO_CAN_FILTER_SOFTWARE, set by CO_CANrxFilterApply() */
+    uint16_t rxFilterMap[CO_CAN_RX_FILTER_FMI_COUNT];
+#endif
+#ifdef CO_DRIVER_TX_QUEUE
+    /* Pending transmit buffers (see CO_driver.h), replaces search for
+     * bufferFull through txArray inside CAN transmit interrupt */
+    CO_CANtxQueue_t txQueue;
+#endif
+#ifdef CO_DRIVER_RX_RING
+    CO_CANrxMsg_t rxRing[CO_CAN_RX_RING_SIZE];
+    volatile uint16_t rxRingWr;
+    volatile uint16_t rxRingRd;
+#endif
+#ifdef CO_DRIVER_STATS
+    /* Statistics object, set by CO_stats_init() */
+    void *stats;
+#endif
 } CO_CANmodule_t;
 
 
@@ -109,7 +175,8 @@ typedef struct {
 } CO_storage_entry_t;
 
 
-/* (un)lock critical section in CO_CANsend() */
+/* (un)lock critical section in CO_CANsend(). CAN_MODULE may be used to lock
+ * only own CAN module, for example with CO_SEPARATE_RT_CAN. */
 #define CO_LOCK_CAN_SEND(CAN_MODULE)
 #define CO_UNLOCK_CAN_SEND(CAN_MODULE)
 
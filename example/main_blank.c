@@ -30,6 +30,8 @@
 #include "CANopen.h"
 #include "OD.h"
 #include "CO_storageBlank.h"
+#include "extra/CO_eventLoop.h"
+#include "301/CO_autobaud.h"
 
 
 #define log_printf(macropar_message, ...) \
@@ -52,6 +54,9 @@
 /* Global variables and objects */
 CO_t *CO = NULL; /* CANopen object */
 uint8_t LED_red, LED_green;
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE
+CO_eventLoop_t eventLoop; /* tickless processing, tmrTask_thread not used */
+#endif
 
 
 /* main ***********************************************************************/
@@ -81,6 +86,14 @@ int main (void){
 
     /* Configure microcontroller. */
 
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE
+    /* On RTOS pass function, which notifies this task, instead of NULL. It
+     * may be called from CAN interrupt. */
+    if (CO_eventLoop_init(&eventLoop, NULL, NULL) != CO_ERROR_NO) {
+        log_printf("Error: Event loop initialization failed\n");
+        return 0;
+    }
+#endif
 
     /* Allocate memory */
     CO_config_t *config_ptr = NULL;
@@ -129,6 +142,31 @@ int main (void){
         CO_CANsetConfigurationMode((void *)&CANptr);
         CO_CANmodule_disable(CO->CANmodule);
 
+#if (CO_CONFIG_AUTOBAUD) & CO_CONFIG_AUTOBAUD_ENABLE
+        /* bit rate 0 (CO_LSS_BIT_TIMING_AUTO from LSS) - detect it */
+        if (pendingBitRate == 0) {
+            CO_autobaud_t autobaud;
+            CO_autobaud_return_t ret;
+
+            err = CO_autobaud_init(&autobaud, CANptr, 125, 100000, 5000000);
+            if (err != CO_ERROR_NO) {
+                log_printf("Error: Bit rate detection failed: %d\n", err);
+                return 0;
+            }
+            do {
+                /* get time difference since last call and sleep */
+                ret = CO_autobaud_process(&autobaud, 1000, NULL);
+            } while (ret == CO_AUTOBAUD_WAIT);
+            if (ret == CO_AUTOBAUD_ERROR) {
+                log_printf("Error: Bit rate detection failed\n");
+                return 0;
+            }
+            log_printf("CANopenNode - Bit rate %u kbit/s %s\n", autobaud.bitRate,
+                       ret == CO_AUTOBAUD_FOUND ? "detected" : "(timeout)");
+            pendingBitRate = autobaud.bitRate;
+        }
+#endif
+
         /* initialize CANopen */
         err = CO_CANinit(CO, CANptr, pendingBitRate);
         if (err != CO_ERROR_NO) {
@@ -191,6 +229,9 @@ int main (void){
 
 
         /* Configure CANopen callbacks, etc */
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE
+        CO_eventLoop_initCANopen(&eventLoop, CO);
+#endif
         if(!CO->nodeIdUnconfigured) {
 
 #if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
@@ -207,6 +248,9 @@ int main (void){
 
         /* start CAN */
         CO_CANsetNormalMode(CO->CANmodule);
+#ifdef CO_SEPARATE_RT_CAN
+        CO_CANsetNormalMode(CO->CANmoduleRT);
+#endif
 
         reset = CO_RESET_NOT;
 
@@ -215,11 +259,22 @@ int main (void){
 
         while(reset == CO_RESET_NOT){
 /* loop for normal program execution ******************************************/
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE
+            /* sleep for eventLoop.timerNext_us or until signaled, add elapsed
+             * time to eventLoop.timeDifference_us */
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+            CO_eventLoop_wait(&eventLoop);
+#endif
+
+            /* CANopen process, including real-time objects */
+            reset = CO_eventLoop_process(&eventLoop, CO, false);
+#else
             /* get time difference since last function call */
             uint32_t timeDifference_us = 500;
 
             /* CANopen process */
             reset = CO_process(CO, false, timeDifference_us, NULL);
+#endif
             LED_red = CO_LED_RED(CO->LEDs, CO_LED_CANopen);
             LED_green = CO_LED_GREEN(CO->LEDs, CO_LED_CANopen);
 
@@ -239,6 +294,9 @@ int main (void){
     /* delete objects from memory */
     CO_CANsetConfigurationMode((void *)&CANptr);
     CO_delete(CO);
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE
+    CO_eventLoop_close(&eventLoop);
+#endif
 
     log_printf("CANopenNode finished\n");
 
@@ -257,6 +315,10 @@ void tmrTask_thread(void){
             /* get time difference since last function call */
             uint32_t timeDifference_us = 1000;
 
+#ifdef CO_DRIVER_RX_RING
+            /* process messages, received by CAN interrupt */
+            CO_CANmodule_processRx(CO->CANmodule);
+#endif
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
             syncWas = CO_process_SYNC(CO, timeDifference_us, NULL);
 #endif
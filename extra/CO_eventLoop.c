@@ -0,0 +1,254 @@
+/*
+ * Tickless event loop for CANopenNode
+ *
+ * @file        CO_eventLoop.c
+ * @ingroup     CO_eventLoop
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "extra/CO_eventLoop.h"
+
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE
+
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Monotonic time in microseconds */
+static uint64_t CO_eventLoop_now_us(void) {
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+/* Add file descriptor for reading to epoll */
+static int CO_eventLoop_epollAdd(CO_eventLoop_t *el, int fd) {
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return epoll_ctl(el->epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+}
+#endif
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_eventLoop_init(CO_eventLoop_t *el,
+                                   void (*wake)(void *object),
+                                   void *wakeObject)
+{
+    if (el == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(el, 0, sizeof(*el));
+    el->wake = wake;
+    el->wakeObject = wakeObject;
+    /* process immediately after start */
+    el->timerNext_us = 0;
+
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+    el->epoll_fd = epoll_create1(0);
+    el->event_fd = eventfd(0, EFD_NONBLOCK);
+    el->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (el->epoll_fd < 0 || el->event_fd < 0 || el->timer_fd < 0
+        || CO_eventLoop_epollAdd(el, el->event_fd) < 0
+        || CO_eventLoop_epollAdd(el, el->timer_fd) < 0
+    ) {
+        CO_eventLoop_close(el);
+        return CO_ERROR_SYSCALL;
+    }
+    el->timeOld_us = CO_eventLoop_now_us();
+#endif
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_eventLoop_close(CO_eventLoop_t *el) {
+    if (el == NULL) {
+        return;
+    }
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+    if (el->timer_fd >= 0) {
+        (void)close(el->timer_fd);
+    }
+    if (el->event_fd >= 0) {
+        (void)close(el->event_fd);
+    }
+    if (el->epoll_fd >= 0) {
+        (void)close(el->epoll_fd);
+    }
+    el->epoll_fd = -1;
+    el->event_fd = -1;
+    el->timer_fd = -1;
+#endif
+}
+
+
+/******************************************************************************/
+void CO_eventLoop_initCANopen(CO_eventLoop_t *el, CO_t *co) {
+    if (el == NULL || co == NULL) {
+        return;
+    }
+    CO_initCallbackPre(co, (void *)el, CO_eventLoop_signal);
+    /* objects were just initialized, process them */
+    CO_eventLoop_signal((void *)el);
+}
+
+
+/******************************************************************************/
+void CO_eventLoop_signal(void *object) {
+    CO_eventLoop_t *el = (CO_eventLoop_t *)object;
+
+    if (el == NULL) {
+        return;
+    }
+    el->signaled = true;
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+    {
+        uint64_t u = 1;
+        /* counter may only overflow, if nobody reads it */
+        ssize_t s = write(el->event_fd, &u, sizeof(u));
+        (void)s;
+    }
+#else
+    if (el->wake != NULL) {
+        el->wake(el->wakeObject);
+    }
+#endif
+}
+
+
+/******************************************************************************/
+CO_NMT_reset_cmd_t CO_eventLoop_process(CO_eventLoop_t *el,
+                                        CO_t *co,
+                                        bool_t enableGateway)
+{
+    CO_NMT_reset_cmd_t reset;
+    uint32_t timeDifference_us;
+
+    if (el == NULL || co == NULL) {
+        return CO_RESET_NOT;
+    }
+
+    timeDifference_us = el->timeDifference_us;
+    el->timeDifference_us = 0;
+    el->signaled = false;
+    el->timerNext_us = CO_CONFIG_EVLOOP_MAX_SLEEP_US;
+
+#ifdef CO_DRIVER_RX_RING
+    /* process messages, received by CAN interrupt */
+    CO_LOCK_OD(co->CANmodule);
+    CO_CANmodule_processRx(co->CANmodule);
+    CO_UNLOCK_OD(co->CANmodule);
+#endif
+
+    reset = CO_process(co, enableGateway, timeDifference_us,
+                       &el->timerNext_us);
+
+    /* real-time objects, processed in the same thread */
+    if (!co->nodeIdUnconfigured && co->CANmodule->CANnormal) {
+        bool_t syncWas = false;
+
+        (void)syncWas; /* may be unused */
+        CO_LOCK_OD(co->CANmodule);
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
+        syncWas = CO_process_SYNC(co, timeDifference_us, &el->timerNext_us);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+        CO_process_RPDO(co, syncWas, timeDifference_us, &el->timerNext_us);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+        CO_process_TPDO(co, syncWas, timeDifference_us, &el->timerNext_us);
+#endif
+#if (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE
+        CO_process_SRDO(co, timeDifference_us, &el->timerNext_us);
+#endif
+        CO_UNLOCK_OD(co->CANmodule);
+    }
+
+    /* object was signaled during processing, repeat without sleep */
+    if (el->signaled) {
+        el->timerNext_us = 0;
+    }
+
+    return reset;
+}
+
+
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+/******************************************************************************/
+CO_ReturnError_t CO_eventLoop_addFd(CO_eventLoop_t *el, int fd) {
+    if (el == NULL || fd < 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    return CO_eventLoop_epollAdd(el, fd) < 0 ? CO_ERROR_SYSCALL : CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_eventLoop_wait(CO_eventLoop_t *el) {
+    struct itimerspec tm;
+    struct epoll_event ev;
+    int timeout = -1;
+    uint64_t now_us;
+
+    if (el == NULL) {
+        return;
+    }
+    el->evNew = false;
+
+    /* Program the deadline into timerfd, epoll_wait() itself has only
+     * millisecond resolution. Zero value disarms the timer. */
+    memset(&tm, 0, sizeof(tm));
+    if (el->timerNext_us == 0U) {
+        timeout = 0;
+    }
+    else {
+        tm.it_value.tv_sec = (time_t)(el->timerNext_us / 1000000U);
+        tm.it_value.tv_nsec = (long)(el->timerNext_us % 1000000U) * 1000L;
+    }
+    (void)timerfd_settime(el->timer_fd, 0, &tm, NULL);
+
+    if (epoll_wait(el->epoll_fd, &ev, 1, timeout) == 1) {
+        if (ev.data.fd == el->event_fd || ev.data.fd == el->timer_fd) {
+            uint64_t u;
+            ssize_t s = read(ev.data.fd, &u, sizeof(u));
+            (void)s;
+        }
+        else {
+            el->ev = ev;
+            el->evNew = true;
+        }
+    }
+
+    now_us = CO_eventLoop_now_us();
+    el->timeDifference_us += (uint32_t)(now_us - el->timeOld_us);
+    el->timeOld_us = now_us;
+}
+#endif /* (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX */
+
+#endif /* (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE */
@@ -0,0 +1,238 @@
+/**
+ * Tickless event loop for CANopenNode
+ *
+ * @file        CO_eventLoop.h
+ * @ingroup     CO_eventLoop
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_EVENT_LOOP_H
+#define CO_EVENT_LOOP_H
+
+#include "CANopen.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_EVLOOP
+#define CO_CONFIG_EVLOOP (0)
+#endif
+#ifndef CO_CONFIG_EVLOOP_MAX_SLEEP_US
+#define CO_CONFIG_EVLOOP_MAX_SLEEP_US 100000
+#endif
+
+#if ((CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE) || defined CO_DOXYGEN
+
+#if (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX
+#include <sys/epoll.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_eventLoop Event loop
+ * Tickless processing of CANopen objects.
+ *
+ * @ingroup CO_CANopen_extra
+ * @{
+ *
+ * Instead of calling CO_process() in constant intervals, processing thread
+ * sleeps until the earliest deadline of all objects or until some object has
+ * something to do. Deadlines are reported by processing functions in
+ * _timerNext_us_ (@ref CO_CONFIG_FLAG_TIMERNEXT). Objects signal received and
+ * preprocessed CAN messages with callbacks (@ref CO_CONFIG_FLAG_CALLBACK_PRE),
+ * which are all configured by CO_eventLoop_initCANopen(). Idle node wakes up
+ * only for own heartbeat, consumer timeouts, etc.
+ *
+ * CO_eventLoop_process() calls CO_process(), CO_process_SYNC(),
+ * CO_process_RPDO(), CO_process_TPDO() and CO_process_SRDO() in the same
+ * thread, so separate real-time thread is not necessary. Time between two
+ * calls is accumulated in CO_eventLoop_t::timeDifference_us.
+ *
+ * Objects, which don't support CO_CONFIG_FLAG_TIMERNEXT or have it disabled,
+ * are still processed at least each CO_CONFIG_EVLOOP_MAX_SLEEP_US. Flags
+ * CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE, CO_CONFIG_GLOBAL_RT_FLAG_CALLBACK_PRE
+ * and CO_CONFIG_GLOBAL_FLAG_TIMERNEXT should be enabled in the target
+ * configuration. If CAN driver uses CO_DRIVER_RX_RING, CAN receive interrupt
+ * only copies messages into the ring, so it must call CO_eventLoop_signal()
+ * itself.
+ *
+ * With CO_CONFIG_EVLOOP_LINUX, thread waits in CO_eventLoop_wait() in
+ * epoll_wait(). Callbacks write to eventfd, deadline is programmed into
+ * timerfd with microsecond resolution. Additional file descriptors, for
+ * example CAN socket or gateway socket, are added with CO_eventLoop_addFd().
+ * @code
+CO_eventLoop_init(&el, NULL, NULL);
+CO_eventLoop_addFd(&el, canSocket);
+
+while (reset == CO_RESET_NOT) {
+    CO_eventLoop_wait(&el);
+    if (el.evNew && el.ev.data.fd == canSocket) {
+        // read messages, call CO_CANinterrupt() or similar
+    }
+    reset = CO_eventLoop_process(&el, CO, true);
+}
+ * @endcode
+ *
+ * On RTOS, wake function passed to CO_eventLoop_init() notifies the task,
+ * for example with vTaskNotifyGiveFromISR() or xTaskNotifyGive(). Callbacks
+ * may be called from CAN interrupt.
+ * @code
+for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((el.timerNext_us + 999) / 1000));
+    el.timeDifference_us += elapsed_us(); // from hardware timer
+    reset = CO_eventLoop_process(&el, CO, false);
+}
+ * @endcode
+ */
+
+
+/**
+ * Event loop object.
+ */
+typedef struct {
+    /** Sleep time until the next processing, calculated by
+     * CO_eventLoop_process(). It is 0, if processing must be repeated
+     * immediately. */
+    uint32_t timerNext_us;
+    /** Time since the previous processing in microseconds. It is
+     * accumulated by CO_eventLoop_wait() or by application and cleared by
+     * CO_eventLoop_process(). */
+    uint32_t timeDifference_us;
+    /** Set by CO_eventLoop_signal(), cleared by CO_eventLoop_process() */
+    volatile bool_t signaled;
+    /** From CO_eventLoop_init() */
+    void (*wake)(void *object);
+    /** From CO_eventLoop_init() */
+    void *wakeObject;
+#if ((CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX) || defined CO_DOXYGEN
+    int epoll_fd; /**< File descriptor for epoll */
+    int event_fd; /**< File descriptor for eventfd, written by callbacks */
+    int timer_fd; /**< File descriptor for timerfd with the deadline */
+    uint64_t timeOld_us; /**< Monotonic time of the previous wakeup */
+    /** Event from CO_eventLoop_wait() for other file descriptors, valid if
+     * _evNew_ is true */
+    struct epoll_event ev;
+    /** True, if CO_eventLoop_wait() returned event for other file
+     * descriptor, added by CO_eventLoop_addFd() */
+    bool_t evNew;
+#endif
+} CO_eventLoop_t;
+
+
+/**
+ * Initialize event loop object.
+ *
+ * @param el This object will be initialized.
+ * @param wake Function, which wakes up the processing thread, called from
+ * CO_eventLoop_signal(). It may be called from interrupt. Not used with
+ * CO_CONFIG_EVLOOP_LINUX, where eventfd is written. Can be NULL.
+ * @param wakeObject Pointer to object, which will be passed to wake().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_SYSCALL.
+ */
+CO_ReturnError_t CO_eventLoop_init(CO_eventLoop_t *el,
+                                   void (*wake)(void *object),
+                                   void *wakeObject);
+
+
+/**
+ * Release resources of event loop object.
+ *
+ * @param el Event loop object.
+ */
+void CO_eventLoop_close(CO_eventLoop_t *el);
+
+
+/**
+ * Configure callbacks of all CANopen objects to CO_eventLoop_signal().
+ *
+ * Must be called in each communication reset, after initialization of
+ * CANopen objects, see CO_initCallbackPre().
+ *
+ * @param el Event loop object.
+ * @param co CANopen object.
+ */
+void CO_eventLoop_initCANopen(CO_eventLoop_t *el, CO_t *co);
+
+
+/**
+ * Signal, that CANopen objects must be processed.
+ *
+ * This is callback function for CANopen objects and may be called from
+ * interrupt or other thread.
+ *
+ * @param object Event loop object.
+ */
+void CO_eventLoop_signal(void *object);
+
+
+/**
+ * Process CANopen objects and calculate sleep time.
+ *
+ * @param el Event loop object. Sleep time is written to _timerNext_us_.
+ * @param co CANopen object.
+ * @param enableGateway Passed to CO_process().
+ *
+ * @return Node or communication reset request, from CO_process().
+ */
+CO_NMT_reset_cmd_t CO_eventLoop_process(CO_eventLoop_t *el,
+                                        CO_t *co,
+                                        bool_t enableGateway);
+
+
+#if ((CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX) || defined CO_DOXYGEN
+/**
+ * Add file descriptor to the event loop.
+ *
+ * CO_eventLoop_wait() will also return, when fd is readable.
+ *
+ * @param el Event loop object.
+ * @param fd File descriptor.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_SYSCALL.
+ */
+CO_ReturnError_t CO_eventLoop_addFd(CO_eventLoop_t *el, int fd);
+
+
+/**
+ * Wait for the next event.
+ *
+ * Function blocks in epoll_wait() for up to _timerNext_us_, until callback is
+ * signaled or until file descriptor added by CO_eventLoop_addFd() is
+ * readable. Then it sets _evNew_ and _ev_ and adds elapsed time to
+ * _timeDifference_us_.
+ *
+ * @param el Event loop object.
+ */
+void CO_eventLoop_wait(CO_eventLoop_t *el);
+#endif /* (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_LINUX */
+
+/** @} */ /* CO_eventLoop */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_EVLOOP) & CO_CONFIG_EVLOOP_ENABLE */
+
+#endif /* CO_EVENT_LOOP_H */
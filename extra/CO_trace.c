@@ -26,487 +26,525 @@
 
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
 
-#include <stdio.h>
 #include <string.h>
-#if !((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_OWN_INTTYPES)
-#include <inttypes.h> /* for PRIu32("u" or "lu") and PRId32("d" or "ld") */
-#endif
-
-/* Different functions for processing value for different data types. */
-static int32_t getValueI8 (void *OD_variable) { return (int32_t) *((int8_t*)   OD_variable);}
-static int32_t getValueI16(void *OD_variable) { return (int32_t) *((int16_t*)  OD_variable);}
-static int32_t getValueI32(void *OD_variable) { return           *((int32_t*)  OD_variable);}
-static int32_t getValueU8 (void *OD_variable) { return (int32_t) *((uint8_t*)  OD_variable);}
-static int32_t getValueU16(void *OD_variable) { return (int32_t) *((uint16_t*) OD_variable);}
-static int32_t getValueU32(void *OD_variable) { return           *((int32_t*)  OD_variable);}
-
-
-/* Different functions for printing points for different data types. */
-static uint32_t printPointCsv(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "%" PRIu32 ";%" PRId32 "\n", timeStamp,              value);
-}
-static uint32_t printPointCsvUnsigned(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "%" PRIu32 ";%" PRIu32 "\n", timeStamp, (uint32_t)   value);
-}
-static uint32_t printPointBinary(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    if(size < 8) return 0;
-    uint32_t timeStampSw = CO_SWAP_32(timeStamp);
-    int32_t valueSw = CO_SWAP_32(value);
-    memcpy(s, &timeStampSw, sizeof(timeStampSw));
-    memcpy(s+4, &valueSw, sizeof(valueSw));
-    return 8;
-}
-static uint32_t printPointSvgStart(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "M%" PRIu32 ",%" PRId32, timeStamp,             value);
+
+/* Sub-indexes of OD_INDEX_TRACE_CONFIG */
+#define TRACE_CFG_SIZE          1
+#define TRACE_CFG_CONTROL       2
+#define TRACE_CFG_SAMPLING      3
+#define TRACE_CFG_DECIMATION    4
+#define TRACE_CFG_TRIGGER       5
+#define TRACE_CFG_TRIGGER_CH    6
+#define TRACE_CFG_THRESHOLD     7
+#define TRACE_CFG_SAMPLES       8
+#define TRACE_CFG_SIGNED        9
+#define TRACE_CFG_MAP           16
+
+/* Sub-indexes of OD_INDEX_TRACE */
+#define TRACE_SIZE              1
+#define TRACE_TRIGGER_TIME      2
+#define TRACE_STATE             3
+#define TRACE_DROPPED           4
+#define TRACE_DATA              5
+
+/* Values of trace->sampling and trace->trigger */
+#define TRACE_SAMPLING_SYNC     1
+#define TRACE_TRIGGER_NONE      0
+#define TRACE_TRIGGER_SYNC      1
+#define TRACE_TRIGGER_RISING    2
+#define TRACE_TRIGGER_FALLING   3
+
+/* Maximum size of one record: header, time and values, each up to 5 bytes */
+#define TRACE_RECORD_SIZE       (6 + 5 * CO_CONFIG_TRACE_CHANNELS)
+
+
+/* Encode value as base-128 varint, return number of bytes */
+static size_t putVarint(uint8_t *buf, uint32_t value) {
+    size_t len = 0;
+
+    while (value >= 0x80U) {
+        buf[len++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    buf[len++] = (uint8_t)value;
+    return len;
 }
-static uint32_t printPointSvgStartUnsigned(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "M%" PRIu32 ",%" PRIu32, timeStamp, (uint32_t)  value);
+
+/* Map signed value to unsigned, so small negative numbers stay small */
+static uint32_t zigzag(int32_t value) {
+    uint32_t u = (uint32_t)value << 1;
+    return (value < 0) ? ~u : u;
 }
-static uint32_t printPointSvg(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "H%" PRIu32 "V%" PRId32, timeStamp,             value);
+
+/* Compare value of the channel with trace->threshold (-1, 0 or 1) */
+static int8_t compareThreshold(CO_trace_t *trace, uint8_t ch, int32_t value) {
+    if ((trace->signedChannels & ((uint32_t)1 << ch)) != 0) {
+        return (value < trace->threshold) ? -1
+               : (value > trace->threshold) ? 1 : 0;
+    }
+    else {
+        uint32_t u = (uint32_t)value, thr = (uint32_t)trace->threshold;
+        return (u < thr) ? -1 : (u > thr) ? 1 : 0;
+    }
 }
-static uint32_t printPointSvgUnsigned(char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
-    return snprintf(s, size, "H%" PRIu32 "V%" PRIu32, timeStamp, (uint32_t)  value);
+
+
+/* Read mapped variable, return previous value on error */
+static int32_t readChannel(CO_trace_t *trace, uint8_t ch) {
+    OD_IO_t *io = &trace->channelIO[ch];
+    uint8_t len = trace->channelLen[ch];
+    uint8_t buf[4] = {0, 0, 0, 0};
+    OD_size_t countRd;
+
+    io->stream.dataOffset = 0;
+    ODR_t odRet = io->read(&io->stream, buf, len, &countRd);
+    io->stream.dataOffset = 0;
+    if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
+        return trace->valuePrev[ch];
+    }
+
+    /* data from OD interface is little endian */
+    uint32_t u = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8)
+               | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    if (len < 4 && (trace->signedChannels & ((uint32_t)1 << ch)) != 0) {
+        uint32_t signBit = (uint32_t)1 << (len * 8 - 1);
+        u = (u ^ signBit) - signBit;
+    }
+    return (int32_t)u;
 }
 
 
-/* Collection of function pointers for fast processing based on specific data type. */
-/* Rules for the array: There must be groups of six members (I8, I16, I32, U8, U16, U32)
- * in correct order and sequence, so findVariable() finds correct member. */
-static const CO_trace_dataType_t dataTypes[] = {
-    {getValueI8,  printPointCsv,              printPointCsv,         printPointCsv},
-    {getValueI16, printPointCsv,              printPointCsv,         printPointCsv},
-    {getValueI32, printPointCsv,              printPointCsv,         printPointCsv},
-    {getValueU8,  printPointCsvUnsigned,      printPointCsvUnsigned, printPointCsvUnsigned},
-    {getValueU16, printPointCsvUnsigned,      printPointCsvUnsigned, printPointCsvUnsigned},
-    {getValueU32, printPointCsvUnsigned,      printPointCsvUnsigned, printPointCsvUnsigned},
-    {getValueI8,  printPointBinary,           printPointBinary,      printPointBinary},
-    {getValueI16, printPointBinary,           printPointBinary,      printPointBinary},
-    {getValueI32, printPointBinary,           printPointBinary,      printPointBinary},
-    {getValueU8,  printPointBinary,           printPointBinary,      printPointBinary},
-    {getValueU16, printPointBinary,           printPointBinary,      printPointBinary},
-    {getValueU32, printPointBinary,           printPointBinary,      printPointBinary},
-    {getValueI8,  printPointSvgStart,         printPointSvg,         printPointSvg},
-    {getValueI16, printPointSvgStart,         printPointSvg,         printPointSvg},
-    {getValueI32, printPointSvgStart,         printPointSvg,         printPointSvg},
-    {getValueU8,  printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
-    {getValueU16, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
-    {getValueU32, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned}
-};
-
-
-/* Find variable in Object Dictionary *****************************************/
-static void findVariable(CO_trace_t *trace) {
-    bool_t err = false;
-    uint16_t index;
-    uint8_t subIndex;
-    uint8_t dataLen;
-    void *OdDataPtr = NULL;
-    unsigned dtIndex = 0;
-
-    /* parse mapping */
-    index = (uint16_t) ((*trace->map) >> 16);
-    subIndex = (uint8_t) ((*trace->map) >> 8);
-    dataLen = (uint8_t) (*trace->map);
-    if((dataLen & 0x07) != 0) { /* data length must be byte aligned */
-        err = true;
-    }
-    dataLen >>= 3;   /* in bytes now */
-    if(dataLen == 0) {
-        dataLen = 4;
-    }
-
-    /* find mapped variable, if map available */
-    if(!err && (index != 0 || subIndex != 0)) {
-        uint16_t entryNo = CO_OD_find(trace->SDO, index);
-
-        if(index >= 0x1000 && entryNo != 0xFFFF && subIndex <= trace->SDO->OD[entryNo].maxSubIndex) {
-            OdDataPtr = CO_OD_getDataPointer(trace->SDO, entryNo, subIndex);
-        }
+/* Encode values into record and write it into circular buffer */
+static void writeRecord(CO_trace_t *trace, const int32_t *values) {
+    uint8_t rec[TRACE_RECORD_SIZE];
+    size_t len;
+    uint32_t timeDiff = trace->time_us - trace->timeLast_us;
+    bool_t key = timeDiff > 0x7FFFFFFFUL;
 
-        if(OdDataPtr != NULL) {
-            uint16_t len = CO_OD_getLength(trace->SDO, entryNo, subIndex);
+    if (trace->keyRequest) {
+        /* cleared before encoding, so new request from reader is not lost */
+        trace->keyRequest = false;
+        key = true;
+    }
 
-            if(len < dataLen) {
-                dataLen = len;
-            }
-        }
-        else {
-            err = true;
-        }
+    if (key) {
+        len = putVarint(rec, 1);
+        len += putVarint(&rec[len], trace->time_us);
+    }
+    else {
+        len = putVarint(rec, timeDiff << 1);
+    }
+    for (uint8_t ch = 0; ch < trace->channelsCount; ch++) {
+        int32_t value = key ? values[ch]
+                      : (int32_t)((uint32_t)values[ch]
+                                  - (uint32_t)trace->valuePrev[ch]);
+        len += putVarint(&rec[len], zigzag(value));
     }
 
-    /* Get function pointers for correct data type */
-    if(!err) {
-        /* first sequence: data length */
-        switch(dataLen) {
-            case 1: dtIndex = 0; break;
-            case 2: dtIndex = 1; break;
-            case 4: dtIndex = 2; break;
-            default: err = true; break;
-        }
-        /* second sequence: signed or unsigned */
-        if(((*trace->format) & 1) == 1) {
-            dtIndex += 3;
-        }
-        /* third sequence: Output type */
-        dtIndex += ((*trace->format) >> 1) * 6;
+    CO_MemoryBarrier();
+    if (CO_fifo_getSpace(&trace->fifo) < len) {
+        trace->dropped++;
+        trace->keyRequest = true;
+        return;
+    }
 
-        if(dtIndex > (sizeof(dataTypes) / sizeof(CO_trace_dataType_t))) {
-            err = true;
+    /* record is split in two regions, if circular buffer wraps */
+    size_t written = 0;
+    while (written < len) {
+        uint8_t *dest;
+        size_t n = CO_fifo_writeSpan(&trace->fifo, &dest);
+
+        if (n > len - written) {
+            n = len - written;
         }
+        memcpy(dest, &rec[written], n);
+        CO_MemoryBarrier();
+        CO_fifo_writeCommit(&trace->fifo, n);
+        written += n;
+    }
+
+    memcpy(trace->valuePrev, values, sizeof(int32_t) * trace->channelsCount);
+    trace->timeLast_us = trace->time_us;
+}
+
+
+/*
+ * Read configuration from OD and start the trace.
+ *
+ * Called from OD write function, so CO_trace_process() does not run
+ * meanwhile (see CO_LOCK_OD()), trace must be stopped.
+ */
+static ODR_t traceStart(CO_trace_t *trace) {
+    OD_entry_t *cfg = trace->OD_traceConfig;
+    uint8_t ch;
+
+    if (OD_get_u8(cfg, TRACE_CFG_SAMPLING, &trace->sampling, true) != ODR_OK
+        || OD_get_u16(cfg, TRACE_CFG_DECIMATION, &trace->decimation, true)
+           != ODR_OK
+        || OD_get_u8(cfg, TRACE_CFG_TRIGGER, &trace->trigger, true) != ODR_OK
+        || OD_get_u8(cfg, TRACE_CFG_TRIGGER_CH, &trace->triggerChannel, true)
+           != ODR_OK
+        || OD_get_i32(cfg, TRACE_CFG_THRESHOLD, &trace->threshold, true)
+           != ODR_OK
+        || OD_get_u32(cfg, TRACE_CFG_SAMPLES, &trace->samples, true) != ODR_OK
+        || OD_get_u32(cfg, TRACE_CFG_SIGNED, &trace->signedChannels, true)
+           != ODR_OK
+    ) {
+        return ODR_DEV_INCOMPAT;
     }
 
-    /* set output variables */
-    if(!err) {
-        if(OdDataPtr != NULL) {
-            trace->OD_variable = OdDataPtr;
+    /* resolve mapped variables */
+    for (ch = 0; ch < CO_CONFIG_TRACE_CHANNELS; ch++) {
+        uint32_t map;
+        if (OD_get_u32(cfg, TRACE_CFG_MAP + ch, &map, true) != ODR_OK
+            || map == 0
+        ) {
+            break;
         }
-        else {
-            trace->OD_variable = trace->value;
+
+        uint16_t index = (uint16_t)(map >> 16);
+        uint8_t subIndex = (uint8_t)(map >> 8);
+        uint8_t bits = (uint8_t)map;
+        OD_IO_t *io = &trace->channelIO[ch];
+
+        if ((bits != 8 && bits != 16 && bits != 32)
+            || OD_getSub(OD_find(trace->od, index), subIndex, io, false)
+               != ODR_OK
+            || (io->stream.attribute & (ODA_SDO_R | ODA_TPDO)) == 0
+            || io->stream.dataLength < (bits / 8U)
+        ) {
+            return ODR_NO_MAP;
         }
-        trace->dt = &dataTypes[dtIndex];
+        trace->channelLen[ch] = bits / 8U;
+    }
+    if (ch == 0
+        || (trace->trigger >= TRACE_TRIGGER_RISING
+            && trace->triggerChannel >= ch)
+        || trace->trigger > TRACE_TRIGGER_FALLING
+    ) {
+        return (ch == 0) ? ODR_NO_MAP : ODR_INVALID_VALUE;
     }
-    else  {
-        trace->OD_variable = NULL;
-        trace->dt = NULL;
+    trace->channelsCount = ch;
+    /* trigger channel is not used without threshold trigger */
+    if (trace->trigger < TRACE_TRIGGER_RISING) {
+        trace->triggerChannel = 0;
     }
+
+    trace->time_us = 0;
+    trace->timeLast_us = 0;
+    trace->triggerTime_us = 0;
+    trace->decimationCounter = 0;
+    trace->recorded = 0;
+    trace->dropped = 0;
+    trace->keyRequest = true;
+    trace->triggerPrevValid = false;
+    trace->readRemaining = 0;
+    CO_fifo_reset(&trace->fifo);
+    memset(trace->valuePrev, 0, sizeof(trace->valuePrev));
+
+    CO_MemoryBarrier();
+    trace->state = CO_TRACE_STATE_ARMED;
+    return ODR_OK;
 }
 
 
-/* OD function for accessing _OD_traceConfig_ (index 0x2300+) from SDO server.
- * For more information see file CO_SDOserver.h. */
-static CO_SDO_abortCode_t CO_ODF_traceConfig(CO_ODF_arg_t *ODF_arg) {
-    CO_trace_t *trace;
-    CO_SDO_abortCode_t ret = CO_SDO_AB_NONE;
+/*
+ * Custom functions for reading and writing OD object "Trace configuration"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_traceConfig(OD_stream_t *stream, void *buf,
+                                 OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
 
-    trace = (CO_trace_t*) ODF_arg->object;
+    CO_trace_t *trace = stream->object;
 
-    switch(ODF_arg->subIndex) {
-    case 1:     /* size */
-        if(ODF_arg->reading) {
-            CO_setUint32(ODF_arg->data, trace->bufferSize);
+    switch (stream->subIndex) {
+    case TRACE_CFG_SIZE:
+        if (count < sizeof(uint32_t)) {
+            return ODR_DEV_INCOMPAT;
         }
-        break;
+        *countRead = CO_setUint32(buf, CO_CONFIG_TRACE_BUFFER_SIZE);
+        return ODR_OK;
 
-    case 2:     /* axisNo (trace enabled if nonzero) */
-        if(ODF_arg->reading) {
-            uint8_t *value = (uint8_t*) ODF_arg->data;
-            if(!trace->enabled) {
-                *value = 0;
-            }
+    case TRACE_CFG_CONTROL: {
+        CO_trace_state_t state = trace->state;
+        if (count < sizeof(uint8_t)) {
+            return ODR_DEV_INCOMPAT;
         }
-        else {
-            uint8_t *value = (uint8_t*) ODF_arg->data;
+        *countRead = CO_setUint8(buf, (state == CO_TRACE_STATE_ARMED
+                                       || state == CO_TRACE_STATE_RUNNING)
+                                      ? 1 : 0);
+        return ODR_OK;
+    }
 
-            if(*value == 0) {
-                trace->enabled = false;
-            }
-            else if(!trace->enabled) {
-                if(trace->bufferSize == 0) {
-                    ret = CO_SDO_AB_OUT_OF_MEM;
-                }
-                else {
-                    /* set trace->OD_variable and trace->dt, based on 'map' and 'format' */
-                    findVariable(trace);
-
-                    if(trace->OD_variable != NULL) {
-                        *trace->value = 0;
-                        *trace->minValue = 0;
-                        *trace->maxValue = 0;
-                        *trace->triggerTime = 0;
-                        trace->valuePrev = 0;
-                        trace->readPtr = 0;
-                        trace->writePtr = 0;
-                        trace->enabled = true;
-                    }
-                    else {
-                        ret = CO_SDO_AB_NO_MAP;
-                    }
-                }
-            }
-        }
-        break;
+    default:
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+}
 
-    case 5:     /* map */
-    case 6:     /* format */
-        if(!ODF_arg->reading) {
-            if(trace->enabled) {
-                ret = CO_SDO_AB_INVALID_VALUE;
+static ODR_t OD_write_traceConfig(OD_stream_t *stream, const void *buf,
+                                  OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_trace_t *trace = stream->object;
+    CO_trace_state_t state = trace->state;
+    bool_t active = state == CO_TRACE_STATE_ARMED
+                 || state == CO_TRACE_STATE_RUNNING;
+
+    if (stream->subIndex == TRACE_CFG_SIZE) {
+        return ODR_READONLY;
+    }
+    else if (stream->subIndex == TRACE_CFG_CONTROL) {
+        if (count != sizeof(uint8_t)) {
+            return ODR_TYPE_MISMATCH;
+        }
+        trace->state = CO_TRACE_STATE_IDLE;
+        if (CO_getUint8(buf) != 0) {
+            ODR_t odRet = traceStart(trace);
+            if (odRet != ODR_OK) {
+                return odRet;
             }
         }
-        break;
-    default:
-        /* MISRA C 2004 15.3 */
-        break;
     }
+    else if (active && stream->subIndex != 0) {
+        return ODR_DATA_DEV_STATE;
+    }
+    else { /* MISRA C 2004 14.10 */ }
 
-    return ret;
+    return OD_writeOriginal(stream, buf, count, countWritten);
 }
 
 
-/* OD function for accessing _OD_trace_ (index 0x2400+) from SDO server.
- * For more information see file CO_SDOserver.h. */
-static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
-    CO_trace_t *trace;
-    CO_SDO_abortCode_t ret = CO_SDO_AB_NONE;
-
-    trace = (CO_trace_t*) ODF_arg->object;
+/*
+ * Custom functions for reading and writing OD object "Trace"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_trace(OD_stream_t *stream, void *buf,
+                           OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
 
-    switch(ODF_arg->subIndex) {
-    case 1:     /* size */
-        if(ODF_arg->reading) {
-            uint32_t size = trace->bufferSize;
-            uint32_t wp = trace->writePtr;
-            uint32_t rp = trace->readPtr;
+    CO_trace_t *trace = stream->object;
 
-            if(wp >= rp) {
-                CO_setUint32(ODF_arg->data,  wp - rp);
-            }
-            else {
-                CO_setUint32(ODF_arg->data, size - rp + wp);
+    if (stream->subIndex == 0) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    if (stream->subIndex == TRACE_DATA) {
+        uint8_t *dest = (uint8_t *)buf;
+        size_t n = 0;
+
+        /* don't read data, recorded during this read */
+        if (stream->dataOffset == 0) {
+            CO_MemoryBarrier();
+            trace->readRemaining = CO_fifo_getOccupied(&trace->fifo);
+            if (trace->readRemaining == 0) {
+                return ODR_NO_DATA;
             }
         }
-        else {
-            if(CO_getUint32(ODF_arg->data) == 0) {
-                /* clear buffer, handle race conditions */
-                while(trace->readPtr != 0 || trace->writePtr != 0) {
-                    trace->readPtr = 0;
-                    trace->writePtr = 0;
-                    *trace->triggerTime = 0;
-                }
-            }
-            else {
-                ret = CO_SDO_AB_INVALID_VALUE;
-            }
+
+        while (n < count && trace->readRemaining > 0) {
+            const uint8_t *src;
+            size_t span = CO_fifo_readSpan(&trace->fifo, &src);
+
+            if (span > count - n) span = count - n;
+            if (span > trace->readRemaining) span = trace->readRemaining;
+            CO_MemoryBarrier();
+            memcpy(&dest[n], src, span);
+            CO_MemoryBarrier();
+            CO_fifo_readCommit(&trace->fifo, span);
+            n += span;
+            trace->readRemaining -= span;
         }
-        break;
 
-    case 5:     /* plot */
-        if(ODF_arg->reading) {
-            /* This plot will be transmitted as domain data type. String data
-             * will be printed directly to SDO buffer. If there is more data
-             * to print, than is the size of SDO buffer, then this function
-             * will be called multiple times until internal trace buffer is
-             * empty. Internal trace buffer is circular buffer. It is accessed
-             * by this function and by higher priority thread. If this buffer
-             * is full, there is a danger for race condition. First records
-             * from trace buffer may be overwritten somewhere between. If this
-             * is detected, then do{}while() loop tries printing again. */
-            if(trace->bufferSize == 0 || ODF_arg->dataLength < 100) {
-                ret = CO_SDO_AB_OUT_OF_MEM;
-            }
-            else if(trace->readPtr == trace->writePtr) {
-                ret = CO_SDO_AB_NO_DATA;
-            }
-            else {
-                uint32_t rp, t, v, len, freeLen;
-                char *s;
-                bool_t readPtrOverflowed; /* for handling race conditions */
-
-                /* repeat everything, if trace->readPtr was overflowed in CO_trace_process */
-                do {
-                    readPtrOverflowed = false;
-                    s = (char*) ODF_arg->data;
-                    freeLen = ODF_arg->dataLength;
-
-                    rp = trace->readPtr;
-
-                    /* start plot, increment variables, verify overflow */
-                    if(ODF_arg->firstSegment) {
-                        t = trace->timeBuffer[rp];
-                        v = trace->valueBuffer[rp];
-                        rp ++;
-                        if(++trace->readPtr == trace->bufferSize) {
-                            trace->readPtr = 0;
-                            if(rp != trace->bufferSize) {
-                                readPtrOverflowed = true;
-                                continue;
-                            }
-                            rp = 0;
-                        }
-                        if(rp != trace->readPtr) {
-                            readPtrOverflowed = true;
-                            continue;
-                        }
-                        len = trace->dt->printPointStart(s, freeLen, t, v);
-                        s += len;
-                        freeLen -= len;
-                    }
-
-                    /* print other points */
-                    if(rp != trace->writePtr) {
-                    for(;;) {
-                        t = trace->timeBuffer[rp];
-                        v = trace->valueBuffer[rp];
-                        rp ++;
-                        if(++trace->readPtr == trace->bufferSize) {
-                            trace->readPtr = 0;
-                            if(rp != trace->bufferSize && ODF_arg->firstSegment) {
-                                readPtrOverflowed = true;
-                                break;
-                            }
-                            rp = 0;
-                        }
-                        if(rp != trace->readPtr && ODF_arg->firstSegment) {
-                            readPtrOverflowed = true;
-                            break;
-                        }
-
-                        /* If internal buffer is empty, end transfer */
-                        if(rp == trace->writePtr) {
-                            /* If there is last time stamp, point will be printed at the end */
-                            if(t != trace->lastTimeStamp) {
-                                len = trace->dt->printPoint(s, freeLen, t, v);
-                                s += len;
-                                freeLen -= len;
-                            }
-                            ODF_arg->lastSegment = true;
-                            break;
-                        }
-                        len = trace->dt->printPoint(s, freeLen, t, v);
-                        s += len;
-                        freeLen -= len;
-
-                        /* if output buffer is full, next data will be sent later */
-                        if(freeLen < 50) {
-                            ODF_arg->lastSegment = false;
-                            break;
-                        }
-                    }
-                    }
-
-                    /* print last point */
-                    if(!readPtrOverflowed && ODF_arg->lastSegment) {
-                        v = trace->valuePrev;
-                        t = trace->lastTimeStamp;
-                        len = trace->dt->printPointEnd(s, freeLen, t, v);
-                        s += len;
-                        freeLen -= len;
-                    }
-                } while(readPtrOverflowed);
-
-                ODF_arg->dataLength -= freeLen;
-            }
+        *countRead = (OD_size_t)n;
+        if (trace->readRemaining > 0) {
+            stream->dataOffset += (OD_size_t)n;
+            return ODR_PARTIAL;
         }
+        stream->dataOffset = 0;
+        return ODR_OK;
+    }
+
+    if (count < sizeof(uint32_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+    switch (stream->subIndex) {
+    case TRACE_SIZE:
+        CO_MemoryBarrier();
+        *countRead = CO_setUint32(buf, CO_fifo_getOccupied(&trace->fifo));
         break;
-    default:
-        /* MISRA C 2004 15.3 */
+    case TRACE_TRIGGER_TIME:
+        *countRead = CO_setUint32(buf, trace->triggerTime_us);
+        break;
+    case TRACE_STATE:
+        *countRead = CO_setUint8(buf, (uint8_t)trace->state);
+        break;
+    case TRACE_DROPPED:
+        *countRead = CO_setUint32(buf, trace->dropped);
         break;
+    default:
+        return ODR_SUB_NOT_EXIST;
     }
+    return ODR_OK;
+}
 
-    return ret;
+static ODR_t OD_write_trace(OD_stream_t *stream, const void *buf,
+                            OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_trace_t *trace = stream->object;
+
+    if (stream->subIndex != TRACE_SIZE) {
+        return ODR_READONLY;
+    }
+    if (count != sizeof(uint32_t)) {
+        return ODR_TYPE_MISMATCH;
+    }
+    if (CO_getUint32(buf) != 0) {
+        return ODR_INVALID_VALUE;
+    }
+
+    /* clear buffer from the reader side, next record will be key record */
+    CO_MemoryBarrier();
+    CO_fifo_readCommit(&trace->fifo, CO_fifo_getOccupied(&trace->fifo));
+    trace->keyRequest = true;
+
+    *countWritten = count;
+    return ODR_OK;
 }
 
 
 /******************************************************************************/
-void CO_trace_init(
-        CO_trace_t             *trace,
-        CO_SDO_t               *SDO,
-        uint8_t                 enabled,
-        uint32_t               *timeBuffer,
-        int32_t                *valueBuffer,
-        uint32_t                bufferSize,
-        uint32_t               *map,
-        uint8_t                *format,
-        uint8_t                *trigger,
-        int32_t                *threshold,
-        int32_t                *value,
-        int32_t                *minValue,
-        int32_t                *maxValue,
-        uint32_t               *triggerTime,
-        uint16_t                idx_OD_traceConfig,
-        uint16_t                idx_OD_trace)
+CO_ReturnError_t CO_trace_init(CO_trace_t *trace,
+                               OD_t *od,
+                               OD_entry_t *OD_traceConfig,
+                               OD_entry_t *OD_trace,
+                               uint32_t *errInfo)
 {
-    trace->SDO = SDO;
-    trace->enabled = (enabled != 0) ? true : false;
-    trace->timeBuffer = timeBuffer;
-    trace->valueBuffer = valueBuffer;
-    trace->bufferSize = bufferSize;
-    trace->writePtr = 0;
-    trace->readPtr = 0;
-    trace->lastTimeStamp = 0;
-    trace->map = map;
-    trace->format = format;
-    trace->trigger = trigger;
-    trace->threshold = threshold;
-    trace->value = value;
-    trace->minValue = minValue;
-    trace->maxValue = maxValue;
-    trace->triggerTime = triggerTime;
-    *trace->value = 0;
-    *trace->minValue = 0;
-    *trace->maxValue = 0;
-    *trace->triggerTime = 0;
-    trace->valuePrev = 0;
-
-    /* set trace->OD_variable and trace->dt, based on 'map' and 'format' */
-    findVariable(trace);
-
-    if(timeBuffer == NULL || valueBuffer == NULL) {
-        trace->bufferSize = 0;
-    }
-
-    if( trace->bufferSize == 0 || trace->OD_variable == NULL) {
-        trace->enabled = false;
-    }
-
-    CO_OD_configure(SDO, idx_OD_traceConfig, CO_ODF_traceConfig, (void*)trace, 0, 0);
-    CO_OD_configure(SDO, idx_OD_trace, CO_ODF_trace, (void*)trace, 0, 0);
+    /* verify arguments */
+    if (trace == NULL || od == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    if (OD_traceConfig == NULL || OD_trace == NULL) {
+        if (errInfo != NULL) {
+            *errInfo = (OD_traceConfig == NULL) ? OD_INDEX_TRACE_CONFIG
+                                                : OD_INDEX_TRACE;
+        }
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    trace->od = od;
+    trace->OD_traceConfig = OD_traceConfig;
+    trace->state = CO_TRACE_STATE_IDLE;
+    trace->channelsCount = 0;
+    trace->dropped = 0;
+    trace->triggerTime_us = 0;
+    trace->readRemaining = 0;
+    CO_fifo_init(&trace->fifo, trace->buf, sizeof(trace->buf));
+
+    trace->OD_traceConfig_ext.object = trace;
+    trace->OD_traceConfig_ext.read = OD_read_traceConfig;
+    trace->OD_traceConfig_ext.write = OD_write_traceConfig;
+    OD_extension_init(OD_traceConfig, &trace->OD_traceConfig_ext);
+
+    trace->OD_trace_ext.object = trace;
+    trace->OD_trace_ext.read = OD_read_trace;
+    trace->OD_trace_ext.write = OD_write_trace;
+    OD_extension_init(OD_trace, &trace->OD_trace_ext);
+
+    return CO_ERROR_NO;
 }
 
 
 /******************************************************************************/
-void CO_trace_process(CO_trace_t *trace, uint32_t timestamp) {
-    if(trace->enabled) {
+void CO_trace_process(CO_trace_t *trace,
+                      bool_t syncWas,
+                      uint32_t timeDifference_us)
+{
+    int32_t values[CO_CONFIG_TRACE_CHANNELS];
+    CO_trace_state_t state = trace->state;
 
-        int32_t val = trace->dt->pGetValue(trace->OD_variable);
+    if (state != CO_TRACE_STATE_ARMED && state != CO_TRACE_STATE_RUNNING) {
+        return;
+    }
+    CO_MemoryBarrier();
 
-        if(val != trace->valuePrev) {
-            /* Verify, if value passed threshold */
-            if((*trace->trigger & 1) != 0 && trace->valuePrev < *trace->threshold && val >= *trace->threshold) {
-                *trace->triggerTime = timestamp;
-            }
-            if((*trace->trigger & 2) != 0 && trace->valuePrev < *trace->threshold && val >= *trace->threshold) {
-                *trace->triggerTime = timestamp;
-            }
+    trace->time_us += timeDifference_us;
+    if (trace->sampling == TRACE_SAMPLING_SYNC && !syncWas) {
+        return;
+    }
 
-            /* Write value and verify min/max */
-            if(trace->value != trace->OD_variable) {
-                *trace->value = val;
-            }
-            trace->valuePrev = val;
-            if(*trace->minValue > val) {
-                *trace->minValue = val;
-            }
-            if(*trace->maxValue < val) {
-                *trace->maxValue = val;
-            }
+    for (uint8_t ch = 0; ch < trace->channelsCount; ch++) {
+        values[ch] = readChannel(trace, ch);
+    }
 
-            /* write buffers and update pointers */
-            trace->timeBuffer[trace->writePtr] = timestamp;
-            trace->valueBuffer[trace->writePtr] = val;
-            if(++trace->writePtr == trace->bufferSize) {
-                trace->writePtr = 0;
-            }
-            if(trace->writePtr == trace->readPtr) {
-                if(++trace->readPtr == trace->bufferSize) {
-                    trace->readPtr = 0;
-                }
-            }
+    if (state == CO_TRACE_STATE_ARMED) {
+        bool_t triggered = false;
+        int8_t cmp = 0;
+
+        /* only threshold triggers use trigger channel */
+        if (trace->trigger >= TRACE_TRIGGER_RISING
+            && trace->triggerChannel < trace->channelsCount
+        ) {
+            cmp = compareThreshold(trace, trace->triggerChannel,
+                                   values[trace->triggerChannel]);
         }
-        else {
-            /* if buffer is empty, make first record */
-            if(trace->writePtr == trace->readPtr) {
-                /* write buffers and update pointers */
-                trace->timeBuffer[trace->writePtr] = timestamp;
-                trace->valueBuffer[trace->writePtr] = val;
-                if(++trace->writePtr == trace->bufferSize) {
-                    trace->writePtr = 0;
-                }
-            }
+
+        switch (trace->trigger) {
+        case TRACE_TRIGGER_NONE:
+            triggered = true;
+            break;
+        case TRACE_TRIGGER_SYNC:
+            triggered = syncWas;
+            break;
+        case TRACE_TRIGGER_RISING:
+            triggered = trace->triggerPrevValid && trace->triggerPrev < 0
+                        && cmp >= 0;
+            break;
+        case TRACE_TRIGGER_FALLING:
+            triggered = trace->triggerPrevValid && trace->triggerPrev > 0
+                        && cmp <= 0;
+            break;
+        default:
+            /* MISRA C 2004 15.3 */
+            break;
         }
-        trace->lastTimeStamp = timestamp;
+        trace->triggerPrev = cmp;
+        trace->triggerPrevValid = true;
+
+        if (!triggered) {
+            return;
+        }
+        trace->triggerTime_us = trace->time_us;
+        trace->decimationCounter = 0;
+        trace->recorded = 0;
+        trace->state = CO_TRACE_STATE_RUNNING;
+    }
+    else if (trace->decimation > 1) {
+        if (++trace->decimationCounter < trace->decimation) {
+            return;
+        }
+        trace->decimationCounter = 0;
+    }
+    else { /* MISRA C 2004 14.10 */ }
+
+    writeRecord(trace, values);
+
+    if (trace->samples > 0 && ++trace->recorded >= trace->samples) {
+        trace->state = CO_TRACE_STATE_FINISHED;
     }
 }
 
@@ -27,15 +27,26 @@
 #define CO_TRACE_H
 
 #include "301/CO_driver.h"
-#include "301/CO_SDOserver.h"
+#include "301/CO_ODinterface.h"
+#include "301/CO_fifo.h"
 
 /* default configuration, see CO_config.h */
 #ifndef CO_CONFIG_TRACE
 #define CO_CONFIG_TRACE (0)
 #endif
+#ifndef CO_CONFIG_TRACE_CHANNELS
+#define CO_CONFIG_TRACE_CHANNELS 16
+#endif
+#ifndef CO_CONFIG_TRACE_BUFFER_SIZE
+#define CO_CONFIG_TRACE_BUFFER_SIZE 1024
+#endif
 
 #if ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE) || defined CO_DOXYGEN
 
+#if !((CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ENABLE)
+#error CO_CONFIG_FIFO_ENABLE must be enabled.
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -50,15 +61,52 @@ extern "C" {
  * Results are then displayed on graph, similar as in oscilloscope.
  *
  * CANopen trace is a configurable object, accessible via CANopen Object
- * Dictionary, which records chosen variable over time. It generates a curve,
- * which can be read via SDO and can then be displayed in a graph.
+ * Dictionary, which records up to @ref CO_CONFIG_TRACE_CHANNELS OD variables
+ * at once. Variables are mapped like in PDO and are sampled by
+ * CO_trace_process() on each call or on each SYNC. Samples are written into
+ * circular buffer in compact binary format and are read as SDO domain (block
+ * transfer is recommended), which consumes data from the buffer. So recording
+ * and reading may run simultaneously.
  *
- * CO_trace_process() runs in 1 ms intervals and monitors one variable. If it
- * changes, it makes a record with timestamp into circular buffer. When trace is
- * accessed by CANopen SDO object, it reads latest points from the the circular
- * buffer, prints a SVG curve into string and sends it as a SDO response. If a
- * SDO request was received from the same device, then no traffic occupies CAN
- * network.
+ * Trace configuration, OD object @ref OD_INDEX_TRACE_CONFIG (RECORD), all
+ * variables, except control, may be changed only when trace is stopped:
+ * - 1 size (UNSIGNED32, ro): size of the circular buffer in bytes.
+ * - 2 control (UNSIGNED8, rw): write 1 to start (arm trigger) or 0 to stop.
+ *   Reads 1 while trace is waiting for trigger or recording.
+ * - 3 sampling (UNSIGNED8, rw): 0 - sample on each CO_trace_process() call,
+ *   1 - sample on SYNC.
+ * - 4 decimation (UNSIGNED16, rw): record each n-th sample, 0 or 1 for each.
+ * - 5 trigger (UNSIGNED8, rw): 0 - start immediately, 1 - start on SYNC,
+ *   2 - start, when trigger channel rises to threshold, 3 - start, when
+ *   trigger channel falls to threshold.
+ * - 6 trigger channel (UNSIGNED8, rw): index of channel, from 0.
+ * - 7 threshold (INTEGER32, rw): compared with value of trigger channel.
+ * - 8 samples (UNSIGNED32, rw): number of records after trigger, 0 for
+ *   continuous recording.
+ * - 9 signed channels (UNSIGNED32, rw): bit n set, if channel n is signed.
+ * - 16 + n map (UNSIGNED32, rw): mapping of channel n, 0xIIIISSLL, same as in
+ *   PDO, length must be 8, 16 or 32 bits. First zero mapping ends channels.
+ *
+ * Trace, OD object @ref OD_INDEX_TRACE (RECORD):
+ * - 1 size (UNSIGNED32, rw): number of bytes in circular buffer. Write 0 to
+ *   clear the buffer.
+ * - 2 trigger time (UNSIGNED32, ro): time of trigger in microseconds after
+ *   start.
+ * - 3 state (UNSIGNED8, ro): see @ref CO_trace_state_t.
+ * - 4 dropped (UNSIGNED32, ro): number of records, dropped because circular
+ *   buffer was full.
+ * - 5 data (DOMAIN, ro): recorded data, see below.
+ *
+ * Data is a sequence of records, one record for each recorded sample. All
+ * numbers are encoded as base-128 varint (7 bits per byte, least significant
+ * first, bit 7 set, if more bytes follow), values as zigzag encoded varint
+ * ((v << 1) ^ (v >> 31)). Each record starts with header. If header is 1,
+ * record is a key record, followed by time in microseconds after start and
+ * value of each channel. Otherwise (header >> 1) is time difference to the
+ * previous record, followed by difference to the previous value of each
+ * channel. First record after start and first record after dropped records
+ * is a key record. Reader must skip records before the first key record, for
+ * example after clearing the buffer.
  */
 
 
@@ -72,43 +120,71 @@ extern "C" {
 
 
 /**
- *  structure for reading variables and printing points for specific data type.
+ * State of the trace, OD_INDEX_TRACE, sub 3
  */
-typedef struct {
-    /** Function pointer for getting the value from OD variable. **/
-    int32_t (*pGetValue) (void *OD_variable);
-    /** Function pointer for printing the start point to trace.plot */
-    uint32_t (*printPointStart)(char *s, uint32_t size, uint32_t timeStamp, int32_t value);
-    /** Function pointer for printing the point to trace.plot */
-    uint32_t (*printPoint)(char *s, uint32_t size, uint32_t timeStamp, int32_t value);
-    /** Function pointer for printing the end point to trace.plot */
-    uint32_t (*printPointEnd)(char *s, uint32_t size, uint32_t timeStamp, int32_t value);
-} CO_trace_dataType_t;
+typedef enum {
+    CO_TRACE_STATE_IDLE = 0,     /**< Trace is stopped */
+    CO_TRACE_STATE_ARMED = 1,    /**< Waiting for trigger */
+    CO_TRACE_STATE_RUNNING = 2,  /**< Recording */
+    CO_TRACE_STATE_FINISHED = 3  /**< Number of samples recorded */
+} CO_trace_state_t;
 
 
 /**
  * Trace object.
  */
 typedef struct {
-    bool_t              enabled;        /**< True, if trace is enabled. */
-    CO_SDO_t           *SDO;            /**< From CO_trace_init(). */
-    uint32_t           *timeBuffer;     /**< From CO_trace_init(). */
-    int32_t            *valueBuffer;    /**< From CO_trace_init(). */
-    uint32_t            bufferSize;     /**< From CO_trace_init(). */
-    volatile uint32_t   writePtr;       /**< Location in buffer, which will be next written. */
-    volatile uint32_t   readPtr;        /**< Location in buffer, which will be next read. */
-    uint32_t            lastTimeStamp;  /**< Last time stamp. If zero, then last point contains last timestamp. */
-    void               *OD_variable;    /**< Pointer to variable, which is monitored */
-    const CO_trace_dataType_t *dt;      /**< Data type specific function pointers. **/
-    int32_t             valuePrev;      /**< Previous value of value. */
-    uint32_t           *map;            /**< From CO_trace_init(). */
-    uint8_t            *format;         /**< From CO_trace_init(). */
-    int32_t            *value;          /**< From CO_trace_init(). */
-    int32_t            *minValue;       /**< From CO_trace_init(). */
-    int32_t            *maxValue;       /**< From CO_trace_init(). */
-    uint32_t           *triggerTime;    /**< From CO_trace_init(). */
-    uint8_t            *trigger;        /**< From CO_trace_init(). */
-    int32_t            *threshold;      /**< From CO_trace_init(). */
+    OD_t *od;                   /**< From CO_trace_init() */
+    OD_entry_t *OD_traceConfig; /**< From CO_trace_init() */
+    /** Extension for OD object */
+    OD_extension_t OD_traceConfig_ext;
+    /** Extension for OD object */
+    OD_extension_t OD_trace_ext;
+    /** State of the trace, written by configuration and by
+     * CO_trace_process() */
+    volatile CO_trace_state_t state;
+    /** Time in microseconds after start */
+    uint32_t time_us;
+    /** Time of the last record */
+    uint32_t timeLast_us;
+    /** Time of the trigger */
+    uint32_t triggerTime_us;
+    /** Sampling, decimation, trigger, trigger channel, threshold, samples and
+     * signed channels from OD, copied on start */
+    uint8_t sampling;
+    uint16_t decimation;        /**< see sampling */
+    uint8_t trigger;            /**< see sampling */
+    uint8_t triggerChannel;     /**< see sampling */
+    int32_t threshold;          /**< see sampling */
+    uint32_t samples;           /**< see sampling */
+    uint32_t signedChannels;    /**< see sampling */
+    /** Number of samples since last record */
+    uint16_t decimationCounter;
+    /** Number of records since trigger */
+    uint32_t recorded;
+    /** Number of records, dropped because of full buffer */
+    uint32_t dropped;
+    /** If true, next record will be key record. Set by reader, when buffer
+     * is cleared */
+    volatile bool_t keyRequest;
+    /** If true, triggerPrev is valid */
+    bool_t triggerPrevValid;
+    /** Previous comparison of trigger channel with threshold: -1, 0 or 1 */
+    int8_t triggerPrev;
+    /** Number of mapped channels */
+    uint8_t channelsCount;
+    /** Length of mapped channels in bytes */
+    uint8_t channelLen[CO_CONFIG_TRACE_CHANNELS];
+    /** Object for accessing mapped variables */
+    OD_IO_t channelIO[CO_CONFIG_TRACE_CHANNELS];
+    /** Values from the previous record */
+    int32_t valuePrev[CO_CONFIG_TRACE_CHANNELS];
+    /** Number of bytes remaining in current SDO read of data */
+    size_t readRemaining;
+    /** Circular buffer for records */
+    CO_fifo_t fifo;
+    /** Buffer for fifo */
+    uint8_t buf[CO_CONFIG_TRACE_BUFFER_SIZE + 1];
 } CO_trace_t;
 
 
@@ -118,54 +194,37 @@ typedef struct {
  * Function must be called in the communication reset section.
  *
  * @param trace This object will be initialized.
- * @param SDO SDO server object.
- * @param enabled Is trace enabled.
- * @param timeBuffer Memory block for storing time records.
- * @param valueBuffer Memory block for storing value records.
- * @param bufferSize Size of the above buffers.
- * @param map Map to variable in Object Dictionary, which will be monitored. Same structure as in PDO.
- * @param format Format of the plot. If first bit is 1, above variable is unsigned. For more info see Object Dictionary.
- * @param trigger If different than zero, trigger time is recorded, when variable goes through threshold.
- * @param threshold Used with trigger.
- * @param value Pointer to variable, which will show last value of the variable.
- * @param minValue Pointer to variable, which will show minimum value of the variable.
- * @param maxValue Pointer to variable, which will show maximum value of the variable.
- * @param triggerTime Pointer to variable, which will show last trigger time of the variable.
- * @param idx_OD_traceConfig Index in Object Dictionary.
- * @param idx_OD_trace Index in Object Dictionary.
+ * @param od Object Dictionary, where mapped variables are searched.
+ * @param OD_traceConfig OD entry for trace configuration,
+ * @ref OD_INDEX_TRACE_CONFIG.
+ * @param OD_trace OD entry for trace data, @ref OD_INDEX_TRACE.
+ * @param [out] errInfo If OD entry is missing, its index is written here, may
+ * be NULL.
  *
- * @return 0 on success, -1 on error.
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
  */
-void CO_trace_init(
-        CO_trace_t             *trace,
-        CO_SDO_t               *SDO,
-        uint8_t                 enabled,
-        uint32_t               *timeBuffer,
-        int32_t                *valueBuffer,
-        uint32_t                bufferSize,
-        uint32_t               *map,
-        uint8_t                *format,
-        uint8_t                *trigger,
-        int32_t                *threshold,
-        int32_t                *value,
-        int32_t                *minValue,
-        int32_t                *maxValue,
-        uint32_t               *triggerTime,
-        uint16_t                idx_OD_traceConfig,
-        uint16_t                idx_OD_trace);
+CO_ReturnError_t CO_trace_init(CO_trace_t *trace,
+                               OD_t *od,
+                               OD_entry_t *OD_traceConfig,
+                               OD_entry_t *OD_trace,
+                               uint32_t *errInfo);
 
 
 /**
  * Process trace object.
  *
- * Function must be called cyclically in 1ms intervals.
+ * Function must be called cyclically, usually from the same real time thread
+ * as PDO processing, see CO_process_TRACE().
  *
  * @param trace This object.
- * @param timestamp Timestamp (usually in millisecond resolution).
- *
- * @return 0 on success, -1 on error.
+ * @param syncWas True, if CANopen SYNC message was just received or
+ * transmitted.
+ * @param timeDifference_us Time difference from previous function call in
+ * microseconds.
  */
-void CO_trace_process(CO_trace_t *trace, uint32_t timestamp);
+void CO_trace_process(CO_trace_t *trace,
+                      bool_t syncWas,
+                      uint32_t timeDifference_us);
 
 /** @} */ /* CO_trace */
 
@@ -0,0 +1,108 @@
+/**
+ * Flash interface for use with CO_storageFlash
+ *
+ * @file        CO_flash.h
+ * @ingroup     CO_storage_flash
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_FLASH_H
+#define CO_FLASH_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CO_storage_flash
+ * @{
+ */
+
+/**
+ * Initialize flash device, target system specific function.
+ *
+ * Flash area, reserved for data storage, consists of sectorCount sectors of
+ * equal size. Flash addresses start with 0 at the beginning of the first
+ * sector. Erased flash reads as 0xFF.
+ *
+ * @param storageModule Pointer to storage module.
+ * @param [out] sectorSize Size of one erasable sector. It must be a multiple
+ * of @ref CO_CONFIG_STORAGE_FLASH_ALIGN.
+ * @param [out] sectorCount Number of sectors, at least two.
+ *
+ * @return True on success
+ */
+bool_t CO_flash_init(void *storageModule,
+                     size_t *sectorSize,
+                     uint16_t *sectorCount);
+
+
+/**
+ * Read block of data from the flash, target system specific function.
+ *
+ * @param storageModule Pointer to storage module.
+ * @param data Pointer to data buffer, where data will be stored.
+ * @param flashAddr Address in flash, from where data will be read.
+ * @param len Length of the data block to be read.
+ */
+void CO_flash_read(void *storageModule, uint8_t *data,
+                   size_t flashAddr, size_t len);
+
+
+/**
+ * Program block of data into erased flash, target system specific function.
+ *
+ * It is blocking function, so it waits, until all data is programmed. Block
+ * never crosses sector boundary, flashAddr and len are always aligned to
+ * @ref CO_CONFIG_STORAGE_FLASH_ALIGN. Each flash location is programmed only
+ * once after erase.
+ *
+ * @param storageModule Pointer to storage module.
+ * @param data Pointer to data buffer which will be programmed.
+ * @param flashAddr Address in flash, where data will be programmed.
+ * @param len Length of the data block.
+ *
+ * @return true on success
+ */
+bool_t CO_flash_program(void *storageModule, const uint8_t *data,
+                        size_t flashAddr, size_t len);
+
+
+/**
+ * Erase one sector of the flash, target system specific function.
+ *
+ * It is blocking function, so it waits, until sector is erased.
+ *
+ * @param storageModule Pointer to storage module.
+ * @param flashAddr Address of the beginning of the sector.
+ *
+ * @return true on success
+ */
+bool_t CO_flash_erase(void *storageModule, size_t flashAddr);
+
+/** @} */ /* CO_storage_flash */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_FLASH_H */
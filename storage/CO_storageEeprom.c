@@ -28,6 +28,259 @@
 
 #if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
 
+#include <string.h>
+
+/* Number of eeprom bytes in one address unit (16 bit char on C2000) */
+#if (C2000_PORT != 0)
+#define CO_STORAGE_AU 2
+#else
+#define CO_STORAGE_AU 1
+#endif
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+
+/*
+ * Size of eeprom region, covered by one bit of entry->dirty. Regions are
+ * aligned with eeprom pages, first region starts with the page, which
+ * contains entry->eepromAddr.
+ */
+static size_t dirtyChunk(const CO_storage_entry_t *entry) {
+    size_t pages = (entry->eepromAddr % CO_CONFIG_STORAGE_PAGE_SIZE + entry->len
+                    + CO_CONFIG_STORAGE_PAGE_SIZE - 1)
+                   / CO_CONFIG_STORAGE_PAGE_SIZE;
+    return CO_CONFIG_STORAGE_PAGE_SIZE * ((pages + 31) / 32);
+}
+
+/*
+ * Update part of eeprom page from entry data, if differs.
+ *
+ * @return false on eeprom write error.
+ */
+static bool_t updatePage(CO_storage_entry_t *entry,
+                         size_t eepromAddr, size_t len)
+{
+    uint8_t buf[CO_CONFIG_STORAGE_PAGE_SIZE / CO_STORAGE_AU];
+    uint8_t *data = (uint8_t *)entry->addr
+                  + (eepromAddr - entry->eepromAddr) / CO_STORAGE_AU;
+
+    CO_eeprom_readBlock(entry->storageModule, buf,
+                        eepromAddr, len / CO_STORAGE_AU);
+    if (memcmp(buf, data, len / CO_STORAGE_AU) == 0) {
+        return true;
+    }
+    return CO_eeprom_writeBlock(entry->storageModule, data,
+                                eepromAddr, len / CO_STORAGE_AU);
+}
+
+/*
+ * Update dirty pages of automatic storage entry. If saveAll is false, only
+ * pages of the lowest bit from the dirty mask are updated.
+ */
+static void autoProcessDirty(CO_storage_t *storage,
+                             CO_storage_entry_t *entry,
+                             bool_t saveAll)
+{
+    uint32_t dirty;
+
+    CO_LOCK_OD(storage->CANmodule);
+    dirty = entry->dirty;
+    if (!saveAll) {
+        dirty &= ~(dirty - 1);
+    }
+    entry->dirty &= ~dirty;
+    CO_UNLOCK_OD(storage->CANmodule);
+
+    if (dirty == 0) {
+        return;
+    }
+
+    size_t chunk = dirtyChunk(entry);
+    size_t base = entry->eepromAddr
+                - entry->eepromAddr % CO_CONFIG_STORAGE_PAGE_SIZE;
+    size_t end = entry->eepromAddr + entry->len;
+
+    for (uint8_t b = 0; b < 32; b++) {
+        if ((dirty & ((uint32_t)1 << b)) == 0) {
+            continue;
+        }
+        size_t addr = base + b * chunk;
+        size_t chunkEnd = addr + chunk;
+        if (addr < entry->eepromAddr) addr = entry->eepromAddr;
+        if (chunkEnd > end) chunkEnd = end;
+
+        /* one CO_eeprom_writeBlock() per page */
+        while (addr < chunkEnd) {
+            size_t pageEnd = addr - addr % CO_CONFIG_STORAGE_PAGE_SIZE
+                           + CO_CONFIG_STORAGE_PAGE_SIZE;
+            if (pageEnd > chunkEnd) pageEnd = chunkEnd;
+
+            if (!updatePage(entry, addr, pageEnd - addr)) {
+                /* try again later */
+                CO_LOCK_OD(storage->CANmodule);
+                entry->dirty |= (uint32_t)1 << b;
+                CO_UNLOCK_OD(storage->CANmodule);
+                break;
+            }
+            addr = pageEnd;
+        }
+    }
+}
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY */
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT
+/* Value of snapshotHeader_t::magic */
+#define CO_STORAGE_SNAPSHOT_MAGIC 0x5A3CU
+
+/* Header of the boot snapshot, followed by signatures of all entries, data of
+ * all entries without CO_storage_auto attribute and snapshot->extra. Crc is
+ * calculated over all data after the header. */
+typedef struct {
+    uint32_t layoutId;
+    uint32_t size;
+    uint16_t crc;
+    uint16_t magic;
+} snapshotHeader_t;
+
+/* Update CRC with data of len bytes (RAM layout of the target) */
+static uint16_t crcData(const void *data, size_t len, uint16_t crc) {
+#if (C2000_PORT != 0)
+    for (size_t i = 0; i < len / 2; i++) {
+        uint16_t word = ((const uint16_t *)data)[i];
+        crc16_ccitt_single(&crc, (uint8_t)(word & 0x00FF));
+        crc16_ccitt_single(&crc, (uint8_t)((word >> 8) & 0x00FF));
+    }
+    return crc;
+#else
+    return crc16_ccitt(data, len, crc);
+#endif
+}
+
+/* Size of the boot snapshot after the header, in bytes */
+static size_t snapshotDataSize(const CO_storage_entry_t *entries,
+                               uint8_t entriesCount,
+                               const CO_storageEeprom_snapshot_t *snapshot)
+{
+    size_t size = sizeof(uint32_t) * CO_STORAGE_AU * entriesCount
+                + snapshot->extraLen;
+
+    for (uint8_t i = 0; i < entriesCount; i++) {
+        if ((entries[i].attr & CO_storage_auto) == 0) {
+            size += entries[i].len;
+        }
+    }
+    return size;
+}
+
+/*
+ * Read boot snapshot into storage locations of all entries without
+ * CO_storage_auto attribute and into snapshot->extra. Snapshot is valid, if
+ * it was written with the same layoutId and the same signatures, as currently
+ * stored in eeprom, and CRC matches.
+ *
+ * @return true, if all data was read from valid snapshot.
+ */
+static bool_t readSnapshot(void *storageModule,
+                           CO_storage_entry_t *entries,
+                           uint8_t entriesCount,
+                           const uint32_t *signatures,
+                           CO_storageEeprom_snapshot_t *snapshot)
+{
+    snapshotHeader_t header;
+    uint16_t crc = 0;
+    size_t addr = snapshot->eepromAddr;
+
+    CO_eeprom_readBlock(storageModule, (uint8_t *)&header, addr,
+                        sizeof(header));
+    addr += sizeof(header) * CO_STORAGE_AU;
+    if (header.magic != CO_STORAGE_SNAPSHOT_MAGIC
+        || header.layoutId != snapshot->layoutId
+        || header.size != snapshotDataSize(entries, entriesCount, snapshot)
+    ) {
+        return false;
+    }
+
+    /* stored or restored entries after snapshot was written invalidate it */
+#if (C2000_PORT != 0)
+    uint32_t signaturesCopy[CO_CONFIG_STORAGE_MAX_ENTRIES];
+#else
+    uint32_t signaturesCopy[entriesCount];
+#endif
+    size_t signaturesLen = sizeof(uint32_t) * entriesCount;
+    CO_eeprom_readBlock(storageModule, (uint8_t *)signaturesCopy, addr,
+                        signaturesLen);
+    addr += signaturesLen * CO_STORAGE_AU;
+    if (memcmp(signaturesCopy, signatures, signaturesLen) != 0) {
+        return false;
+    }
+    crc = crcData(signaturesCopy, signaturesLen * CO_STORAGE_AU, crc);
+
+    /* data is contiguous in eeprom */
+    for (uint8_t i = 0; i < entriesCount; i++) {
+        CO_storage_entry_t *entry = &entries[i];
+        if ((entry->attr & CO_storage_auto) != 0) {
+            continue;
+        }
+        CO_eeprom_readBlock(storageModule, entry->addr, addr,
+                            entry->len / CO_STORAGE_AU);
+        addr += entry->len;
+        crc = crcData(entry->addr, entry->len, crc);
+    }
+    if (snapshot->extraLen > 0) {
+        CO_eeprom_readBlock(storageModule, snapshot->extra, addr,
+                            snapshot->extraLen / CO_STORAGE_AU);
+        crc = crcData(snapshot->extra, snapshot->extraLen, crc);
+    }
+
+    return crc == header.crc;
+}
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT */
+
+/*
+ * Read data of the entry from eeprom into storage location and verify CRC,
+ * except for auto storage variables.
+ *
+ * @return false, if data is corrupt.
+ */
+static bool_t loadEntry(CO_storage_entry_t *entry, bool_t isAuto) {
+    /* Read data into storage location */
+    CO_eeprom_readBlock(entry->storageModule, entry->addr,
+#if (C2000_PORT != 0)
+                        entry->eepromAddr, entry->len / 2);  // For C2000, length is in words, not bytes
+#else
+                        entry->eepromAddr, entry->len);
+#endif
+
+    /* Verify CRC, except for auto storage variables */
+    if (!isAuto) {
+#if (C2000_PORT != 0)
+        uint16_t crc = 0;
+        uint8_t chr = 0;
+        for(uint16_t j = 0; j < (entry->len / 2); j++) {
+            uint16_t word = ((uint16_t *)entry->addr)[j];
+            chr = word & 0x00FF;
+            crc16_ccitt_single(&crc, chr);
+            chr = (word >> 8) & 0x00FF;
+            crc16_ccitt_single(&crc, chr);
+        }
+#else
+        uint16_t crc = crc16_ccitt(entry->addr, entry->len, 0);
+#endif
+        if (crc != entry->crc) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Set bit of subIndexOD in storageInitError */
+static void setInitError(const CO_storage_entry_t *entry,
+                         uint32_t *storageInitError)
+{
+    uint32_t errorBit = entry->subIndexOD;
+    if (errorBit > 31) errorBit = 31;
+    *storageInitError |= ((uint32_t) 1) << errorBit;
+}
+
 /*
  * Function for writing data on "Store parameters" command - OD object 1010
  *
@@ -86,6 +339,10 @@ static ODR_t storeEeprom(CO_storage_entry_t *entry, CO_CANmodule_t *CANmodule) {
         return ODR_HW;
     }
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+    /* whole block is in eeprom now */
+    entry->dirty = 0;
+#endif
     return ODR_OK;
 }
 
@@ -130,6 +387,9 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
                                        OD_entry_t *OD_1011_RestoreDefaultParam,
                                        CO_storage_entry_t *entries,
                                        uint8_t entriesCount,
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT
+                                       CO_storageEeprom_snapshot_t *snapshot,
+#endif
                                        uint32_t *storageInitError)
 {
     CO_ReturnError_t ret;
@@ -223,45 +483,59 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
         if (signatureInEeprom != signatureOfEntry) {
             dataCorrupt = true;
         }
-        else {
-            /* Read data into storage location */
-            CO_eeprom_readBlock(entry->storageModule, entry->addr,
-#if (C2000_PORT != 0)
-                                entry->eepromAddr, entry->len / 2);  // For C2000, length is in words, not bytes
-#else
-                                entry->eepromAddr, entry->len);
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT
+        else if (snapshot != NULL && !isAuto) {
+            /* data will be loaded from the snapshot or below */
+        }
 #endif
+        else {
+            dataCorrupt = !loadEntry(entry, isAuto);
+        }
 
-            /* Verify CRC, except for auto storage variables */
-            if (!isAuto) {
-#if (C2000_PORT != 0)
-                uint16_t crc = 0;
-                uint8_t chr = 0;
-                for(uint16_t j = 0; j < (entry->len / 2); j++) {
-                    uint16_t word = ((uint16_t *)entry->addr)[j];
-                    chr = word & 0x00FF;
-                    crc16_ccitt_single(&crc, chr);
-                    chr = (word >> 8) & 0x00FF;
-                    crc16_ccitt_single(&crc, chr);
-                }
-#else
-                uint16_t crc = crc16_ccitt(entry->addr, entry->len, 0);
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+        /* data in eeprom equals data in storage location, if valid */
+        entry->dirty = (dataCorrupt && isAuto) ? 0xFFFFFFFF : 0;
 #endif
-                if (crc != entry->crc) {
-                    dataCorrupt = true;
-                }
-            }
-        }
 
         /* additional info in case of error */
         if (dataCorrupt) {
-            uint32_t errorBit = entry->subIndexOD;
-            if (errorBit > 31) errorBit = 31;
-            *storageInitError |= ((uint32_t) 1) << errorBit;
+            setInitError(entry, storageInitError);
             ret = CO_ERROR_DATA_CORRUPT;
         }
     } /* for (entries) */
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT
+    if (snapshot != NULL) {
+        snapshot->restored = false;
+        snapshot->eepromAddr = CO_eeprom_getAddr(storageModule, false,
+            sizeof(snapshotHeader_t) * CO_STORAGE_AU
+                + snapshotDataSize(entries, entriesCount, snapshot),
+            &eepromOvf);
+        if (eepromOvf) {
+            *storageInitError = entriesCount;
+            return CO_ERROR_OUT_OF_MEMORY;
+        }
+
+        /* snapshot contains valid signatures of entries, which it contains */
+        snapshot->restored = readSnapshot(storageModule, entries,
+                                          entriesCount, signatures, snapshot);
+
+        /* otherwise load entries one by one */
+        if (!snapshot->restored) {
+            for (uint8_t i = 0; i < entriesCount; i++) {
+                CO_storage_entry_t *entry = &entries[i];
+                if ((entry->attr & CO_storage_auto) == 0
+                    && (uint16_t)signatures[i] == (uint16_t)entry->len
+                    && !loadEntry(entry, false)
+                ) {
+                    setInitError(entry, storageInitError);
+                    ret = CO_ERROR_DATA_CORRUPT;
+                }
+            }
+        }
+    }
+#endif
+
     storage->enabled = true;
     return ret;
 }
@@ -280,6 +554,9 @@ void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll) {
         if ((entry->attr & CO_storage_auto) == 0)
             continue;
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+        autoProcessDirty(storage, entry, saveAll);
+#else
         if (saveAll) {
             /* update all bytes */
 #if (C2000_PORT != 0)
@@ -331,7 +608,126 @@ void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll) {
             }
 #endif
         }
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY */
+    }
+}
+
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+/******************************************************************************/
+void CO_storageEeprom_markDirty(CO_storage_t *storage,
+                                const void *addr,
+                                size_t len)
+{
+    const uint8_t *data = (const uint8_t *)addr;
+
+    /* verify arguments */
+    if (storage == NULL || data == NULL || len == 0) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &storage->entries[i];
+        const uint8_t *start = (const uint8_t *)entry->addr;
+
+        if ((entry->attr & CO_storage_auto) == 0 || data < start
+            || data >= start + entry->len / CO_STORAGE_AU
+        ) {
+            continue;
+        }
+
+        /* offsets of the first and the last changed byte in eeprom region */
+        size_t pageOffset = entry->eepromAddr % CO_CONFIG_STORAGE_PAGE_SIZE;
+        size_t chunk = dirtyChunk(entry);
+        size_t first = (size_t)(data - start) * CO_STORAGE_AU;
+        size_t last = first + len * CO_STORAGE_AU - 1;
+        if (last >= entry->len) last = entry->len - 1;
+
+        for (size_t b = (first + pageOffset) / chunk;
+             b <= (last + pageOffset) / chunk; b++
+        ) {
+            entry->dirty |= (uint32_t)1 << b;
+        }
+        return;
+    }
+}
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY */
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT
+/******************************************************************************/
+CO_ReturnError_t CO_storageEeprom_writeSnapshot(
+    CO_storage_t *storage,
+    const CO_storageEeprom_snapshot_t *snapshot)
+{
+    snapshotHeader_t header;
+    uint32_t signature;
+    bool_t writeOk = true;
+
+    /* verify arguments */
+    if (storage == NULL || !storage->enabled || snapshot == NULL
+        || (snapshot->extra == NULL && snapshot->extraLen > 0)
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    void *storageModule = storage->entries[0].storageModule;
+    size_t addr = snapshot->eepromAddr + sizeof(header) * CO_STORAGE_AU;
+    header.crc = 0;
+
+    /* signatures, must be valid and equal to the data in storage locations */
+    for (uint8_t i = 0; i < storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &storage->entries[i];
+
+        CO_eeprom_readBlock(storageModule, (uint8_t *)&signature,
+                            entry->eepromAddrSignature, sizeof(signature));
+        if ((entry->attr & CO_storage_auto) == 0
+            && (signature != ((((uint32_t)entry->crc) << 16)
+                              | (uint16_t)entry->len)
+                || crcData(entry->addr, entry->len, 0) != entry->crc)
+        ) {
+            return CO_ERROR_DATA_CORRUPT;
+        }
+        writeOk &= CO_eeprom_writeBlock(storageModule, (uint8_t *)&signature,
+                                        addr, sizeof(signature));
+        addr += sizeof(signature) * CO_STORAGE_AU;
+        header.crc = crcData(&signature, sizeof(signature) * CO_STORAGE_AU,
+                             header.crc);
+    }
+
+    for (uint8_t i = 0; i < storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &storage->entries[i];
+        if ((entry->attr & CO_storage_auto) != 0) {
+            continue;
+        }
+        writeOk &= CO_eeprom_writeBlock(storageModule, entry->addr, addr,
+                                        entry->len / CO_STORAGE_AU);
+        addr += entry->len;
+        header.crc = crcData(entry->addr, entry->len, header.crc);
+    }
+    if (snapshot->extraLen > 0) {
+        writeOk &= CO_eeprom_writeBlock(storageModule, snapshot->extra, addr,
+                                        snapshot->extraLen / CO_STORAGE_AU);
+        header.crc = crcData(snapshot->extra, snapshot->extraLen, header.crc);
+    }
+
+    /* header is written last */
+    header.layoutId = snapshot->layoutId;
+    header.size = (uint32_t)snapshotDataSize(storage->entries,
+                                             storage->entriesCount, snapshot);
+    header.magic = CO_STORAGE_SNAPSHOT_MAGIC;
+    writeOk &= CO_eeprom_writeBlock(storageModule, (uint8_t *)&header,
+                                    snapshot->eepromAddr, sizeof(header));
+
+    if (!writeOk
+        || CO_eeprom_getCrcBlock(storageModule,
+                                 snapshot->eepromAddr
+                                     + sizeof(header) * CO_STORAGE_AU,
+                                 header.size / CO_STORAGE_AU) != header.crc
+    ) {
+        return CO_ERROR_DATA_CORRUPT;
     }
+    return CO_ERROR_NO;
 }
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT */
 
 #endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE */
@@ -36,6 +36,10 @@
   #endif
 #endif
 
+#ifndef CO_CONFIG_STORAGE_PAGE_SIZE
+#define CO_CONFIG_STORAGE_PAGE_SIZE 64
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -76,7 +80,66 @@ extern "C" {
  * are stored into write unprotected location. For auto storage to work,
  * its signature in eeprom must be correct. CRC checksum for the data is not
  * used.
+ *
+ * With CO_CONFIG_STORAGE_AUTO_DIRTY automatic storage does not compare eeprom
+ * byte by byte. Changed data must be marked with
+ * CO_storageEeprom_markDirty(), usually from @ref OD_WRITE_HOOK, which is
+ * called on each write into OD variable, for example in CO_driver_target.h:
+ * \code{.c}
+extern CO_storage_t storage;
+#define OD_WRITE_HOOK(dataOrig, count) \
+    CO_storageEeprom_markDirty(&storage, dataOrig, count)
+ * \endcode
+ * Each entry has 32 bit dirty mask, one bit for one eeprom page of
+ * @ref CO_CONFIG_STORAGE_PAGE_SIZE or for a group of pages for larger entries.
+ * CO_storageEeprom_auto_process() reads each dirty page and writes it with
+ * one CO_eeprom_writeBlock(), if it differs. Application must also mark data,
+ * which it changes directly, not through OD interface.
+ *
+ * With CO_CONFIG_STORAGE_SNAPSHOT optional boot snapshot is used for faster
+ * startup. It is a contiguous copy of all entries without CO_storage_auto
+ * attribute and of application data (usually PDO mapping from
+ * CO_getPDOmapCache()), protected by single CRC. It is valid only, if
+ * signatures of all entries did not change since it was written, so it is
+ * invalidated by each store or restore command. Example:
+ * \code{.c}
+static CO_PDO_mapCache_t PDOmapCache[OD_CNT_RPDO + OD_CNT_TPDO];
+CO_storageEeprom_snapshot_t snapshot = {
+    .layoutId = FIRMWARE_BUILD_ID,
+    .extra = PDOmapCache,
+    .extraLen = sizeof(PDOmapCache)
+};
+CO_storageEeprom_init(..., &snapshot, &storageInitError);
+...
+CO->PDOmapCache = snapshot.restored ? PDOmapCache : NULL;
+CO_CANopenInitPDO(...);
+if (!snapshot.restored) {
+    CO_getPDOmapCache(CO, OD, PDOmapCache);
+    CO_storageEeprom_writeSnapshot(&storage, &snapshot);
+}
+ * \endcode
+ */
+
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT) || defined CO_DOXYGEN
+/**
+ * Boot snapshot, used with CO_CONFIG_STORAGE_SNAPSHOT
  */
+typedef struct {
+    /** Identifier of firmware and Object Dictionary layout, set by
+     * application. Snapshot written with different layoutId is not used. */
+    uint32_t layoutId;
+    /** Additional application data, stored into snapshot and read from valid
+     * snapshot, set by application. May be NULL. */
+    void *extra;
+    /** Length of extra in bytes, set by application. */
+    size_t extraLen;
+    /** Address of snapshot inside eeprom, set by init. */
+    size_t eepromAddr;
+    /** True, if data was read from valid snapshot, set by init. */
+    bool_t restored;
+} CO_storageEeprom_snapshot_t;
+#endif
 
 
 /**
@@ -98,6 +161,9 @@ extern "C" {
  * parameters". Entry is optional, may be NULL.
  * @param entries Pointer to array of storage entries, see @ref CO_storage_init.
  * @param entriesCount Count of storage entries
+ * @param snapshot Boot snapshot, may be NULL. If valid, data of entries
+ * without CO_storage_auto attribute is read from it. Used with
+ * CO_CONFIG_STORAGE_SNAPSHOT.
  * @param [out] storageInitError If function returns CO_ERROR_DATA_CORRUPT,
  * then this variable contains a bit mask from subIndexOD values, where data
  * was not properly initialized. If other error, then this variable contains
@@ -115,6 +181,9 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
                                        OD_entry_t *OD_1011_RestoreDefaultParam,
                                        CO_storage_entry_t *entries,
                                        uint8_t entriesCount,
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT) || defined CO_DOXYGEN
+                                       CO_storageEeprom_snapshot_t *snapshot,
+#endif
                                        uint32_t *storageInitError);
 
 
@@ -122,12 +191,53 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
  * Automatically update data if differs inside eeprom.
  *
  * Should be called cyclically by program. Each interval it updates one byte.
+ * With CO_CONFIG_STORAGE_AUTO_DIRTY it updates dirty pages of one bit from
+ * the dirty mask of each entry, each page with blocking CO_eeprom_writeBlock().
  *
  * @param storage This object
  * @param saveAll If true, all bytes are updated, useful on program end.
  */
 void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll);
 
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY) || defined CO_DOXYGEN
+/**
+ * Mark data of automatic storage as changed.
+ *
+ * Data, which is not inside any automatic storage entry, is ignored. Must be
+ * called inside CO_LOCK_OD() section, like other OD access. OD interface
+ * calls it from @ref OD_WRITE_HOOK, if defined so.
+ *
+ * @param storage This object
+ * @param addr Address of changed data
+ * @param len Length of changed data
+ */
+void CO_storageEeprom_markDirty(CO_storage_t *storage,
+                                const void *addr,
+                                size_t len);
+#endif
+
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_SNAPSHOT) || defined CO_DOXYGEN
+/**
+ * Write boot snapshot into eeprom.
+ *
+ * Should be called by application after startup, if snapshot was not
+ * restored, after extra data is prepared. Data of all entries without
+ * CO_storage_auto attribute must be equal to the data stored in eeprom, so
+ * function must be called before any change of those data.
+ *
+ * @param storage This object
+ * @param snapshot Snapshot, passed to CO_storageEeprom_init().
+ *
+ * @return CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or CO_ERROR_DATA_CORRUPT, if
+ * data is not stored or eeprom write failed.
+ */
+CO_ReturnError_t CO_storageEeprom_writeSnapshot(
+    CO_storage_t *storage,
+    const CO_storageEeprom_snapshot_t *snapshot);
+#endif
+
 /** @} */ /* CO_storage_eeprom */
 
 #ifdef __cplusplus
@@ -0,0 +1,623 @@
+/*
+ * CANopen data storage object for storing data into flash memory
+ *
+ * @file        CO_storageFlash.c
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <stddef.h>
+
+#include "storage/CO_storageFlash.h"
+#include "storage/CO_flash.h"
+#include "301/crc16-ccitt.h"
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
+
+#if CO_CONFIG_STORAGE_FLASH_BUF_SIZE % CO_CONFIG_STORAGE_FLASH_ALIGN != 0
+#error CO_CONFIG_STORAGE_FLASH_BUF_SIZE must be multiple of CO_CONFIG_STORAGE_FLASH_ALIGN
+#endif
+
+/* Length of entry data in address units (16 bit char on C2000) */
+#if (C2000_PORT != 0)
+#define LEN_AU(len) ((len) / 2)
+#else
+#define LEN_AU(len) (len)
+#endif
+
+/* Value of entry->flashAddr, if entry has no record */
+#define FLASH_ADDR_NONE ((size_t)-1)
+
+/* First value in each used sector, "COFL" */
+#define SECTOR_MAGIC 0x4C464F43UL
+
+/* Header at the beginning of each used sector, check equals ~sequence */
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t check;
+} sectorHeader_t;
+
+/* Header at the beginning of each record. Record without data (len = 0) is
+ * written on restore default parameters. */
+typedef struct {
+    uint16_t len;
+    uint8_t subIndexOD;
+    uint8_t reserved;
+    uint16_t crcHeader;
+} recordHeader_t;
+
+/* Trailer at the end of each record, programmed last. Record is valid only,
+ * if check equals ~crc. */
+typedef struct {
+    uint16_t crc;
+    uint16_t check;
+} recordTrailer_t;
+
+
+static size_t alignUp(size_t size) {
+    return (size + CO_CONFIG_STORAGE_FLASH_ALIGN - 1)
+           / CO_CONFIG_STORAGE_FLASH_ALIGN * CO_CONFIG_STORAGE_FLASH_ALIGN;
+}
+
+static size_t recordSize(size_t lenAU) {
+    return alignUp(sizeof(recordHeader_t)) + alignUp(lenAU)
+           + alignUp(sizeof(recordTrailer_t));
+}
+
+/* Continue CRC calculation over data with length in address units */
+static uint16_t crcUpdate(uint16_t crc, const uint8_t *data, size_t lenAU) {
+#if (C2000_PORT != 0)
+    for (size_t i = 0; i < lenAU; i++) {
+        uint16_t word = ((const uint16_t *)data)[i];
+        crc16_ccitt_single(&crc, word & 0x00FF);
+        crc16_ccitt_single(&crc, (word >> 8) & 0x00FF);
+    }
+    return crc;
+#else
+    return crc16_ccitt(data, lenAU, crc);
+#endif
+}
+
+/* Calculate CRC of the data inside flash */
+static uint16_t crcFlash(CO_storageFlash_t *flash,
+                         size_t flashAddr, size_t lenAU)
+{
+    uint8_t buf[CO_CONFIG_STORAGE_FLASH_BUF_SIZE];
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < lenAU; i += sizeof(buf)) {
+        size_t n = lenAU - i;
+        if (n > sizeof(buf)) n = sizeof(buf);
+        CO_flash_read(flash->storageModule, buf, flashAddr + i, n);
+        crc = crcUpdate(crc, buf, n);
+    }
+    return crc;
+}
+
+/* Program small object, padded with 0xFF to the aligned size */
+static bool_t programPadded(CO_storageFlash_t *flash, size_t flashAddr,
+                            const void *object, size_t size)
+{
+    uint8_t buf[CO_CONFIG_STORAGE_FLASH_BUF_SIZE];
+
+    memset(buf, 0xFF, sizeof(buf));
+    memcpy(buf, object, size);
+    return CO_flash_program(flash->storageModule, buf,
+                            flashAddr, alignUp(size));
+}
+
+static bool_t readSectorHeader(CO_storageFlash_t *flash, uint16_t sector,
+                               sectorHeader_t *sh)
+{
+    CO_flash_read(flash->storageModule, (uint8_t *)sh,
+                  (size_t)sector * flash->sectorSize, sizeof(*sh));
+    return sh->magic == SECTOR_MAGIC && sh->check == ~sh->sequence;
+}
+
+static CO_storage_entry_t *findEntry(CO_storageFlash_t *flash,
+                                     uint8_t subIndexOD)
+{
+    for (uint8_t i = 0; i < flash->storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &flash->storage->entries[i];
+        if (entry->subIndexOD == subIndexOD) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool_t openSector(CO_storageFlash_t *flash);
+
+/*
+ * Append record to the head sector
+ *
+ * Data is copied from the storage location, if srcFlashAddr is
+ * FLASH_ADDR_NONE, or from the existing record at srcFlashAddr. If len is
+ * zero, record without data is appended. In any case entry->flashAddr and
+ * entry->crc are updated on success.
+ *
+ * @return false on flash error.
+ */
+static bool_t appendRecord(CO_storageFlash_t *flash, CO_storage_entry_t *entry,
+                           size_t len, size_t srcFlashAddr)
+{
+    uint8_t buf[CO_CONFIG_STORAGE_FLASH_BUF_SIZE];
+    size_t lenAU = LEN_AU(len);
+    size_t size = recordSize(lenAU);
+
+    if (flash->writeOffset + size > flash->sectorSize) {
+        /* Sector after head contains record, which is being copied. */
+        if (srcFlashAddr != FLASH_ADDR_NONE || !openSector(flash)
+            || flash->writeOffset + size > flash->sectorSize
+        ) {
+            return false;
+        }
+    }
+
+    size_t flashAddr = (size_t)flash->head * flash->sectorSize
+                     + flash->writeOffset;
+    size_t dataAddr = flashAddr + alignUp(sizeof(recordHeader_t));
+    /* area is used, even if programming fails */
+    flash->writeOffset += size;
+
+    recordHeader_t header;
+    header.len = (uint16_t)len;
+    header.subIndexOD = entry->subIndexOD;
+    header.reserved = 0xFF;
+    header.crcHeader = crcUpdate(0, (uint8_t *)&header,
+                                 offsetof(recordHeader_t, crcHeader));
+    bool_t ok = programPadded(flash, flashAddr, &header, sizeof(header));
+
+    /* Copy the data through the buffer, calculate CRC from the same buffer */
+    uint16_t crc = 0;
+    for (size_t i = 0; i < lenAU && ok; i += sizeof(buf)) {
+        size_t n = lenAU - i;
+        if (n > sizeof(buf)) n = sizeof(buf);
+
+        if (srcFlashAddr == FLASH_ADDR_NONE) {
+            memcpy(buf, (uint8_t *)entry->addr + i, n);
+        }
+        else {
+            CO_flash_read(flash->storageModule, buf,
+                          srcFlashAddr + alignUp(sizeof(recordHeader_t)) + i,
+                          n);
+        }
+        crc = crcUpdate(crc, buf, n);
+        memset(&buf[n], 0xFF, alignUp(n) - n);
+        ok = CO_flash_program(flash->storageModule, buf,
+                              dataAddr + i, alignUp(n));
+    }
+
+    /* Copy keeps original CRC, so corrupted data stays detectable */
+    if (srcFlashAddr != FLASH_ADDR_NONE) {
+        crc = entry->crc;
+    }
+
+    if (ok && crcFlash(flash, dataAddr, lenAU) == crc) {
+        recordTrailer_t trailer;
+        trailer.crc = crc;
+        trailer.check = (uint16_t)~crc;
+        ok = programPadded(flash,
+                           flashAddr + size - alignUp(sizeof(trailer)),
+                           &trailer, sizeof(trailer));
+    }
+    else {
+        ok = false;
+    }
+
+    if (ok) {
+        entry->flashAddr = len > 0 ? flashAddr : FLASH_ADDR_NONE;
+        entry->crc = crc;
+        /* flash works again, give failed sector erase new chance */
+        if (srcFlashAddr == FLASH_ADDR_NONE) {
+            flash->eraseRetries = 0;
+        }
+    }
+    return ok;
+}
+
+/*
+ * Copy live records (newest record of each entry) out of the sector into the
+ * head sector. Failed copy is retried once, if there is space for it. Record
+ * with corrupt data can not be copied, it is dropped and reported in
+ * flash->dataCorrupt.
+ *
+ * @return true, if no live record is left in the sector, so it may be erased.
+ */
+static bool_t copyLive(CO_storageFlash_t *flash, uint16_t sector) {
+    bool_t ok = true;
+
+    for (uint8_t i = 0; i < flash->storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &flash->storage->entries[i];
+
+        if (entry->flashAddr == FLASH_ADDR_NONE
+            || entry->flashAddr / flash->sectorSize != sector
+        ) {
+            continue;
+        }
+        if (crcFlash(flash, entry->flashAddr + alignUp(sizeof(recordHeader_t)),
+                     LEN_AU(entry->len)) != entry->crc
+        ) {
+            uint32_t errorBit = entry->subIndexOD;
+            if (errorBit > 31) errorBit = 31;
+            flash->dataCorrupt |= ((uint32_t) 1) << errorBit;
+            entry->flashAddr = FLASH_ADDR_NONE;
+            continue;
+        }
+        if (!appendRecord(flash, entry, entry->len, entry->flashAddr)
+            && !appendRecord(flash, entry, entry->len, entry->flashAddr)
+        ) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/*
+ * Open next sector for records
+ *
+ * Next sector is erased, if necessary. Then live records from the oldest
+ * sector (after the new head) are copied into it, so the oldest sector can be
+ * erased by CO_storageFlash_process().
+ *
+ * @return false on flash error.
+ */
+static bool_t openSector(CO_storageFlash_t *flash) {
+    uint16_t next = (uint16_t)((flash->head + 1) % flash->sectorCount);
+    size_t sectorAddr = (size_t)next * flash->sectorSize;
+
+    /* next sector still contains live records, if their copying failed */
+    if (!flash->spareErased
+        && (!copyLive(flash, next)
+            || !CO_flash_erase(flash->storageModule, sectorAddr))
+    ) {
+        return false;
+    }
+    flash->spareErased = false;
+
+    sectorHeader_t sh;
+    sh.magic = SECTOR_MAGIC;
+    sh.sequence = flash->sequence + 1;
+    sh.check = ~sh.sequence;
+    if (!programPadded(flash, sectorAddr, &sh, sizeof(sh))) {
+        return false;
+    }
+    flash->head = next;
+    flash->sequence = sh.sequence;
+    flash->writeOffset = alignUp(sizeof(sh));
+
+    /* copy live records from the oldest sector */
+    return copyLive(flash, (uint16_t)((next + 1) % flash->sectorCount));
+}
+
+/* Returns true, if newest record of the entry contains the same data */
+static bool_t recordEqual(CO_storageFlash_t *flash, CO_storage_entry_t *entry) {
+    uint8_t buf[CO_CONFIG_STORAGE_FLASH_BUF_SIZE];
+    size_t lenAU = LEN_AU(entry->len);
+
+    if (entry->flashAddr == FLASH_ADDR_NONE) {
+        return false;
+    }
+
+    size_t dataAddr = entry->flashAddr + alignUp(sizeof(recordHeader_t));
+    for (size_t i = 0; i < lenAU; i += sizeof(buf)) {
+        size_t n = lenAU - i;
+        if (n > sizeof(buf)) n = sizeof(buf);
+        CO_flash_read(flash->storageModule, buf, dataAddr + i, n);
+        if (memcmp(buf, (uint8_t *)entry->addr + i, n) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * Function for writing data on "Store parameters" command - OD object 1010
+ *
+ * For more information see file CO_storage.h, CO_storage_entry_t.
+ */
+static ODR_t storeFlash(CO_storage_entry_t *entry, CO_CANmodule_t *CANmodule) {
+    (void) CANmodule;
+    CO_storageFlash_t *flash = (CO_storageFlash_t *)entry->flashLog;
+
+    if (recordEqual(flash, entry)) {
+        return ODR_OK;
+    }
+    return appendRecord(flash, entry, entry->len, FLASH_ADDR_NONE)
+           ? ODR_OK : ODR_HW;
+}
+
+
+/*
+ * Function for restoring data on "Restore default parameters" command - OD 1011
+ *
+ * For more information see file CO_storage.h, CO_storage_entry_t.
+ */
+static ODR_t restoreFlash(CO_storage_entry_t *entry,
+                          CO_CANmodule_t *CANmodule)
+{
+    (void) CANmodule;
+    CO_storageFlash_t *flash = (CO_storageFlash_t *)entry->flashLog;
+
+    if (entry->flashAddr == FLASH_ADDR_NONE) {
+        return ODR_OK;
+    }
+    return appendRecord(flash, entry, 0, FLASH_ADDR_NONE) ? ODR_OK : ODR_HW;
+}
+
+
+/*
+ * Scan records of one sector and update index of newest records in entries
+ *
+ * @return offset after the last record.
+ */
+static size_t scanSector(CO_storageFlash_t *flash, uint16_t sector) {
+    size_t sectorAddr = (size_t)sector * flash->sectorSize;
+    size_t offset = alignUp(sizeof(sectorHeader_t));
+    size_t end = offset;
+    bool_t damaged = false;
+
+    while (offset + recordSize(0) <= flash->sectorSize) {
+        recordHeader_t header;
+        CO_flash_read(flash->storageModule, (uint8_t *)&header,
+                      sectorAddr + offset, sizeof(header));
+
+        /* end of records, if header is erased */
+        const uint8_t *h = (const uint8_t *)&header;
+        bool_t erased = true;
+        for (size_t i = 0; i < sizeof(header); i++) {
+            if (h[i] != 0xFF) erased = false;
+        }
+        if (erased) {
+            if (!damaged) {
+                break;
+            }
+            /* search for the next record after the damaged one */
+            offset += CO_CONFIG_STORAGE_FLASH_ALIGN;
+            continue;
+        }
+
+        size_t size = recordSize(LEN_AU(header.len));
+        if (header.crcHeader != crcUpdate(0, (uint8_t *)&header,
+                                offsetof(recordHeader_t, crcHeader))
+            || offset + size > flash->sectorSize
+        ) {
+            /* Damaged header, programming failed or was interrupted. Area of
+             * the whole record was used, so next record follows after
+             * erased data, or directly after the header, if it was
+             * appended after reboot. */
+            damaged = true;
+            offset += CO_CONFIG_STORAGE_FLASH_ALIGN;
+            end = offset;
+            continue;
+        }
+        damaged = false;
+
+        recordTrailer_t trailer;
+        CO_flash_read(flash->storageModule, (uint8_t *)&trailer,
+                      sectorAddr + offset + size - alignUp(sizeof(trailer)),
+                      sizeof(trailer));
+        CO_storage_entry_t *entry = findEntry(flash, header.subIndexOD);
+        if (entry != NULL && trailer.check == (uint16_t)~trailer.crc) {
+            entry->flashAddr = header.len > 0 ? sectorAddr + offset
+                                              : FLASH_ADDR_NONE;
+            entry->crc = trailer.crc;
+        }
+        offset += size;
+        end = offset;
+    }
+    return end;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_storageFlash_init(CO_storage_t *storage,
+                                      CO_storageFlash_t *flash,
+                                      CO_CANmodule_t *CANmodule,
+                                      void *storageModule,
+                                      OD_entry_t *OD_1010_StoreParameters,
+                                      OD_entry_t *OD_1011_RestoreDefaultParam,
+                                      CO_storage_entry_t *entries,
+                                      uint8_t entriesCount,
+                                      uint32_t *storageInitError)
+{
+    CO_ReturnError_t ret;
+
+    /* verify arguments */
+    if (storage == NULL || flash == NULL || entries == NULL
+        || entriesCount == 0 || storageInitError == NULL
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    storage->enabled = false;
+    memset(flash, 0, sizeof(CO_storageFlash_t));
+    flash->storage = storage;
+    flash->storageModule = storageModule;
+
+    /* Initialize storage hardware */
+    if (!CO_flash_init(storageModule, &flash->sectorSize, &flash->sectorCount)
+        || flash->sectorCount < 2
+        || flash->sectorSize % CO_CONFIG_STORAGE_FLASH_ALIGN != 0
+    ) {
+        *storageInitError = 0xFFFFFFFF;
+        return CO_ERROR_DATA_CORRUPT;
+    }
+
+    /* initialize storage and OD extensions */
+    ret = CO_storage_init(storage,
+                          CANmodule,
+                          OD_1010_StoreParameters,
+                          OD_1011_RestoreDefaultParam,
+                          storeFlash,
+                          restoreFlash,
+                          entries,
+                          entriesCount);
+    if (ret != CO_ERROR_NO) {
+        return ret;
+    }
+
+    /* verify entries. All live records and one more must fit into sector */
+    size_t sizeAll = alignUp(sizeof(sectorHeader_t));
+    size_t sizeMax = 0;
+    for (uint8_t i = 0; i < entriesCount; i++) {
+        CO_storage_entry_t *entry = &entries[i];
+
+        if (entry->addr == NULL || entry->len == 0 || entry->len > 0xFFFF
+            || entry->subIndexOD < 2
+        ) {
+            *storageInitError = i;
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+        entry->flashLog = flash;
+        entry->flashAddr = FLASH_ADDR_NONE;
+        entry->crc = 0;
+
+        size_t size = recordSize(LEN_AU(entry->len));
+        sizeAll += size;
+        if (size > sizeMax) sizeMax = size;
+        if (sizeAll + sizeMax > flash->sectorSize) {
+            *storageInitError = i;
+            return CO_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    /* head is the sector with the highest sequence number */
+    bool_t found = false;
+    for (uint16_t s = 0; s < flash->sectorCount; s++) {
+        sectorHeader_t sh;
+        if (readSectorHeader(flash, s, &sh)
+            && (!found || sh.sequence > flash->sequence)
+        ) {
+            flash->head = s;
+            flash->sequence = sh.sequence;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        /* empty flash, first record will open sector 0 */
+        flash->head = flash->sectorCount - 1;
+        flash->writeOffset = flash->sectorSize;
+    }
+    else {
+        /* scan sectors from the oldest to the head, newer records override */
+        for (uint16_t k = 1; k <= flash->sectorCount; k++) {
+            uint16_t s = (uint16_t)((flash->head + k) % flash->sectorCount);
+            sectorHeader_t sh;
+            if (readSectorHeader(flash, s, &sh)) {
+                size_t offset = scanSector(flash, s);
+                if (s == flash->head) {
+                    flash->writeOffset = offset;
+                }
+            }
+        }
+
+        /* Oldest sector may not be erased yet. Copy its live records, if
+         * copying was interrupted. */
+        copyLive(flash, (uint16_t)((flash->head + 1) % flash->sectorCount));
+    }
+
+    /* read newest data into storage locations */
+    *storageInitError = 0;
+    for (uint8_t i = 0; i < entriesCount; i++) {
+        CO_storage_entry_t *entry = &entries[i];
+        bool_t dataCorrupt = true;
+
+        if (entry->flashAddr != FLASH_ADDR_NONE) {
+            recordHeader_t header;
+            CO_flash_read(storageModule, (uint8_t *)&header,
+                          entry->flashAddr, sizeof(header));
+            if (header.len == entry->len) {
+                size_t lenAU = LEN_AU(entry->len);
+                CO_flash_read(storageModule, entry->addr,
+                              entry->flashAddr
+                              + alignUp(sizeof(recordHeader_t)),
+                              lenAU);
+                dataCorrupt = crcUpdate(0, entry->addr, lenAU) != entry->crc;
+            }
+        }
+
+        /* additional info in case of error */
+        if (dataCorrupt) {
+            uint32_t errorBit = entry->subIndexOD;
+            if (errorBit > 31) errorBit = 31;
+            *storageInitError |= ((uint32_t) 1) << errorBit;
+            ret = CO_ERROR_DATA_CORRUPT;
+        }
+    }
+
+    storage->enabled = true;
+    return ret;
+}
+
+
+/******************************************************************************/
+void CO_storageFlash_process(CO_storageFlash_t *flash, bool_t saveAll) {
+    if (flash == NULL || flash->storage == NULL || !flash->storage->enabled) {
+        return;
+    }
+
+    /* erase the sector after head, live records were copied out of it or
+     * copying is repeated, if it failed. Each failed copy uses space in the
+     * head sector, so number of retries is limited until the next store. */
+    if (!flash->spareErased
+        && flash->eraseRetries < CO_CONFIG_STORAGE_FLASH_ERASE_RETRIES
+    ) {
+        uint16_t spare = (uint16_t)((flash->head + 1) % flash->sectorCount);
+        if (copyLive(flash, spare)
+            && CO_flash_erase(flash->storageModule,
+                              (size_t)spare * flash->sectorSize)
+        ) {
+            flash->spareErased = true;
+            flash->eraseRetries = 0;
+        }
+        else {
+            flash->eraseRetries++;
+        }
+        if (!saveAll) {
+            return;
+        }
+    }
+
+    /* append records of changed automatic entries */
+    for (uint8_t i = 0; i < flash->storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &flash->storage->entries[i];
+
+        if ((entry->attr & CO_storage_auto) == 0) {
+            continue;
+        }
+
+        /* entry must be stored once with OD 1010 */
+        if (entry->flashAddr == FLASH_ADDR_NONE
+            || crcUpdate(0, entry->addr, LEN_AU(entry->len)) == entry->crc
+        ) {
+            continue;
+        }
+        appendRecord(flash, entry, entry->len, FLASH_ADDR_NONE);
+        if (!saveAll) {
+            return;
+        }
+    }
+}
+
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE */
@@ -0,0 +1,187 @@
+/**
+ * CANopen data storage object for storing data into flash memory
+ *
+ * @file        CO_storageFlash.h
+ * @ingroup     CO_storage_flash
+ * @author      CANopenNode contributors
+ * @copyright   2026 CANopenNode contributors
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_STORAGE_FLASH_H
+#define CO_STORAGE_FLASH_H
+
+#include "storage/CO_storage.h"
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE) || defined CO_DOXYGEN
+
+#ifndef CO_CONFIG_STORAGE_FLASH_ALIGN
+#define CO_CONFIG_STORAGE_FLASH_ALIGN 8
+#endif
+#ifndef CO_CONFIG_STORAGE_FLASH_BUF_SIZE
+#define CO_CONFIG_STORAGE_FLASH_BUF_SIZE 64
+#endif
+#ifndef CO_CONFIG_STORAGE_FLASH_ERASE_RETRIES
+#define CO_CONFIG_STORAGE_FLASH_ERASE_RETRIES 3
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_storage_flash Data storage in flash
+ * Log-structured data storage for NOR flash.
+ *
+ * @ingroup CO_CANopen_storage
+ * @{
+ *
+ * This is an interface into generic CANopenNode @ref CO_storage for usage with
+ * flash memory, where erase of the sector is much slower than programming.
+ * Functions @ref CO_storageFlash_init() and @ref CO_storageFlash_process() are
+ * target system independent. Functions specified by @ref CO_flash.h file,
+ * must be defined by target system.
+ *
+ * Storage principle:
+ * Data is never rewritten in place. Flash area is used as a ring of sectors,
+ * each starts with a header with sequence number. Each store of the entry
+ * appends a record with copy of the data to the end of the newest sector:
+ * record header (length, subIndexOD, CRC of the header), data and trailer
+ * with CRC of the data. Data is copied into flash through small buffer and
+ * its CRC is calculated from the same buffer in one pass, so record is always
+ * consistent, even if data changes during store. Trailer is programmed last,
+ * so record interrupted by power loss is ignored. If programming fails, area
+ * of the record stays used and startup scan continues with the next record
+ * after it. Sector is never erased, while it contains live records, failed
+ * copies are repeated by CO_storageFlash_process() up to
+ * CO_CONFIG_STORAGE_FLASH_ERASE_RETRIES times, then again after the next
+ * successful store. Live record with corrupt data can not be copied, it is
+ * dropped and reported in CO_storageFlash_t::dataCorrupt. Record is not
+ * appended, if newest record already contains the same data. Restore default parameters appends an empty record,
+ * so entry has no data on next startup.
+ *
+ * If record does not fit into the newest sector, next sector is opened. Live
+ * records (newest record of each entry) from the sector after it (the oldest
+ * sector) are copied to the new sector and the oldest sector is erased later,
+ * in CO_storageFlash_process(). So store usually takes only a few flash
+ * programs. Sector erase is done during store only, if
+ * CO_storageFlash_process() had no chance to erase it before.
+ *
+ * On startup only record headers and trailers are read to find the newest
+ * record of each entry. Then data of that record is read into storage
+ * location and verified with CRC. If there is no valid record for entry, data
+ * for that entry is indicated as corrupt and CANopen emergency message is
+ * sent.
+ *
+ * Size of all records of all entries together with the size of the largest
+ * record must fit into one sector.
+ *
+ * If entry attribute has CO_storage_auto set, then CO_storageFlash_process()
+ * appends new record, when CRC of the data changes. For auto storage to work,
+ * entry must have valid record, so it must be stored once via object 0x1010.
+ */
+
+
+/**
+ * Flash storage object.
+ *
+ * Holds state of the log, used by the functions in this file only.
+ */
+typedef struct {
+    CO_storage_t *storage; /**< From CO_storageFlash_init() */
+    void *storageModule; /**< From CO_storageFlash_init() */
+    size_t sectorSize; /**< Size of the sector, from CO_flash_init() */
+    uint16_t sectorCount; /**< Number of sectors, from CO_flash_init() */
+    uint16_t head; /**< Sector, where records are appended */
+    size_t writeOffset; /**< Offset of the next record inside head sector */
+    uint32_t sequence; /**< Sequence number of the head sector */
+    bool_t spareErased; /**< True, if sector after head sector is erased */
+    uint8_t eraseRetries; /**< Failed erase attempts in process function */
+    /** Bit mask from subIndexOD values (as storageInitError from
+     * CO_storageFlash_init()) of entries, whose record had corrupt data and
+     * was dropped, while copied out of the oldest sector. Entry must be
+     * stored again. May be read and cleared by application. */
+    uint32_t dataCorrupt;
+} CO_storageFlash_t;
+
+
+/**
+ * Initialize data storage object (flash specific)
+ *
+ * This function should be called by application after the program startup,
+ * before @ref CO_CANopenInit(). This function initializes storage object,
+ * OD extensions on objects 1010 and 1011, scans the flash, loads newest data,
+ * verifies them and writes data to addresses specified inside entries. This
+ * function internally calls @ref CO_storage_init().
+ *
+ * @param storage This object will be initialized. It must be defined by
+ * application and must exist permanently.
+ * @param flash Flash storage object, will be initialized. It must be defined
+ * by application and must exist permanently.
+ * @param CANmodule CAN device, used for @ref CO_LOCK_OD() macro.
+ * @param storageModule Pointer to storage module passed to CO_flash functions.
+ * @param OD_1010_StoreParameters OD entry for 0x1010 -"Store parameters".
+ * Entry is optional, may be NULL.
+ * @param OD_1011_RestoreDefaultParam OD entry for 0x1011 -"Restore default
+ * parameters". Entry is optional, may be NULL.
+ * @param entries Pointer to array of storage entries, see @ref CO_storage_init.
+ * Entries must have unique subIndexOD.
+ * @param entriesCount Count of storage entries
+ * @param [out] storageInitError If function returns CO_ERROR_DATA_CORRUPT,
+ * then this variable contains a bit mask from subIndexOD values, where data
+ * was not properly initialized. If other error, then this variable contains
+ * index or erroneous entry. If there is hardware error like missing flash,
+ * then storageInitError is 0xFFFFFFFF and function returns
+ * CO_ERROR_DATA_CORRUPT.
+ *
+ * @return CO_ERROR_NO, CO_ERROR_DATA_CORRUPT if data can not be initialized,
+ * CO_ERROR_ILLEGAL_ARGUMENT or CO_ERROR_OUT_OF_MEMORY.
+ */
+CO_ReturnError_t CO_storageFlash_init(CO_storage_t *storage,
+                                      CO_storageFlash_t *flash,
+                                      CO_CANmodule_t *CANmodule,
+                                      void *storageModule,
+                                      OD_entry_t *OD_1010_StoreParameters,
+                                      OD_entry_t *OD_1011_RestoreDefaultParam,
+                                      CO_storage_entry_t *entries,
+                                      uint8_t entriesCount,
+                                      uint32_t *storageInitError);
+
+
+/**
+ * Process flash storage in background.
+ *
+ * Should be called cyclically by program. It erases the sector after the head
+ * sector, if not erased yet, and for entries with CO_storage_auto attribute
+ * it appends new record, if data changed. One erase or one record per call.
+ *
+ * @param flash This object
+ * @param saveAll If true, records for all changed automatic entries are
+ * appended, useful on program end.
+ */
+void CO_storageFlash_process(CO_storageFlash_t *flash, bool_t saveAll);
+
+/** @} */ /* CO_storage_flash */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE */
+
+#endif /* CO_STORAGE_FLASH_H */
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+#
+# Generate binary Object Dictionary image from EDS or XDD file
+#
+# @file        odimage.py
+# @author      CANopenNode contributors
+# @copyright   2026 CANopenNode contributors
+#
+# This file is part of CANopenNode, an opensource CANopen Stack.
+# Project home page is <https://github.com/CANopenNode/CANopenNode>.
+# For more information on CANopen see <http://www.can-cia.org/>.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Generate OD image for OD_image_load() from EDS, XDD or XPD file.
+
+Image format is described in 301/CO_ODimage.h. Attributes are set the same
+way as in OD.c, generated by CANopenEditor. COB-IDs with $NODEID are stored
+without node-ID, as in OD.c, unless --node-id is given.
+
+Usage: odimage.py DS301_profile.eds -o DS301_profile.odimg
+"""
+
+import argparse
+import configparser
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+MAGIC = b"COOD"
+VERSION = 1
+NO_DATA = 0xFFFFFFFF
+
+ODT_VAR, ODT_ARR, ODT_REC = 0x01, 0x02, 0x03
+
+ODA_SDO_R, ODA_SDO_W, ODA_SDO_RW = 0x01, 0x02, 0x03
+ODA_TPDO, ODA_RPDO = 0x04, 0x08
+ODA_MB, ODA_STR = 0x40, 0x80
+
+# CANopen data type: (length, struct format or kind)
+DATA_TYPES = {
+    0x01: (1, "?"), 0x02: (1, "b"), 0x03: (2, "h"), 0x04: (4, "i"),
+    0x05: (1, "B"), 0x06: (2, "H"), 0x07: (4, "I"), 0x08: (4, "f"),
+    0x09: (0, "str"), 0x0A: (0, "oct"), 0x0B: (0, "uni"), 0x0F: (0, "dom"),
+    0x10: (3, "s"), 0x11: (8, "d"), 0x12: (5, "s"), 0x13: (6, "s"),
+    0x14: (7, "s"), 0x15: (8, "q"), 0x16: (3, "u"), 0x18: (5, "u"),
+    0x19: (6, "u"), 0x1A: (7, "u"), 0x1B: (8, "Q"),
+}
+
+# XDD/XPD element names of data types
+XDD_TYPES = {
+    "BOOL": 0x01, "SINT": 0x02, "INT": 0x03, "DINT": 0x04, "USINT": 0x05,
+    "UINT": 0x06, "UDINT": 0x07, "REAL": 0x08, "STRING": 0x09,
+    "BITSTRING": 0x0A, "WSTRING": 0x0B, "LREAL": 0x11, "LINT": 0x15,
+    "ULINT": 0x1B, "DOMAIN": 0x0F,
+}
+
+XDD_ACCESS = {
+    "read": "ro", "write": "wo", "readWrite": "rw", "readWriteInput": "rww",
+    "readWriteOutput": "rwr", "const": "const", "noAccess": "ro",
+}
+
+
+class OdError(Exception):
+    pass
+
+
+class Sub:
+    def __init__(self, sub_index, data_type, access, pdo, default, node_id):
+        if data_type not in DATA_TYPES:
+            raise OdError("unsupported data type 0x%02X" % data_type)
+        self.sub_index = sub_index
+        self.data_type = data_type
+        self.data = encode(data_type, default, node_id)
+        kind = DATA_TYPES[data_type][1]
+        self.attribute = attribute(access, pdo)
+        if kind in ("str", "uni"):
+            self.attribute |= ODA_STR
+        elif len(self.data) > 1 and kind not in ("oct", "dom"):
+            self.attribute |= ODA_MB
+        # as in CANopenEditor, variable without default value has no data in
+        # OD, it is accessed through extension only (0x1003 for example)
+        self.has_data = kind != "dom" and (kind in ("str", "uni", "oct")
+                                           or (default or "").strip() != "")
+
+
+class Entry:
+    def __init__(self, index, object_type, subs):
+        self.index = index
+        self.object_type = object_type
+        self.subs = subs
+
+
+def attribute(access, pdo):
+    """OD_attributes_t from EDS AccessType and PDO mapping"""
+    access = access.lower()
+    attr = {"ro": ODA_SDO_R, "const": ODA_SDO_R, "wo": ODA_SDO_W}.get(
+        access, ODA_SDO_RW)
+    if pdo in ("TPDO", "RPDO"):
+        return attr | (ODA_TPDO if pdo == "TPDO" else ODA_RPDO)
+    if pdo:
+        if access in ("ro", "const", "rwr"):
+            attr |= ODA_TPDO
+        elif access in ("wo", "rww"):
+            attr |= ODA_RPDO
+        else:
+            attr |= ODA_TPDO | ODA_RPDO
+    return attr
+
+
+def parse_int(text, node_id):
+    text = text.strip().replace("$NODEID", "%d" % node_id)
+    total = 0
+    for term in text.split("+"):
+        term = term.strip()
+        if term == "":
+            continue
+        try:
+            total += int(term, 0)
+        except ValueError:
+            total += int(term, 10)
+    return total
+
+
+def encode(data_type, default, node_id):
+    """Default value as little endian bytes"""
+    length, kind = DATA_TYPES[data_type]
+    default = (default or "").strip()
+    if kind == "dom":
+        return b""
+    if kind == "str":
+        return default.encode("utf-8") or b"\0"
+    if kind == "uni":
+        return default.encode("utf-16-le") or b"\0\0"
+    if kind == "oct":
+        return bytes(int(b, 16) for b in default.split()) or b"\0"
+    if kind in "fd":
+        return struct.pack("<" + kind, float(default or 0))
+    value = parse_int(default, node_id) if default else 0
+    if kind in ("s", "u"):
+        return (value & ((1 << (8 * length)) - 1)).to_bytes(length, "little")
+    if kind == "?":
+        return struct.pack("<B", 1 if value else 0)
+    return struct.pack("<" + kind, value)
+
+
+def load_eds(path, node_id):
+    eds = configparser.ConfigParser(strict=False, interpolation=None)
+    eds.optionxform = str.lower
+    with open(path, encoding="utf-8", errors="replace") as f:
+        eds.read_file(f)
+
+    sections = {}
+    for name in eds.sections():
+        m = re.fullmatch(r"([0-9A-Fa-f]{4})(?:sub([0-9A-Fa-f]{1,2}))?", name,
+                         re.IGNORECASE)
+        if m:
+            index = int(m.group(1), 16)
+            sub = int(m.group(2), 16) if m.group(2) is not None else None
+            sections.setdefault(index, {})[sub] = eds[name]
+
+    def make_sub(sec, sub_index):
+        return Sub(sub_index, parse_int(sec.get("datatype", "0x7"), 0),
+                   sec.get("accesstype", "ro"),
+                   parse_int(sec.get("pdomapping", "0"), 0) != 0,
+                   sec.get("defaultvalue", ""), node_id)
+
+    entries = []
+    for index in sorted(sections):
+        secs = sections[index]
+        if None not in secs or index < 0x1000:
+            continue
+        obj_type = parse_int(secs[None].get("objecttype", "0x7"), 0)
+        if obj_type in (0x7, 0x2):
+            entries.append(Entry(index, ODT_VAR, [make_sub(secs[None], 0)]))
+        else:
+            subs = [make_sub(secs[s], s) for s in sorted(s for s in secs
+                                                         if s is not None)]
+            entries.append(Entry(index, ODT_ARR if obj_type == 0x8
+                                 else ODT_REC, subs))
+    return entries
+
+
+def load_xdd(path, node_id):
+    root = ET.parse(path).getroot()
+
+    def local(tag):
+        return tag.rsplit("}", 1)[-1]
+
+    # parameters of XPD (CANopenNode project file), referenced by uniqueIDRef
+    params = {}
+    for el in root.iter():
+        if local(el.tag) == "parameter" and el.get("uniqueID"):
+            p = {"access": XDD_ACCESS.get(el.get("access", "read"), "ro")}
+            for child in el:
+                name = local(child.tag)
+                if name in XDD_TYPES:
+                    p["dataType"] = XDD_TYPES[name]
+                elif name == "defaultValue":
+                    p["defaultValue"] = child.get("value", "")
+            params[el.get("uniqueID")] = p
+
+    def make_sub(el, sub_index):
+        p = params.get(el.get("uniqueIDRef"), {})
+        data_type = el.get("dataType")
+        data_type = int(data_type, 16) if data_type else p.get("dataType")
+        if data_type is None:
+            raise OdError("no data type for %s" % el.get("name"))
+        access = el.get("accessType") or p.get("access", "ro")
+        pdo = el.get("PDOmapping", "no")
+        pdo = pdo if pdo in ("TPDO", "RPDO") else pdo != "no"
+        default = el.get("defaultValue")
+        if default is None:
+            default = p.get("defaultValue", "")
+        return Sub(sub_index, data_type, access, pdo, default, node_id)
+
+    entries = []
+    for el in root.iter():
+        if local(el.tag) != "CANopenObject":
+            continue
+        index = int(el.get("index"), 16)
+        obj_type = int(el.get("objectType", "7"), 0)
+        if obj_type in (0x7, 0x2):
+            entries.append(Entry(index, ODT_VAR, [make_sub(el, 0)]))
+        else:
+            subs = [make_sub(s, int(s.get("subIndex"), 16)) for s in el
+                    if local(s.tag) == "CANopenSubObject"]
+            subs.sort(key=lambda s: s.sub_index)
+            entries.append(Entry(index, ODT_ARR if obj_type == 0x8
+                                 else ODT_REC, subs))
+    entries.sort(key=lambda e: e.index)
+    return entries
+
+
+def build(entries):
+    """Binary image from entries"""
+    entry_bin = bytearray()
+    sub_bin = bytearray()
+    data = bytearray()
+    sub_count = 0
+
+    def place(blob, length):
+        align = 8 if length >= 8 else 4 if length >= 4 else \
+            2 if length >= 2 else 1
+        data.extend(b"\0" * (-len(data) % align))
+        offset = len(data)
+        data.extend(blob)
+        return offset
+
+    for e in entries:
+        if not e.subs or len(e.subs) > 255:
+            raise OdError("wrong number of sub-entries in 0x%04X" % e.index)
+        descs = []
+        if e.object_type == ODT_ARR:
+            sub0, elems = e.subs[0], e.subs[1:]
+            if sub0.sub_index != 0 or len(sub0.data) != 1:
+                raise OdError("0x%04X: sub-index 0 must be UNSIGNED8" % e.index)
+            length = max([len(s.data) for s in elems] or [0])
+            if any(s.data_type != elems[0].data_type
+                   or s.attribute != elems[0].attribute for s in elems):
+                raise OdError("0x%04X: array elements differ, use RECORD"
+                              % e.index)
+            descs.append((0, sub0.attribute, 1, place(sub0.data, 1)
+                          if sub0.has_data else NO_DATA))
+            attr = elems[0].attribute if elems else sub0.attribute
+            offset = NO_DATA
+            if elems and elems[0].has_data and length > 0:
+                for i, s in enumerate(elems):
+                    o = place(s.data.ljust(length, b"\0"), length)
+                    offset = o if i == 0 else offset
+            descs.append((1, attr, length, offset))
+        else:
+            for s in e.subs:
+                offset = place(s.data, len(s.data)) if s.has_data else NO_DATA
+                descs.append((s.sub_index, s.attribute, len(s.data), offset))
+
+        entry_bin += struct.pack("<HBBI", e.index, len(e.subs),
+                                 e.object_type, sub_count)
+        for sub_index, attr, length, offset in descs:
+            sub_bin += struct.pack("<BBHII", sub_index, attr, 0, length,
+                                   offset)
+        sub_count += len(descs)
+
+    header = MAGIC + struct.pack("<BBHII", VERSION, 0, len(entries),
+                                 sub_count, len(data))
+    image = bytearray(header) + entry_bin + sub_bin
+    image.extend(b"\0" * (-len(image) % 8))
+    return bytes(image + data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input", help="EDS, XDD or XPD file")
+    ap.add_argument("-o", "--output", required=True, help="OD image file")
+    ap.add_argument("--node-id", type=lambda x: int(x, 0), default=0,
+                    help="value of $NODEID in default values (default 0)")
+    args = ap.parse_args()
+
+    try:
+        if args.input.lower().endswith(".eds"):
+            entries = load_eds(args.input, args.node_id)
+        else:
+            entries = load_xdd(args.input, args.node_id)
+        image = build(entries)
+    except (OdError, ValueError, OSError, ET.ParseError) as e:
+        sys.exit("%s: %s" % (args.input, e))
+
+    with open(args.output, "wb") as f:
+        f.write(image)
+    print("%s: %d objects, %d bytes" % (args.output, len(entries), len(image)))
+
+
+if __name__ == "__main__":
+    main()